@@ -0,0 +1,179 @@
+// Batch export benchmark
+// End-of-day style export of several symbols to CSV, JSON and XML.
+// Times the number formatting on its own (iostream against to_chars),
+// each exporter run standalone, BatchExporter serially (one shared
+// formatting pass) and on a thread pool, and gzip written while streaming
+// against compressing the finished file afterwards.
+//
+// Usage: batch_export_benchmark [symbols] [bars_per_symbol] [threads]
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <charconv>
+#include <string>
+#include <vector>
+#include <random>
+#include <filesystem>
+#include <functional>
+#include <thread>
+
+#include "visualization/data_export.h"
+
+using namespace trading;
+using namespace trading::visualization;
+
+namespace
+{
+    double time_ms(const std::function<void()> &fn)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void report(const char *name, double ms, double baseline_ms = 0.0)
+    {
+        std::cout << std::left << std::setw(34) << name << std::right
+                  << std::setw(10) << std::fixed << std::setprecision(1) << ms << " ms";
+        if (baseline_ms > 0.0)
+        {
+            std::cout << std::setw(8) << std::setprecision(2) << baseline_ms / ms << "x";
+        }
+        std::cout << "\n";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t symbols = argc > 1 ? std::stoul(argv[1]) : 10;
+    size_t bars = argc > 2 ? std::stoul(argv[2]) : 100000;
+    size_t threads = argc > 3 ? std::stoul(argv[3]) : std::max(2u, std::thread::hardware_concurrency());
+
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> step(0.0, 0.05);
+    std::vector<MarketDataSeries> book;
+    auto start = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+    for (size_t s = 0; s < symbols; ++s)
+    {
+        MarketDataSeries series("SYM" + std::to_string(s));
+        double price = 50.0 + static_cast<double>(s);
+        for (size_t i = 0; i < bars; ++i)
+        {
+            double open = price;
+            price += step(rng);
+            series.add_point(MarketDataPoint(start + std::chrono::minutes(i), open, std::max(open, price) + 0.01,
+                                             std::min(open, price) - 0.01, price, 1000 + rng() % 5000));
+        }
+        book.push_back(std::move(series));
+    }
+
+    auto dir = std::filesystem::temp_directory_path() / "batch_export_benchmark";
+    std::filesystem::create_directories(dir);
+    auto path = [&](const std::string &name)
+    { return (dir / name).string(); };
+
+    std::cout << "Batch export benchmark: " << symbols << " symbols x " << bars << " bars, "
+              << threads << " threads (" << std::thread::hardware_concurrency() << " cores)\n\n";
+
+    // Number formatting alone
+    const auto &closes = book[0].data();
+    size_t sink = 0;
+    double iostream_ms = time_ms([&]
+                                 {
+        for (const auto &point : closes)
+        {
+            std::ostringstream oss;
+            oss << std::fixed << std::setprecision(6) << point.close;
+            sink += oss.str().size();
+        } });
+    double to_chars_ms = time_ms([&]
+                                 {
+        char buffer[64];
+        for (const auto &point : closes)
+        {
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), point.close, std::chars_format::fixed, 6);
+            sink += static_cast<size_t>(result.ptr - buffer);
+        } });
+    report("format_number (iostream)", iostream_ms);
+    report("to_chars", to_chars_ms, iostream_ms);
+    std::cout << "\n";
+
+    auto configure = [&](BatchExporter &batch)
+    {
+        batch.add_exporter(std::make_unique<CSVExporter>());
+        batch.add_exporter(std::make_unique<JSONExporter>());
+        batch.add_exporter(std::make_unique<XMLExporter>());
+        batch.add_export_config("csv", ExportConfig(path("book.csv")));
+        batch.add_export_config("json", ExportConfig(path("book.json"), ExportFormat::JSON));
+        batch.add_export_config("xml", ExportConfig(path("book.xml"), ExportFormat::XML));
+    };
+
+    // Every exporter on its own: no shared formatting, no concurrency
+    CSVExporter csv;
+    JSONExporter json;
+    XMLExporter xml;
+    double standalone_ms = time_ms([&]
+                                   {
+        for (const auto &series : book)
+        {
+            csv.export_market_data(series, ExportConfig(path("book.csv")));
+            json.export_market_data(series, ExportConfig(path("book.json"), ExportFormat::JSON));
+            xml.export_market_data(series, ExportConfig(path("book.xml"), ExportFormat::XML));
+        } });
+    report("standalone exporters", standalone_ms);
+
+    BatchExporter serial;
+    configure(serial);
+    double serial_ms = time_ms([&]
+                               {
+        for (const auto &series : book)
+        {
+            serial.export_market_data_batch(series);
+        } });
+    report("BatchExporter, serial", serial_ms, standalone_ms);
+
+    BatchExporter parallel(std::make_shared<ThreadPool>(threads));
+    configure(parallel);
+    double parallel_ms = time_ms([&]
+                                 {
+        for (const auto &series : book)
+        {
+            parallel.export_market_data_batch(series);
+        } });
+    report("BatchExporter, thread pool", parallel_ms, standalone_ms);
+    std::cout << "\n";
+
+    // Compression: streaming stage against a pass over the finished file
+    double post_ms = time_ms([&]
+                             {
+        for (const auto &series : book)
+        {
+            csv.export_market_data(series, ExportConfig(path("post.csv")));
+            ExportUtils::compress_file(path("post.csv"), path("post.csv.gz"));
+        } });
+    ExportConfig gzip_config(path("stream.csv"));
+    gzip_config.compression = ExportCompression::GZIP;
+    bool gzip_ok = true;
+    double stream_ms = time_ms([&]
+                               {
+        for (const auto &series : book)
+        {
+            gzip_ok = csv.export_market_data(series, gzip_config) && gzip_ok;
+        } });
+    if (gzip_ok)
+    {
+        report("csv, then compress_file", post_ms);
+        report("csv, streaming gzip", stream_ms, post_ms);
+        std::cout << "gzip size " << ExportUtils::format_file_size(ExportUtils::get_file_size(path("stream.csv.gz")))
+                  << " of " << ExportUtils::format_file_size(ExportUtils::get_file_size(path("post.csv"))) << "\n";
+    }
+    else
+    {
+        std::cout << "gzip unavailable (built without zlib)\n";
+    }
+
+    std::filesystem::remove_all(dir);
+    return sink == 0;
+}
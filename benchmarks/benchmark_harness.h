@@ -0,0 +1,399 @@
+#pragma once
+
+// Benchmark harness used by benchmark_suite
+// Times named cases over repeated runs, reports robust statistics and
+// writes them as JSON, so a run can be stored as a baseline and later
+// runs compared against it.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "external/json.hpp"
+
+namespace trading
+{
+    namespace bench
+    {
+
+        /**
+         * @brief One benchmark: a body timed over several runs
+         *
+         * Names are group/subject/variant (core/thread_pool/submit,
+         * data/indicators/sma/1M) and are the key baselines are matched on,
+         * so keep them stable across releases.
+         */
+        struct Case
+        {
+            std::string name;
+            size_t items = 1;            // Work units one run processes (points, tasks, operations)
+            std::function<void()> run;   // Timed
+            std::function<void()> setup; // Untimed, before every run (may be empty)
+
+            Case(std::string case_name, size_t case_items, std::function<void()> body,
+                 std::function<void()> before = {})
+                : name(std::move(case_name)), items(case_items), run(std::move(body)), setup(std::move(before)) {}
+        };
+
+        /**
+         * @brief Timing of one case; times are nanoseconds per run
+         */
+        struct Result
+        {
+            std::string name;
+            size_t items = 0;
+            size_t runs = 0;
+            double min_ns = 0.0;
+            double median_ns = 0.0;
+            double mean_ns = 0.0;
+            double max_ns = 0.0;
+            double stddev_ns = 0.0;
+
+            double items_per_second() const { return median_ns > 0.0 ? static_cast<double>(items) * 1e9 / median_ns : 0.0; }
+        };
+
+        /**
+         * @brief Command-line settings
+         */
+        struct Options
+        {
+            std::vector<std::string> filters; // Run cases whose name contains any of these (empty = all)
+            size_t runs = 5;                  // Timed runs per case, after one untimed warm-up run
+            bool quick = false;               // Skip the largest sizes and time 3 runs
+            bool list = false;                // Print case names and exit
+            std::string json_path;            // Write results here
+            std::string baseline_path;        // Compare against these results
+            double threshold = 0.10;          // Median slowdown that counts as a regression
+        };
+
+        inline void print_usage(const char *program)
+        {
+            std::cout << "Usage: " << program
+                      << " [--filter text[,text...]] [--runs N] [--quick] [--list]\n"
+                         "       [--json results.json] [--baseline baseline.json] [--threshold 0.10]\n";
+        }
+
+        /**
+         * @throws std::invalid_argument on an unknown or incomplete option
+         */
+        inline Options parse_options(int argc, char *argv[])
+        {
+            Options options;
+            for (int i = 1; i < argc; ++i)
+            {
+                std::string arg = argv[i];
+                auto value = [&]() -> std::string
+                {
+                    if (i + 1 >= argc)
+                    {
+                        throw std::invalid_argument(arg + " needs a value");
+                    }
+                    return argv[++i];
+                };
+
+                if (arg == "--filter")
+                {
+                    std::stringstream list(value());
+                    std::string filter;
+                    while (std::getline(list, filter, ','))
+                    {
+                        if (!filter.empty())
+                        {
+                            options.filters.push_back(filter);
+                        }
+                    }
+                }
+                else if (arg == "--runs")
+                {
+                    options.runs = std::max<size_t>(1, std::stoul(value()));
+                }
+                else if (arg == "--quick")
+                {
+                    options.quick = true;
+                    options.runs = 3;
+                }
+                else if (arg == "--list")
+                {
+                    options.list = true;
+                }
+                else if (arg == "--json")
+                {
+                    options.json_path = value();
+                }
+                else if (arg == "--baseline")
+                {
+                    options.baseline_path = value();
+                }
+                else if (arg == "--threshold")
+                {
+                    options.threshold = std::stod(value());
+                }
+                else
+                {
+                    throw std::invalid_argument("Unknown option " + arg);
+                }
+            }
+            return options;
+        }
+
+        inline bool selected(const Options &options, const std::string &name)
+        {
+            return options.filters.empty() ||
+                   std::any_of(options.filters.begin(), options.filters.end(), [&](const std::string &filter)
+                               { return name.find(filter) != std::string::npos; });
+        }
+
+        /**
+         * @brief Run a case once untimed, then options.runs times timed
+         *
+         * The warm-up run builds lazily created inputs and faults in
+         * memory, so timed runs see steady state. The median is the
+         * headline figure: unlike the mean it ignores the odd run that
+         * lost the CPU.
+         */
+        inline Result measure(const Case &benchmark, const Options &options)
+        {
+            std::vector<double> times;
+            times.reserve(options.runs);
+            for (size_t run = 0; run <= options.runs; ++run)
+            {
+                if (benchmark.setup)
+                {
+                    benchmark.setup();
+                }
+                auto start = std::chrono::steady_clock::now();
+                benchmark.run();
+                double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+                if (run > 0)
+                {
+                    times.push_back(ns);
+                }
+            }
+
+            Result result;
+            result.name = benchmark.name;
+            result.items = benchmark.items;
+            result.runs = times.size();
+            std::sort(times.begin(), times.end());
+            size_t middle = times.size() / 2;
+            result.median_ns = times.size() % 2 ? times[middle] : (times[middle - 1] + times[middle]) / 2.0;
+            result.min_ns = times.front();
+            result.max_ns = times.back();
+            double sum = 0.0;
+            for (double t : times)
+            {
+                sum += t;
+            }
+            result.mean_ns = sum / static_cast<double>(times.size());
+            double squares = 0.0;
+            for (double t : times)
+            {
+                squares += (t - result.mean_ns) * (t - result.mean_ns);
+            }
+            result.stddev_ns = times.size() > 1 ? std::sqrt(squares / static_cast<double>(times.size() - 1)) : 0.0;
+            return result;
+        }
+
+        // Human-readable time for the console table
+        inline std::string format_duration(double ns)
+        {
+            std::ostringstream out;
+            out << std::fixed << std::setprecision(2);
+            if (ns < 1e3)
+            {
+                out << ns << " ns";
+            }
+            else if (ns < 1e6)
+            {
+                out << ns / 1e3 << " us";
+            }
+            else if (ns < 1e9)
+            {
+                out << ns / 1e6 << " ms";
+            }
+            else
+            {
+                out << ns / 1e9 << " s";
+            }
+            return out.str();
+        }
+
+        inline void print_result(const Result &result)
+        {
+            double spread = result.median_ns > 0.0 ? 100.0 * result.stddev_ns / result.median_ns : 0.0;
+            std::cout << std::left << std::setw(46) << result.name << std::right
+                      << std::setw(12) << format_duration(result.median_ns)
+                      << std::setw(12) << format_duration(result.min_ns)
+                      << std::setw(8) << std::fixed << std::setprecision(1) << spread << "%"
+                      << std::setw(12) << std::setprecision(2) << result.items_per_second() / 1e6 << " M/s"
+                      << std::setw(12) << format_duration(result.median_ns / static_cast<double>(result.items)) << "/item\n";
+        }
+
+        inline void print_header()
+        {
+            std::cout << std::left << std::setw(46) << "case" << std::right << std::setw(12) << "median"
+                      << std::setw(12) << "min" << std::setw(9) << "stddev" << std::setw(16) << "items/s"
+                      << std::setw(17) << "per item" << "\n";
+        }
+
+        /**
+         * @brief Where and how the results were produced
+         */
+        inline nlohmann::json context(const Options &options)
+        {
+            std::time_t now = std::time(nullptr);
+            char timestamp[32];
+            std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+            nlohmann::json info;
+            info["timestamp"] = timestamp;
+#if defined(__clang__)
+            info["compiler"] = "clang " __clang_version__;
+#elif defined(__GNUC__)
+            info["compiler"] = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+            info["compiler"] = "msvc " + std::to_string(_MSC_VER);
+#endif
+#if defined(TRADING_BUILD_TYPE)
+            info["build_type"] = TRADING_BUILD_TYPE;
+#endif
+            info["hardware_threads"] = std::thread::hardware_concurrency();
+#if defined(TRADING_METRICS)
+            info["metrics"] = true;
+#else
+            info["metrics"] = false;
+#endif
+            info["runs"] = options.runs;
+            info["quick"] = options.quick;
+            return info;
+        }
+
+        inline std::string to_json(const std::vector<Result> &results, const Options &options)
+        {
+            nlohmann::json document;
+            document["format"] = "trading-benchmarks";
+            document["version"] = 1;
+            document["context"] = context(options);
+            document["results"] = nlohmann::json::array();
+            for (const Result &result : results)
+            {
+                document["results"].push_back({{"name", result.name},
+                                               {"items", result.items},
+                                               {"runs", result.runs},
+                                               {"min_ns", result.min_ns},
+                                               {"median_ns", result.median_ns},
+                                               {"mean_ns", result.mean_ns},
+                                               {"max_ns", result.max_ns},
+                                               {"stddev_ns", result.stddev_ns},
+                                               {"items_per_second", result.items_per_second()}});
+            }
+            return document.dump(2);
+        }
+
+        /**
+         * @brief Read results written by to_json()
+         * @throws std::runtime_error if the file cannot be read or is not a results file
+         */
+        inline std::vector<Result> load_results(const std::string &path)
+        {
+            std::ifstream file(path);
+            if (!file)
+            {
+                throw std::runtime_error("Cannot open benchmark results " + path);
+            }
+            nlohmann::json document;
+            try
+            {
+                file >> document;
+            }
+            catch (const nlohmann::json::exception &e)
+            {
+                throw std::runtime_error("Invalid benchmark results " + path + ": " + e.what());
+            }
+            if (document.value("format", "") != "trading-benchmarks")
+            {
+                throw std::runtime_error(path + " is not a benchmark results file");
+            }
+
+            std::vector<Result> results;
+            for (const auto &entry : document.at("results"))
+            {
+                Result result;
+                result.name = entry.at("name").get<std::string>();
+                result.items = entry.value("items", size_t{0});
+                result.runs = entry.value("runs", size_t{0});
+                result.min_ns = entry.value("min_ns", 0.0);
+                result.median_ns = entry.at("median_ns").get<double>();
+                result.mean_ns = entry.value("mean_ns", 0.0);
+                result.max_ns = entry.value("max_ns", 0.0);
+                result.stddev_ns = entry.value("stddev_ns", 0.0);
+                results.push_back(std::move(result));
+            }
+            return results;
+        }
+
+        /**
+         * @brief Print each case against its baseline
+         * @return Number of cases slower than the baseline by more than threshold
+         *
+         * Cases are matched by name, and per-item times are compared so a
+         * case whose size changed still compares fairly. Cases missing from
+         * either side are listed but never count as regressions.
+         */
+        inline size_t compare(const std::vector<Result> &current, const std::vector<Result> &baseline, double threshold)
+        {
+            std::map<std::string, const Result *> previous;
+            for (const Result &result : baseline)
+            {
+                previous[result.name] = &result;
+            }
+
+            auto per_item = [](const Result &result)
+            { return result.median_ns / static_cast<double>(std::max<size_t>(result.items, 1)); };
+
+            std::cout << "\n"
+                      << std::left << std::setw(46) << "case" << std::right << std::setw(14) << "baseline"
+                      << std::setw(14) << "current" << std::setw(10) << "change" << "\n";
+            size_t regressions = 0;
+            for (const Result &result : current)
+            {
+                auto it = previous.find(result.name);
+                std::cout << std::left << std::setw(46) << result.name << std::right;
+                if (it == previous.end())
+                {
+                    std::cout << std::setw(14) << "-" << std::setw(14) << format_duration(per_item(result)) << "       new\n";
+                    continue;
+                }
+
+                double before = per_item(*it->second);
+                double after = per_item(result);
+                double change = before > 0.0 ? after / before - 1.0 : 0.0;
+                bool regressed = change > threshold;
+                regressions += regressed ? 1 : 0;
+                std::cout << std::setw(14) << format_duration(before) << std::setw(14) << format_duration(after)
+                          << std::setw(9) << std::showpos << std::fixed << std::setprecision(1) << change * 100.0
+                          << std::noshowpos << "%" << (regressed ? "  REGRESSION" : (change < -threshold ? "  faster" : ""))
+                          << "\n";
+                previous.erase(it);
+            }
+            for (const auto &[name, result] : previous)
+            {
+                std::cout << std::left << std::setw(46) << name << std::right << std::setw(14)
+                          << format_duration(per_item(*result)) << std::setw(14) << "-" << "   missing\n";
+            }
+            return regressions;
+        }
+
+    } // namespace bench
+} // namespace trading
@@ -0,0 +1,561 @@
+// Benchmark suite
+// Reproducible micro- and macrobenchmarks of the core, data and
+// visualization hot paths in one executable: ThreadPool submission,
+// LockFreeQueue operations, MemoryPool against malloc, every DataProcessor
+// indicator at 1K, 1M and 10M points, the fused IndicatorPipeline,
+// IndicatorCache hits and appends, clean_data with and without a pool,
+// CacheManager cold and warm loads, exporter and renderer throughput.
+// Inputs come from fixed seeds, each case gets an untimed warm-up run,
+// and the median of the timed runs is reported. --json writes the results for tracking; --baseline compares
+// with an earlier results file and exits with status 1 if any case got
+// slower per item by more than --threshold.
+//
+// Usage: benchmark_suite [--filter text[,text...]] [--runs N] [--quick] [--list]
+//                        [--json results.json] [--baseline baseline.json] [--threshold 0.10]
+
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <thread>
+#include <future>
+#include <random>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <cstdlib>
+
+#include "benchmark_harness.h"
+#include "core/thread_pool.h"
+#include "core/lock_free_queue.h"
+#include "core/memory_pool.h"
+#include "data/data_processor.h"
+#include "data/cache_manager.h"
+#include "data/indicator_cache.h"
+#include "data/indicator_pipeline.h"
+#include "visualization/data_export.h"
+#include "visualization/chart_renderer.h"
+#include "visualization/chart_lod.h"
+
+using namespace trading;
+using namespace trading::visualization;
+using bench::Case;
+
+namespace
+{
+    volatile size_t sink = 0;
+
+    // Input built on first use, so filtered-out cases never allocate theirs
+    template <typename T>
+    class Lazy
+    {
+    public:
+        explicit Lazy(std::function<T()> make) : make_(std::move(make)) {}
+
+        T &get()
+        {
+            if (!value_)
+            {
+                value_.emplace(make_());
+            }
+            return *value_;
+        }
+
+    private:
+        std::function<T()> make_;
+        std::optional<T> value_;
+    };
+
+    template <typename T>
+    std::shared_ptr<Lazy<T>> lazy(std::function<T()> make)
+    {
+        return std::make_shared<Lazy<T>>(std::move(make));
+    }
+
+    // Random-walk minute bars; the same seed always gives the same series
+    MarketDataSeries make_series(const std::string &symbol, size_t bars, uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<double> step(0.0, 0.05);
+        MarketDataSeries series(symbol);
+        series.reserve(bars);
+        auto start = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+        double price = 100.0;
+        for (size_t i = 0; i < bars; ++i)
+        {
+            double open = price;
+            price = std::max(1.0, price + step(rng));
+            double high = std::max(open, price) + std::abs(step(rng));
+            double low = std::min(open, price) - std::abs(step(rng));
+            series.add_point(MarketDataPoint(start + std::chrono::minutes(i), open, high, low, price, 1000 + rng() % 5000));
+        }
+        return series;
+    }
+
+    std::vector<double> make_prices(size_t points)
+    {
+        std::mt19937_64 rng(42);
+        std::normal_distribution<double> step(0.0, 0.05);
+        std::vector<double> prices(points);
+        double price = 100.0;
+        for (double &p : prices)
+        {
+            price = std::max(1.0, price + step(rng));
+            p = price;
+        }
+        return prices;
+    }
+
+    std::string size_label(size_t n)
+    {
+        if (n >= 1000000 && n % 1000000 == 0)
+        {
+            return std::to_string(n / 1000000) + "M";
+        }
+        if (n >= 1000 && n % 1000 == 0)
+        {
+            return std::to_string(n / 1000) + "K";
+        }
+        return std::to_string(n);
+    }
+
+    std::filesystem::path scratch_dir(const std::string &name)
+    {
+        auto dir = std::filesystem::temp_directory_path() / "trading_benchmark_suite" / name;
+        std::filesystem::create_directories(dir);
+        return dir;
+    }
+
+    void add_core_cases(std::vector<Case> &cases)
+    {
+        auto pool = lazy<std::shared_ptr<ThreadPool>>([]
+                                                      { return std::make_shared<ThreadPool>(); });
+
+        const size_t tasks = 100000;
+        cases.push_back({"core/thread_pool/submit", tasks, [pool, tasks]
+                         {
+                             ThreadPool &p = *pool->get();
+                             std::vector<std::future<void>> futures;
+                             futures.reserve(tasks);
+                             for (size_t i = 0; i < tasks; ++i)
+                             {
+                                 futures.push_back(p.submit([i]
+                                                            { sink = i; }));
+                             }
+                             for (auto &future : futures)
+                             {
+                                 future.get();
+                             }
+                         }});
+        cases.push_back({"core/thread_pool/submit_batch", tasks, [pool, tasks]
+                         {
+                             auto futures = pool->get()->submit_batch(tasks, [](size_t i)
+                                                                      { sink = i; });
+                             for (auto &future : futures)
+                             {
+                                 future.get();
+                             }
+                         }});
+        const size_t indices = 10000000;
+        cases.push_back({"core/thread_pool/parallel_for", indices, [pool, indices]
+                         {
+                             pool->get()->parallel_for(0, indices, [](size_t i)
+                                                       { sink = i; });
+                         }});
+
+        // Single thread: push a burst, pop it back; no waiting involved
+        const size_t operations = 10000000;
+        auto queue = lazy<std::shared_ptr<LockFreeQueue<uint64_t>>>([]
+                                                                   { return std::make_shared<LockFreeQueue<uint64_t>>(1024); });
+        cases.push_back({"core/lock_free_queue/push_pop", operations, [queue, operations]
+                         {
+                             LockFreeQueue<uint64_t> &q = *queue->get();
+                             uint64_t value = 0;
+                             for (size_t done = 0; done < operations; done += 512)
+                             {
+                                 for (uint64_t i = 0; i < 512; ++i)
+                                 {
+                                     q.try_push(i);
+                                 }
+                                 for (size_t i = 0; i < 512; ++i)
+                                 {
+                                     q.try_pop(value);
+                                 }
+                             }
+                             sink = value;
+                         }});
+
+        // Producer and consumer threads; they yield when the queue is full or empty
+        const size_t transfers = 2000000;
+        cases.push_back({"core/lock_free_queue/spsc_threads", transfers, [transfers]
+                         {
+                             LockFreeQueue<uint64_t, SpinThenYieldWait> q(4096);
+                             std::thread producer([&]
+                                                  {
+                                 for (uint64_t i = 0; i < transfers; ++i)
+                                 {
+                                     q.push(i);
+                                 } });
+                             uint64_t value = 0;
+                             for (size_t i = 0; i < transfers; ++i)
+                             {
+                                 q.pop(value);
+                             }
+                             producer.join();
+                             sink = value;
+                         }});
+
+        // Allocate a wave of 64-byte blocks, free it, repeat
+        const size_t allocations = 1000000;
+        const size_t wave = 1024;
+        auto memory_pool = lazy<std::shared_ptr<MemoryPool>>([wave]
+                                                             { return std::make_shared<MemoryPool>(64, wave); });
+        cases.push_back({"core/memory_pool/allocate_free", allocations, [memory_pool, allocations, wave]
+                         {
+                             MemoryPool &p = *memory_pool->get();
+                             std::vector<void *> blocks(wave);
+                             for (size_t done = 0; done < allocations; done += wave)
+                             {
+                                 for (auto &block : blocks)
+                                 {
+                                     block = p.allocate();
+                                 }
+                                 for (void *block : blocks)
+                                 {
+                                     p.deallocate(block);
+                                 }
+                             }
+                         }});
+        cases.push_back({"core/malloc/allocate_free", allocations, [allocations, wave]
+                         {
+                             std::vector<void *> blocks(wave);
+                             for (size_t done = 0; done < allocations; done += wave)
+                             {
+                                 for (auto &block : blocks)
+                                 {
+                                     block = std::malloc(64);
+                                 }
+                                 for (void *block : blocks)
+                                 {
+                                     std::free(block);
+                                 }
+                             }
+                         }});
+    }
+
+    void add_data_cases(std::vector<Case> &cases, const bench::Options &options)
+    {
+        std::vector<size_t> sizes = {1000, 1000000};
+        if (!options.quick)
+        {
+            sizes.push_back(10000000);
+        }
+        auto pool = lazy<std::shared_ptr<ThreadPool>>([]
+                                                      { return std::make_shared<ThreadPool>(); });
+
+        for (size_t n : sizes)
+        {
+            const std::string suffix = "/" + size_label(n);
+            auto prices = lazy<std::vector<double>>([n]
+                                                    { return make_prices(n); });
+            auto returns = lazy<std::vector<double>>([prices]
+                                                     { return DataProcessor().calculate_returns(prices->get()); });
+            auto series = lazy<MarketDataSeries>([n]
+                                                 { return make_series("BENCH", n, 7); });
+
+            // Small inputs run many times per sample so the timer resolution does not matter
+            const size_t repeat = std::max<size_t>(1, 1000000 / n);
+            auto indicator = [&](const std::string &name, std::function<size_t(const std::vector<double> &)> body,
+                                 std::shared_ptr<Lazy<std::vector<double>>> input)
+            {
+                cases.push_back({"data/indicators/" + name + suffix, n * repeat, [input, body, repeat]
+                                 {
+                                     for (size_t r = 0; r < repeat; ++r)
+                                     {
+                                         sink = body(input->get());
+                                     }
+                                 }});
+            };
+
+            DataProcessor processor;
+            indicator("sma", [processor](const std::vector<double> &p)
+                      { return processor.calculate_sma(p, 20).size(); }, prices);
+            indicator("ema", [processor](const std::vector<double> &p)
+                      { return processor.calculate_ema(p, 20).size(); }, prices);
+            indicator("rsi", [processor](const std::vector<double> &p)
+                      { return processor.calculate_rsi(p, 14).size(); }, prices);
+            indicator("macd", [processor](const std::vector<double> &p)
+                      { return processor.calculate_macd(p).first.size(); }, prices);
+            indicator("bollinger", [processor](const std::vector<double> &p)
+                      { return processor.calculate_bollinger_bands(p).first.size(); }, prices);
+            indicator("returns", [processor](const std::vector<double> &p)
+                      { return processor.calculate_returns(p).size(); }, prices);
+            indicator("volatility", [processor](const std::vector<double> &r)
+                      { return processor.calculate_volatility(r, 20).size(); }, returns);
+            indicator("normalize", [processor](const std::vector<double> &p)
+                      { return processor.normalize_prices(p).size(); }, prices);
+
+            cases.push_back({"data/indicators/all" + suffix, n * repeat, [series, repeat]
+                             {
+                                 DataProcessor processor;
+                                 for (size_t r = 0; r < repeat; ++r)
+                                 {
+                                     sink = processor.calculate_indicators(series->get()).sma_20.size();
+                                 }
+                             }});
+            // The same indicators fused into caller-owned columns reused across runs
+            auto columns = lazy<std::vector<std::vector<double>>>([n]
+                                                                  { return std::vector<std::vector<double>>(
+                                                                        StandardIndicatorPipeline::output_count, std::vector<double>(n)); });
+            auto volumes = lazy<std::vector<double>>([n]
+                                                     { return std::vector<double>(n, 1000.0); });
+            cases.push_back({"data/indicators/pipeline" + suffix, n * repeat, [prices, volumes, columns, repeat]
+                             {
+                                 StandardIndicatorPipeline::Outputs outputs;
+                                 for (size_t k = 0; k < outputs.size(); ++k)
+                                 {
+                                     outputs[k] = columns->get()[k];
+                                 }
+                                 for (size_t r = 0; r < repeat; ++r)
+                                 {
+                                     StandardIndicatorPipeline pipeline;
+                                     pipeline.process(prices->get(), volumes->get(), outputs);
+                                     sink = pipeline.size();
+                                 }
+                             }});
+
+            // Memoized: repeated requests, and single bars appended to a
+            // cached series (its own copy, so the other cases keep theirs).
+            // Skipped at 10M, where each cache would hold another 800 MB.
+            if (n <= 1000000)
+            {
+                auto cache = std::make_shared<IndicatorCache>(4096);
+                cases.push_back({"data/indicator_cache/hit" + suffix, n * repeat, [series, cache, repeat]
+                                 {
+                                     for (size_t r = 0; r < repeat; ++r)
+                                     {
+                                         sink = cache->calculate_indicators(series->get())->sma_20.size();
+                                     }
+                                 }});
+
+                const size_t appends = 1000;
+                auto growing = lazy<MarketDataSeries>([n]
+                                                      { return make_series("APPEND", n, 7); });
+                cases.push_back({"data/indicator_cache/append" + suffix, appends, [growing, cache, appends]
+                                 {
+                                     MarketDataSeries &s = growing->get();
+                                     for (size_t i = 0; i < appends; ++i)
+                                     {
+                                         MarketDataPoint bar = s.back();
+                                         bar.timestamp += std::chrono::minutes(1);
+                                         s.add_point(bar);
+                                         sink = cache->calculate_indicators(s)->sma_20.size();
+                                     }
+                                 }});
+            }
+            cases.push_back({"data/clean_data" + suffix, n * repeat, [series, repeat]
+                             {
+                                 DataProcessor processor;
+                                 for (size_t r = 0; r < repeat; ++r)
+                                 {
+                                     sink = processor.clean_data(series->get()).size();
+                                 }
+                             }});
+            cases.push_back({"data/clean_data/pooled" + suffix, n * repeat, [series, pool, repeat]
+                             {
+                                 DataProcessor processor;
+                                 processor.set_thread_pool(pool->get());
+                                 for (size_t r = 0; r < repeat; ++r)
+                                 {
+                                     sink = processor.clean_data(series->get()).size();
+                                 }
+                             }});
+        }
+
+        // Cold: a new cache that only has the on-disk index, faulting every
+        // entry in (file pages are in the OS page cache after the first run).
+        // Warm: lookups of resident entries.
+        const size_t entries = 16;
+        const size_t bars = 64 * 1024;
+        auto populated = lazy<std::string>([entries, bars]
+                                           {
+            auto dir = scratch_dir("cache");
+            std::filesystem::remove_all(dir);
+            CacheManager cache(1024, dir.string());
+            for (size_t i = 0; i < entries; ++i)
+            {
+                cache.put("SYM" + std::to_string(i), make_series("SYM" + std::to_string(i), bars, i));
+            }
+            return dir.string(); });
+        cases.push_back({"data/cache/cold_load", entries * bars, [populated, entries]
+                         {
+                             CacheManager cache(1024, populated->get());
+                             for (size_t i = 0; i < entries; ++i)
+                             {
+                                 sink = cache.get("SYM" + std::to_string(i))->size();
+                             }
+                         }});
+
+        const size_t lookups = 1000000;
+        auto warm = lazy<std::shared_ptr<CacheManager>>([populated, entries]
+                                                        {
+            auto cache = std::make_shared<CacheManager>(1024, populated->get());
+            for (size_t i = 0; i < entries; ++i)
+            {
+                cache->get("SYM" + std::to_string(i));
+            }
+            return cache; });
+        auto keys = std::make_shared<std::vector<std::string>>();
+        for (size_t i = 0; i < entries; ++i)
+        {
+            keys->push_back("SYM" + std::to_string(i));
+        }
+        cases.push_back({"data/cache/warm_get", lookups, [warm, keys, lookups]
+                         {
+                             CacheManager &cache = *warm->get();
+                             for (size_t i = 0; i < lookups; ++i)
+                             {
+                                 sink = cache.get((*keys)[i % keys->size()])->size();
+                             }
+                         }});
+    }
+
+    void add_visualization_cases(std::vector<Case> &cases)
+    {
+        const size_t bars = 250000;
+        auto series = lazy<MarketDataSeries>([bars]
+                                             { return make_series("AAPL", bars, 11); });
+
+        struct Format
+        {
+            const char *name;
+            ExportFormat format;
+        };
+        for (const Format &f : {Format{"csv", ExportFormat::CSV}, Format{"json", ExportFormat::JSON},
+                                Format{"parquet", ExportFormat::PARQUET}, Format{"feather", ExportFormat::FEATHER}})
+        {
+            auto path = (scratch_dir("export") / (std::string(f.name) + ExportFactory::get_file_extension(f.format))).string();
+            cases.push_back({std::string("visualization/export/") + f.name, bars, [series, path, format = f.format]
+                             {
+                                 auto exporter = ExportFactory::create_exporter(format);
+                                 if (!exporter->export_market_data(series->get(), ExportConfig(path, format)))
+                                 {
+                                     throw std::runtime_error("Export to " + path + " failed");
+                                 }
+                             }});
+        }
+
+        for (size_t n : {size_t{1000}, size_t{1000000}})
+        {
+            auto candles = lazy<std::vector<CandlestickPoint>>([n]
+                                                               {
+                auto source = make_series("AAPL", n, 13);
+                return std::vector<CandlestickPoint>(source.data().begin(), source.data().end()); });
+
+            // The HTML renderer reduces long series to the plot width first
+            cases.push_back({"visualization/render/html_candlestick/" + size_label(n), n, [candles]
+                             {
+                                 auto renderer = ChartFactory::create_renderer(ChartFactory::RendererType::HTML);
+                                 ChartConfig config;
+                                 renderer->initialize(config);
+                                 renderer->render_candlestick_chart(candles->get(), {}, config);
+                                 sink = renderer->get_chart_data("html").size();
+                             }});
+            cases.push_back({"visualization/lod/pyramid_build/" + size_label(n), n, [candles]
+                             {
+                                 CandlestickPyramid pyramid;
+                                 pyramid.build(candles->get());
+                                 sink = pyramid.level_count();
+                             }});
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    bench::Options options;
+    try
+    {
+        options = bench::parse_options(argc, argv);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        bench::print_usage(argv[0]);
+        return 2;
+    }
+
+    std::vector<Case> cases;
+    add_core_cases(cases);
+    add_data_cases(cases, options);
+    add_visualization_cases(cases);
+
+    if (options.list)
+    {
+        for (const Case &c : cases)
+        {
+            std::cout << c.name << "\n";
+        }
+        return 0;
+    }
+
+    std::cout << "Benchmark suite: " << options.runs << " timed runs per case"
+              << (options.quick ? " (quick)" : "") << ", " << std::thread::hardware_concurrency()
+              << " hardware threads\n\n";
+    bench::print_header();
+
+    std::vector<bench::Result> results;
+    try
+    {
+        for (const Case &c : cases)
+        {
+            if (bench::selected(options, c.name))
+            {
+                results.push_back(bench::measure(c, options));
+                bench::print_result(results.back());
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Benchmark failed: " << e.what() << "\n";
+        return 2;
+    }
+    cases.clear(); // Closes the caches before their directory goes
+    std::filesystem::remove_all(std::filesystem::temp_directory_path() / "trading_benchmark_suite");
+
+    if (!options.json_path.empty())
+    {
+        std::ofstream out(options.json_path);
+        out << bench::to_json(results, options) << "\n";
+        if (!out)
+        {
+            std::cerr << "Cannot write " << options.json_path << "\n";
+            return 2;
+        }
+        std::cout << "\nResults written to " << options.json_path << "\n";
+    }
+
+    if (!options.baseline_path.empty())
+    {
+        try
+        {
+            // Cases filtered out of this run are not missing
+            auto baseline = bench::load_results(options.baseline_path);
+            baseline.erase(std::remove_if(baseline.begin(), baseline.end(), [&](const bench::Result &result)
+                                          { return !bench::selected(options, result.name); }),
+                           baseline.end());
+            size_t regressions = bench::compare(results, baseline, options.threshold);
+            std::cout << "\n"
+                      << regressions << " regression(s) beyond " << options.threshold * 100.0 << "%\n";
+            return regressions == 0 ? 0 : 1;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << e.what() << "\n";
+            return 2;
+        }
+    }
+    return 0;
+}
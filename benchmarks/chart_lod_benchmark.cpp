@@ -0,0 +1,152 @@
+// Chart level-of-detail benchmark
+// Renders a year of minute bars (and a line and indicator of the same
+// length) through HTMLChartRenderer with and without the LOD layer,
+// reporting render time, HTML size and SVG element count, then times the
+// reduction kernels and zooming through a CandlestickPyramid against
+// re-bucketing the raw range on every zoom step.
+//
+// Usage: chart_lod_benchmark [bars] [width]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <random>
+#include <functional>
+
+#include "visualization/chart_renderer.h"
+#include "visualization/chart_lod.h"
+
+using namespace trading;
+using namespace trading::visualization;
+
+namespace
+{
+    double time_ms(const std::function<void()> &fn, int repeats = 1)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repeats; ++i)
+        {
+            fn();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+    }
+
+    size_t count_elements(const std::string &html)
+    {
+        size_t count = 0;
+        for (const char *tag : {"<rect x=", "<line ", "<path d="})
+        {
+            for (size_t pos = html.find(tag); pos != std::string::npos; pos = html.find(tag, pos + 1))
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    void report(const char *name, double ms, const std::string &html)
+    {
+        std::cout << std::left << std::setw(24) << name << std::right
+                  << std::setw(10) << std::fixed << std::setprecision(2) << ms << " ms"
+                  << std::setw(10) << std::setprecision(1) << html.size() / 1024.0 << " KiB"
+                  << std::setw(10) << count_elements(html) << " elements\n";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 252 * 390; // One year of regular-session minutes
+    int width = argc > 2 ? std::stoi(argv[2]) : 1600;
+
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> step(0.0, 0.05);
+    std::vector<CandlestickPoint> candles;
+    std::vector<ChartPoint> line;
+    candles.reserve(bars);
+    line.reserve(bars);
+    auto start = std::chrono::system_clock::now();
+    double price = 100.0;
+    for (size_t i = 0; i < bars; ++i)
+    {
+        double open = price;
+        price += step(rng);
+        double high = std::max(open, price) + std::abs(step(rng));
+        double low = std::min(open, price) - std::abs(step(rng));
+        candles.emplace_back(MarketDataPoint(start + std::chrono::minutes(i), open, high, low, price, 1000 + i % 500));
+        line.emplace_back(static_cast<double>(i), price);
+    }
+    IndicatorOverlay overlay("SMA", "#ffff00");
+    overlay.points = line;
+    std::vector<ChartSeries> series{ChartSeries("Close", ChartType::LINE, "#00ff00")};
+    series[0].points = line;
+
+    std::cout << "Chart LOD benchmark: " << bars << " bars, " << width << " px wide\n\n";
+
+    ChartConfig config;
+    config.width = width;
+    HTMLChartRenderer renderer;
+    for (bool lod : {false, true})
+    {
+        config.level_of_detail = lod;
+        renderer.initialize(config);
+        std::string label = lod ? " (LOD)" : " (raw)";
+
+        double ms = time_ms([&]
+                            { renderer.render_candlestick_chart(candles, {overlay}, config); });
+        report(("candlestick+SMA" + label).c_str(), ms, renderer.get_chart_data("html"));
+
+        ms = time_ms([&]
+                     { renderer.render_line_chart(series, config); });
+        report(("line" + label).c_str(), ms, renderer.get_chart_data("html"));
+    }
+
+    // Reduction kernels
+    size_t budget = lod_budget(config, 1);
+    std::cout << "\nreduction to " << budget << " points:\n";
+    std::cout << "  bucket_candles    " << std::setprecision(3)
+              << time_ms([&]
+                         { bucket_candles(candles, budget / 2); }, 10)
+              << " ms\n";
+    std::cout << "  lttb_decimate     "
+              << time_ms([&]
+                         { lttb_decimate(line, budget); }, 10)
+              << " ms\n";
+    std::cout << "  min_max_decimate  "
+              << time_ms([&]
+                         { min_max_decimate(line, budget); }, 10)
+              << " ms\n";
+
+    // Zooming: halve the visible range around the middle, 12 steps
+    CandlestickPyramid pyramid;
+    double build_ms = time_ms([&]
+                              { pyramid.build(candles); });
+    size_t candle_budget = lod_budget(config, 2);
+    auto zoom = [&](const std::function<size_t(size_t, size_t)> &render_range)
+    {
+        size_t produced = 0;
+        size_t begin = 0;
+        size_t end = candles.size();
+        for (int step_index = 0; step_index < 12 && end - begin > 1; ++step_index)
+        {
+            produced += render_range(begin, end);
+            size_t quarter = (end - begin) / 4;
+            begin += quarter;
+            end -= quarter;
+        }
+        return produced;
+    };
+    double raw_zoom_ms = time_ms([&]
+                                 { zoom([&](size_t b, size_t e)
+                                        { return bucket_candles(candles.data() + b, e - b, candle_budget).size(); }); }, 10);
+    double pyramid_zoom_ms = time_ms([&]
+                                     { zoom([&](size_t b, size_t e)
+                                            { return pyramid.view(b, e, candle_budget).size(); }); }, 10);
+
+    std::cout << "\npyramid: " << pyramid.level_count() << " levels, built in " << build_ms << " ms\n";
+    std::cout << "12-step zoom, raw rescans: " << raw_zoom_ms << " ms\n";
+    std::cout << "12-step zoom, pyramid:     " << pyramid_zoom_ms << " ms ("
+              << std::setprecision(1) << raw_zoom_ms / pyramid_zoom_ms << "x)\n";
+    return 0;
+}
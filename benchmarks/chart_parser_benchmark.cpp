@@ -0,0 +1,144 @@
+// Chart response parsing benchmark
+// Builds a Yahoo-style chart response with num_points minute bars and
+// times the nlohmann DOM walk the client used to do against the streaming
+// parser, fed in network-sized chunks.
+//
+// Usage: chart_parser_benchmark [num_points] [chunk_bytes]
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <chrono>
+#include <sstream>
+#include <string>
+
+#include "data/chart_parser.h"
+#include "external/json.hpp"
+
+using namespace trading;
+using json = nlohmann::json;
+
+namespace
+{
+    template <typename F>
+    double time_seconds(F &&f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void report(const std::string &label, double seconds, size_t points, size_t bytes)
+    {
+        std::cout << std::left << std::setw(24) << label << std::right << std::fixed
+                  << std::setprecision(3) << seconds << " s, "
+                  << std::setprecision(0) << points / seconds << " points/s, "
+                  << std::setprecision(1) << bytes / seconds / (1024 * 1024) << " MB/s" << std::endl;
+    }
+
+    std::string make_response(size_t num_points)
+    {
+        std::mt19937_64 rng(5);
+        std::normal_distribution<double> step(0.0, 0.0005);
+        std::uniform_int_distribution<int> vol(1000, 5000);
+
+        std::vector<double> closes(num_points);
+        double price = 100.0;
+        for (auto &close : closes)
+        {
+            price *= 1.0 + step(rng);
+            close = price;
+        }
+
+        std::ostringstream out;
+        out << std::setprecision(10);
+        auto column = [&](const char *name, double scale)
+        {
+            out << "\"" << name << "\":[";
+            for (size_t i = 0; i < num_points; ++i)
+            {
+                out << (i ? "," : "") << closes[i] * scale;
+            }
+            out << "]";
+        };
+
+        out << "{\"chart\":{\"result\":[{\"meta\":{\"symbol\":\"BENCH\"},\"timestamp\":[";
+        for (size_t i = 0; i < num_points; ++i)
+        {
+            out << (i ? "," : "") << 1700000000 + 60 * i;
+        }
+        out << "],\"indicators\":{\"quote\":[{";
+        column("open", 0.999);
+        out << ",";
+        column("high", 1.001);
+        out << ",";
+        column("low", 0.998);
+        out << ",";
+        column("close", 1.0);
+        out << ",\"volume\":[";
+        for (size_t i = 0; i < num_points; ++i)
+        {
+            out << (i ? "," : "") << vol(rng);
+        }
+        out << "]}]}}],\"error\":null}}";
+        return out.str();
+    }
+
+    // What YahooFinanceClient did before the streaming parser
+    MarketDataSeries parse_dom(const std::string &body)
+    {
+        json j = json::parse(body);
+        MarketDataSeries series("BENCH");
+        auto result = j["chart"]["result"][0];
+        auto timestamp = result["timestamp"];
+        auto quote = result["indicators"]["quote"][0];
+        for (size_t i = 0; i < timestamp.size(); ++i)
+        {
+            series.add_point(MarketDataPoint(std::chrono::system_clock::from_time_t(timestamp[i].get<int64_t>()),
+                                             quote["open"][i].get<double>(), quote["high"][i].get<double>(),
+                                             quote["low"][i].get<double>(), quote["close"][i].get<double>(),
+                                             quote["volume"][i].get<int64_t>()));
+        }
+        return series;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t num_points = argc > 1 ? std::stoull(argv[1]) : 500000;
+    size_t chunk_bytes = argc > 2 ? std::stoull(argv[2]) : 16384;
+
+    std::cout << "=== Chart Parser Benchmark ===" << std::endl;
+    std::string body = make_response(num_points);
+    std::cout << num_points << " points, " << body.size() / (1024 * 1024) << " MB response, "
+              << chunk_bytes << " byte chunks" << std::endl;
+
+    double checksum = 0.0;
+
+    report("DOM (nlohmann)", time_seconds([&]
+                                          { checksum += parse_dom(body).back().close; }),
+           num_points, body.size());
+
+    report("Streaming (columnar)", time_seconds([&]
+                                                {
+        ChartStreamParser parser("BENCH");
+        for (size_t offset = 0; offset < body.size(); offset += chunk_bytes)
+        {
+            parser.feed(std::string_view(body).substr(offset, chunk_bytes));
+        }
+        checksum += parser.finish().close().back(); }),
+           num_points, body.size());
+
+    report("Streaming + to_series", time_seconds([&]
+                                                 {
+        ChartStreamParser parser("BENCH");
+        for (size_t offset = 0; offset < body.size(); offset += chunk_bytes)
+        {
+            parser.feed(std::string_view(body).substr(offset, chunk_bytes));
+        }
+        checksum += parser.finish().to_series().back().close; }),
+           num_points, body.size());
+
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,98 @@
+// Columnar export benchmark
+// Exports a synthetic minute-bar series through the CSV, Parquet (plain
+// and GZIP) and Feather exporters and reports write time, throughput and
+// file size for each, so the encodings (delta timestamps, dictionary
+// symbols) and compression can be weighed against plain text.
+//
+// Usage: columnar_export_benchmark [bars] [row_group_size]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <random>
+#include <filesystem>
+
+#include "visualization/data_export.h"
+#include "visualization/columnar_export.h"
+
+using namespace trading;
+using namespace trading::visualization;
+
+int main(int argc, char *argv[])
+{
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    size_t row_group_size = argc > 2 ? std::stoul(argv[2]) : 64 * 1024;
+
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> step(0.0, 0.05);
+    MarketDataSeries series("AAPL");
+    auto start = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+    double price = 100.0;
+    for (size_t i = 0; i < bars; ++i)
+    {
+        double open = price;
+        price += step(rng);
+        double high = std::max(open, price) + std::abs(step(rng));
+        double low = std::min(open, price) - std::abs(step(rng));
+        series.add_point(MarketDataPoint(start + std::chrono::minutes(i), open, high, low, price, 1000 + rng() % 5000));
+    }
+
+    auto dir = std::filesystem::temp_directory_path() / "columnar_export_benchmark";
+    std::filesystem::create_directories(dir);
+
+    struct Case
+    {
+        const char *name;
+        ExportFormat format;
+        ExportCompression compression;
+    };
+    std::vector<Case> cases = {
+        {"csv", ExportFormat::CSV, ExportCompression::NONE},
+        {"parquet", ExportFormat::PARQUET, ExportCompression::NONE},
+#ifdef HAVE_ZLIB
+        {"parquet+gzip", ExportFormat::PARQUET, ExportCompression::GZIP},
+#endif
+        {"feather", ExportFormat::FEATHER, ExportCompression::NONE},
+    };
+
+    std::cout << "Columnar export benchmark: " << bars << " bars, " << row_group_size << " rows per group\n\n";
+    double csv_bytes = 0.0;
+    for (const auto &c : cases)
+    {
+        auto exporter = ExportFactory::create_exporter(c.format);
+        auto path = dir / (std::string(c.name) + ExportFactory::get_file_extension(c.format));
+        ExportConfig config(path.string(), c.format);
+        config.compression = c.compression;
+        config.row_group_size = row_group_size;
+
+        auto t0 = std::chrono::steady_clock::now();
+        bool ok = exporter->export_market_data(series, config);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        if (!ok)
+        {
+            std::cout << c.name << ": export failed\n";
+            continue;
+        }
+
+        double bytes = static_cast<double>(std::filesystem::file_size(path));
+        if (c.format == ExportFormat::CSV)
+        {
+            csv_bytes = bytes;
+        }
+        std::cout << std::left << std::setw(14) << c.name << std::right
+                  << std::setw(10) << std::fixed << std::setprecision(1) << ms << " ms"
+                  << std::setw(10) << std::setprecision(1) << static_cast<double>(bars) / ms / 1000.0 << " Mrows/s"
+                  << std::setw(10) << std::setprecision(2) << bytes / (1024.0 * 1024.0) << " MiB"
+                  << std::setw(8) << std::setprecision(1) << bytes / static_cast<double>(bars) << " B/row";
+        if (csv_bytes > 0.0 && c.format != ExportFormat::CSV)
+        {
+            std::cout << std::setw(8) << std::setprecision(1) << csv_bytes / bytes << "x smaller";
+        }
+        std::cout << "\n";
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
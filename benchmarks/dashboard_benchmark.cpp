@@ -0,0 +1,198 @@
+// Dashboard refresh benchmark
+// A dashboard of price tickers refreshed on a timer, fed with quotes.
+// Compares the old refresh path (quotes serialised to strings and parsed
+// by set_data(), every widget re-marked and re-rendered on each refresh)
+// with typed snapshot channels and dirty-only rendering, where a quiet
+// ticker costs nothing per frame. Reports the cost of one frame and the
+// share of a core it takes at the refresh interval, then runs the render
+// thread against a live feed thread and reports the CPU both used.
+// Rendered text goes to a null stream.
+//
+// Usage: dashboard_benchmark [tickers] [refresh_ms] [active_percent]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <ctime>
+
+#include "visualization/dashboard.h"
+
+using namespace trading;
+using namespace trading::visualization;
+
+namespace
+{
+    // Discards everything written to it
+    class NullBuffer : public std::streambuf
+    {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+    };
+
+    double process_cpu_seconds()
+    {
+        timespec ts{};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+        return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+    }
+
+    std::unique_ptr<Dashboard> make_dashboard(size_t tickers, std::vector<PriceTickerWidget *> &widgets)
+    {
+        auto dashboard = std::make_unique<Dashboard>("Benchmark");
+        dashboard->add_panel(std::make_unique<DashboardPanel>("tickers", "Tickers", 0, 0, 1920, 1080));
+        widgets.clear();
+        for (size_t i = 0; i < tickers; ++i)
+        {
+            std::string symbol = "SYM" + std::to_string(i);
+            auto widget = std::make_unique<PriceTickerWidget>(
+                "ticker_" + symbol, WidgetConfig(WidgetType::PRICE_TICKER, symbol, 0, 0, 180, 80), symbol);
+            widgets.push_back(widget.get());
+            dashboard->add_widget_to_panel("tickers", std::move(widget));
+        }
+        return dashboard;
+    }
+
+    std::string quote_json(double price, double change, uint64_t volume)
+    {
+        std::ostringstream data;
+        data << "{\n  \"price\": " << price << ",\n  \"change\": " << change
+             << ",\n  \"volume\": " << volume << "\n}";
+        return data.str();
+    }
+
+    struct FrameCost
+    {
+        double micros_per_frame;
+        double widgets_per_frame;
+    };
+
+    // Old path: every refresh re-marks every widget, data arrives as strings
+    FrameCost run_legacy(size_t tickers, size_t active, size_t frames)
+    {
+        std::vector<PriceTickerWidget *> widgets;
+        auto dashboard = make_dashboard(tickers, widgets);
+        std::mt19937_64 rng(7);
+        std::uniform_real_distribution<double> move(-0.5, 0.5);
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t frame = 0; frame < frames; ++frame)
+        {
+            for (size_t i = 0; i < active; ++i)
+            {
+                auto *widget = widgets[rng() % tickers];
+                widget->set_data(quote_json(100.0 + move(rng), move(rng), 1000 + frame));
+            }
+            for (auto *widget : widgets)
+            {
+                widget->mark_for_update();
+            }
+            for (auto *widget : widgets)
+            {
+                widget->update();
+                widget->render();
+                widget->clear_render_flag();
+            }
+        }
+        double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        return {elapsed / static_cast<double>(frames), static_cast<double>(tickers)};
+    }
+
+    // New path: typed quotes published, only changed widgets drawn
+    FrameCost run_incremental(size_t tickers, size_t active, size_t frames)
+    {
+        std::vector<PriceTickerWidget *> widgets;
+        auto dashboard = make_dashboard(tickers, widgets);
+        dashboard->render_dirty(); // First full frame
+        std::mt19937_64 rng(7);
+        std::uniform_real_distribution<double> move(-0.5, 0.5);
+
+        uint64_t drawn = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t frame = 0; frame < frames; ++frame)
+        {
+            for (size_t i = 0; i < active; ++i)
+            {
+                double change = move(rng);
+                widgets[rng() % tickers]->update_price(100.0 + change, change, change, 1000 + frame);
+            }
+            dashboard->update();
+            drawn += dashboard->render_dirty();
+        }
+        double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        return {elapsed / static_cast<double>(frames), static_cast<double>(drawn) / static_cast<double>(frames)};
+    }
+
+    void print_cost(const char *name, const FrameCost &cost, double refresh_ms)
+    {
+        double core_percent = cost.micros_per_frame / (refresh_ms * 1000.0) * 100.0;
+        std::cout << std::left << std::setw(14) << name << std::right
+                  << std::setw(10) << std::fixed << std::setprecision(1) << cost.micros_per_frame << " us/frame"
+                  << std::setw(8) << std::setprecision(1) << cost.widgets_per_frame << " widgets/frame"
+                  << std::setw(9) << std::setprecision(3) << core_percent << "% of a core\n";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t tickers = argc > 1 ? std::stoul(argv[1]) : 50;
+    double refresh_ms = argc > 2 ? std::stod(argv[2]) : 100.0;
+    double active_percent = argc > 3 ? std::stod(argv[3]) : 10.0;
+    size_t active = std::max<size_t>(1, static_cast<size_t>(static_cast<double>(tickers) * active_percent / 100.0));
+    const size_t frames = 2000;
+
+    std::cout << "Dashboard benchmark: " << tickers << " tickers, " << refresh_ms << " ms refresh, "
+              << active << " quotes per frame\n\n";
+
+    NullBuffer null_buffer;
+    auto *old_buffer = std::cout.rdbuf(&null_buffer);
+    FrameCost legacy = run_legacy(tickers, active, frames);
+    FrameCost incremental = run_incremental(tickers, active, frames);
+    std::cout.rdbuf(old_buffer);
+
+    print_cost("legacy", legacy, refresh_ms);
+    print_cost("incremental", incremental, refresh_ms);
+    std::cout << "speedup: " << std::setprecision(1) << legacy.micros_per_frame / incremental.micros_per_frame << "x\n\n";
+
+    // Render thread against a feed thread publishing at frame rate
+    std::vector<PriceTickerWidget *> widgets;
+    auto dashboard = make_dashboard(tickers, widgets);
+    dashboard->set_refresh_interval(std::chrono::milliseconds(static_cast<int64_t>(refresh_ms)));
+    std::atomic<bool> stop{false};
+
+    std::cout.rdbuf(&null_buffer);
+    double cpu_start = process_cpu_seconds();
+    auto wall_start = std::chrono::steady_clock::now();
+    dashboard->start();
+    std::thread feed([&]
+                     {
+        std::mt19937_64 rng(11);
+        std::uniform_real_distribution<double> move(-0.5, 0.5);
+        auto period = std::chrono::microseconds(static_cast<int64_t>(refresh_ms * 1000.0 / static_cast<double>(active)));
+        auto next = std::chrono::steady_clock::now();
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            double change = move(rng);
+            widgets[rng() % widgets.size()]->update_price(100.0 + change, change, change, 1000);
+            next += period;
+            std::this_thread::sleep_until(next);
+        } });
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    stop = true;
+    feed.join();
+    dashboard->stop();
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    double cpu = process_cpu_seconds() - cpu_start;
+    std::cout.rdbuf(old_buffer);
+
+    std::cout << "render thread: " << dashboard->frames_rendered() << " frames, "
+              << dashboard->widgets_rendered() << " widget renders in " << std::setprecision(2) << wall << " s, "
+              << std::setprecision(3) << cpu / wall * 100.0 << "% of a core (feed + render)\n";
+    return 0;
+}
@@ -0,0 +1,241 @@
+// Memory pool benchmark
+// Compares the thread-caching MemoryPool with the mutex-guarded pool it
+// replaced and with operator new: allocate/free churn on several threads,
+// and cross-thread frees where one thread allocates what others release.
+// A last run puts std::map nodes on PoolResource.
+//
+// Usage: memory_pool_benchmark [operations_per_thread] [num_threads]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <map>
+#include <mutex>
+#include <functional>
+#include <memory_resource>
+
+#include "core/memory_pool.h"
+
+using namespace trading;
+
+namespace
+{
+    // The previous MemoryPool: one mutex around a single free list
+    class LegacyMemoryPool
+    {
+    public:
+        LegacyMemoryPool(size_t block_size, size_t initial_blocks)
+            : block_size_(std::max(block_size, sizeof(void *)))
+        {
+            expand(initial_blocks);
+        }
+
+        void *allocate()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (free_list_ == nullptr)
+            {
+                expand(std::max<size_t>(1, total_ / 2));
+            }
+            void *block = free_list_;
+            free_list_ = *static_cast<void **>(block);
+            return block;
+        }
+
+        void deallocate(void *ptr)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            *static_cast<void **>(ptr) = free_list_;
+            free_list_ = ptr;
+        }
+
+    private:
+        void expand(size_t num_blocks)
+        {
+            chunks_.push_back(std::make_unique<char[]>(block_size_ * num_blocks));
+            for (size_t i = 0; i < num_blocks; ++i)
+            {
+                void *block = chunks_.back().get() + i * block_size_;
+                *static_cast<void **>(block) = free_list_;
+                free_list_ = block;
+            }
+            total_ += num_blocks;
+        }
+
+        size_t block_size_;
+        size_t total_ = 0;
+        void *free_list_ = nullptr;
+        std::vector<std::unique_ptr<char[]>> chunks_;
+        std::mutex mutex_;
+    };
+
+    template <typename F>
+    double time_seconds(F &&f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void report(const std::string &label, double seconds, size_t operations)
+    {
+        std::cout << std::left << std::setw(34) << label << std::right << std::fixed
+                  << std::setprecision(3) << seconds << " s, "
+                  << std::setprecision(1) << operations / seconds / 1e6 << " M ops/s" << std::endl;
+    }
+
+    constexpr size_t kBlockSize = 64;
+    constexpr size_t kLive = 64; // Blocks each thread holds at once
+
+    // Each thread keeps a window of live blocks and replaces one per step
+    template <typename Alloc, typename Free>
+    double churn(size_t threads, size_t operations, Alloc alloc, Free release)
+    {
+        return time_seconds([&]
+                            {
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < threads; ++t)
+            {
+                workers.emplace_back([&]()
+                                     {
+                    std::vector<void *> live(kLive);
+                    for (auto &block : live)
+                    {
+                        block = alloc();
+                    }
+                    for (size_t i = 0; i < operations; ++i)
+                    {
+                        void *&block = live[i % kLive];
+                        release(block);
+                        block = alloc();
+                        static_cast<char *>(block)[0] = static_cast<char>(i);
+                    }
+                    for (auto *block : live)
+                    {
+                        release(block);
+                    } });
+            }
+            for (auto &worker : workers)
+            {
+                worker.join();
+            } });
+    }
+
+    // Thread t frees what thread t-1 allocated, in rounds
+    template <typename Alloc, typename Free>
+    double cross_thread(size_t threads, size_t operations, Alloc alloc, Free release)
+    {
+        const size_t batch = 4096;
+        const size_t rounds = operations / batch;
+        std::vector<std::vector<void *>> handoff(threads, std::vector<void *>(batch));
+        return time_seconds([&]
+                            {
+            for (size_t round = 0; round < rounds; ++round)
+            {
+                std::vector<std::thread> workers;
+                for (size_t t = 0; t < threads; ++t)
+                {
+                    workers.emplace_back([&, t]()
+                                         {
+                        // Allocated by another thread last round
+                        for (auto &block : handoff[t])
+                        {
+                            if (round > 0)
+                            {
+                                release(block);
+                            }
+                            block = alloc();
+                        } });
+                }
+                for (auto &worker : workers)
+                {
+                    worker.join();
+                }
+                std::rotate(handoff.begin(), handoff.begin() + 1, handoff.end());
+            }
+            for (auto &blocks : handoff)
+            {
+                for (auto *block : blocks)
+                {
+                    release(block);
+                }
+            } });
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t operations = argc > 1 ? std::stoull(argv[1]) : 2000000;
+    size_t threads = argc > 2 ? std::stoull(argv[2]) : std::max(2u, std::thread::hardware_concurrency());
+
+    std::cout << "=== Memory Pool Benchmark ===" << std::endl;
+    std::cout << operations << " operations per thread, " << threads << " threads, "
+              << kBlockSize << "-byte blocks" << std::endl;
+
+    const size_t total = operations * threads;
+
+    {
+        LegacyMemoryPool legacy(kBlockSize, 1024);
+        MemoryPool pool(kBlockSize, 1024);
+
+        report("Churn, legacy pool", churn(threads, operations, [&]
+                                           { return legacy.allocate(); }, [&](void *p)
+                                           { legacy.deallocate(p); }),
+               total);
+        report("Churn, operator new", churn(threads, operations, []
+                                            { return ::operator new(kBlockSize); }, [](void *p)
+                                            { ::operator delete(p); }),
+               total);
+        report("Churn, MemoryPool", churn(threads, operations, [&]
+                                          { return pool.allocate(); }, [&](void *p)
+                                          { pool.deallocate(p); }),
+               total);
+    }
+
+    {
+        LegacyMemoryPool legacy(kBlockSize, 1024);
+        MemoryPool pool(kBlockSize, 1024);
+
+        report("Cross-thread, legacy pool", cross_thread(threads, operations, [&]
+                                                         { return legacy.allocate(); }, [&](void *p)
+                                                         { legacy.deallocate(p); }),
+               total);
+        report("Cross-thread, MemoryPool", cross_thread(threads, operations, [&]
+                                                        { return pool.allocate(); }, [&](void *p)
+                                                        { pool.deallocate(p); }),
+               total);
+    }
+
+    // Node containers: one allocation per insert
+    const size_t nodes = operations / 4;
+    size_t checksum = 0;
+    auto fill = [&](auto &map)
+    {
+        for (size_t i = 0; i < nodes; ++i)
+        {
+            map.emplace(static_cast<int>(i * 2654435761u % nodes), static_cast<double>(i));
+        }
+        checksum += map.size();
+    };
+
+    report("std::map, std::allocator", time_seconds([&]
+                                                    {
+        std::map<int, double> map;
+        fill(map); }),
+           nodes);
+
+    PoolResource resource;
+    report("std::map, PoolAllocator", time_seconds([&]
+                                                   {
+        std::map<int, double, std::less<int>, PoolAllocator<std::pair<const int, double>>> map{
+            PoolAllocator<std::pair<const int, double>>(resource)};
+        fill(map); }),
+           nodes);
+
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,433 @@
+// Order book benchmark
+// Replays an ITCH-like binary message file (add, execute, partial cancel,
+// delete, replace) through OrderBook and through a std::map/std::list book
+// of the kind it replaces, reporting messages/sec and the median and tail
+// latency of each message type. Without a file argument a synthetic feed
+// is generated first: a random-walking mid price with orders clustered
+// around it, roughly the message mix of a liquid equity.
+//
+// Message layout (little-endian, each preceded by a uint16 length as in
+// SoupBinTCP framing):
+//   'A' side(u8) id(u64) price(u32, 1/10000) shares(u32)
+//   'E' id(u64) shares(u32)        executed against the order
+//   'X' id(u64) shares(u32)        partial cancel
+//   'D' id(u64)                    delete
+//   'U' id(u64) new_id(u64) price(u32) shares(u32)
+//
+// Usage: order_book_benchmark [messages] [file]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <map>
+#include <list>
+#include <unordered_map>
+#include <random>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+#include "data/order_book.h"
+
+using namespace trading;
+
+namespace
+{
+    constexpr double kPriceScale = 10000.0;
+
+    // Book built from std::map levels of std::list orders with a hash index
+    class MapOrderBook
+    {
+    public:
+        bool add(uint64_t id, BookSide side, double price, uint64_t quantity)
+        {
+            int64_t tick = std::llround(price * kPriceScale);
+            auto &levels = side == BookSide::BID ? bids_ : asks_;
+            auto &queue = levels[tick];
+            queue.push_back(Entry{id, quantity});
+            return orders_.emplace(id, Handle{side, tick, std::prev(queue.end())}).second;
+        }
+
+        bool reduce(uint64_t id, uint64_t quantity)
+        {
+            auto it = orders_.find(id);
+            if (it == orders_.end())
+            {
+                return false;
+            }
+            if (quantity >= it->second.entry->quantity)
+            {
+                return cancel(id);
+            }
+            it->second.entry->quantity -= quantity;
+            return true;
+        }
+
+        bool cancel(uint64_t id)
+        {
+            auto it = orders_.find(id);
+            if (it == orders_.end())
+            {
+                return false;
+            }
+            auto &levels = it->second.side == BookSide::BID ? bids_ : asks_;
+            auto level = levels.find(it->second.tick);
+            level->second.erase(it->second.entry);
+            if (level->second.empty())
+            {
+                levels.erase(level);
+            }
+            orders_.erase(it);
+            return true;
+        }
+
+        bool replace(uint64_t id, uint64_t new_id, double price, uint64_t quantity)
+        {
+            auto it = orders_.find(id);
+            if (it == orders_.end())
+            {
+                return false;
+            }
+            BookSide side = it->second.side;
+            cancel(id);
+            return add(new_id, side, price, quantity);
+        }
+
+        std::optional<double> best_bid() const
+        {
+            if (bids_.empty())
+            {
+                return std::nullopt;
+            }
+            return bids_.rbegin()->first / kPriceScale;
+        }
+        size_t order_count() const { return orders_.size(); }
+
+    private:
+        struct Entry
+        {
+            uint64_t id;
+            uint64_t quantity;
+        };
+
+        struct Handle
+        {
+            BookSide side;
+            int64_t tick;
+            std::list<Entry>::iterator entry;
+        };
+
+        std::map<int64_t, std::list<Entry>> bids_;
+        std::map<int64_t, std::list<Entry>> asks_;
+        std::unordered_map<uint64_t, Handle> orders_;
+    };
+
+    enum MessageType : char
+    {
+        ADD = 'A',
+        EXECUTE = 'E',
+        CANCEL = 'X',
+        DELETE = 'D',
+        REPLACE = 'U'
+    };
+
+    struct Message
+    {
+        char type = 0;
+        uint8_t side = 0;
+        uint64_t id = 0;
+        uint64_t new_id = 0;
+        uint32_t price = 0;
+        uint32_t shares = 0;
+    };
+
+    class Writer
+    {
+    public:
+        explicit Writer(const std::string &path) : out_(path, std::ios::binary) {}
+
+        void write(const Message &message)
+        {
+            char body[32];
+            size_t length = 0;
+            auto put = [&](const void *data, size_t size)
+            {
+                std::memcpy(body + length, data, size);
+                length += size;
+            };
+            put(&message.type, 1);
+            switch (message.type)
+            {
+            case ADD:
+                put(&message.side, 1);
+                put(&message.id, 8);
+                put(&message.price, 4);
+                put(&message.shares, 4);
+                break;
+            case EXECUTE:
+            case CANCEL:
+                put(&message.id, 8);
+                put(&message.shares, 4);
+                break;
+            case DELETE:
+                put(&message.id, 8);
+                break;
+            case REPLACE:
+                put(&message.id, 8);
+                put(&message.new_id, 8);
+                put(&message.price, 4);
+                put(&message.shares, 4);
+                break;
+            }
+            uint16_t frame = static_cast<uint16_t>(length);
+            out_.write(reinterpret_cast<const char *>(&frame), sizeof(frame));
+            out_.write(body, static_cast<std::streamsize>(length));
+        }
+
+    private:
+        std::ofstream out_;
+    };
+
+    // Decodes the whole file up front so the replay measures only the book
+    std::vector<Message> read_messages(const std::string &path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::vector<Message> messages;
+
+        size_t pos = 0;
+        while (pos + 2 <= bytes.size())
+        {
+            uint16_t frame;
+            std::memcpy(&frame, &bytes[pos], 2);
+            const char *body = &bytes[pos + 2];
+            pos += 2 + frame;
+            if (pos > bytes.size())
+            {
+                break;
+            }
+
+            Message message;
+            size_t at = 1;
+            auto get = [&](void *data, size_t size)
+            {
+                std::memcpy(data, body + at, size);
+                at += size;
+            };
+            message.type = body[0];
+            switch (message.type)
+            {
+            case ADD:
+                get(&message.side, 1);
+                get(&message.id, 8);
+                get(&message.price, 4);
+                get(&message.shares, 4);
+                break;
+            case EXECUTE:
+            case CANCEL:
+                get(&message.id, 8);
+                get(&message.shares, 4);
+                break;
+            case DELETE:
+                get(&message.id, 8);
+                break;
+            case REPLACE:
+                get(&message.id, 8);
+                get(&message.new_id, 8);
+                get(&message.price, 4);
+                get(&message.shares, 4);
+                break;
+            default:
+                continue;
+            }
+            messages.push_back(message);
+        }
+        return messages;
+    }
+
+    void generate(const std::string &path, size_t count)
+    {
+        std::mt19937_64 rng(42);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        Writer writer(path);
+
+        struct Live
+        {
+            uint64_t id;
+            uint32_t shares;
+            uint32_t price;
+            uint8_t side;
+        };
+        std::vector<Live> live;
+        uint64_t next_id = 1;
+        double mid = 1000000.0; // $100.00 in 1/10000
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            mid += (unit(rng) - 0.5) * 200.0;
+            double roll = unit(rng);
+
+            if (live.size() < 200 || roll < 0.45)
+            {
+                uint8_t side = unit(rng) < 0.5 ? 'B' : 'S';
+                uint32_t offset = 100 * (1 + static_cast<uint32_t>(unit(rng) * unit(rng) * 40));
+                int64_t tick = std::llround(mid / 100.0) * 100;
+                auto price = static_cast<uint32_t>(side == 'B' ? tick - offset : tick + offset);
+                Message message{ADD, side, next_id, 0, price, 100 * (1 + static_cast<uint32_t>(unit(rng) * 10))};
+                live.push_back(Live{next_id++, message.shares, price, side});
+                writer.write(message);
+                continue;
+            }
+
+            size_t pick = static_cast<size_t>(unit(rng) * live.size());
+            Live &order = live[pick];
+            if (roll < 0.80)
+            {
+                writer.write(Message{DELETE, 0, order.id, 0, 0, 0});
+                live[pick] = live.back();
+                live.pop_back();
+            }
+            else if (roll < 0.96)
+            {
+                MessageType type = roll < 0.88 ? EXECUTE : CANCEL;
+                uint32_t shares = std::max<uint32_t>(1, order.shares / 2);
+                writer.write(Message{type, 0, order.id, 0, 0, shares});
+                order.shares -= shares;
+                if (order.shares == 0)
+                {
+                    live[pick] = live.back();
+                    live.pop_back();
+                }
+            }
+            else
+            {
+                uint32_t price = order.side == 'B' ? order.price - 100 : order.price + 100;
+                writer.write(Message{REPLACE, 0, order.id, next_id, price, order.shares});
+                order.id = next_id++;
+                order.price = price;
+            }
+        }
+    }
+
+    struct Timings
+    {
+        std::map<char, std::vector<int64_t>> by_type;
+        double seconds = 0.0;
+    };
+
+    template <typename Book>
+    void apply(Book &book, const Message &message)
+    {
+        switch (message.type)
+        {
+        case ADD:
+            book.add(message.id, message.side == 'B' ? BookSide::BID : BookSide::ASK, message.price / kPriceScale, message.shares);
+            break;
+        case EXECUTE:
+        case CANCEL:
+            book.reduce(message.id, message.shares);
+            break;
+        case DELETE:
+            book.cancel(message.id);
+            break;
+        case REPLACE:
+            book.replace(message.id, message.new_id, message.price / kPriceScale, message.shares);
+            break;
+        }
+    }
+
+    // Per-message timing on a second pass; the first pass gives throughput
+    template <typename Book>
+    Timings replay(const std::vector<Message> &messages, std::function<std::unique_ptr<Book>()> make, double &checksum)
+    {
+        Timings timings;
+        {
+            auto book = make();
+            auto start = std::chrono::steady_clock::now();
+            for (const auto &message : messages)
+            {
+                apply(*book, message);
+            }
+            timings.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            checksum += book->order_count();
+        }
+        {
+            auto book = make();
+            for (const auto &message : messages)
+            {
+                auto start = std::chrono::steady_clock::now();
+                apply(*book, message);
+                auto end = std::chrono::steady_clock::now();
+                timings.by_type[message.type].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            }
+            checksum += book->best_bid().value_or(0.0);
+        }
+        return timings;
+    }
+
+    int64_t percentile(std::vector<int64_t> &values, double q)
+    {
+        size_t rank = std::min(values.size() - 1, static_cast<size_t>(q * values.size()));
+        std::nth_element(values.begin(), values.begin() + rank, values.end());
+        return values[rank];
+    }
+
+    void report(const std::string &label, Timings timings, size_t messages)
+    {
+        std::cout << label << ": " << std::fixed << std::setprecision(1)
+                  << messages / timings.seconds / 1e6 << " M msgs/s" << std::endl;
+        for (auto &[type, values] : timings.by_type)
+        {
+            std::cout << "  '" << type << "' " << std::setw(9) << values.size() << " msgs   p50 "
+                      << std::setw(5) << percentile(values, 0.50) << " ns   p99 "
+                      << std::setw(6) << percentile(values, 0.99) << " ns   p99.9 "
+                      << std::setw(7) << percentile(values, 0.999) << " ns" << std::endl;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? std::stoull(argv[1]) : 2000000;
+    std::string path = argc > 2 ? argv[2] : (std::filesystem::temp_directory_path() / "order_book_feed.itch").string();
+    bool generated = argc <= 2 || !std::filesystem::exists(path);
+
+    std::cout << "=== Order Book Benchmark ===" << std::endl;
+    if (generated)
+    {
+        generate(path, count);
+    }
+    auto messages = read_messages(path);
+    std::cout << messages.size() << " messages from " << path << std::endl;
+
+    // Timer overhead, to read the per-message numbers against
+    std::vector<int64_t> overhead;
+    for (int i = 0; i < 100000; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto end = std::chrono::steady_clock::now();
+        overhead.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+    std::cout << "(timer overhead p50 " << percentile(overhead, 0.5) << " ns, included below)" << std::endl;
+
+    double checksum = 0.0;
+    report("std::map book", replay<MapOrderBook>(messages, []
+                                                  { return std::make_unique<MapOrderBook>(); }, checksum),
+           messages.size());
+    report("OrderBook", replay<OrderBook>(messages, []
+                                          { return std::make_unique<OrderBook>(0.0001, 8192, 1 << 16); }, checksum),
+           messages.size());
+
+    if (generated && argc <= 2)
+    {
+        std::filesystem::remove(path);
+    }
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    return 0;
+}
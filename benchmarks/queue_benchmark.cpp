@@ -0,0 +1,367 @@
+// Queue benchmark
+// Measures throughput and enqueue-to-dequeue latency of the lock-free
+// queues at different producer/consumer counts: the SPSC LockFreeQueue
+// (against the compare-and-swap version it replaced) at 1:1, and
+// MpmcQueue with single-element and bulk calls at every shape.
+// Latency is sampled on every 16th element and reported as percentiles.
+// A last run feeds a blocking consumer at a trickle and reports the CPU
+// time each wait strategy burns while waiting.
+//
+// Usage: queue_benchmark [items_per_producer] [capacity] [batch]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <span>
+#include <cstdint>
+#include <ctime>
+
+#include "core/lock_free_queue.h"
+#include "core/mpmc_queue.h"
+
+using namespace trading;
+
+namespace
+{
+    // The previous LockFreeQueue: per-slot sequence numbers, both indices on
+    // one cache line, and a weak compare-and-swap on every push and pop
+    template <typename T>
+    class LegacySpscQueue
+    {
+    public:
+        explicit LegacySpscQueue(size_t capacity)
+        {
+            capacity_ = 1;
+            while (capacity_ < capacity)
+            {
+                capacity_ <<= 1;
+            }
+            mask_ = capacity_ - 1;
+            buffer_ = std::make_unique<Node[]>(capacity_);
+            for (size_t i = 0; i < capacity_; ++i)
+            {
+                buffer_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        bool try_push(const T &value)
+        {
+            size_t head = head_.load(std::memory_order_relaxed);
+            size_t tail = tail_.load(std::memory_order_acquire);
+            if (head - tail >= capacity_)
+            {
+                return false;
+            }
+            Node &node = buffer_[head & mask_];
+            if (node.sequence.load(std::memory_order_acquire) != head ||
+                !head_.compare_exchange_weak(head, head + 1, std::memory_order_relaxed))
+            {
+                return false;
+            }
+            node.data = value;
+            node.sequence.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_pop(T &value)
+        {
+            size_t tail = tail_.load(std::memory_order_relaxed);
+            size_t head = head_.load(std::memory_order_acquire);
+            if (tail >= head)
+            {
+                return false;
+            }
+            Node &node = buffer_[tail & mask_];
+            if (node.sequence.load(std::memory_order_acquire) != tail + 1 ||
+                !tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+            {
+                return false;
+            }
+            value = std::move(node.data);
+            node.sequence.store(tail + capacity_, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        struct Node
+        {
+            T data;
+            std::atomic<size_t> sequence{0};
+        };
+
+        std::unique_ptr<Node[]> buffer_;
+        size_t capacity_;
+        size_t mask_;
+        std::atomic<size_t> head_{0};
+        std::atomic<size_t> tail_{0};
+    };
+
+    struct Item
+    {
+        int64_t enqueued_ns = 0;
+        uint64_t value = 0;
+    };
+
+    int64_t now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    constexpr size_t kSampleEvery = 16;
+
+    struct RunResult
+    {
+        double seconds = 0.0;
+        std::vector<int64_t> latencies;
+        uint64_t checksum = 0;
+    };
+
+    // Push and pop take a span and return how many elements they moved, so
+    // the single-element and bulk variants share one driver
+    template <typename Push, typename Pop>
+    RunResult run(size_t producers, size_t consumers, size_t items, size_t batch, Push push, Pop pop)
+    {
+        const size_t total = producers * items;
+        std::atomic<size_t> consumed{0};
+        std::atomic<uint64_t> checksum{0};
+        std::vector<std::vector<int64_t>> samples(consumers);
+        std::atomic<size_t> ready{0};
+        std::atomic<bool> go{false};
+
+        std::vector<std::thread> threads;
+        for (size_t p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&, p]()
+                                 {
+                std::vector<Item> buffer(batch);
+                ++ready;
+                while (!go.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+                size_t sent = 0;
+                while (sent < items)
+                {
+                    size_t n = std::min(batch, items - sent);
+                    int64_t stamp = now_ns();
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        buffer[i] = Item{stamp, p * items + sent + i};
+                    }
+                    size_t pushed = 0;
+                    while (pushed < n)
+                    {
+                        size_t k = push(std::span<Item>(buffer).subspan(pushed, n - pushed));
+                        if (k == 0)
+                        {
+                            std::this_thread::yield();
+                        }
+                        pushed += k;
+                    }
+                    sent += n;
+                } });
+        }
+        for (size_t c = 0; c < consumers; ++c)
+        {
+            threads.emplace_back([&, c]()
+                                 {
+                std::vector<Item> buffer(batch);
+                auto &mine = samples[c];
+                mine.reserve(total / kSampleEvery / consumers + 16);
+                uint64_t local_sum = 0;
+                size_t local_count = 0;
+                ++ready;
+                while (!go.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+                while (consumed.load(std::memory_order_relaxed) < total)
+                {
+                    size_t n = pop(std::span<Item>(buffer));
+                    if (n == 0)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    int64_t now = now_ns();
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        local_sum += buffer[i].value;
+                        if (++local_count % kSampleEvery == 0)
+                        {
+                            mine.push_back(now - buffer[i].enqueued_ns);
+                        }
+                    }
+                    consumed.fetch_add(n, std::memory_order_relaxed);
+                }
+                checksum += local_sum; });
+        }
+
+        while (ready.load() < producers + consumers)
+        {
+            std::this_thread::yield();
+        }
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        RunResult result;
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.checksum = checksum.load();
+        for (auto &consumer_samples : samples)
+        {
+            result.latencies.insert(result.latencies.end(), consumer_samples.begin(), consumer_samples.end());
+        }
+        return result;
+    }
+
+    double percentile_us(std::vector<int64_t> &values, double q)
+    {
+        if (values.empty())
+        {
+            return 0.0;
+        }
+        size_t rank = std::min(values.size() - 1, static_cast<size_t>(q * values.size()));
+        std::nth_element(values.begin(), values.begin() + rank, values.end());
+        return values[rank] / 1000.0;
+    }
+
+    void report(const std::string &label, RunResult result, size_t operations)
+    {
+        std::cout << std::left << std::setw(30) << label << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(8) << operations / result.seconds / 1e6 << " M ops/s"
+                  << "   p50 " << std::setw(9) << std::setprecision(2) << percentile_us(result.latencies, 0.50)
+                  << " us   p99 " << std::setw(9) << percentile_us(result.latencies, 0.99)
+                  << " us   p99.9 " << std::setw(9) << percentile_us(result.latencies, 0.999) << " us"
+                  << std::endl;
+    }
+
+    double thread_cpu_seconds()
+    {
+        timespec ts{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return ts.tv_sec + ts.tv_nsec / 1e9;
+    }
+
+    // One item every gap_us microseconds into a consumer blocked in pop()
+    template <typename Queue>
+    void run_trickle(const std::string &label, size_t items, int gap_us, uint64_t &checksum)
+    {
+        Queue queue(64);
+        std::vector<int64_t> latencies;
+        latencies.reserve(items);
+        double consumer_cpu = 0.0;
+
+        auto start = std::chrono::steady_clock::now();
+        std::thread consumer([&]()
+                             {
+            double cpu_start = thread_cpu_seconds();
+            Item item;
+            for (size_t i = 0; i < items; ++i)
+            {
+                queue.pop(item);
+                latencies.push_back(now_ns() - item.enqueued_ns);
+                checksum += item.value;
+            }
+            consumer_cpu = thread_cpu_seconds() - cpu_start; });
+        for (size_t i = 0; i < items; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(gap_us));
+            queue.push(Item{now_ns(), i});
+        }
+        consumer.join();
+        double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << std::left << std::setw(30) << label << std::right << std::fixed << std::setprecision(2)
+                  << "consumer CPU " << std::setw(6) << 100.0 * consumer_cpu / wall << "%"
+                  << "   p50 " << std::setw(9) << percentile_us(latencies, 0.50)
+                  << " us   p99 " << std::setw(9) << percentile_us(latencies, 0.99) << " us" << std::endl;
+    }
+
+    std::string shape(size_t producers, size_t consumers, const std::string &variant)
+    {
+        return std::to_string(producers) + "P/" + std::to_string(consumers) + "C " + variant;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t items = argc > 1 ? std::stoull(argv[1]) : 2000000;
+    size_t capacity = argc > 2 ? std::stoull(argv[2]) : 1024;
+    size_t batch = argc > 3 ? std::stoull(argv[3]) : 32;
+
+    std::cout << "=== Queue Benchmark ===" << std::endl;
+    std::cout << items << " items per producer, capacity " << capacity << ", bulk batch " << batch
+              << ", " << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+
+    uint64_t checksum = 0;
+
+    // SPSC, 1:1
+    {
+        LegacySpscQueue<Item> legacy(capacity);
+        auto result = run(1, 1, items, 1, [&](std::span<Item> in)
+                          { return legacy.try_push(in[0]) ? size_t{1} : size_t{0}; }, [&](std::span<Item> out)
+                          { return legacy.try_pop(out[0]) ? size_t{1} : size_t{0}; });
+        checksum += result.checksum;
+        report(shape(1, 1, "legacy SPSC"), std::move(result), items);
+    }
+    {
+        LockFreeQueue<Item> queue(capacity);
+        auto result = run(1, 1, items, 1, [&](std::span<Item> in)
+                          { return queue.try_push(in[0]) ? size_t{1} : size_t{0}; }, [&](std::span<Item> out)
+                          { return queue.try_pop(out[0]) ? size_t{1} : size_t{0}; });
+        checksum += result.checksum;
+        report(shape(1, 1, "LockFreeQueue"), std::move(result), items);
+    }
+    {
+        LockFreeQueue<Item> queue(capacity);
+        auto result = run(1, 1, items, batch, [&](std::span<Item> in)
+                          { return queue.try_push_bulk(in); }, [&](std::span<Item> out)
+                          { return queue.try_pop_bulk(out); });
+        checksum += result.checksum;
+        report(shape(1, 1, "LockFreeQueue bulk"), std::move(result), items);
+    }
+
+    // MPMC at several shapes
+    const std::pair<size_t, size_t> shapes[] = {{1, 1}, {2, 1}, {4, 1}, {2, 2}, {4, 4}};
+    for (auto [producers, consumers] : shapes)
+    {
+        {
+            MpmcQueue<Item> queue(capacity);
+            auto result = run(producers, consumers, items, 1, [&](std::span<Item> in)
+                              { return queue.try_push(in[0]) ? size_t{1} : size_t{0}; }, [&](std::span<Item> out)
+                              { return queue.try_pop(out[0]) ? size_t{1} : size_t{0}; });
+            checksum += result.checksum;
+            report(shape(producers, consumers, "MpmcQueue"), std::move(result), producers * items);
+        }
+        {
+            MpmcQueue<Item> queue(capacity);
+            auto result = run(producers, consumers, items, batch, [&](std::span<Item> in)
+                              { return queue.try_push_bulk(in); }, [&](std::span<Item> out)
+                              { return queue.try_pop_bulk(out); });
+            checksum += result.checksum;
+            report(shape(producers, consumers, "MpmcQueue bulk"), std::move(result), producers * items);
+        }
+    }
+
+    // Blocking consumer fed at a trickle: latency against CPU burned while idle
+    const size_t trickle_items = 2000;
+    const int gap_us = 200;
+    std::cout << "Trickle feed: " << trickle_items << " items, one every " << gap_us << " us" << std::endl;
+    run_trickle<LockFreeQueue<Item, BusySpinWait>>("1P/1C BusySpinWait", trickle_items, gap_us, checksum);
+    run_trickle<LockFreeQueue<Item, SpinThenYieldWait>>("1P/1C SpinThenYieldWait", trickle_items, gap_us, checksum);
+    run_trickle<LockFreeQueue<Item, ParkingWait>>("1P/1C ParkingWait", trickle_items, gap_us, checksum);
+
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,111 @@
+// Parameter sweep benchmark
+// Compares the shared-column ParameterSweep against the naive approach of
+// copying the series and recomputing indicators for every job.
+//
+// Usage: sweep_benchmark [num_symbols] [bars_per_symbol]
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+#include "strategies/parameter_sweep.h"
+#include "strategies/sma_crossover.h"
+
+using namespace trading;
+
+namespace
+{
+    std::shared_ptr<const MarketDataSeries> generate_series(const std::string &symbol, size_t num_bars, uint64_t seed)
+    {
+        auto series = std::make_shared<MarketDataSeries>(symbol);
+        series->reserve(num_bars);
+
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<double> step(0.0, 0.002);
+
+        auto timestamp = std::chrono::system_clock::time_point{};
+        double price = 100.0;
+        for (size_t i = 0; i < num_bars; ++i)
+        {
+            double close = price * std::exp(step(rng));
+            series->add_point(MarketDataPoint(timestamp, price, std::max(price, close), std::min(price, close), close, 1000));
+            timestamp += std::chrono::minutes(1);
+            price = close;
+        }
+        return series;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t num_symbols = argc > 1 ? std::stoull(argv[1]) : 50;
+    size_t num_bars = argc > 2 ? std::stoull(argv[2]) : 20000;
+
+    std::cout << "=== Parameter Sweep Benchmark ===" << std::endl;
+
+    std::vector<std::shared_ptr<const MarketDataSeries>> universe;
+    for (size_t s = 0; s < num_symbols; ++s)
+    {
+        universe.push_back(generate_series("SYM" + std::to_string(s), num_bars, s + 1));
+    }
+
+    auto grid = ParameterSweep::make_grid({{"fast", {5, 10, 15, 20}}, {"slow", {30, 50, 100, 200}}});
+    size_t total_jobs = universe.size() * grid.size();
+    std::cout << num_symbols << " symbols x " << grid.size() << " parameter sets = "
+              << total_jobs << " jobs, " << num_bars << " bars each" << std::endl;
+
+    auto pool = std::make_shared<ThreadPool>();
+    BacktestConfig config;
+
+    // Shared, memoized indicator columns
+    ParameterSweep sweep(pool, config);
+    auto results = sweep.run(universe, grid, [](const ParameterSet &params, IndicatorColumns &columns)
+                             { return std::make_unique<SmaCrossoverStrategy>(
+                                   columns.sma(static_cast<int>(params.get("fast"))),
+                                   columns.sma(static_cast<int>(params.get("slow")))); });
+
+    std::cout << "ParameterSweep: " << std::fixed << std::setprecision(3) << results.elapsed_seconds << " s ("
+              << std::setprecision(0) << total_jobs / results.elapsed_seconds << " jobs/s)" << std::endl;
+
+    // Naive baseline: copy the series and recompute all indicators per job
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::future<double>> futures;
+    futures.reserve(total_jobs);
+    for (const auto &series : universe)
+    {
+        for (const auto &params : grid)
+        {
+            futures.push_back(pool->submit([series_copy = *series, params, config]()
+                                           {
+                                               DataProcessor processor;
+                                               auto indicators = processor.calculate_indicators(series_copy);
+                                               std::vector<double> prices;
+                                               for (const auto &point : series_copy.data())
+                                               {
+                                                   prices.push_back(point.close);
+                                               }
+                                               auto fast = std::make_shared<const std::vector<double>>(
+                                                   processor.calculate_sma(prices, static_cast<int>(params.get("fast"))));
+                                               auto slow = std::make_shared<const std::vector<double>>(
+                                                   processor.calculate_sma(prices, static_cast<int>(params.get("slow"))));
+                                               BacktestEngine engine(config);
+                                               SmaCrossoverStrategy strategy(fast, slow);
+                                               return engine.run(series_copy, strategy).final_equity; }));
+        }
+    }
+    for (auto &future : futures)
+    {
+        future.get();
+    }
+    double naive_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Naive per-job:  " << std::fixed << std::setprecision(3) << naive_seconds << " s ("
+              << std::setprecision(0) << total_jobs / naive_seconds << " jobs/s)" << std::endl;
+    std::cout << "Speedup: " << std::setprecision(1) << naive_seconds / results.elapsed_seconds << "x" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,213 @@
+// Thread pool benchmark
+// Compares the work-stealing ThreadPool with the single-queue pool it
+// replaced on fine-grained tasks: one future per task, a batch of tasks,
+// and parallel_for against chunked submission. A last run measures
+// hot-path latency while slow background writes are queued, with and
+// without a dedicated background lane.
+//
+// Usage: thread_pool_benchmark [num_tasks] [num_threads]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <queue>
+#include <vector>
+#include <cmath>
+
+#include "core/thread_pool.h"
+
+using namespace trading;
+
+namespace
+{
+    // The previous ThreadPool: one mutex-guarded std::queue of
+    // std::function, each task a shared_ptr<packaged_task>
+    class LegacyThreadPool
+    {
+    public:
+        explicit LegacyThreadPool(size_t num_threads)
+        {
+            for (size_t i = 0; i < num_threads; ++i)
+            {
+                workers_.emplace_back([this]()
+                                      {
+                    while (true)
+                    {
+                        std::function<void()> task;
+                        {
+                            std::unique_lock<std::mutex> lock(mutex_);
+                            condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                            if (stop_ && tasks_.empty())
+                            {
+                                return;
+                            }
+                            task = std::move(tasks_.front());
+                            tasks_.pop();
+                        }
+                        task();
+                    } });
+            }
+        }
+
+        ~LegacyThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            condition_.notify_all();
+            for (auto &worker : workers_)
+            {
+                worker.join();
+            }
+        }
+
+        template <typename F>
+        auto submit(F &&task) -> std::future<std::invoke_result_t<F>>
+        {
+            using return_type = std::invoke_result_t<F>;
+            auto packaged_task = std::make_shared<std::packaged_task<return_type()>>(std::forward<F>(task));
+            auto result = packaged_task->get_future();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                tasks_.emplace([packaged_task]()
+                               { (*packaged_task)(); });
+            }
+            condition_.notify_one();
+            return result;
+        }
+
+    private:
+        std::vector<std::thread> workers_;
+        std::queue<std::function<void()>> tasks_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        bool stop_ = false;
+    };
+
+    template <typename F>
+    double time_seconds(F &&f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void report(const std::string &label, double seconds, size_t tasks)
+    {
+        std::cout << std::left << std::setw(34) << label << std::right << std::fixed
+                  << std::setprecision(3) << seconds << " s, "
+                  << std::setprecision(0) << tasks / seconds << " tasks/s" << std::endl;
+    }
+
+    // A few hundred nanoseconds of work, like one symbol's indicator update
+    double tiny_work(size_t i)
+    {
+        double x = static_cast<double>(i);
+        for (int k = 0; k < 32; ++k)
+        {
+            x = std::sqrt(x + k);
+        }
+        return x;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t num_tasks = argc > 1 ? std::stoull(argv[1]) : 500000;
+    size_t num_threads = argc > 2 ? std::stoull(argv[2]) : std::max(2u, std::thread::hardware_concurrency());
+
+    std::cout << "=== Thread Pool Benchmark ===" << std::endl;
+    std::cout << num_tasks << " tasks, " << num_threads << " threads" << std::endl;
+
+    double checksum = 0.0;
+
+    {
+        LegacyThreadPool legacy(num_threads);
+        report("Legacy submit (future per task)", time_seconds([&]
+                                                              {
+            std::vector<std::future<double>> futures;
+            futures.reserve(num_tasks);
+            for (size_t i = 0; i < num_tasks; ++i)
+            {
+                futures.push_back(legacy.submit([i]() { return tiny_work(i); }));
+            }
+            for (auto &future : futures)
+            {
+                checksum += future.get();
+            } }),
+               num_tasks);
+    }
+
+    ThreadPool pool(num_threads);
+
+    report("submit (future per task)", time_seconds([&]
+                                                    {
+        std::vector<std::future<double>> futures;
+        futures.reserve(num_tasks);
+        for (size_t i = 0; i < num_tasks; ++i)
+        {
+            futures.push_back(pool.submit([i]() { return tiny_work(i); }));
+        }
+        for (auto &future : futures)
+        {
+            checksum += future.get();
+        } }),
+           num_tasks);
+
+    report("submit_batch", time_seconds([&]
+                                        {
+        auto futures = pool.submit_batch(num_tasks, [](size_t i) { return tiny_work(i); });
+        for (auto &future : futures)
+        {
+            checksum += future.get();
+        } }),
+           num_tasks);
+
+    std::vector<double> results(num_tasks);
+    report("parallel_for", time_seconds([&]
+                                        { pool.parallel_for(0, num_tasks, [&](size_t i)
+                                                            { results[i] = tiny_work(i); }); }),
+           num_tasks);
+    checksum += results.back();
+
+    // Round-trip latency of small tasks behind a backlog of 2 ms "disk writes"
+    auto latency_under_io = [&](ThreadPool &target, bool background_lane)
+    {
+        std::vector<std::future<void>> writes;
+        for (size_t i = 0; i < 4 * num_threads; ++i)
+        {
+            auto write = []()
+            { std::this_thread::sleep_for(std::chrono::milliseconds(2)); };
+            writes.push_back(background_lane ? target.submit_background(write) : target.submit(write));
+        }
+
+        const size_t probes = 200;
+        double total = time_seconds([&]
+                                    {
+            for (size_t i = 0; i < probes; ++i)
+            {
+                checksum += target.submit([i]() { return tiny_work(i); }).get();
+            } });
+        for (auto &write : writes)
+        {
+            write.get();
+        }
+        return total / probes * 1e6;
+    };
+
+    {
+        ThreadPoolConfig config;
+        config.num_threads = num_threads;
+        config.num_background_threads = 1;
+        ThreadPool lanes(config);
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "Hot-path latency, writes on submit()           " << latency_under_io(pool, false) << " us" << std::endl;
+        std::cout << "Hot-path latency, writes on background lane    " << latency_under_io(lanes, true) << " us" << std::endl;
+    }
+
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,147 @@
+// Universe panel benchmark
+// Cross-sectional scan over many symbols: for every bar, the mean
+// close-to-close return of the symbols trading at both bars. Compares
+// aligning the universe per run with per-symbol timestamp hash maps (how
+// cross-sectional code had to do it) against building a UniversePanel
+// once, serially and on a thread pool, and scanning its rows.
+//
+// Usage: universe_panel_benchmark [symbols] [bars] [threads]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <bit>
+#include <thread>
+
+#include "data/universe_panel.h"
+
+using namespace trading;
+
+namespace
+{
+    double time_ms(const std::function<void()> &fn)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t symbols = argc > 1 ? std::stoul(argv[1]) : 2000;
+    size_t bars = argc > 2 ? std::stoul(argv[2]) : 2520;
+    size_t threads = argc > 3 ? std::stoul(argv[3]) : std::max(2u, std::thread::hardware_concurrency());
+
+    // Random walks with ~2% missing bars and staggered listing dates
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> step(0.0, 0.01);
+    auto t0 = std::chrono::system_clock::time_point(std::chrono::seconds(1262304000));
+    std::vector<MarketDataSeries> universe;
+    universe.reserve(symbols);
+    for (size_t s = 0; s < symbols; ++s)
+    {
+        MarketDataSeries series("SYM" + std::to_string(s));
+        size_t listed = rng() % 10 == 0 ? rng() % (bars / 2) : 0;
+        double price = 20.0 + static_cast<double>(rng() % 200);
+        for (size_t i = listed; i < bars; ++i)
+        {
+            price *= 1.0 + step(rng);
+            if (rng() % 50 != 0)
+            {
+                series.add_point(MarketDataPoint(t0 + std::chrono::hours(24 * i), price, price, price, price, 1000));
+            }
+        }
+        universe.push_back(std::move(series));
+    }
+
+    std::cout << "Universe panel benchmark: " << symbols << " symbols x " << bars << " bars, "
+              << threads << " threads (" << std::thread::hardware_concurrency() << " cores)\n\n";
+
+    // Per-run alignment with hash maps, then the scan through them
+    double hashed_sum = 0.0;
+    double hashed_ms = time_ms([&]
+                               {
+        std::vector<int64_t> axis;
+        std::vector<std::unordered_map<int64_t, size_t>> index(symbols);
+        for (size_t s = 0; s < symbols; ++s)
+        {
+            const auto &data = universe[s].data();
+            index[s].reserve(data.size());
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                int64_t t = to_epoch_nanos(data[i].timestamp);
+                index[s][t] = i;
+                axis.push_back(t);
+            }
+        }
+        std::sort(axis.begin(), axis.end());
+        axis.erase(std::unique(axis.begin(), axis.end()), axis.end());
+        for (size_t t = 1; t < axis.size(); ++t)
+        {
+            double total = 0.0;
+            size_t count = 0;
+            for (size_t s = 0; s < symbols; ++s)
+            {
+                auto now = index[s].find(axis[t]);
+                auto before = index[s].find(axis[t - 1]);
+                if (now != index[s].end() && before != index[s].end())
+                {
+                    total += universe[s][now->second].close / universe[s][before->second].close - 1.0;
+                    ++count;
+                }
+            }
+            hashed_sum += count ? total / static_cast<double>(count) : 0.0;
+        } });
+
+    UniversePanel panel;
+    double build_ms = time_ms([&]
+                              { panel = UniversePanel::from_series(universe); });
+    auto pool = std::make_shared<ThreadPool>(threads);
+    double parallel_build_ms = time_ms([&]
+                                       { panel = UniversePanel::from_series(universe, pool); });
+
+    // The scan reads two contiguous rows and two bitmap rows per bar
+    double panel_sum = 0.0;
+    const PanelView &view = panel.view();
+    double scan_ms = time_ms([&]
+                             {
+        for (size_t t = 1; t < view.bars(); ++t)
+        {
+            auto now = view.row(PanelField::CLOSE, t);
+            auto before = view.row(PanelField::CLOSE, t - 1);
+            auto valid_now = view.valid_row(t);
+            auto valid_before = view.valid_row(t - 1);
+            double total = 0.0;
+            size_t count = 0;
+            for (size_t w = 0; w < valid_now.size(); ++w)
+            {
+                uint64_t both = valid_now[w] & valid_before[w];
+                count += static_cast<size_t>(std::popcount(both));
+                for (; both != 0; both &= both - 1)
+                {
+                    size_t s = w * 64 + static_cast<size_t>(std::countr_zero(both));
+                    total += now[s] / before[s] - 1.0;
+                }
+            }
+            panel_sum += count ? total / static_cast<double>(count) : 0.0;
+        } });
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "hash-map alignment + scan   " << std::setw(10) << hashed_ms << " ms\n";
+    std::cout << "panel build                 " << std::setw(10) << build_ms << " ms\n";
+    std::cout << "panel build, thread pool    " << std::setw(10) << parallel_build_ms << " ms\n";
+    std::cout << "panel scan                  " << std::setw(10) << scan_ms << " ms ("
+              << hashed_ms / scan_ms << "x vs re-aligning every run)\n";
+    std::cout << "panel memory                " << std::setw(10) << panel.memory_bytes() / (1024.0 * 1024.0) << " MiB\n";
+    std::cout << "results agree: " << (std::abs(hashed_sum - panel_sum) < 1e-9 * std::max(1.0, std::abs(hashed_sum)) ? "yes" : "NO")
+              << "\n";
+    return 0;
+}
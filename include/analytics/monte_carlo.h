@@ -0,0 +1,134 @@
+#pragma once
+
+#include "core/thread_pool.h"
+#include <vector>
+#include <memory>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace trading
+{
+    namespace analytics
+    {
+
+        /**
+         * @brief How simulated returns are drawn
+         */
+        enum class SimulationMethod
+        {
+            BOOTSTRAP,         // Resample historical returns (optionally in blocks)
+            GEOMETRIC_BROWNIAN // Log-normal steps fitted to the historical log returns
+        };
+
+        /**
+         * @brief Monte Carlo simulation parameters
+         */
+        struct MonteCarloConfig
+        {
+            size_t num_paths = 100000;                           // Number of simulated paths
+            size_t horizon = 252;                                // Steps per path
+            SimulationMethod method = SimulationMethod::BOOTSTRAP;
+            size_t bootstrap_block_length = 1;                   // Consecutive returns drawn per resample (1 = iid)
+            size_t paths_per_block = 1024;                       // Paths generated together in one SoA block
+            uint64_t seed = 42;                                  // Base seed; results do not depend on thread count
+            std::vector<double> confidence_levels{0.95, 0.99};   // VaR/CVaR levels
+        };
+
+        /**
+         * @brief Value at Risk figures for one confidence level
+         *
+         * Losses are reported as positive fractions of the starting value.
+         */
+        struct RiskMeasure
+        {
+            double confidence = 0.0;
+            double value_at_risk = 0.0;        // Loss not exceeded with the given confidence
+            double conditional_var = 0.0;      // Mean loss in the tail beyond VaR (expected shortfall)
+            double drawdown_at_risk = 0.0;     // Max drawdown not exceeded with the given confidence
+        };
+
+        /**
+         * @brief Monte Carlo simulation output
+         */
+        struct MonteCarloResult
+        {
+            // Per-path outcomes, indexed by path
+            std::vector<double> terminal_returns; // Final value / initial value - 1
+            std::vector<double> max_drawdowns;    // Largest peak-to-trough loss along the path
+
+            // Distribution summary
+            double mean_return = 0.0;
+            double median_return = 0.0;
+            double return_std_dev = 0.0;
+            double probability_of_loss = 0.0;
+            double mean_max_drawdown = 0.0;
+            double median_max_drawdown = 0.0;
+            std::vector<RiskMeasure> risk;
+
+            double elapsed_seconds = 0.0;
+            double paths_per_second = 0.0;
+        };
+
+        /**
+         * @brief Parallel Monte Carlo engine for return-path simulation
+         *
+         * Paths are produced in blocks of paths_per_block. Inside a block all
+         * state is structure-of-arrays (one contiguous array per quantity,
+         * indexed by path) and the simulation advances every path one step at
+         * a time, so the inner loop is a straight, branch-light loop over
+         * contiguous memory that the compiler can vectorize.
+         *
+         * Every path owns an independent xoshiro256++ stream seeded from
+         * (seed, path index). Results are therefore bit-identical for a given
+         * seed no matter how many threads run or how blocks are scheduled.
+         *
+         * Blocks are claimed by ThreadPool workers from a shared counter. Each
+         * worker allocates its block scratch once, and path outcomes are
+         * written straight into the pre-sized result vectors, so the hot loop
+         * never allocates.
+         */
+        class MonteCarloEngine
+        {
+        public:
+            /**
+             * @brief Constructor
+             * @param thread_pool Pool used to run blocks (nullptr runs on the calling thread)
+             * @param config Simulation parameters
+             */
+            explicit MonteCarloEngine(std::shared_ptr<ThreadPool> thread_pool,
+                                      const MonteCarloConfig &config = MonteCarloConfig{});
+
+            /**
+             * @brief Simulate paths from a sample of periodic returns
+             * @param returns Historical simple returns (e.g. DataProcessor::calculate_returns)
+             * @return Per-path outcomes and risk summary
+             */
+            MonteCarloResult run(std::span<const double> returns) const;
+
+            /**
+             * @brief Simulate paths from a price history
+             * @param prices Historical prices
+             * @return Per-path outcomes and risk summary
+             *
+             * Computes returns with DataProcessor::calculate_returns and drops
+             * its leading placeholder zero.
+             */
+            MonteCarloResult run_from_prices(const std::vector<double> &prices) const;
+
+            /**
+             * @brief Fill in the distribution summary of a result
+             * @param result Result with terminal_returns and max_drawdowns populated
+             * @param confidence_levels Levels for VaR/CVaR
+             */
+            static void summarize(MonteCarloResult &result, const std::vector<double> &confidence_levels);
+
+            const MonteCarloConfig &config() const { return config_; }
+
+        private:
+            std::shared_ptr<ThreadPool> thread_pool_;
+            MonteCarloConfig config_;
+        };
+
+    } // namespace analytics
+} // namespace trading
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "core/thread_pool.h"
+#include <vector>
+#include <memory>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace trading
+{
+    namespace analytics
+    {
+
+        /**
+         * @brief Equity of many strategies over a common set of bars
+         *
+         * One column per curve. Values are stored bar by bar, so the equity
+         * of every curve at one bar is contiguous: that is the order the
+         * analytics kernel consumes them in (one bar at a time across a run
+         * of curves), and appending a new bar is a single contiguous write.
+         */
+        class EquityMatrix
+        {
+        public:
+            /**
+             * @brief Constructor
+             * @param curves Number of curves (columns)
+             * @param reserve_bars Bars to reserve space for
+             */
+            explicit EquityMatrix(size_t curves, size_t reserve_bars = 0);
+
+            /**
+             * @brief Build a matrix from one equity vector per curve
+             * @throws std::invalid_argument if the curves differ in length
+             *
+             * Accepts e.g. BacktestResult::equity_curve of every sweep job.
+             */
+            static EquityMatrix from_curves(const std::vector<std::vector<double>> &curves);
+
+            /**
+             * @brief Append the next bar
+             * @param equity One value per curve
+             * @throws std::invalid_argument if equity.size() != curves()
+             */
+            void append_bar(std::span<const double> equity);
+
+            size_t curves() const { return curves_; }
+            size_t bars() const { return curves_ == 0 ? 0 : values_.size() / curves_; }
+
+            double at(size_t bar, size_t curve) const { return values_[bar * curves_ + curve]; }
+            std::span<const double> bar(size_t index) const
+            {
+                return std::span<const double>(values_.data() + index * curves_, curves_);
+            }
+
+            /**
+             * @brief Copy of one curve's column
+             */
+            std::vector<double> curve(size_t index) const;
+
+        private:
+            size_t curves_;
+            std::vector<double> values_; // values_[bar * curves_ + curve]
+        };
+
+        /**
+         * @brief Parameters of the metric calculations
+         */
+        struct AnalyticsConfig
+        {
+            double periods_per_year = 252.0; // Bars per year, used to annualize
+            double risk_free_rate = 0.0;     // Annual rate subtracted in Sharpe and Sortino
+            size_t rolling_window = 63;      // Bars in the rolling volatility/beta window
+            size_t curves_per_task = 512;    // Curves one pool task advances together
+        };
+
+        /**
+         * @brief Metrics of one equity curve
+         *
+         * Returns are simple per-bar returns; ratios and volatilities are
+         * annualized with AnalyticsConfig::periods_per_year. Drawdowns are
+         * positive fractions of the running peak. Win/loss figures count
+         * bars, with avg_win/avg_loss/profit_factor in currency terms.
+         * Turnover and trade counts need exposures and are zero without.
+         */
+        struct CurveMetrics
+        {
+            size_t bars = 0;
+            double total_return = 0.0;
+            double annualized_return = 0.0;
+            double volatility = 0.0;
+            double sharpe_ratio = 0.0;
+            double sortino_ratio = 0.0;
+            double calmar_ratio = 0.0;
+            double max_drawdown = 0.0;
+            size_t max_drawdown_duration = 0; // Longest stretch of bars below a previous peak
+            double current_drawdown = 0.0;
+            double rolling_volatility = 0.0; // Over the latest rolling_window returns
+            double rolling_beta = 0.0;       // Against the benchmark, same window
+            double turnover = 0.0;           // Annualized sum of |exposure change|
+            int total_trades = 0;            // Bars on which the exposure changed
+            double win_rate = 0.0;           // Rising bars / bars with any change
+            double avg_win = 0.0;
+            double avg_loss = 0.0;           // Positive
+            double profit_factor = 0.0;      // Gross gains / gross losses (0 without losses)
+        };
+
+        /**
+         * @brief Incremental metrics for thousands of equity curves at once
+         *
+         * All running state is structure-of-arrays indexed by curve, and
+         * each bar advances a run of curves in one straight loop over
+         * contiguous memory that the compiler can vectorize. Every metric is
+         * kept as a running quantity (Welford mean/variance, running peak,
+         * windowed sums over a ring of the latest returns), so update() is
+         * O(1) per curve however long the history. The windowed sums are
+         * recomputed from the ring once per window to stop rounding drift,
+         * which keeps the cost amortized O(1).
+         *
+         * With a pool, curves are split into tasks of curves_per_task;
+         * run() hands each task its curves for the whole matrix, so the
+         * pool is entered once rather than once per bar. Results do not
+         * depend on the number of threads.
+         */
+        class PortfolioAnalytics
+        {
+        public:
+            /**
+             * @brief Constructor
+             * @param curves Number of equity curves tracked
+             * @param thread_pool Pool used to split curves (nullptr runs on the calling thread)
+             * @param config Metric parameters
+             * @throws std::invalid_argument if rolling_window is 0 or periods_per_year is not positive
+             */
+            PortfolioAnalytics(size_t curves, std::shared_ptr<ThreadPool> thread_pool = nullptr,
+                               const AnalyticsConfig &config = AnalyticsConfig{});
+
+            /**
+             * @brief Add one bar
+             * @param equity Equity of every curve at this bar
+             * @param benchmark_return Benchmark simple return over the bar (for beta)
+             * @param exposure Optional exposure (e.g. position weight) of every curve
+             * @throws std::invalid_argument if a span does not have one value per curve
+             */
+            void update(std::span<const double> equity, double benchmark_return = 0.0,
+                        std::span<const double> exposure = {});
+
+            /**
+             * @brief Add every bar of a matrix
+             * @param equity Bars to append, in order
+             * @param benchmark_returns One return per bar, or empty for none
+             * @param exposures Matrix of the same shape, or nullptr
+             * @throws std::invalid_argument if the shapes do not match
+             *
+             * Equivalent to calling update() for each bar.
+             */
+            void run(const EquityMatrix &equity, std::span<const double> benchmark_returns = {},
+                     const EquityMatrix *exposures = nullptr);
+
+            /**
+             * @brief Current metrics of one curve
+             */
+            CurveMetrics metrics(size_t curve) const;
+
+            /**
+             * @brief Current metrics of every curve
+             */
+            std::vector<CurveMetrics> all_metrics() const;
+
+            /**
+             * @brief Forget all bars, keeping the curve count and configuration
+             */
+            void reset();
+
+            size_t curves() const { return curves_; }
+            size_t bars() const { return bars_; }
+            const AnalyticsConfig &config() const { return config_; }
+
+        private:
+            // Rolling window of benchmark returns, shared by every curve
+            struct BenchmarkWindow
+            {
+                std::vector<double> ring; // ring[return index % rolling_window]
+                size_t count = 0;
+                double sum = 0.0;
+                double sum_sq = 0.0;
+            };
+
+            void advance(const BenchmarkWindow &window, size_t bar, const double *equity, const double *exposure,
+                         double benchmark_in, double benchmark_out, size_t begin, size_t end);
+            static double push_benchmark(BenchmarkWindow &window, double value, size_t bar); // Returns the value it replaced
+            template <typename Body>
+            void for_each_task(Body &&body);
+
+            size_t curves_;
+            std::shared_ptr<ThreadPool> thread_pool_;
+            AnalyticsConfig config_;
+            size_t bars_ = 0;
+            bool has_exposure_ = false;
+            BenchmarkWindow benchmark_;
+
+            // Per-curve running state (structure of arrays)
+            std::vector<double> first_;      // Equity at the first bar
+            std::vector<double> last_;       // Equity at the latest bar
+            std::vector<double> peak_;
+            std::vector<double> mean_;       // Welford mean of returns
+            std::vector<double> m2_;         // Welford sum of squared deviations
+            std::vector<double> downside_;   // Sum of squared shortfalls below the risk-free return
+            std::vector<double> max_dd_;
+            std::vector<double> underwater_; // Bars since the last peak
+            std::vector<double> max_underwater_;
+            std::vector<double> win_bars_;
+            std::vector<double> loss_bars_;
+            std::vector<double> gross_gain_;
+            std::vector<double> gross_loss_;
+            std::vector<double> exposure_;   // Latest exposure
+            std::vector<double> turnover_;   // Sum of |exposure change|
+            std::vector<double> trades_;
+            std::vector<double> window_sum_;
+            std::vector<double> window_sum_sq_;
+            std::vector<double> window_cross_; // Sum of return * benchmark return
+            std::vector<double> ring_;         // ring_[slot * curves_ + curve], latest returns
+        };
+
+    } // namespace analytics
+} // namespace trading
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace trading
+{
+    namespace analytics
+    {
+
+        /**
+         * @brief SplitMix64 generator
+         *
+         * Used to expand a single 64-bit seed into well-mixed state for other
+         * generators. Every output is a bijective hash of the counter, so
+         * nearby seeds give unrelated streams.
+         */
+        inline uint64_t splitmix64(uint64_t &state)
+        {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        /**
+         * @brief xoshiro256++ pseudo-random generator
+         *
+         * Small (32 bytes of state), fast and statistically strong. Satisfies
+         * UniformRandomBitGenerator so it can drive the <random> distributions.
+         * Each simulation stream owns its own instance; instances are never
+         * shared between threads.
+         */
+        class Xoshiro256
+        {
+        public:
+            using result_type = uint64_t;
+
+            explicit Xoshiro256(uint64_t seed = 0x5EED)
+            {
+                this->seed(seed);
+            }
+
+            /**
+             * @brief Re-seed the generator
+             * @param seed Any 64-bit value (zero is fine)
+             */
+            void seed(uint64_t seed)
+            {
+                uint64_t sm = seed;
+                s_[0] = splitmix64(sm);
+                s_[1] = splitmix64(sm);
+                s_[2] = splitmix64(sm);
+                s_[3] = splitmix64(sm);
+            }
+
+            static constexpr result_type min() { return 0; }
+            static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+            result_type operator()()
+            {
+                const uint64_t result = rotl(s_[0] + s_[3], 23) + s_[0];
+                const uint64_t t = s_[1] << 17;
+
+                s_[2] ^= s_[0];
+                s_[3] ^= s_[1];
+                s_[1] ^= s_[2];
+                s_[0] ^= s_[3];
+                s_[2] ^= t;
+                s_[3] = rotl(s_[3], 45);
+
+                return result;
+            }
+
+            /**
+             * @brief Uniform double in [0, 1) with 53 bits of precision
+             */
+            double uniform() { return to_unit_double((*this)()); }
+
+            /**
+             * @brief Convert raw generator output to a double in [0, 1)
+             */
+            static double to_unit_double(uint64_t x) { return static_cast<double>(x >> 11) * 0x1.0p-53; }
+
+            static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+        private:
+            uint64_t s_[4];
+        };
+
+    } // namespace analytics
+} // namespace trading
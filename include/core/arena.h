@@ -0,0 +1,99 @@
+#pragma once
+
+#include <memory_resource>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+namespace trading
+{
+
+    /**
+     * @brief Monotonic scratch arena for per-step temporaries
+     *
+     * A std::pmr::memory_resource that hands out memory by bumping a
+     * pointer and ignores deallocation; everything allocated since the last
+     * reset() is released at once by the next one. Give it to std::pmr
+     * containers and strings that live for one backtest bar, one indicator
+     * pass or one export, and reset it at the end.
+     *
+     * When a cycle outgrows the buffer, the extra blocks come from the
+     * upstream resource, and reset() replaces the buffer with one as large
+     * as the peak usage. After a warm-up cycle or two, every cycle is
+     * served from a single block and the arena stops calling the upstream
+     * allocator altogether, so long sweeps allocate nothing and no longer
+     * fragment the heap.
+     *
+     * Not thread-safe: use one arena per thread.
+     */
+    class ScratchArena : public std::pmr::memory_resource
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param initial_bytes Size of the first buffer
+         * @param upstream Resource the buffers come from
+         */
+        explicit ScratchArena(size_t initial_bytes = 64 * 1024,
+                              std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+
+        ~ScratchArena() override;
+
+        ScratchArena(const ScratchArena &) = delete;
+        ScratchArena &operator=(const ScratchArena &) = delete;
+
+        /**
+         * @brief Release everything allocated since the last reset
+         *
+         * Memory handed out before the call must no longer be used.
+         */
+        void reset();
+
+        /**
+         * @brief Bytes handed out since the last reset, padding included
+         */
+        size_t bytes_used() const { return used_before_ + offset_; }
+
+        /**
+         * @brief Size of the main buffer
+         */
+        size_t capacity() const { return capacity_; }
+
+        /**
+         * @brief Largest bytes_used() seen in any cycle
+         */
+        size_t high_water() const;
+
+        /**
+         * @brief Number of times the upstream resource was called
+         */
+        size_t upstream_allocations() const { return upstream_allocations_; }
+
+    protected:
+        void *do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void *ptr, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    private:
+        struct Block
+        {
+            std::byte *data;
+            size_t size;
+            size_t alignment;
+        };
+
+        void *allocate_overflow(size_t bytes, size_t alignment);
+
+        std::pmr::memory_resource *upstream_;
+        std::byte *buffer_ = nullptr; // Main buffer, kept across resets
+        size_t capacity_ = 0;
+        std::byte *current_ = nullptr; // Block being bumped
+        size_t current_size_ = 0;
+        size_t offset_ = 0;            // Bytes used in the current block
+        size_t used_before_ = 0;       // Bytes used in earlier blocks this cycle
+        size_t high_water_ = 0;
+        size_t upstream_allocations_ = 0;
+        std::vector<Block> overflow_; // Extra blocks for this cycle
+    };
+
+} // namespace trading
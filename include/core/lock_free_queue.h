@@ -1,7 +1,10 @@
 #pragma once
 
+#include "core/wait_strategy.h"
 #include <atomic>
 #include <memory>
+#include <span>
+#include <algorithm>
 #include <cstddef>
 
 namespace trading
@@ -21,8 +24,22 @@ namespace trading
      * - Fixed-size circular buffer
      * - Memory ordering guarantees
      * - Exception safety
+     *
+     * Each index is written by one side only, so publishing an element is a
+     * plain release store rather than a compare-and-swap. The indices live
+     * on separate cache lines, each next to the owning side's cached copy of
+     * the other index; a side only reloads the other's index when its copy
+     * says the queue is full (or empty). try_push_bulk() and try_pop_bulk()
+     * move a whole span for a single index update.
+     *
+     * push(), pop() and pop_bulk() block instead of failing; how they wait
+     * is set by the Wait parameter (see wait_strategy.h). The default,
+     * BusySpinWait, adds nothing to the try_* paths; ParkingWait lets an
+     * idle consumer sleep in the kernel until the producer publishes.
+     *
+     * For several producers or consumers use MpmcQueue.
      */
-    template <typename T>
+    template <typename T, typename Wait = BusySpinWait>
     class LockFreeQueue
     {
     public:
@@ -42,14 +59,10 @@ namespace trading
          */
         ~LockFreeQueue() = default;
 
-        // Prevent copying
+        // Prevent copying and moving (the indices are atomics)
         LockFreeQueue(const LockFreeQueue &) = delete;
         LockFreeQueue &operator=(const LockFreeQueue &) = delete;
 
-        // Allow moving
-        LockFreeQueue(LockFreeQueue &&) noexcept = default;
-        LockFreeQueue &operator=(LockFreeQueue &&) noexcept = default;
-
         /**
          * @brief Try to push an element to the queue
          * @param value Value to push
@@ -67,6 +80,15 @@ namespace trading
          */
         bool try_push(T &&value);
 
+        /**
+         * @brief Push as many leading elements of a span as fit
+         * @param values Elements to push; the pushed ones are moved from
+         * @return Number of elements pushed, 0 if the queue is full
+         *
+         * Producer thread only.
+         */
+        size_t try_push_bulk(std::span<T> values);
+
         /**
          * @brief Try to pop an element from the queue
          * @param value Reference to store the popped value
@@ -77,6 +99,50 @@ namespace trading
          */
         bool try_pop(T &value);
 
+        /**
+         * @brief Pop up to out.size() elements in FIFO order
+         * @param out Destination for the popped elements
+         * @return Number of elements written to the front of out
+         *
+         * Consumer thread only.
+         */
+        size_t try_pop_bulk(std::span<T> out);
+
+        /**
+         * @brief Push an element, waiting while the queue is full
+         * @param value Value to push
+         */
+        void push(const T &value);
+
+        /**
+         * @brief Push an element, waiting while the queue is full (move version)
+         * @param value Value to push (will be moved)
+         */
+        void push(T &&value);
+
+        /**
+         * @brief Pop an element, waiting while the queue is empty
+         * @param value Reference to store the popped value
+         * @param stop Optional flag; once set, pop() returns false instead of waiting
+         * @return true if an element was popped, false if stopped with the queue empty
+         *
+         * After setting stop, call wake_all() so that parked consumers see it.
+         */
+        bool pop(T &value, const std::atomic<bool> *stop = nullptr);
+
+        /**
+         * @brief Pop up to out.size() elements, waiting until there is at least one
+         * @param out Destination for the popped elements
+         * @param stop Optional flag, as for pop()
+         * @return Number of elements popped, 0 only if stopped or out is empty
+         */
+        size_t pop_bulk(std::span<T> out, const std::atomic<bool> *stop = nullptr);
+
+        /**
+         * @brief Wake every waiting producer and consumer so they re-check
+         */
+        void wake_all();
+
         /**
          * @brief Check if the queue is empty
          * @return true if queue is empty
@@ -108,190 +174,250 @@ namespace trading
         size_t capacity() const { return capacity_; }
 
     private:
-        // Node structure for the queue
-        struct Node
-        {
-            T data;
-            std::atomic<size_t> sequence;
-
-            Node() : sequence(0) {}
-        };
+        template <typename U>
+        bool push_one(U &&value);
 
         // Member variables
-        std::unique_ptr<Node[]> buffer_; // Circular buffer
-        size_t capacity_;                // Queue capacity (power of 2)
-        size_t mask_;                    // Bit mask for modulo operation
+        std::unique_ptr<T[]> buffer_; // Circular buffer
+        size_t capacity_;             // Queue capacity (power of 2)
+        size_t mask_;                 // Bit mask for modulo operation
+
+        // Producer side: its index and its last view of the consumer's
+        alignas(kCacheLineSize) std::atomic<size_t> head_;
+        size_t cached_tail_ = 0;
+
+        // Consumer side: its index and its last view of the producer's
+        alignas(kCacheLineSize) std::atomic<size_t> tail_;
+        size_t cached_head_ = 0;
 
-        // Atomic indices
-        std::atomic<size_t> head_; // Producer index
-        std::atomic<size_t> tail_; // Consumer index
+        [[no_unique_address]] Wait not_empty_; // Consumers wait here, producers notify
+        [[no_unique_address]] Wait not_full_;  // Producers wait here, consumers notify
 
         // Helper methods
         static size_t next_power_of_2(size_t n);
-        size_t increment(size_t index) const;
     };
 
     // Template implementation (must be in header for templates)
 
-    template <typename T>
-    LockFreeQueue<T>::LockFreeQueue(size_t capacity)
+    template <typename T, typename Wait>
+    LockFreeQueue<T, Wait>::LockFreeQueue(size_t capacity)
         : capacity_(next_power_of_2(capacity)), mask_(capacity_ - 1)
     {
 
         // Allocate buffer
-        buffer_ = std::make_unique<Node[]>(capacity_);
-
-        // Initialize sequence numbers
-        for (size_t i = 0; i < capacity_; ++i)
-        {
-            buffer_[i].sequence.store(i, std::memory_order_relaxed);
-        }
+        buffer_ = std::make_unique<T[]>(capacity_);
 
         // Initialize indices
         head_.store(0, std::memory_order_relaxed);
         tail_.store(0, std::memory_order_relaxed);
     }
 
-    template <typename T>
-    bool LockFreeQueue<T>::try_push(const T &value)
+    template <typename T, typename Wait>
+    bool LockFreeQueue<T, Wait>::try_push(const T &value)
     {
-        size_t head = head_.load(std::memory_order_relaxed);
-        size_t tail = tail_.load(std::memory_order_acquire);
-
-        // Check if queue is full
-        if (head - tail >= capacity_)
-        {
-            return false;
-        }
+        return push_one(value);
+    }
 
-        // Get the node at head position
-        Node &node = buffer_[head & mask_];
-        size_t sequence = node.sequence.load(std::memory_order_acquire);
+    template <typename T, typename Wait>
+    bool LockFreeQueue<T, Wait>::try_push(T &&value)
+    {
+        return push_one(std::move(value));
+    }
 
-        // Check if this slot is available
-        if (sequence != head)
-        {
-            return false;
-        }
+    template <typename T, typename Wait>
+    template <typename U>
+    bool LockFreeQueue<T, Wait>::push_one(U &&value)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
 
-        // Try to increment head
-        if (!head_.compare_exchange_weak(head, head + 1,
-                                         std::memory_order_relaxed))
+        // Check if queue is full, refreshing our view of the consumer first
+        if (head - cached_tail_ >= capacity_)
         {
-            return false;
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head - cached_tail_ >= capacity_)
+            {
+                return false;
+            }
         }
 
-        // Store the value
-        node.data = value;
-
-        // Update sequence number
-        node.sequence.store(head + 1, std::memory_order_release);
+        // Store the value, then publish it
+        buffer_[head & mask_] = std::forward<U>(value);
+        head_.store(head + 1, std::memory_order_release);
+        not_empty_.notify();
 
         return true;
     }
 
-    template <typename T>
-    bool LockFreeQueue<T>::try_push(T &&value)
+    template <typename T, typename Wait>
+    size_t LockFreeQueue<T, Wait>::try_push_bulk(std::span<T> values)
     {
         size_t head = head_.load(std::memory_order_relaxed);
-        size_t tail = tail_.load(std::memory_order_acquire);
 
-        // Check if queue is full
-        if (head - tail >= capacity_)
+        size_t free_slots = capacity_ - (head - cached_tail_);
+        if (free_slots < values.size())
         {
-            return false;
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            free_slots = capacity_ - (head - cached_tail_);
         }
 
-        // Get the node at head position
-        Node &node = buffer_[head & mask_];
-        size_t sequence = node.sequence.load(std::memory_order_acquire);
-
-        // Check if this slot is available
-        if (sequence != head)
+        size_t count = std::min(free_slots, values.size());
+        for (size_t i = 0; i < count; ++i)
         {
-            return false;
+            buffer_[(head + i) & mask_] = std::move(values[i]);
         }
 
-        // Try to increment head
-        if (!head_.compare_exchange_weak(head, head + 1,
-                                         std::memory_order_relaxed))
+        // One store publishes the whole batch
+        if (count > 0)
         {
-            return false;
+            head_.store(head + count, std::memory_order_release);
+            not_empty_.notify();
         }
 
-        // Store the value (move)
-        node.data = std::move(value);
+        return count;
+    }
 
-        // Update sequence number
-        node.sequence.store(head + 1, std::memory_order_release);
+    template <typename T, typename Wait>
+    bool LockFreeQueue<T, Wait>::try_pop(T &value)
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+
+        // Check if queue is empty, refreshing our view of the producer first
+        if (tail == cached_head_)
+        {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail == cached_head_)
+            {
+                return false;
+            }
+        }
+
+        // Load the value, then hand the slot back
+        value = std::move(buffer_[tail & mask_]);
+        tail_.store(tail + 1, std::memory_order_release);
+        not_full_.notify();
 
         return true;
     }
 
-    template <typename T>
-    bool LockFreeQueue<T>::try_pop(T &value)
+    template <typename T, typename Wait>
+    size_t LockFreeQueue<T, Wait>::try_pop_bulk(std::span<T> out)
     {
         size_t tail = tail_.load(std::memory_order_relaxed);
-        size_t head = head_.load(std::memory_order_acquire);
 
-        // Check if queue is empty
-        if (tail >= head)
+        size_t available = cached_head_ - tail;
+        if (available < out.size())
         {
-            return false;
+            cached_head_ = head_.load(std::memory_order_acquire);
+            available = cached_head_ - tail;
         }
 
-        // Get the node at tail position
-        Node &node = buffer_[tail & mask_];
-        size_t sequence = node.sequence.load(std::memory_order_acquire);
-
-        // Check if this slot contains data
-        if (sequence != tail + 1)
+        size_t count = std::min(available, out.size());
+        for (size_t i = 0; i < count; ++i)
         {
-            return false;
+            out[i] = std::move(buffer_[(tail + i) & mask_]);
         }
 
-        // Try to increment tail
-        if (!tail_.compare_exchange_weak(tail, tail + 1,
-                                         std::memory_order_relaxed))
+        // One store hands all the slots back
+        if (count > 0)
         {
-            return false;
+            tail_.store(tail + count, std::memory_order_release);
+            not_full_.notify();
         }
 
-        // Load the value
-        value = std::move(node.data);
+        return count;
+    }
 
-        // Update sequence number
-        node.sequence.store(tail + capacity_, std::memory_order_release);
+    template <typename T, typename Wait>
+    void LockFreeQueue<T, Wait>::push(const T &value)
+    {
+        while (!try_push(value))
+        {
+            not_full_.wait([this]
+                           { return !full(); });
+        }
+    }
+
+    template <typename T, typename Wait>
+    void LockFreeQueue<T, Wait>::push(T &&value)
+    {
+        // A failed try_push leaves value untouched
+        while (!try_push(std::move(value)))
+        {
+            not_full_.wait([this]
+                           { return !full(); });
+        }
+    }
 
+    template <typename T, typename Wait>
+    bool LockFreeQueue<T, Wait>::pop(T &value, const std::atomic<bool> *stop)
+    {
+        while (!try_pop(value))
+        {
+            if (stop != nullptr && stop->load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            not_empty_.wait([this, stop]
+                            { return !empty() || (stop != nullptr && stop->load(std::memory_order_acquire)); });
+        }
         return true;
     }
 
-    template <typename T>
-    bool LockFreeQueue<T>::empty() const
+    template <typename T, typename Wait>
+    size_t LockFreeQueue<T, Wait>::pop_bulk(std::span<T> out, const std::atomic<bool> *stop)
+    {
+        if (out.empty())
+        {
+            return 0;
+        }
+
+        size_t count;
+        while ((count = try_pop_bulk(out)) == 0)
+        {
+            if (stop != nullptr && stop->load(std::memory_order_acquire))
+            {
+                return 0;
+            }
+            not_empty_.wait([this, stop]
+                            { return !empty() || (stop != nullptr && stop->load(std::memory_order_acquire)); });
+        }
+        return count;
+    }
+
+    template <typename T, typename Wait>
+    void LockFreeQueue<T, Wait>::wake_all()
+    {
+        not_empty_.wake_all();
+        not_full_.wake_all();
+    }
+
+    template <typename T, typename Wait>
+    bool LockFreeQueue<T, Wait>::empty() const
     {
         size_t tail = tail_.load(std::memory_order_relaxed);
         size_t head = head_.load(std::memory_order_relaxed);
         return tail >= head;
     }
 
-    template <typename T>
-    bool LockFreeQueue<T>::full() const
+    template <typename T, typename Wait>
+    bool LockFreeQueue<T, Wait>::full() const
     {
+        size_t tail = tail_.load(std::memory_order_acquire);
         size_t head = head_.load(std::memory_order_relaxed);
-        size_t tail = tail_.load(std::memory_order_relaxed);
         return head - tail >= capacity_;
     }
 
-    template <typename T>
-    size_t LockFreeQueue<T>::size() const
+    template <typename T, typename Wait>
+    size_t LockFreeQueue<T, Wait>::size() const
     {
+        // Tail first: head only grows, so the difference cannot underflow
+        size_t tail = tail_.load(std::memory_order_acquire);
         size_t head = head_.load(std::memory_order_relaxed);
-        size_t tail = tail_.load(std::memory_order_relaxed);
         return head - tail;
     }
 
-    template <typename T>
-    size_t LockFreeQueue<T>::next_power_of_2(size_t n)
+    template <typename T, typename Wait>
+    size_t LockFreeQueue<T, Wait>::next_power_of_2(size_t n)
     {
         if (n <= 1)
             return 1;
@@ -304,10 +430,4 @@ namespace trading
         return power;
     }
 
-    template <typename T>
-    size_t LockFreeQueue<T>::increment(size_t index) const
-    {
-        return (index + 1) & mask_;
-    }
-
-} // namespace trading
\ No newline at end of file
+} // namespace trading
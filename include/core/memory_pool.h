@@ -3,8 +3,14 @@
 #include <vector>
 #include <mutex>
 #include <memory>
+#include <memory_resource>
 #include <cstddef>
+#include <cstdint>
 #include <atomic>
+#include <array>
+#include <limits>
+#include <new>
+#include <type_traits>
 
 namespace trading
 {
@@ -16,15 +22,31 @@ namespace trading
      * quickly allocated and deallocated without system calls. This is crucial
      * for high-frequency trading where allocation overhead can impact performance.
      *
+     * Each thread keeps a private cache of free blocks, so allocate() and
+     * deallocate() normally touch no shared state at all. Caches trade
+     * blocks with a shared depot in magazines of kMagazineSize blocks
+     * through a lock-free stack, so a block freed on another thread than
+     * the one that allocated it simply joins the freeing thread's cache.
+     * Only growing the pool takes a lock. A thread caches blocks of a few
+     * pools per cache set; a pool that finds every way of its set taken
+     * on some thread trades single blocks with the depot there instead.
+     *
+     * Every block is preceded by a one-word header that holds the owning
+     * pool's tag while the block is allocated, so deallocate() checks
+     * ownership in O(1) and ignores foreign pointers and double frees.
+     *
      * Key features:
-     * - Thread-safe allocation/deallocation
-     * - Fixed-size blocks for predictable performance
+     * - Thread-safe allocation/deallocation without locks on the fast path
+     * - Fixed-size, 16-byte aligned blocks for predictable performance
      * - Automatic expansion when pool is exhausted
      * - Memory reuse to reduce fragmentation
      */
     class MemoryPool
     {
     public:
+        static constexpr size_t kMagazineSize = 32; // Blocks moved between a thread cache and the depot at once
+        static constexpr size_t kAlignment = 16;    // Alignment of every block
+
         /**
          * @brief Constructor
          * @param block_size Size of each memory block in bytes
@@ -37,18 +59,15 @@ namespace trading
         /**
          * @brief Destructor
          *
-         * Frees all allocated memory.
+         * Frees all allocated memory. Blocks still held by other threads'
+         * caches are released with it.
          */
         ~MemoryPool();
 
-        // Prevent copying
+        // Prevent copying and moving (allocated blocks carry the pool's tag)
         MemoryPool(const MemoryPool &) = delete;
         MemoryPool &operator=(const MemoryPool &) = delete;
 
-        // Allow moving
-        MemoryPool(MemoryPool &&) noexcept;
-        MemoryPool &operator=(MemoryPool &&) noexcept;
-
         /**
          * @brief Allocate a memory block
          * @return Pointer to allocated memory block
@@ -62,13 +81,20 @@ namespace trading
          * @brief Deallocate a memory block
          * @param ptr Pointer to previously allocated block
          *
-         * Returns a memory block to the pool for reuse.
+         * Returns a memory block to the pool for reuse. May be called from
+         * any thread; pointers this pool did not hand out are ignored.
          */
         void deallocate(void *ptr);
 
+        /**
+         * @brief Check whether a pointer is a live block of this pool
+         * @param ptr Pointer to check; must point into readable memory
+         */
+        bool owns(const void *ptr) const;
+
         /**
          * @brief Get the size of each block
-         * @return Block size in bytes
+         * @return Usable block size in bytes
          */
         size_t block_size() const { return block_size_; }
 
@@ -80,16 +106,31 @@ namespace trading
 
         /**
          * @brief Get the number of free blocks
-         * @return Number of available blocks
+         * @return Number of available blocks, including those in thread caches
+         *
+         * Exact, so it locks and walks every thread cache holding blocks
+         * of this pool; meant for statistics, not hot paths.
          */
         size_t free_blocks() const;
 
         /**
          * @brief Get the number of allocated blocks
          * @return Number of currently allocated blocks
+         *
+         * Exact, with the same cost as free_blocks().
          */
         size_t allocated_blocks() const;
 
+        /**
+         * @brief Get the number of blocks outside the shared depot
+         * @return Allocated blocks plus free blocks held in thread caches
+         *
+         * A single atomic load, updated only when a cache trades a magazine
+         * with the depot. An upper bound on allocated_blocks() that is
+         * cheap enough for hot paths.
+         */
+        size_t outstanding_blocks() const;
+
         /**
          * @brief Reserve additional blocks
          * @param num_blocks Number of blocks to add
@@ -100,70 +141,156 @@ namespace trading
         void reserve(size_t num_blocks);
 
     private:
-        // Memory block structure
-        struct Block
+        struct CacheSlot;
+        struct ThreadCache;
+
+        // Memory chunks are allocated over-aligned and freed accordingly
+        struct ChunkDeleter
         {
-            Block *next;  // Next block in free list
-            char data[1]; // Single byte array (we'll allocate more space)
+            void operator()(std::byte *chunk) const;
         };
 
+        // Per-thread cache
+        static ThreadCache *thread_cache();
+        CacheSlot *local_slot();
+        CacheSlot *attach(CacheSlot &slot);
+        void refill(CacheSlot &slot);
+        void spill(CacheSlot &slot, size_t keep);
+        void detach(CacheSlot &slot);
+
+        // Shared depot of magazines (lock-free stack with a tagged head)
+        void push_magazine(void *first, size_t count);
+        bool pop_magazine(void *&first, size_t &count);
+
+        // Helper methods
+        void expand_pool(size_t num_blocks);
+
         // Member variables
-        size_t block_size_;                           // Size of each block
-        std::vector<std::unique_ptr<char[]>> chunks_; // Memory chunks
-        Block *free_list_;                            // Linked list of free blocks
+        size_t block_size_; // Usable bytes per block
+        size_t stride_;     // Distance between blocks, header included
+        uint64_t id_;       // Never reused, so stale cache slots cannot match
+        uintptr_t tag_;     // Header value of an allocated block
+
+        std::atomic<uint64_t> depot_{0};            // Packed magazine pointer and ABA tag
+        std::atomic<size_t> depot_blocks_{0};       // Free blocks in the depot
+        std::atomic<size_t> outstanding_blocks_{0}; // Blocks taken from the depot and not returned
+        std::atomic<size_t> total_blocks_{0};       // Total blocks created
 
         // Synchronization
-        mutable std::mutex pool_mutex_; // Protects pool state
+        std::mutex grow_mutex_;                            // Serializes expansion
+        std::vector<std::unique_ptr<std::byte[], ChunkDeleter>> chunks_; // Memory chunks
+        mutable std::mutex caches_mutex_;                  // Guards caches_
+        std::vector<CacheSlot *> caches_;                  // Thread cache slots holding our blocks
+    };
 
-        // Statistics
-        size_t total_blocks_{0};                  // Total blocks created
-        std::atomic<size_t> allocated_blocks_{0}; // Currently allocated blocks
+    /**
+     * @brief Size-class allocator built from MemoryPools
+     *
+     * A std::pmr::memory_resource that rounds each request up to one of
+     * kNumClasses block sizes (16-byte steps to 128, then four classes per
+     * power of two up to kMaxPooledSize) and serves it from the matching
+     * MemoryPool. Larger or over-aligned requests go to the upstream
+     * resource. Usable from any number of threads without contention, and
+     * with std::pmr containers directly or std containers via PoolAllocator.
+     */
+    class PoolResource : public std::pmr::memory_resource
+    {
+    public:
+        static constexpr size_t kMaxPooledSize = 4096;
+        static constexpr size_t kNumClasses = 28;
 
-        // Helper methods
-        void expand_pool(size_t num_blocks);
-        bool is_valid_pointer(void *ptr) const;
+        /**
+         * @brief Constructor
+         * @param upstream Resource for requests the size classes don't cover
+         */
+        explicit PoolResource(std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+
+        PoolResource(const PoolResource &) = delete;
+        PoolResource &operator=(const PoolResource &) = delete;
+
+        /**
+         * @brief Size class serving a request
+         * @param bytes Requested size, at most kMaxPooledSize
+         * @return Class index in [0, kNumClasses)
+         */
+        static size_t size_class(size_t bytes);
+
+        /**
+         * @brief Block size of a size class
+         */
+        static size_t class_size(size_t index);
+
+        /**
+         * @brief Pool backing a size class
+         */
+        const MemoryPool &pool(size_t index) const { return *pools_[index]; }
+
+        /**
+         * @brief Resource used for requests the size classes don't cover
+         */
+        std::pmr::memory_resource *upstream() const { return upstream_; }
+
+    protected:
+        void *do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void *ptr, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    private:
+        std::pmr::memory_resource *upstream_;
+        std::array<std::unique_ptr<MemoryPool>, kNumClasses> pools_;
     };
 
     /**
-     * @brief RAII wrapper for memory pool allocation
+     * @brief Standard allocator over a memory resource
+     *
+     * Meets the Allocator requirements, so std::vector, std::deque,
+     * std::map and friends can allocate from a PoolResource:
      *
-     * This class provides automatic deallocation when it goes out of scope,
-     * similar to std::unique_ptr but for memory pool allocations.
+     *     std::vector<double, PoolAllocator<double>> prices{PoolAllocator<double>(resource)};
+     *
+     * Unlike std::pmr::polymorphic_allocator, it is part of the container
+     * type, propagates on assignment and swap, and does not pass itself
+     * on to the elements.
      */
     template <typename T>
     class PoolAllocator
     {
     public:
-        explicit PoolAllocator(MemoryPool &pool) : pool_(pool) {}
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+        using is_always_equal = std::false_type;
+
+        explicit PoolAllocator(std::pmr::memory_resource &resource) noexcept : resource_(&resource) {}
+
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U> &other) noexcept : resource_(other.resource()) {}
 
         T *allocate(size_t n)
         {
-            if (n != 1)
+            if (n > std::numeric_limits<size_t>::max() / sizeof(T))
             {
-                throw std::bad_alloc(); // Only support single object allocation
+                throw std::bad_array_new_length();
             }
-            return static_cast<T *>(pool_.allocate());
+            return static_cast<T *>(resource_->allocate(n * sizeof(T), alignof(T)));
         }
 
-        void deallocate(T *ptr, size_t)
+        void deallocate(T *ptr, size_t n) noexcept
         {
-            pool_.deallocate(ptr);
+            resource_->deallocate(ptr, n * sizeof(T), alignof(T));
         }
 
-        template <typename U, typename... Args>
-        void construct(U *ptr, Args &&...args)
-        {
-            new (ptr) U(std::forward<Args>(args)...);
-        }
+        std::pmr::memory_resource *resource() const noexcept { return resource_; }
 
         template <typename U>
-        void destroy(U *ptr)
+        bool operator==(const PoolAllocator<U> &other) const noexcept
         {
-            ptr->~U();
+            return *resource_ == *other.resource();
         }
 
     private:
-        MemoryPool &pool_;
+        std::pmr::memory_resource *resource_;
     };
 
-} // namespace trading
\ No newline at end of file
+} // namespace trading
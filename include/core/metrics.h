@@ -0,0 +1,436 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define TRADING_METRICS_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TRADING_METRICS_RDTSC 1
+#endif
+
+namespace trading
+{
+    namespace metrics
+    {
+
+        /**
+         * @brief Whether instrumentation is compiled in (CMake option ENABLE_METRICS)
+         *
+         * When it is not, ticks() returns 0 and every record/add call is an
+         * empty inline function, so instrumented code compiles to what it
+         * was before. Metrics still register and export, reading zero.
+         */
+#if defined(TRADING_METRICS)
+        inline constexpr bool kEnabled = true;
+#else
+        inline constexpr bool kEnabled = false;
+#endif
+
+        /**
+         * @brief Cheap monotonic timestamp in ticks
+         *
+         * The time-stamp counter on x86 (a few nanoseconds to read, no
+         * system call), steady_clock nanoseconds elsewhere. Tick deltas are
+         * converted with nanoseconds_per_tick(); this assumes an invariant
+         * TSC, which every x86 CPU of the last decade has.
+         */
+        inline uint64_t ticks()
+        {
+            if constexpr (!kEnabled)
+            {
+                return 0;
+            }
+#if defined(TRADING_METRICS_RDTSC)
+            return __rdtsc();
+#else
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                             std::chrono::steady_clock::now().time_since_epoch())
+                                             .count());
+#endif
+        }
+
+        /**
+         * @brief Length of one tick, calibrated against steady_clock once
+         *
+         * The first call spins for about 10 ms to calibrate.
+         */
+        double nanoseconds_per_tick();
+
+        /**
+         * @brief Shards per metric: threads beyond this share shards
+         */
+        constexpr size_t kMaxShards = 64;
+
+        // Shard of the calling thread, assigned round-robin on first use
+        size_t next_thread_shard();
+        inline size_t thread_shard()
+        {
+            thread_local const size_t shard = next_thread_shard();
+            return shard;
+        }
+
+        /**
+         * @brief Latency distribution of one histogram
+         *
+         * Values are nanoseconds. Percentiles are the upper bound of the
+         * bucket holding the rank, so they overstate by at most one bucket
+         * width (1/32 of the value).
+         */
+        struct HistogramSnapshot
+        {
+            std::string name;
+            std::string help;
+            uint64_t count = 0;
+            double sum = 0.0;
+            double min = 0.0;
+            double max = 0.0;
+            std::vector<std::pair<double, uint64_t>> buckets; // (upper bound, count) of non-empty buckets, ascending
+
+            double mean() const { return count == 0 ? 0.0 : sum / static_cast<double>(count); }
+
+            /**
+             * @param quantile In [0, 1]
+             */
+            double percentile(double quantile) const;
+        };
+
+        /**
+         * @brief Value of one counter or gauge
+         */
+        struct ValueSnapshot
+        {
+            std::string name;
+            std::string help;
+            std::string labels; // Prometheus label set without braces, e.g. pool="0"
+            double value = 0.0;
+        };
+
+        /**
+         * @brief Every registered metric at one point in time
+         */
+        struct MetricsSnapshot
+        {
+            std::vector<ValueSnapshot> counters;
+            std::vector<ValueSnapshot> gauges;
+            std::vector<HistogramSnapshot> histograms;
+
+            const HistogramSnapshot *find_histogram(const std::string &name) const;
+            const ValueSnapshot *find_counter(const std::string &name) const;
+            const ValueSnapshot *find_gauge(const std::string &name, const std::string &labels = "") const;
+        };
+
+        /**
+         * @brief Monotonic count, summed over per-thread cells
+         *
+         * add() is one relaxed atomic add on the calling thread's own cache
+         * line, so counting from many threads never contends.
+         */
+        class Counter
+        {
+        public:
+            /**
+             * @param name Metric name (exported with a trading_ prefix)
+             * @param help One-line description
+             */
+            Counter(std::string name, std::string help);
+            ~Counter();
+
+            Counter(const Counter &) = delete;
+            Counter &operator=(const Counter &) = delete;
+
+            void add(uint64_t amount = 1)
+            {
+                if constexpr (kEnabled)
+                {
+                    cells_[thread_shard()].value.fetch_add(amount, std::memory_order_relaxed);
+                }
+            }
+
+            uint64_t value() const;
+            void reset();
+
+            const std::string &name() const { return name_; }
+            const std::string &help() const { return help_; }
+
+        private:
+            struct alignas(64) Cell
+            {
+                std::atomic<uint64_t> value{0};
+            };
+
+            std::string name_;
+            std::string help_;
+            Cell cells_[kMaxShards];
+        };
+
+        /**
+         * @brief Level that goes up and down (queue depth, bytes held), summed over per-thread cells
+         */
+        class Gauge
+        {
+        public:
+            Gauge(std::string name, std::string help);
+            ~Gauge();
+
+            Gauge(const Gauge &) = delete;
+            Gauge &operator=(const Gauge &) = delete;
+
+            void add(int64_t amount)
+            {
+                if constexpr (kEnabled)
+                {
+                    cells_[thread_shard()].value.fetch_add(amount, std::memory_order_relaxed);
+                }
+            }
+            void sub(int64_t amount) { add(-amount); }
+
+            int64_t value() const;
+
+            const std::string &name() const { return name_; }
+            const std::string &help() const { return help_; }
+
+        private:
+            struct alignas(64) Cell
+            {
+                std::atomic<int64_t> value{0};
+            };
+
+            std::string name_;
+            std::string help_;
+            Cell cells_[kMaxShards];
+        };
+
+        /**
+         * @brief HDR-style latency histogram with per-thread shards
+         *
+         * Buckets are log-linear: values below 64 ticks are exact, and
+         * every power of two above is split into 32 equal buckets, so any
+         * value up to 2^44 ticks (hours) is kept to within 1/32. A thread
+         * records into its own shard, allocated on its first record(), so
+         * recording is a couple of relaxed atomic adds on memory no other
+         * thread writes; snapshots merge the shards.
+         */
+        class Histogram
+        {
+        public:
+            static constexpr unsigned kSubBucketBits = 5;
+            static constexpr unsigned kMaxValueBits = 44;
+            static constexpr size_t kBuckets = (kMaxValueBits - kSubBucketBits + 1) << kSubBucketBits;
+
+            /**
+             * @param name Metric name; latency histograms end in _seconds
+             * @param help One-line description
+             */
+            Histogram(std::string name, std::string help);
+            ~Histogram();
+
+            Histogram(const Histogram &) = delete;
+            Histogram &operator=(const Histogram &) = delete;
+
+            /**
+             * @brief Record one duration in ticks
+             */
+            void record(uint64_t duration)
+            {
+                if constexpr (kEnabled)
+                {
+                    shard().record(duration);
+                }
+            }
+
+            /**
+             * @brief Bucket holding a value (values past the range land in the last one)
+             */
+            static size_t bucket_index(uint64_t value);
+
+            /**
+             * @brief Largest value that lands in a bucket
+             */
+            static uint64_t bucket_upper_bound(size_t index);
+
+            HistogramSnapshot snapshot() const;
+            void reset();
+
+            const std::string &name() const { return name_; }
+
+        private:
+            struct Shard
+            {
+                std::atomic<uint64_t> counts[kBuckets] = {};
+                std::atomic<uint64_t> sum{0};
+                std::atomic<uint64_t> min{UINT64_MAX};
+                std::atomic<uint64_t> max{0};
+
+                void record(uint64_t duration);
+            };
+
+            Shard &shard()
+            {
+                size_t index = thread_shard();
+                Shard *shard = shards_[index].load(std::memory_order_acquire);
+                return shard ? *shard : create_shard(index);
+            }
+            Shard &create_shard(size_t index);
+
+            std::string name_;
+            std::string help_;
+            std::atomic<Shard *> shards_[kMaxShards] = {};
+        };
+
+        /**
+         * @brief Records the lifetime of a scope into a histogram
+         */
+        class ScopedTimer
+        {
+        public:
+            explicit ScopedTimer(Histogram &histogram) : histogram_(histogram), start_(ticks()) {}
+            ~ScopedTimer() { histogram_.record(ticks() - start_); }
+
+            ScopedTimer(const ScopedTimer &) = delete;
+            ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+        private:
+            Histogram &histogram_;
+            uint64_t start_;
+        };
+
+        /**
+         * @brief Gauge read from a callback at snapshot time, for as long as this object lives
+         *
+         * For levels an object already tracks (queue depth, say), which cost
+         * nothing until someone looks. The callback runs on the thread
+         * taking the snapshot and must be safe to call from there.
+         */
+        class GaugeCallback
+        {
+        public:
+            GaugeCallback() = default;
+            GaugeCallback(std::string name, std::string help, std::string labels, std::function<double()> read);
+            ~GaugeCallback();
+
+            GaugeCallback(GaugeCallback &&other) noexcept : id_(std::exchange(other.id_, 0)) {}
+            GaugeCallback &operator=(GaugeCallback &&other) noexcept;
+            GaugeCallback(const GaugeCallback &) = delete;
+            GaugeCallback &operator=(const GaugeCallback &) = delete;
+
+        private:
+            uint64_t id_ = 0;
+        };
+
+        /**
+         * @brief Process-wide set of metrics
+         *
+         * Metrics register themselves on construction and leave on
+         * destruction; the registry only holds pointers, under a mutex that
+         * no recording path takes.
+         */
+        class Registry
+        {
+        public:
+            static Registry &global();
+
+            /**
+             * @brief Read every metric (gauge callbacks run on this thread)
+             */
+            MetricsSnapshot snapshot() const;
+
+            /**
+             * @brief Zero every counter and histogram (gauges are levels and are kept)
+             */
+            void reset();
+
+            // Used by the metric classes
+            void add(Counter *counter);
+            void remove(Counter *counter);
+            void add(Gauge *gauge);
+            void remove(Gauge *gauge);
+            void add(Histogram *histogram);
+            void remove(Histogram *histogram);
+            uint64_t add_callback(ValueSnapshot description, std::function<double()> read);
+            void remove_callback(uint64_t id);
+
+        private:
+            struct Callback
+            {
+                uint64_t id;
+                ValueSnapshot description;
+                std::function<double()> read;
+            };
+
+            mutable std::mutex mutex_;
+            std::vector<Counter *> counters_;
+            std::vector<Gauge *> gauges_;
+            std::vector<Histogram *> histograms_;
+            std::vector<Callback> callbacks_;
+            uint64_t next_callback_id_ = 1;
+        };
+
+        /**
+         * @brief Prometheus text exposition format (version 0.0.4)
+         *
+         * Names get a trading_ prefix. Histograms are exported as summaries
+         * in seconds (p50, p90, p99, p99.9 plus _sum and _count) with a
+         * separate _max gauge, since the bucket layout is too fine to
+         * export bucket by bucket.
+         */
+        std::string to_prometheus(const MetricsSnapshot &snapshot);
+
+        /**
+         * @brief JSON document with every metric; histogram figures in nanoseconds
+         */
+        std::string to_json(const MetricsSnapshot &snapshot);
+
+        /**
+         * @brief Minimal HTTP endpoint serving the global registry
+         *
+         * GET /metrics returns the Prometheus format, GET /metrics.json the
+         * JSON one. Requests are served one at a time on a background
+         * thread, each connection closed after its response. Binds to the
+         * loopback interface unless told otherwise. POSIX only.
+         */
+        class MetricsServer
+        {
+        public:
+            /**
+             * @param port TCP port (0 picks a free one, see port())
+             * @param address IPv4 address to listen on
+             * @throws std::runtime_error if the socket cannot be bound, or on platforms without sockets
+             */
+            explicit MetricsServer(uint16_t port = 9464, const std::string &address = "127.0.0.1");
+
+            /**
+             * @brief Stops serving and joins the thread
+             */
+            ~MetricsServer();
+
+            MetricsServer(const MetricsServer &) = delete;
+            MetricsServer &operator=(const MetricsServer &) = delete;
+
+            uint16_t port() const { return port_; }
+            uint64_t requests_served() const { return requests_.load(std::memory_order_relaxed); }
+
+        private:
+            void serve();
+            void handle(int client);
+
+            int listen_fd_ = -1;
+            uint16_t port_ = 0;
+            std::atomic<bool> stop_{false};
+            std::atomic<uint64_t> requests_{0};
+            std::thread thread_;
+        };
+
+    } // namespace metrics
+} // namespace trading
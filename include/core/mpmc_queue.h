@@ -0,0 +1,441 @@
+#pragma once
+
+#include "core/lock_free_queue.h"
+#include <atomic>
+#include <memory>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+
+namespace trading
+{
+
+    /**
+     * @brief Bounded lock-free multi-producer, multi-consumer queue
+     *
+     * The MPMC counterpart to LockFreeQueue, for fanning several feed
+     * threads into one dispatcher (or one feed out to several workers).
+     * Every slot carries a sequence number that says whose turn it is: a
+     * producer may fill slot i when its sequence equals the position being
+     * claimed, and a consumer may empty it when the sequence is one past
+     * that. Producers claim positions with a compare-and-swap on head_,
+     * consumers on tail_; the two indices sit on separate cache lines.
+     *
+     * The bulk calls claim a run of ready slots with one compare-and-swap,
+     * so a batch costs one contended index update instead of one per
+     * element.
+     *
+     * try_push() only fails when the queue is full and try_pop() only when
+     * it is empty (or every element is still being written); contention
+     * alone never makes them fail.
+     *
+     * The blocking calls wait according to the Wait parameter, as for
+     * LockFreeQueue. Notifications wake every parked thread, so give
+     * ParkingWait queues few consumers or expect some to find nothing.
+     */
+    template <typename T, typename Wait = BusySpinWait>
+    class MpmcQueue
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param capacity Maximum number of elements, rounded up to a power of 2 (at least 2)
+         */
+        explicit MpmcQueue(size_t capacity);
+
+        ~MpmcQueue() = default;
+
+        // Prevent copying and moving (the indices are atomics)
+        MpmcQueue(const MpmcQueue &) = delete;
+        MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+        /**
+         * @brief Try to push an element
+         * @param value Value to push
+         * @return true if successful, false if the queue is full
+         */
+        bool try_push(const T &value);
+
+        /**
+         * @brief Try to push an element (move version)
+         * @param value Value to push (will be moved)
+         * @return true if successful, false if the queue is full
+         */
+        bool try_push(T &&value);
+
+        /**
+         * @brief Push as many leading elements of a span as there are free slots
+         * @param values Elements to push; the pushed ones are moved from
+         * @return Number of elements pushed, 0 if the queue is full
+         *
+         * The pushed elements occupy consecutive positions, so a single
+         * consumer sees them together and in order.
+         */
+        size_t try_push_bulk(std::span<T> values);
+
+        /**
+         * @brief Try to pop an element
+         * @param value Reference to store the popped value
+         * @return true if successful, false if the queue is empty
+         */
+        bool try_pop(T &value);
+
+        /**
+         * @brief Pop up to out.size() consecutive elements
+         * @param out Destination for the popped elements
+         * @return Number of elements written to the front of out
+         */
+        size_t try_pop_bulk(std::span<T> out);
+
+        /**
+         * @brief Push an element, waiting while the queue is full
+         */
+        void push(const T &value);
+
+        /**
+         * @brief Push an element, waiting while the queue is full (move version)
+         */
+        void push(T &&value);
+
+        /**
+         * @brief Pop an element, waiting while the queue is empty
+         * @param value Reference to store the popped value
+         * @param stop Optional flag; once set, pop() returns false instead of waiting
+         * @return true if an element was popped, false if stopped with nothing to pop
+         *
+         * After setting stop, call wake_all() so that parked consumers see it.
+         */
+        bool pop(T &value, const std::atomic<bool> *stop = nullptr);
+
+        /**
+         * @brief Pop up to out.size() elements, waiting until there is at least one
+         * @return Number of elements popped, 0 only if stopped or out is empty
+         */
+        size_t pop_bulk(std::span<T> out, const std::atomic<bool> *stop = nullptr);
+
+        /**
+         * @brief Wake every waiting producer and consumer so they re-check
+         */
+        void wake_all();
+
+        /**
+         * @brief Check if the queue is empty (snapshot)
+         */
+        bool empty() const { return size() == 0; }
+
+        /**
+         * @brief Get the current number of elements (snapshot)
+         */
+        size_t size() const;
+
+        /**
+         * @brief Get the maximum capacity
+         */
+        size_t capacity() const { return capacity_; }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+
+        template <typename U>
+        bool push_one(U &&value);
+
+        // Signed distance between a slot's sequence and the expected one
+        static std::intptr_t lag(size_t sequence, size_t expected)
+        {
+            return static_cast<std::intptr_t>(sequence - expected);
+        }
+
+        // Whether the slot at the current index is ready (or the index is stale)
+        bool can_push() const
+        {
+            size_t pos = head_.load(std::memory_order_relaxed);
+            return lag(buffer_[pos & mask_].sequence.load(std::memory_order_acquire), pos) >= 0;
+        }
+
+        bool can_pop() const
+        {
+            size_t pos = tail_.load(std::memory_order_relaxed);
+            return lag(buffer_[pos & mask_].sequence.load(std::memory_order_acquire), pos + 1) >= 0;
+        }
+
+        static size_t next_power_of_2(size_t n);
+
+        std::unique_ptr<Cell[]> buffer_;
+        size_t capacity_;
+        size_t mask_;
+
+        alignas(kCacheLineSize) std::atomic<size_t> head_{0}; // Next position to fill
+        alignas(kCacheLineSize) std::atomic<size_t> tail_{0}; // Next position to empty
+
+        [[no_unique_address]] Wait not_empty_; // Consumers wait here, producers notify
+        [[no_unique_address]] Wait not_full_;  // Producers wait here, consumers notify
+    };
+
+    // Template implementation (must be in header for templates)
+
+    template <typename T, typename Wait>
+    MpmcQueue<T, Wait>::MpmcQueue(size_t capacity)
+        : capacity_(next_power_of_2(capacity)), mask_(capacity_ - 1)
+    {
+        buffer_ = std::make_unique<Cell[]>(capacity_);
+        for (size_t i = 0; i < capacity_; ++i)
+        {
+            buffer_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename T, typename Wait>
+    bool MpmcQueue<T, Wait>::try_push(const T &value)
+    {
+        return push_one(value);
+    }
+
+    template <typename T, typename Wait>
+    bool MpmcQueue<T, Wait>::try_push(T &&value)
+    {
+        return push_one(std::move(value));
+    }
+
+    template <typename T, typename Wait>
+    template <typename U>
+    bool MpmcQueue<T, Wait>::push_one(U &&value)
+    {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell &cell = buffer_[pos & mask_];
+            std::intptr_t diff = lag(cell.sequence.load(std::memory_order_acquire), pos);
+            if (diff == 0)
+            {
+                // Slot is free for this lap; claim the position
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.data = std::forward<U>(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    not_empty_.notify();
+                    return true;
+                }
+                // pos now holds the current head
+            }
+            else if (diff < 0)
+            {
+                // The consumer of the previous lap has not emptied it yet
+                return false;
+            }
+            else
+            {
+                // Another producer got here first
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <typename T, typename Wait>
+    size_t MpmcQueue<T, Wait>::try_push_bulk(std::span<T> values)
+    {
+        if (values.empty())
+        {
+            return 0;
+        }
+
+        size_t pos = head_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            std::intptr_t diff = lag(buffer_[pos & mask_].sequence.load(std::memory_order_acquire), pos);
+            if (diff < 0)
+            {
+                return 0;
+            }
+            if (diff > 0)
+            {
+                pos = head_.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            // Extend the claim over every following slot that is free too
+            size_t count = 1;
+            while (count < values.size() &&
+                   buffer_[(pos + count) & mask_].sequence.load(std::memory_order_acquire) == pos + count)
+            {
+                ++count;
+            }
+
+            if (head_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    Cell &cell = buffer_[(pos + i) & mask_];
+                    cell.data = std::move(values[i]);
+                    cell.sequence.store(pos + i + 1, std::memory_order_release);
+                }
+                not_empty_.notify();
+                return count;
+            }
+        }
+    }
+
+    template <typename T, typename Wait>
+    bool MpmcQueue<T, Wait>::try_pop(T &value)
+    {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell &cell = buffer_[pos & mask_];
+            std::intptr_t diff = lag(cell.sequence.load(std::memory_order_acquire), pos + 1);
+            if (diff == 0)
+            {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    value = std::move(cell.data);
+                    // Free the slot for the producer one lap ahead
+                    cell.sequence.store(pos + capacity_, std::memory_order_release);
+                    not_full_.notify();
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                // Nothing published at this position yet
+                return false;
+            }
+            else
+            {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <typename T, typename Wait>
+    size_t MpmcQueue<T, Wait>::try_pop_bulk(std::span<T> out)
+    {
+        if (out.empty())
+        {
+            return 0;
+        }
+
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            std::intptr_t diff = lag(buffer_[pos & mask_].sequence.load(std::memory_order_acquire), pos + 1);
+            if (diff < 0)
+            {
+                return 0;
+            }
+            if (diff > 0)
+            {
+                pos = tail_.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            // Stop at the first element that is not published yet
+            size_t count = 1;
+            while (count < out.size() &&
+                   buffer_[(pos + count) & mask_].sequence.load(std::memory_order_acquire) == pos + count + 1)
+            {
+                ++count;
+            }
+
+            if (tail_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    Cell &cell = buffer_[(pos + i) & mask_];
+                    out[i] = std::move(cell.data);
+                    cell.sequence.store(pos + i + capacity_, std::memory_order_release);
+                }
+                not_full_.notify();
+                return count;
+            }
+        }
+    }
+
+    template <typename T, typename Wait>
+    void MpmcQueue<T, Wait>::push(const T &value)
+    {
+        while (!try_push(value))
+        {
+            not_full_.wait([this]
+                           { return can_push(); });
+        }
+    }
+
+    template <typename T, typename Wait>
+    void MpmcQueue<T, Wait>::push(T &&value)
+    {
+        // A failed try_push leaves value untouched
+        while (!try_push(std::move(value)))
+        {
+            not_full_.wait([this]
+                           { return can_push(); });
+        }
+    }
+
+    template <typename T, typename Wait>
+    bool MpmcQueue<T, Wait>::pop(T &value, const std::atomic<bool> *stop)
+    {
+        while (!try_pop(value))
+        {
+            if (stop != nullptr && stop->load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            not_empty_.wait([this, stop]
+                            { return can_pop() || (stop != nullptr && stop->load(std::memory_order_acquire)); });
+        }
+        return true;
+    }
+
+    template <typename T, typename Wait>
+    size_t MpmcQueue<T, Wait>::pop_bulk(std::span<T> out, const std::atomic<bool> *stop)
+    {
+        if (out.empty())
+        {
+            return 0;
+        }
+
+        size_t count;
+        while ((count = try_pop_bulk(out)) == 0)
+        {
+            if (stop != nullptr && stop->load(std::memory_order_acquire))
+            {
+                return 0;
+            }
+            not_empty_.wait([this, stop]
+                            { return can_pop() || (stop != nullptr && stop->load(std::memory_order_acquire)); });
+        }
+        return count;
+    }
+
+    template <typename T, typename Wait>
+    void MpmcQueue<T, Wait>::wake_all()
+    {
+        not_empty_.wake_all();
+        not_full_.wake_all();
+    }
+
+    template <typename T, typename Wait>
+    size_t MpmcQueue<T, Wait>::size() const
+    {
+        // Tail first: head only grows, so the difference cannot underflow
+        size_t tail = tail_.load(std::memory_order_acquire);
+        size_t head = head_.load(std::memory_order_acquire);
+        return std::min(head - tail, capacity_);
+    }
+
+    template <typename T, typename Wait>
+    size_t MpmcQueue<T, Wait>::next_power_of_2(size_t n)
+    {
+        // A single slot cannot tell "full" from "empty" by sequence alone
+        size_t power = 2;
+        while (power < n)
+        {
+            power <<= 1;
+        }
+        return power;
+    }
+
+} // namespace trading
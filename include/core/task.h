@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace trading
+{
+
+    /**
+     * @brief Move-only type-erased void() callable with inline storage
+     *
+     * A replacement for std::function<void()> on the task-queue hot path.
+     * Callables up to kInlineSize bytes (a lambda capturing a promise and a
+     * few pointers, say) live inside the Task itself, so creating and
+     * queueing one does not allocate; larger ones fall back to the heap.
+     * Unlike std::function it accepts move-only callables such as lambdas
+     * that own a std::promise.
+     */
+    class Task
+    {
+    public:
+        static constexpr size_t kInlineSize = 56;
+
+        Task() = default;
+
+        template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+        Task(F &&callable)
+        {
+            using Callable = std::decay_t<F>;
+            if constexpr (fits_inline<Callable>())
+            {
+                ::new (static_cast<void *>(storage_)) Callable(std::forward<F>(callable));
+                vtable_ = &inline_vtable<Callable>;
+            }
+            else
+            {
+                ::new (static_cast<void *>(storage_)) Callable *(new Callable(std::forward<F>(callable)));
+                vtable_ = &heap_vtable<Callable>;
+            }
+        }
+
+        Task(Task &&other) noexcept
+        {
+            move_from(other);
+        }
+
+        Task &operator=(Task &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                move_from(other);
+            }
+            return *this;
+        }
+
+        Task(const Task &) = delete;
+        Task &operator=(const Task &) = delete;
+
+        ~Task() { reset(); }
+
+        /**
+         * @brief Invoke the callable
+         */
+        void operator()() { vtable_->invoke(storage_); }
+
+        explicit operator bool() const { return vtable_ != nullptr; }
+
+        /**
+         * @brief Destroy the held callable, leaving the Task empty
+         */
+        void reset()
+        {
+            if (vtable_)
+            {
+                vtable_->destroy(storage_);
+                vtable_ = nullptr;
+            }
+        }
+
+        /**
+         * @brief True if callables of type F are stored without allocating
+         */
+        template <typename F>
+        static constexpr bool fits_inline()
+        {
+            return sizeof(F) <= kInlineSize && alignof(F) <= alignof(std::max_align_t) &&
+                   std::is_nothrow_move_constructible_v<F>;
+        }
+
+    private:
+        struct VTable
+        {
+            void (*invoke)(void *storage);
+            void (*move)(void *destination, void *source); // Leaves source destroyed
+            void (*destroy)(void *storage);
+        };
+
+        template <typename F>
+        static constexpr VTable inline_vtable{
+            [](void *storage)
+            { (*std::launder(static_cast<F *>(storage)))(); },
+            [](void *destination, void *source)
+            {
+                F *from = std::launder(static_cast<F *>(source));
+                ::new (destination) F(std::move(*from));
+                from->~F();
+            },
+            [](void *storage)
+            { std::launder(static_cast<F *>(storage))->~F(); }};
+
+        template <typename F>
+        static constexpr VTable heap_vtable{
+            [](void *storage)
+            { (**static_cast<F **>(storage))(); },
+            [](void *destination, void *source)
+            { *static_cast<F **>(destination) = *static_cast<F **>(source); },
+            [](void *storage)
+            { delete *static_cast<F **>(storage); }};
+
+        void move_from(Task &other) noexcept
+        {
+            if (other.vtable_)
+            {
+                other.vtable_->move(storage_, other.storage_);
+                vtable_ = other.vtable_;
+                other.vtable_ = nullptr;
+            }
+        }
+
+        alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+        const VTable *vtable_ = nullptr;
+    };
+
+} // namespace trading
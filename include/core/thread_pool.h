@@ -1,29 +1,78 @@
 #pragma once
 
+#include "core/task.h"
+#include "core/metrics.h"
 #include <vector>
-#include <queue>
+#include <deque>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <functional>
 #include <future>
 #include <atomic>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
 
 namespace trading
 {
 
     /**
-     * @brief Thread-safe thread pool for parallel task execution
+     * @brief How ThreadPool workers are pinned to CPUs
+     */
+    enum class AffinityMode
+    {
+        NONE,     // Let the OS schedule workers anywhere
+        CORE,     // Pin each worker to one CPU, round-robin over the CPU list
+        NUMA_NODE // Pin workers to all CPUs of a NUMA node, in contiguous blocks
+    };
+
+    /**
+     * @brief ThreadPool construction options
+     */
+    struct ThreadPoolConfig
+    {
+        size_t num_threads = 0;                    // Latency-critical workers (0 = one per CPU)
+        size_t num_background_threads = 0;         // Background lane (0 = idle workers serve it)
+        AffinityMode affinity = AffinityMode::NONE; // Worker pinning
+        std::vector<int> cpus;                     // CPUs to place workers on (empty = all allowed)
+        bool lower_background_priority = true;     // Run background threads at a higher nice value
+    };
+
+    /**
+     * @brief Work-stealing thread pool for parallel task execution
      *
      * This class manages a pool of worker threads that can execute tasks in parallel.
      * It's designed for high-performance scenarios where you need to process many
-     * independent tasks efficiently.
+     * independent, fine-grained tasks efficiently.
+     *
+     * Each worker owns a task deque. Tasks submitted from a worker go to its
+     * own deque; tasks from other threads are spread round-robin. A worker
+     * takes its own tasks oldest first and, when it runs dry, steals the
+     * newest task from another worker. There is no global queue lock, and
+     * tasks are stored in a small-buffer Task, so submitting one allocates
+     * only the future's shared state, and parallel_for allocates nothing
+     * per index.
+     *
+     * Work submitted with submit_background() goes to a separate lane.
+     * With dedicated background threads, workers never touch it; without,
+     * workers only take background tasks when no other work is queued.
+     * Either way background I/O never sits ahead of latency-critical work.
+     *
+     * Workers can be pinned to cores or NUMA nodes (Linux only; elsewhere
+     * the setting is ignored). Each worker allocates its own queue from its
+     * own thread so first-touch placement keeps it node-local, steals from
+     * workers on its own node first, and on_each_worker() lets callers set
+     * up per-worker buffers the same way.
      *
      * Key features:
      * - Thread-safe task submission
-     * - Automatic load balancing
-     * - Graceful shutdown
-     * - Exception safety
+     * - Automatic load balancing through work stealing
+     * - Batch submission with one wake-up for many tasks
+     * - Graceful shutdown (queued tasks still run)
+     * - Exception safety (task exceptions reach the future)
      */
     class ThreadPool
     {
@@ -37,6 +86,14 @@ namespace trading
          */
         explicit ThreadPool(size_t num_threads = 0);
 
+        /**
+         * @brief Constructor with placement and lane options
+         * @param config Thread counts, affinity and background lane settings
+         */
+        explicit ThreadPool(const ThreadPoolConfig &config);
+
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
         /**
          * @brief Destructor
          *
@@ -44,14 +101,10 @@ namespace trading
          */
         ~ThreadPool();
 
-        // Prevent copying
+        // Prevent copying and moving (workers hold a pointer to the pool)
         ThreadPool(const ThreadPool &) = delete;
         ThreadPool &operator=(const ThreadPool &) = delete;
 
-        // Allow moving
-        ThreadPool(ThreadPool &&) noexcept;
-        ThreadPool &operator=(ThreadPool &&) noexcept;
-
         /**
          * @brief Submit a task for execution
          * @param task Function to execute
@@ -64,11 +117,78 @@ namespace trading
         auto submit(F &&task, Args &&...args)
             -> std::future<typename std::invoke_result_t<F, Args...>>;
 
+        /**
+         * @brief Submit a low-priority task (disk I/O, housekeeping)
+         * @param task Function to execute
+         * @return Future containing the result
+         *
+         * Runs on the background lane, never ahead of work from submit().
+         */
+        template <typename F, typename... Args>
+        auto submit_background(F &&task, Args &&...args)
+            -> std::future<typename std::invoke_result_t<F, Args...>>;
+
+        /**
+         * @brief Submit count tasks with a single wake-up
+         * @param count Number of tasks
+         * @param task Function called as task(i) for i in [0, count)
+         * @return One future per task, in index order
+         *
+         * The function object is shared by all tasks rather than copied.
+         */
+        template <typename F>
+        auto submit_batch(size_t count, F &&task)
+            -> std::vector<std::future<typename std::invoke_result_t<F &, size_t>>>;
+
+        /**
+         * @brief Run body(i) for every i in [begin, end) and wait
+         * @param begin First index
+         * @param end One past the last index
+         * @param body Function called with each index
+         * @param grain Indices per chunk (0 picks one from the range and pool size)
+         *
+         * Chunks are claimed dynamically by the calling thread and up to
+         * thread_count() helper tasks, so uneven chunks balance out. The
+         * caller takes part, which also makes nested calls from inside a
+         * task safe. The first exception thrown by body is rethrown here
+         * after the remaining chunks have been skipped.
+         */
+        template <typename F>
+        void parallel_for(size_t begin, size_t end, F &&body, size_t grain = 0);
+
+        /**
+         * @brief Run task(worker) once on every worker thread and wait
+         * @param task Function called with the worker index
+         *
+         * Useful for first-touch allocation of per-worker buffers next to
+         * the worker that will use them. The first exception is rethrown.
+         * May be called from workers, also several at once.
+         */
+        void on_each_worker(const std::function<void(size_t)> &task);
+
         /**
          * @brief Get the number of worker threads
-         * @return Number of threads in the pool
+         * @return Number of threads in the pool, excluding the background lane
          */
-        size_t thread_count() const { return workers_.size(); }
+        size_t thread_count() const { return num_workers_; }
+
+        /**
+         * @brief Get the number of dedicated background threads
+         */
+        size_t background_thread_count() const { return num_background_; }
+
+        /**
+         * @brief Index of the calling worker thread
+         * @return Worker index, or npos if not called from one of this pool's workers
+         */
+        size_t worker_index() const;
+
+        /**
+         * @brief NUMA node a worker is placed on
+         * @param worker Worker index
+         * @return Node id, or -1 if the worker is not pinned to a known node
+         */
+        int worker_numa_node(size_t worker) const;
 
         /**
          * @brief Get the number of pending tasks
@@ -79,7 +199,9 @@ namespace trading
         /**
          * @brief Wait for all tasks to complete
          *
-         * Blocks until all submitted tasks have been executed.
+         * Blocks until all submitted tasks have been executed, including
+         * tasks they submit in turn.
+         * @throws std::logic_error if called from one of the pool's tasks
          */
         void wait_all();
 
@@ -92,58 +214,189 @@ namespace trading
         void shutdown();
 
     private:
-        // Worker thread function
-        void worker_function();
+        struct Worker;
+
+        struct Placement;
+
+        // A queued task and when it was queued, for the queue-wait histograms
+        struct QueuedTask
+        {
+            Task task;
+            uint64_t queued_at = 0; // metrics::ticks()
+            bool background = false;
+        };
+
+        // Wrap a callable and its promise in a Task
+        template <typename F, typename... Args>
+        static auto package(F &&task, Args &&...args)
+            -> std::pair<Task, std::future<typename std::invoke_result_t<F, Args...>>>;
+
+        // Queue tasks and wake workers
+        void enqueue(Task task);
+        void enqueue_batch(std::vector<Task> &tasks);
+        void enqueue_background(Task task);
+        void admit(size_t count, std::atomic<size_t> *queued);
+        void push(size_t queue, Task task);
+        void wake(size_t count);
+
+        // Worker side
+        void start_threads(const ThreadPoolConfig &config);
+        void worker_function(size_t index);
+        void background_function();
+        bool try_pop(size_t index, QueuedTask &task);
+        bool has_work(size_t index) const;
+        void run(QueuedTask &task);
+
+        // Shared by parallel_for instantiations
+        void parallel_chunks(size_t num_chunks, const std::function<void(size_t)> &chunk_body);
 
         // Member variables
-        std::vector<std::thread> workers_;        // Worker threads
-        std::queue<std::function<void()>> tasks_; // Task queue
+        size_t num_workers_ = 0;
+        size_t num_background_ = 0;
+        std::vector<std::unique_ptr<Worker>> workers_; // Each allocated by its own thread
+        std::vector<std::thread> threads_;             // Workers, then the background lane
+        std::atomic<size_t> next_queue_{0};            // Round-robin target for external submissions
+
+        // Background lane
+        std::mutex background_mutex_;
+        std::deque<QueuedTask> background_;
+        std::condition_variable background_condition_;
+        std::atomic<size_t> background_pending_{0};
 
         // Synchronization primitives
-        mutable std::mutex queue_mutex_;    // Protects task queue
-        std::condition_variable condition_; // Signals workers
-        std::atomic<bool> stop_;            // Shutdown flag
-
-        // Statistics
-        mutable std::mutex stats_mutex_;         // Protects statistics
-        std::atomic<size_t> active_tasks_{0};    // Currently executing tasks
-        std::atomic<size_t> completed_tasks_{0}; // Completed tasks
+        std::mutex sleep_mutex_;                  // Guards sleeping and shutdown
+        std::condition_variable sleep_condition_; // Signals idle workers
+        std::atomic<size_t> sleepers_{0};         // Workers waiting for tasks
+        std::atomic<bool> stop_{false};           // Shutdown flag
+        bool joined_ = false;
+
+        // Task accounting
+        std::atomic<size_t> pending_{0};    // Queued, not yet taken
+        std::atomic<size_t> unfinished_{0}; // Queued or running
+        std::mutex done_mutex_;
+        std::condition_variable done_condition_; // Signals wait_all
+
+        // Queue depth gauges, labelled with this pool's id; declared last so
+        // they are unregistered before anything they read is destroyed
+        std::vector<metrics::GaugeCallback> gauges_;
     };
 
     // Template implementation (must be in header for templates)
+    template <typename F, typename... Args>
+    auto ThreadPool::package(F &&task, Args &&...args)
+        -> std::pair<Task, std::future<typename std::invoke_result_t<F, Args...>>>
+    {
+        using return_type = typename std::invoke_result_t<F, Args...>;
+
+        std::promise<return_type> promise;
+        std::future<return_type> result = promise.get_future();
+
+        // The promise and the callable travel inside the Task itself
+        Task packaged([promise = std::move(promise), fn = std::forward<F>(task),
+                       bound = std::make_tuple(std::forward<Args>(args)...)]() mutable
+                      {
+            try
+            {
+                if constexpr (std::is_void_v<return_type>)
+                {
+                    std::apply(fn, std::move(bound));
+                    promise.set_value();
+                }
+                else
+                {
+                    promise.set_value(std::apply(fn, std::move(bound)));
+                }
+            }
+            catch (...)
+            {
+                promise.set_exception(std::current_exception());
+            } });
+
+        return {std::move(packaged), std::move(result)};
+    }
+
     template <typename F, typename... Args>
     auto ThreadPool::submit(F &&task, Args &&...args)
         -> std::future<typename std::invoke_result_t<F, Args...>>
     {
+        auto packaged = package(std::forward<F>(task), std::forward<Args>(args)...);
+        enqueue(std::move(packaged.first));
+        return std::move(packaged.second);
+    }
 
-        using return_type = typename std::invoke_result_t<F, Args...>;
+    template <typename F, typename... Args>
+    auto ThreadPool::submit_background(F &&task, Args &&...args)
+        -> std::future<typename std::invoke_result_t<F, Args...>>
+    {
+        auto packaged = package(std::forward<F>(task), std::forward<Args>(args)...);
+        enqueue_background(std::move(packaged.first));
+        return std::move(packaged.second);
+    }
 
-        // Create a packaged_task that will execute our function
-        auto packaged_task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(task), std::forward<Args>(args)...));
+    template <typename F>
+    auto ThreadPool::submit_batch(size_t count, F &&task)
+        -> std::vector<std::future<typename std::invoke_result_t<F &, size_t>>>
+    {
+        using return_type = typename std::invoke_result_t<F &, size_t>;
 
-        // Get the future from the packaged_task
-        std::future<return_type> result = packaged_task->get_future();
+        auto shared = std::make_shared<std::decay_t<F>>(std::forward<F>(task));
+        std::vector<std::future<return_type>> futures;
+        std::vector<Task> tasks;
+        futures.reserve(count);
+        tasks.reserve(count);
 
+        for (size_t i = 0; i < count; ++i)
         {
-            // Lock the queue to add the task
-            std::lock_guard<std::mutex> lock(queue_mutex_);
+            std::promise<return_type> promise;
+            futures.push_back(promise.get_future());
+            tasks.emplace_back([promise = std::move(promise), shared, i]() mutable
+                               {
+                try
+                {
+                    if constexpr (std::is_void_v<return_type>)
+                    {
+                        (*shared)(i);
+                        promise.set_value();
+                    }
+                    else
+                    {
+                        promise.set_value((*shared)(i));
+                    }
+                }
+                catch (...)
+                {
+                    promise.set_exception(std::current_exception());
+                } });
+        }
 
-            // Don't allow submission after shutdown
-            if (stop_)
-            {
-                throw std::runtime_error("submit on stopped ThreadPool");
-            }
+        enqueue_batch(tasks);
+        return futures;
+    }
 
-            // Add the task to the queue
-            tasks_.emplace([packaged_task]()
-                           { (*packaged_task)(); });
+    template <typename F>
+    void ThreadPool::parallel_for(size_t begin, size_t end, F &&body, size_t grain)
+    {
+        if (end <= begin)
+        {
+            return;
         }
 
-        // Notify one worker thread that a task is available
-        condition_.notify_one();
+        const size_t count = end - begin;
+        if (grain == 0)
+        {
+            // A few chunks per participant keeps the tail short
+            grain = std::max<size_t>(1, count / ((num_workers_ + 1) * 4));
+        }
+        const size_t num_chunks = (count + grain - 1) / grain;
 
-        return result;
+        parallel_chunks(num_chunks, [&](size_t chunk)
+                        {
+            size_t first = begin + chunk * grain;
+            size_t last = std::min(end, first + grain);
+            for (size_t i = first; i < last; ++i)
+            {
+                body(i);
+            } });
     }
 
-} // namespace trading
\ No newline at end of file
+} // namespace trading
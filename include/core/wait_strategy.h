@@ -0,0 +1,170 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+
+namespace trading
+{
+
+    /**
+     * @brief Cache line size used to keep producer and consumer state apart
+     */
+    inline constexpr size_t kCacheLineSize = 64;
+
+    /**
+     * @brief Tell the CPU we are in a spin loop (PAUSE on x86, YIELD on ARM)
+     */
+    inline void cpu_relax() noexcept
+    {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+        asm volatile("yield" ::: "memory");
+#endif
+    }
+
+    /*
+     * Wait strategies decide what a blocking queue operation does while it
+     * cannot make progress. LockFreeQueue and MpmcQueue take one as a
+     * template parameter and keep one instance per direction: consumers
+     * wait on "not empty" (notified by producers) and producers on "not
+     * full" (notified by consumers). A strategy provides:
+     *
+     *   template <typename Ready> void wait(Ready ready);  // returns once ready() is true
+     *   void notify() noexcept;    // called after every push (or pop)
+     *   void wake_all() noexcept;  // make every waiter re-check, e.g. on shutdown
+     *
+     * The try_* operations never wait, and with BusySpinWait or
+     * SpinThenYieldWait notify() compiles to nothing.
+     */
+
+    /**
+     * @brief Spin on the condition without ever giving up the core
+     *
+     * Lowest wake-up latency, one full core per waiting thread. For
+     * dedicated, pinned threads only.
+     */
+    struct BusySpinWait
+    {
+        template <typename Ready>
+        void wait(Ready ready)
+        {
+            while (!ready())
+            {
+                cpu_relax();
+            }
+        }
+
+        void notify() noexcept {}
+        void wake_all() noexcept {}
+    };
+
+    /**
+     * @brief Spin for a short while, then yield the core between checks
+     *
+     * Almost as fast as spinning when data arrives within a few
+     * microseconds, and lets other runnable threads use the core when it
+     * does not. An idle waiter still wakes up on every scheduler tick.
+     */
+    struct SpinThenYieldWait
+    {
+        static constexpr size_t kSpinLimit = 256;
+
+        template <typename Ready>
+        void wait(Ready ready)
+        {
+            for (size_t i = 0; i < kSpinLimit; ++i)
+            {
+                if (ready())
+                {
+                    return;
+                }
+                cpu_relax();
+            }
+            while (!ready())
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        void notify() noexcept {}
+        void wake_all() noexcept {}
+    };
+
+    /**
+     * @brief Spin briefly, then park the thread until notified
+     *
+     * Parks on std::atomic::wait (a futex on Linux), so an idle waiter
+     * costs no CPU. The waker only makes the system call when someone is
+     * actually parked. Its fast path is a fence and one load of a counter
+     * that lives on its own cache line; that fence is the price every
+     * push (or pop) pays for the parking side.
+     */
+    class alignas(kCacheLineSize) ParkingWait
+    {
+    public:
+        static constexpr size_t kSpinLimit = 128;
+
+        template <typename Ready>
+        void wait(Ready ready)
+        {
+            for (size_t i = 0; i < kSpinLimit; ++i)
+            {
+                if (ready())
+                {
+                    return;
+                }
+                cpu_relax();
+            }
+
+            while (true)
+            {
+                // Announce ourselves before the final check, so a notify()
+                // that misses the condition cannot also miss us
+                uint32_t epoch = epoch_.load(std::memory_order_acquire);
+                parked_.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (ready())
+                {
+                    parked_.fetch_sub(1, std::memory_order_relaxed);
+                    return;
+                }
+                epoch_.wait(epoch, std::memory_order_acquire);
+                parked_.fetch_sub(1, std::memory_order_relaxed);
+                if (ready())
+                {
+                    return;
+                }
+            }
+        }
+
+        void notify() noexcept
+        {
+            // Pairs with the fence in wait(): either the waiter sees our
+            // update, or we see it parked
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (parked_.load(std::memory_order_relaxed) != 0)
+            {
+                wake_all();
+            }
+        }
+
+        void wake_all() noexcept
+        {
+            epoch_.fetch_add(1, std::memory_order_release);
+            epoch_.notify_all();
+        }
+
+        /**
+         * @brief Number of threads currently parked (snapshot)
+         */
+        uint32_t parked() const { return parked_.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<uint32_t> epoch_{0};
+        std::atomic<uint32_t> parked_{0};
+    };
+
+} // namespace trading
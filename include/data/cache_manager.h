@@ -1,33 +1,74 @@
 #pragma once
 
 #include "data/market_data.h"
+#include "data/columnar_file.h"
 #include "core/thread_pool.h"
 #include <string>
 #include <unordered_map>
-#include <list>
+#include <vector>
 #include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
 #include <chrono>
 #include <memory>
 #include <optional>
+#include <future>
+#include <atomic>
+#include <functional>
 
 namespace trading
 {
 
     /**
      * @brief Cache entry for market data
+     *
+     * One slot of a shard's CLOCK ring. The access fields are atomic so
+     * hits can update them under a shared lock.
      */
     struct CacheEntry
     {
-        MarketDataSeries data;
-        size_t size_bytes;
-        std::chrono::steady_clock::time_point last_accessed;
+        std::string key;
+        std::shared_ptr<const MarketDataSeries> data; // nullptr for a free slot
+        size_t size_bytes = 0;
+        std::atomic<bool> referenced{false};           // CLOCK reference bit
+        std::atomic<int64_t> last_accessed_ns{0};      // steady_clock ticks in ns
         std::chrono::steady_clock::time_point created;
 
         CacheEntry() = default;
     };
 
     /**
-     * @brief Market data cache manager with LRU eviction and disk persistence
+     * @brief Index record for an entry persisted on disk
+     *
+     * Kept for every persisted key whether or not it is resident, and
+     * saved to metadata.json so startup does not have to open the files.
+     */
+    struct DiskIndexEntry
+    {
+        size_t size_bytes = 0;                               // Estimated in-memory size
+        std::chrono::system_clock::time_point last_accessed; // Wall clock, survives restarts
+    };
+
+    /**
+     * @brief Sharded market data cache with CLOCK eviction and disk persistence
+     *
+     * Keys hash to one of N independently locked shards. Each shard guards
+     * its map with a std::shared_mutex: hits take only the shared lock, set
+     * the entry's CLOCK reference bit and hand out a shared_ptr to the
+     * cached series, so concurrent readers neither serialize nor copy.
+     * Writers and eviction take the exclusive lock of one shard at a time.
+     * The memory budget is global; when it is exceeded, each shard's CLOCK
+     * hand nominates its next unreferenced entry and the least recently
+     * used nominee is evicted.
+     *
+     * Entries are persisted in the binary columnar format (see
+     * columnar_file.h), which loads by memory-mapping the file instead of
+     * parsing it. Cache files written by older versions as JSON are still
+     * read; JSON is otherwise only produced by export_to_json().
+     *
+     * Startup reads only the metadata index. Persisted entries are faulted
+     * in on their first get(), and warm_up_async() can load them in the
+     * background, most recently used first.
      */
     class CacheManager
     {
@@ -47,6 +88,18 @@ namespace trading
          */
         CacheManager(size_t max_memory_mb, const std::string &cache_dir, std::shared_ptr<ThreadPool> thread_pool);
 
+        /**
+         * @brief Constructor with thread pool and shard count
+         * @param max_memory_mb Maximum memory usage in MB
+         * @param cache_dir Directory for disk cache
+         * @param thread_pool Thread pool for async operations (may be nullptr)
+         * @param num_shards Number of independently locked shards
+         */
+        CacheManager(size_t max_memory_mb, const std::string &cache_dir, std::shared_ptr<ThreadPool> thread_pool,
+                     size_t num_shards);
+
+        static constexpr size_t kDefaultShardCount = 16;
+
         /**
          * @brief Destructor
          */
@@ -63,17 +116,28 @@ namespace trading
         /**
          * @brief Get cached data
          * @param key Cache key
-         * @return Cached data if available
+         * @return Shared, immutable cached data, or nullptr if not cached
+         *
+         * Entries that are only on disk are loaded and made resident. The
+         * returned series stays valid after eviction for as long as the
+         * caller holds it.
          */
-        std::optional<MarketDataSeries> get(const std::string &key);
+        std::shared_ptr<const MarketDataSeries> get(const std::string &key);
 
         /**
          * @brief Store data in cache
          * @param key Cache key
-         * @param data Market data to cache
+         * @param data Market data to cache (copied once)
          */
         void put(const std::string &key, const MarketDataSeries &data);
 
+        /**
+         * @brief Store shared data in cache without copying it
+         * @param key Cache key
+         * @param data Market data to cache
+         */
+        void put(const std::string &key, std::shared_ptr<const MarketDataSeries> data);
+
         /**
          * @brief Remove cache entry
          * @param key Cache key
@@ -88,10 +152,22 @@ namespace trading
         /**
          * @brief Check if data is cached
          * @param key Cache key
-         * @return true if cached
+         * @return true if cached in memory or on disk
          */
         bool contains(const std::string &key) const;
 
+        /**
+         * @brief Check if data is resident in memory
+         * @param key Cache key
+         * @return true if get() will not touch the disk
+         */
+        bool is_resident(const std::string &key) const;
+
+        /**
+         * @brief Get number of entries persisted on disk
+         */
+        size_t indexed_size() const;
+
         /**
          * @brief Get cache size
          * @return Number of cache entries
@@ -104,12 +180,54 @@ namespace trading
          */
         size_t memory_usage() const;
 
+        /**
+         * @brief Charge memory held by a companion cache against this budget
+         * @param bytes Bytes to reserve
+         * @param allow_evict Evict cached series to make room
+         * @return true if reserved; on false nothing is reserved
+         *
+         * Lets caches of data derived from series (see IndicatorCache)
+         * share one memory limit with the series themselves. Every
+         * reservation must eventually be returned with release_memory().
+         */
+        bool reserve_memory(size_t bytes, bool allow_evict = true);
+
+        /**
+         * @brief Return memory reserved with reserve_memory()
+         * @param bytes Bytes to release
+         */
+        void release_memory(size_t bytes);
+
+        /**
+         * @brief Register a companion cache that put() can take memory back from
+         * @param reclaim Called when no series is left to evict; frees one
+         *        entry, releases its reservation and returns true, or
+         *        returns false when it holds nothing. Must not call back
+         *        into add_reclaimer() or remove_reclaimer().
+         * @return Handle for remove_reclaimer()
+         */
+        size_t add_reclaimer(std::function<bool()> reclaim);
+
+        /**
+         * @brief Unregister a reclaimer
+         * @param handle Value returned by add_reclaimer()
+         *
+         * Waits for a running call to the reclaimer to return, so its
+         * owner may be destroyed afterwards.
+         */
+        void remove_reclaimer(size_t handle);
+
         /**
          * @brief Get cache hit rate
-         * @return Hit rate as percentage
+         * @return Hit rate as a fraction of get() calls
          */
         double hit_rate() const;
 
+        /**
+         * @brief Get number of shards
+         */
+        size_t shard_count() const { return num_shards_; }
+
         /**
          * @brief Clean up expired entries
          * @param max_age Maximum age for entries
@@ -118,32 +236,82 @@ namespace trading
 
         /**
          * @brief Preload cache from disk
+         *
+         * Eagerly loads every persisted entry on the calling thread.
          */
         void preload_from_disk();
 
+        /**
+         * @brief Load persisted entries in the background
+         * @return Future holding the number of entries loaded
+         *
+         * Runs on the attached thread pool (inline without one). Entries are
+         * loaded most recently accessed first; an entry that would not fit
+         * in the remaining memory budget is skipped, and nothing resident is
+         * evicted to make room. Stops early if the manager is destroyed.
+         */
+        std::shared_future<size_t> warm_up_async();
+
+        /**
+         * @brief Map a persisted entry without loading it into memory
+         * @param key Cache key
+         * @param verify_checksum Hash the column data when opening (reads every page)
+         * @return Mapped file exposing the columns in place, or nullptr if
+         *         the entry is not on disk in the columnar format
+         */
+        std::shared_ptr<const MappedColumnarFile> map_from_disk(const std::string &key, bool verify_checksum = true) const;
+
+        /**
+         * @brief Export a cached entry as JSON
+         * @param key Cache key
+         * @param filepath Destination file
+         * @return true if the entry was found and written
+         */
+        bool export_to_json(const std::string &key, const std::string &filepath);
+
     private:
+        struct Shard;
+
         // Helper methods
-        void evict_lru_item();
+        Shard &shard_for(const std::string &key) const;
+        bool insert(const std::string &key, std::shared_ptr<const MarketDataSeries> data, bool persist, bool allow_evict);
+        bool next_victim(Shard &shard, size_t &slot, int64_t &last_accessed_ns);
+        bool evict_one();
+        bool reclaim_one();
+        void erase_locked(Shard &shard, const std::string &key);
+        void remove_locked(Shard &shard, const std::string &key);
+        size_t warm_up();
         size_t estimate_memory_usage(const MarketDataSeries &data) const;
         std::string get_cache_file_path(const std::string &key) const;
         void persist_to_disk(const std::string &key, const MarketDataSeries &data);
-        std::optional<MarketDataSeries> load_from_disk(const std::string &key);
+        std::optional<MarketDataSeries> load_from_disk(const std::string &key) const;
+        std::optional<MarketDataSeries> load_legacy_json(const std::string &filepath) const;
         void load_cache_metadata();
         void save_cache_metadata();
 
         // Member variables
-        mutable std::mutex cache_mutex_;
-        std::unordered_map<std::string, CacheEntry> cache_;
-        std::list<std::string> lru_list_; // Most recently used first
+        size_t num_shards_;
+        std::unique_ptr<Shard[]> shards_;
 
         size_t max_memory_bytes_;
-        size_t current_memory_bytes_;
+        std::atomic<size_t> current_memory_bytes_{0};
         std::string cache_dir_;
         std::shared_ptr<ThreadPool> thread_pool_;
 
-        // Statistics
-        size_t total_requests_{0};
-        size_t cache_hits_{0};
+        // Companion caches sharing the budget, asked in order
+        std::mutex reclaim_mutex_;
+        std::vector<std::pair<size_t, std::function<bool()>>> reclaimers_;
+        size_t next_reclaimer_ = 0;
+
+        // Background warm-up
+        std::mutex warm_up_mutex_;
+        std::shared_future<size_t> warm_up_future_;
+        std::atomic<bool> stop_warm_up_{false};
+
+        // Background persistence; the destructor waits for these
+        std::atomic<size_t> pending_persists_{0};
+        std::mutex persist_mutex_;
+        std::condition_variable persist_done_;
     };
 
-} // namespace trading
\ No newline at end of file
+} // namespace trading
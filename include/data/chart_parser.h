@@ -0,0 +1,136 @@
+#pragma once
+
+#include "data/columnar_series.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace trading
+{
+
+    /**
+     * @brief Incremental parser for Yahoo Finance chart responses
+     *
+     * Accepts the response body in arbitrary chunks, as they arrive from
+     * the network, and writes the OHLCV arrays straight into the columns
+     * of a ColumnarSeries. No document tree is built and the body is never
+     * buffered: the only state carried between chunks is the container
+     * stack and at most one partial token, so memory beyond the output
+     * columns stays constant however large the response is.
+     *
+     * Only chart.result[0].timestamp, chart.result[0].indicators.quote[0]
+     * and chart.error are interpreted; everything else is validated as
+     * JSON and skipped. As with the DOM parser it replaces, rows with a
+     * missing open, high, low or close are dropped and a missing volume
+     * reads as zero.
+     */
+    class ChartStreamParser
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param symbol Symbol stored in the resulting series
+         */
+        explicit ChartStreamParser(const std::string &symbol);
+
+        /**
+         * @brief Parse the next chunk of the response
+         * @param chunk Bytes following those already fed
+         * @throws std::runtime_error on malformed JSON
+         */
+        void feed(std::string_view chunk);
+
+        /**
+         * @brief Finish parsing and take the series
+         * @return Parsed series
+         * @throws std::runtime_error if the input was truncated or the API
+         *         reported an error
+         */
+        ColumnarSeries finish();
+
+        /**
+         * @brief Number of bytes fed so far
+         */
+        size_t bytes_consumed() const { return bytes_consumed_; }
+
+    private:
+        enum class Column
+        {
+            NONE,
+            TIMESTAMP,
+            OPEN,
+            HIGH,
+            LOW,
+            CLOSE,
+            VOLUME
+        };
+
+        enum class Expect
+        {
+            VALUE,
+            VALUE_OR_END, // After '['
+            KEY,
+            KEY_OR_END, // After '{'
+            COLON,
+            COMMA_OR_END,
+            DONE
+        };
+
+        enum class Token
+        {
+            NONE,
+            STRING,
+            NUMBER,
+            LITERAL
+        };
+
+        struct Frame
+        {
+            bool is_array = false;
+            std::string key;   // Current key, for objects
+            size_t index = 0;  // Current element, for arrays
+            Column column = Column::NONE;
+        };
+
+        // Structure
+        void begin_container(bool is_array);
+        void end_container(bool is_array);
+        void comma();
+        void colon();
+        void after_value();
+        void expect_value() const;
+        Column column_for_array() const;
+        bool in_error_object() const;
+
+        // Tokens
+        size_t scan_string(const char *p, const char *end);
+        size_t scan_number(const char *p, const char *end);
+        size_t scan_literal(const char *p, const char *end);
+        void on_string(std::string_view value);
+        void on_number(std::string_view text);
+        void on_literal(std::string_view text);
+        void push_value(double value, bool is_null, std::string_view text);
+        void append_code_point(uint32_t code_point);
+        [[noreturn]] void fail(const std::string &message) const;
+
+        ColumnarSeries series_;
+        std::vector<Frame> stack_;
+        Expect expect_ = Expect::VALUE;
+        size_t bytes_consumed_ = 0;
+
+        // Partial token carried across chunks
+        Token token_ = Token::NONE;
+        std::string token_text_;
+        bool escape_ = false;
+        int unicode_digits_ = -1; // Hex digits still to read in a \u escape, -1 if none
+        uint32_t unicode_value_ = 0;
+        uint32_t high_surrogate_ = 0;
+
+        // chart.error
+        bool has_error_ = false;
+        std::string error_description_;
+    };
+
+} // namespace trading
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "data/columnar_series.h"
+#include "data/columnar_file.h"
+#include "core/thread_pool.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <future>
+#include <cstdint>
+#include <cstddef>
+
+namespace trading
+{
+
+    class CacheManager;
+
+    /**
+     * @brief ChunkedSeriesReader settings
+     */
+    struct StreamingConfig
+    {
+        size_t chunk_bars = 64 * 1024; // New bars per chunk
+        size_t lookback = 0;           // Bars of the previous chunk repeated at the front of each chunk
+        bool verify_checksum = false;  // Hash each segment when it is opened (reads it in full once)
+    };
+
+    /**
+     * @brief One chunk of a streamed series
+     *
+     * bars holds `lookback` bars carried over from the previous chunk
+     * (fewer at the start of the stream) followed by the chunk's new bars,
+     * so windowed indicator kernels can run over bars and be exact from
+     * the first new bar on. The view points into the reader's buffers and
+     * is valid until the next call to next().
+     */
+    struct StreamChunk
+    {
+        ColumnarSeriesView bars;
+        size_t lookback = 0;  // Leading bars already delivered in earlier chunks
+        size_t first_bar = 0; // Stream position of bars[lookback]
+
+        size_t size() const { return bars.size() - lookback; }
+
+        /**
+         * @brief The chunk's new bars only
+         */
+        ColumnarSeriesView fresh() const { return bars.slice(lookback, size()); }
+    };
+
+    /**
+     * @brief Reads an out-of-core series in fixed-size chunks with bounded memory
+     *
+     * The series is a sequence of segments in the binary columnar format
+     * (files, or persisted cache entries), read in order as one stream.
+     * Segments are memory-mapped one at a time, when the stream reaches
+     * them. Each chunk is copied out of the mapping into one of two
+     * buffers, and the rows it came from are released from the process
+     * straight away (MappedColumnarFile::release), so resident memory is
+     * two chunk buffers whether the series is a megabyte or a terabyte.
+     *
+     * With a thread pool, the chunk after the one just returned is read on
+     * the pool's background lane while the caller processes the current
+     * one, so page faults and disk reads overlap with the caller's work.
+     * Without one, next() reads each chunk on the calling thread.
+     *
+     * Segments are expected to be consecutive parts of one series; chunks
+     * run across segment boundaries and take the symbol of the first.
+     */
+    class ChunkedSeriesReader
+    {
+    public:
+        /**
+         * @brief Opens segment i of the stream
+         * @return Mapped segment (never nullptr)
+         */
+        using SegmentOpener = std::function<std::shared_ptr<const MappedColumnarFile>(size_t segment)>;
+
+        /**
+         * @brief Stream a list of columnar files
+         * @param paths Segment files, in stream order
+         * @param config Chunking settings
+         * @param thread_pool Pool whose background lane prefetches chunks (nullptr reads on the calling thread)
+         * @throws std::invalid_argument if chunk_bars is 0
+         *
+         * Files are opened lazily; a missing or corrupt file throws
+         * std::runtime_error from the next() that reaches it.
+         */
+        explicit ChunkedSeriesReader(std::vector<std::string> paths, const StreamingConfig &config = StreamingConfig{},
+                                     std::shared_ptr<ThreadPool> thread_pool = nullptr);
+
+        /**
+         * @brief Stream arbitrary segments
+         * @param segments Number of segments
+         * @param opener Called once per segment, in order, when the stream reaches it
+         * @param config Chunking settings
+         * @param thread_pool Pool whose background lane prefetches chunks
+         * @throws std::invalid_argument if chunk_bars is 0 or opener is empty
+         */
+        ChunkedSeriesReader(size_t segments, SegmentOpener opener, const StreamingConfig &config = StreamingConfig{},
+                            std::shared_ptr<ThreadPool> thread_pool = nullptr);
+
+        /**
+         * @brief Stream entries persisted by a cache, without loading them into it
+         * @param cache Cache whose disk entries are read (must outlive the reader)
+         * @param keys Cache keys, in stream order
+         *
+         * An entry that is not on disk in the columnar format throws
+         * std::runtime_error from the next() that reaches it.
+         */
+        static std::unique_ptr<ChunkedSeriesReader> from_cache(const CacheManager &cache, std::vector<std::string> keys,
+                                                               const StreamingConfig &config = StreamingConfig{},
+                                                               std::shared_ptr<ThreadPool> thread_pool = nullptr);
+
+        /**
+         * @brief Destructor (waits for an outstanding prefetch)
+         */
+        ~ChunkedSeriesReader();
+
+        // Prevent copying and moving (the prefetch task points at this object)
+        ChunkedSeriesReader(const ChunkedSeriesReader &) = delete;
+        ChunkedSeriesReader &operator=(const ChunkedSeriesReader &) = delete;
+
+        /**
+         * @brief Advance to the next chunk
+         * @param chunk Receives the chunk (valid until the next call)
+         * @return false once the stream is exhausted
+         * @throws std::runtime_error if a segment cannot be opened
+         */
+        bool next(StreamChunk &chunk);
+
+        /**
+         * @brief Start again from the first bar of the first segment
+         */
+        void rewind();
+
+        /**
+         * @brief Symbol of the stream (empty until the first segment is opened)
+         */
+        const std::string &symbol() const { return symbol_; }
+
+        const StreamingConfig &config() const { return config_; }
+        size_t segments() const { return segments_; }
+
+        /**
+         * @brief New bars delivered so far
+         */
+        size_t bars_read() const { return bars_read_; }
+
+        /**
+         * @brief Bytes held by the chunk buffers
+         */
+        size_t buffer_bytes() const;
+
+    private:
+        // Columns of one chunk, allocated once at lookback + chunk_bars rows
+        struct Buffer
+        {
+            std::vector<int64_t> timestamps;
+            std::vector<double> open;
+            std::vector<double> high;
+            std::vector<double> low;
+            std::vector<double> close;
+            std::vector<double> volume;
+            size_t size = 0;
+            size_t lookback = 0;
+            size_t first_bar = 0;
+        };
+
+        void load(Buffer &buffer, const Buffer *previous);
+        bool open_next_segment();
+        void wait_for_prefetch();
+
+        StreamingConfig config_;
+        std::shared_ptr<ThreadPool> thread_pool_;
+        size_t segments_;
+        SegmentOpener opener_;
+        std::string symbol_;
+
+        // Read position; only load() touches these, and loads never overlap
+        std::shared_ptr<const MappedColumnarFile> segment_;
+        size_t next_segment_ = 0;
+        size_t cursor_ = 0;    // Next row of segment_
+        size_t next_bar_ = 0;  // Stream position of the next new bar
+        bool exhausted_ = false;
+
+        Buffer buffers_[2];
+        size_t front_ = 0; // Buffer handed out by the last next()
+        bool started_ = false;
+        size_t bars_read_ = 0;
+        std::future<void> prefetch_; // Filling buffers_[front_ ^ 1]
+    };
+
+} // namespace trading
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "data/market_data.h"
+#include "data/columnar_series.h"
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+namespace trading
+{
+
+    /**
+     * @brief Current on-disk columnar file format version
+     *
+     * Layout (all integers little-endian):
+     *   [0, 64)    file header: magic, version, row count, file size,
+     *              symbol length, data checksum, header checksum
+     *   [64, 192)  column directory: field id, value type and byte offset
+     *              for each of the six columns
+     *   symbol     UTF-8 bytes, padded to 64
+     *   columns    timestamps (int64 ns since epoch), open, high, low,
+     *              close, volume (float64), each starting on a 64-byte
+     *              boundary
+     *
+     * The data checksum is xxHash64 over everything after the header.
+     */
+    constexpr uint32_t kColumnarFileVersion = 1;
+
+    /**
+     * @brief 64-bit xxHash of a byte range
+     * @param data Bytes to hash
+     * @param length Number of bytes
+     * @param seed Hash seed
+     * @return xxHash64 digest
+     */
+    uint64_t xxhash64(const void *data, size_t length, uint64_t seed = 0);
+
+    /**
+     * @brief Write a series in the binary columnar format
+     * @param path Destination file
+     * @param series Data to write
+     * @throws std::runtime_error if the file cannot be written
+     *
+     * Writes to a temporary file and renames it over path, so readers never
+     * observe a partially written file.
+     */
+    void write_columnar_file(const std::string &path, const ColumnarSeriesView &series);
+
+    /**
+     * @brief Read-only memory mapping of a binary columnar file
+     *
+     * Opening validates the header and column directory (and optionally the
+     * data checksum) and then exposes the columns in place as a
+     * ColumnarSeriesView; nothing is parsed or copied. The view stays valid
+     * for as long as the MappedColumnarFile is alive, so hand out the
+     * shared_ptr alongside any view taken from it.
+     *
+     * Uses mmap on POSIX systems. Elsewhere the file is read into a 64-byte
+     * aligned buffer, which keeps the same interface at the cost of one copy.
+     */
+    class MappedColumnarFile
+    {
+    public:
+        /**
+         * @brief Open and validate a columnar file
+         * @param path File to open
+         * @param verify_checksum Hash the column data and compare with the header
+         * @return Mapped file
+         * @throws std::runtime_error if the file is missing, truncated,
+         *         corrupt or of an unsupported version
+         */
+        static std::shared_ptr<MappedColumnarFile> open(const std::string &path, bool verify_checksum = true);
+
+        /**
+         * @brief Check whether a file starts with the columnar file magic
+         * @param path File to check
+         * @return true if the file looks like a columnar file
+         */
+        static bool is_columnar_file(const std::string &path);
+
+        ~MappedColumnarFile();
+
+        // Prevent copying and moving (views point into this object)
+        MappedColumnarFile(const MappedColumnarFile &) = delete;
+        MappedColumnarFile &operator=(const MappedColumnarFile &) = delete;
+
+        // Getters
+        const ColumnarSeriesView &view() const { return view_; }
+        const std::string &symbol() const { return symbol_; }
+        size_t size() const { return view_.size(); }
+        size_t file_size() const { return length_; }
+
+        /**
+         * @brief Copy the mapped columns into an AoS series
+         */
+        MarketDataSeries to_series() const { return view_.to_series(); }
+
+        /**
+         * @brief Start reading rows [offset, offset + count) ahead of use
+         *
+         * Asks the kernel to read the pages of those rows in every column
+         * (madvise MADV_WILLNEED). A no-op without mmap.
+         */
+        void prefetch(size_t offset, size_t count) const;
+
+        /**
+         * @brief Drop rows [offset, offset + count) from the process's resident memory
+         *
+         * The mapping is read-only, so its pages can always be discarded
+         * (madvise MADV_DONTNEED): they stay in the OS page cache, and the
+         * view stays valid, faulting them back in if the rows are read
+         * again. Whole pages are dropped, so a few rows either side of the
+         * range may have to be faulted back in too. A no-op without mmap.
+         */
+        void release(size_t offset, size_t count) const;
+
+    private:
+        MappedColumnarFile() = default;
+
+        void map(const std::string &path);
+        void validate(const std::string &path, bool verify_checksum);
+        void advise(size_t offset, size_t count, bool will_need) const;
+
+        const std::byte *data_ = nullptr;
+        size_t length_ = 0;
+        bool mapped_ = false; // true for mmap, false for the aligned-buffer fallback
+        std::string symbol_;
+        ColumnarSeriesView view_;
+    };
+
+} // namespace trading
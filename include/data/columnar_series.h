@@ -0,0 +1,169 @@
+#pragma once
+
+#include "data/market_data.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+namespace trading
+{
+
+    /**
+     * @brief Convert a timestamp to nanoseconds since the Unix epoch
+     *
+     * Columnar storage keeps timestamps as plain integers with a fixed unit so
+     * that the layout does not depend on the platform's system_clock period.
+     */
+    inline int64_t to_epoch_nanos(std::chrono::system_clock::time_point timestamp)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Convert nanoseconds since the Unix epoch back to a timestamp
+     */
+    inline std::chrono::system_clock::time_point from_epoch_nanos(int64_t nanos)
+    {
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanos)));
+    }
+
+    /**
+     * @brief Non-owning, read-only view over columnar market data
+     *
+     * Each field is a contiguous span of equal length. Views are cheap to
+     * copy and slice, and can point at any storage that lays columns out
+     * contiguously (a ColumnarSeries, a memory-mapped file, ...). The
+     * underlying storage must outlive the view.
+     */
+    struct ColumnarSeriesView
+    {
+        std::string_view symbol;
+        std::span<const int64_t> timestamps; // Nanoseconds since the Unix epoch
+        std::span<const double> open;
+        std::span<const double> high;
+        std::span<const double> low;
+        std::span<const double> close;
+        std::span<const double> volume;
+
+        size_t size() const { return close.size(); }
+        bool empty() const { return close.empty(); }
+
+        /**
+         * @brief Get one bar as an AoS point
+         */
+        MarketDataPoint point(size_t index) const
+        {
+            return MarketDataPoint(from_epoch_nanos(timestamps[index]), open[index], high[index],
+                                   low[index], close[index], static_cast<int64_t>(volume[index]));
+        }
+
+        /**
+         * @brief View of bars [offset, offset + count)
+         */
+        ColumnarSeriesView slice(size_t offset, size_t count) const
+        {
+            return ColumnarSeriesView{symbol,
+                                      timestamps.subspan(offset, count),
+                                      open.subspan(offset, count),
+                                      high.subspan(offset, count),
+                                      low.subspan(offset, count),
+                                      close.subspan(offset, count),
+                                      volume.subspan(offset, count)};
+        }
+
+        /**
+         * @brief Copy the viewed bars into an AoS series
+         */
+        MarketDataSeries to_series() const;
+    };
+
+    /**
+     * @brief Structure-of-arrays market data series
+     *
+     * Stores timestamps and each OHLCV field in its own contiguous vector,
+     * so indicator kernels can read a price column directly (and the compiler
+     * can vectorize over it) instead of gathering it out of MarketDataPoint
+     * structs first.
+     *
+     * Volume is stored as double so volume indicators can consume the column
+     * as-is; integral volumes up to 2^53 round-trip exactly.
+     *
+     * Converts to and from MarketDataSeries in a single pass.
+     */
+    class ColumnarSeries
+    {
+    public:
+        ColumnarSeries() = default;
+        explicit ColumnarSeries(const std::string &symbol) : symbol_(symbol) {}
+
+        /**
+         * @brief Build from an AoS series
+         * @param series Source series
+         * @return Columnar copy of the series
+         */
+        static ColumnarSeries from_series(const MarketDataSeries &series);
+
+        /**
+         * @brief Copy into an AoS series
+         */
+        MarketDataSeries to_series() const { return view().to_series(); }
+
+        // Getters
+        const std::string &symbol() const { return symbol_; }
+        size_t size() const { return close_.size(); }
+        bool empty() const { return close_.empty(); }
+
+        // Column access
+        std::span<const int64_t> timestamps() const { return timestamps_; }
+        std::span<const double> open() const { return open_; }
+        std::span<const double> high() const { return high_; }
+        std::span<const double> low() const { return low_; }
+        std::span<const double> close() const { return close_; }
+        std::span<const double> volume() const { return volume_; }
+
+        /**
+         * @brief Get one bar as an AoS point
+         */
+        MarketDataPoint point(size_t index) const { return view().point(index); }
+
+        /**
+         * @brief Read-only view over all columns
+         */
+        ColumnarSeriesView view() const
+        {
+            return ColumnarSeriesView{symbol_, timestamps_, open_, high_, low_, close_, volume_};
+        }
+
+        operator ColumnarSeriesView() const { return view(); }
+
+        // Data modification
+        void add_point(const MarketDataPoint &point);
+        void add_point(int64_t timestamp_nanos, double open, double high, double low, double close, double volume);
+        void reserve(size_t capacity);
+        void resize(size_t count);
+        void clear();
+
+        // Mutable column access for bulk writers (all columns must stay the same length)
+        std::vector<int64_t> &mutable_timestamps() { return timestamps_; }
+        std::vector<double> &mutable_open() { return open_; }
+        std::vector<double> &mutable_high() { return high_; }
+        std::vector<double> &mutable_low() { return low_; }
+        std::vector<double> &mutable_close() { return close_; }
+        std::vector<double> &mutable_volume() { return volume_; }
+
+    private:
+        std::string symbol_;
+        std::vector<int64_t> timestamps_;
+        std::vector<double> open_;
+        std::vector<double> high_;
+        std::vector<double> low_;
+        std::vector<double> close_;
+        std::vector<double> volume_;
+    };
+
+} // namespace trading
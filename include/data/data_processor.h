@@ -1,12 +1,20 @@
 #pragma once
 
 #include "data/market_data.h"
+#include "data/columnar_series.h"
 #include <vector>
 #include <string>
+#include <span>
+#include <memory>
+#include <memory_resource>
+#include <cstdint>
 
 namespace trading
 {
 
+    class IndicatorCache;
+    class ThreadPool;
+
     /**
      * @brief Technical indicators for market analysis
      *
@@ -40,11 +48,60 @@ namespace trading
      * - Outlier detection
      * - Data normalization
      * - Statistical analysis
+     *
+     * Price and volume inputs are taken as std::span<const double>, so
+     * kernels read std::vector data or ColumnarSeries columns in place
+     * without copying them.
+     *
+     * Temporaries that do not outlive a call (columns gathered from a
+     * MarketDataSeries) are allocated from an optional scratch resource, such as
+     * a ScratchArena that the caller resets after each step. Results are
+     * ordinary std::vectors and never live in the scratch resource.
      */
     class DataProcessor
     {
     public:
-        DataProcessor() = default;
+        /**
+         * @brief Constructor
+         * @param scratch Resource for per-call temporaries (nullptr = default resource)
+         */
+        explicit DataProcessor(std::pmr::memory_resource *scratch = nullptr) : scratch_(scratch) {}
+
+        /**
+         * @brief Set the resource for per-call temporaries
+         * @param scratch Resource to use, or nullptr for the default resource
+         */
+        void set_scratch_resource(std::pmr::memory_resource *scratch) { scratch_ = scratch; }
+
+        /**
+         * @brief Get the resource used for per-call temporaries
+         */
+        std::pmr::memory_resource *scratch_resource() const
+        {
+            return scratch_ ? scratch_ : std::pmr::get_default_resource();
+        }
+
+        /**
+         * @brief Serve calculate_indicators(const MarketDataSeries &) from a cache
+         * @param cache Cache to use, or nullptr to always compute
+         *
+         * Repeated calls on the same series then copy the cached result,
+         * and calls after new bars were appended only compute the new bars.
+         * Use the IndicatorCache directly to share results without copying.
+         */
+        void set_indicator_cache(std::shared_ptr<IndicatorCache> cache) { indicator_cache_ = std::move(cache); }
+
+        /**
+         * @brief Split outlier statistics of long series across a pool
+         * @param thread_pool Pool to use, or nullptr to run on the calling thread
+         *
+         * Series longer than kCleanChunkPoints are processed in chunks
+         * either way, so results do not depend on whether a pool is set.
+         */
+        void set_thread_pool(std::shared_ptr<ThreadPool> thread_pool) { thread_pool_ = std::move(thread_pool); }
+
+        // Points per chunk of the outlier statistics (a whole number of mask words)
+        static constexpr size_t kCleanChunkPoints = 64 * 1024;
 
         /**
          * @brief Clean and validate market data
@@ -52,10 +109,25 @@ namespace trading
          * @return Cleaned and validated data series
          *
          * Removes outliers, fills missing data, and validates the
-         * integrity of the market data.
+         * integrity of the market data. Outliers are marked in a bitmap
+         * first; one pass then drops them, replaces invalid prices with
+         * the previous kept close, and drops bars that are still invalid
+         * (no earlier close to fill from, high < low, negative volume or
+         * a timestamp before the previous kept bar). The result satisfies
+         * MarketDataSeries::is_valid().
          */
         MarketDataSeries clean_data(const MarketDataSeries &series);
 
+        /**
+         * @brief Clean and validate columnar market data
+         * @param series Raw columnar data
+         * @return Cleaned columnar series
+         *
+         * Same rules as the MarketDataSeries overload, reading the close
+         * column in place.
+         */
+        ColumnarSeries clean_data(const ColumnarSeriesView &series);
+
         /**
          * @brief Calculate technical indicators
          * @param series Market data series
@@ -65,13 +137,24 @@ namespace trading
          */
         TechnicalIndicators calculate_indicators(const MarketDataSeries &series);
 
+        /**
+         * @brief Calculate technical indicators from columnar data
+         * @param series Columnar market data
+         * @return Technical indicators
+         *
+         * Reads the close and volume columns directly; no per-call gather.
+         */
+        TechnicalIndicators calculate_indicators(const ColumnarSeriesView &series);
+
         /**
          * @brief Calculate Simple Moving Average
          * @param prices Price data
          * @param period Period for calculation
-         * @return Moving average values
+         * @return Moving average values (NaN for the first period - 1 points)
+         *
+         * Uses a running window sum, so cost is O(n) regardless of period.
          */
-        std::vector<double> calculate_sma(const std::vector<double> &prices, int period) const;
+        std::vector<double> calculate_sma(std::span<const double> prices, int period) const;
 
         /**
          * @brief Calculate Exponential Moving Average
@@ -79,15 +162,18 @@ namespace trading
          * @param period Period for calculation
          * @return Exponential moving average values
          */
-        std::vector<double> calculate_ema(const std::vector<double> &prices, int period) const;
+        std::vector<double> calculate_ema(std::span<const double> prices, int period) const;
 
         /**
          * @brief Calculate Relative Strength Index
          * @param prices Price data
          * @param period Period for calculation (default 14)
-         * @return RSI values
+         * @return RSI values (NaN for the first period points)
+         *
+         * Uses Wilder smoothing: the first value averages the first period
+         * changes, later averages are carried forward in O(1) per point.
          */
-        std::vector<double> calculate_rsi(const std::vector<double> &prices, int period = 14) const;
+        std::vector<double> calculate_rsi(std::span<const double> prices, int period = 14) const;
 
         /**
          * @brief Calculate MACD
@@ -98,7 +184,7 @@ namespace trading
          * @return MACD line and signal line
          */
         std::pair<std::vector<double>, std::vector<double>> calculate_macd(
-            const std::vector<double> &prices,
+            std::span<const double> prices,
             int fast_period = 12,
             int slow_period = 26,
             int signal_period = 9) const;
@@ -109,9 +195,11 @@ namespace trading
          * @param period Period for calculation (default 20)
          * @param std_dev Standard deviation multiplier (default 2.0)
          * @return Upper and lower bands
+         *
+         * Uses a rolling Welford mean/variance, so cost is O(n) regardless of period.
          */
         std::pair<std::vector<double>, std::vector<double>> calculate_bollinger_bands(
-            const std::vector<double> &prices,
+            std::span<const double> prices,
             int period = 20,
             double std_dev = 2.0) const;
 
@@ -120,8 +208,13 @@ namespace trading
          * @param prices Price data
          * @param threshold Standard deviation threshold (default 3.0)
          * @return Indices of outlier points
+         *
+         * Mean and standard deviation are taken over the finite prices.
+         * Long series are summarised per chunk of kCleanChunkPoints and
+         * the chunk statistics merged (Chan et al.), in parallel when a
+         * thread pool is set.
          */
-        std::vector<size_t> detect_outliers(const std::vector<double> &prices, double threshold = 3.0) const;
+        std::vector<size_t> detect_outliers(std::span<const double> prices, double threshold = 3.0) const;
 
         /**
          * @brief Fill missing data points
@@ -137,14 +230,14 @@ namespace trading
          * @param prices Price data
          * @return Normalized prices (0-1 range)
          */
-        std::vector<double> normalize_prices(const std::vector<double> &prices) const;
+        std::vector<double> normalize_prices(std::span<const double> prices) const;
 
         /**
          * @brief Calculate price returns
          * @param prices Price data
          * @return Price returns (percentage change)
          */
-        std::vector<double> calculate_returns(const std::vector<double> &prices) const;
+        std::vector<double> calculate_returns(std::span<const double> prices) const;
 
         /**
          * @brief Calculate volatility
@@ -152,14 +245,20 @@ namespace trading
          * @param window Rolling window size (default 20)
          * @return Rolling volatility
          */
-        std::vector<double> calculate_volatility(const std::vector<double> &returns, int window = 20) const;
+        std::vector<double> calculate_volatility(std::span<const double> returns, int window = 20) const;
 
     private:
         // Helper methods
-        double calculate_std_dev(const std::vector<double> &values, size_t start, size_t end) const;
-        std::vector<double> calculate_gains_losses(const std::vector<double> &prices) const;
+        TechnicalIndicators calculate_indicators(std::span<const double> close, std::span<const double> volume);
+        std::pmr::vector<uint64_t> outlier_mask(std::span<const double> prices, double threshold) const;
+        double calculate_std_dev(std::span<const double> values, size_t start, size_t end) const;
+        std::vector<double> calculate_gains_losses(std::span<const double> prices) const;
         bool is_valid_price(double price) const;
         bool is_valid_volume(int64_t volume) const;
+
+        std::pmr::memory_resource *scratch_ = nullptr;
+        std::shared_ptr<IndicatorCache> indicator_cache_;
+        std::shared_ptr<ThreadPool> thread_pool_;
     };
 
 } // namespace trading
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "data/market_data.h"
+#include "data/data_processor.h"
+#include "data/rolling_window.h"
+#include <cstddef>
+
+namespace trading
+{
+
+    /**
+     * @brief Latest value of every indicator in TechnicalIndicators
+     *
+     * Fields read as NaN until their warm-up period has passed.
+     */
+    struct IndicatorValues
+    {
+        double sma_20;
+        double sma_50;
+        double ema_12;
+        double ema_26;
+        double rsi;
+        double macd;
+        double macd_signal;
+        double bollinger_upper;
+        double bollinger_lower;
+        double volume_sma;
+    };
+
+    /**
+     * @brief Streaming technical indicators for live bar feeds
+     *
+     * Holds the rolling state behind every indicator that
+     * DataProcessor::calculate_indicators produces and updates all of them
+     * in O(1) per new bar, without revisiting history. It uses the same
+     * rolling kernels as the batch path, so after feeding a series bar by
+     * bar the history is bit-identical to calculate_indicators on the
+     * whole series. The windows are sized at compile time, so the rolling
+     * state itself needs no heap allocation.
+     */
+    class IncrementalIndicators
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param record_history Append every update to history() (disable for
+         *        unbounded live feeds that only need latest())
+         */
+        explicit IncrementalIndicators(bool record_history = true);
+
+        /**
+         * @brief Add one bar
+         * @param close Closing price
+         * @param volume Bar volume
+         * @return Indicator values after this bar
+         */
+        const IndicatorValues &update(double close, double volume);
+
+        /**
+         * @brief Add one bar
+         * @param point Market data point
+         * @return Indicator values after this bar
+         */
+        const IndicatorValues &update(const MarketDataPoint &point)
+        {
+            return update(point.close, static_cast<double>(point.volume));
+        }
+
+        /**
+         * @brief Clear all state and history
+         */
+        void reset();
+
+        // Getters
+        const IndicatorValues &latest() const { return latest_; }
+        const TechnicalIndicators &history() const { return history_; }
+        size_t size() const { return bars_; }
+
+    private:
+        void append_history();
+
+        bool record_history_;
+        size_t bars_ = 0;
+
+        BasicRollingMean<20> sma_20_;
+        BasicRollingMean<50> sma_50_;
+        EmaState ema_12_{12};
+        EmaState ema_26_{26};
+        WilderRsi rsi_{14};
+        EmaState macd_fast_{12};
+        EmaState macd_slow_{26};
+        EmaState macd_signal_{9};
+        BasicRollingMeanVariance<20> bollinger_;
+        BasicRollingMean<20> volume_sma_;
+
+        IndicatorValues latest_;
+        TechnicalIndicators history_;
+    };
+
+} // namespace trading
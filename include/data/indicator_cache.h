@@ -0,0 +1,163 @@
+#pragma once
+
+#include "data/market_data.h"
+#include "data/data_processor.h"
+#include "data/cache_manager.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+
+namespace trading
+{
+
+    /**
+     * @brief Memoized technical indicators over market data series
+     *
+     * Results are keyed by the series' version (MarketDataSeries::version)
+     * plus the indicator and its parameters, so repeated requests for the
+     * same indicator on the same series are served without recomputing.
+     * Every entry also keeps the rolling kernel state after the last bar it
+     * has seen: when the series has grown through add_point() since, only
+     * the new bars are pushed through the kernels and appended to the
+     * cached output. Values are bit-identical to the DataProcessor method
+     * of the same name.
+     *
+     * Results are shared and immutable. An entry whose output is still
+     * held by a caller is copied before it is extended, so a handle never
+     * changes under its holder.
+     *
+     * Memory is charged to a CacheManager's budget when one is given, so
+     * cached series and cached indicators share a single limit. Each cache
+     * first evicts its own least recently used entries to make room, and
+     * only takes memory from the other when it has nothing left to evict.
+     * Without a CacheManager the cache enforces its own limit.
+     *
+     * Thread-safe. The map lock is held only to find and account entries;
+     * computing or extending an entry locks that entry alone.
+     */
+    class IndicatorCache
+    {
+    public:
+        using Column = std::shared_ptr<const std::vector<double>>;
+        using ColumnPair = std::shared_ptr<const std::pair<std::vector<double>, std::vector<double>>>;
+
+        /**
+         * @brief Constructor with its own memory limit
+         * @param max_memory_mb Maximum memory usage in MB
+         */
+        explicit IndicatorCache(size_t max_memory_mb);
+
+        /**
+         * @brief Constructor sharing a series cache's memory budget
+         * @param budget Cache whose budget entries are charged to; kept
+         *        alive by this cache
+         * @throws std::invalid_argument if budget is nullptr
+         */
+        explicit IndicatorCache(std::shared_ptr<CacheManager> budget);
+
+        /**
+         * @brief Destructor, returns all memory to the budget
+         */
+        ~IndicatorCache();
+
+        // Prevent copying and moving; the budget holds a callback to this cache
+        IndicatorCache(const IndicatorCache &) = delete;
+        IndicatorCache &operator=(const IndicatorCache &) = delete;
+
+        /**
+         * @brief Simple Moving Average of the close
+         * @see DataProcessor::calculate_sma
+         */
+        Column sma(const MarketDataSeries &series, int period);
+
+        /**
+         * @brief Exponential Moving Average of the close
+         * @see DataProcessor::calculate_ema
+         */
+        Column ema(const MarketDataSeries &series, int period);
+
+        /**
+         * @brief Relative Strength Index of the close
+         * @see DataProcessor::calculate_rsi
+         */
+        Column rsi(const MarketDataSeries &series, int period = 14);
+
+        /**
+         * @brief MACD line and signal line of the close
+         * @see DataProcessor::calculate_macd
+         */
+        ColumnPair macd(const MarketDataSeries &series, int fast_period = 12, int slow_period = 26,
+                        int signal_period = 9);
+
+        /**
+         * @brief Upper and lower Bollinger Bands of the close
+         * @see DataProcessor::calculate_bollinger_bands
+         */
+        ColumnPair bollinger_bands(const MarketDataSeries &series, int period = 20, double std_dev = 2.0);
+
+        /**
+         * @brief Every indicator in TechnicalIndicators
+         * @see DataProcessor::calculate_indicators
+         */
+        std::shared_ptr<const TechnicalIndicators> calculate_indicators(const MarketDataSeries &series);
+
+        /**
+         * @brief Drop every entry
+         */
+        void clear();
+
+        /**
+         * @brief Get number of cached entries
+         */
+        size_t size() const;
+
+        /**
+         * @brief Get memory charged to the budget
+         * @return Memory usage in bytes
+         */
+        size_t memory_usage() const;
+
+        // Request statistics
+        uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }             // Served as cached
+        uint64_t extensions() const { return extensions_.load(std::memory_order_relaxed); } // Extended by new bars
+        uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }         // Computed from scratch
+
+    private:
+        struct Entry;
+
+        struct Slot
+        {
+            std::shared_ptr<Entry> entry;
+            size_t charged_bytes = 0;
+            uint64_t last_used = 0;
+        };
+
+        template <typename Output>
+        std::shared_ptr<const Output> fetch(const MarketDataSeries &series, const std::string &spec,
+                                            const std::function<std::shared_ptr<Entry>()> &make);
+        void charge(const std::string &key, const std::shared_ptr<Entry> &entry, size_t bytes);
+        bool reserve(size_t bytes, bool allow_evict);
+        void release(size_t bytes);
+        bool evict_one_locked(const std::string &keep);
+        void erase_locked(std::unordered_map<std::string, Slot>::iterator it);
+
+        std::shared_ptr<CacheManager> budget_; // nullptr = own limit
+        size_t reclaimer_ = 0;
+        size_t max_memory_bytes_ = 0;
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, Slot> entries_; // "version/spec" -> entry
+        size_t memory_bytes_ = 0;
+        uint64_t clock_ = 0; // LRU stamp source
+
+        std::atomic<uint64_t> hits_{0};
+        std::atomic<uint64_t> extensions_{0};
+        std::atomic<uint64_t> misses_{0};
+    };
+
+} // namespace trading
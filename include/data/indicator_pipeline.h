@@ -0,0 +1,249 @@
+#pragma once
+
+#include "data/rolling_window.h"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace trading
+{
+
+    /**
+     * @brief Column a pipeline stage reads
+     */
+    enum class PipelineInput
+    {
+        CLOSE,
+        VOLUME
+    };
+
+    /**
+     * @brief Stages for IndicatorPipeline
+     *
+     * Each stage holds one indicator's rolling state and declares how many
+     * output columns it writes. Periods are template arguments, so SMA and
+     * Bollinger windows are std::arrays sized at compile time and live
+     * inline in the pipeline. Every stage runs the same kernel and the
+     * same expression as the DataProcessor method it mirrors, so the
+     * outputs are bit-identical.
+     */
+    namespace stages
+    {
+
+        /**
+         * @brief Simple Moving Average, as DataProcessor::calculate_sma
+         */
+        template <int Period, PipelineInput Input = PipelineInput::CLOSE>
+        struct Sma
+        {
+            static_assert(Period > 0, "Period must be positive");
+            static constexpr size_t outputs = 1;
+            static constexpr PipelineInput input = Input;
+
+            void push(double close, double volume, double *const *out, size_t i)
+            {
+                window.push(Input == PipelineInput::CLOSE ? close : volume);
+                out[0][i] = window.value();
+            }
+
+            BasicRollingMean<static_cast<size_t>(Period)> window;
+        };
+
+        /**
+         * @brief Exponential Moving Average, as DataProcessor::calculate_ema
+         */
+        template <int Period, PipelineInput Input = PipelineInput::CLOSE>
+        struct Ema
+        {
+            static_assert(Period > 0, "Period must be positive");
+            static constexpr size_t outputs = 1;
+            static constexpr PipelineInput input = Input;
+
+            void push(double close, double volume, double *const *out, size_t i)
+            {
+                out[0][i] = state.push(Input == PipelineInput::CLOSE ? close : volume);
+            }
+
+            EmaState state{Period};
+        };
+
+        /**
+         * @brief Relative Strength Index of the close, as DataProcessor::calculate_rsi
+         *
+         * Writes one value per bar; for a single bar that is NaN, where
+         * calculate_rsi returns an empty vector.
+         */
+        template <int Period = 14>
+        struct Rsi
+        {
+            static_assert(Period > 0, "Period must be positive");
+            static constexpr size_t outputs = 1;
+            static constexpr PipelineInput input = PipelineInput::CLOSE;
+
+            void push(double close, double, double *const *out, size_t i)
+            {
+                out[0][i] = state.push(close);
+            }
+
+            WilderRsi state{Period};
+        };
+
+        /**
+         * @brief MACD line and signal line of the close, as DataProcessor::calculate_macd
+         */
+        template <int Fast = 12, int Slow = 26, int Signal = 9>
+        struct Macd
+        {
+            static_assert(Fast > 0 && Slow > 0 && Signal > 0, "Periods must be positive");
+            static constexpr size_t outputs = 2;
+            static constexpr PipelineInput input = PipelineInput::CLOSE;
+
+            void push(double close, double, double *const *out, size_t i)
+            {
+                double fast_value = fast.push(close);
+                double slow_value = slow.push(close);
+                double macd = (std::isnan(fast_value) || std::isnan(slow_value)) ? std::numeric_limits<double>::quiet_NaN()
+                                                                                   : fast_value - slow_value;
+                out[0][i] = macd;
+                out[1][i] = signal.push(macd);
+            }
+
+            EmaState fast{Fast};
+            EmaState slow{Slow};
+            EmaState signal{Signal};
+        };
+
+        /**
+         * @brief Upper and lower Bollinger Bands of the close, as
+         *        DataProcessor::calculate_bollinger_bands
+         */
+        template <int Period = 20, double Multiplier = 2.0>
+        struct Bollinger
+        {
+            static_assert(Period > 0, "Period must be positive");
+            static constexpr size_t outputs = 2;
+            static constexpr PipelineInput input = PipelineInput::CLOSE;
+
+            void push(double close, double, double *const *out, size_t i)
+            {
+                window.push(close);
+                double sma = window.mean();
+                double std_dev = window.std_dev();
+                out[0][i] = sma + (Multiplier * std_dev);
+                out[1][i] = sma - (Multiplier * std_dev);
+            }
+
+            BasicRollingMeanVariance<static_cast<size_t>(Period)> window;
+        };
+
+    } // namespace stages
+
+    /**
+     * @brief Indicators composed at compile time and computed in one fused pass
+     *
+     * IndicatorPipeline<stages::Sma<20>, stages::Rsi<14>> reads each close
+     * (and volume, if a stage needs it) once and advances every stage on
+     * it, instead of one pass and one output allocation per indicator.
+     * Outputs go to caller-provided columns, in stage order, each stage
+     * contributing Stage::outputs columns.
+     *
+     * The pipeline keeps its state between calls to process(), so a long
+     * series can be fed in consecutive chunks (or one bar at a time) with
+     * the same result as a single call. Copy a pipeline to fork its state.
+     */
+    template <typename... Stages>
+    class IndicatorPipeline
+    {
+    public:
+        static constexpr size_t output_count = (Stages::outputs + ... + 0);
+        static constexpr bool reads_volume = ((Stages::input == PipelineInput::VOLUME) || ...);
+
+        using Outputs = std::array<std::span<double>, output_count>;
+
+        /**
+         * @brief Advance every stage over the next bars
+         * @param close Close prices
+         * @param volume Volumes, one per close (may be empty if no stage reads volume)
+         * @param outputs Destination columns, each at least close.size() long
+         * @throws std::invalid_argument if a column is too short
+         */
+        void process(std::span<const double> close, std::span<const double> volume, const Outputs &outputs)
+        {
+            if (reads_volume && volume.size() != close.size())
+            {
+                throw std::invalid_argument("IndicatorPipeline needs one volume per close");
+            }
+
+            std::array<double *, output_count + 1> columns{};
+            for (size_t k = 0; k < output_count; ++k)
+            {
+                if (outputs[k].size() < close.size())
+                {
+                    throw std::invalid_argument("IndicatorPipeline output column is too short");
+                }
+                columns[k] = outputs[k].data();
+            }
+
+            const size_t n = close.size();
+            for (size_t i = 0; i < n; ++i)
+            {
+                step(std::index_sequence_for<Stages...>{}, close[i], reads_volume ? volume[i] : 0.0, columns.data(), i);
+            }
+            bars_ += n;
+        }
+
+        /**
+         * @brief Clear all state
+         */
+        void reset() { *this = IndicatorPipeline(); }
+
+        /**
+         * @brief Bars processed so far
+         */
+        size_t size() const { return bars_; }
+
+        /**
+         * @brief State of stage I, e.g. to read its window
+         */
+        template <size_t I>
+        const auto &stage() const { return std::get<I>(stages_); }
+
+    private:
+        // First output column of each stage
+        static constexpr std::array<size_t, sizeof...(Stages)> offsets()
+        {
+            std::array<size_t, sizeof...(Stages)> result{};
+            size_t next = 0, i = 0;
+            ((result[i++] = next, next += Stages::outputs), ...);
+            return result;
+        }
+
+        template <size_t... I>
+        void step(std::index_sequence<I...>, double close, double volume, double *const *columns, size_t i)
+        {
+            constexpr auto offset = offsets();
+            (std::get<I>(stages_).push(close, volume, columns + offset[I], i), ...);
+        }
+
+        std::tuple<Stages...> stages_;
+        size_t bars_ = 0;
+    };
+
+    /**
+     * @brief The indicator set of DataProcessor::calculate_indicators
+     *
+     * Output columns are in TechnicalIndicators order: sma_20, sma_50,
+     * ema_12, ema_26, rsi, macd, macd_signal, bollinger_upper,
+     * bollinger_lower, volume_sma.
+     */
+    using StandardIndicatorPipeline =
+        IndicatorPipeline<stages::Sma<20>, stages::Sma<50>, stages::Ema<12>, stages::Ema<26>, stages::Rsi<14>,
+                          stages::Macd<12, 26, 9>, stages::Bollinger<20, 2.0>,
+                          stages::Sma<20, PipelineInput::VOLUME>>;
+
+} // namespace trading
@@ -4,6 +4,7 @@
 #include <vector>
 #include <chrono>
 #include <cstdint>
+#include <utility>
 
 namespace trading
 {
@@ -37,12 +38,28 @@ namespace trading
      * This class holds a collection of market data points for a specific
      * symbol over a time period. It provides methods for accessing and
      * manipulating the data efficiently.
+     *
+     * Points can only be appended or cleared, so a series' version (see
+     * version()) tells consumers such as IndicatorCache whether results
+     * they derived from its first n points are still valid.
      */
     class MarketDataSeries
     {
     public:
-        MarketDataSeries() = default;
-        explicit MarketDataSeries(const std::string &symbol) : symbol_(symbol) {}
+        MarketDataSeries() : version_(next_version()) {}
+        explicit MarketDataSeries(const std::string &symbol) : symbol_(symbol), version_(next_version()) {}
+
+        // A copy is a new series; a move hands the version over with the points
+        MarketDataSeries(const MarketDataSeries &other)
+            : symbol_(other.symbol_), data_(other.data_), version_(next_version()) {}
+        MarketDataSeries(MarketDataSeries &&other) noexcept
+            : symbol_(std::move(other.symbol_)), data_(std::move(other.data_)), version_(other.version_)
+        {
+            other.data_.clear();
+            other.version_ = next_version();
+        }
+        MarketDataSeries &operator=(const MarketDataSeries &other);
+        MarketDataSeries &operator=(MarketDataSeries &&other) noexcept;
 
         // Getters
         const std::string &symbol() const { return symbol_; }
@@ -50,6 +67,16 @@ namespace trading
         size_t size() const { return data_.size(); }
         bool empty() const { return data_.empty(); }
 
+        /**
+         * @brief Identity of the points held, up to appends
+         *
+         * Unique within the process. add_point() keeps it, since the points
+         * already held do not change; clear() and assignment replace it. A
+         * consumer that processed the first n points under version v can
+         * resume from point n for as long as version() == v.
+         */
+        uint64_t version() const { return version_; }
+
         // Data access
         const MarketDataPoint &operator[](size_t index) const { return data_[index]; }
         const MarketDataPoint &front() const { return data_.front(); }
@@ -58,7 +85,11 @@ namespace trading
         // Data modification
         void add_point(const MarketDataPoint &point) { data_.push_back(point); }
         void add_point(MarketDataPoint &&point) { data_.emplace_back(std::move(point)); }
-        void clear() { data_.clear(); }
+        void clear()
+        {
+            data_.clear();
+            version_ = next_version();
+        }
         void reserve(size_t capacity) { data_.reserve(capacity); }
 
         // Time range queries
@@ -66,18 +97,23 @@ namespace trading
             std::chrono::system_clock::time_point start,
             std::chrono::system_clock::time_point end) const;
 
-        // Statistical methods
+        // Statistical methods over closing prices (0 for an empty series);
+        // volatility is the per-bar standard deviation of simple returns
         double get_average_price() const;
         double get_volatility() const;
         double get_max_price() const;
         double get_min_price() const;
 
-        // Validation
+        // Validation: positive finite prices, high >= low, non-negative
+        // volume and non-decreasing timestamps
         bool is_valid() const;
 
     private:
+        static uint64_t next_version();
+
         std::string symbol_;                // Stock symbol (e.g., "AAPL")
         std::vector<MarketDataPoint> data_; // Time series data
+        uint64_t version_;                  // See version()
     };
 
     /**
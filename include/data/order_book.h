@@ -0,0 +1,270 @@
+#pragma once
+
+#include "core/memory_pool.h"
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+namespace trading
+{
+
+    /**
+     * @brief Side of the book an order rests on
+     */
+    enum class BookSide
+    {
+        BID,
+        ASK
+    };
+
+    /**
+     * @brief Aggregated price level, as shown in a depth snapshot
+     */
+    struct BookLevel
+    {
+        double price = 0.0;
+        uint64_t quantity = 0;    // Shares resting at this price
+        uint32_t order_count = 0; // Orders resting at this price
+    };
+
+    /**
+     * @brief One execution against a resting order
+     */
+    struct BookTrade
+    {
+        uint64_t resting_id; // Order that was resting in the book
+        double price;        // Price of the resting order
+        uint64_t quantity;   // Shares traded
+    };
+
+    /**
+     * @brief Liquidity available to an incoming order, without touching the book
+     */
+    struct BookQuote
+    {
+        uint64_t quantity = 0;
+        double notional = 0.0;
+
+        double average_price() const { return quantity > 0 ? notional / static_cast<double>(quantity) : 0.0; }
+    };
+
+    /**
+     * @brief Price-level limit order book with a matching engine
+     *
+     * Prices are kept as integer ticks. Each side is a flat array of price
+     * levels indexed by tick, so finding a level is an index computation, and
+     * a bitmap of non-empty levels finds the next best price with a couple
+     * of bit scans when the top level empties. Orders at a level form an
+     * intrusive FIFO list (price-time priority) whose nodes come from a
+     * MemoryPool, and an open-addressing table maps order ids to nodes.
+     *
+     * Complexity:
+     * - add, cancel, reduce, modify: O(1)
+     * - match: O(levels crossed + orders filled)
+     * - the ladder is re-centred (O(levels)) only when a price falls outside it
+     *
+     * add() rests an order without matching, which is what a market-data
+     * book built from an exchange feed needs; submit() is the matching
+     * engine entry point for a limit order, and match() takes liquidity
+     * without resting anything.
+     *
+     * Not thread-safe.
+     */
+    class OrderBook
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param tick_size Minimum price increment
+         * @param initial_levels Price levels per side before the ladder grows
+         * @param initial_orders Order nodes pre-allocated in the pool
+         * @throws std::invalid_argument if tick_size is not positive
+         */
+        explicit OrderBook(double tick_size = 0.01, size_t initial_levels = 4096, size_t initial_orders = 4096);
+
+        ~OrderBook();
+
+        // Prevent copying
+        OrderBook(const OrderBook &) = delete;
+        OrderBook &operator=(const OrderBook &) = delete;
+
+        /**
+         * @brief Rest an order at the back of its price level
+         * @return false if the id is already in the book or quantity is 0
+         */
+        bool add(uint64_t id, BookSide side, double price, uint64_t quantity);
+
+        /**
+         * @brief Remove an order
+         * @return false if the id is not in the book
+         */
+        bool cancel(uint64_t id);
+
+        /**
+         * @brief Take shares off an order (partial cancel or execution)
+         * @return false if the id is not in the book
+         *
+         * The order keeps its queue position; it is removed once nothing is left.
+         */
+        bool reduce(uint64_t id, uint64_t quantity);
+
+        /**
+         * @brief Change an order's price and size
+         * @return false if the id is not in the book
+         *
+         * Shrinking an order at the same price keeps its queue position; any
+         * other change sends it to the back of its (new) level. A quantity
+         * of 0 cancels the order.
+         */
+        bool modify(uint64_t id, double price, uint64_t quantity);
+
+        /**
+         * @brief Replace an order with a new id, price and size (loses priority)
+         * @return false if id is not in the book, new_id already is, or quantity is 0
+         */
+        bool replace(uint64_t id, uint64_t new_id, double price, uint64_t quantity);
+
+        /**
+         * @brief Match a limit order, resting whatever does not fill
+         * @param trades Optional output for the executions, in fill order
+         * @return Shares filled
+         */
+        uint64_t submit(uint64_t id, BookSide side, double price, uint64_t quantity,
+                        std::vector<BookTrade> *trades = nullptr);
+
+        /**
+         * @brief Take liquidity without resting
+         * @param taker Side of the incoming order (BID buys from the asks)
+         * @param quantity Shares wanted
+         * @param limit_price Worst acceptable price, none for a market order
+         * @param trades Optional output for the executions, in fill order
+         * @return Shares filled
+         */
+        uint64_t match(BookSide taker, uint64_t quantity, std::optional<double> limit_price = std::nullopt,
+                       std::vector<BookTrade> *trades = nullptr);
+
+        /**
+         * @brief What match() would fill, without changing the book
+         */
+        BookQuote quote(BookSide taker, uint64_t quantity, std::optional<double> limit_price = std::nullopt) const;
+
+        /**
+         * @brief Best bid, if any
+         */
+        std::optional<double> best_bid() const;
+
+        /**
+         * @brief Best ask, if any
+         */
+        std::optional<double> best_ask() const;
+
+        /**
+         * @brief Shares resting at a price
+         */
+        uint64_t volume_at(BookSide side, double price) const;
+
+        /**
+         * @brief Best levels of one side, best first
+         * @param side Side to read
+         * @param depth Maximum number of levels
+         * @param out Replaced with the levels (its capacity is reused)
+         */
+        void snapshot(BookSide side, size_t depth, std::vector<BookLevel> &out) const;
+
+        /**
+         * @brief Check whether an order is resting
+         */
+        bool contains(uint64_t id) const { return find(id) != nullptr; }
+
+        /**
+         * @brief Number of resting orders
+         */
+        size_t order_count() const { return index_count_; }
+
+        /**
+         * @brief Number of non-empty price levels on one side
+         */
+        size_t level_count(BookSide side) const { return ladder(side).occupied_levels; }
+
+        /**
+         * @brief Minimum price increment
+         */
+        double tick_size() const { return tick_size_; }
+
+        /**
+         * @brief Remove every order
+         */
+        void clear();
+
+    private:
+        struct OrderNode
+        {
+            uint64_t id;
+            uint64_t quantity;
+            int64_t tick;
+            OrderNode *prev;
+            OrderNode *next;
+            BookSide side;
+        };
+
+        struct Level
+        {
+            uint64_t quantity = 0;
+            uint32_t order_count = 0;
+            OrderNode *head = nullptr;
+            OrderNode *tail = nullptr;
+        };
+
+        struct Ladder
+        {
+            std::vector<Level> levels;     // Index = tick - base_tick_
+            std::vector<uint64_t> occupied; // One bit per non-empty level
+            size_t occupied_levels = 0;
+            int64_t best = -1;              // Index of the best level, -1 when empty
+        };
+
+        struct IndexSlot
+        {
+            uint64_t id;
+            OrderNode *node; // nullptr marks a free slot
+        };
+
+        // Price/tick conversion and ladder management
+        int64_t to_tick(double price) const;
+        double to_price(int64_t tick) const { return static_cast<double>(tick) * tick_size_; }
+        Ladder &ladder(BookSide side) { return side == BookSide::BID ? bids_ : asks_; }
+        const Ladder &ladder(BookSide side) const { return side == BookSide::BID ? bids_ : asks_; }
+        size_t level_index(int64_t tick);
+        void regrow(int64_t tick);
+
+        // Level lists
+        void link(OrderNode *node);
+        void unlink(OrderNode *node);
+        void release(OrderNode *node);
+
+        // Bitmap scans
+        static int64_t highest_set(const std::vector<uint64_t> &bits, int64_t from);
+        static int64_t lowest_set(const std::vector<uint64_t> &bits, int64_t from, int64_t limit);
+
+        // Matching walk shared by submit() and match()
+        uint64_t take(BookSide taker, uint64_t quantity, int64_t limit_tick, std::vector<BookTrade> *trades);
+        int64_t limit_tick(BookSide taker, const std::optional<double> &limit_price) const;
+
+        // Order id index
+        OrderNode *find(uint64_t id) const;
+        void index_insert(uint64_t id, OrderNode *node);
+        void index_erase(uint64_t id);
+        size_t index_slot(uint64_t id) const;
+
+        double tick_size_;
+        int64_t base_tick_ = 0; // Tick of level 0 on both sides
+        Ladder bids_;
+        Ladder asks_;
+
+        MemoryPool node_pool_;
+        std::vector<IndexSlot> index_;
+        size_t index_count_ = 0;
+    };
+
+} // namespace trading
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <algorithm>
+#include <stdexcept>
+
+namespace trading
+{
+
+    /**
+     * @brief Thread-safe token bucket rate limiter
+     *
+     * Tokens accrue continuously at rate per second up to burst; each
+     * request spends one. Callers never block here: try_acquire() either
+     * takes a token or fails, and wait_time() says how long until the next
+     * one, so an event loop can fold it into its poll timeout. A rate of
+     * zero disables limiting.
+     */
+    class RateLimiter
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Constructor
+         * @param rate_per_second Sustained request rate (0 for unlimited)
+         * @param burst Maximum tokens held, i.e. requests allowed back to back
+         */
+        RateLimiter(double rate_per_second, double burst)
+        {
+            set_rate(rate_per_second, burst);
+        }
+
+        /**
+         * @brief Change the rate; the bucket starts full
+         * @throws std::invalid_argument if rate is negative or burst is below 1
+         */
+        void set_rate(double rate_per_second, double burst)
+        {
+            if (rate_per_second < 0.0 || burst < 1.0)
+            {
+                throw std::invalid_argument("RateLimiter needs a non-negative rate and a burst of at least 1");
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            rate_ = rate_per_second;
+            burst_ = burst;
+            tokens_ = burst;
+            last_refill_ = Clock::now();
+        }
+
+        /**
+         * @brief Take a token if one is available
+         * @param now Current time
+         * @return true if the request may proceed
+         */
+        bool try_acquire(Clock::time_point now = Clock::now())
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (rate_ == 0.0)
+            {
+                return true;
+            }
+
+            refill(now);
+            if (tokens_ < 1.0)
+            {
+                return false;
+            }
+            tokens_ -= 1.0;
+            return true;
+        }
+
+        /**
+         * @brief Time until try_acquire() would next succeed
+         * @param now Current time
+         * @return Zero if a token is available now
+         */
+        Clock::duration wait_time(Clock::time_point now = Clock::now())
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (rate_ == 0.0)
+            {
+                return Clock::duration::zero();
+            }
+
+            refill(now);
+            if (tokens_ >= 1.0)
+            {
+                return Clock::duration::zero();
+            }
+            auto seconds = std::chrono::duration<double>((1.0 - tokens_) / rate_);
+            return std::chrono::ceil<Clock::duration>(seconds);
+        }
+
+        double rate() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return rate_;
+        }
+
+        double burst() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return burst_;
+        }
+
+    private:
+        void refill(Clock::time_point now)
+        {
+            // Time can appear to run backwards when callers pass stale timestamps
+            if (now > last_refill_)
+            {
+                double elapsed = std::chrono::duration<double>(now - last_refill_).count();
+                tokens_ = std::min(burst_, tokens_ + elapsed * rate_);
+                last_refill_ = now;
+            }
+        }
+
+        mutable std::mutex mutex_;
+        double rate_ = 0.0;
+        double burst_ = 1.0;
+        double tokens_ = 1.0;
+        Clock::time_point last_refill_;
+    };
+
+} // namespace trading
@@ -0,0 +1,395 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <type_traits>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <cstddef>
+
+namespace trading
+{
+
+    /**
+     * @brief Period argument of the rolling windows for a length chosen at run time
+     *
+     * BasicRollingMean<20> keeps its window inline in a std::array and
+     * folds the period into the arithmetic; BasicRollingMean<> (RollingMean)
+     * takes the period as a constructor argument and allocates the window.
+     * Both run the same code, so their results are bit-identical.
+     */
+    inline constexpr size_t kRuntimePeriod = 0;
+
+    /**
+     * @brief Fixed-size rolling mean over the last N values
+     *
+     * Keeps the window in a ring buffer and a compensated (Neumaier) running
+     * sum, so each push is O(1) and the sum does not drift over millions of
+     * updates. Non-finite inputs are held in the window but kept out of the
+     * sum; while any is in the window the mean reads as NaN, matching the
+     * result of summing the window directly.
+     */
+    template <size_t Period = kRuntimePeriod>
+    class BasicRollingMean
+    {
+    public:
+        explicit BasicRollingMean(int period)
+            requires(Period == kRuntimePeriod)
+            : period_(period > 0 ? static_cast<size_t>(period) : throw std::invalid_argument("Period must be positive")),
+              window_(period_)
+        {
+        }
+
+        BasicRollingMean()
+            requires(Period != kRuntimePeriod)
+        {
+        }
+
+        /**
+         * @brief Add a value, evicting the oldest once the window is full
+         */
+        void push(double value)
+        {
+            if (count_ == period())
+            {
+                remove(window_[head_]);
+            }
+            else
+            {
+                ++count_;
+            }
+
+            window_[head_] = value;
+            head_ = head_ + 1 == period() ? 0 : head_ + 1;
+            add(value);
+        }
+
+        /**
+         * @brief True once the window holds period values
+         */
+        bool ready() const { return count_ == period(); }
+
+        /**
+         * @brief Mean of the window, NaN until ready
+         */
+        double value() const
+        {
+            if (!ready() || non_finite_ > 0)
+            {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            return (sum_ + compensation_) / static_cast<double>(period());
+        }
+
+        size_t period() const
+        {
+            if constexpr (Period == kRuntimePeriod)
+            {
+                return period_;
+            }
+            else
+            {
+                return Period;
+            }
+        }
+
+    private:
+        void add(double value)
+        {
+            if (!std::isfinite(value))
+            {
+                ++non_finite_;
+                return;
+            }
+            accumulate(value);
+        }
+
+        void remove(double value)
+        {
+            if (!std::isfinite(value))
+            {
+                --non_finite_;
+                return;
+            }
+            accumulate(-value);
+        }
+
+        void accumulate(double value)
+        {
+            double total = sum_ + value;
+            if (std::abs(sum_) >= std::abs(value))
+            {
+                compensation_ += (sum_ - total) + value;
+            }
+            else
+            {
+                compensation_ += (value - total) + sum_;
+            }
+            sum_ = total;
+        }
+
+        using Window = std::conditional_t<Period == kRuntimePeriod, std::vector<double>, std::array<double, Period>>;
+
+        size_t period_ = Period;
+        Window window_{};
+        size_t head_ = 0;
+        size_t count_ = 0;
+        size_t non_finite_ = 0;
+        double sum_ = 0.0;
+        double compensation_ = 0.0;
+    };
+
+    using RollingMean = BasicRollingMean<>;
+
+    /**
+     * @brief Fixed-size rolling mean and population variance
+     *
+     * Sliding-window Welford update: each push removes the evicted value
+     * from and adds the new value to the running mean and sum of squared
+     * deviations. This avoids the cancellation of the sum/sum-of-squares
+     * formula when the variance is small relative to the price level.
+     * Non-finite inputs behave as in RollingMean.
+     */
+    template <size_t Period = kRuntimePeriod>
+    class BasicRollingMeanVariance
+    {
+    public:
+        explicit BasicRollingMeanVariance(int period)
+            requires(Period == kRuntimePeriod)
+            : period_(period > 0 ? static_cast<size_t>(period) : throw std::invalid_argument("Period must be positive")),
+              window_(period_)
+        {
+        }
+
+        BasicRollingMeanVariance()
+            requires(Period != kRuntimePeriod)
+        {
+        }
+
+        /**
+         * @brief Add a value, evicting the oldest once the window is full
+         */
+        void push(double value)
+        {
+            if (count_ == period())
+            {
+                remove(window_[head_]);
+            }
+            else
+            {
+                ++count_;
+            }
+
+            window_[head_] = value;
+            head_ = head_ + 1 == period() ? 0 : head_ + 1;
+            add(value);
+        }
+
+        bool ready() const { return count_ == period(); }
+
+        /**
+         * @brief Mean of the window, NaN until ready
+         */
+        double mean() const
+        {
+            if (!ready() || non_finite_ > 0)
+            {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            return mean_;
+        }
+
+        /**
+         * @brief Population variance of the window, NaN until ready
+         */
+        double variance() const
+        {
+            if (!ready() || non_finite_ > 0)
+            {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            // Rounding can leave a tiny negative residue for a constant window
+            return m2_ > 0.0 ? m2_ / static_cast<double>(period()) : 0.0;
+        }
+
+        double std_dev() const { return std::sqrt(variance()); }
+
+        size_t period() const
+        {
+            if constexpr (Period == kRuntimePeriod)
+            {
+                return period_;
+            }
+            else
+            {
+                return Period;
+            }
+        }
+
+    private:
+        void add(double value)
+        {
+            if (!std::isfinite(value))
+            {
+                ++non_finite_;
+                return;
+            }
+            ++finite_;
+            double delta = value - mean_;
+            mean_ += delta / static_cast<double>(finite_);
+            m2_ += delta * (value - mean_);
+        }
+
+        void remove(double value)
+        {
+            if (!std::isfinite(value))
+            {
+                --non_finite_;
+                return;
+            }
+            if (--finite_ == 0)
+            {
+                mean_ = 0.0;
+                m2_ = 0.0;
+                return;
+            }
+            double delta = value - mean_;
+            mean_ -= delta / static_cast<double>(finite_);
+            m2_ -= delta * (value - mean_);
+        }
+
+        using Window = std::conditional_t<Period == kRuntimePeriod, std::vector<double>, std::array<double, Period>>;
+
+        size_t period_ = Period;
+        Window window_{};
+        size_t head_ = 0;
+        size_t count_ = 0;
+        size_t finite_ = 0;
+        size_t non_finite_ = 0;
+        double mean_ = 0.0;
+        double m2_ = 0.0;
+    };
+
+    using RollingMeanVariance = BasicRollingMeanVariance<>;
+
+    /**
+     * @brief Exponential moving average state
+     *
+     * Seeded with the first value, then value = x * alpha + value * (1 - alpha)
+     * with alpha = 2 / (period + 1).
+     */
+    class EmaState
+    {
+    public:
+        explicit EmaState(int period)
+            : multiplier_(period > 0 ? 2.0 / (period + 1) : throw std::invalid_argument("Period must be positive"))
+        {
+        }
+
+        /**
+         * @brief Add a value
+         * @return Updated EMA
+         */
+        double push(double value)
+        {
+            if (!initialized_)
+            {
+                value_ = value;
+                initialized_ = true;
+            }
+            else
+            {
+                value_ = (value * multiplier_) + (value_ * (1 - multiplier_));
+            }
+            return value_;
+        }
+
+        bool ready() const { return initialized_; }
+        double value() const { return initialized_ ? value_ : std::numeric_limits<double>::quiet_NaN(); }
+
+    private:
+        double multiplier_;
+        double value_ = 0.0;
+        bool initialized_ = false;
+    };
+
+    /**
+     * @brief Wilder-smoothed Relative Strength Index state
+     *
+     * The first value, after period price changes, uses the simple average
+     * gain and loss. After that each average is smoothed as
+     * avg = (avg * (period - 1) + x) / period.
+     */
+    class WilderRsi
+    {
+    public:
+        explicit WilderRsi(int period)
+            : period_(period > 0 ? period : throw std::invalid_argument("Period must be positive"))
+        {
+        }
+
+        /**
+         * @brief Add a price
+         * @return Updated RSI, NaN until period changes have been seen
+         */
+        double push(double price)
+        {
+            if (!has_previous_)
+            {
+                previous_ = price;
+                has_previous_ = true;
+                return value();
+            }
+
+            double change = price - previous_;
+            previous_ = price;
+            double gain = change > 0 ? change : 0.0;
+            double loss = change < 0 ? -change : 0.0;
+
+            if (changes_ < period_)
+            {
+                // Seed with a simple average over the first period changes
+                avg_gain_ += gain;
+                avg_loss_ += loss;
+                if (++changes_ == period_)
+                {
+                    avg_gain_ /= period_;
+                    avg_loss_ /= period_;
+                }
+            }
+            else
+            {
+                avg_gain_ = (avg_gain_ * (period_ - 1) + gain) / period_;
+                avg_loss_ = (avg_loss_ * (period_ - 1) + loss) / period_;
+            }
+
+            return value();
+        }
+
+        bool ready() const { return changes_ == period_; }
+
+        double value() const
+        {
+            if (!ready())
+            {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            if (avg_loss_ == 0.0)
+            {
+                return 100.0;
+            }
+            double rs = avg_gain_ / avg_loss_;
+            return 100.0 - (100.0 / (1.0 + rs));
+        }
+
+    private:
+        int period_;
+        int changes_ = 0;
+        double previous_ = 0.0;
+        bool has_previous_ = false;
+        double avg_gain_ = 0.0;
+        double avg_loss_ = 0.0;
+    };
+
+} // namespace trading
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstddef>
+
+namespace trading
+{
+    namespace simd
+    {
+
+        /**
+         * @brief Instruction sets the kernels can run on
+         */
+        enum class Isa
+        {
+            SCALAR, // Portable C++ reference implementation
+            AVX2,   // x86-64, 256-bit
+            AVX512, // x86-64, 512-bit (AVX-512F)
+            NEON    // AArch64, 128-bit
+        };
+
+        /**
+         * @brief Best instruction set supported by this CPU
+         */
+        Isa detect_isa();
+
+        /**
+         * @brief Whether this build and CPU can run the given instruction set
+         */
+        bool is_supported(Isa isa);
+
+        /**
+         * @brief Instruction set the kernels currently dispatch to
+         *
+         * Defaults to detect_isa() on first use.
+         */
+        Isa active_isa();
+
+        /**
+         * @brief Force the kernels onto a specific instruction set
+         * @param isa Instruction set to use
+         * @throws std::invalid_argument if the instruction set is not supported
+         *
+         * Intended for tests and benchmarks comparing implementations.
+         */
+        void set_isa(Isa isa);
+
+        /**
+         * @brief Human-readable instruction set name
+         */
+        const char *isa_name(Isa isa);
+
+        /**
+         * @brief Sum of all values
+         *
+         * Every implementation uses the same summation order: element i is
+         * added to accumulator i % 8 and the eight accumulators are combined
+         * in a fixed tree. Results are therefore bit-identical across
+         * instruction sets (but may differ in the last bits from a plain
+         * left-to-right loop).
+         */
+        double sum(std::span<const double> values);
+
+        /**
+         * @brief Sum of (value - mean)^2, in the same order as sum()
+         */
+        double sum_squared_deviations(std::span<const double> values, double mean);
+
+        /**
+         * @brief Minimum and maximum of a range
+         */
+        struct MinMax
+        {
+            double min;
+            double max;
+        };
+
+        /**
+         * @brief Minimum and maximum of all values
+         * @param values Input (must not be empty)
+         * @return Same values std::min_element / std::max_element would select,
+         *         including their handling of NaN and signed zero
+         */
+        MinMax min_max(std::span<const double> values);
+
+        /**
+         * @brief Simple returns (p[i] - p[i-1]) / p[i-1]
+         * @param prices Input prices
+         * @param out Output, same size as prices; out[0] and any return
+         *        after a zero price are 0
+         */
+        void simple_returns(std::span<const double> prices, std::span<double> out);
+
+        /**
+         * @brief Elementwise (value - offset) / scale
+         * @param values Input values
+         * @param offset Value subtracted from each element
+         * @param scale Divisor
+         * @param out Output, same size as values
+         */
+        void normalize(std::span<const double> values, double offset, double scale, std::span<double> out);
+
+        /**
+         * @brief Append indices whose |value - mean| / std_dev exceeds threshold
+         * @param values Input values
+         * @param mean Mean of values
+         * @param std_dev Standard deviation of values
+         * @param threshold Z-score threshold
+         * @param out Receives matching indices in ascending order
+         */
+        void append_outliers(std::span<const double> values, double mean, double std_dev, double threshold,
+                             std::vector<size_t> &out);
+
+    } // namespace simd
+} // namespace trading
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "data/market_data.h"
+#include "data/columnar_series.h"
+#include "core/thread_pool.h"
+#include <string>
+#include <vector>
+#include <span>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+namespace trading
+{
+
+    class CacheManager;
+
+    /**
+     * @brief Price and volume fields stored by a UniversePanel
+     */
+    enum class PanelField
+    {
+        OPEN,
+        HIGH,
+        LOW,
+        CLOSE,
+        VOLUME,
+        COUNT
+    };
+
+    class PanelSymbolView;
+
+    /**
+     * @brief Read-only view over a time range of a panel
+     *
+     * Cheap to copy and slice: a view is a handful of pointers into the
+     * panel's storage, which must outlive it.
+     */
+    class PanelView
+    {
+    public:
+        size_t bars() const { return timestamps_.size(); }
+        size_t symbols() const { return symbols_ ? symbols_->size() : 0; }
+        const std::vector<std::string> &symbol_names() const { return *symbols_; }
+
+        std::span<const int64_t> timestamps() const { return timestamps_; } // Nanoseconds since the Unix epoch
+        std::chrono::system_clock::time_point time(size_t bar) const { return from_epoch_nanos(timestamps_[bar]); }
+
+        /**
+         * @brief Every symbol's value of one field at one bar
+         *
+         * The values are contiguous, which is what makes cross-sectional
+         * scans cheap. Missing bars are NaN.
+         */
+        std::span<const double> row(PanelField field, size_t bar) const
+        {
+            return std::span<const double>(fields_[static_cast<size_t>(field)] + bar * stride_, symbols());
+        }
+
+        double at(PanelField field, size_t bar, size_t symbol) const
+        {
+            return fields_[static_cast<size_t>(field)][bar * stride_ + symbol];
+        }
+
+        /**
+         * @brief Validity bitmap of one bar: bit (symbol % 64) of word (symbol / 64)
+         */
+        std::span<const uint64_t> valid_row(size_t bar) const
+        {
+            return std::span<const uint64_t>(valid_ + bar * words_, words_);
+        }
+
+        bool valid(size_t bar, size_t symbol) const
+        {
+            return (valid_[bar * words_ + symbol / 64] >> (symbol % 64)) & 1;
+        }
+
+        /**
+         * @brief Number of symbols with data at a bar
+         */
+        size_t valid_count(size_t bar) const;
+
+        /**
+         * @brief Bars [offset, offset + count)
+         */
+        PanelView slice(size_t offset, size_t count) const;
+
+        /**
+         * @brief Bars with start <= timestamp < end
+         */
+        PanelView slice(std::chrono::system_clock::time_point start, std::chrono::system_clock::time_point end) const;
+
+        PanelSymbolView symbol(size_t index) const;
+
+        /**
+         * @brief Index of a symbol (linear search)
+         * @return Index, or npos if the panel does not hold the symbol
+         */
+        size_t find(const std::string &symbol) const;
+
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+    private:
+        friend class UniversePanel;
+
+        const std::vector<std::string> *symbols_ = nullptr;
+        std::span<const int64_t> timestamps_;
+        const double *fields_[static_cast<size_t>(PanelField::COUNT)] = {};
+        const uint64_t *valid_ = nullptr;
+        size_t stride_ = 0; // Values per row, padded to whole cache lines
+        size_t words_ = 0;  // Bitmap words per row
+    };
+
+    /**
+     * @brief One symbol's bars inside a panel (strided, non-owning)
+     *
+     * Indexed by the panel's time axis, so bar i of every symbol view of
+     * the same panel refers to the same timestamp. Bars the symbol has no
+     * data for read as NaN and have valid(i) == false.
+     */
+    class PanelSymbolView
+    {
+    public:
+        PanelSymbolView(const PanelView &panel, size_t symbol) : panel_(panel), symbol_(symbol) {}
+
+        const std::string &symbol() const { return panel_.symbol_names()[symbol_]; }
+        size_t size() const { return panel_.bars(); }
+
+        bool valid(size_t bar) const { return panel_.valid(bar, symbol_); }
+        double at(PanelField field, size_t bar) const { return panel_.at(field, bar, symbol_); }
+        double close(size_t bar) const { return at(PanelField::CLOSE, bar); }
+
+        /**
+         * @brief Contiguous copy of one field over the view's bars (NaN where missing)
+         */
+        std::vector<double> column(PanelField field) const;
+
+        /**
+         * @brief Copy only the bars the symbol has data for
+         */
+        ColumnarSeries to_columnar() const;
+        MarketDataSeries to_series() const;
+
+    private:
+        PanelView panel_;
+        size_t symbol_;
+    };
+
+    /**
+     * @brief N symbols x T bars of market data on one shared time axis
+     *
+     * The time axis is the union of every symbol's timestamps. Each field
+     * is one time-major matrix: row t holds that field for every symbol at
+     * timestamp t, rows padded to whole cache lines and starting on a
+     * cache-line boundary. A per-row bitmap records which symbols have a
+     * bar at t; missing bars hold NaN rather than interpolated copies
+     * (compare DataProcessor::fill_missing_data), so no value is
+     * invented and a scan that ignores the bitmap still cannot use a
+     * stale price silently.
+     *
+     * Time slices and per-symbol views are non-owning and O(1) to make.
+     * Building works on groups of 64 symbols (one bitmap word), so groups
+     * can be filled on a thread pool without sharing a word.
+     */
+    class UniversePanel
+    {
+    public:
+        UniversePanel();
+
+        UniversePanel(const UniversePanel &) = delete;
+        UniversePanel &operator=(const UniversePanel &) = delete;
+        UniversePanel(UniversePanel &&) noexcept = default;
+        UniversePanel &operator=(UniversePanel &&) noexcept = default;
+
+        /**
+         * @brief Align a set of series on the union of their timestamps
+         * @param series One series per symbol (nullptr gives a symbol with no bars)
+         * @param thread_pool Pool used to fill symbol groups (nullptr runs on the calling thread)
+         * @throws std::invalid_argument if a series' timestamps decrease
+         *
+         * Where a series has several bars with the same timestamp the last one is kept.
+         */
+        static UniversePanel from_series(const std::vector<std::shared_ptr<const MarketDataSeries>> &series,
+                                         std::shared_ptr<ThreadPool> thread_pool = nullptr);
+        static UniversePanel from_series(const std::vector<MarketDataSeries> &series,
+                                         std::shared_ptr<ThreadPool> thread_pool = nullptr);
+
+        /**
+         * @brief Fetch series from a cache and align them
+         * @param cache Cache to read
+         * @param keys One cache key per symbol
+         * @param thread_pool Pool used for the lookups (disk loads run concurrently) and the fill
+         *
+         * Symbols are named after their series (the key if the series has
+         * no symbol). Keys that are not cached become symbols with no bars.
+         */
+        static UniversePanel load(CacheManager &cache, const std::vector<std::string> &keys,
+                                  std::shared_ptr<ThreadPool> thread_pool = nullptr);
+
+        const PanelView &view() const { return view_; }
+        operator const PanelView &() const { return view_; }
+
+        size_t bars() const { return view_.bars(); }
+        size_t symbols() const { return view_.symbols(); }
+        PanelView slice(size_t offset, size_t count) const { return view_.slice(offset, count); }
+        PanelView slice(std::chrono::system_clock::time_point start, std::chrono::system_clock::time_point end) const
+        {
+            return view_.slice(start, end);
+        }
+        PanelSymbolView symbol(size_t index) const { return view_.symbol(index); }
+        size_t find(const std::string &symbol) const { return view_.find(symbol); }
+
+        /**
+         * @brief Bytes held by the value matrices and bitmap
+         */
+        size_t memory_bytes() const;
+
+    private:
+        static UniversePanel build(std::vector<std::string> names, const std::vector<const MarketDataSeries *> &series,
+                                   ThreadPool *thread_pool);
+
+        // view_ points into these; moving a vector keeps its buffer, and
+        // the names sit behind a pointer, so the view survives moves
+        std::unique_ptr<std::vector<std::string>> symbols_;
+        std::vector<int64_t> timestamps_;
+        std::vector<double> values_; // Every field's matrix, plus slack to align the first row
+        std::vector<uint64_t> valid_;
+        PanelView view_;
+    };
+
+} // namespace trading
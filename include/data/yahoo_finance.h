@@ -3,6 +3,7 @@
 #include "data/market_data.h"
 #include "core/thread_pool.h"
 #include <string>
+#include <vector>
 #include <future>
 #include <memory>
 #include <curl/curl.h>
@@ -18,10 +19,18 @@ namespace trading
      * JSON parsing, and data validation.
      *
      * Key features:
-     * - Asynchronous data fetching using thread pool
-     * - Automatic retry on failures
-     * - Rate limiting to respect API limits
+     * - Concurrent fetching of many symbols over one curl multi handle
+     * - Connection, DNS and TLS session reuse across requests
+     * - Token bucket rate limiting to respect API limits
+     * - Automatic retry with exponential backoff on transient failures
+     * - Responses parsed as they stream in, without buffering the body
+     *   (see chart_parser.h)
      * - Data validation and error handling
+     *
+     * All transfers run on a dedicated I/O thread that owns the curl
+     * handles, so every public method is safe to call from any thread.
+     * Backoff between retries is a timer in that thread's event loop: no
+     * thread ever sleeps waiting for a retry.
      */
     class YahooFinanceClient
     {
@@ -30,15 +39,17 @@ namespace trading
          * @brief Constructor
          * @param thread_pool Thread pool for async operations
          *
-         * Creates a Yahoo Finance client with the specified thread pool
-         * for handling asynchronous data requests.
+         * Creates a Yahoo Finance client and starts its I/O thread. The
+         * thread pool is not used for transfers, so fetches never occupy a
+         * pool thread.
          */
         explicit YahooFinanceClient(std::shared_ptr<ThreadPool> thread_pool);
 
         /**
          * @brief Destructor
          *
-         * Cleans up CURL resources.
+         * Fails any outstanding requests, stops the I/O thread and cleans
+         * up CURL resources.
          */
         ~YahooFinanceClient();
 
@@ -57,10 +68,21 @@ namespace trading
          *
          * Asynchronously fetches historical market data for the specified
          * symbol and time range. Returns a future that will contain the
-         * result when the operation completes.
+         * result when the operation completes, or throw std::runtime_error
+         * once retries are exhausted.
          */
         std::future<MarketDataSeries> fetch_historical_data(const MarketDataRequest &request);
 
+        /**
+         * @brief Fetch historical market data for many requests at once
+         * @param requests Market data requests
+         * @return One future per request, in the same order
+         *
+         * Requests are driven concurrently, up to the connection limit and
+         * subject to the rate limit. A failure only affects its own future.
+         */
+        std::vector<std::future<MarketDataSeries>> fetch_batch(const std::vector<MarketDataRequest> &requests);
+
         /**
          * @brief Fetch historical market data (synchronous)
          * @param request Market data request parameters
@@ -95,35 +117,45 @@ namespace trading
          *
          * Sets the timeout for HTTP requests.
          */
-        void set_timeout(int timeout_seconds) { timeout_seconds_ = timeout_seconds; }
+        void set_timeout(int timeout_seconds);
 
         /**
          * @brief Set retry attempts
          * @param max_retries Maximum number of retry attempts
          *
-         * Sets the maximum number of retry attempts for failed requests.
+         * Sets the maximum number of attempts for a request that fails with
+         * a transient error (network errors, HTTP 429 and 5xx).
          */
-        void set_max_retries(int max_retries) { max_retries_ = max_retries; }
+        void set_max_retries(int max_retries);
 
-    private:
-        // HTTP response callback
-        static size_t write_callback(void *contents, size_t size, size_t nmemb, std::string *userp);
+        /**
+         * @brief Set the request rate limit
+         * @param requests_per_second Sustained request rate (0 for unlimited)
+         * @param burst Requests allowed back to back
+         */
+        void set_rate_limit(double requests_per_second, double burst);
 
-        // Helper methods
-        std::string build_url(const MarketDataRequest &request) const;
-        MarketDataSeries parse_json_response(const std::string &json_data, const std::string &symbol) const;
-        std::chrono::system_clock::time_point parse_timestamp(int64_t timestamp) const;
+        /**
+         * @brief Set the maximum number of concurrent transfers
+         * @param max_connections Transfers in flight at once
+         */
+        void set_max_connections(size_t max_connections);
 
-        // Error handling
-        void handle_curl_error(CURLcode result, const std::string &operation) const;
-        std::string get_error_message(CURLcode result) const;
+        /**
+         * @brief Set the base URL requests are made against
+         * @param base_url URL the symbol is appended to
+         *
+         * Defaults to the Yahoo Finance chart endpoint; useful for mirrors
+         * and proxies.
+         */
+        void set_base_url(const std::string &base_url);
+
+    private:
+        struct IoLoop;
 
         // Member variables
-        std::shared_ptr<ThreadPool> thread_pool_;        // Thread pool for async operations
-        CURL *curl_handle_;                              // CURL handle for HTTP requests
-        int timeout_seconds_{30};                        // Request timeout
-        int max_retries_{3};                             // Maximum retry attempts
-        std::string user_agent_{"TradingSimulator/1.0"}; // User agent string
+        std::shared_ptr<ThreadPool> thread_pool_; // Thread pool for async operations
+        std::unique_ptr<IoLoop> io_;              // I/O thread and the curl handles it owns
     };
 
 } // namespace trading
\ No newline at end of file
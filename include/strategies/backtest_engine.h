@@ -0,0 +1,229 @@
+#pragma once
+
+#include "strategies/strategy.h"
+#include "core/lock_free_queue.h"
+#include "core/memory_pool.h"
+#include "core/arena.h"
+#include "data/market_data.h"
+#include "data/order_book.h"
+#include "data/chunked_reader.h"
+#include <chrono>
+#include <functional>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace trading
+{
+
+    /**
+     * @brief Backtest engine configuration
+     */
+    struct BacktestConfig
+    {
+        double initial_capital = 100000.0;  // Starting cash
+        double commission_per_share = 0.0;  // Commission charged per filled share
+        double slippage_bps = 0.0;          // Slippage applied to market fills (basis points)
+        bool allow_short = false;           // Allow selling more than the current position
+        bool allow_margin = false;          // Allow buying more than the available cash
+        size_t queue_capacity = 1024;       // Capacity of each stage queue
+        size_t max_working_orders = 1024;   // Maximum number of simultaneously working orders
+        size_t order_pool_size = 1024;      // Orders pre-allocated in the order pool
+        bool record_equity_curve = true;    // Keep one equity value per bar
+        size_t scratch_bytes = 64 * 1024;   // Initial size of the per-bar scratch arena
+    };
+
+    /**
+     * @brief Summary of a completed backtest run
+     */
+    struct BacktestResult
+    {
+        std::string symbol;
+        double initial_capital = 0.0;
+        double final_equity = 0.0;
+        double total_return = 0.0; // (final - initial) / initial
+        double max_drawdown = 0.0; // Largest peak-to-trough loss as a fraction
+        int64_t final_position = 0;
+
+        size_t bars_processed = 0;
+        size_t orders_submitted = 0;
+        size_t orders_filled = 0;
+        size_t orders_rejected = 0;
+        size_t orders_cancelled = 0;
+        double total_commission = 0.0;
+
+        double elapsed_seconds = 0.0;
+        double bars_per_second = 0.0;
+        double orders_per_second = 0.0;
+
+        std::vector<double> equity_curve; // Equity after each bar (if recorded)
+    };
+
+    /**
+     * @brief Event-driven backtest engine
+     *
+     * Replays the bars of a MarketDataSeries through a three-stage pipeline:
+     *
+     *   market data --(bar queue)--> strategy --(order queue)--> execution
+     *                                    ^                          |
+     *                                    +-------(fill queue)-------+
+     *
+     * Each hand-off goes through a LockFreeQueue and orders are carved out of
+     * a MemoryPool that is sized up front, so once run() has started the
+     * per-bar path performs no heap allocation.
+     *
+     * Execution model:
+     * - Market orders fill at the open of the bar after submission
+     * - Limit orders fill at the limit (or a better open) once a later bar
+     *   trades through the limit price
+     * - Orders still working when the series ends are cancelled
+     *
+     * With an order book attached (set_order_book()), fills come from the
+     * book instead: at each bar the feed callback brings the book up to
+     * date, then working orders take liquidity from it level by level.
+     * Market orders fill at the volume-weighted price of the levels they
+     * sweep, limit orders only against levels at or better than the
+     * limit, and either can fill partially and keep working. The liquidity
+     * a fill takes is removed from the book.
+     *
+     * Strategies get a ScratchArena through scratch() that is reset after
+     * every callback, so their per-bar temporaries cost a pointer bump and
+     * are all released at once.
+     *
+     * run_streaming() replays a series that does not fit in memory, one
+     * ChunkedSeriesReader chunk at a time, through the same pipeline.
+     *
+     * An engine can be reused for many runs; queues, the order pool and the
+     * scratch arena are kept between runs.
+     */
+    class BacktestEngine : public StrategyContext
+    {
+    public:
+        /**
+         * @brief Brings the order book up to date before a bar's orders execute
+         *
+         * Called with the bar index and bar, typically replaying the L2
+         * messages timestamped up to that bar.
+         */
+        using BookFeed = std::function<void(size_t bar_index, const MarketDataPoint &bar, OrderBook &book)>;
+
+        /**
+         * @brief Called with each streamed chunk before its bars are replayed
+         *
+         * The place to run batch indicator kernels over the chunk's columns
+         * (in place, with the reader's lookback as warm-up), e.g. to fill
+         * buffers a strategy reads by bar index.
+         */
+        using ChunkCallback = std::function<void(const StreamChunk &chunk)>;
+
+        /**
+         * @brief Constructor
+         * @param config Engine configuration
+         */
+        explicit BacktestEngine(const BacktestConfig &config = BacktestConfig{});
+
+        ~BacktestEngine() override;
+
+        // Prevent copying
+        BacktestEngine(const BacktestEngine &) = delete;
+        BacktestEngine &operator=(const BacktestEngine &) = delete;
+
+        /**
+         * @brief Run a strategy over a series
+         * @param series Market data to replay (not copied)
+         * @param strategy Strategy to drive
+         * @return Run summary
+         */
+        BacktestResult run(const MarketDataSeries &series, Strategy &strategy);
+
+        /**
+         * @brief Run a strategy over a series streamed in chunks
+         * @param reader Chunk source, replayed from its current position to the end
+         * @param strategy Strategy to drive
+         * @param on_chunk Optional callback run on every chunk first
+         * @return Run summary, identical to run() over the same bars
+         * @throws std::runtime_error if the reader fails to read a segment
+         *
+         * Only the reader's two chunk buffers hold market data, so memory
+         * does not grow with the length of the series, except for the
+         * equity curve (8 bytes a bar): turn off record_equity_curve to keep
+         * it flat. The strategy's on_start() receives an empty series
+         * carrying the symbol, so strategies that need the whole series up
+         * front (e.g. precomputed columns) cannot stream.
+         */
+        BacktestResult run_streaming(ChunkedSeriesReader &reader, Strategy &strategy, const ChunkCallback &on_chunk = {});
+
+        /**
+         * @brief Get the engine configuration
+         */
+        const BacktestConfig &config() const { return config_; }
+
+        /**
+         * @brief Fill orders against an L2 order book instead of bar prices
+         * @param book Book to trade against (not owned), or nullptr to detach
+         * @param feed Optional callback that updates the book at every bar
+         */
+        void set_order_book(OrderBook *book, BookFeed feed = {});
+
+        // StrategyContext implementation
+        uint64_t submit_order(OrderSide side, int64_t quantity,
+                              OrderType type = OrderType::MARKET,
+                              double limit_price = 0.0) override;
+        void cancel_all_orders() override;
+        int64_t position() const override { return position_; }
+        size_t working_orders() const override { return working_orders_.size(); }
+        double cash() const override { return cash_; }
+        double equity() const override { return cash_ + static_cast<double>(position_) * last_price_; }
+        size_t bar_index() const override { return bar_index_; }
+        std::pmr::memory_resource *scratch() override { return &scratch_; }
+
+    private:
+        // Event flowing from the market data stage to the strategy stage
+        struct BarEvent
+        {
+            size_t index;
+            MarketDataPoint bar;
+        };
+
+        // Run phases shared by run() and run_streaming()
+        void start_run(const MarketDataSeries &series, Strategy &strategy);
+        template <typename BarAt>
+        void replay(size_t first_index, size_t count, BarAt &&bar_at, Strategy &strategy);
+        BacktestResult finish_run(Strategy &strategy);
+
+        // Pipeline stages
+        void reset();
+        void execute_working_orders(const MarketDataPoint &bar);
+        void dispatch_fills(Strategy &strategy);
+        void accept_new_orders();
+        bool try_fill(Order &order, const MarketDataPoint &bar);
+        bool try_fill_from_book(Order &order);
+        bool record_fill(Order &order, int64_t quantity, double price);
+        void release_order(Order *order);
+
+        // Member variables
+        BacktestConfig config_;
+        LockFreeQueue<BarEvent> bar_queue_;   // Market data -> strategy
+        LockFreeQueue<Order *> order_queue_;  // Strategy -> execution
+        LockFreeQueue<Fill> fill_queue_;      // Execution -> strategy
+        MemoryPool order_pool_;               // Storage for Order objects
+        size_t live_orders_{0};               // Orders taken from order_pool_ and not yet released
+        std::vector<Order *> working_orders_; // Orders waiting for a fill
+        ScratchArena scratch_;                // Per-callback strategy temporaries
+        OrderBook *book_{nullptr};            // L2 liquidity, when attached
+        BookFeed book_feed_;
+
+        // Portfolio state
+        double cash_{0.0};
+        int64_t position_{0};
+        double last_price_{0.0};
+        size_t bar_index_{0};
+        uint64_t next_order_id_{1};
+        double peak_equity_{0.0};
+        std::chrono::steady_clock::time_point start_time_;
+
+        // Statistics for the current run
+        BacktestResult result_;
+    };
+
+} // namespace trading
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "strategies/backtest_engine.h"
+#include "strategies/strategy.h"
+#include "data/market_data.h"
+#include "data/data_processor.h"
+#include "core/thread_pool.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <future>
+#include <functional>
+#include <unordered_map>
+#include <cstdint>
+
+namespace trading
+{
+
+    /**
+     * @brief Named strategy parameters for one sweep point
+     */
+    struct ParameterSet
+    {
+        std::vector<std::pair<std::string, double>> values;
+
+        /**
+         * @brief Look up a parameter value
+         * @param name Parameter name
+         * @param default_value Value returned when the parameter is missing
+         */
+        double get(const std::string &name, double default_value = 0.0) const;
+
+        /**
+         * @brief Format as "name=value,name=value"
+         */
+        std::string to_string() const;
+    };
+
+    /**
+     * @brief Memoized indicator columns for one read-only series
+     *
+     * Shared by every sweep job that runs on the same symbol. Each column is
+     * computed at most once, by the first job that asks for it; concurrent
+     * requests for the same column wait on that computation instead of
+     * repeating it.
+     */
+    class IndicatorColumns
+    {
+    public:
+        using Column = std::shared_ptr<const std::vector<double>>;
+
+        explicit IndicatorColumns(std::shared_ptr<const MarketDataSeries> series);
+
+        const MarketDataSeries &series() const { return *series_; }
+
+        /**
+         * @brief Close prices as a contiguous column
+         */
+        Column closes();
+
+        /**
+         * @brief Simple moving average of the close
+         */
+        Column sma(int period);
+
+        /**
+         * @brief Exponential moving average of the close
+         */
+        Column ema(int period);
+
+        /**
+         * @brief Relative Strength Index of the close
+         */
+        Column rsi(int period);
+
+        /**
+         * @brief Get the number of columns computed so far
+         */
+        size_t computed_columns() const;
+
+    private:
+        Column get_or_compute(const std::string &key, const std::function<std::vector<double>()> &compute);
+
+        std::shared_ptr<const MarketDataSeries> series_;
+        DataProcessor processor_;
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, std::shared_future<Column>> columns_;
+    };
+
+    /**
+     * @brief Compact, column-oriented table of sweep results
+     *
+     * Row i describes the backtest of parameter set parameter_index[i] on
+     * symbol symbol_index[i]. Rows are ordered symbol-major.
+     */
+    struct SweepResults
+    {
+        std::vector<std::string> symbols;
+        std::vector<ParameterSet> parameters;
+
+        std::vector<uint32_t> symbol_index;
+        std::vector<uint32_t> parameter_index;
+        std::vector<double> total_return;
+        std::vector<double> max_drawdown;
+        std::vector<double> final_equity;
+        std::vector<uint32_t> orders_filled;
+
+        double elapsed_seconds = 0.0;
+
+        size_t size() const { return total_return.size(); }
+
+        /**
+         * @brief Row with the highest total return for a symbol
+         * @param symbol Index into symbols
+         * @return Row index, or size() if the symbol has no rows
+         */
+        size_t best_for_symbol(size_t symbol) const;
+
+        /**
+         * @brief Parameter set with the highest mean return across all symbols
+         * @return Index into parameters, or parameters.size() if empty
+         */
+        size_t best_parameters() const;
+    };
+
+    /**
+     * @brief Builds a strategy for one (symbol, parameter set) job
+     *
+     * Factories should take indicator inputs from the shared IndicatorColumns
+     * so that parameter sets needing the same column reuse it.
+     */
+    using StrategyFactory = std::function<std::unique_ptr<Strategy>(const ParameterSet &parameters,
+                                                                    IndicatorColumns &columns)>;
+
+    /**
+     * @brief Parallel grid-search runner
+     *
+     * Splits the (symbol x parameter set) job space across ThreadPool
+     * workers. Each worker owns one BacktestEngine and pulls contiguous job
+     * ranges from a shared counter, writing results straight into the
+     * pre-sized SweepResults columns. Only one future per worker is created,
+     * regardless of the number of jobs.
+     */
+    class ParameterSweep
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param thread_pool Pool that runs the jobs
+         * @param config Backtest configuration used for every job
+         */
+        ParameterSweep(std::shared_ptr<ThreadPool> thread_pool, const BacktestConfig &config = BacktestConfig{});
+
+        /**
+         * @brief Run every parameter set on every symbol
+         * @param universe Series to test (shared, never copied)
+         * @param parameters Parameter grid
+         * @param factory Strategy factory
+         * @return Result table
+         */
+        SweepResults run(const std::vector<std::shared_ptr<const MarketDataSeries>> &universe,
+                         const std::vector<ParameterSet> &parameters,
+                         const StrategyFactory &factory);
+
+        /**
+         * @brief Build the Cartesian product of parameter axes
+         * @param axes Parameter names with the values to try
+         * @return One ParameterSet per grid point
+         */
+        static std::vector<ParameterSet> make_grid(
+            const std::vector<std::pair<std::string, std::vector<double>>> &axes);
+
+        /**
+         * @brief Set the number of jobs a worker claims at a time
+         */
+        void set_chunk_size(size_t chunk_size) { chunk_size_ = chunk_size == 0 ? 1 : chunk_size; }
+
+    private:
+        std::shared_ptr<ThreadPool> thread_pool_;
+        BacktestConfig config_;
+        size_t chunk_size_{16};
+    };
+
+} // namespace trading
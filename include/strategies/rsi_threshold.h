@@ -0,0 +1,44 @@
+#pragma once
+
+#include "strategies/strategy.h"
+#include <vector>
+#include <string>
+#include <memory>
+
+namespace trading
+{
+
+    /**
+     * @brief RSI mean-reversion strategy
+     *
+     * Buys a fixed quantity when the RSI drops below the oversold threshold
+     * and exits when it rises above the overbought threshold. The RSI column
+     * is precomputed (one value per bar, NaN during warm-up) so that every
+     * threshold combination tested on a symbol shares a single computation.
+     */
+    class RsiThresholdStrategy : public Strategy
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param rsi RSI column aligned with the series
+         * @param oversold Enter long below this level
+         * @param overbought Exit above this level
+         * @param quantity Shares to hold while long
+         */
+        RsiThresholdStrategy(std::shared_ptr<const std::vector<double>> rsi,
+                             double oversold = 30.0, double overbought = 70.0,
+                             int64_t quantity = 100);
+
+        void on_start(const MarketDataSeries &series, StrategyContext &context) override;
+        void on_bar(const MarketDataPoint &bar, StrategyContext &context) override;
+        std::string name() const override;
+
+    private:
+        std::shared_ptr<const std::vector<double>> rsi_;
+        double oversold_;
+        double overbought_;
+        int64_t quantity_;
+    };
+
+} // namespace trading
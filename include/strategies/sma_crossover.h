@@ -0,0 +1,69 @@
+#pragma once
+
+#include "strategies/strategy.h"
+#include <vector>
+#include <string>
+#include <memory>
+
+namespace trading
+{
+
+    /**
+     * @brief Moving average crossover strategy
+     *
+     * Goes long a fixed quantity when the fast simple moving average crosses
+     * above the slow one and goes flat when it crosses back below. Both
+     * averages are maintained with running sums over ring buffers that are
+     * sized in on_start(), so on_bar() is O(1) and allocation-free.
+     *
+     * Alternatively the averages can be supplied as precomputed columns
+     * aligned with the series (NaN during warm-up), which lets many
+     * strategy instances share one computation.
+     */
+    class SmaCrossoverStrategy : public Strategy
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param fast_period Fast SMA period
+         * @param slow_period Slow SMA period (must be greater than fast_period)
+         * @param quantity Shares to hold while long
+         */
+        SmaCrossoverStrategy(int fast_period, int slow_period, int64_t quantity = 100);
+
+        /**
+         * @brief Constructor using precomputed moving averages
+         * @param fast_sma Fast SMA column, one value per bar
+         * @param slow_sma Slow SMA column, one value per bar
+         * @param quantity Shares to hold while long
+         */
+        SmaCrossoverStrategy(std::shared_ptr<const std::vector<double>> fast_sma,
+                             std::shared_ptr<const std::vector<double>> slow_sma,
+                             int64_t quantity = 100);
+
+        void on_start(const MarketDataSeries &series, StrategyContext &context) override;
+        void on_bar(const MarketDataPoint &bar, StrategyContext &context) override;
+        std::string name() const override;
+
+        int fast_period() const { return fast_period_; }
+        int slow_period() const { return slow_period_; }
+
+    private:
+        void trade(double fast_sma, double slow_sma, StrategyContext &context);
+
+        int fast_period_;
+        int slow_period_;
+        int64_t quantity_;
+
+        // Rolling state
+        std::vector<double> window_; // Last slow_period closes
+        size_t count_{0};
+        double fast_sum_{0.0};
+        double slow_sum_{0.0};
+
+        // Precomputed columns (optional)
+        std::shared_ptr<const std::vector<double>> fast_column_;
+        std::shared_ptr<const std::vector<double>> slow_column_;
+    };
+
+} // namespace trading
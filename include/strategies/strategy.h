@@ -0,0 +1,205 @@
+#pragma once
+
+#include "data/market_data.h"
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <memory_resource>
+
+namespace trading
+{
+
+    /**
+     * @brief Direction of an order or fill
+     */
+    enum class OrderSide
+    {
+        BUY,
+        SELL
+    };
+
+    /**
+     * @brief Supported order types
+     */
+    enum class OrderType
+    {
+        MARKET, // Fill at the next bar's open
+        LIMIT   // Fill when the next bar trades through the limit price
+    };
+
+    /**
+     * @brief Lifecycle state of an order
+     */
+    enum class OrderStatus
+    {
+        WORKING,
+        FILLED,
+        REJECTED,
+        CANCELLED
+    };
+
+    /**
+     * @brief Order submitted by a strategy
+     *
+     * Orders are allocated from the engine's MemoryPool and handed to the
+     * execution stage by pointer, so this struct is kept small and trivially
+     * destructible.
+     */
+    struct Order
+    {
+        uint64_t id;          // Engine-assigned order id
+        OrderSide side;       // Buy or sell
+        OrderType type;       // Market or limit
+        int64_t quantity;     // Number of shares (always positive)
+        double limit_price;   // Limit price (ignored for market orders)
+        size_t submitted_bar; // Index of the bar on which the order was submitted
+        OrderStatus status;   // Current state
+
+        Order() = default;
+
+        Order(uint64_t order_id, OrderSide s, OrderType t, int64_t qty, double limit, size_t bar)
+            : id(order_id), side(s), type(t), quantity(qty), limit_price(limit), submitted_bar(bar), status(OrderStatus::WORKING) {}
+    };
+
+    /**
+     * @brief Execution report for a filled order
+     */
+    struct Fill
+    {
+        uint64_t order_id; // Id of the filled order
+        OrderSide side;    // Buy or sell
+        int64_t quantity;  // Filled shares
+        double price;      // Execution price including slippage
+        double commission; // Commission charged
+        size_t bar_index;  // Index of the bar on which the fill happened
+
+        Fill() = default;
+
+        Fill(uint64_t id, OrderSide s, int64_t qty, double px, double comm, size_t bar)
+            : order_id(id), side(s), quantity(qty), price(px), commission(comm), bar_index(bar) {}
+    };
+
+    /**
+     * @brief Engine services available to a strategy while it runs
+     *
+     * The backtest engine implements this interface and passes it to every
+     * strategy callback. Strategies never touch the order pool or queues
+     * directly.
+     */
+    class StrategyContext
+    {
+    public:
+        virtual ~StrategyContext() = default;
+
+        /**
+         * @brief Submit an order to the execution stage
+         * @param side Buy or sell
+         * @param quantity Number of shares (must be positive)
+         * @param type Market or limit order
+         * @param limit_price Limit price for limit orders
+         * @return Order id, or 0 if the order was rejected at submission
+         */
+        virtual uint64_t submit_order(OrderSide side, int64_t quantity,
+                                      OrderType type = OrderType::MARKET,
+                                      double limit_price = 0.0) = 0;
+
+        /**
+         * @brief Cancel all working orders
+         */
+        virtual void cancel_all_orders() = 0;
+
+        /**
+         * @brief Get the current position in shares (negative when short)
+         */
+        virtual int64_t position() const = 0;
+
+        /**
+         * @brief Get the number of orders still waiting for a fill
+         */
+        virtual size_t working_orders() const = 0;
+
+        /**
+         * @brief Get the available cash
+         */
+        virtual double cash() const = 0;
+
+        /**
+         * @brief Get the marked-to-market portfolio value
+         */
+        virtual double equity() const = 0;
+
+        /**
+         * @brief Get the index of the bar currently being processed
+         */
+        virtual size_t bar_index() const = 0;
+
+        /**
+         * @brief Scratch memory for the current callback
+         *
+         * Use it for std::pmr temporaries (or a DataProcessor's scratch
+         * resource); everything allocated from it is released when the
+         * callback returns, so nothing may be kept across bars.
+         */
+        virtual std::pmr::memory_resource *scratch() { return std::pmr::get_default_resource(); }
+    };
+
+    /**
+     * @brief Base class for trading strategies
+     *
+     * A strategy receives every bar in order through on_bar() and reacts by
+     * submitting orders through the context. Fills are reported through
+     * on_fill() before the bar on which they happened is delivered.
+     *
+     * Implementations should do any allocation in on_start() so that the
+     * per-bar callbacks stay allocation-free.
+     */
+    class Strategy
+    {
+    public:
+        virtual ~Strategy() = default;
+
+        /**
+         * @brief Called once before the first bar
+         * @param series Series that is about to be replayed
+         * @param context Engine services
+         */
+        virtual void on_start(const MarketDataSeries &series, StrategyContext &context)
+        {
+            (void)series;
+            (void)context;
+        }
+
+        /**
+         * @brief Called for every bar
+         * @param bar Current bar
+         * @param context Engine services
+         */
+        virtual void on_bar(const MarketDataPoint &bar, StrategyContext &context) = 0;
+
+        /**
+         * @brief Called when one of the strategy's orders is filled
+         * @param fill Execution report
+         * @param context Engine services
+         */
+        virtual void on_fill(const Fill &fill, StrategyContext &context)
+        {
+            (void)fill;
+            (void)context;
+        }
+
+        /**
+         * @brief Called once after the last bar
+         * @param context Engine services
+         */
+        virtual void on_finish(StrategyContext &context)
+        {
+            (void)context;
+        }
+
+        /**
+         * @brief Get a human readable strategy name
+         */
+        virtual std::string name() const = 0;
+    };
+
+} // namespace trading
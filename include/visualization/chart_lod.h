@@ -0,0 +1,141 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "chart_renderer.h"
+
+namespace trading
+{
+    namespace visualization
+    {
+
+        /*
+         * Level-of-detail reduction of chart data. A chart can only show
+         * about one sample per pixel column, so long series are reduced to
+         * that budget before any SVG or console output is produced:
+         *
+         * - candlesticks are bucketed: each output candle merges a run of
+         *   consecutive bars (first open, highest high, lowest low, last
+         *   close, summed volume), which is exactly the bar a coarser
+         *   interval would have produced;
+         * - lines and indicator overlays use LTTB (largest triangle three
+         *   buckets), which keeps the visual shape, or min/max decimation,
+         *   which keeps every spike.
+         *
+         * Series shorter than the budget are returned unchanged. The
+         * pyramids precompute coarser levels once, so rendering a zoomed
+         * view reads O(max_points * factor) samples instead of the whole
+         * range.
+         */
+
+        /**
+         * @brief Samples worth drawing across a chart's plot area
+         * @param pixels_per_sample Horizontal pixels each sample needs
+         * @return config.max_points if set, otherwise the plot width divided by pixels_per_sample
+         */
+        size_t lod_budget(const ChartConfig &config, int pixels_per_sample = 1);
+
+        /**
+         * @brief Merge consecutive candles into at most max_points buckets
+         */
+        std::vector<CandlestickPoint> bucket_candles(const CandlestickPoint *data, size_t count, size_t max_points);
+        std::vector<CandlestickPoint> bucket_candles(const std::vector<CandlestickPoint> &data, size_t max_points);
+
+        /**
+         * @brief Largest-triangle-three-buckets downsampling
+         *
+         * Keeps the first and last point and, from each bucket, the point
+         * forming the largest triangle with the previously kept point and
+         * the next bucket's average. Points must be ordered by x.
+         */
+        std::vector<ChartPoint> lttb_decimate(const ChartPoint *points, size_t count, size_t max_points);
+        std::vector<ChartPoint> lttb_decimate(const std::vector<ChartPoint> &points, size_t max_points);
+
+        /**
+         * @brief Keep the minimum and maximum of each bucket (in x order)
+         *
+         * Output has at most max_points points, including the first and last.
+         */
+        std::vector<ChartPoint> min_max_decimate(const ChartPoint *points, size_t count, size_t max_points);
+        std::vector<ChartPoint> min_max_decimate(const std::vector<ChartPoint> &points, size_t max_points);
+
+        /**
+         * @brief Reduce a line with the chosen method
+         */
+        std::vector<ChartPoint> decimate(const std::vector<ChartPoint> &points, size_t max_points, Decimation method);
+
+        /**
+         * @brief Multi-resolution candlestick series for zoomable charts
+         *
+         * Level 0 is the raw series; level k merges factor^k bars per
+         * candle and is built from level k-1, so build() is O(n) and the
+         * coarse levels add about 1/(factor-1) of the raw size. Views
+         * start from the coarsest level that still has max_points candles
+         * in range; at that level the first and last candle may include up
+         * to factor^k - 1 bars outside [begin, end).
+         */
+        class CandlestickPyramid
+        {
+        public:
+            /**
+             * @throws std::invalid_argument if factor < 2
+             */
+            explicit CandlestickPyramid(size_t factor = 4);
+
+            void build(const std::vector<CandlestickPoint> &data);
+            void clear() { levels_.clear(); }
+
+            /**
+             * @brief Candles covering raw bars [begin, end), at most max_points of them
+             */
+            std::vector<CandlestickPoint> view(size_t begin, size_t end, size_t max_points) const;
+
+            size_t size() const { return levels_.empty() ? 0 : levels_[0].size(); }
+            size_t level_count() const { return levels_.size(); }
+            const std::vector<CandlestickPoint> &level(size_t k) const { return levels_.at(k); }
+            size_t factor() const { return factor_; }
+
+        private:
+            size_t factor_;
+            std::vector<std::vector<CandlestickPoint>> levels_;
+        };
+
+        /**
+         * @brief Multi-resolution line series for zoomable charts
+         *
+         * Level k keeps the minimum and maximum of every factor^k raw
+         * points (two points per bucket, in x order). Min/max composes, so
+         * each level is built from the one below and no spike is lost at
+         * any level; view() then applies the requested decimation to the
+         * slice it reads.
+         */
+        class LinePyramid
+        {
+        public:
+            /**
+             * @throws std::invalid_argument if factor < 2
+             */
+            explicit LinePyramid(size_t factor = 4);
+
+            void build(const std::vector<ChartPoint> &points);
+            void clear() { levels_.clear(); }
+
+            /**
+             * @brief Points covering raw indices [begin, end), at most max_points of them
+             */
+            std::vector<ChartPoint> view(size_t begin, size_t end, size_t max_points,
+                                         Decimation method = Decimation::LTTB) const;
+
+            size_t size() const { return levels_.empty() ? 0 : levels_[0].size(); }
+            size_t level_count() const { return levels_.size(); }
+            const std::vector<ChartPoint> &level(size_t k) const { return levels_.at(k); }
+            size_t factor() const { return factor_; }
+
+        private:
+            size_t factor_;
+            std::vector<std::vector<ChartPoint>> levels_;
+        };
+
+    } // namespace visualization
+} // namespace trading
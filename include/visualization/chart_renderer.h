@@ -28,6 +28,13 @@ namespace trading
             SCATTER
         };
 
+        // Line downsampling method (see chart_lod.h)
+        enum class Decimation
+        {
+            LTTB,   // Shape-preserving
+            MIN_MAX // Keeps every extreme
+        };
+
         // Chart configuration
         struct ChartConfig
         {
@@ -42,6 +49,11 @@ namespace trading
             std::string background_color = "#1e1e1e";
             std::string grid_color = "#333333";
             std::string text_color = "#ffffff";
+
+            // Level of detail: longer series are reduced before rendering
+            bool level_of_detail = true;
+            size_t max_points = 0; // 0 = derive from the plot width
+            Decimation decimation = Decimation::LTTB;
         };
 
         // Chart data point for rendering
@@ -0,0 +1,301 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <fstream>
+#include <map>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+#include "data_export.h"
+
+namespace trading
+{
+    namespace visualization
+    {
+
+        /**
+         * @brief Logical type of a column in a columnar export
+         *
+         * TIMESTAMP columns hold microseconds since the Unix epoch (UTC).
+         * Missing floating-point values are written as NaN.
+         */
+        enum class ColumnType
+        {
+            INT64,
+            DOUBLE,
+            TIMESTAMP,
+            STRING
+        };
+
+        struct ColumnSpec
+        {
+            std::string name;
+            ColumnType type;
+
+            ColumnSpec(const std::string &n, ColumnType t) : name(n), type(t) {}
+        };
+
+        /**
+         * @brief One batch of rows, stored column by column
+         *
+         * INT64 and TIMESTAMP columns are filled through ints(), DOUBLE
+         * through doubles() and STRING through strings(). clear() keeps the
+         * capacity, so a batch reused for every row group does not allocate
+         * once it has reached its size.
+         */
+        class ColumnBatch
+        {
+        public:
+            explicit ColumnBatch(const std::vector<ColumnSpec> &schema);
+
+            std::vector<int64_t> &ints(size_t column) { return columns_[column].ints; }
+            std::vector<double> &doubles(size_t column) { return columns_[column].doubles; }
+            std::vector<std::string> &strings(size_t column) { return columns_[column].strings; }
+            const std::vector<int64_t> &ints(size_t column) const { return columns_[column].ints; }
+            const std::vector<double> &doubles(size_t column) const { return columns_[column].doubles; }
+            const std::vector<std::string> &strings(size_t column) const { return columns_[column].strings; }
+
+            /**
+             * @brief Rows in the batch
+             * @throws std::invalid_argument if the columns differ in length
+             */
+            size_t rows() const;
+
+            size_t column_count() const { return columns_.size(); }
+            ColumnType type(size_t column) const { return columns_[column].type; }
+            void reserve(size_t rows);
+            void clear();
+
+        private:
+            struct Column
+            {
+                ColumnType type;
+                std::vector<int64_t> ints;
+                std::vector<double> doubles;
+                std::vector<std::string> strings;
+            };
+
+            std::vector<Column> columns_;
+        };
+
+        /**
+         * @brief Options shared by the columnar writers
+         */
+        struct ColumnarOptions
+        {
+            ExportCompression compression = ExportCompression::NONE;
+            std::map<std::string, std::string> metadata; // Stored as file key/value metadata
+        };
+
+        /**
+         * @brief Streaming writer of a columnar file
+         *
+         * Each write() call becomes one row group (Parquet) or record batch
+         * (Feather) and is encoded and written immediately, so memory use is
+         * bounded by the batch size however large the export. The file is
+         * written under a temporary name and renamed into place by close(),
+         * so readers never see a partial file; destroying a writer that was
+         * not closed discards it.
+         */
+        class ColumnarWriter
+        {
+        public:
+            /**
+             * @throws std::runtime_error if the file cannot be created
+             */
+            ColumnarWriter(const std::string &path, std::vector<ColumnSpec> schema, ColumnarOptions options);
+            virtual ~ColumnarWriter();
+
+            ColumnarWriter(const ColumnarWriter &) = delete;
+            ColumnarWriter &operator=(const ColumnarWriter &) = delete;
+
+            /**
+             * @brief Encode and write one batch (empty batches are skipped)
+             * @throws std::invalid_argument if the batch does not match the schema
+             * @throws std::runtime_error on write errors or after close()
+             */
+            void write(const ColumnBatch &batch);
+
+            /**
+             * @brief Write the footer and move the file into place
+             * @throws std::runtime_error on write errors
+             */
+            void close();
+
+            const std::vector<ColumnSpec> &schema() const { return schema_; }
+            uint64_t rows_written() const { return rows_written_; }
+            uint64_t bytes_written() const { return offset_; }
+
+        protected:
+            virtual void write_batch(const ColumnBatch &batch, size_t rows) = 0;
+            virtual void write_footer() = 0;
+
+            void write_bytes(const void *data, size_t size);
+            void write_padding(size_t alignment);
+
+            std::vector<ColumnSpec> schema_;
+            ColumnarOptions options_;
+            uint64_t offset_ = 0;
+
+        private:
+            std::string path_;
+            std::string temp_path_;
+            std::ofstream file_;
+            uint64_t rows_written_ = 0;
+            bool closed_ = false;
+        };
+
+        /**
+         * @brief Apache Parquet writer
+         *
+         * One column chunk per row group holding a single data page (v1),
+         * preceded by a dictionary page for dictionary-encoded columns:
+         * - INT64 and TIMESTAMP: DELTA_BINARY_PACKED (an evenly spaced
+         *   timestamp column costs a few bits per row);
+         * - DOUBLE: PLAIN;
+         * - STRING: RLE_DICTIONARY while the chunk has at most
+         *   kMaxDictionarySize distinct values, PLAIN otherwise.
+         * Columns are REQUIRED and carry min/max statistics (NaN ignored).
+         * With GZIP every page is compressed separately.
+         */
+        class ParquetWriter : public ColumnarWriter
+        {
+        public:
+            static constexpr size_t kMaxDictionarySize = 1 << 16;
+
+            /**
+             * @throws std::runtime_error if the file cannot be created or GZIP
+             *         is requested without zlib
+             */
+            ParquetWriter(const std::string &path, std::vector<ColumnSpec> schema, ColumnarOptions options = {});
+
+        protected:
+            void write_batch(const ColumnBatch &batch, size_t rows) override;
+            void write_footer() override;
+
+        private:
+            struct ChunkInfo
+            {
+                int32_t type = 0;
+                std::vector<int32_t> encodings;
+                int64_t num_values = 0;
+                int64_t total_uncompressed = 0;
+                int64_t total_compressed = 0;
+                int64_t data_page_offset = 0;
+                int64_t dictionary_page_offset = -1;
+                std::string min_value; // PLAIN encoded statistics, empty when unknown
+                std::string max_value;
+            };
+
+            struct RowGroupInfo
+            {
+                std::vector<ChunkInfo> columns;
+                int64_t num_rows = 0;
+                int64_t total_byte_size = 0;
+            };
+
+            ChunkInfo write_chunk(const ColumnBatch &batch, size_t column, size_t rows);
+            void write_page(ChunkInfo &chunk, int page_type, const std::vector<uint8_t> &payload, size_t values, int encoding);
+
+            std::vector<RowGroupInfo> row_groups_;
+            std::vector<uint8_t> compressed_; // Reused page compression buffer
+        };
+
+        /**
+         * @brief Feather (V2, Arrow IPC file) writer
+         *
+         * Each batch becomes one uncompressed record batch with 8-byte
+         * aligned buffers laid out as Arrow expects in memory, so readers
+         * can memory-map the file. Arrow IPC only defines LZ4 and ZSTD
+         * buffer compression, neither of which is available here, so GZIP
+         * is rejected.
+         */
+        class FeatherWriter : public ColumnarWriter
+        {
+        public:
+            /**
+             * @throws std::runtime_error if the file cannot be created
+             * @throws std::invalid_argument if compression is requested
+             */
+            FeatherWriter(const std::string &path, std::vector<ColumnSpec> schema, ColumnarOptions options = {});
+
+        protected:
+            void write_batch(const ColumnBatch &batch, size_t rows) override;
+            void write_footer() override;
+
+        private:
+            struct Block
+            {
+                int64_t offset;
+                int32_t metadata_length;
+                int64_t body_length;
+            };
+
+            // Body buffers as (data, size); each is padded to 8 bytes
+            Block write_message(const std::vector<uint8_t> &metadata,
+                                const std::vector<std::pair<const void *, size_t>> &buffers);
+
+            std::vector<Block> record_batches_;
+        };
+
+        /**
+         * @brief DataExporter front end for the columnar writers
+         *
+         * Exports stream through a ColumnBatch of config.row_group_size rows,
+         * so only one row group is ever held in memory. Market data adds a
+         * dictionary-encoded symbol column and records the symbol in the
+         * file metadata alongside config.metadata.
+         */
+        class ColumnarExporter : public DataExporter
+        {
+        public:
+            bool export_market_data(const MarketDataSeries &series, const ExportConfig &config) override;
+            bool export_indicators(const TechnicalIndicators &indicators, const ExportConfig &config) override;
+            bool export_chart_data(const std::vector<CandlestickPoint> &data,
+                                   const std::vector<IndicatorOverlay> &indicators,
+                                   const ExportConfig &config) override;
+            bool export_performance_data(const std::vector<ChartPoint> &pnl_data,
+                                         const std::vector<ChartPoint> &drawdown_data,
+                                         const ExportConfig &config) override;
+            bool export_portfolio_data(const std::vector<std::pair<std::string, double>> &positions,
+                                       const ExportConfig &config) override;
+            bool validate_config(const ExportConfig &config) override;
+
+        protected:
+            virtual std::unique_ptr<ColumnarWriter> open_writer(const std::string &path, std::vector<ColumnSpec> schema,
+                                                                ColumnarOptions options) = 0;
+
+        private:
+            template <typename Fill>
+            bool stream_rows(const ExportConfig &config, std::vector<ColumnSpec> schema, size_t rows,
+                             std::map<std::string, std::string> metadata, Fill fill);
+        };
+
+        // Parquet exporter
+        class ParquetExporter : public ColumnarExporter
+        {
+        public:
+            std::vector<ExportFormat> supported_formats() const override { return {ExportFormat::PARQUET}; }
+
+        protected:
+            std::unique_ptr<ColumnarWriter> open_writer(const std::string &path, std::vector<ColumnSpec> schema,
+                                                        ColumnarOptions options) override;
+        };
+
+        // Feather exporter
+        class FeatherExporter : public ColumnarExporter
+        {
+        public:
+            std::vector<ExportFormat> supported_formats() const override { return {ExportFormat::FEATHER}; }
+            bool validate_config(const ExportConfig &config) override;
+
+        protected:
+            std::unique_ptr<ColumnarWriter> open_writer(const std::string &path, std::vector<ColumnSpec> schema,
+                                                        ColumnarOptions options) override;
+        };
+
+    } // namespace visualization
+} // namespace trading
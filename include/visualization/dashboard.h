@@ -7,10 +7,20 @@
 #include <functional>
 #include <chrono>
 #include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <utility>
+#include <cstdint>
+#include <cstring>
 
 #include "../data/market_data.h"
 #include "../data/data_processor.h"
+#include "../data/order_book.h"
+#include "../analytics/portfolio_analytics.h"
+#include "../core/metrics.h"
 #include "chart_renderer.h"
+#include "chart_lod.h"
 
 namespace trading
 {
@@ -33,7 +43,8 @@ namespace trading
             NEWS_FEED,
             ALERTS,
             VOLUME_PROFILE,
-            TECHNICAL_INDICATORS
+            TECHNICAL_INDICATORS,
+            SYSTEM_METRICS
         };
 
         // Widget configuration
@@ -54,6 +65,71 @@ namespace trading
         // Real-time data update callback
         using DataUpdateCallback = std::function<void(const std::string &widget_id, const std::string &data)>;
 
+        /**
+         * @brief Latest-value hand-off of a typed snapshot between two threads
+         *
+         * Double-buffered: publish() writes the back buffer and take() swaps
+         * it with the reader's front copy, handing the old front back to be
+         * overwritten. In steady state neither side allocates (the copy
+         * reuses the old front's capacity), and the lock is only held for
+         * one copy or one swap. Snapshots published between two take()
+         * calls replace each other, so the reader only sees the newest.
+         */
+        template <typename T>
+        class SnapshotChannel
+        {
+        public:
+            void publish(const T &value)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                back_ = value;
+                pending_.store(true, std::memory_order_release);
+            }
+
+            void publish(T &&value)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                back_ = std::move(value);
+                pending_.store(true, std::memory_order_release);
+            }
+
+            /**
+             * @brief Swap the newest snapshot into front
+             * @return false (front untouched) if nothing was published since the last take
+             */
+            bool take(T &front)
+            {
+                if (!pending_.load(std::memory_order_acquire))
+                {
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(mutex_);
+                using std::swap;
+                swap(front, back_);
+                pending_.store(false, std::memory_order_relaxed);
+                return true;
+            }
+
+            bool pending() const { return pending_.load(std::memory_order_acquire); }
+
+        private:
+            std::mutex mutex_;
+            T back_{};
+            std::atomic<bool> pending_{false};
+        };
+
+        /*
+         * Widget data flow: data threads hand typed snapshots to a widget
+         * through its update_* methods, which publish into the widget's
+         * SnapshotChannels and call mark_for_update(); they never touch what
+         * render() reads. update() runs on the render thread, takes the
+         * pending snapshots, recomputes derived values and flags the widget
+         * for rendering, and render_dirty() then redraws only flagged
+         * widgets. The string set_data()/get_data() interface is kept for
+         * layouts and scripting and is not synchronised with a running
+         * render thread.
+         */
+
         // Base widget class
         class DashboardWidget
         {
@@ -61,11 +137,19 @@ namespace trading
             std::string id_;
             WidgetConfig config_;
             std::atomic<bool> needs_update_;
+            bool needs_render_; // Render thread only
             DataUpdateCallback update_callback_;
 
+            /**
+             * @brief Claim a pending update (call at the top of update())
+             * @return true if data was published since the last call; the
+             *         widget is then flagged for rendering
+             */
+            bool begin_update();
+
         public:
             DashboardWidget(const std::string &widget_id, const WidgetConfig &cfg)
-                : id_(widget_id), config_(cfg), needs_update_(false) {}
+                : id_(widget_id), config_(cfg), needs_update_(false), needs_render_(true) {}
 
             virtual ~DashboardWidget() = default;
 
@@ -73,19 +157,26 @@ namespace trading
             const std::string &id() const { return id_; }
             const WidgetConfig &config() const { return config_; }
             bool needs_update() const { return needs_update_; }
+            bool needs_render() const { return needs_render_; }
 
             // Setters
             void set_update_callback(DataUpdateCallback callback) { update_callback_ = callback; }
-            void set_visible(bool visible) { config_.visible = visible; }
+            void set_visible(bool visible)
+            {
+                config_.visible = visible;
+                needs_render_ = true;
+            }
             void set_position(int x, int y)
             {
                 config_.x = x;
                 config_.y = y;
+                needs_render_ = true;
             }
             void set_size(int width, int height)
             {
                 config_.width = width;
                 config_.height = height;
+                needs_render_ = true;
             }
 
             // Virtual methods
@@ -94,14 +185,28 @@ namespace trading
             virtual std::string get_data() const = 0;
             virtual void set_data(const std::string &data) = 0;
 
-            // Mark for update
+            // Mark for update (any thread)
             void mark_for_update();
             void clear_update_flag();
+
+            // Mark for render (render thread)
+            void mark_for_render() { needs_render_ = true; }
+            void clear_render_flag() { needs_render_ = false; }
         };
 
         // Price ticker widget
         class PriceTickerWidget : public DashboardWidget
         {
+        public:
+            struct Quote
+            {
+                double price = 0.0;
+                double change = 0.0;
+                double change_percent = 0.0;
+                uint64_t volume = 0;
+                std::chrono::system_clock::time_point timestamp;
+            };
+
         private:
             std::string symbol_;
             double current_price_;
@@ -109,6 +214,8 @@ namespace trading
             double price_change_percent_;
             uint64_t volume_;
             std::chrono::system_clock::time_point last_update_;
+            SnapshotChannel<Quote> quote_in_;
+            Quote quote_; // Front buffer of quote_in_
 
         public:
             PriceTickerWidget(const std::string &widget_id, const WidgetConfig &cfg, const std::string &symbol)
@@ -122,7 +229,9 @@ namespace trading
 
             // Specific methods
             void update_price(double price, double change, double change_percent, uint64_t volume);
+            void update_quote(const Quote &quote);
             const std::string &symbol() const { return symbol_; }
+            double price() const { return current_price_; }
 
         private:
             // Utility functions
@@ -139,6 +248,13 @@ namespace trading
             std::vector<IndicatorOverlay> indicators_;
             std::vector<ChartSeries> current_series_;
             ChartConfig chart_config_;
+            SnapshotChannel<std::vector<CandlestickPoint>> candles_in_;
+            SnapshotChannel<std::vector<IndicatorOverlay>> indicators_in_;
+
+            // Zoom: views are cut from the pyramid instead of the raw bars
+            CandlestickPyramid pyramid_;
+            size_t view_begin_ = 0;
+            size_t view_end_ = SIZE_MAX;
 
         public:
             ChartWidget(const std::string &widget_id, const WidgetConfig &cfg,
@@ -154,12 +270,21 @@ namespace trading
             void update_indicators(const std::vector<IndicatorOverlay> &indicators);
             void set_chart_config(const ChartConfig &config);
             bool export_chart(const std::string &filename);
+
+            /**
+             * @brief Zoom to bars [begin, end) (render thread)
+             *
+             * Re-renders from the precomputed pyramid, so changing the zoom
+             * level reads at most a few samples per pixel.
+             */
+            void set_view_range(size_t begin, size_t end);
+            void reset_view() { set_view_range(0, SIZE_MAX); }
         };
 
         // Order book widget
         class OrderBookWidget : public DashboardWidget
         {
-        private:
+        public:
             struct OrderBookLevel
             {
                 double price;
@@ -171,8 +296,15 @@ namespace trading
                     : price(p), quantity(q), order_count(count), is_bid(bid) {}
             };
 
-            std::vector<OrderBookLevel> bids_;
-            std::vector<OrderBookLevel> asks_;
+            struct Depth
+            {
+                std::vector<OrderBookLevel> bids;
+                std::vector<OrderBookLevel> asks;
+            };
+
+        private:
+            Depth depth_; // Front buffer of depth_in_
+            SnapshotChannel<Depth> depth_in_;
             double spread_;
             uint64_t total_bid_volume_;
             uint64_t total_ask_volume_;
@@ -189,6 +321,13 @@ namespace trading
             // Specific methods
             void update_order_book(const std::vector<OrderBookLevel> &bids,
                                    const std::vector<OrderBookLevel> &asks);
+
+            /**
+             * @brief Take a depth snapshot of a live order book
+             * @param book Book to read
+             * @param depth Levels per side to show
+             */
+            void update_from_book(const OrderBook &book, size_t depth = 10);
             double spread() const { return spread_; }
             uint64_t total_bid_volume() const { return total_bid_volume_; }
             uint64_t total_ask_volume() const { return total_ask_volume_; }
@@ -196,6 +335,10 @@ namespace trading
         private:
             // Utility functions
             std::string format_volume(uint64_t volume);
+
+            // Publisher-side scratch, reused by update_from_book()
+            std::vector<BookLevel> snapshot_;
+            Depth staged_;
         };
 
         // Position summary widget
@@ -221,6 +364,8 @@ namespace trading
             double total_unrealized_pnl_;
             double total_realized_pnl_;
             double total_portfolio_value_;
+            SnapshotChannel<std::vector<Position>> positions_in_;
+            SnapshotChannel<double> portfolio_value_in_;
 
         public:
             PositionSummaryWidget(const std::string &widget_id, const WidgetConfig &cfg)
@@ -248,6 +393,9 @@ namespace trading
             ChartConfig chart_config_;
             double max_drawdown_;
             double total_return_;
+            SnapshotChannel<std::vector<ChartPoint>> pnl_in_;
+            SnapshotChannel<std::vector<ChartPoint>> drawdown_in_;
+            SnapshotChannel<std::pair<double, double>> metrics_in_; // (max drawdown, total return)
 
         public:
             PnLChartWidget(const std::string &widget_id, const WidgetConfig &cfg,
@@ -261,6 +409,7 @@ namespace trading
             // Specific methods
             void update_pnl_data(const std::vector<ChartPoint> &pnl, const std::vector<ChartPoint> &drawdown);
             void update_metrics(double max_dd, double total_ret);
+            void update_metrics(const analytics::CurveMetrics &metrics);
             double max_drawdown() const { return max_drawdown_; }
             double total_return() const { return total_return_; }
         };
@@ -268,7 +417,7 @@ namespace trading
         // Performance metrics widget
         class PerformanceMetricsWidget : public DashboardWidget
         {
-        private:
+        public:
             struct Metrics
             {
                 double sharpe_ratio;
@@ -285,7 +434,9 @@ namespace trading
                 double profit_factor;
             };
 
+        private:
             Metrics metrics_;
+            SnapshotChannel<Metrics> metrics_in_;
 
         public:
             PerformanceMetricsWidget(const std::string &widget_id, const WidgetConfig &cfg)
@@ -302,9 +453,45 @@ namespace trading
 
             // Specific methods
             void update_metrics(const Metrics &metrics);
+
+            /**
+             * @brief Show the metrics PortfolioAnalytics computed for one curve
+             */
+            void update_metrics(const analytics::CurveMetrics &metrics);
             const Metrics &get_metrics() const { return metrics_; }
         };
 
+        /**
+         * @brief Latency histograms, counters and gauges from the metrics registry
+         *
+         * Shows count, p50, p99, p99.9 and max per histogram in
+         * microseconds. Feed it from any thread, typically on a timer.
+         */
+        class SystemMetricsWidget : public DashboardWidget
+        {
+        private:
+            metrics::MetricsSnapshot snapshot_;
+            SnapshotChannel<metrics::MetricsSnapshot> snapshot_in_;
+
+        public:
+            SystemMetricsWidget(const std::string &widget_id, const WidgetConfig &cfg)
+                : DashboardWidget(widget_id, cfg) {}
+
+            void update() override;
+            void render() override;
+            std::string get_data() const override;
+            void set_data(const std::string &data) override;
+
+            // Specific methods
+            void update_metrics(const metrics::MetricsSnapshot &snapshot);
+
+            /**
+             * @brief Publish a fresh snapshot of metrics::Registry::global()
+             */
+            void update_from_registry();
+            const metrics::MetricsSnapshot &get_snapshot() const { return snapshot_; }
+        };
+
         // Dashboard panel (container for widgets)
         class DashboardPanel
         {
@@ -351,9 +538,26 @@ namespace trading
             // Rendering
             void render();
             void update();
+
+            /**
+             * @brief Render only the visible widgets flagged for rendering
+             * @return Number of widgets rendered
+             */
+            size_t render_dirty();
         };
 
-        // Main dashboard class
+        /**
+         * @brief Main dashboard class
+         *
+         * Rendering is incremental: update() applies the snapshots widgets
+         * have been sent since the last frame and render_dirty() redraws
+         * only the widgets that changed, so an idle widget costs nothing per
+         * frame. start() moves that loop onto a render thread that produces
+         * one frame per refresh interval, decoupled from the threads
+         * publishing data. While it runs, other threads may only feed
+         * widgets through their update_* methods; layout changes (panels,
+         * widgets, sizes) need the render thread stopped.
+         */
         class Dashboard
         {
         private:
@@ -362,9 +566,19 @@ namespace trading
             std::vector<std::unique_ptr<DashboardPanel>> panels_;
             std::map<std::string, DataUpdateCallback> data_sources_;
             std::chrono::system_clock::time_point last_update_;
-            bool auto_refresh_;
+            std::atomic<bool> auto_refresh_;
             std::chrono::milliseconds refresh_interval_;
 
+            // Render thread
+            std::thread render_thread_;
+            std::mutex render_mutex_;
+            std::condition_variable render_cv_;
+            bool stop_render_ = false;
+            std::atomic<uint64_t> frames_rendered_{0};
+            std::atomic<uint64_t> widgets_rendered_{0};
+
+            void render_loop();
+
             // Layout management
             void auto_layout_panels();
             void handle_widget_resize(const std::string &widget_id, int new_width, int new_height);
@@ -375,6 +589,12 @@ namespace trading
                 : title_(title), width_(width), height_(height), auto_refresh_(true),
                   refresh_interval_(std::chrono::milliseconds(1000)) {}
 
+            ~Dashboard();
+
+            // Prevent copying
+            Dashboard(const Dashboard &) = delete;
+            Dashboard &operator=(const Dashboard &) = delete;
+
             // Panel management
             void add_panel(std::unique_ptr<DashboardPanel> panel);
             void remove_panel(const std::string &panel_id);
@@ -384,6 +604,16 @@ namespace trading
             void add_widget_to_panel(const std::string &panel_id, std::unique_ptr<DashboardWidget> widget);
             DashboardWidget *get_widget(const std::string &widget_id);
 
+            /**
+             * @brief Typed widget lookup, for handing a widget to a data thread
+             * @return nullptr if the id is unknown or the widget is another type
+             */
+            template <typename Widget>
+            Widget *get_widget_as(const std::string &widget_id)
+            {
+                return dynamic_cast<Widget *>(get_widget(widget_id));
+            }
+
             // Data source management
             void register_data_source(const std::string &source_id, DataUpdateCallback callback);
             void unregister_data_source(const std::string &source_id);
@@ -391,7 +621,14 @@ namespace trading
 
             // Configuration
             void set_auto_refresh(bool enabled) { auto_refresh_ = enabled; }
-            void set_refresh_interval(std::chrono::milliseconds interval) { refresh_interval_ = interval; }
+            void set_refresh_interval(std::chrono::milliseconds interval)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(render_mutex_);
+                    refresh_interval_ = interval;
+                }
+                render_cv_.notify_all();
+            }
             void set_size(int width, int height)
             {
                 width_ = width;
@@ -407,8 +644,41 @@ namespace trading
 
             // Main operations
             void initialize();
+
+            /**
+             * @brief Apply pending widget data (widgets changed become dirty)
+             */
             void update();
+
+            /**
+             * @brief Apply pending data and redraw every visible widget
+             */
             void render();
+
+            /**
+             * @brief Redraw only the widgets that changed since they were last drawn
+             * @return Number of widgets rendered
+             */
+            size_t render_dirty();
+
+            /**
+             * @brief Start the render thread
+             *
+             * Every refresh interval it runs update() and render_dirty(); it
+             * skips frames while auto refresh is disabled. Calling start()
+             * while running does nothing.
+             */
+            void start();
+
+            /**
+             * @brief Stop and join the render thread (also done by the destructor)
+             */
+            void stop();
+
+            bool running() const { return render_thread_.joinable(); }
+            uint64_t frames_rendered() const { return frames_rendered_.load(std::memory_order_relaxed); }
+            uint64_t widgets_rendered() const { return widgets_rendered_.load(std::memory_order_relaxed); }
+
             void export_layout(const std::string &filename);
             void load_layout(const std::string &filename);
 
@@ -6,9 +6,14 @@
 #include <fstream>
 #include <map>
 #include <chrono>
+#include <memory_resource>
+#include <string_view>
+#include <cstdint>
 
 #include "../data/market_data.h"
 #include "../data/data_processor.h"
+#include "../core/arena.h"
+#include "../core/thread_pool.h"
 #include "chart_renderer.h"
 
 namespace trading
@@ -27,6 +32,13 @@ namespace trading
             FEATHER
         };
 
+        // Export compression
+        enum class ExportCompression
+        {
+            NONE,
+            GZIP // Requires zlib (HAVE_ZLIB)
+        };
+
         // Export configuration
         struct ExportConfig
         {
@@ -37,12 +49,63 @@ namespace trading
             bool include_timestamps = true;
             std::vector<std::string> columns;
             std::map<std::string, std::string> metadata;
+            // Text formats with GZIP are compressed while they are written and
+            // get a ".gz" suffix; Parquet compresses each page instead
+            ExportCompression compression = ExportCompression::NONE;
+            size_t row_group_size = 64 * 1024; // Rows per Parquet row group / Feather record batch
 
             ExportConfig() = default;
             ExportConfig(const std::string &fname, ExportFormat fmt = ExportFormat::CSV)
                 : filename(fname), format(fmt) {}
         };
 
+        /**
+         * @brief Text fields of a market data series, formatted once
+         *
+         * BatchExporter builds one when several text exports cover the same
+         * series, so timestamps and prices are formatted once instead of
+         * once per format. Fields are stored back to back in chunks of
+         * kChunkRows rows, which are formatted in parallel when a thread
+         * pool is given. The cache is read-only once built and refers to
+         * the series, which must outlive it.
+         */
+        class FormattedSeries
+        {
+        public:
+            enum Column
+            {
+                TIMESTAMP,
+                OPEN,
+                HIGH,
+                LOW,
+                CLOSE,
+                VOLUME,
+                COLUMN_COUNT
+            };
+
+            static constexpr size_t kChunkRows = 4096;
+
+            explicit FormattedSeries(const MarketDataSeries &series, ThreadPool *thread_pool = nullptr);
+
+            const MarketDataSeries &series() const { return *series_; }
+            size_t rows() const { return rows_; }
+
+            // Same text RowWriter produces for the field
+            std::string_view field(size_t row, Column column) const;
+
+        private:
+            struct Chunk
+            {
+                std::string text;
+                std::vector<uint32_t> row_start;
+                std::vector<uint16_t> widths; // COLUMN_COUNT per row
+            };
+
+            const MarketDataSeries *series_;
+            size_t rows_;
+            std::vector<Chunk> chunks_;
+        };
+
         // Data export interface
         class DataExporter
         {
@@ -74,6 +137,28 @@ namespace trading
 
             // Get supported formats
             virtual std::vector<ExportFormat> supported_formats() const = 0;
+
+            // Resource for per-export temporaries such as row buffers
+            // (nullptr = default resource); nothing allocated from it
+            // outlives the export call
+            void set_scratch_resource(std::pmr::memory_resource *scratch) { scratch_ = scratch; }
+            std::pmr::memory_resource *scratch_resource() const
+            {
+                return scratch_ ? scratch_ : std::pmr::get_default_resource();
+            }
+
+            // Preformatted fields for export_market_data (nullptr = format in
+            // place); only used for the series it was built from
+            void set_formatted_series(const FormattedSeries *formatted) { formatted_ = formatted; }
+
+        protected:
+            const FormattedSeries *formatted_for(const MarketDataSeries &series) const
+            {
+                return formatted_ && &formatted_->series() == &series ? formatted_ : nullptr;
+            }
+
+            std::pmr::memory_resource *scratch_ = nullptr;
+            const FormattedSeries *formatted_ = nullptr;
         };
 
         // CSV Exporter
@@ -84,8 +169,8 @@ namespace trading
             std::string escape_csv_field(const std::string &field, const std::string &delimiter);
             std::string format_timestamp(const std::chrono::system_clock::time_point &timestamp);
             std::string format_number(double value, int precision = 6);
-            void write_headers(std::ofstream &file, const std::vector<std::string> &headers, const std::string &delimiter);
-            void write_metadata(std::ofstream &file, const std::map<std::string, std::string> &metadata);
+            void write_headers(std::ostream &file, const std::vector<std::string> &headers, const std::string &delimiter);
+            void write_metadata(std::ostream &file, const std::map<std::string, std::string> &metadata);
 
         public:
             CSVExporter() = default;
@@ -112,9 +197,6 @@ namespace trading
             // Helper methods
             std::string format_timestamp(const std::chrono::system_clock::time_point &timestamp);
             std::string format_number(double value, int precision = 6);
-            std::string serialize_market_data_point(const MarketDataPoint &point);
-            std::string serialize_chart_point(const ChartPoint &point);
-            std::string serialize_candlestick_point(const CandlestickPoint &point);
 
         public:
             JSONExporter() = default;
@@ -142,8 +224,8 @@ namespace trading
             std::string format_timestamp(const std::chrono::system_clock::time_point &timestamp);
             std::string format_number(double value, int precision = 6);
             std::string escape_xml(const std::string &text);
-            void write_xml_header(std::ofstream &file, const std::string &root_element);
-            void write_xml_footer(std::ofstream &file, const std::string &root_element);
+            void write_xml_header(std::ostream &file, const std::string &root_element);
+            void write_xml_footer(std::ostream &file, const std::string &root_element);
 
         public:
             XMLExporter() = default;
@@ -170,8 +252,9 @@ namespace trading
             // Helper methods
             std::string format_timestamp(const std::chrono::system_clock::time_point &timestamp);
             std::string format_number(double value, int precision = 6);
-            void write_excel_header(std::ofstream &file);
-            void write_excel_footer(std::ofstream &file);
+            void write_excel_header(std::ostream &file);
+            void write_excel_footer(std::ostream &file);
+            CSVExporter csv_delegate() const; // Shares this exporter's scratch and formatted series
 
         public:
             ExcelExporter() = default;
@@ -200,18 +283,35 @@ namespace trading
             static std::string get_format_name(ExportFormat format);
         };
 
-        // Batch export manager
+        /**
+         * @brief Runs each export configuration through the exporters for its format
+         *
+         * With a thread pool the exporters run concurrently, each with its
+         * own scratch arena; one exporter's configurations still run in
+         * turn, so exporters are never entered from two threads. Market
+         * data bound for more than one text export is formatted once into
+         * a FormattedSeries that all of them copy from.
+         */
         class BatchExporter
         {
         private:
             std::vector<std::unique_ptr<DataExporter>> exporters_;
+            std::vector<std::unique_ptr<ScratchArena>> scratch_; // One per exporter, reset after each export
             std::map<std::string, ExportConfig> export_configs_;
+            std::map<std::string, bool> export_status_;
+            std::shared_ptr<ThreadPool> thread_pool_;
+            size_t scratch_bytes_;
+
+            // Runs export_one(exporter, config) for every matching pair and records the status
+            template <typename Export>
+            bool run_exports(Export &&export_one);
 
         public:
-            BatchExporter() = default;
+            explicit BatchExporter(size_t scratch_bytes = 256 * 1024);
+            explicit BatchExporter(std::shared_ptr<ThreadPool> thread_pool, size_t scratch_bytes = 256 * 1024);
             ~BatchExporter() = default;
 
-            // Add exporter
+            // Add exporter (its scratch resource becomes an arena owned by the batch)
             void add_exporter(std::unique_ptr<DataExporter> exporter);
 
             // Add export configuration
@@ -237,7 +337,7 @@ namespace trading
             // Clear all configurations
             void clear_configs();
 
-            // Get export status
+            // Per configuration: whether every exporter succeeded in the last batch
             std::map<std::string, bool> get_export_status() const;
         };
 
@@ -260,7 +360,8 @@ namespace trading
             // Get file size
             size_t get_file_size(const std::string &filename);
 
-            // Compress file (if supported)
+            // Gzip input_file into output_file through the exporters' streaming
+            // compression stage (false without zlib)
             bool compress_file(const std::string &input_file, const std::string &output_file);
 
             // Format file size for display
@@ -0,0 +1,396 @@
+#include "analytics/monte_carlo.h"
+#include "analytics/random.h"
+#include "data/data_processor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace trading
+{
+    namespace analytics
+    {
+        namespace
+        {
+            constexpr double kTwoPi = 6.283185307179586476925286766559;
+
+            // Structure-of-arrays scratch for one block of paths. Allocated once
+            // per worker and reused for every block that worker claims.
+            struct BlockScratch
+            {
+                std::vector<uint64_t> s0, s1, s2, s3; // Per-path xoshiro256++ state
+                std::vector<double> wealth;          // Current path value (starts at 1)
+                std::vector<double> peak;            // Running maximum of wealth
+                std::vector<double> max_drawdown;    // Running maximum drawdown
+                std::vector<double> spare_normal;    // Second Box-Muller output
+                std::vector<size_t> index;           // Current bootstrap position
+
+                explicit BlockScratch(size_t block_size)
+                    : s0(block_size), s1(block_size), s2(block_size), s3(block_size),
+                      wealth(block_size), peak(block_size), max_drawdown(block_size),
+                      spare_normal(block_size), index(block_size) {}
+            };
+
+            // Advance lane p of the SoA generator (xoshiro256++), returning 64 random bits
+            inline uint64_t next_lane(uint64_t *__restrict s0, uint64_t *__restrict s1,
+                                      uint64_t *__restrict s2, uint64_t *__restrict s3, size_t p)
+            {
+                const uint64_t result = Xoshiro256::rotl(s0[p] + s3[p], 23) + s0[p];
+                const uint64_t t = s1[p] << 17;
+
+                s2[p] ^= s0[p];
+                s3[p] ^= s1[p];
+                s1[p] ^= s2[p];
+                s0[p] ^= s3[p];
+                s2[p] ^= t;
+                s3[p] = Xoshiro256::rotl(s3[p], 45);
+
+                return result;
+            }
+
+            // Seed every lane of a block from (seed, global path index)
+            void seed_block(BlockScratch &scratch, uint64_t seed, size_t first_path, size_t count)
+            {
+                for (size_t p = 0; p < count; ++p)
+                {
+                    uint64_t sm = seed ^ ((first_path + p) * 0xD1B54A32D192ED03ULL);
+                    scratch.s0[p] = splitmix64(sm);
+                    scratch.s1[p] = splitmix64(sm);
+                    scratch.s2[p] = splitmix64(sm);
+                    scratch.s3[p] = splitmix64(sm);
+                    scratch.wealth[p] = 1.0;
+                    scratch.peak[p] = 1.0;
+                    scratch.max_drawdown[p] = 0.0;
+                    scratch.index[p] = 0;
+                }
+            }
+
+            // Apply one simulated growth factor per lane and update drawdown state
+            inline void apply_growth(double *__restrict wealth, double *__restrict peak,
+                                     double *__restrict max_dd, size_t p, double growth)
+            {
+                double w = wealth[p] * growth;
+                double pk = std::max(peak[p], w);
+                double dd = pk > 0.0 ? 1.0 - w / pk : 0.0;
+                wealth[p] = w;
+                peak[p] = pk;
+                max_dd[p] = std::max(max_dd[p], dd);
+            }
+
+            void simulate_bootstrap_block(BlockScratch &scratch, size_t count, size_t horizon,
+                                          std::span<const double> returns, size_t block_length)
+            {
+                uint64_t *__restrict s0 = scratch.s0.data();
+                uint64_t *__restrict s1 = scratch.s1.data();
+                uint64_t *__restrict s2 = scratch.s2.data();
+                uint64_t *__restrict s3 = scratch.s3.data();
+                double *__restrict wealth = scratch.wealth.data();
+                double *__restrict peak = scratch.peak.data();
+                double *__restrict max_dd = scratch.max_drawdown.data();
+                size_t *__restrict index = scratch.index.data();
+
+                const double *sample = returns.data();
+                const size_t n = returns.size();
+                const double n_double = static_cast<double>(n);
+
+                for (size_t t = 0; t < horizon; ++t)
+                {
+                    if (t % block_length == 0)
+                    {
+                        // Start a new block at a uniformly drawn position
+                        for (size_t p = 0; p < count; ++p)
+                        {
+                            size_t idx = static_cast<size_t>(Xoshiro256::to_unit_double(next_lane(s0, s1, s2, s3, p)) * n_double);
+                            index[p] = idx;
+                            apply_growth(wealth, peak, max_dd, p, 1.0 + sample[idx]);
+                        }
+                    }
+                    else
+                    {
+                        // Continue the current block, wrapping around the sample
+                        for (size_t p = 0; p < count; ++p)
+                        {
+                            size_t idx = index[p] + 1;
+                            idx = idx == n ? 0 : idx;
+                            index[p] = idx;
+                            apply_growth(wealth, peak, max_dd, p, 1.0 + sample[idx]);
+                        }
+                    }
+                }
+            }
+
+            // Log-normal steps are accumulated in the log domain: wealth, peak and
+            // drawdown are tracked as log values so no exp() is needed per step.
+            // On exit the scratch arrays hold wealth and drawdown in linear terms.
+            void simulate_gbm_block(BlockScratch &scratch, size_t count, size_t horizon,
+                                    double log_mean, double log_std_dev)
+            {
+                uint64_t *__restrict s0 = scratch.s0.data();
+                uint64_t *__restrict s1 = scratch.s1.data();
+                uint64_t *__restrict s2 = scratch.s2.data();
+                uint64_t *__restrict s3 = scratch.s3.data();
+                double *__restrict log_wealth = scratch.wealth.data();
+                double *__restrict log_peak = scratch.peak.data();
+                double *__restrict worst = scratch.max_drawdown.data(); // min(log_wealth - log_peak)
+                double *__restrict spare = scratch.spare_normal.data();
+
+                for (size_t p = 0; p < count; ++p)
+                {
+                    log_wealth[p] = 0.0;
+                    log_peak[p] = 0.0;
+                    worst[p] = 0.0;
+                }
+
+                for (size_t t = 0; t < horizon; ++t)
+                {
+                    if (t % 2 == 0)
+                    {
+                        // Box-Muller: one pair of uniforms gives this step and the next
+                        for (size_t p = 0; p < count; ++p)
+                        {
+                            double u1 = 1.0 - Xoshiro256::to_unit_double(next_lane(s0, s1, s2, s3, p)); // (0, 1]
+                            double u2 = Xoshiro256::to_unit_double(next_lane(s0, s1, s2, s3, p));
+                            double radius = std::sqrt(-2.0 * std::log(u1));
+                            double angle = kTwoPi * u2;
+                            spare[p] = radius * std::sin(angle);
+
+                            double lw = log_wealth[p] + log_mean + log_std_dev * radius * std::cos(angle);
+                            double lp = std::max(log_peak[p], lw);
+                            log_wealth[p] = lw;
+                            log_peak[p] = lp;
+                            worst[p] = std::min(worst[p], lw - lp);
+                        }
+                    }
+                    else
+                    {
+                        for (size_t p = 0; p < count; ++p)
+                        {
+                            double lw = log_wealth[p] + log_mean + log_std_dev * spare[p];
+                            double lp = std::max(log_peak[p], lw);
+                            log_wealth[p] = lw;
+                            log_peak[p] = lp;
+                            worst[p] = std::min(worst[p], lw - lp);
+                        }
+                    }
+                }
+
+                for (size_t p = 0; p < count; ++p)
+                {
+                    log_wealth[p] = std::exp(log_wealth[p]);
+                    worst[p] = -std::expm1(worst[p]);
+                }
+            }
+
+            // Quantile of sorted data using linear interpolation between order statistics
+            double sorted_quantile(const std::vector<double> &sorted, double q)
+            {
+                if (sorted.empty())
+                {
+                    return 0.0;
+                }
+                double position = q * static_cast<double>(sorted.size() - 1);
+                size_t lower = static_cast<size_t>(position);
+                size_t upper = std::min(lower + 1, sorted.size() - 1);
+                double fraction = position - static_cast<double>(lower);
+                return sorted[lower] + fraction * (sorted[upper] - sorted[lower]);
+            }
+        }
+
+        MonteCarloEngine::MonteCarloEngine(std::shared_ptr<ThreadPool> thread_pool, const MonteCarloConfig &config)
+            : thread_pool_(std::move(thread_pool)), config_(config)
+        {
+            if (config_.num_paths == 0 || config_.horizon == 0)
+            {
+                throw std::invalid_argument("Monte Carlo requires at least one path and one step");
+            }
+            if (config_.paths_per_block == 0)
+            {
+                config_.paths_per_block = 1024;
+            }
+            if (config_.bootstrap_block_length == 0)
+            {
+                config_.bootstrap_block_length = 1;
+            }
+            for (double level : config_.confidence_levels)
+            {
+                if (!(level > 0.0 && level < 1.0))
+                {
+                    throw std::invalid_argument("Confidence levels must be in (0, 1)");
+                }
+            }
+        }
+
+        MonteCarloResult MonteCarloEngine::run(std::span<const double> returns) const
+        {
+            if (returns.empty())
+            {
+                throw std::invalid_argument("Monte Carlo requires a non-empty return sample");
+            }
+
+            MonteCarloResult result;
+            result.terminal_returns.resize(config_.num_paths);
+            result.max_drawdowns.resize(config_.num_paths);
+
+            // Fit the log-normal step distribution once, up front
+            double log_mean = 0.0;
+            double log_std_dev = 0.0;
+            if (config_.method == SimulationMethod::GEOMETRIC_BROWNIAN)
+            {
+                size_t count = 0;
+                double mean = 0.0, m2 = 0.0;
+                for (double r : returns)
+                {
+                    if (r <= -1.0 || !std::isfinite(r))
+                    {
+                        continue;
+                    }
+                    double x = std::log1p(r);
+                    ++count;
+                    double delta = x - mean;
+                    mean += delta / count;
+                    m2 += delta * (x - mean);
+                }
+                if (count == 0)
+                {
+                    throw std::invalid_argument("Return sample has no usable values");
+                }
+                log_mean = mean;
+                log_std_dev = count > 1 ? std::sqrt(m2 / (count - 1)) : 0.0;
+            }
+
+            auto start_time = std::chrono::steady_clock::now();
+
+            const size_t block_size = config_.paths_per_block;
+            const size_t num_blocks = (config_.num_paths + block_size - 1) / block_size;
+            std::atomic<size_t> next_block{0};
+
+            auto worker = [&]()
+            {
+                BlockScratch scratch(block_size);
+
+                while (true)
+                {
+                    size_t block = next_block.fetch_add(1, std::memory_order_relaxed);
+                    if (block >= num_blocks)
+                    {
+                        return;
+                    }
+
+                    size_t first_path = block * block_size;
+                    size_t count = std::min(block_size, config_.num_paths - first_path);
+
+                    seed_block(scratch, config_.seed, first_path, count);
+
+                    if (config_.method == SimulationMethod::BOOTSTRAP)
+                    {
+                        simulate_bootstrap_block(scratch, count, config_.horizon, returns, config_.bootstrap_block_length);
+                    }
+                    else
+                    {
+                        simulate_gbm_block(scratch, count, config_.horizon, log_mean, log_std_dev);
+                    }
+
+                    // Write outcomes straight into the result columns
+                    for (size_t p = 0; p < count; ++p)
+                    {
+                        result.terminal_returns[first_path + p] = scratch.wealth[p] - 1.0;
+                        result.max_drawdowns[first_path + p] = scratch.max_drawdown[p];
+                    }
+                }
+            };
+
+            size_t num_workers = thread_pool_ ? std::min(thread_pool_->thread_count(), num_blocks) : 0;
+            if (num_workers <= 1)
+            {
+                worker();
+            }
+            else
+            {
+                std::vector<std::future<void>> futures;
+                futures.reserve(num_workers);
+                for (size_t i = 0; i < num_workers; ++i)
+                {
+                    futures.push_back(thread_pool_->submit(worker));
+                }
+                for (auto &future : futures)
+                {
+                    future.get();
+                }
+            }
+
+            result.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+            if (result.elapsed_seconds > 0.0)
+            {
+                result.paths_per_second = config_.num_paths / result.elapsed_seconds;
+            }
+
+            summarize(result, config_.confidence_levels);
+            return result;
+        }
+
+        MonteCarloResult MonteCarloEngine::run_from_prices(const std::vector<double> &prices) const
+        {
+            DataProcessor processor;
+            auto returns = processor.calculate_returns(prices);
+            if (returns.size() < 2)
+            {
+                throw std::invalid_argument("Monte Carlo requires at least two prices");
+            }
+            return run(std::span<const double>(returns).subspan(1));
+        }
+
+        void MonteCarloEngine::summarize(MonteCarloResult &result, const std::vector<double> &confidence_levels)
+        {
+            const size_t n = result.terminal_returns.size();
+            if (n == 0)
+            {
+                return;
+            }
+
+            std::vector<double> sorted_returns = result.terminal_returns;
+            std::sort(sorted_returns.begin(), sorted_returns.end());
+            std::vector<double> sorted_drawdowns = result.max_drawdowns;
+            std::sort(sorted_drawdowns.begin(), sorted_drawdowns.end());
+
+            double sum = std::accumulate(sorted_returns.begin(), sorted_returns.end(), 0.0);
+            result.mean_return = sum / n;
+
+            double variance = 0.0;
+            for (double r : sorted_returns)
+            {
+                double diff = r - result.mean_return;
+                variance += diff * diff;
+            }
+            result.return_std_dev = n > 1 ? std::sqrt(variance / (n - 1)) : 0.0;
+
+            result.median_return = sorted_quantile(sorted_returns, 0.5);
+            size_t losses = static_cast<size_t>(std::lower_bound(sorted_returns.begin(), sorted_returns.end(), 0.0) - sorted_returns.begin());
+            result.probability_of_loss = static_cast<double>(losses) / n;
+
+            result.mean_max_drawdown = std::accumulate(sorted_drawdowns.begin(), sorted_drawdowns.end(), 0.0) / n;
+            result.median_max_drawdown = sorted_quantile(sorted_drawdowns, 0.5);
+
+            result.risk.clear();
+            for (double level : confidence_levels)
+            {
+                RiskMeasure measure;
+                measure.confidence = level;
+
+                // VaR is the loss at the (1 - level) quantile of returns
+                double cutoff = sorted_quantile(sorted_returns, 1.0 - level);
+                measure.value_at_risk = -cutoff;
+
+                // CVaR averages every outcome at or below the cutoff
+                size_t tail = static_cast<size_t>(std::upper_bound(sorted_returns.begin(), sorted_returns.end(), cutoff) - sorted_returns.begin());
+                tail = std::max<size_t>(tail, 1);
+                measure.conditional_var = -std::accumulate(sorted_returns.begin(), sorted_returns.begin() + tail, 0.0) / tail;
+
+                measure.drawdown_at_risk = sorted_quantile(sorted_drawdowns, level);
+                result.risk.push_back(measure);
+            }
+        }
+
+    } // namespace analytics
+} // namespace trading
@@ -0,0 +1,432 @@
+#include "analytics/portfolio_analytics.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace trading
+{
+    namespace analytics
+    {
+
+        namespace
+        {
+            // The per-bar work is split into two kernels, each a branch-free
+            // loop over a run of curves that the compiler vectorizes (one
+            // fused loop, or the same loops inside a member function, stay
+            // scalar with GCC). Pointers are offset to the first curve of
+            // the run.
+
+            // Returns, Welford moments and the rolling window. The return
+            // divides by 1 where the previous equity is not positive and
+            // masks the result, since a select around the division would
+            // keep the loop scalar.
+            void advance_returns(size_t count, const double *__restrict price, const double *__restrict last,
+                                 double *__restrict mean, double *__restrict m2, double *__restrict downside,
+                                 double *__restrict ring, double *__restrict sum, double *__restrict sum_sq,
+                                 double *__restrict cross, double inv_n, double risk_free,
+                                 double benchmark_in, double benchmark_out)
+            {
+                for (size_t c = 0; c < count; ++c)
+                {
+                    const double previous = last[c];
+                    const double valid = static_cast<double>(previous > 0.0);
+                    const double r = (price[c] / (previous * valid + (1.0 - valid)) - 1.0) * valid;
+
+                    const double delta = r - mean[c];
+                    mean[c] += delta * inv_n;
+                    m2[c] += delta * (r - mean[c]);
+                    const double shortfall = std::min(r - risk_free, 0.0);
+                    downside[c] += shortfall * shortfall;
+
+                    const double out = ring[c];
+                    ring[c] = r;
+                    sum[c] += r - out;
+                    sum_sq[c] += r * r - out * out;
+                    cross[c] += r * benchmark_in - out * benchmark_out;
+                }
+            }
+
+            // Drawdown, underwater duration and win/loss bookkeeping; moves
+            // `last` on to the new equity
+            void advance_drawdowns(size_t count, const double *__restrict price, double *__restrict last,
+                                   double *__restrict peak, double *__restrict max_dd, double *__restrict underwater,
+                                   double *__restrict max_underwater, double *__restrict win_bars,
+                                   double *__restrict loss_bars, double *__restrict gross_gain,
+                                   double *__restrict gross_loss)
+            {
+                for (size_t c = 0; c < count; ++c)
+                {
+                    const double previous = last[c];
+                    const double e = price[c];
+                    const double pk = std::max(peak[c], e);
+                    const double dd = pk > 0.0 ? 1.0 - e / pk : 0.0;
+                    const double below = e < pk ? underwater[c] + 1.0 : 0.0;
+                    peak[c] = pk;
+                    max_dd[c] = std::max(max_dd[c], dd);
+                    underwater[c] = below;
+                    max_underwater[c] = std::max(max_underwater[c], below);
+
+                    const double change = e - previous;
+                    win_bars[c] += change > 0.0 ? 1.0 : 0.0;
+                    loss_bars[c] += change < 0.0 ? 1.0 : 0.0;
+                    gross_gain[c] += std::max(change, 0.0);
+                    gross_loss[c] += std::max(-change, 0.0);
+                    last[c] = e;
+                }
+            }
+
+            // Turnover and trade count from the change in exposure
+            void advance_exposures(size_t count, const double *__restrict weights, double *__restrict held,
+                                   double *__restrict turnover, double *__restrict trades)
+            {
+                for (size_t c = 0; c < count; ++c)
+                {
+                    const double change = std::abs(weights[c] - held[c]);
+                    turnover[c] += change;
+                    trades[c] += change != 0.0 ? 1.0 : 0.0;
+                    held[c] = weights[c];
+                }
+            }
+        }
+
+        // EquityMatrix implementation
+        EquityMatrix::EquityMatrix(size_t curves, size_t reserve_bars)
+            : curves_(curves)
+        {
+            values_.reserve(curves * reserve_bars);
+        }
+
+        EquityMatrix EquityMatrix::from_curves(const std::vector<std::vector<double>> &curves)
+        {
+            size_t bars = curves.empty() ? 0 : curves[0].size();
+            for (const auto &curve : curves)
+            {
+                if (curve.size() != bars)
+                {
+                    throw std::invalid_argument("Equity curves must have the same length");
+                }
+            }
+
+            EquityMatrix matrix(curves.size(), bars);
+            matrix.values_.resize(curves.size() * bars);
+            for (size_t c = 0; c < curves.size(); ++c)
+            {
+                for (size_t b = 0; b < bars; ++b)
+                {
+                    matrix.values_[b * curves.size() + c] = curves[c][b];
+                }
+            }
+            return matrix;
+        }
+
+        void EquityMatrix::append_bar(std::span<const double> equity)
+        {
+            if (equity.size() != curves_)
+            {
+                throw std::invalid_argument("Bar must have one value per curve");
+            }
+            values_.insert(values_.end(), equity.begin(), equity.end());
+        }
+
+        std::vector<double> EquityMatrix::curve(size_t index) const
+        {
+            std::vector<double> column(bars());
+            for (size_t b = 0; b < column.size(); ++b)
+            {
+                column[b] = at(b, index);
+            }
+            return column;
+        }
+
+        // PortfolioAnalytics implementation
+        PortfolioAnalytics::PortfolioAnalytics(size_t curves, std::shared_ptr<ThreadPool> thread_pool,
+                                               const AnalyticsConfig &config)
+            : curves_(curves), thread_pool_(std::move(thread_pool)), config_(config)
+        {
+            if (config_.rolling_window == 0)
+            {
+                throw std::invalid_argument("Rolling window must be positive");
+            }
+            if (!(config_.periods_per_year > 0.0))
+            {
+                throw std::invalid_argument("Periods per year must be positive");
+            }
+            config_.curves_per_task = std::max<size_t>(1, config_.curves_per_task);
+            reset();
+        }
+
+        void PortfolioAnalytics::reset()
+        {
+            bars_ = 0;
+            has_exposure_ = false;
+            benchmark_ = BenchmarkWindow{};
+            benchmark_.ring.assign(config_.rolling_window, 0.0);
+
+            for (auto *state : {&first_, &last_, &peak_, &mean_, &m2_, &downside_, &max_dd_, &underwater_,
+                                &max_underwater_, &win_bars_, &loss_bars_, &gross_gain_, &gross_loss_, &exposure_,
+                                &turnover_, &trades_, &window_sum_, &window_sum_sq_, &window_cross_})
+            {
+                state->assign(curves_, 0.0);
+            }
+            ring_.assign(config_.rolling_window * curves_, 0.0);
+        }
+
+        double PortfolioAnalytics::push_benchmark(BenchmarkWindow &window, double value, size_t bar)
+        {
+            const size_t size = window.ring.size();
+            double &slot = window.ring[bar % size];
+            double out = slot;
+            slot = value;
+            window.sum += value - out;
+            window.sum_sq += value * value - out * out;
+            window.count = std::min(window.count + 1, size);
+
+            if ((bar + 1) % size == 0)
+            {
+                window.sum = 0.0;
+                window.sum_sq = 0.0;
+                for (double b : window.ring)
+                {
+                    window.sum += b;
+                    window.sum_sq += b * b;
+                }
+            }
+            return out;
+        }
+
+        template <typename Body>
+        void PortfolioAnalytics::for_each_task(Body &&body)
+        {
+            // Serial runs are split the same way, so each pass over the state
+            // arrays stays within a cache-sized run of curves
+            const size_t per_task = config_.curves_per_task;
+            const size_t tasks = (curves_ + per_task - 1) / per_task;
+            auto task = [&](size_t t)
+            {
+                body(t * per_task, std::min(curves_, (t + 1) * per_task));
+            };
+
+            if (thread_pool_ && tasks > 1)
+            {
+                thread_pool_->parallel_for(0, tasks, task, 1);
+            }
+            else
+            {
+                for (size_t t = 0; t < tasks; ++t)
+                {
+                    task(t);
+                }
+            }
+        }
+
+        // Advance curves [begin, end) by the return with index `bar` (0 for
+        // the move from the first to the second bar)
+        void PortfolioAnalytics::advance(const BenchmarkWindow &window, size_t bar, const double *equity,
+                                         const double *exposure, double benchmark_in, double benchmark_out,
+                                         size_t begin, size_t end)
+        {
+            const size_t count = end - begin;
+            const size_t window_size = config_.rolling_window;
+            double *sum = window_sum_.data();
+            double *sum_sq = window_sum_sq_.data();
+            double *cross = window_cross_.data();
+
+            advance_returns(count, equity + begin, last_.data() + begin, mean_.data() + begin, m2_.data() + begin,
+                            downside_.data() + begin, ring_.data() + (bar % window_size) * curves_ + begin,
+                            sum + begin, sum_sq + begin, cross + begin, 1.0 / static_cast<double>(bar + 1),
+                            config_.risk_free_rate / config_.periods_per_year, benchmark_in, benchmark_out);
+            advance_drawdowns(count, equity + begin, last_.data() + begin, peak_.data() + begin,
+                              max_dd_.data() + begin, underwater_.data() + begin, max_underwater_.data() + begin,
+                              win_bars_.data() + begin, loss_bars_.data() + begin, gross_gain_.data() + begin,
+                              gross_loss_.data() + begin);
+
+            if (exposure)
+            {
+                advance_exposures(count, exposure + begin, exposure_.data() + begin, turnover_.data() + begin,
+                                  trades_.data() + begin);
+            }
+
+            if ((bar + 1) % window_size == 0)
+            {
+                // The ring has just been overwritten in full: rebuild the
+                // windowed sums so rounding from add/subtract cannot build up
+                for (size_t c = begin; c < end; ++c)
+                {
+                    sum[c] = 0.0;
+                    sum_sq[c] = 0.0;
+                    cross[c] = 0.0;
+                }
+                for (size_t slot = 0; slot < window_size; ++slot)
+                {
+                    const double *returns = ring_.data() + slot * curves_;
+                    const double b = window.ring[slot];
+                    for (size_t c = begin; c < end; ++c)
+                    {
+                        sum[c] += returns[c];
+                        sum_sq[c] += returns[c] * returns[c];
+                        cross[c] += returns[c] * b;
+                    }
+                }
+            }
+        }
+
+        void PortfolioAnalytics::update(std::span<const double> equity, double benchmark_return,
+                                        std::span<const double> exposure)
+        {
+            if (equity.size() != curves_ || (!exposure.empty() && exposure.size() != curves_))
+            {
+                throw std::invalid_argument("Bar must have one value per curve");
+            }
+            const double *held = exposure.empty() ? nullptr : exposure.data();
+
+            if (bars_ == 0)
+            {
+                // The first bar only sets the starting point of every curve
+                std::copy(equity.begin(), equity.end(), first_.begin());
+                std::copy(equity.begin(), equity.end(), last_.begin());
+                std::copy(equity.begin(), equity.end(), peak_.begin());
+                if (held)
+                {
+                    std::copy(exposure.begin(), exposure.end(), exposure_.begin());
+                }
+                has_exposure_ = held != nullptr;
+                bars_ = 1;
+                return;
+            }
+
+            const size_t bar = bars_ - 1;
+            const double benchmark_out = push_benchmark(benchmark_, benchmark_return, bar);
+            for_each_task([&](size_t begin, size_t end)
+                          { advance(benchmark_, bar, equity.data(), held, benchmark_return, benchmark_out, begin, end); });
+            has_exposure_ = has_exposure_ || held != nullptr;
+            ++bars_;
+        }
+
+        void PortfolioAnalytics::run(const EquityMatrix &equity, std::span<const double> benchmark_returns,
+                                     const EquityMatrix *exposures)
+        {
+            const size_t count = equity.bars();
+            if (equity.curves() != curves_ ||
+                (!benchmark_returns.empty() && benchmark_returns.size() != count) ||
+                (exposures && (exposures->curves() != curves_ || exposures->bars() != count)))
+            {
+                throw std::invalid_argument("Equity, benchmark and exposure shapes do not match");
+            }
+            if (count == 0)
+            {
+                return;
+            }
+
+            auto benchmark_at = [&](size_t t)
+            {
+                return benchmark_returns.empty() ? 0.0 : benchmark_returns[t];
+            };
+            auto exposure_at = [&](size_t t)
+            {
+                return exposures ? exposures->bar(t).data() : nullptr;
+            };
+
+            size_t first = 0;
+            if (bars_ == 0)
+            {
+                update(equity.bar(0), benchmark_at(0), exposures ? exposures->bar(0) : std::span<const double>{});
+                first = 1;
+            }
+
+            // Every task walks all bars for its own curves, replaying the
+            // shared benchmark window on a private copy
+            const size_t start = bars_ - 1;
+            for_each_task([&](size_t begin, size_t end)
+                          {
+                BenchmarkWindow window = benchmark_;
+                for (size_t t = first; t < count; ++t)
+                {
+                    const size_t bar = start + (t - first);
+                    const double b = benchmark_at(t);
+                    const double out = push_benchmark(window, b, bar);
+                    advance(window, bar, equity.bar(t).data(), exposure_at(t), b, out, begin, end);
+                } });
+
+            for (size_t t = first; t < count; ++t)
+            {
+                push_benchmark(benchmark_, benchmark_at(t), start + (t - first));
+            }
+            has_exposure_ = has_exposure_ || exposures != nullptr;
+            bars_ += count - first;
+        }
+
+        CurveMetrics PortfolioAnalytics::metrics(size_t curve) const
+        {
+            if (curve >= curves_)
+            {
+                throw std::out_of_range("Curve index out of range");
+            }
+
+            CurveMetrics m;
+            m.bars = bars_;
+            if (bars_ < 2)
+            {
+                return m;
+            }
+
+            const double n = static_cast<double>(bars_ - 1);
+            const double periods = config_.periods_per_year;
+            const double annualizer = std::sqrt(periods);
+            const double first = first_[curve];
+            const double last = last_[curve];
+
+            if (first > 0.0)
+            {
+                m.total_return = last / first - 1.0;
+                m.annualized_return = last > 0.0 ? std::pow(last / first, periods / n) - 1.0 : -1.0;
+            }
+
+            const double std_dev = n > 1.0 ? std::sqrt(m2_[curve] / (n - 1.0)) : 0.0;
+            const double excess = mean_[curve] - config_.risk_free_rate / periods;
+            const double downside_dev = std::sqrt(downside_[curve] / n);
+            m.volatility = std_dev * annualizer;
+            m.sharpe_ratio = std_dev > 0.0 ? excess / std_dev * annualizer : 0.0;
+            m.sortino_ratio = downside_dev > 0.0 ? excess / downside_dev * annualizer : 0.0;
+
+            m.max_drawdown = max_dd_[curve];
+            m.max_drawdown_duration = static_cast<size_t>(max_underwater_[curve]);
+            m.current_drawdown = peak_[curve] > 0.0 ? 1.0 - last / peak_[curve] : 0.0;
+            m.calmar_ratio = m.max_drawdown > 0.0 ? m.annualized_return / m.max_drawdown : 0.0;
+
+            // Windowed figures use population moments over the latest returns
+            const double w = static_cast<double>(benchmark_.count);
+            const double mean_r = window_sum_[curve] / w;
+            const double mean_b = benchmark_.sum / w;
+            const double var_r = std::max(0.0, window_sum_sq_[curve] / w - mean_r * mean_r);
+            const double var_b = std::max(0.0, benchmark_.sum_sq / w - mean_b * mean_b);
+            const double covariance = window_cross_[curve] / w - mean_r * mean_b;
+            m.rolling_volatility = w > 1.0 ? std::sqrt(var_r * w / (w - 1.0)) * annualizer : 0.0;
+            m.rolling_beta = var_b > 0.0 ? covariance / var_b : 0.0;
+
+            if (has_exposure_)
+            {
+                m.turnover = turnover_[curve] * periods / n;
+                m.total_trades = static_cast<int>(trades_[curve]);
+            }
+
+            const double wins = win_bars_[curve];
+            const double losses = loss_bars_[curve];
+            m.win_rate = wins + losses > 0.0 ? wins / (wins + losses) : 0.0;
+            m.avg_win = wins > 0.0 ? gross_gain_[curve] / wins : 0.0;
+            m.avg_loss = losses > 0.0 ? gross_loss_[curve] / losses : 0.0;
+            m.profit_factor = gross_loss_[curve] > 0.0 ? gross_gain_[curve] / gross_loss_[curve] : 0.0;
+            return m;
+        }
+
+        std::vector<CurveMetrics> PortfolioAnalytics::all_metrics() const
+        {
+            std::vector<CurveMetrics> all(curves_);
+            for (size_t c = 0; c < curves_; ++c)
+            {
+                all[c] = metrics(c);
+            }
+            return all;
+        }
+
+    } // namespace analytics
+} // namespace trading
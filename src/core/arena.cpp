@@ -0,0 +1,123 @@
+#include "core/arena.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace trading
+{
+    namespace
+    {
+        constexpr size_t kBlockAlignment = alignof(std::max_align_t);
+
+        size_t align_up(size_t value, size_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    ScratchArena::ScratchArena(size_t initial_bytes, std::pmr::memory_resource *upstream)
+        : upstream_(upstream)
+    {
+        if (upstream_ == nullptr)
+        {
+            throw std::invalid_argument("Upstream resource must not be null");
+        }
+
+        capacity_ = align_up(std::max<size_t>(initial_bytes, kBlockAlignment), kBlockAlignment);
+        buffer_ = static_cast<std::byte *>(upstream_->allocate(capacity_, kBlockAlignment));
+        ++upstream_allocations_;
+        current_ = buffer_;
+        current_size_ = capacity_;
+    }
+
+    ScratchArena::~ScratchArena()
+    {
+        for (const auto &block : overflow_)
+        {
+            upstream_->deallocate(block.data, block.size, block.alignment);
+        }
+        upstream_->deallocate(buffer_, capacity_, kBlockAlignment);
+    }
+
+    void ScratchArena::reset()
+    {
+        size_t used = bytes_used();
+        high_water_ = std::max(high_water_, used);
+
+        if (!overflow_.empty())
+        {
+            for (const auto &block : overflow_)
+            {
+                upstream_->deallocate(block.data, block.size, block.alignment);
+            }
+            overflow_.clear();
+
+            // Next time the whole cycle fits in one buffer
+            size_t grown = align_up(high_water_ + high_water_ / 8, kBlockAlignment);
+            std::byte *buffer = static_cast<std::byte *>(upstream_->allocate(grown, kBlockAlignment));
+            ++upstream_allocations_;
+            upstream_->deallocate(buffer_, capacity_, kBlockAlignment);
+            buffer_ = buffer;
+            capacity_ = grown;
+        }
+
+        current_ = buffer_;
+        current_size_ = capacity_;
+        offset_ = 0;
+        used_before_ = 0;
+    }
+
+    size_t ScratchArena::high_water() const
+    {
+        return std::max(high_water_, bytes_used());
+    }
+
+    void *ScratchArena::do_allocate(size_t bytes, size_t alignment)
+    {
+        // Both block types are max_align_t aligned, so aligning the offset suffices
+        size_t start = align_up(offset_, alignment);
+        if (alignment <= kBlockAlignment && start + bytes <= current_size_)
+        {
+            offset_ = start + bytes;
+            return current_ + start;
+        }
+        return allocate_overflow(bytes, alignment);
+    }
+
+    void ScratchArena::do_deallocate(void *, size_t, size_t)
+    {
+        // Released in bulk by reset()
+    }
+
+    bool ScratchArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+    {
+        return this == &other;
+    }
+
+    void *ScratchArena::allocate_overflow(size_t bytes, size_t alignment)
+    {
+        // Over-aligned requests get a block of their own
+        if (alignment > kBlockAlignment)
+        {
+            size_t size = align_up(bytes, alignment);
+            std::byte *data = static_cast<std::byte *>(upstream_->allocate(size, alignment));
+            ++upstream_allocations_;
+            overflow_.push_back({data, size, alignment});
+            used_before_ += size;
+            return data;
+        }
+
+        // Geometric growth keeps the number of blocks per cycle logarithmic;
+        // the new block becomes the one we bump
+        size_t size = align_up(std::max(bytes, current_size_ * 2), kBlockAlignment);
+        std::byte *data = static_cast<std::byte *>(upstream_->allocate(size, kBlockAlignment));
+        ++upstream_allocations_;
+        overflow_.push_back({data, size, kBlockAlignment});
+
+        used_before_ += offset_;
+        current_ = data;
+        current_size_ = size;
+        offset_ = bytes;
+        return data;
+    }
+
+} // namespace trading
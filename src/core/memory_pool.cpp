@@ -1,200 +1,492 @@
 #include "core/memory_pool.h"
+#include "core/metrics.h"
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <stdexcept>
 
 namespace trading
 {
+    namespace
+    {
+        constexpr size_t kHeaderSize = sizeof(uintptr_t);
+        constexpr size_t kChunkAlignment = 64;
+        constexpr size_t kCacheWays = 4;
+        constexpr size_t kCacheSets = 16;
 
-    MemoryPool::MemoryPool(size_t block_size, size_t initial_blocks)
-        : block_size_(block_size), free_list_(nullptr)
+        // Depot head: block address >> 4 in the low 44 bits, ABA tag above
+        constexpr unsigned kTagShift = 44;
+
+        // Slow paths only: the per-thread cache fast path stays uncounted
+        struct AllocatorMetrics
+        {
+            metrics::Histogram expand{"memory_pool_expand_seconds", "Time to allocate and thread one new chunk"};
+            metrics::Counter expansions{"memory_pool_expansions_total", "Chunks allocated from upstream"};
+            metrics::Counter blocks{"memory_pool_blocks_created_total", "Blocks carved out of new chunks"};
+            metrics::Counter refills{"memory_pool_refills_total", "Thread caches refilled from the shared depot"};
+            metrics::Counter spills{"memory_pool_spills_total", "Magazines returned from thread caches to the depot"};
+        };
+
+        AllocatorMetrics &allocator_metrics()
+        {
+            static AllocatorMetrics instance;
+            return instance;
+        }
+
+        uint64_t pack(void *block, uint64_t tag)
+        {
+            return (tag << kTagShift) | (reinterpret_cast<uintptr_t>(block) >> 4);
+        }
+
+        void *unpack(uint64_t head)
+        {
+            return reinterpret_cast<void *>((head & ((uint64_t{1} << kTagShift) - 1)) << 4);
+        }
+
+        // Allocated: the owner's tag. Free: the next block in the chain.
+        uintptr_t &header(void *block)
+        {
+            return *reinterpret_cast<uintptr_t *>(static_cast<std::byte *>(block) - kHeaderSize);
+        }
+
+        void *next_in_chain(void *block)
+        {
+            return reinterpret_cast<void *>(header(block));
+        }
+
+        // A magazine in the depot keeps its links in its first block's data
+        std::atomic_ref<uintptr_t> next_magazine(void *block)
+        {
+            return std::atomic_ref<uintptr_t>(*static_cast<uintptr_t *>(block));
+        }
+
+        size_t &magazine_count(void *block)
+        {
+            return *reinterpret_cast<size_t *>(static_cast<std::byte *>(block) + sizeof(uintptr_t));
+        }
+
+        size_t round_up(size_t value, size_t multiple)
+        {
+            return (value + multiple - 1) / multiple * multiple;
+        }
+
+        std::atomic<uint64_t> next_pool_id{1};
+
+        // Guards which pool each thread cache slot belongs to
+        std::mutex registry_mutex;
+
+        // Trivially destructible, so still readable after the cache is gone
+        thread_local bool cache_destroyed = false;
+    }
+
+    struct MemoryPool::CacheSlot
     {
+        std::atomic<uint64_t> pool_id{0}; // 0 = unused
+        MemoryPool *pool = nullptr;
+        void *head = nullptr;          // Chain of free blocks
+        std::atomic<size_t> count{0};  // Written by the owner only, read by stats
+    };
 
-        if (block_size == 0)
+    struct MemoryPool::ThreadCache
+    {
+        // Set-associative by pool id: a pool may use any of the ways of
+        // set id % kCacheSets, so a few pools sharing a set coexist
+        std::array<CacheSlot, kCacheSets * kCacheWays> slots;
+
+        ~ThreadCache()
         {
-            throw std::invalid_argument("Block size must be greater than 0");
+            cache_destroyed = true;
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            for (auto &slot : slots)
+            {
+                if (slot.pool_id.load(std::memory_order_relaxed) != 0)
+                {
+                    slot.pool->detach(slot);
+                }
+            }
         }
+    };
 
-        // Add header size to block size
-        size_t total_block_size = sizeof(Block) + block_size - 1; // -1 because data[1] already includes one byte
+    MemoryPool::MemoryPool(size_t block_size, size_t initial_blocks)
+        : block_size_(block_size), stride_(0), id_(next_pool_id.fetch_add(1)),
+          tag_(reinterpret_cast<uintptr_t>(this) | 1)
+    {
 
-        // Ensure proper alignment
-        if (total_block_size % alignof(Block) != 0)
+        if (block_size == 0)
         {
-            total_block_size += alignof(Block) - (total_block_size % alignof(Block));
+            throw std::invalid_argument("Block size must be greater than 0");
         }
 
-        block_size_ = total_block_size;
+        // Free blocks in the depot need two words of data for their links;
+        // the stride keeps every block's data 16-byte aligned
+        stride_ = round_up(kHeaderSize + std::max(block_size, 2 * sizeof(uintptr_t)), kAlignment);
+        block_size_ = stride_ - kHeaderSize;
 
         // Initialize the pool with initial blocks
         if (initial_blocks > 0)
         {
-            expand_pool(initial_blocks);
+            reserve(initial_blocks);
         }
     }
 
     MemoryPool::~MemoryPool()
     {
-        // All memory is automatically freed when chunks_ is destroyed
+        // Detach every thread cache still holding our blocks; the memory
+        // itself is freed when chunks_ is destroyed
+        std::lock_guard<std::mutex> registry(registry_mutex);
+        std::lock_guard<std::mutex> lock(caches_mutex_);
+        for (CacheSlot *slot : caches_)
+        {
+            slot->pool_id.store(0, std::memory_order_relaxed);
+            slot->pool = nullptr;
+        }
     }
 
-    MemoryPool::MemoryPool(MemoryPool &&other) noexcept
-        : block_size_(other.block_size_), chunks_(std::move(other.chunks_)), free_list_(other.free_list_), total_blocks_(other.total_blocks_), allocated_blocks_(other.allocated_blocks_.load())
+    void MemoryPool::ChunkDeleter::operator()(std::byte *chunk) const
     {
-
-        other.free_list_ = nullptr;
-        other.total_blocks_ = 0;
-        other.allocated_blocks_.store(0);
+        ::operator delete(chunk, std::align_val_t{kChunkAlignment});
     }
 
-    MemoryPool &MemoryPool::operator=(MemoryPool &&other) noexcept
+    void *MemoryPool::allocate()
     {
-        if (this != &other)
+        // A thread past its cache's destruction goes straight to the depot
+        CacheSlot *slot = local_slot();
+        CacheSlot direct;
+        CacheSlot &cache = slot ? *slot : direct;
+
+        if (cache.head == nullptr)
         {
-            block_size_ = other.block_size_;
-            chunks_ = std::move(other.chunks_);
-            free_list_ = other.free_list_;
-            total_blocks_ = other.total_blocks_;
-            allocated_blocks_.store(other.allocated_blocks_.load());
+            refill(cache);
+        }
 
-            other.free_list_ = nullptr;
-            other.total_blocks_ = 0;
-            other.allocated_blocks_.store(0);
+        void *block = cache.head;
+        cache.head = next_in_chain(block);
+        cache.count.store(cache.count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        header(block) = tag_;
+
+        if (!slot)
+        {
+            spill(direct, 0);
         }
-        return *this;
+        return block;
     }
 
-    void *MemoryPool::allocate()
+    void MemoryPool::deallocate(void *ptr)
     {
-        std::lock_guard<std::mutex> lock(pool_mutex_);
+        // Ignore null, foreign and already freed pointers
+        if (ptr == nullptr || !owns(ptr))
+        {
+            return;
+        }
+
+        CacheSlot *slot = local_slot();
+        CacheSlot direct;
+        CacheSlot &cache = slot ? *slot : direct;
 
-        // If no free blocks, expand the pool
-        if (free_list_ == nullptr)
+        header(ptr) = reinterpret_cast<uintptr_t>(cache.head);
+        cache.head = ptr;
+        size_t count = cache.count.load(std::memory_order_relaxed) + 1;
+        cache.count.store(count, std::memory_order_relaxed);
+
+        // Keep one magazine so alternating allocate/deallocate stays local
+        if (!slot)
+        {
+            spill(direct, 0);
+        }
+        else if (count >= 2 * kMagazineSize)
         {
-            expand_pool(std::max(size_t(1), total_blocks_ / 2));
+            spill(cache, kMagazineSize);
         }
+    }
 
-        // Get a block from the free list
-        Block *block = free_list_;
-        free_list_ = free_list_->next;
+    bool MemoryPool::owns(const void *ptr) const
+    {
+        return ptr != nullptr && header(const_cast<void *>(ptr)) == tag_;
+    }
 
-        // Update statistics
-        allocated_blocks_.fetch_add(1);
+    size_t MemoryPool::total_blocks() const
+    {
+        return total_blocks_.load();
+    }
 
-        return block->data;
+    size_t MemoryPool::outstanding_blocks() const
+    {
+        return outstanding_blocks_.load(std::memory_order_relaxed);
     }
 
-    void MemoryPool::deallocate(void *ptr)
+    size_t MemoryPool::free_blocks() const
     {
-        if (ptr == nullptr)
+        std::lock_guard<std::mutex> lock(caches_mutex_);
+
+        size_t count = depot_blocks_.load();
+        for (const CacheSlot *slot : caches_)
         {
-            return;
+            count += slot->count.load(std::memory_order_relaxed);
         }
 
-        // Validate the pointer
-        if (!is_valid_pointer(ptr))
+        return count;
+    }
+
+    size_t MemoryPool::allocated_blocks() const
+    {
+        // Blocks in transit between a cache and the depot count as allocated,
+        // so free never exceeds total
+        size_t total = total_blocks();
+        size_t free = free_blocks();
+        return total > free ? total - free : 0;
+    }
+
+    void MemoryPool::reserve(size_t num_blocks)
+    {
+        if (num_blocks == 0)
         {
-            // In production, you might want to log this or throw an exception
             return;
         }
 
-        std::lock_guard<std::mutex> lock(pool_mutex_);
+        std::lock_guard<std::mutex> lock(grow_mutex_);
+        expand_pool(num_blocks);
+    }
+
+    MemoryPool::ThreadCache *MemoryPool::thread_cache()
+    {
+        thread_local ThreadCache cache;
+        return &cache;
+    }
 
-        // Convert pointer back to block
-        Block *block = reinterpret_cast<Block *>(
-            reinterpret_cast<char *>(ptr) - offsetof(Block, data));
+    MemoryPool::CacheSlot *MemoryPool::local_slot()
+    {
+        if (cache_destroyed)
+        {
+            return nullptr;
+        }
 
-        // Add block back to free list
-        block->next = free_list_;
-        free_list_ = block;
+        CacheSlot *set = thread_cache()->slots.data() + (id_ % kCacheSets) * kCacheWays;
+        CacheSlot *empty = nullptr;
+        for (size_t way = 0; way < kCacheWays; ++way)
+        {
+            uint64_t owner = set[way].pool_id.load(std::memory_order_relaxed);
+            if (owner == id_)
+            {
+                return &set[way];
+            }
+            if (owner == 0 && empty == nullptr)
+            {
+                empty = &set[way];
+            }
+        }
 
-        // Update statistics
-        allocated_blocks_.fetch_sub(1);
+        // Only this thread fills its slots, so an empty way stays empty.
+        // With every way taken, use the depot rather than evict another
+        // pool's cache (and take the registry lock) on every call.
+        return empty ? attach(*empty) : nullptr;
     }
 
-    size_t MemoryPool::total_blocks() const
+    MemoryPool::CacheSlot *MemoryPool::attach(CacheSlot &slot)
     {
-        std::lock_guard<std::mutex> lock(pool_mutex_);
-        return total_blocks_;
+        std::lock_guard<std::mutex> registry(registry_mutex);
+
+        slot.pool = this;
+        slot.head = nullptr;
+        slot.count.store(0, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(caches_mutex_);
+            caches_.push_back(&slot);
+        }
+        slot.pool_id.store(id_, std::memory_order_relaxed);
+        return &slot;
     }
 
-    size_t MemoryPool::free_blocks() const
+    void MemoryPool::detach(CacheSlot &slot)
     {
-        std::lock_guard<std::mutex> lock(pool_mutex_);
+        // Called with registry_mutex held, so this pool is still alive
+        spill(slot, 0);
+        {
+            std::lock_guard<std::mutex> lock(caches_mutex_);
+            caches_.erase(std::find(caches_.begin(), caches_.end(), &slot));
+        }
+        slot.pool_id.store(0, std::memory_order_relaxed);
+        slot.pool = nullptr;
+    }
 
+    void MemoryPool::refill(CacheSlot &slot)
+    {
+        allocator_metrics().refills.add();
+        void *first = nullptr;
         size_t count = 0;
-        Block *current = free_list_;
-        while (current != nullptr)
+        while (!pop_magazine(first, count))
         {
-            ++count;
-            current = current->next;
+            // Another thread may have grown the pool while we waited
+            std::lock_guard<std::mutex> lock(grow_mutex_);
+            if (depot_blocks_.load() == 0)
+            {
+                expand_pool(std::max(kMagazineSize, total_blocks_.load() / 2));
+            }
         }
 
-        return count;
+        slot.head = first;
+        slot.count.store(count, std::memory_order_relaxed);
+        outstanding_blocks_.fetch_add(count, std::memory_order_relaxed);
     }
 
-    size_t MemoryPool::allocated_blocks() const
+    void MemoryPool::spill(CacheSlot &slot, size_t keep)
+    {
+        size_t count = slot.count.load(std::memory_order_relaxed);
+        while (count > keep)
+        {
+            size_t take = std::min(kMagazineSize, count - keep);
+            void *first = slot.head;
+            void *last = first;
+            for (size_t i = 1; i < take; ++i)
+            {
+                last = next_in_chain(last);
+            }
+            slot.head = next_in_chain(last);
+            header(last) = 0;
+
+            // Leave the cache before entering the depot, so stats never
+            // count a block twice
+            count -= take;
+            slot.count.store(count, std::memory_order_relaxed);
+            outstanding_blocks_.fetch_sub(take, std::memory_order_relaxed);
+            push_magazine(first, take);
+            allocator_metrics().spills.add();
+        }
+    }
+
+    void MemoryPool::push_magazine(void *first, size_t count)
     {
-        return allocated_blocks_.load();
+        magazine_count(first) = count;
+        depot_blocks_.fetch_add(count);
+
+        uint64_t head = depot_.load(std::memory_order_relaxed);
+        do
+        {
+            next_magazine(first).store(reinterpret_cast<uintptr_t>(unpack(head)), std::memory_order_relaxed);
+        } while (!depot_.compare_exchange_weak(head, pack(first, (head >> kTagShift) + 1),
+                                               std::memory_order_release, std::memory_order_relaxed));
     }
 
-    void MemoryPool::reserve(size_t num_blocks)
+    bool MemoryPool::pop_magazine(void *&first, size_t &count)
     {
-        std::lock_guard<std::mutex> lock(pool_mutex_);
-        expand_pool(num_blocks);
+        uint64_t head = depot_.load(std::memory_order_acquire);
+        while (true)
+        {
+            void *top = unpack(head);
+            if (top == nullptr)
+            {
+                return false;
+            }
+
+            // top may be popped and reused concurrently; blocks are never
+            // unmapped while the pool lives, and the tag makes the CAS fail
+            void *next = reinterpret_cast<void *>(next_magazine(top).load(std::memory_order_relaxed));
+            if (depot_.compare_exchange_weak(head, pack(next, (head >> kTagShift) + 1),
+                                             std::memory_order_acquire, std::memory_order_acquire))
+            {
+                first = top;
+                count = magazine_count(top);
+                depot_blocks_.fetch_sub(count);
+                return true;
+            }
+        }
     }
 
     void MemoryPool::expand_pool(size_t num_blocks)
     {
-        // Calculate chunk size
-        size_t chunk_size = block_size_ * num_blocks;
+        AllocatorMetrics &stats = allocator_metrics();
+        metrics::ScopedTimer timer(stats.expand);
 
-        // Allocate new chunk
-        auto chunk = std::make_unique<char[]>(chunk_size);
+        // Calculate chunk size; the first header sits just before a 16-byte boundary
+        size_t chunk_size = kAlignment + stride_ * num_blocks;
 
-        // Initialize blocks in the chunk
-        char *chunk_ptr = chunk.get();
-        for (size_t i = 0; i < num_blocks; ++i)
+        // Allocate new chunk
+        std::unique_ptr<std::byte[], ChunkDeleter> chunk(
+            static_cast<std::byte *>(::operator new(chunk_size, std::align_val_t{kChunkAlignment})));
+        if ((reinterpret_cast<uintptr_t>(chunk.get()) + chunk_size) >> (kTagShift + 4))
         {
-            Block *block = reinterpret_cast<Block *>(chunk_ptr);
-
-            // Add to free list
-            block->next = free_list_;
-            free_list_ = block;
+            throw std::bad_alloc(); // Outside the address range the depot head can encode
+        }
 
-            chunk_ptr += block_size_;
+        // Initialize blocks in the chunk, one magazine at a time
+        std::byte *data = chunk.get() + kAlignment;
+        total_blocks_.fetch_add(num_blocks);
+        for (size_t begin = 0; begin < num_blocks; begin += kMagazineSize)
+        {
+            size_t end = std::min(num_blocks, begin + kMagazineSize);
+            for (size_t i = begin; i < end; ++i)
+            {
+                void *block = data + i * stride_;
+                header(block) = i + 1 < end ? reinterpret_cast<uintptr_t>(data + (i + 1) * stride_) : 0;
+            }
+            push_magazine(data + begin * stride_, end - begin);
         }
 
         // Store the chunk
         chunks_.push_back(std::move(chunk));
-        total_blocks_ += num_blocks;
+        stats.expansions.add();
+        stats.blocks.add(num_blocks);
     }
 
-    bool MemoryPool::is_valid_pointer(void *ptr) const
+    PoolResource::PoolResource(std::pmr::memory_resource *upstream)
+        : upstream_(upstream)
     {
-        if (ptr == nullptr)
+        if (upstream_ == nullptr)
         {
-            return false;
+            throw std::invalid_argument("Upstream resource must not be null");
         }
 
-        // Check if pointer is within any of our chunks
-        for (const auto &chunk : chunks_)
+        // Pools start empty and grow on first use
+        for (size_t i = 0; i < kNumClasses; ++i)
         {
-            char *chunk_start = chunk.get();
-            char *chunk_end = chunk_start + (total_blocks_ * block_size_);
-            char *ptr_char = static_cast<char *>(ptr);
+            pools_[i] = std::make_unique<MemoryPool>(class_size(i), 0);
+        }
+    }
 
-            if (ptr_char >= chunk_start && ptr_char < chunk_end)
-            {
-                // Check alignment
-                size_t offset = ptr_char - chunk_start;
-                if (offset % block_size_ == offsetof(Block, data))
-                {
-                    return true;
-                }
-            }
+    size_t PoolResource::size_class(size_t bytes)
+    {
+        assert(bytes <= kMaxPooledSize);
+        if (bytes <= 128)
+        {
+            return (std::max<size_t>(bytes, 1) + 15) / 16 - 1;
+        }
+
+        // Four classes per power of two: (5..8) << shift
+        unsigned shift = static_cast<unsigned>(std::bit_width(bytes - 1)) - 3;
+        return 8 + 4 * (shift - 5) + ((bytes - 1) >> shift) - 4;
+    }
+
+    size_t PoolResource::class_size(size_t index)
+    {
+        if (index < 8)
+        {
+            return (index + 1) * 16;
+        }
+        size_t group = (index - 8) / 4;
+        return ((index - 8) % 4 + 5) << (group + 5);
+    }
+
+    void *PoolResource::do_allocate(size_t bytes, size_t alignment)
+    {
+        if (bytes > kMaxPooledSize || alignment > MemoryPool::kAlignment)
+        {
+            return upstream_->allocate(bytes, alignment);
+        }
+        return pools_[size_class(bytes)]->allocate();
+    }
+
+    void PoolResource::do_deallocate(void *ptr, size_t bytes, size_t alignment)
+    {
+        if (bytes > kMaxPooledSize || alignment > MemoryPool::kAlignment)
+        {
+            upstream_->deallocate(ptr, bytes, alignment);
+            return;
         }
+        pools_[size_class(bytes)]->deallocate(ptr);
+    }
 
-        return false;
+    bool PoolResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+    {
+        return this == &other;
     }
 
-} // namespace trading
\ No newline at end of file
+} // namespace trading
@@ -0,0 +1,691 @@
+#include "core/metrics.h"
+#include "external/json.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace trading
+{
+    namespace metrics
+    {
+        namespace
+        {
+            constexpr const char *kPrefix = "trading_";
+            constexpr std::pair<double, const char *> kQuantiles[] = {
+                {0.5, "0.5"}, {0.9, "0.9"}, {0.99, "0.99"}, {0.999, "0.999"}};
+
+            std::string format_number(double value)
+            {
+                std::ostringstream out;
+                out << std::setprecision(12) << value;
+                return out.str();
+            }
+
+            std::string with_labels(const std::string &name, const std::string &labels)
+            {
+                return labels.empty() ? name : name + "{" + labels + "}";
+            }
+        }
+
+        double nanoseconds_per_tick()
+        {
+#if defined(TRADING_METRICS_RDTSC) && defined(TRADING_METRICS)
+            static const double ratio = []
+            {
+                auto start = std::chrono::steady_clock::now();
+                uint64_t first = __rdtsc();
+                auto end = start;
+                while (end - start < std::chrono::milliseconds(10))
+                {
+                    end = std::chrono::steady_clock::now();
+                }
+                uint64_t last = __rdtsc();
+                return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(last - first);
+            }();
+            return ratio;
+#else
+            return 1.0;
+#endif
+        }
+
+        size_t next_thread_shard()
+        {
+            static std::atomic<size_t> next{0};
+            return next.fetch_add(1, std::memory_order_relaxed) % kMaxShards;
+        }
+
+        // HistogramSnapshot / MetricsSnapshot
+
+        double HistogramSnapshot::percentile(double quantile) const
+        {
+            if (count == 0)
+            {
+                return 0.0;
+            }
+
+            uint64_t rank = static_cast<uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(count)));
+            rank = std::max<uint64_t>(rank, 1);
+            uint64_t seen = 0;
+            for (const auto &[upper, bucket_count] : buckets)
+            {
+                seen += bucket_count;
+                if (seen >= rank)
+                {
+                    return std::clamp(upper, min, max);
+                }
+            }
+            return max;
+        }
+
+        const HistogramSnapshot *MetricsSnapshot::find_histogram(const std::string &name) const
+        {
+            for (const auto &histogram : histograms)
+            {
+                if (histogram.name == name)
+                {
+                    return &histogram;
+                }
+            }
+            return nullptr;
+        }
+
+        const ValueSnapshot *MetricsSnapshot::find_counter(const std::string &name) const
+        {
+            for (const auto &counter : counters)
+            {
+                if (counter.name == name)
+                {
+                    return &counter;
+                }
+            }
+            return nullptr;
+        }
+
+        const ValueSnapshot *MetricsSnapshot::find_gauge(const std::string &name, const std::string &labels) const
+        {
+            for (const auto &gauge : gauges)
+            {
+                if (gauge.name == name && (labels.empty() || gauge.labels == labels))
+                {
+                    return &gauge;
+                }
+            }
+            return nullptr;
+        }
+
+        // Counter
+
+        Counter::Counter(std::string name, std::string help)
+            : name_(std::move(name)), help_(std::move(help))
+        {
+            Registry::global().add(this);
+        }
+
+        Counter::~Counter()
+        {
+            Registry::global().remove(this);
+        }
+
+        uint64_t Counter::value() const
+        {
+            uint64_t total = 0;
+            for (const Cell &cell : cells_)
+            {
+                total += cell.value.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+        void Counter::reset()
+        {
+            for (Cell &cell : cells_)
+            {
+                cell.value.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        // Gauge
+
+        Gauge::Gauge(std::string name, std::string help)
+            : name_(std::move(name)), help_(std::move(help))
+        {
+            Registry::global().add(this);
+        }
+
+        Gauge::~Gauge()
+        {
+            Registry::global().remove(this);
+        }
+
+        int64_t Gauge::value() const
+        {
+            int64_t total = 0;
+            for (const Cell &cell : cells_)
+            {
+                total += cell.value.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+        // Histogram
+
+        Histogram::Histogram(std::string name, std::string help)
+            : name_(std::move(name)), help_(std::move(help))
+        {
+            Registry::global().add(this);
+        }
+
+        Histogram::~Histogram()
+        {
+            Registry::global().remove(this);
+            for (auto &shard : shards_)
+            {
+                delete shard.load(std::memory_order_relaxed);
+            }
+        }
+
+        size_t Histogram::bucket_index(uint64_t value)
+        {
+            if (value >> kMaxValueBits)
+            {
+                return kBuckets - 1;
+            }
+            // Below 2^(kSubBucketBits + 1) the index is the value itself;
+            // above, each power of two keeps its top kSubBucketBits + 1 bits
+            unsigned msb = 63 - static_cast<unsigned>(std::countl_zero(value | 1));
+            unsigned shift = msb > kSubBucketBits ? msb - kSubBucketBits : 0;
+            return (static_cast<size_t>(shift) << kSubBucketBits) + static_cast<size_t>(value >> shift);
+        }
+
+        uint64_t Histogram::bucket_upper_bound(size_t index)
+        {
+            if (index < (size_t(2) << kSubBucketBits))
+            {
+                return index;
+            }
+            unsigned shift = static_cast<unsigned>(index >> kSubBucketBits) - 1;
+            uint64_t mantissa = index - (static_cast<size_t>(shift) << kSubBucketBits);
+            return ((mantissa + 1) << shift) - 1;
+        }
+
+        void Histogram::Shard::record(uint64_t duration)
+        {
+            counts[bucket_index(duration)].fetch_add(1, std::memory_order_relaxed);
+            sum.fetch_add(duration, std::memory_order_relaxed);
+
+            // Only threads sharing a shard (more than kMaxShards of them) ever race here
+            uint64_t low = min.load(std::memory_order_relaxed);
+            while (duration < low && !min.compare_exchange_weak(low, duration, std::memory_order_relaxed))
+            {
+            }
+            uint64_t high = max.load(std::memory_order_relaxed);
+            while (duration > high && !max.compare_exchange_weak(high, duration, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        Histogram::Shard &Histogram::create_shard(size_t index)
+        {
+            auto shard = std::make_unique<Shard>();
+            Shard *expected = nullptr;
+            if (shards_[index].compare_exchange_strong(expected, shard.get(), std::memory_order_acq_rel))
+            {
+                return *shard.release();
+            }
+            return *expected; // Another thread on the same shard got there first
+        }
+
+        HistogramSnapshot Histogram::snapshot() const
+        {
+            HistogramSnapshot result;
+            result.name = name_;
+            result.help = help_;
+
+            std::vector<uint64_t> counts(kBuckets, 0);
+            uint64_t sum = 0;
+            uint64_t low = UINT64_MAX;
+            uint64_t high = 0;
+            for (const auto &slot : shards_)
+            {
+                const Shard *shard = slot.load(std::memory_order_acquire);
+                if (!shard)
+                {
+                    continue;
+                }
+                for (size_t i = 0; i < kBuckets; ++i)
+                {
+                    counts[i] += shard->counts[i].load(std::memory_order_relaxed);
+                }
+                sum += shard->sum.load(std::memory_order_relaxed);
+                low = std::min(low, shard->min.load(std::memory_order_relaxed));
+                high = std::max(high, shard->max.load(std::memory_order_relaxed));
+            }
+
+            const double scale = nanoseconds_per_tick();
+            for (size_t i = 0; i < kBuckets; ++i)
+            {
+                if (counts[i] > 0)
+                {
+                    result.count += counts[i];
+                    result.buckets.emplace_back(static_cast<double>(bucket_upper_bound(i)) * scale, counts[i]);
+                }
+            }
+            if (result.count > 0)
+            {
+                result.sum = static_cast<double>(sum) * scale;
+                result.min = static_cast<double>(low) * scale;
+                result.max = static_cast<double>(high) * scale;
+            }
+            return result;
+        }
+
+        void Histogram::reset()
+        {
+            for (auto &slot : shards_)
+            {
+                Shard *shard = slot.load(std::memory_order_acquire);
+                if (!shard)
+                {
+                    continue;
+                }
+                for (auto &count : shard->counts)
+                {
+                    count.store(0, std::memory_order_relaxed);
+                }
+                shard->sum.store(0, std::memory_order_relaxed);
+                shard->min.store(UINT64_MAX, std::memory_order_relaxed);
+                shard->max.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        // GaugeCallback
+
+        GaugeCallback::GaugeCallback(std::string name, std::string help, std::string labels, std::function<double()> read)
+            : id_(Registry::global().add_callback(ValueSnapshot{std::move(name), std::move(help), std::move(labels), 0.0},
+                                                  std::move(read)))
+        {
+        }
+
+        GaugeCallback::~GaugeCallback()
+        {
+            if (id_ != 0)
+            {
+                Registry::global().remove_callback(id_);
+            }
+        }
+
+        GaugeCallback &GaugeCallback::operator=(GaugeCallback &&other) noexcept
+        {
+            if (this != &other)
+            {
+                if (id_ != 0)
+                {
+                    Registry::global().remove_callback(id_);
+                }
+                id_ = std::exchange(other.id_, 0);
+            }
+            return *this;
+        }
+
+        // Registry
+
+        Registry &Registry::global()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        MetricsSnapshot Registry::snapshot() const
+        {
+            MetricsSnapshot result;
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            for (const Counter *counter : counters_)
+            {
+                result.counters.push_back(
+                    ValueSnapshot{counter->name(), counter->help(), "", static_cast<double>(counter->value())});
+            }
+            for (const Gauge *gauge : gauges_)
+            {
+                result.gauges.push_back(ValueSnapshot{gauge->name(), gauge->help(), "", static_cast<double>(gauge->value())});
+            }
+            for (const Callback &callback : callbacks_)
+            {
+                ValueSnapshot value = callback.description;
+                value.value = callback.read();
+                result.gauges.push_back(std::move(value));
+            }
+            for (const Histogram *histogram : histograms_)
+            {
+                result.histograms.push_back(histogram->snapshot());
+            }
+
+            // Same-named metrics side by side, as the text format requires
+            auto by_name = [](const auto &a, const auto &b)
+            { return a.name < b.name; };
+            std::stable_sort(result.counters.begin(), result.counters.end(), by_name);
+            std::stable_sort(result.gauges.begin(), result.gauges.end(), by_name);
+            std::stable_sort(result.histograms.begin(), result.histograms.end(), by_name);
+            return result;
+        }
+
+        void Registry::reset()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (Counter *counter : counters_)
+            {
+                counter->reset();
+            }
+            for (Histogram *histogram : histograms_)
+            {
+                histogram->reset();
+            }
+        }
+
+        void Registry::add(Counter *counter)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            counters_.push_back(counter);
+        }
+
+        void Registry::remove(Counter *counter)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            counters_.erase(std::remove(counters_.begin(), counters_.end(), counter), counters_.end());
+        }
+
+        void Registry::add(Gauge *gauge)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            gauges_.push_back(gauge);
+        }
+
+        void Registry::remove(Gauge *gauge)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            gauges_.erase(std::remove(gauges_.begin(), gauges_.end(), gauge), gauges_.end());
+        }
+
+        void Registry::add(Histogram *histogram)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            histograms_.push_back(histogram);
+        }
+
+        void Registry::remove(Histogram *histogram)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            histograms_.erase(std::remove(histograms_.begin(), histograms_.end(), histogram), histograms_.end());
+        }
+
+        uint64_t Registry::add_callback(ValueSnapshot description, std::function<double()> read)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            uint64_t id = next_callback_id_++;
+            callbacks_.push_back(Callback{id, std::move(description), std::move(read)});
+            return id;
+        }
+
+        void Registry::remove_callback(uint64_t id)
+        {
+            // Taking the lock also waits out a snapshot that is running the callback
+            std::lock_guard<std::mutex> lock(mutex_);
+            callbacks_.erase(std::remove_if(callbacks_.begin(), callbacks_.end(), [id](const Callback &callback)
+                                            { return callback.id == id; }),
+                             callbacks_.end());
+        }
+
+        // Exposition formats
+
+        std::string to_prometheus(const MetricsSnapshot &snapshot)
+        {
+            std::ostringstream out;
+            auto header = [&out](const std::string &name, const std::string &help, const char *type)
+            {
+                out << "# HELP " << name << " " << help << "\n";
+                out << "# TYPE " << name << " " << type << "\n";
+            };
+
+            const std::string *previous = nullptr;
+            for (const auto &counter : snapshot.counters)
+            {
+                std::string name = kPrefix + counter.name;
+                header(name, counter.help, "counter");
+                out << with_labels(name, counter.labels) << " " << format_number(counter.value) << "\n";
+            }
+            for (const auto &gauge : snapshot.gauges)
+            {
+                std::string name = kPrefix + gauge.name;
+                if (!previous || *previous != gauge.name)
+                {
+                    header(name, gauge.help, "gauge");
+                }
+                previous = &gauge.name;
+                out << with_labels(name, gauge.labels) << " " << format_number(gauge.value) << "\n";
+            }
+            for (const auto &histogram : snapshot.histograms)
+            {
+                std::string name = kPrefix + histogram.name;
+                header(name, histogram.help, "summary");
+                for (const auto &[quantile, label] : kQuantiles)
+                {
+                    out << name << "{quantile=\"" << label << "\"} "
+                        << format_number(histogram.percentile(quantile) * 1e-9) << "\n";
+                }
+                out << name << "_sum " << format_number(histogram.sum * 1e-9) << "\n";
+                out << name << "_count " << histogram.count << "\n";
+                header(name + "_max", "Largest value of " + name, "gauge");
+                out << name << "_max " << format_number(histogram.max * 1e-9) << "\n";
+            }
+            return out.str();
+        }
+
+        std::string to_json(const MetricsSnapshot &snapshot)
+        {
+            using json = nlohmann::json;
+            auto values = [](const std::vector<ValueSnapshot> &items)
+            {
+                json list = json::array();
+                for (const auto &item : items)
+                {
+                    json entry{{"name", item.name}, {"help", item.help}, {"value", item.value}};
+                    if (!item.labels.empty())
+                    {
+                        entry["labels"] = item.labels;
+                    }
+                    list.push_back(std::move(entry));
+                }
+                return list;
+            };
+
+            json histograms = json::array();
+            for (const auto &histogram : snapshot.histograms)
+            {
+                json buckets = json::array();
+                for (const auto &[upper, count] : histogram.buckets)
+                {
+                    buckets.push_back(json::array({upper, count}));
+                }
+                histograms.push_back(json{{"name", histogram.name},
+                                          {"help", histogram.help},
+                                          {"count", histogram.count},
+                                          {"mean_ns", histogram.mean()},
+                                          {"min_ns", histogram.min},
+                                          {"max_ns", histogram.max},
+                                          {"p50_ns", histogram.percentile(0.5)},
+                                          {"p90_ns", histogram.percentile(0.9)},
+                                          {"p99_ns", histogram.percentile(0.99)},
+                                          {"p999_ns", histogram.percentile(0.999)},
+                                          {"buckets", std::move(buckets)}});
+            }
+
+            json document{{"counters", values(snapshot.counters)},
+                          {"gauges", values(snapshot.gauges)},
+                          {"histograms", std::move(histograms)}};
+            return document.dump(2);
+        }
+
+        // MetricsServer
+
+#if !defined(_WIN32)
+        MetricsServer::MetricsServer(uint16_t port, const std::string &address)
+        {
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(port);
+            if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1)
+            {
+                throw std::runtime_error("Invalid metrics server address " + address);
+            }
+
+            listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+            if (listen_fd_ < 0)
+            {
+                throw std::runtime_error("Failed to create metrics server socket");
+            }
+            int reuse = 1;
+            setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+            socklen_t length = sizeof(addr);
+            if (::bind(listen_fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || ::listen(listen_fd_, 16) != 0 ||
+                ::getsockname(listen_fd_, reinterpret_cast<sockaddr *>(&addr), &length) != 0)
+            {
+                ::close(listen_fd_);
+                throw std::runtime_error("Failed to listen on " + address + ":" + std::to_string(port));
+            }
+            port_ = ntohs(addr.sin_port);
+
+            thread_ = std::thread(&MetricsServer::serve, this);
+        }
+
+        MetricsServer::~MetricsServer()
+        {
+            stop_ = true;
+            if (thread_.joinable())
+            {
+                thread_.join();
+            }
+            ::close(listen_fd_);
+        }
+
+        void MetricsServer::serve()
+        {
+            while (!stop_)
+            {
+                // Wake up regularly to notice stop_
+                pollfd listener{listen_fd_, POLLIN, 0};
+                if (::poll(&listener, 1, 100) <= 0)
+                {
+                    continue;
+                }
+                int client = ::accept(listen_fd_, nullptr, nullptr);
+                if (client < 0)
+                {
+                    continue;
+                }
+                handle(client);
+                ::close(client);
+            }
+        }
+
+        void MetricsServer::handle(int client)
+        {
+            // A client that stalls cannot hold the endpoint for long
+            timeval timeout{1, 0};
+            setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+            std::string request;
+            char buffer[1024];
+            while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192)
+            {
+                ssize_t received = ::recv(client, buffer, sizeof(buffer), 0);
+                if (received <= 0)
+                {
+                    break;
+                }
+                request.append(buffer, static_cast<size_t>(received));
+            }
+
+            // Request line: METHOD SP target SP version
+            std::istringstream line(request.substr(0, request.find("\r\n")));
+            std::string method, target;
+            line >> method >> target;
+            std::string path = target.substr(0, target.find('?'));
+
+            std::string status = "200 OK";
+            std::string content_type;
+            std::string body;
+            if (method != "GET")
+            {
+                status = "405 Method Not Allowed";
+            }
+            else if (path == "/metrics")
+            {
+                content_type = "text/plain; version=0.0.4";
+                body = to_prometheus(Registry::global().snapshot());
+            }
+            else if (path == "/metrics.json")
+            {
+                content_type = "application/json";
+                body = to_json(Registry::global().snapshot());
+            }
+            else
+            {
+                status = "404 Not Found";
+            }
+            if (content_type.empty())
+            {
+                content_type = "text/plain";
+                body = status + "\n";
+            }
+
+            std::string response = "HTTP/1.1 " + status + "\r\nContent-Type: " + content_type +
+                                   "\r\nContent-Length: " + std::to_string(body.size()) +
+                                   "\r\nConnection: close\r\n\r\n" + body;
+            for (size_t sent = 0; sent < response.size();)
+            {
+                ssize_t written = ::send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+                if (written <= 0)
+                {
+                    return;
+                }
+                sent += static_cast<size_t>(written);
+            }
+            requests_.fetch_add(1, std::memory_order_relaxed);
+        }
+#else
+        MetricsServer::MetricsServer(uint16_t port, const std::string &address)
+        {
+            (void)port;
+            (void)address;
+            throw std::runtime_error("MetricsServer needs POSIX sockets");
+        }
+
+        MetricsServer::~MetricsServer() = default;
+
+        void MetricsServer::serve()
+        {
+        }
+
+        void MetricsServer::handle(int client)
+        {
+            (void)client;
+        }
+#endif
+
+    } // namespace metrics
+} // namespace trading
@@ -1,148 +1,791 @@
 #include "core/thread_pool.h"
 #include <algorithm>
 #include <stdexcept>
+#include <latch>
+#include <map>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <cctype>
+#include <chrono>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace trading
 {
-
-    ThreadPool::ThreadPool(size_t num_threads) : stop_(false)
+    namespace
     {
-        // If no threads specified, use number of CPU cores
-        if (num_threads == 0)
+        // Identifies the pool and deque of the current worker thread
+        thread_local const ThreadPool *current_pool = nullptr;
+        thread_local size_t current_index = ThreadPool::npos;
+
+        // Shared by every pool; queue depths are per pool (see start_threads)
+        struct PoolMetrics
+        {
+            metrics::Histogram queue_wait{"threadpool_queue_wait_seconds", "Time tasks wait in a worker queue"};
+            metrics::Histogram run_time{"threadpool_task_run_seconds", "Time tasks take to run"};
+            metrics::Histogram background_wait{"threadpool_background_queue_wait_seconds",
+                                               "Time background tasks wait in the background queue"};
+            metrics::Histogram background_run_time{"threadpool_background_task_run_seconds",
+                                                   "Time background tasks take to run"};
+            metrics::Counter tasks{"threadpool_tasks_total", "Tasks run"};
+            metrics::Counter steals{"threadpool_steals_total", "Tasks taken from another worker's queue"};
+        };
+
+        PoolMetrics &pool_metrics()
+        {
+            static PoolMetrics instance;
+            return instance;
+        }
+
+        std::atomic<size_t> next_pool_id{0};
+
+        // Parse a sysfs CPU list such as "0-3,8,10-11"
+        std::vector<int> parse_cpu_list(const std::string &list)
+        {
+            std::vector<int> cpus;
+            std::stringstream stream(list);
+            std::string range;
+            while (std::getline(stream, range, ','))
+            {
+                if (range.empty() || range == "\n")
+                {
+                    continue;
+                }
+                size_t dash = range.find('-');
+                int first = std::stoi(range.substr(0, dash));
+                int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                for (int cpu = first; cpu <= last; ++cpu)
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+            return cpus;
+        }
+
+        // CPUs this process may run on
+        std::vector<int> allowed_cpus()
+        {
+            std::vector<int> cpus;
+#ifdef __linux__
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (sched_getaffinity(0, sizeof(set), &set) == 0)
+            {
+                for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                {
+                    if (CPU_ISSET(cpu, &set))
+                    {
+                        cpus.push_back(cpu);
+                    }
+                }
+            }
+#endif
+            return cpus;
+        }
+
+        // CPU -> NUMA node, from sysfs; empty when the topology is unknown
+        std::map<int, int> numa_nodes()
+        {
+            std::map<int, int> node_of;
+#ifdef __linux__
+            std::error_code ec;
+            for (const auto &entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec))
+            {
+                std::string name = entry.path().filename().string();
+                if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+                    !std::all_of(name.begin() + 4, name.end(), ::isdigit))
+                {
+                    continue;
+                }
+
+                std::ifstream file(entry.path() / "cpulist");
+                std::string list;
+                if (std::getline(file, list))
+                {
+                    for (int cpu : parse_cpu_list(list))
+                    {
+                        node_of[cpu] = std::stoi(name.substr(4));
+                    }
+                }
+            }
+#endif
+            return node_of;
+        }
+
+        void pin_current_thread(const std::vector<int> &cpus)
         {
-            num_threads = std::thread::hardware_concurrency();
-            if (num_threads == 0)
+#ifdef __linux__
+            if (cpus.empty())
             {
-                num_threads = 4; // Fallback to 4 threads
+                return;
             }
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu : cpus)
+            {
+                CPU_SET(cpu, &set);
+            }
+            // Best effort: a CPU outside our cgroup just leaves the thread unpinned
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+            (void)cpus;
+#endif
         }
 
-        // Create worker threads
-        workers_.reserve(num_threads);
-        for (size_t i = 0; i < num_threads; ++i)
+        void lower_current_thread_priority()
         {
-            workers_.emplace_back(&ThreadPool::worker_function, this);
+#ifdef __linux__
+            // Linux applies nice values per thread
+            setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10);
+#endif
         }
     }
 
-    ThreadPool::~ThreadPool()
+    struct alignas(64) ThreadPool::Worker
     {
-        shutdown();
+        std::mutex mutex;
+        std::deque<QueuedTask> tasks;        // Owner pops the front, thieves the back
+        std::deque<QueuedTask> pinned;       // on_each_worker() tasks; never stolen
+        std::atomic<size_t> pinned_count{0}; // Read without the lock while sleeping
+        std::vector<size_t> steal_order;     // Same NUMA node first
+        int numa_node = -1;
+    };
+
+    struct ThreadPool::Placement
+    {
+        std::vector<int> cpus; // Empty: not pinned
+        int numa_node = -1;
+        std::vector<size_t> steal_order;
+    };
+
+    ThreadPool::ThreadPool(size_t num_threads)
+    {
+        ThreadPoolConfig config;
+        config.num_threads = num_threads;
+        start_threads(config);
     }
 
-    ThreadPool::ThreadPool(ThreadPool &&other) noexcept
-        : workers_(std::move(other.workers_)), tasks_(std::move(other.tasks_)), stop_(other.stop_.load()), active_tasks_(other.active_tasks_.load()), completed_tasks_(other.completed_tasks_.load())
+    ThreadPool::ThreadPool(const ThreadPoolConfig &config)
+    {
+        start_threads(config);
+    }
+
+    ThreadPool::~ThreadPool()
     {
-        other.stop_.store(true);
+        shutdown();
     }
 
-    ThreadPool &ThreadPool::operator=(ThreadPool &&other) noexcept
+    void ThreadPool::start_threads(const ThreadPoolConfig &config)
     {
-        if (this != &other)
+        // If no threads specified, use number of CPU cores
+        num_workers_ = config.num_threads;
+        if (num_workers_ == 0)
+        {
+            num_workers_ = std::thread::hardware_concurrency();
+            if (num_workers_ == 0)
+            {
+                num_workers_ = 4; // Fallback to 4 threads
+            }
+        }
+        num_background_ = config.num_background_threads;
+
+        // Work out where each worker goes
+        std::vector<int> cpus = config.cpus.empty() ? allowed_cpus() : config.cpus;
+        std::map<int, int> node_of = config.affinity == AffinityMode::NONE ? std::map<int, int>{} : numa_nodes();
+        auto node_for = [&](int cpu)
         {
-            shutdown();
+            auto it = node_of.find(cpu);
+            return it == node_of.end() ? -1 : it->second;
+        };
 
-            workers_ = std::move(other.workers_);
-            tasks_ = std::move(other.tasks_);
-            stop_ = other.stop_.load();
-            active_tasks_ = other.active_tasks_.load();
-            completed_tasks_ = other.completed_tasks_.load();
+        std::vector<Placement> placements(num_workers_);
+        if (config.affinity == AffinityMode::CORE && !cpus.empty())
+        {
+            for (size_t i = 0; i < num_workers_; ++i)
+            {
+                int cpu = cpus[i % cpus.size()];
+                placements[i].cpus = {cpu};
+                placements[i].numa_node = node_for(cpu);
+            }
+        }
+        else if (config.affinity == AffinityMode::NUMA_NODE && !cpus.empty())
+        {
+            // Group the CPUs by node; unknown topology is one node
+            std::map<int, std::vector<int>> by_node;
+            for (int cpu : cpus)
+            {
+                by_node[node_for(cpu)].push_back(cpu);
+            }
+            std::vector<std::pair<int, std::vector<int>>> nodes(by_node.begin(), by_node.end());
 
-            other.stop_.store(true);
+            // Contiguous blocks, so neighbouring workers share a node
+            for (size_t i = 0; i < num_workers_; ++i)
+            {
+                const auto &node = nodes[i * nodes.size() / num_workers_];
+                placements[i].cpus = node.second;
+                placements[i].numa_node = node.first;
+            }
         }
-        return *this;
+
+        for (size_t i = 0; i < num_workers_; ++i)
+        {
+            auto &order = placements[i].steal_order;
+            for (size_t offset = 1; offset < num_workers_; ++offset)
+            {
+                order.push_back((i + offset) % num_workers_);
+            }
+            std::stable_partition(order.begin(), order.end(), [&](size_t other)
+                                  { return placements[other].numa_node == placements[i].numa_node; });
+        }
+
+        // Create worker threads; each allocates its own queue once pinned
+        workers_.resize(num_workers_);
+        threads_.reserve(num_workers_ + num_background_);
+        // Shared so a late notify from the last arrival never outlives it
+        auto started = std::make_shared<std::latch>(static_cast<std::ptrdiff_t>(num_workers_) + 1);
+        for (size_t i = 0; i < num_workers_; ++i)
+        {
+            threads_.emplace_back([this, i, placement = placements[i], started]()
+                                  {
+                pin_current_thread(placement.cpus);
+                auto worker = std::make_unique<Worker>();
+                worker->numa_node = placement.numa_node;
+                worker->steal_order = placement.steal_order;
+                workers_[i] = std::move(worker);
+
+                // Workers steal from each other, so all queues must exist first
+                started->arrive_and_wait();
+                worker_function(i); });
+        }
+        started->arrive_and_wait();
+
+        for (size_t i = 0; i < num_background_; ++i)
+        {
+            threads_.emplace_back([this, lower = config.lower_background_priority]()
+                                  {
+                if (lower)
+                {
+                    lower_current_thread_priority();
+                }
+                background_function(); });
+        }
+
+        std::string labels = "pool=\"" + std::to_string(next_pool_id.fetch_add(1)) + "\"";
+        gauges_.emplace_back("threadpool_pending_tasks", "Tasks queued on the workers, not yet taken", labels,
+                             [this]
+                             { return static_cast<double>(pending_.load(std::memory_order_relaxed)); });
+        gauges_.emplace_back("threadpool_background_pending_tasks", "Tasks queued on the background lane", labels,
+                             [this]
+                             { return static_cast<double>(background_pending_.load(std::memory_order_relaxed)); });
+        gauges_.emplace_back("threadpool_sleeping_workers", "Workers waiting for tasks", labels, [this]
+                             { return static_cast<double>(sleepers_.load(std::memory_order_relaxed)); });
     }
 
     size_t ThreadPool::pending_tasks() const
     {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        return tasks_.size();
+        return pending_.load() + background_pending_.load();
+    }
+
+    size_t ThreadPool::worker_index() const
+    {
+        return current_pool == this ? current_index : npos;
+    }
+
+    int ThreadPool::worker_numa_node(size_t worker) const
+    {
+        return worker < num_workers_ ? workers_[worker]->numa_node : -1;
     }
 
     void ThreadPool::wait_all()
     {
-        // Wait until all tasks are completed
-        while (true)
+        // A task waiting for itself to finish would never return
+        if (current_pool == this)
         {
-            {
-                std::lock_guard<std::mutex> lock(queue_mutex_);
-                if (tasks_.empty() && active_tasks_.load() == 0)
-                {
-                    break;
-                }
-            }
-            std::this_thread::yield();
+            throw std::logic_error("wait_all called from a ThreadPool task");
         }
+
+        std::unique_lock<std::mutex> lock(done_mutex_);
+        done_condition_.wait(lock, [this]
+                             { return unfinished_.load() == 0; });
     }
 
     void ThreadPool::shutdown()
     {
         {
-            std::lock_guard<std::mutex> lock(queue_mutex_);
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
             stop_ = true;
+            if (joined_)
+            {
+                return;
+            }
+            joined_ = true;
         }
 
         // Notify all waiting threads
-        condition_.notify_all();
+        sleep_condition_.notify_all();
+        {
+            std::lock_guard<std::mutex> lock(background_mutex_);
+        }
+        background_condition_.notify_all();
 
         // Wait for all threads to finish
-        for (auto &worker : workers_)
+        for (auto &thread : threads_)
         {
-            if (worker.joinable())
+            if (thread.joinable())
             {
-                worker.join();
+                thread.join();
             }
         }
+    }
 
-        workers_.clear();
+    void ThreadPool::enqueue(Task task)
+    {
+        admit(1, &pending_);
+
+        // Workers keep their own tasks local; other threads spread them out
+        size_t self = worker_index();
+        push(self != npos ? self : next_queue_.fetch_add(1, std::memory_order_relaxed) % num_workers_,
+             std::move(task));
+        wake(1);
+    }
+
+    void ThreadPool::enqueue_batch(std::vector<Task> &tasks)
+    {
+        if (tasks.empty())
+        {
+            return;
+        }
+
+        const size_t count = tasks.size();
+        admit(count, &pending_);
+
+        // Deal the batch out in contiguous runs, one lock per deque
+        size_t self = worker_index();
+        size_t first = self != npos ? self : next_queue_.fetch_add(1, std::memory_order_relaxed);
+        size_t per_queue = (count + num_workers_ - 1) / num_workers_;
+        const uint64_t now = metrics::ticks();
+        for (size_t q = 0, begin = 0; begin < count; ++q, begin += per_queue)
+        {
+            Worker &worker = *workers_[(first + q) % num_workers_];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            for (size_t i = begin; i < std::min(count, begin + per_queue); ++i)
+            {
+                worker.tasks.push_back(QueuedTask{std::move(tasks[i]), now});
+            }
+        }
+        tasks.clear();
+
+        wake(count);
     }
 
-    void ThreadPool::worker_function()
+    void ThreadPool::enqueue_background(Task task)
     {
+        admit(1, &background_pending_);
+        {
+            std::lock_guard<std::mutex> lock(background_mutex_);
+            background_.push_back(QueuedTask{std::move(task), metrics::ticks(), true});
+        }
+
+        if (num_background_ > 0)
+        {
+            background_condition_.notify_one();
+        }
+        else
+        {
+            wake(1);
+        }
+    }
+
+    void ThreadPool::admit(size_t count, std::atomic<size_t> *queued)
+    {
+        // Count the tasks before checking stop_: a worker that sees stop_
+        // then also sees them and stays until they have run
+        unfinished_.fetch_add(count);
+        if (queued)
+        {
+            queued->fetch_add(count);
+        }
+        if (stop_)
+        {
+            if (queued)
+            {
+                queued->fetch_sub(count);
+            }
+            if (unfinished_.fetch_sub(count) == count)
+            {
+                std::lock_guard<std::mutex> lock(done_mutex_);
+                done_condition_.notify_all();
+            }
+            throw std::runtime_error("submit on stopped ThreadPool");
+        }
+    }
+
+    void ThreadPool::push(size_t queue, Task task)
+    {
+        Worker &worker = *workers_[queue];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(QueuedTask{std::move(task), metrics::ticks()});
+    }
+
+    void ThreadPool::wake(size_t count)
+    {
+        if (sleepers_.load() == 0)
+        {
+            return;
+        }
+
+        // Taking the lock orders this wake-up after a sleeper's last check
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+        }
+        if (count == 1)
+        {
+            sleep_condition_.notify_one();
+        }
+        else
+        {
+            sleep_condition_.notify_all();
+        }
+    }
+
+    void ThreadPool::worker_function(size_t index)
+    {
+        current_pool = this;
+        current_index = index;
+
         while (true)
         {
-            std::function<void()> task;
+            QueuedTask task;
+            if (try_pop(index, task))
+            {
+                run(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            sleepers_.fetch_add(1);
+
+            // Wait for a task or shutdown signal
+            sleep_condition_.wait(lock, [&]
+                                  { return stop_ || has_work(index); });
+            sleepers_.fetch_sub(1);
 
+            // If shutting down and no tasks, exit
+            if (stop_ && !has_work(index))
             {
-                std::unique_lock<std::mutex> lock(queue_mutex_);
+                return;
+            }
+        }
+    }
 
-                // Wait for a task or shutdown signal
-                condition_.wait(lock, [this]
-                                { return stop_ || !tasks_.empty(); });
+    void ThreadPool::background_function()
+    {
+        while (true)
+        {
+            QueuedTask task;
+            {
+                std::unique_lock<std::mutex> lock(background_mutex_);
+                background_condition_.wait(lock, [this]
+                                           { return stop_ || !background_.empty(); });
 
-                // If shutting down and no tasks, exit
-                if (stop_ && tasks_.empty())
+                // Queued background work still runs on shutdown
+                if (background_.empty())
                 {
                     return;
                 }
+                task = std::move(background_.front());
+                background_.pop_front();
+                background_pending_.fetch_sub(1);
+            }
+            run(task);
+        }
+    }
+
+    bool ThreadPool::has_work(size_t index) const
+    {
+        return pending_.load() > 0 || workers_[index]->pinned_count.load() > 0 ||
+               (num_background_ == 0 && background_pending_.load() > 0);
+    }
+
+    bool ThreadPool::try_pop(size_t index, QueuedTask &task)
+    {
+        Worker &own = *workers_[index];
+        {
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.pinned.empty())
+            {
+                task = std::move(own.pinned.front());
+                own.pinned.pop_front();
+                own.pinned_count.fetch_sub(1);
+                return true;
+            }
+            if (!own.tasks.empty())
+            {
+                task = std::move(own.tasks.front());
+                own.tasks.pop_front();
+                pending_.fetch_sub(1);
+                return true;
+            }
+        }
+
+        // Steal, nearest workers first; skip busy deques on the first pass
+        for (bool wait : {false, true})
+        {
+            for (size_t other : own.steal_order)
+            {
+                Worker &victim = *workers_[other];
+                std::unique_lock<std::mutex> lock(victim.mutex, std::defer_lock);
+                if (wait)
+                {
+                    lock.lock();
+                }
+                else if (!lock.try_lock())
+                {
+                    continue;
+                }
+
+                if (!victim.tasks.empty())
+                {
+                    task = std::move(victim.tasks.back());
+                    victim.tasks.pop_back();
+                    pending_.fetch_sub(1);
+                    pool_metrics().steals.add();
+                    return true;
+                }
+            }
+        }
+
+        // Background work only when nothing else is queued
+        if (num_background_ == 0 && background_pending_.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(background_mutex_);
+            if (!background_.empty())
+            {
+                task = std::move(background_.front());
+                background_.pop_front();
+                background_pending_.fetch_sub(1);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ThreadPool::run(QueuedTask &task)
+    {
+        PoolMetrics &stats = pool_metrics();
+        const uint64_t start = metrics::ticks();
+        (task.background ? stats.background_wait : stats.queue_wait).record(start - task.queued_at);
+
+        try
+        {
+            task.task();
+        }
+        catch (...)
+        {
+            // Tasks from submit() route exceptions to their future; anything
+            // else escaping a task is dropped so the worker keeps running
+        }
+        task.task.reset();
+
+        (task.background ? stats.background_run_time : stats.run_time).record(metrics::ticks() - start);
+        stats.tasks.add();
+
+        if (unfinished_.fetch_sub(1) == 1)
+        {
+            std::lock_guard<std::mutex> lock(done_mutex_);
+            done_condition_.notify_all();
+        }
+    }
+
+    void ThreadPool::on_each_worker(const std::function<void(size_t)> &task)
+    {
+        struct State
+        {
+            std::atomic<size_t> remaining{0};
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
 
-                // Get the next task
-                if (!tasks_.empty())
+        auto state = std::make_shared<State>();
+        state->remaining = num_workers_;
+
+        auto run_one = [&task, state](size_t worker)
+        {
+            try
+            {
+                task(worker);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->error)
                 {
-                    task = std::move(tasks_.front());
-                    tasks_.pop();
+                    state->error = std::current_exception();
                 }
             }
 
-            // Execute the task
-            if (task)
+            if (state->remaining.fetch_sub(1) == 1)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finished.notify_all();
+            }
+        };
+
+        // Queue on every other worker's private deque
+        size_t self = worker_index();
+        for (size_t i = 0; i < num_workers_; ++i)
+        {
+            if (i == self)
             {
-                active_tasks_.fetch_add(1);
+                continue;
+            }
+
+            admit(1, nullptr);
+            Worker &worker = *workers_[i];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.pinned.push_back(QueuedTask{Task([run_one, i]()
+                                                    { run_one(i); }),
+                                               metrics::ticks()});
+            worker.pinned_count.fetch_add(1);
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+        }
+        sleep_condition_.notify_all();
 
-                try
+        if (self == npos)
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->finished.wait(lock, [&]
+                                 { return state->remaining.load() == 0; });
+        }
+        else
+        {
+            // A worker calling this runs its own share inline, then keeps
+            // serving its pinned queue while it waits: another worker in
+            // on_each_worker at the same time is waiting on a task there
+            run_one(self);
+            Worker &own = *workers_[self];
+            while (state->remaining.load() != 0)
+            {
+                QueuedTask pinned;
+                bool found = false;
                 {
-                    task();
+                    std::lock_guard<std::mutex> lock(own.mutex);
+                    if (!own.pinned.empty())
+                    {
+                        pinned = std::move(own.pinned.front());
+                        own.pinned.pop_front();
+                        own.pinned_count.fetch_sub(1);
+                        found = true;
+                    }
                 }
-                catch (...)
+                if (found)
                 {
-                    // Log error in production code
-                    // For now, just continue
+                    run(pinned);
+                    continue;
                 }
 
-                active_tasks_.fetch_sub(1);
-                completed_tasks_.fetch_add(1);
+                // Pushing a pinned task does not signal state->finished, so poll
+                std::unique_lock<std::mutex> lock(state->mutex);
+                state->finished.wait_for(lock, std::chrono::microseconds(200), [&]
+                                         { return state->remaining.load() == 0 || own.pinned_count.load() > 0; });
             }
         }
+
+        if (state->error)
+        {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+    void ThreadPool::parallel_chunks(size_t num_chunks, const std::function<void(size_t)> &chunk_body)
+    {
+        // Helpers may start after the loop is over, so they only touch this
+        // shared state until they have claimed a chunk
+        struct State
+        {
+            std::atomic<size_t> next{0};
+            std::atomic<size_t> done{0};
+            size_t num_chunks = 0;
+            const std::function<void(size_t)> *body = nullptr;
+            std::atomic<bool> failed{false};
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+
+        auto state = std::make_shared<State>();
+        state->num_chunks = num_chunks;
+        state->body = &chunk_body;
+
+        auto work = [](State &s)
+        {
+            size_t chunk;
+            while ((chunk = s.next.fetch_add(1)) < s.num_chunks)
+            {
+                if (!s.failed.load(std::memory_order_relaxed))
+                {
+                    try
+                    {
+                        (*s.body)(chunk);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(s.mutex);
+                        if (!s.error)
+                        {
+                            s.error = std::current_exception();
+                        }
+                        s.failed = true;
+                    }
+                }
+
+                if (s.done.fetch_add(1) + 1 == s.num_chunks)
+                {
+                    std::lock_guard<std::mutex> lock(s.mutex);
+                    s.finished.notify_all();
+                }
+            }
+        };
+
+        // One helper per worker at most; the caller is a participant too
+        size_t helpers = std::min(num_workers_, num_chunks - 1);
+        if (helpers > 0)
+        {
+            std::vector<Task> tasks;
+            tasks.reserve(helpers);
+            for (size_t i = 0; i < helpers; ++i)
+            {
+                tasks.emplace_back([state, work]()
+                                   { work(*state); });
+            }
+            enqueue_batch(tasks);
+        }
+
+        work(*state);
+
+        // Chunks still running elsewhere are being executed, not queued,
+        // so waiting for them cannot deadlock
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->finished.wait(lock, [&]
+                                 { return state->done.load() == num_chunks; });
+        }
+
+        if (state->error)
+        {
+            std::rethrow_exception(state->error);
+        }
     }
 
-} // namespace trading
\ No newline at end of file
+} // namespace trading
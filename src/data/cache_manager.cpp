@@ -1,9 +1,12 @@
 #include "data/cache_manager.h"
+#include "core/metrics.h"
 #include "external/json.hpp"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <deque>
 #include <filesystem>
+#include <functional>
 #include <stdexcept>
 #include <iostream>
 
@@ -11,18 +14,74 @@ using json = nlohmann::json;
 
 namespace trading
 {
-    CacheManager::CacheManager(size_t max_memory_mb, const std::string &cache_dir)
-        : max_memory_bytes_(max_memory_mb * 1024 * 1024), current_memory_bytes_(0), cache_dir_(cache_dir), thread_pool_(nullptr)
+    namespace
     {
-        // Create cache directory if it doesn't exist
-        std::filesystem::create_directories(cache_dir_);
+        int64_t steady_now_ns()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
 
-        // Load existing cache metadata
-        load_cache_metadata();
+        // Process-wide rather than per cache: a CacheManager can be moved,
+        // and the figures are most useful summed over every cache anyway
+        struct CacheMetrics
+        {
+            metrics::Histogram get{"cache_get_seconds", "CacheManager::get latency, disk loads included"};
+            metrics::Histogram put{"cache_put_seconds", "CacheManager::put latency, evictions and inline writes included"};
+            metrics::Histogram eviction{"cache_eviction_seconds", "Time to choose and evict one entry"};
+            metrics::Histogram disk_load{"cache_disk_load_seconds", "Time to read one entry from disk"};
+            metrics::Histogram persist{"cache_persist_seconds", "Time to write one entry to disk"};
+            metrics::Counter hits{"cache_hits_total", "Lookups served from memory"};
+            metrics::Counter misses{"cache_misses_total", "Lookups not in memory"};
+            metrics::Counter evictions{"cache_evictions_total", "Entries evicted to make room"};
+        };
+
+        CacheMetrics &cache_metrics()
+        {
+            static CacheMetrics instance;
+            return instance;
+        }
+    }
+
+    /**
+     * One independently locked slice of the key space. Entries live in a
+     * deque (stable addresses, no moves) that the CLOCK hand sweeps; freed
+     * slots are recycled before the ring grows.
+     */
+    struct alignas(64) CacheManager::Shard
+    {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, size_t> index; // key -> slot
+        std::deque<CacheEntry> slots;
+        std::vector<size_t> free_slots;
+        size_t hand = 0;
+
+        // Persisted entries in this shard, resident or not
+        std::unordered_map<std::string, DiskIndexEntry> disk_index;
+
+        // Statistics (updated under the shared lock)
+        std::atomic<uint64_t> total_requests{0};
+        std::atomic<uint64_t> cache_hits{0};
+    };
+
+    CacheManager::CacheManager(size_t max_memory_mb, const std::string &cache_dir)
+        : CacheManager(max_memory_mb, cache_dir, nullptr, kDefaultShardCount)
+    {
     }
 
     CacheManager::CacheManager(size_t max_memory_mb, const std::string &cache_dir, std::shared_ptr<ThreadPool> thread_pool)
-        : max_memory_bytes_(max_memory_mb * 1024 * 1024), current_memory_bytes_(0), cache_dir_(cache_dir), thread_pool_(thread_pool)
+        : CacheManager(max_memory_mb, cache_dir, std::move(thread_pool), kDefaultShardCount)
+    {
+    }
+
+    CacheManager::CacheManager(size_t max_memory_mb, const std::string &cache_dir, std::shared_ptr<ThreadPool> thread_pool,
+                               size_t num_shards)
+        : num_shards_(std::max<size_t>(num_shards, 1)),
+          shards_(std::make_unique<Shard[]>(num_shards_)),
+          max_memory_bytes_(max_memory_mb * 1024 * 1024),
+          cache_dir_(cache_dir),
+          thread_pool_(std::move(thread_pool))
     {
         // Create cache directory if it doesn't exist
         std::filesystem::create_directories(cache_dir_);
@@ -33,103 +92,371 @@ namespace trading
 
     CacheManager::~CacheManager()
     {
+        // Let a running warm-up finish its current entry
+        stop_warm_up_ = true;
+        {
+            std::lock_guard<std::mutex> lock(warm_up_mutex_);
+            if (warm_up_future_.valid())
+            {
+                warm_up_future_.wait();
+            }
+        }
+
+        // Queued writes reference this cache
+        {
+            std::unique_lock<std::mutex> lock(persist_mutex_);
+            persist_done_.wait(lock, [this]
+                               { return pending_persists_.load() == 0; });
+        }
+
         // Save cache metadata before destruction
         save_cache_metadata();
     }
 
-    std::optional<MarketDataSeries> CacheManager::get(const std::string &key)
+    CacheManager::Shard &CacheManager::shard_for(const std::string &key) const
     {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
+        return shards_[std::hash<std::string>{}(key) % num_shards_];
+    }
+
+    std::shared_ptr<const MarketDataSeries> CacheManager::get(const std::string &key)
+    {
+        CacheMetrics &stats = cache_metrics();
+        metrics::ScopedTimer timer(stats.get);
+        Shard &shard = shard_for(key);
+        shard.total_requests.fetch_add(1, std::memory_order_relaxed);
 
-        auto it = cache_.find(key);
-        if (it == cache_.end())
         {
-            return std::nullopt;
-        }
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+            auto it = shard.index.find(key);
+            if (it != shard.index.end())
+            {
+                // Hits only touch atomics, so readers share the lock
+                CacheEntry &entry = shard.slots[it->second];
+                entry.referenced.store(true, std::memory_order_relaxed);
+                entry.last_accessed_ns.store(steady_now_ns(), std::memory_order_relaxed);
+                shard.cache_hits.fetch_add(1, std::memory_order_relaxed);
+                stats.hits.add();
+                return entry.data;
+            }
+            stats.misses.add();
 
-        // Update access time for LRU
-        it->second.last_accessed = std::chrono::steady_clock::now();
+            if (shard.disk_index.find(key) == shard.disk_index.end())
+            {
+                return nullptr;
+            }
+        }
 
-        // Move to front of LRU list
-        lru_list_.remove(key);
-        lru_list_.push_front(key);
+        // Fault the entry in from disk without holding the lock
+        auto data = load_from_disk(key);
+        if (!data)
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.disk_index.erase(key);
+            return nullptr;
+        }
 
-        return it->second.data;
+        auto shared = std::make_shared<const MarketDataSeries>(std::move(*data));
+        insert(key, shared, false, true);
+        return shared;
     }
 
     void CacheManager::put(const std::string &key, const MarketDataSeries &data)
     {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
+        metrics::ScopedTimer timer(cache_metrics().put);
+        insert(key, std::make_shared<const MarketDataSeries>(data), true, true);
+    }
 
-        // Calculate memory usage of this data
-        size_t data_size = estimate_memory_usage(data);
+    void CacheManager::put(const std::string &key, std::shared_ptr<const MarketDataSeries> data)
+    {
+        if (!data)
+        {
+            throw std::invalid_argument("CacheManager::put requires data");
+        }
+        metrics::ScopedTimer timer(cache_metrics().put);
+        insert(key, std::move(data), true, true);
+    }
+
+    bool CacheManager::insert(const std::string &key, std::shared_ptr<const MarketDataSeries> data, bool persist,
+                              bool allow_evict)
+    {
+        Shard &shard = shard_for(key);
 
-        // Check if we need to evict items
-        while (current_memory_bytes_ + data_size > max_memory_bytes_ && !cache_.empty())
+        // Calculate memory usage of this data
+        size_t data_size = estimate_memory_usage(*data);
+        if (data_size > max_memory_bytes_)
         {
-            evict_lru_item();
+            return false;
         }
 
-        // If still too large, don't cache
-        if (current_memory_bytes_ + data_size > max_memory_bytes_)
+        // Drop any previous version first so it can't be counted twice
         {
-            return;
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            erase_locked(shard, key);
         }
 
-        // Add to cache
-        CacheEntry entry;
-        entry.data = data;
-        entry.size_bytes = data_size;
-        entry.last_accessed = std::chrono::steady_clock::now();
-        entry.created = std::chrono::steady_clock::now();
+        // Reserve the budget, evicting until the reservation fits
+        size_t reserved = current_memory_bytes_.fetch_add(data_size) + data_size;
+        while (reserved > max_memory_bytes_)
+        {
+            if (!allow_evict || !(evict_one() || reclaim_one()))
+            {
+                current_memory_bytes_.fetch_sub(data_size);
+                return false;
+            }
+            reserved = current_memory_bytes_.load();
+        }
 
-        // Remove existing entry if it exists
-        auto existing_it = cache_.find(key);
-        if (existing_it != cache_.end())
         {
-            current_memory_bytes_ -= existing_it->second.size_bytes;
-            lru_list_.remove(key);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+            // A concurrent insert of the same key may have landed meanwhile
+            erase_locked(shard, key);
+
+            size_t slot;
+            if (!shard.free_slots.empty())
+            {
+                slot = shard.free_slots.back();
+                shard.free_slots.pop_back();
+            }
+            else
+            {
+                slot = shard.slots.size();
+                shard.slots.emplace_back();
+            }
+
+            // Add to cache
+            CacheEntry &entry = shard.slots[slot];
+            entry.key = key;
+            entry.data = data;
+            entry.size_bytes = data_size;
+            entry.referenced.store(true, std::memory_order_relaxed);
+            entry.last_accessed_ns.store(steady_now_ns(), std::memory_order_relaxed);
+            entry.created = std::chrono::steady_clock::now();
+            shard.index[key] = slot;
+
+            auto &index_entry = shard.disk_index[key];
+            index_entry.size_bytes = data_size;
+            index_entry.last_accessed = std::chrono::system_clock::now();
         }
 
-        cache_[key] = entry;
-        current_memory_bytes_ += data_size;
-        lru_list_.push_front(key);
+        if (!persist)
+        {
+            return true;
+        }
 
-        // Persist to disk asynchronously if thread pool is available
+        // Persist to disk on the pool's background lane if there is one, so
+        // writes never queue ahead of latency-critical tasks; the task
+        // shares the series instead of copying it
         if (thread_pool_)
         {
-            thread_pool_->submit([this, key, data]()
-                                 { persist_to_disk(key, data); });
+            pending_persists_.fetch_add(1);
+            try
+            {
+                thread_pool_->submit_background([this, key, data]()
+                                                {
+                    persist_to_disk(key, *data);
+                    if (pending_persists_.fetch_sub(1) == 1)
+                    {
+                        std::lock_guard<std::mutex> lock(persist_mutex_);
+                        persist_done_.notify_all();
+                    } });
+                return true;
+            }
+            catch (const std::runtime_error &)
+            {
+                // Pool already shut down
+                pending_persists_.fetch_sub(1);
+            }
         }
-        else
+
+        persist_to_disk(key, *data);
+
+        return true;
+    }
+
+    bool CacheManager::next_victim(Shard &shard, size_t &slot, int64_t &last_accessed_ns)
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        // CLOCK: clear reference bits until an unreferenced entry comes round,
+        // leaving the hand on it. One sweep per call, so an entry that was
+        // referenced survives until every shard has been swept.
+        const size_t ring = shard.slots.size();
+        for (size_t step = 0; step < ring; ++step)
         {
-            persist_to_disk(key, data);
+            CacheEntry &entry = shard.slots[shard.hand];
+            if (entry.data && !entry.referenced.exchange(false, std::memory_order_relaxed))
+            {
+                slot = shard.hand;
+                last_accessed_ns = entry.last_accessed_ns.load(std::memory_order_relaxed);
+                return true;
+            }
+            shard.hand = (shard.hand + 1) % ring;
         }
+
+        return false;
     }
 
-    void CacheManager::remove(const std::string &key)
+    bool CacheManager::evict_one()
+    {
+        CacheMetrics &stats = cache_metrics();
+        metrics::ScopedTimer timer(stats.eviction);
+
+        // Two rounds always suffice: the first clears every reference bit
+        for (int round = 0; round < 2; ++round)
+        {
+            // Each shard nominates a victim; evict the least recently used one.
+            // Only one shard lock is held at a time.
+            Shard *best = nullptr;
+            size_t best_slot = 0;
+            int64_t best_accessed = 0;
+            for (size_t i = 0; i < num_shards_; ++i)
+            {
+                size_t slot;
+                int64_t accessed;
+                if (next_victim(shards_[i], slot, accessed) && (!best || accessed < best_accessed))
+                {
+                    best = &shards_[i];
+                    best_slot = slot;
+                    best_accessed = accessed;
+                }
+            }
+
+            if (!best)
+            {
+                continue;
+            }
+
+            std::unique_lock<std::shared_mutex> lock(best->mutex);
+            if (best_slot < best->slots.size())
+            {
+                CacheEntry &entry = best->slots[best_slot];
+                // Skip it if it was hit, replaced or removed since it was nominated
+                if (entry.data && !entry.referenced.load(std::memory_order_relaxed))
+                {
+                    std::string key = entry.key;
+                    erase_locked(*best, key);
+                    stats.evictions.add();
+                    return true;
+                }
+            }
+            // Lost the race; another round re-nominates
+            round = -1;
+        }
+
+        return false;
+    }
+
+    bool CacheManager::reclaim_one()
+    {
+        std::lock_guard<std::mutex> lock(reclaim_mutex_);
+        for (auto &[handle, reclaim] : reclaimers_)
+        {
+            if (reclaim())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool CacheManager::reserve_memory(size_t bytes, bool allow_evict)
+    {
+        if (bytes > max_memory_bytes_)
+        {
+            return false;
+        }
+
+        // Same reservation protocol as insert(), but only series are evicted:
+        // the caller owns the companion memory and decides what to drop
+        size_t reserved = current_memory_bytes_.fetch_add(bytes) + bytes;
+        while (reserved > max_memory_bytes_)
+        {
+            if (!allow_evict || !evict_one())
+            {
+                current_memory_bytes_.fetch_sub(bytes);
+                return false;
+            }
+            reserved = current_memory_bytes_.load();
+        }
+        return true;
+    }
+
+    void CacheManager::release_memory(size_t bytes)
     {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
+        current_memory_bytes_.fetch_sub(bytes);
+    }
+
+    size_t CacheManager::add_reclaimer(std::function<bool()> reclaim)
+    {
+        std::lock_guard<std::mutex> lock(reclaim_mutex_);
+        size_t handle = ++next_reclaimer_;
+        reclaimers_.emplace_back(handle, std::move(reclaim));
+        return handle;
+    }
 
-        auto it = cache_.find(key);
-        if (it != cache_.end())
+    void CacheManager::remove_reclaimer(size_t handle)
+    {
+        std::lock_guard<std::mutex> lock(reclaim_mutex_);
+        reclaimers_.erase(std::remove_if(reclaimers_.begin(), reclaimers_.end(), [handle](const auto &entry)
+                                         { return entry.first == handle; }),
+                          reclaimers_.end());
+    }
+
+    void CacheManager::erase_locked(Shard &shard, const std::string &key)
+    {
+        auto it = shard.index.find(key);
+        if (it == shard.index.end())
         {
-            current_memory_bytes_ -= it->second.size_bytes;
-            lru_list_.remove(key);
-            cache_.erase(it);
+            return;
+        }
+
+        CacheEntry &entry = shard.slots[it->second];
+        current_memory_bytes_.fetch_sub(entry.size_bytes);
+        entry.data.reset();
+        entry.key.clear();
+        entry.size_bytes = 0;
+        entry.referenced.store(false, std::memory_order_relaxed);
+        shard.free_slots.push_back(it->second);
+        shard.index.erase(it);
+    }
 
-            // Remove from disk
+    void CacheManager::remove(const std::string &key)
+    {
+        Shard &shard = shard_for(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        remove_locked(shard, key);
+    }
+
+    void CacheManager::remove_locked(Shard &shard, const std::string &key)
+    {
+        erase_locked(shard, key);
+
+        // Remove from disk
+        if (shard.disk_index.erase(key) > 0)
+        {
             std::filesystem::remove(get_cache_file_path(key));
         }
     }
 
     void CacheManager::clear()
     {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
+        for (size_t i = 0; i < num_shards_; ++i)
+        {
+            Shard &shard = shards_[i];
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
 
-        cache_.clear();
-        lru_list_.clear();
-        current_memory_bytes_ = 0;
+            for (const auto &[key, slot] : shard.index)
+            {
+                current_memory_bytes_.fetch_sub(shard.slots[slot].size_bytes);
+            }
+            shard.index.clear();
+            shard.slots.clear();
+            shard.free_slots.clear();
+            shard.disk_index.clear();
+            shard.hand = 0;
+        }
 
         // Clear disk cache
         for (const auto &entry : std::filesystem::directory_iterator(cache_dir_))
@@ -143,128 +470,227 @@ namespace trading
 
     bool CacheManager::contains(const std::string &key) const
     {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        return cache_.find(key) != cache_.end();
+        Shard &shard = shard_for(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.index.find(key) != shard.index.end() || shard.disk_index.find(key) != shard.disk_index.end();
+    }
+
+    bool CacheManager::is_resident(const std::string &key) const
+    {
+        Shard &shard = shard_for(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.index.find(key) != shard.index.end();
+    }
+
+    size_t CacheManager::indexed_size() const
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < num_shards_; ++i)
+        {
+            std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+            total += shards_[i].disk_index.size();
+        }
+        return total;
     }
 
     size_t CacheManager::size() const
     {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        return cache_.size();
+        size_t total = 0;
+        for (size_t i = 0; i < num_shards_; ++i)
+        {
+            std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+            total += shards_[i].index.size();
+        }
+        return total;
     }
 
     size_t CacheManager::memory_usage() const
     {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        return current_memory_bytes_;
+        return current_memory_bytes_.load();
     }
 
     double CacheManager::hit_rate() const
     {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
+        uint64_t requests = 0, hits = 0;
+        for (size_t i = 0; i < num_shards_; ++i)
+        {
+            requests += shards_[i].total_requests.load(std::memory_order_relaxed);
+            hits += shards_[i].cache_hits.load(std::memory_order_relaxed);
+        }
 
-        if (total_requests_ == 0)
+        if (requests == 0)
         {
             return 0.0;
         }
 
-        return static_cast<double>(cache_hits_) / total_requests_;
+        return static_cast<double>(hits) / requests;
     }
 
     void CacheManager::cleanup_expired_entries(std::chrono::hours max_age)
     {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-
         auto now = std::chrono::steady_clock::now();
-        std::vector<std::string> to_remove;
 
-        for (const auto &[key, entry] : cache_)
+        for (size_t i = 0; i < num_shards_; ++i)
         {
-            if (now - entry.created > max_age)
+            Shard &shard = shards_[i];
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+            std::vector<std::string> to_remove;
+            for (const auto &[key, slot] : shard.index)
             {
-                to_remove.push_back(key);
+                if (now - shard.slots[slot].created > max_age)
+                {
+                    to_remove.push_back(key);
+                }
             }
-        }
 
-        for (const auto &key : to_remove)
-        {
-            remove(key);
+            for (const auto &key : to_remove)
+            {
+                remove_locked(shard, key);
+            }
         }
     }
 
     void CacheManager::preload_from_disk()
     {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-
-        for (const auto &entry : std::filesystem::directory_iterator(cache_dir_))
+        // Snapshot keys first; insert() takes the shard locks itself
+        std::vector<std::string> keys;
+        for (size_t i = 0; i < num_shards_; ++i)
         {
-            if (entry.is_regular_file() && entry.path().extension() == ".cache")
+            std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+            for (const auto &[key, entry] : shards_[i].disk_index)
             {
-                std::string key = entry.path().stem().string();
+                keys.push_back(key);
+            }
+        }
 
-                try
-                {
-                    auto data = load_from_disk(key);
-                    if (data)
-                    {
-                        put(key, *data);
-                    }
-                }
-                catch (const std::exception &e)
+        for (const auto &key : keys)
+        {
+            try
+            {
+                auto data = load_from_disk(key);
+                if (data)
                 {
-                    // Log error and continue
-                    std::cerr << "Failed to preload cache entry " << key << ": " << e.what() << std::endl;
+                    // Already on disk, so no need to persist again
+                    insert(key, std::make_shared<const MarketDataSeries>(std::move(*data)), false, true);
                 }
             }
+            catch (const std::exception &e)
+            {
+                // Log error and continue
+                std::cerr << "Failed to preload cache entry " << key << ": " << e.what() << std::endl;
+            }
         }
     }
 
-    void CacheManager::evict_lru_item()
+    std::shared_future<size_t> CacheManager::warm_up_async()
     {
-        if (lru_list_.empty())
+        std::lock_guard<std::mutex> lock(warm_up_mutex_);
+
+        if (warm_up_future_.valid() &&
+            warm_up_future_.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
         {
-            return;
+            // Already running
+            return warm_up_future_;
         }
 
-        std::string key_to_evict = lru_list_.back();
-        lru_list_.pop_back();
-
-        auto it = cache_.find(key_to_evict);
-        if (it != cache_.end())
+        if (thread_pool_)
+        {
+            warm_up_future_ = thread_pool_->submit_background([this]()
+                                                              { return warm_up(); })
+                                  .share();
+        }
+        else
         {
-            current_memory_bytes_ -= it->second.size_bytes;
-            cache_.erase(it);
+            std::promise<size_t> loaded;
+            loaded.set_value(warm_up());
+            warm_up_future_ = loaded.get_future().share();
         }
+
+        return warm_up_future_;
     }
 
-    size_t CacheManager::estimate_memory_usage(const MarketDataSeries &data) const
+    size_t CacheManager::warm_up()
     {
-        // Rough estimation: each data point is about 64 bytes (timestamp + 5 doubles + volume)
-        size_t base_size = sizeof(MarketDataPoint) * data.size();
+        // Snapshot the non-resident entries, most recently used first
+        std::vector<std::pair<std::string, DiskIndexEntry>> candidates;
+        for (size_t i = 0; i < num_shards_; ++i)
+        {
+            std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+            for (const auto &[key, entry] : shards_[i].disk_index)
+            {
+                if (shards_[i].index.find(key) == shards_[i].index.end())
+                {
+                    candidates.emplace_back(key, entry);
+                }
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const auto &a, const auto &b)
+                  { return a.second.last_accessed > b.second.last_accessed; });
 
-        // Add overhead for symbol string and vector storage
-        size_t overhead = data.symbol().size() + sizeof(std::vector<MarketDataPoint>) + 100;
+        size_t loaded = 0;
+        for (const auto &[key, entry] : candidates)
+        {
+            if (stop_warm_up_)
+            {
+                break;
+            }
 
-        return base_size + overhead;
+            // Skip entries that would not fit in what is left of the budget
+            if (current_memory_bytes_.load() + entry.size_bytes > max_memory_bytes_ || is_resident(key))
+            {
+                continue;
+            }
+
+            auto data = load_from_disk(key);
+            if (data && insert(key, std::make_shared<const MarketDataSeries>(std::move(*data)), false, false))
+            {
+                // Keep the persisted access time rather than stamping "now"
+                Shard &shard = shard_for(key);
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                shard.disk_index[key].last_accessed = entry.last_accessed;
+                ++loaded;
+            }
+        }
+
+        return loaded;
     }
 
-    std::string CacheManager::get_cache_file_path(const std::string &key) const
+    std::shared_ptr<const MappedColumnarFile> CacheManager::map_from_disk(const std::string &key, bool verify_checksum) const
     {
-        return (std::filesystem::path(cache_dir_) / (key + ".cache")).string();
+        std::string filepath = get_cache_file_path(key);
+        if (!MappedColumnarFile::is_columnar_file(filepath))
+        {
+            return nullptr;
+        }
+
+        try
+        {
+            return MappedColumnarFile::open(filepath, verify_checksum);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Failed to map cache entry " << key << ": " << e.what() << std::endl;
+            return nullptr;
+        }
     }
 
-    void CacheManager::persist_to_disk(const std::string &key, const MarketDataSeries &data)
+    bool CacheManager::export_to_json(const std::string &key, const std::string &filepath)
     {
-        try
+        auto data = get(key);
+        if (!data)
         {
-            std::string filepath = get_cache_file_path(key);
+            return false;
+        }
 
+        try
+        {
             // Create JSON representation
             json j;
-            j["symbol"] = data.symbol();
+            j["symbol"] = data->symbol();
             j["data"] = json::array();
 
-            for (const auto &point : data.data())
+            for (const auto &point : data->data())
             {
                 json point_json;
                 point_json["timestamp"] = std::chrono::duration_cast<std::chrono::seconds>(
@@ -281,11 +707,42 @@ namespace trading
 
             // Write to file
             std::ofstream file(filepath);
-            if (file.is_open())
+            if (!file.is_open())
             {
-                file << j.dump(2);
-                file.close();
+                return false;
             }
+            file << j.dump(2);
+            return static_cast<bool>(file);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Failed to export cache entry " << key << ": " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    size_t CacheManager::estimate_memory_usage(const MarketDataSeries &data) const
+    {
+        // Rough estimation: each data point is about 64 bytes (timestamp + 5 doubles + volume)
+        size_t base_size = sizeof(MarketDataPoint) * data.size();
+
+        // Add overhead for symbol string and vector storage
+        size_t overhead = data.symbol().size() + sizeof(std::vector<MarketDataPoint>) + 100;
+
+        return base_size + overhead;
+    }
+
+    std::string CacheManager::get_cache_file_path(const std::string &key) const
+    {
+        return (std::filesystem::path(cache_dir_) / (key + ".cache")).string();
+    }
+
+    void CacheManager::persist_to_disk(const std::string &key, const MarketDataSeries &data)
+    {
+        metrics::ScopedTimer timer(cache_metrics().persist);
+        try
+        {
+            write_columnar_file(get_cache_file_path(key), ColumnarSeries::from_series(data));
         }
         catch (const std::exception &e)
         {
@@ -293,37 +750,24 @@ namespace trading
         }
     }
 
-    std::optional<MarketDataSeries> CacheManager::load_from_disk(const std::string &key)
+    std::optional<MarketDataSeries> CacheManager::load_from_disk(const std::string &key) const
     {
+        metrics::ScopedTimer timer(cache_metrics().disk_load);
         try
         {
             std::string filepath = get_cache_file_path(key);
-            std::ifstream file(filepath);
-
-            if (!file.is_open())
+            if (!std::filesystem::exists(filepath))
             {
                 return std::nullopt;
             }
 
-            json j;
-            file >> j;
-
-            MarketDataSeries series(j["symbol"].get<std::string>());
-
-            for (const auto &point_json : j["data"])
+            // Files from before the binary format are JSON
+            if (!MappedColumnarFile::is_columnar_file(filepath))
             {
-                MarketDataPoint point(
-                    std::chrono::system_clock::from_time_t(point_json["timestamp"].get<int64_t>()),
-                    point_json["open"].get<double>(),
-                    point_json["high"].get<double>(),
-                    point_json["low"].get<double>(),
-                    point_json["close"].get<double>(),
-                    point_json["volume"].get<int64_t>());
-
-                series.add_point(std::move(point));
+                return load_legacy_json(filepath);
             }
 
-            return series;
+            return MappedColumnarFile::open(filepath)->to_series();
         }
         catch (const std::exception &e)
         {
@@ -332,8 +776,40 @@ namespace trading
         }
     }
 
+    std::optional<MarketDataSeries> CacheManager::load_legacy_json(const std::string &filepath) const
+    {
+        std::ifstream file(filepath);
+
+        if (!file.is_open())
+        {
+            return std::nullopt;
+        }
+
+        json j;
+        file >> j;
+
+        MarketDataSeries series(j["symbol"].get<std::string>());
+
+        for (const auto &point_json : j["data"])
+        {
+            MarketDataPoint point(
+                std::chrono::system_clock::from_time_t(point_json["timestamp"].get<int64_t>()),
+                point_json["open"].get<double>(),
+                point_json["high"].get<double>(),
+                point_json["low"].get<double>(),
+                point_json["close"].get<double>(),
+                point_json["volume"].get<int64_t>());
+
+            series.add_point(std::move(point));
+        }
+
+        return series;
+    }
+
     void CacheManager::load_cache_metadata()
     {
+        bool indexed = false;
+
         try
         {
             std::string metadata_file = (std::filesystem::path(cache_dir_) / "metadata.json").string();
@@ -344,15 +820,51 @@ namespace trading
                 json j;
                 file >> j;
 
-                total_requests_ = j.value("total_requests", 0);
-                cache_hits_ = j.value("cache_hits", 0);
+                // Lifetime totals carry over in the first shard
+                shards_[0].total_requests = j.value("total_requests", uint64_t{0});
+                shards_[0].cache_hits = j.value("cache_hits", uint64_t{0});
+
+                if (j.contains("entries"))
+                {
+                    for (const auto &[key, entry_json] : j["entries"].items())
+                    {
+                        DiskIndexEntry entry;
+                        entry.size_bytes = entry_json.value("size_bytes", size_t{0});
+                        entry.last_accessed = std::chrono::system_clock::time_point(
+                            std::chrono::milliseconds(entry_json.value("last_accessed_ms", int64_t{0})));
+                        shard_for(key).disk_index[key] = entry;
+                    }
+                    indexed = true;
+                }
             }
         }
         catch (const std::exception &e)
         {
             // Metadata loading failed, use defaults
-            total_requests_ = 0;
-            cache_hits_ = 0;
+            shards_[0].total_requests = 0;
+            shards_[0].cache_hits = 0;
+            for (size_t i = 0; i < num_shards_; ++i)
+            {
+                shards_[i].disk_index.clear();
+            }
+        }
+
+        if (indexed)
+        {
+            return;
+        }
+
+        // No index yet (older cache directory): list the files without opening them
+        std::error_code ec;
+        for (const auto &entry : std::filesystem::directory_iterator(cache_dir_, ec))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".cache")
+            {
+                DiskIndexEntry index_entry;
+                index_entry.size_bytes = static_cast<size_t>(entry.file_size());
+                std::string key = entry.path().stem().string();
+                shard_for(key).disk_index[key] = index_entry;
+            }
         }
     }
 
@@ -365,9 +877,41 @@ namespace trading
 
             if (file.is_open())
             {
+                uint64_t requests = 0, hits = 0;
+                json entries = json::object();
+
+                // Resident entries carry a fresher steady-clock access time
+                auto steady_now = steady_now_ns();
+                auto system_now = std::chrono::system_clock::now();
+                for (size_t i = 0; i < num_shards_; ++i)
+                {
+                    const Shard &shard = shards_[i];
+                    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                    requests += shard.total_requests.load();
+                    hits += shard.cache_hits.load();
+
+                    for (const auto &[key, index_entry] : shard.disk_index)
+                    {
+                        auto last_accessed = index_entry.last_accessed;
+                        auto resident = shard.index.find(key);
+                        if (resident != shard.index.end())
+                        {
+                            auto idle = std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                                std::chrono::nanoseconds(steady_now - shard.slots[resident->second].last_accessed_ns.load()));
+                            last_accessed = std::max(last_accessed, system_now - idle);
+                        }
+
+                        entries[key] = {{"size_bytes", index_entry.size_bytes},
+                                        {"last_accessed_ms", std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                                 last_accessed.time_since_epoch())
+                                                                 .count()}};
+                    }
+                }
+
                 json j;
-                j["total_requests"] = total_requests_;
-                j["cache_hits"] = cache_hits_;
+                j["total_requests"] = requests;
+                j["cache_hits"] = hits;
+                j["entries"] = std::move(entries);
 
                 file << j.dump(2);
                 file.close();
@@ -378,4 +922,4 @@ namespace trading
             std::cerr << "Failed to save cache metadata: " << e.what() << std::endl;
         }
     }
-}
\ No newline at end of file
+}
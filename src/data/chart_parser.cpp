@@ -0,0 +1,626 @@
+#include "data/chart_parser.h"
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace trading
+{
+    namespace
+    {
+        constexpr size_t kMaxDepth = 64;
+        constexpr size_t kMaxTokenLength = 4096; // Longer strings are truncated; they are never used as data
+        constexpr int64_t kMissingTimestamp = std::numeric_limits<int64_t>::min();
+        constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+        bool is_number_char(char c)
+        {
+            return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+        }
+
+        bool is_literal_char(char c)
+        {
+            return c >= 'a' && c <= 'z';
+        }
+
+        void append_bounded(std::string &text, const char *data, size_t length)
+        {
+            if (text.size() < kMaxTokenLength)
+            {
+                text.append(data, std::min(length, kMaxTokenLength - text.size()));
+            }
+        }
+    }
+
+    ChartStreamParser::ChartStreamParser(const std::string &symbol)
+        : series_(symbol)
+    {
+        stack_.reserve(16);
+    }
+
+    void ChartStreamParser::feed(std::string_view chunk)
+    {
+        const char *p = chunk.data();
+        const char *end = p + chunk.size();
+        bytes_consumed_ += chunk.size();
+
+        while (p < end)
+        {
+            // Resume a token split across chunks
+            switch (token_)
+            {
+            case Token::STRING:
+                p += scan_string(p, end);
+                continue;
+            case Token::NUMBER:
+                p += scan_number(p, end);
+                continue;
+            case Token::LITERAL:
+                p += scan_literal(p, end);
+                continue;
+            case Token::NONE:
+                break;
+            }
+
+            char c = *p;
+            switch (c)
+            {
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                ++p;
+                break;
+            case '{':
+                begin_container(false);
+                ++p;
+                break;
+            case '[':
+                begin_container(true);
+                ++p;
+                break;
+            case '}':
+                end_container(false);
+                ++p;
+                break;
+            case ']':
+                end_container(true);
+                ++p;
+                break;
+            case ',':
+                comma();
+                ++p;
+                break;
+            case ':':
+                colon();
+                ++p;
+                break;
+            case '"':
+                token_ = Token::STRING;
+                token_text_.clear();
+                ++p;
+                break;
+            default:
+                if (c == '-' || (c >= '0' && c <= '9'))
+                {
+                    token_ = Token::NUMBER;
+                    token_text_.clear();
+                }
+                else if (is_literal_char(c))
+                {
+                    token_ = Token::LITERAL;
+                    token_text_.clear();
+                }
+                else
+                {
+                    fail(std::string("unexpected character '") + c + "'");
+                }
+                break;
+            }
+        }
+    }
+
+    ColumnarSeries ChartStreamParser::finish()
+    {
+        // A number or literal may run right up to the end of the input
+        if (token_ == Token::NUMBER)
+        {
+            token_ = Token::NONE;
+            on_number(token_text_);
+        }
+        else if (token_ == Token::LITERAL)
+        {
+            token_ = Token::NONE;
+            on_literal(token_text_);
+        }
+
+        if (token_ != Token::NONE || expect_ != Expect::DONE)
+        {
+            fail("unexpected end of input");
+        }
+
+        if (has_error_)
+        {
+            throw std::runtime_error("Yahoo Finance API error: " + error_description_);
+        }
+
+        auto &timestamps = series_.mutable_timestamps();
+        auto &open = series_.mutable_open();
+        auto &high = series_.mutable_high();
+        auto &low = series_.mutable_low();
+        auto &close = series_.mutable_close();
+        auto &volume = series_.mutable_volume();
+
+        // Columns shorter than the timestamps read as missing
+        const size_t rows = timestamps.size();
+        for (auto *column : {&open, &high, &low, &close, &volume})
+        {
+            column->resize(rows, kMissing);
+        }
+
+        // Drop incomplete rows in place
+        size_t kept = 0;
+        for (size_t i = 0; i < rows; ++i)
+        {
+            if (timestamps[i] == kMissingTimestamp || std::isnan(open[i]) || std::isnan(high[i]) ||
+                std::isnan(low[i]) || std::isnan(close[i]))
+            {
+                continue;
+            }
+
+            timestamps[kept] = timestamps[i];
+            open[kept] = open[i];
+            high[kept] = high[i];
+            low[kept] = low[i];
+            close[kept] = close[i];
+            volume[kept] = std::isnan(volume[i]) ? 0.0 : std::trunc(volume[i]);
+            ++kept;
+        }
+        series_.resize(kept);
+
+        return std::move(series_);
+    }
+
+    void ChartStreamParser::begin_container(bool is_array)
+    {
+        expect_value();
+        if (stack_.size() >= kMaxDepth)
+        {
+            fail("nesting too deep");
+        }
+
+        Frame frame;
+        frame.is_array = is_array;
+        if (is_array)
+        {
+            frame.column = column_for_array();
+        }
+        else if (stack_.size() == 2 && !stack_[0].is_array && stack_[0].key == "chart" &&
+                 !stack_[1].is_array && stack_[1].key == "error")
+        {
+            // chart.error is null on success, an object on failure
+            has_error_ = true;
+        }
+
+        stack_.push_back(std::move(frame));
+        expect_ = is_array ? Expect::VALUE_OR_END : Expect::KEY_OR_END;
+    }
+
+    void ChartStreamParser::end_container(bool is_array)
+    {
+        if (stack_.empty() || stack_.back().is_array != is_array)
+        {
+            fail("mismatched bracket");
+        }
+
+        Expect open_state = is_array ? Expect::VALUE_OR_END : Expect::KEY_OR_END;
+        if (expect_ != open_state && expect_ != Expect::COMMA_OR_END)
+        {
+            fail("unexpected end of container");
+        }
+
+        Column column = stack_.back().column;
+        stack_.pop_back();
+
+        // Timestamps come first, so their count sizes the other columns
+        if (column == Column::TIMESTAMP)
+        {
+            series_.reserve(series_.mutable_timestamps().size());
+        }
+
+        after_value();
+    }
+
+    void ChartStreamParser::comma()
+    {
+        if (expect_ != Expect::COMMA_OR_END)
+        {
+            fail("unexpected ','");
+        }
+
+        if (stack_.back().is_array)
+        {
+            ++stack_.back().index;
+            expect_ = Expect::VALUE;
+        }
+        else
+        {
+            expect_ = Expect::KEY;
+        }
+    }
+
+    void ChartStreamParser::colon()
+    {
+        if (expect_ != Expect::COLON)
+        {
+            fail("unexpected ':'");
+        }
+        expect_ = Expect::VALUE;
+    }
+
+    void ChartStreamParser::after_value()
+    {
+        expect_ = stack_.empty() ? Expect::DONE : Expect::COMMA_OR_END;
+    }
+
+    void ChartStreamParser::expect_value() const
+    {
+        if (expect_ != Expect::VALUE && expect_ != Expect::VALUE_OR_END)
+        {
+            fail("unexpected value");
+        }
+    }
+
+    ChartStreamParser::Column ChartStreamParser::column_for_array() const
+    {
+        auto key_at = [&](size_t depth, const char *key)
+        {
+            return !stack_[depth].is_array && stack_[depth].key == key;
+        };
+        auto first_element_at = [&](size_t depth)
+        {
+            return stack_[depth].is_array && stack_[depth].index == 0;
+        };
+
+        // chart.result[0].timestamp
+        if (stack_.size() == 4 && key_at(0, "chart") && key_at(1, "result") && first_element_at(2) &&
+            key_at(3, "timestamp"))
+        {
+            return Column::TIMESTAMP;
+        }
+
+        // chart.result[0].indicators.quote[0].<field>
+        if (stack_.size() == 7 && key_at(0, "chart") && key_at(1, "result") && first_element_at(2) &&
+            key_at(3, "indicators") && key_at(4, "quote") && first_element_at(5) && !stack_[6].is_array)
+        {
+            const std::string &field = stack_[6].key;
+            if (field == "open")
+                return Column::OPEN;
+            if (field == "high")
+                return Column::HIGH;
+            if (field == "low")
+                return Column::LOW;
+            if (field == "close")
+                return Column::CLOSE;
+            if (field == "volume")
+                return Column::VOLUME;
+        }
+
+        return Column::NONE;
+    }
+
+    bool ChartStreamParser::in_error_object() const
+    {
+        return has_error_ && stack_.size() == 3 && !stack_[0].is_array && stack_[0].key == "chart" &&
+               !stack_[1].is_array && stack_[1].key == "error" && !stack_[2].is_array;
+    }
+
+    size_t ChartStreamParser::scan_string(const char *p, const char *end)
+    {
+        const char *start = p;
+        while (p < end)
+        {
+            char c = *p;
+
+            if (unicode_digits_ > 0)
+            {
+                uint32_t digit;
+                if (c >= '0' && c <= '9')
+                    digit = c - '0';
+                else if (c >= 'a' && c <= 'f')
+                    digit = c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F')
+                    digit = c - 'A' + 10;
+                else
+                    fail("invalid \\u escape");
+
+                unicode_value_ = (unicode_value_ << 4) | digit;
+                if (--unicode_digits_ == 0)
+                {
+                    unicode_digits_ = -1;
+                    append_code_point(unicode_value_);
+                }
+                ++p;
+                continue;
+            }
+
+            if (escape_)
+            {
+                escape_ = false;
+                switch (c)
+                {
+                case '"':
+                case '\\':
+                case '/':
+                    append_bounded(token_text_, &c, 1);
+                    break;
+                case 'b':
+                    append_bounded(token_text_, "\b", 1);
+                    break;
+                case 'f':
+                    append_bounded(token_text_, "\f", 1);
+                    break;
+                case 'n':
+                    append_bounded(token_text_, "\n", 1);
+                    break;
+                case 'r':
+                    append_bounded(token_text_, "\r", 1);
+                    break;
+                case 't':
+                    append_bounded(token_text_, "\t", 1);
+                    break;
+                case 'u':
+                    unicode_digits_ = 4;
+                    unicode_value_ = 0;
+                    break;
+                default:
+                    fail("invalid escape");
+                }
+                ++p;
+                continue;
+            }
+
+            if (c == '\\')
+            {
+                escape_ = true;
+                ++p;
+                continue;
+            }
+
+            if (c == '"')
+            {
+                ++p;
+                token_ = Token::NONE;
+                if (high_surrogate_)
+                {
+                    append_code_point(0xFFFD);
+                }
+                on_string(token_text_);
+                return p - start;
+            }
+
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                fail("control character in string");
+            }
+
+            if (high_surrogate_)
+            {
+                append_code_point(0xFFFD);
+            }
+
+            // Copy a run of plain characters at once
+            const char *run = p;
+            while (p < end && *p != '"' && *p != '\\' && static_cast<unsigned char>(*p) >= 0x20)
+            {
+                ++p;
+            }
+            append_bounded(token_text_, run, p - run);
+        }
+        return p - start;
+    }
+
+    size_t ChartStreamParser::scan_number(const char *p, const char *end)
+    {
+        const char *q = p;
+        while (q < end && is_number_char(*q))
+        {
+            ++q;
+        }
+
+        if (q == end)
+        {
+            // May continue in the next chunk
+            if (token_text_.size() + (q - p) > 64)
+            {
+                fail("number too long");
+            }
+            token_text_.append(p, q - p);
+            return q - p;
+        }
+
+        token_ = Token::NONE;
+        if (token_text_.empty())
+        {
+            // Common case: the whole number is in this chunk, parse it in place
+            on_number(std::string_view(p, q - p));
+        }
+        else
+        {
+            token_text_.append(p, q - p);
+            on_number(token_text_);
+        }
+        return q - p;
+    }
+
+    size_t ChartStreamParser::scan_literal(const char *p, const char *end)
+    {
+        const char *q = p;
+        while (q < end && is_literal_char(*q))
+        {
+            ++q;
+        }
+
+        if (token_text_.size() + (q - p) > 5)
+        {
+            fail("invalid literal");
+        }
+        token_text_.append(p, q - p);
+
+        if (q < end)
+        {
+            token_ = Token::NONE;
+            on_literal(token_text_);
+        }
+        return q - p;
+    }
+
+    void ChartStreamParser::on_string(std::string_view value)
+    {
+        if (expect_ == Expect::KEY || expect_ == Expect::KEY_OR_END)
+        {
+            stack_.back().key.assign(value);
+            expect_ = Expect::COLON;
+            return;
+        }
+
+        expect_value();
+        if (in_error_object() && stack_.back().key == "description")
+        {
+            error_description_.assign(value);
+        }
+        push_value(kMissing, true, {});
+        after_value();
+    }
+
+    void ChartStreamParser::on_number(std::string_view text)
+    {
+        expect_value();
+
+        double value = 0.0;
+        auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec != std::errc() || end != text.data() + text.size())
+        {
+            fail("invalid number '" + std::string(text) + "'");
+        }
+
+        push_value(value, false, text);
+        after_value();
+    }
+
+    void ChartStreamParser::on_literal(std::string_view text)
+    {
+        if (text != "null" && text != "true" && text != "false")
+        {
+            fail("invalid literal '" + std::string(text) + "'");
+        }
+
+        expect_value();
+        push_value(kMissing, true, {});
+        after_value();
+    }
+
+    void ChartStreamParser::push_value(double value, bool is_null, std::string_view text)
+    {
+        if (stack_.empty() || !stack_.back().is_array)
+        {
+            return;
+        }
+
+        switch (stack_.back().column)
+        {
+        case Column::NONE:
+            break;
+        case Column::TIMESTAMP:
+        {
+            int64_t seconds = kMissingTimestamp;
+            if (!is_null)
+            {
+                auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), seconds);
+                if (ec != std::errc() || end != text.data() + text.size())
+                {
+                    seconds = static_cast<int64_t>(value);
+                }
+                seconds = to_epoch_nanos(std::chrono::system_clock::from_time_t(seconds));
+            }
+            series_.mutable_timestamps().push_back(seconds);
+            break;
+        }
+        case Column::OPEN:
+            series_.mutable_open().push_back(value);
+            break;
+        case Column::HIGH:
+            series_.mutable_high().push_back(value);
+            break;
+        case Column::LOW:
+            series_.mutable_low().push_back(value);
+            break;
+        case Column::CLOSE:
+            series_.mutable_close().push_back(value);
+            break;
+        case Column::VOLUME:
+            series_.mutable_volume().push_back(value);
+            break;
+        }
+    }
+
+    void ChartStreamParser::append_code_point(uint32_t code_point)
+    {
+        // Pair UTF-16 surrogates; a lone surrogate becomes U+FFFD
+        if (code_point >= 0xD800 && code_point < 0xDC00)
+        {
+            if (high_surrogate_)
+            {
+                append_code_point(0xFFFD);
+            }
+            high_surrogate_ = code_point;
+            return;
+        }
+        if (code_point >= 0xDC00 && code_point < 0xE000)
+        {
+            code_point = high_surrogate_ ? 0x10000 + ((high_surrogate_ - 0xD800) << 10) + (code_point - 0xDC00) : 0xFFFD;
+            high_surrogate_ = 0;
+        }
+        else if (high_surrogate_)
+        {
+            high_surrogate_ = 0;
+            append_code_point(0xFFFD);
+        }
+
+        char utf8[4];
+        size_t length;
+        if (code_point < 0x80)
+        {
+            utf8[0] = static_cast<char>(code_point);
+            length = 1;
+        }
+        else if (code_point < 0x800)
+        {
+            utf8[0] = static_cast<char>(0xC0 | (code_point >> 6));
+            utf8[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+            length = 2;
+        }
+        else if (code_point < 0x10000)
+        {
+            utf8[0] = static_cast<char>(0xE0 | (code_point >> 12));
+            utf8[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            utf8[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+            length = 3;
+        }
+        else
+        {
+            utf8[0] = static_cast<char>(0xF0 | (code_point >> 18));
+            utf8[1] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            utf8[2] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            utf8[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+            length = 4;
+        }
+        append_bounded(token_text_, utf8, length);
+    }
+
+    void ChartStreamParser::fail(const std::string &message) const
+    {
+        throw std::runtime_error("JSON parsing error: " + message + " (after " + std::to_string(bytes_consumed_) +
+                                 " bytes received)");
+    }
+}
@@ -0,0 +1,241 @@
+#include "data/chunked_reader.h"
+#include "data/cache_manager.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace trading
+{
+    ChunkedSeriesReader::ChunkedSeriesReader(std::vector<std::string> paths, const StreamingConfig &config,
+                                             std::shared_ptr<ThreadPool> thread_pool)
+        : ChunkedSeriesReader(
+              paths.size(),
+              [paths, verify = config.verify_checksum](size_t segment)
+              { return std::shared_ptr<const MappedColumnarFile>(MappedColumnarFile::open(paths[segment], verify)); },
+              config, std::move(thread_pool))
+    {
+    }
+
+    ChunkedSeriesReader::ChunkedSeriesReader(size_t segments, SegmentOpener opener, const StreamingConfig &config,
+                                             std::shared_ptr<ThreadPool> thread_pool)
+        : config_(config), thread_pool_(std::move(thread_pool)), segments_(segments), opener_(std::move(opener))
+    {
+        if (config_.chunk_bars == 0)
+        {
+            throw std::invalid_argument("Chunk size must be greater than 0");
+        }
+        if (!opener_)
+        {
+            throw std::invalid_argument("Segment opener must not be empty");
+        }
+    }
+
+    std::unique_ptr<ChunkedSeriesReader> ChunkedSeriesReader::from_cache(const CacheManager &cache,
+                                                                         std::vector<std::string> keys,
+                                                                         const StreamingConfig &config,
+                                                                         std::shared_ptr<ThreadPool> thread_pool)
+    {
+        size_t segments = keys.size();
+        auto opener = [&cache, keys = std::move(keys), verify = config.verify_checksum](size_t segment)
+        {
+            auto file = cache.map_from_disk(keys[segment], verify);
+            if (!file)
+            {
+                throw std::runtime_error("Cache entry " + keys[segment] + " is not on disk in the columnar format");
+            }
+            return file;
+        };
+        return std::make_unique<ChunkedSeriesReader>(segments, std::move(opener), config, std::move(thread_pool));
+    }
+
+    ChunkedSeriesReader::~ChunkedSeriesReader()
+    {
+        if (prefetch_.valid())
+        {
+            prefetch_.wait();
+        }
+    }
+
+    bool ChunkedSeriesReader::next(StreamChunk &chunk)
+    {
+        if (!started_)
+        {
+            started_ = true;
+            front_ = 0;
+            load(buffers_[0], nullptr);
+        }
+        else if (prefetch_.valid())
+        {
+            prefetch_.get(); // Rethrows a failed read
+            front_ ^= 1;
+        }
+        else if (!exhausted_)
+        {
+            load(buffers_[front_ ^ 1], &buffers_[front_]);
+            front_ ^= 1;
+        }
+        else
+        {
+            return false;
+        }
+
+        const Buffer &buffer = buffers_[front_];
+        if (buffer.size == buffer.lookback)
+        {
+            exhausted_ = true;
+            return false;
+        }
+
+        chunk.bars = ColumnarSeriesView{symbol_,
+                                        std::span<const int64_t>(buffer.timestamps.data(), buffer.size),
+                                        std::span<const double>(buffer.open.data(), buffer.size),
+                                        std::span<const double>(buffer.high.data(), buffer.size),
+                                        std::span<const double>(buffer.low.data(), buffer.size),
+                                        std::span<const double>(buffer.close.data(), buffer.size),
+                                        std::span<const double>(buffer.volume.data(), buffer.size)};
+        chunk.lookback = buffer.lookback;
+        chunk.first_bar = buffer.first_bar;
+        bars_read_ += chunk.size();
+
+        // Read the next chunk while the caller works on this one; the
+        // caller only reads the front buffer, which the load only reads too
+        if (thread_pool_ && !exhausted_)
+        {
+            prefetch_ = thread_pool_->submit_background([this]
+                                                        { load(buffers_[front_ ^ 1], &buffers_[front_]); });
+        }
+        return true;
+    }
+
+    void ChunkedSeriesReader::rewind()
+    {
+        wait_for_prefetch();
+        segment_.reset();
+        next_segment_ = 0;
+        cursor_ = 0;
+        next_bar_ = 0;
+        exhausted_ = false;
+        started_ = false;
+        bars_read_ = 0;
+    }
+
+    size_t ChunkedSeriesReader::buffer_bytes() const
+    {
+        size_t bytes = 0;
+        for (const Buffer &buffer : buffers_)
+        {
+            bytes += buffer.timestamps.capacity() * sizeof(int64_t);
+            for (const auto *column : {&buffer.open, &buffer.high, &buffer.low, &buffer.close, &buffer.volume})
+            {
+                bytes += column->capacity() * sizeof(double);
+            }
+        }
+        return bytes;
+    }
+
+    void ChunkedSeriesReader::wait_for_prefetch()
+    {
+        if (prefetch_.valid())
+        {
+            try
+            {
+                prefetch_.get();
+            }
+            catch (...)
+            {
+                // The chunk is being thrown away, and its error with it
+            }
+        }
+    }
+
+    bool ChunkedSeriesReader::open_next_segment()
+    {
+        segment_.reset(); // Unmap the finished segment before mapping the next
+        cursor_ = 0;
+        if (next_segment_ >= segments_)
+        {
+            return false;
+        }
+
+        segment_ = opener_(next_segment_++);
+        if (!segment_)
+        {
+            throw std::runtime_error("Segment " + std::to_string(next_segment_ - 1) + " could not be opened");
+        }
+        if (config_.verify_checksum)
+        {
+            // Hashing touched every page; none of them is needed until its chunk
+            segment_->release(0, segment_->size());
+        }
+        if (next_segment_ == 1)
+        {
+            // Always opened by next() on the calling thread, so symbol() never races a prefetch
+            symbol_ = segment_->symbol();
+        }
+        return true;
+    }
+
+    void ChunkedSeriesReader::load(Buffer &buffer, const Buffer *previous)
+    {
+        const size_t capacity = config_.lookback + config_.chunk_bars;
+        if (buffer.close.size() != capacity)
+        {
+            buffer.timestamps.resize(capacity);
+            for (auto *column : {&buffer.open, &buffer.high, &buffer.low, &buffer.close, &buffer.volume})
+            {
+                column->resize(capacity);
+            }
+        }
+
+        // Carry the tail of the previous chunk over as history
+        size_t keep = previous ? std::min(config_.lookback, previous->size) : 0;
+        if (keep > 0)
+        {
+            size_t from = previous->size - keep;
+            std::memcpy(buffer.timestamps.data(), previous->timestamps.data() + from, keep * sizeof(int64_t));
+            std::memcpy(buffer.open.data(), previous->open.data() + from, keep * sizeof(double));
+            std::memcpy(buffer.high.data(), previous->high.data() + from, keep * sizeof(double));
+            std::memcpy(buffer.low.data(), previous->low.data() + from, keep * sizeof(double));
+            std::memcpy(buffer.close.data(), previous->close.data() + from, keep * sizeof(double));
+            std::memcpy(buffer.volume.data(), previous->volume.data() + from, keep * sizeof(double));
+        }
+
+        const size_t target = keep + config_.chunk_bars;
+        size_t filled = keep;
+        while (filled < target)
+        {
+            if (!segment_ || cursor_ >= segment_->size())
+            {
+                if (!open_next_segment())
+                {
+                    exhausted_ = true;
+                    break;
+                }
+                continue;
+            }
+
+            size_t count = std::min(target - filled, segment_->size() - cursor_);
+            const ColumnarSeriesView &view = segment_->view();
+
+            // Fault the rows in with one read-ahead, copy them out, then
+            // hand the pages back so the mapping never accumulates
+            segment_->prefetch(cursor_, count);
+            std::memcpy(buffer.timestamps.data() + filled, view.timestamps.data() + cursor_, count * sizeof(int64_t));
+            std::memcpy(buffer.open.data() + filled, view.open.data() + cursor_, count * sizeof(double));
+            std::memcpy(buffer.high.data() + filled, view.high.data() + cursor_, count * sizeof(double));
+            std::memcpy(buffer.low.data() + filled, view.low.data() + cursor_, count * sizeof(double));
+            std::memcpy(buffer.close.data() + filled, view.close.data() + cursor_, count * sizeof(double));
+            std::memcpy(buffer.volume.data() + filled, view.volume.data() + cursor_, count * sizeof(double));
+            segment_->release(cursor_, count);
+
+            cursor_ += count;
+            filled += count;
+        }
+
+        buffer.size = filled;
+        buffer.lookback = keep;
+        buffer.first_bar = next_bar_;
+        next_bar_ += filled - keep;
+    }
+
+} // namespace trading
@@ -0,0 +1,487 @@
+#include "data/columnar_file.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace trading
+{
+    namespace
+    {
+        constexpr std::array<char, 8> kMagic = {'T', 'R', 'D', 'C', 'O', 'L', '\r', '\n'};
+        constexpr size_t kAlignment = 64;
+        constexpr size_t kHeaderSize = 64;
+        constexpr size_t kColumnCount = 6;
+        constexpr size_t kDirectorySize = 128; // 6 x 16-byte descriptors, padded
+
+        enum class ValueType : uint32_t
+        {
+            INT64 = 1,
+            FLOAT64 = 2
+        };
+
+        // Column field ids, in the order they appear in ColumnarSeriesView
+        enum class Field : uint32_t
+        {
+            TIMESTAMP = 0,
+            OPEN,
+            HIGH,
+            LOW,
+            CLOSE,
+            VOLUME
+        };
+
+        struct FileHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t column_count;
+            uint64_t row_count;
+            uint64_t file_size;
+            uint32_t symbol_length;
+            uint32_t reserved0;
+            uint64_t data_checksum;   // xxHash64 of bytes [kHeaderSize, file_size)
+            uint64_t header_checksum; // xxHash64 of the header up to this field
+            uint64_t reserved1;
+        };
+        static_assert(sizeof(FileHeader) == kHeaderSize, "Header layout changed");
+        constexpr size_t kHeaderChecksumOffset = offsetof(FileHeader, header_checksum);
+
+        struct ColumnDescriptor
+        {
+            uint32_t field;
+            uint32_t type;
+            uint64_t offset;
+        };
+        static_assert(sizeof(ColumnDescriptor) == 16, "Descriptor layout changed");
+        static_assert(kColumnCount * sizeof(ColumnDescriptor) <= kDirectorySize, "Directory too small");
+
+        constexpr size_t align_up(size_t value)
+        {
+            return (value + kAlignment - 1) & ~(kAlignment - 1);
+        }
+
+        void require_little_endian()
+        {
+            if constexpr (std::endian::native != std::endian::little)
+            {
+                throw std::runtime_error("Columnar cache files require a little-endian host");
+            }
+        }
+
+        // -------------------------------------------------------------------
+        // xxHash64
+        // -------------------------------------------------------------------
+
+        constexpr uint64_t kPrime1 = 11400714785074694791ULL;
+        constexpr uint64_t kPrime2 = 14029467366897019727ULL;
+        constexpr uint64_t kPrime3 = 1609587929392839161ULL;
+        constexpr uint64_t kPrime4 = 9650029242287828579ULL;
+        constexpr uint64_t kPrime5 = 2870177450012600261ULL;
+
+        inline uint64_t read64(const unsigned char *p)
+        {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline uint32_t read32(const unsigned char *p)
+        {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline uint64_t xxh_round(uint64_t acc, uint64_t input)
+        {
+            acc += input * kPrime2;
+            acc = std::rotl(acc, 31);
+            return acc * kPrime1;
+        }
+
+        inline uint64_t xxh_merge(uint64_t acc, uint64_t value)
+        {
+            acc ^= xxh_round(0, value);
+            return acc * kPrime1 + kPrime4;
+        }
+    }
+
+    uint64_t xxhash64(const void *data, size_t length, uint64_t seed)
+    {
+        const auto *p = static_cast<const unsigned char *>(data);
+        const unsigned char *end = p + length;
+        uint64_t h;
+
+        if (length >= 32)
+        {
+            // Four independent lanes over 32-byte stripes
+            uint64_t v1 = seed + kPrime1 + kPrime2;
+            uint64_t v2 = seed + kPrime2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - kPrime1;
+            const unsigned char *limit = end - 32;
+            do
+            {
+                v1 = xxh_round(v1, read64(p));
+                v2 = xxh_round(v2, read64(p + 8));
+                v3 = xxh_round(v3, read64(p + 16));
+                v4 = xxh_round(v4, read64(p + 24));
+                p += 32;
+            } while (p <= limit);
+
+            h = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+            h = xxh_merge(h, v1);
+            h = xxh_merge(h, v2);
+            h = xxh_merge(h, v3);
+            h = xxh_merge(h, v4);
+        }
+        else
+        {
+            h = seed + kPrime5;
+        }
+
+        h += static_cast<uint64_t>(length);
+
+        // Tail
+        for (; p + 8 <= end; p += 8)
+        {
+            h ^= xxh_round(0, read64(p));
+            h = std::rotl(h, 27) * kPrime1 + kPrime4;
+        }
+        if (p + 4 <= end)
+        {
+            h ^= static_cast<uint64_t>(read32(p)) * kPrime1;
+            h = std::rotl(h, 23) * kPrime2 + kPrime3;
+            p += 4;
+        }
+        for (; p < end; ++p)
+        {
+            h ^= static_cast<uint64_t>(*p) * kPrime5;
+            h = std::rotl(h, 11) * kPrime1;
+        }
+
+        // Avalanche
+        h ^= h >> 33;
+        h *= kPrime2;
+        h ^= h >> 29;
+        h *= kPrime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    void write_columnar_file(const std::string &path, const ColumnarSeriesView &series)
+    {
+        require_little_endian();
+
+        const size_t rows = series.size();
+        if (series.timestamps.size() != rows || series.open.size() != rows || series.high.size() != rows ||
+            series.low.size() != rows || series.volume.size() != rows)
+        {
+            throw std::invalid_argument("All columns must have the same length");
+        }
+
+        // Lay out the file
+        const size_t column_bytes = rows * sizeof(double);
+        const size_t symbol_offset = kHeaderSize + kDirectorySize;
+        size_t offset = align_up(symbol_offset + series.symbol.size());
+        std::array<ColumnDescriptor, kColumnCount> directory{};
+        for (size_t c = 0; c < kColumnCount; ++c)
+        {
+            directory[c].field = static_cast<uint32_t>(c);
+            directory[c].type = static_cast<uint32_t>(c == 0 ? ValueType::INT64 : ValueType::FLOAT64);
+            directory[c].offset = offset;
+            offset = align_up(offset + column_bytes);
+        }
+        const size_t file_size = offset;
+
+        // Build the image in memory so the checksum is computed in one pass
+        std::vector<std::byte> image(file_size);
+        std::memcpy(image.data() + kHeaderSize, directory.data(), sizeof(directory));
+        if (!series.symbol.empty())
+        {
+            std::memcpy(image.data() + symbol_offset, series.symbol.data(), series.symbol.size());
+        }
+
+        const void *columns[kColumnCount] = {series.timestamps.data(), series.open.data(), series.high.data(),
+                                             series.low.data(), series.close.data(), series.volume.data()};
+        for (size_t c = 0; c < kColumnCount; ++c)
+        {
+            if (column_bytes > 0)
+            {
+                std::memcpy(image.data() + directory[c].offset, columns[c], column_bytes);
+            }
+        }
+
+        FileHeader header{};
+        std::memcpy(header.magic, kMagic.data(), kMagic.size());
+        header.version = kColumnarFileVersion;
+        header.column_count = static_cast<uint32_t>(kColumnCount);
+        header.row_count = rows;
+        header.file_size = file_size;
+        header.symbol_length = static_cast<uint32_t>(series.symbol.size());
+        header.data_checksum = xxhash64(image.data() + kHeaderSize, file_size - kHeaderSize);
+        header.header_checksum = xxhash64(&header, kHeaderChecksumOffset);
+        std::memcpy(image.data(), &header, sizeof(header));
+
+        // Write beside the target and rename over it
+        std::string temp_path = path + ".tmp." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        {
+            std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                throw std::runtime_error("Failed to open " + temp_path + " for writing");
+            }
+            file.write(reinterpret_cast<const char *>(image.data()), static_cast<std::streamsize>(image.size()));
+            if (!file)
+            {
+                throw std::runtime_error("Failed to write " + temp_path);
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temp_path, path, ec);
+        if (ec)
+        {
+            std::filesystem::remove(temp_path);
+            throw std::runtime_error("Failed to replace " + path + ": " + ec.message());
+        }
+    }
+
+    std::shared_ptr<MappedColumnarFile> MappedColumnarFile::open(const std::string &path, bool verify_checksum)
+    {
+        require_little_endian();
+
+        std::shared_ptr<MappedColumnarFile> file(new MappedColumnarFile());
+        file->map(path);
+        file->validate(path, verify_checksum);
+        return file;
+    }
+
+    bool MappedColumnarFile::is_columnar_file(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::array<char, 8> magic{};
+        file.read(magic.data(), magic.size());
+        return file && magic == kMagic;
+    }
+
+    MappedColumnarFile::~MappedColumnarFile()
+    {
+        if (data_ == nullptr)
+        {
+            return;
+        }
+#if !defined(_WIN32)
+        if (mapped_)
+        {
+            munmap(const_cast<std::byte *>(data_), length_);
+            return;
+        }
+#endif
+        ::operator delete(const_cast<std::byte *>(data_), std::align_val_t(kAlignment));
+    }
+
+    void MappedColumnarFile::map(const std::string &path)
+    {
+#if !defined(_WIN32)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Failed to open columnar file " + path);
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("Failed to stat columnar file " + path);
+        }
+        length_ = static_cast<size_t>(st.st_size);
+
+        if (length_ > 0)
+        {
+            void *addr = mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("Failed to map columnar file " + path);
+            }
+            data_ = static_cast<const std::byte *>(addr);
+            mapped_ = true;
+        }
+        // The mapping keeps the file referenced after the descriptor closes
+        ::close(fd);
+#else
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open columnar file " + path);
+        }
+        length_ = static_cast<size_t>(file.tellg());
+        file.seekg(0);
+
+        if (length_ > 0)
+        {
+            auto *buffer = static_cast<std::byte *>(::operator new(length_, std::align_val_t(kAlignment)));
+            data_ = buffer;
+            if (!file.read(reinterpret_cast<char *>(buffer), static_cast<std::streamsize>(length_)))
+            {
+                throw std::runtime_error("Failed to read columnar file " + path);
+            }
+        }
+#endif
+    }
+
+    void MappedColumnarFile::validate(const std::string &path, bool verify_checksum)
+    {
+        auto fail = [&path](const std::string &reason)
+        {
+            throw std::runtime_error("Invalid columnar file " + path + ": " + reason);
+        };
+
+        if (length_ < kHeaderSize + kDirectorySize)
+        {
+            fail("truncated header");
+        }
+
+        FileHeader header;
+        std::memcpy(&header, data_, sizeof(header));
+
+        if (std::memcmp(header.magic, kMagic.data(), kMagic.size()) != 0)
+        {
+            fail("bad magic");
+        }
+        if (header.header_checksum != xxhash64(&header, kHeaderChecksumOffset))
+        {
+            fail("header checksum mismatch");
+        }
+        if (header.version != kColumnarFileVersion)
+        {
+            fail("unsupported version " + std::to_string(header.version));
+        }
+        if (header.column_count != kColumnCount)
+        {
+            fail("unexpected column count");
+        }
+        if (header.file_size != length_)
+        {
+            fail("file size mismatch");
+        }
+
+        const size_t symbol_offset = kHeaderSize + kDirectorySize;
+        if (header.symbol_length > length_ - symbol_offset)
+        {
+            fail("symbol out of range");
+        }
+        if (header.row_count > length_ / sizeof(double))
+        {
+            fail("row count out of range");
+        }
+
+        if (verify_checksum && header.data_checksum != xxhash64(data_ + kHeaderSize, length_ - kHeaderSize))
+        {
+            fail("data checksum mismatch");
+        }
+
+        // Resolve each column through the directory
+        const size_t rows = static_cast<size_t>(header.row_count);
+        const size_t column_bytes = rows * sizeof(double);
+        const std::byte *columns[kColumnCount] = {};
+        for (size_t c = 0; c < kColumnCount; ++c)
+        {
+            ColumnDescriptor descriptor;
+            std::memcpy(&descriptor, data_ + kHeaderSize + c * sizeof(ColumnDescriptor), sizeof(descriptor));
+
+            if (descriptor.field >= kColumnCount || columns[descriptor.field] != nullptr)
+            {
+                fail("bad column directory");
+            }
+            auto expected = descriptor.field == static_cast<uint32_t>(Field::TIMESTAMP) ? ValueType::INT64 : ValueType::FLOAT64;
+            if (descriptor.type != static_cast<uint32_t>(expected))
+            {
+                fail("unexpected column type");
+            }
+            if (descriptor.offset % kAlignment != 0 || descriptor.offset < symbol_offset + header.symbol_length ||
+                descriptor.offset > length_ || column_bytes > length_ - descriptor.offset)
+            {
+                fail("column out of range");
+            }
+            columns[descriptor.field] = data_ + descriptor.offset;
+        }
+
+        symbol_.assign(reinterpret_cast<const char *>(data_ + symbol_offset), header.symbol_length);
+
+        auto doubles = [&](Field field)
+        {
+            return std::span<const double>(reinterpret_cast<const double *>(columns[static_cast<size_t>(field)]), rows);
+        };
+        view_ = ColumnarSeriesView{symbol_,
+                                   std::span<const int64_t>(reinterpret_cast<const int64_t *>(columns[0]), rows),
+                                   doubles(Field::OPEN),
+                                   doubles(Field::HIGH),
+                                   doubles(Field::LOW),
+                                   doubles(Field::CLOSE),
+                                   doubles(Field::VOLUME)};
+    }
+
+    void MappedColumnarFile::prefetch(size_t offset, size_t count) const
+    {
+        advise(offset, count, true);
+    }
+
+    void MappedColumnarFile::release(size_t offset, size_t count) const
+    {
+        advise(offset, count, false);
+    }
+
+    void MappedColumnarFile::advise(size_t offset, size_t count, bool will_need) const
+    {
+#if !defined(_WIN32)
+        if (!mapped_ || offset >= view_.size())
+        {
+            return;
+        }
+        count = std::min(count, view_.size() - offset);
+        if (count == 0)
+        {
+            return;
+        }
+
+        // madvise wants a page-aligned start; the length is rounded up for us
+        const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        auto range = [&](const void *column, size_t value_size)
+        {
+            uintptr_t begin = reinterpret_cast<uintptr_t>(column) + offset * value_size;
+            uintptr_t first = begin & ~(page - 1);
+            madvise(reinterpret_cast<void *>(first), begin + count * value_size - first,
+                    will_need ? MADV_WILLNEED : MADV_DONTNEED);
+        };
+        range(view_.timestamps.data(), sizeof(int64_t));
+        for (const auto &column : {view_.open, view_.high, view_.low, view_.close, view_.volume})
+        {
+            range(column.data(), sizeof(double));
+        }
+#else
+        (void)offset;
+        (void)count;
+        (void)will_need;
+#endif
+    }
+
+} // namespace trading
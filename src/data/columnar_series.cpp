@@ -0,0 +1,85 @@
+#include "data/columnar_series.h"
+
+namespace trading
+{
+    MarketDataSeries ColumnarSeriesView::to_series() const
+    {
+        MarketDataSeries series{std::string(symbol)};
+        series.reserve(size());
+
+        for (size_t i = 0; i < size(); ++i)
+        {
+            series.add_point(point(i));
+        }
+
+        return series;
+    }
+
+    ColumnarSeries ColumnarSeries::from_series(const MarketDataSeries &series)
+    {
+        ColumnarSeries columnar(series.symbol());
+        columnar.resize(series.size());
+
+        // Single pass scattering each field into its column
+        const auto &data = series.data();
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            const auto &point = data[i];
+            columnar.timestamps_[i] = to_epoch_nanos(point.timestamp);
+            columnar.open_[i] = point.open;
+            columnar.high_[i] = point.high;
+            columnar.low_[i] = point.low;
+            columnar.close_[i] = point.close;
+            columnar.volume_[i] = static_cast<double>(point.volume);
+        }
+
+        return columnar;
+    }
+
+    void ColumnarSeries::add_point(const MarketDataPoint &point)
+    {
+        add_point(to_epoch_nanos(point.timestamp), point.open, point.high, point.low, point.close,
+                  static_cast<double>(point.volume));
+    }
+
+    void ColumnarSeries::add_point(int64_t timestamp_nanos, double open, double high, double low, double close, double volume)
+    {
+        timestamps_.push_back(timestamp_nanos);
+        open_.push_back(open);
+        high_.push_back(high);
+        low_.push_back(low);
+        close_.push_back(close);
+        volume_.push_back(volume);
+    }
+
+    void ColumnarSeries::reserve(size_t capacity)
+    {
+        timestamps_.reserve(capacity);
+        open_.reserve(capacity);
+        high_.reserve(capacity);
+        low_.reserve(capacity);
+        close_.reserve(capacity);
+        volume_.reserve(capacity);
+    }
+
+    void ColumnarSeries::resize(size_t count)
+    {
+        timestamps_.resize(count);
+        open_.resize(count);
+        high_.resize(count);
+        low_.resize(count);
+        close_.resize(count);
+        volume_.resize(count);
+    }
+
+    void ColumnarSeries::clear()
+    {
+        timestamps_.clear();
+        open_.clear();
+        high_.clear();
+        low_.clear();
+        close_.clear();
+        volume_.clear();
+    }
+
+} // namespace trading
@@ -1,11 +1,131 @@
 #include "data/data_processor.h"
+#include "data/indicator_cache.h"
+#include "data/indicator_pipeline.h"
+#include "data/rolling_window.h"
+#include "data/simd_kernels.h"
+#include "core/thread_pool.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
 #include <stdexcept>
+#include <limits>
+#include <bit>
 
 namespace trading
 {
+    namespace
+    {
+        // Count, mean and sum of squared deviations of the finite values
+        // of one chunk
+        struct ChunkMoments
+        {
+            size_t count = 0;
+            double mean = 0.0;
+            double m2 = 0.0;
+        };
+
+        ChunkMoments chunk_moments(std::span<const double> values)
+        {
+            ChunkMoments moments;
+            double sum = simd::sum(values);
+            if (std::isfinite(sum))
+            {
+                moments.count = values.size();
+                moments.mean = sum / values.size();
+                moments.m2 = simd::sum_squared_deviations(values, moments.mean);
+                return moments;
+            }
+
+            // Rare: skip the non-finite values one by one
+            for (double value : values)
+            {
+                if (std::isfinite(value))
+                {
+                    ++moments.count;
+                    double delta = value - moments.mean;
+                    moments.mean += delta / moments.count;
+                    moments.m2 += delta * (value - moments.mean);
+                }
+            }
+            return moments;
+        }
+
+        // Chan et al. pairwise update; merging in chunk order keeps the
+        // result independent of which thread summarised which chunk
+        void merge_moments(ChunkMoments &total, const ChunkMoments &chunk)
+        {
+            if (chunk.count == 0)
+            {
+                return;
+            }
+            if (total.count == 0)
+            {
+                // Copied as is, so a single chunk gives the plain two-pass result
+                total = chunk;
+                return;
+            }
+            size_t count = total.count + chunk.count;
+            double delta = chunk.mean - total.mean;
+            total.m2 += chunk.m2 + delta * delta * (static_cast<double>(total.count) * chunk.count / count);
+            total.mean += delta * chunk.count / count;
+            total.count = count;
+        }
+
+        bool is_outlier(const std::pmr::vector<uint64_t> &mask, size_t index)
+        {
+            return (mask[index / 64] >> (index % 64)) & 1;
+        }
+
+        // Bar fields clean_data reads, for both the AoS and columnar paths
+        template <typename Timestamp, typename Volume>
+        struct CleanBar
+        {
+            Timestamp timestamp;
+            double open;
+            double high;
+            double low;
+            double close;
+            Volume volume;
+        };
+
+        // The fused clean, fill and validate pass: skips outliers, fills
+        // invalid prices from the previous kept close, drops bars that are
+        // still invalid and calls emit(bar) for each kept bar in order
+        template <typename Bar, typename Get, typename Valid, typename Emit>
+        void clean_pass(size_t n, const std::pmr::vector<uint64_t> &mask, Get &&get, Valid &&is_valid_price, Emit &&emit)
+        {
+            bool have_previous = false;
+            Bar previous{};
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (is_outlier(mask, i))
+                {
+                    continue;
+                }
+
+                Bar bar = get(i);
+                bool filled = true;
+                for (double *price : {&bar.open, &bar.high, &bar.low, &bar.close})
+                {
+                    if (!is_valid_price(*price))
+                    {
+                        *price = previous.close;
+                        filled = have_previous;
+                    }
+                }
+                if (!filled || !(bar.high >= bar.low) || !(bar.volume >= 0) ||
+                    (have_previous && bar.timestamp < previous.timestamp))
+                {
+                    continue;
+                }
+
+                emit(bar);
+                previous = bar;
+                have_previous = true;
+            }
+        }
+    } // namespace
+
     MarketDataSeries DataProcessor::clean_data(const MarketDataSeries &series)
     {
         MarketDataSeries cleaned_series(series.symbol());
@@ -19,121 +139,158 @@ namespace trading
         cleaned_series.reserve(series.size());
 
         // Extract prices for outlier detection
-        std::vector<double> prices;
+        std::pmr::vector<double> prices(scratch_resource());
         prices.reserve(series.size());
         for (const auto &point : series.data())
         {
             prices.push_back(point.close);
         }
 
-        // Detect outliers
-        auto outlier_indices = detect_outliers(prices, 3.0);
+        auto mask = outlier_mask(prices, 3.0);
 
-        // Add non-outlier points to cleaned series
-        for (size_t i = 0; i < series.size(); ++i)
-        {
-            if (std::find(outlier_indices.begin(), outlier_indices.end(), i) == outlier_indices.end())
+        using Bar = CleanBar<std::chrono::system_clock::time_point, int64_t>;
+        clean_pass<Bar>(
+            series.size(), mask,
+            [&series](size_t i)
             {
-                cleaned_series.add_point(series[i]);
-            }
+                const auto &point = series[i];
+                return Bar{point.timestamp, point.open, point.high, point.low, point.close, point.volume};
+            },
+            [this](double price)
+            { return is_valid_price(price); },
+            [&cleaned_series](const Bar &bar)
+            {
+                cleaned_series.add_point(MarketDataPoint(bar.timestamp, bar.open, bar.high, bar.low, bar.close, bar.volume));
+            });
+
+        return cleaned_series;
+    }
+
+    ColumnarSeries DataProcessor::clean_data(const ColumnarSeriesView &series)
+    {
+        ColumnarSeries cleaned_series{std::string(series.symbol)};
+
+        if (series.empty())
+        {
+            return cleaned_series;
         }
 
+        cleaned_series.reserve(series.size());
+
+        // Outlier detection reads the close column in place
+        auto mask = outlier_mask(series.close, 3.0);
+
+        using Bar = CleanBar<int64_t, double>;
+        clean_pass<Bar>(
+            series.size(), mask,
+            [&series](size_t i)
+            {
+                return Bar{series.timestamps[i], series.open[i], series.high[i], series.low[i], series.close[i], series.volume[i]};
+            },
+            [this](double price)
+            { return is_valid_price(price); },
+            [&cleaned_series](const Bar &bar)
+            {
+                cleaned_series.add_point(bar.timestamp, bar.open, bar.high, bar.low, bar.close, bar.volume);
+            });
+
         return cleaned_series;
     }
 
     TechnicalIndicators DataProcessor::calculate_indicators(const MarketDataSeries &series)
     {
-        TechnicalIndicators indicators;
-
         if (series.empty())
         {
-            return indicators;
+            return TechnicalIndicators{};
+        }
+
+        if (indicator_cache_)
+        {
+            return *indicator_cache_->calculate_indicators(series);
         }
 
-        // Extract close prices
-        std::vector<double> prices;
+        // Gather the two columns the indicators need
+        std::pmr::vector<double> prices(scratch_resource());
+        std::pmr::vector<double> volumes(scratch_resource());
         prices.reserve(series.size());
+        volumes.reserve(series.size());
         for (const auto &point : series.data())
         {
             prices.push_back(point.close);
+            volumes.push_back(static_cast<double>(point.volume));
         }
 
-        // Calculate indicators
-        indicators.sma_20 = calculate_sma(prices, 20);
-        indicators.sma_50 = calculate_sma(prices, 50);
-        indicators.ema_12 = calculate_ema(prices, 12);
-        indicators.ema_26 = calculate_ema(prices, 26);
-        indicators.rsi = calculate_rsi(prices, 14);
+        return calculate_indicators(prices, volumes);
+    }
+
+    TechnicalIndicators DataProcessor::calculate_indicators(const ColumnarSeriesView &series)
+    {
+        if (series.empty())
+        {
+            return TechnicalIndicators{};
+        }
 
-        auto macd_result = calculate_macd(prices, 12, 26, 9);
-        indicators.macd = macd_result.first;
-        indicators.macd_signal = macd_result.second;
+        return calculate_indicators(series.close, series.volume);
+    }
 
-        auto bollinger_result = calculate_bollinger_bands(prices, 20, 2.0);
-        indicators.bollinger_upper = bollinger_result.first;
-        indicators.bollinger_lower = bollinger_result.second;
+    TechnicalIndicators DataProcessor::calculate_indicators(std::span<const double> prices, std::span<const double> volumes)
+    {
+        TechnicalIndicators indicators;
+        std::vector<double> *columns[] = {&indicators.sma_20, &indicators.sma_50, &indicators.ema_12,
+                                          &indicators.ema_26, &indicators.rsi, &indicators.macd,
+                                          &indicators.macd_signal, &indicators.bollinger_upper,
+                                          &indicators.bollinger_lower, &indicators.volume_sma};
+
+        // One fused pass over both columns instead of one pass per indicator
+        StandardIndicatorPipeline::Outputs outputs;
+        for (size_t k = 0; k < outputs.size(); ++k)
+        {
+            columns[k]->resize(prices.size());
+            outputs[k] = *columns[k];
+        }
+        StandardIndicatorPipeline pipeline;
+        pipeline.process(prices, volumes, outputs);
 
-        // Calculate volume SMA
-        std::vector<double> volumes;
-        volumes.reserve(series.size());
-        for (const auto &point : series.data())
+        // calculate_rsi has no output until there is a price change
+        if (prices.size() < 2)
         {
-            volumes.push_back(static_cast<double>(point.volume));
+            indicators.rsi.clear();
         }
-        indicators.volume_sma = calculate_sma(volumes, 20);
 
         return indicators;
     }
 
-    std::vector<double> DataProcessor::calculate_sma(const std::vector<double> &prices, int period) const
+    std::vector<double> DataProcessor::calculate_sma(std::span<const double> prices, int period) const
     {
         std::vector<double> sma;
         sma.reserve(prices.size());
 
-        for (size_t i = 0; i < prices.size(); ++i)
+        // Running window sum, O(1) per point
+        RollingMean window(period);
+        for (double price : prices)
         {
-            if (i < static_cast<size_t>(period - 1))
-            {
-                sma.push_back(std::numeric_limits<double>::quiet_NaN());
-            }
-            else
-            {
-                double sum = 0.0;
-                for (int j = 0; j < period; ++j)
-                {
-                    sum += prices[i - j];
-                }
-                sma.push_back(sum / period);
-            }
+            window.push(price);
+            sma.push_back(window.value());
         }
 
         return sma;
     }
 
-    std::vector<double> DataProcessor::calculate_ema(const std::vector<double> &prices, int period) const
+    std::vector<double> DataProcessor::calculate_ema(std::span<const double> prices, int period) const
     {
         std::vector<double> ema;
         ema.reserve(prices.size());
 
-        double multiplier = 2.0 / (period + 1);
-
-        for (size_t i = 0; i < prices.size(); ++i)
+        EmaState state(period);
+        for (double price : prices)
         {
-            if (i == 0)
-            {
-                ema.push_back(prices[0]);
-            }
-            else
-            {
-                double new_ema = (prices[i] * multiplier) + (ema[i - 1] * (1 - multiplier));
-                ema.push_back(new_ema);
-            }
+            ema.push_back(state.push(price));
         }
 
         return ema;
     }
 
-    std::vector<double> DataProcessor::calculate_rsi(const std::vector<double> &prices, int period) const
+    std::vector<double> DataProcessor::calculate_rsi(std::span<const double> prices, int period) const
     {
         std::vector<double> rsi;
         rsi.reserve(prices.size());
@@ -143,155 +300,135 @@ namespace trading
             return rsi;
         }
 
-        // Calculate price changes
-        std::vector<double> gains, losses;
-        gains.reserve(prices.size());
-        losses.reserve(prices.size());
-
-        for (size_t i = 1; i < prices.size(); ++i)
-        {
-            double change = prices[i] - prices[i - 1];
-            gains.push_back(change > 0 ? change : 0.0);
-            losses.push_back(change < 0 ? -change : 0.0);
-        }
-
-        // Calculate RSI
-        for (size_t i = 0; i < prices.size(); ++i)
+        // Wilder smoothing carries the averages forward, O(1) per point
+        WilderRsi state(period);
+        for (double price : prices)
         {
-            if (i < static_cast<size_t>(period))
-            {
-                rsi.push_back(std::numeric_limits<double>::quiet_NaN());
-            }
-            else
-            {
-                double avg_gain = 0.0, avg_loss = 0.0;
-
-                for (int j = 0; j < period; ++j)
-                {
-                    avg_gain += gains[i - period + j];
-                    avg_loss += losses[i - period + j];
-                }
-
-                avg_gain /= period;
-                avg_loss /= period;
-
-                if (avg_loss == 0.0)
-                {
-                    rsi.push_back(100.0);
-                }
-                else
-                {
-                    double rs = avg_gain / avg_loss;
-                    rsi.push_back(100.0 - (100.0 / (1.0 + rs)));
-                }
-            }
+            rsi.push_back(state.push(price));
         }
 
         return rsi;
     }
 
     std::pair<std::vector<double>, std::vector<double>> DataProcessor::calculate_macd(
-        const std::vector<double> &prices, int fast_period, int slow_period, int signal_period) const
+        std::span<const double> prices, int fast_period, int slow_period, int signal_period) const
     {
 
-        auto fast_ema = calculate_ema(prices, fast_period);
-        auto slow_ema = calculate_ema(prices, slow_period);
-
-        std::vector<double> macd_line;
+        std::vector<double> macd_line, signal_line;
         macd_line.reserve(prices.size());
+        signal_line.reserve(prices.size());
 
-        for (size_t i = 0; i < prices.size(); ++i)
+        // Both EMAs and the signal line advance together in one pass
+        EmaState fast_ema(fast_period), slow_ema(slow_period), signal_ema(signal_period);
+        for (double price : prices)
         {
-            if (std::isnan(fast_ema[i]) || std::isnan(slow_ema[i]))
-            {
-                macd_line.push_back(std::numeric_limits<double>::quiet_NaN());
-            }
-            else
-            {
-                macd_line.push_back(fast_ema[i] - slow_ema[i]);
-            }
+            double fast = fast_ema.push(price);
+            double slow = slow_ema.push(price);
+            double macd = (std::isnan(fast) || std::isnan(slow)) ? std::numeric_limits<double>::quiet_NaN() : fast - slow;
+            macd_line.push_back(macd);
+            signal_line.push_back(signal_ema.push(macd));
         }
 
-        auto signal_line = calculate_ema(macd_line, signal_period);
-
-        return {macd_line, signal_line};
+        return {std::move(macd_line), std::move(signal_line)};
     }
 
     std::pair<std::vector<double>, std::vector<double>> DataProcessor::calculate_bollinger_bands(
-        const std::vector<double> &prices, int period, double std_dev_multiplier) const
+        std::span<const double> prices, int period, double std_dev_multiplier) const
     {
 
         std::vector<double> upper_band, lower_band;
         upper_band.reserve(prices.size());
         lower_band.reserve(prices.size());
 
-        for (size_t i = 0; i < prices.size(); ++i)
+        // Rolling Welford mean/variance, O(1) per point
+        RollingMeanVariance window(period);
+        for (double price : prices)
         {
-            if (i < static_cast<size_t>(period - 1))
-            {
-                upper_band.push_back(std::numeric_limits<double>::quiet_NaN());
-                lower_band.push_back(std::numeric_limits<double>::quiet_NaN());
-            }
-            else
-            {
-                double sma = 0.0;
-                for (int j = 0; j < period; ++j)
-                {
-                    sma += prices[i - j];
-                }
-                sma /= period;
-
-                double variance = 0.0;
-                for (int j = 0; j < period; ++j)
-                {
-                    double diff = prices[i - j] - sma;
-                    variance += diff * diff;
-                }
-                variance /= period;
+            window.push(price);
+            double sma = window.mean();
+            double std_dev = window.std_dev();
+            upper_band.push_back(sma + (std_dev_multiplier * std_dev));
+            lower_band.push_back(sma - (std_dev_multiplier * std_dev));
+        }
 
-                double std_dev = std::sqrt(variance);
+        return {std::move(upper_band), std::move(lower_band)};
+    }
 
-                upper_band.push_back(sma + (std_dev_multiplier * std_dev));
-                lower_band.push_back(sma - (std_dev_multiplier * std_dev));
+    std::vector<size_t> DataProcessor::detect_outliers(std::span<const double> prices, double threshold) const
+    {
+        std::vector<size_t> outliers;
+        auto mask = outlier_mask(prices, threshold);
+        for (size_t w = 0; w < mask.size(); ++w)
+        {
+            for (uint64_t bits = mask[w]; bits != 0; bits &= bits - 1)
+            {
+                outliers.push_back(w * 64 + static_cast<size_t>(std::countr_zero(bits)));
             }
         }
 
-        return {upper_band, lower_band};
+        return outliers;
     }
 
-    std::vector<size_t> DataProcessor::detect_outliers(const std::vector<double> &prices, double threshold) const
+    std::pmr::vector<uint64_t> DataProcessor::outlier_mask(std::span<const double> prices, double threshold) const
     {
-        std::vector<size_t> outliers;
+        std::pmr::vector<uint64_t> mask((prices.size() + 63) / 64, 0, scratch_resource());
 
         if (prices.size() < 2)
         {
-            return outliers;
+            return mask;
         }
 
-        // Calculate mean and standard deviation
-        double mean = std::accumulate(prices.begin(), prices.end(), 0.0) / prices.size();
-
-        double variance = 0.0;
-        for (double price : prices)
+        const size_t chunks = (prices.size() + kCleanChunkPoints - 1) / kCleanChunkPoints;
+        auto chunk_span = [&](size_t c)
         {
-            double diff = price - mean;
-            variance += diff * diff;
-        }
-        variance /= prices.size();
-
-        double std_dev = std::sqrt(variance);
-
-        // Find outliers
-        for (size_t i = 0; i < prices.size(); ++i)
+            size_t first = c * kCleanChunkPoints;
+            return prices.subspan(first, std::min(kCleanChunkPoints, prices.size() - first));
+        };
+        auto run = [&](auto &&body)
         {
-            double z_score = std::abs(prices[i] - mean) / std_dev;
-            if (z_score > threshold)
+            if (thread_pool_ && chunks > 1)
             {
-                outliers.push_back(i);
+                thread_pool_->parallel_for(0, chunks, body, 1);
             }
+            else
+            {
+                for (size_t c = 0; c < chunks; ++c)
+                {
+                    body(c);
+                }
+            }
+        };
+
+        // Calculate mean and standard deviation, one chunk per task
+        std::pmr::vector<ChunkMoments> moments(chunks, scratch_resource());
+        run([&](size_t c)
+            { moments[c] = chunk_moments(chunk_span(c)); });
+        ChunkMoments total;
+        for (const auto &chunk : moments)
+        {
+            merge_moments(total, chunk);
         }
+        if (total.count < 2)
+        {
+            return mask;
+        }
+        double mean = total.mean;
+        double std_dev = std::sqrt(total.m2 / total.count);
 
-        return outliers;
+        // Find outliers; chunks start on a word boundary, so each task
+        // owns the mask words it writes
+        run([&](size_t c)
+            {
+                std::vector<size_t> indices;
+                simd::append_outliers(chunk_span(c), mean, std_dev, threshold, indices);
+                uint64_t *words = mask.data() + c * (kCleanChunkPoints / 64);
+                for (size_t i : indices)
+                {
+                    words[i / 64] |= uint64_t{1} << (i % 64);
+                }
+            });
+
+        return mask;
     }
 
     MarketDataSeries DataProcessor::fill_missing_data(const MarketDataSeries &series) const
@@ -335,82 +472,56 @@ namespace trading
         return filled_series;
     }
 
-    std::vector<double> DataProcessor::normalize_prices(const std::vector<double> &prices) const
+    std::vector<double> DataProcessor::normalize_prices(std::span<const double> prices) const
     {
         if (prices.empty())
         {
             return {};
         }
 
-        double min_price = *std::min_element(prices.begin(), prices.end());
-        double max_price = *std::max_element(prices.begin(), prices.end());
+        auto [min_price, max_price] = simd::min_max(prices);
 
         if (max_price == min_price)
         {
             return std::vector<double>(prices.size(), 0.5);
         }
 
-        std::vector<double> normalized;
-        normalized.reserve(prices.size());
-
-        for (double price : prices)
-        {
-            normalized.push_back((price - min_price) / (max_price - min_price));
-        }
+        std::vector<double> normalized(prices.size());
+        simd::normalize(prices, min_price, max_price - min_price, normalized);
 
         return normalized;
     }
 
-    std::vector<double> DataProcessor::calculate_returns(const std::vector<double> &prices) const
+    std::vector<double> DataProcessor::calculate_returns(std::span<const double> prices) const
     {
-        std::vector<double> returns;
-        returns.reserve(prices.size());
-
         if (prices.size() < 2)
         {
-            return returns;
+            return {};
         }
 
-        returns.push_back(0.0); // First return is 0
-
-        for (size_t i = 1; i < prices.size(); ++i)
-        {
-            if (prices[i - 1] != 0.0)
-            {
-                double ret = (prices[i] - prices[i - 1]) / prices[i - 1];
-                returns.push_back(ret);
-            }
-            else
-            {
-                returns.push_back(0.0);
-            }
-        }
+        // First return is 0
+        std::vector<double> returns(prices.size());
+        simd::simple_returns(prices, returns);
 
         return returns;
     }
 
-    std::vector<double> DataProcessor::calculate_volatility(const std::vector<double> &returns, int window) const
+    std::vector<double> DataProcessor::calculate_volatility(std::span<const double> returns, int window) const
     {
         std::vector<double> volatility;
         volatility.reserve(returns.size());
 
-        for (size_t i = 0; i < returns.size(); ++i)
+        RollingMeanVariance window_stats(window);
+        for (double ret : returns)
         {
-            if (i < static_cast<size_t>(window - 1))
-            {
-                volatility.push_back(std::numeric_limits<double>::quiet_NaN());
-            }
-            else
-            {
-                double std_dev = calculate_std_dev(returns, i - window + 1, i + 1);
-                volatility.push_back(std_dev * std::sqrt(252.0)); // Annualized volatility
-            }
+            window_stats.push(ret);
+            volatility.push_back(window_stats.std_dev() * std::sqrt(252.0)); // Annualized volatility
         }
 
         return volatility;
     }
 
-    double DataProcessor::calculate_std_dev(const std::vector<double> &values, size_t start, size_t end) const
+    double DataProcessor::calculate_std_dev(std::span<const double> values, size_t start, size_t end) const
     {
         if (start >= end || start >= values.size())
         {
@@ -437,7 +548,7 @@ namespace trading
         return std::sqrt(variance);
     }
 
-    std::vector<double> DataProcessor::calculate_gains_losses(const std::vector<double> &prices) const
+    std::vector<double> DataProcessor::calculate_gains_losses(std::span<const double> prices) const
     {
         std::vector<double> gains_losses;
         gains_losses.reserve(prices.size());
@@ -0,0 +1,74 @@
+#include "data/incremental_indicators.h"
+#include <cmath>
+#include <limits>
+
+namespace trading
+{
+    namespace
+    {
+        constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    IncrementalIndicators::IncrementalIndicators(bool record_history)
+        : record_history_(record_history),
+          latest_{kNaN, kNaN, kNaN, kNaN, kNaN, kNaN, kNaN, kNaN, kNaN, kNaN}
+    {
+    }
+
+    const IndicatorValues &IncrementalIndicators::update(double close, double volume)
+    {
+        // Moving averages
+        sma_20_.push(close);
+        sma_50_.push(close);
+        latest_.sma_20 = sma_20_.value();
+        latest_.sma_50 = sma_50_.value();
+        latest_.ema_12 = ema_12_.push(close);
+        latest_.ema_26 = ema_26_.push(close);
+
+        latest_.rsi = rsi_.push(close);
+
+        // MACD, same expression as DataProcessor::calculate_macd
+        double fast = macd_fast_.push(close);
+        double slow = macd_slow_.push(close);
+        latest_.macd = (std::isnan(fast) || std::isnan(slow)) ? kNaN : fast - slow;
+        latest_.macd_signal = macd_signal_.push(latest_.macd);
+
+        // Bollinger Bands (20, 2.0)
+        bollinger_.push(close);
+        double mean = bollinger_.mean();
+        double std_dev = bollinger_.std_dev();
+        latest_.bollinger_upper = mean + (2.0 * std_dev);
+        latest_.bollinger_lower = mean - (2.0 * std_dev);
+
+        volume_sma_.push(volume);
+        latest_.volume_sma = volume_sma_.value();
+
+        ++bars_;
+        if (record_history_)
+        {
+            append_history();
+        }
+
+        return latest_;
+    }
+
+    void IncrementalIndicators::reset()
+    {
+        *this = IncrementalIndicators(record_history_);
+    }
+
+    void IncrementalIndicators::append_history()
+    {
+        history_.sma_20.push_back(latest_.sma_20);
+        history_.sma_50.push_back(latest_.sma_50);
+        history_.ema_12.push_back(latest_.ema_12);
+        history_.ema_26.push_back(latest_.ema_26);
+        history_.rsi.push_back(latest_.rsi);
+        history_.macd.push_back(latest_.macd);
+        history_.macd_signal.push_back(latest_.macd_signal);
+        history_.bollinger_upper.push_back(latest_.bollinger_upper);
+        history_.bollinger_lower.push_back(latest_.bollinger_lower);
+        history_.volume_sma.push_back(latest_.volume_sma);
+    }
+
+} // namespace trading
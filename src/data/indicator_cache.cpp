@@ -0,0 +1,517 @@
+#include "data/indicator_cache.h"
+#include "data/incremental_indicators.h"
+#include "data/rolling_window.h"
+#include "core/metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+
+namespace trading
+{
+    namespace
+    {
+        struct IndicatorCacheMetrics
+        {
+            metrics::Histogram compute{"indicator_cache_compute_seconds", "Time to compute or extend one cached indicator"};
+            metrics::Counter hits{"indicator_cache_hits_total", "Indicator requests served as cached"};
+            metrics::Counter extensions{"indicator_cache_extensions_total", "Cached indicators extended by appended bars"};
+            metrics::Counter misses{"indicator_cache_misses_total", "Indicators computed from scratch"};
+            metrics::Counter evictions{"indicator_cache_evictions_total", "Cached indicators evicted to make room"};
+        };
+
+        IndicatorCacheMetrics &indicator_cache_metrics()
+        {
+            static IndicatorCacheMetrics instance;
+            return instance;
+        }
+
+        size_t column_bytes(const std::vector<double> &column)
+        {
+            return column.capacity() * sizeof(double);
+        }
+
+        // Room for extra more values, keeping growth geometric across
+        // single-bar appends
+        void grow(std::vector<double> &column, size_t extra)
+        {
+            size_t needed = column.size() + extra;
+            if (column.capacity() < needed)
+            {
+                column.reserve(std::max(needed, column.capacity() * 2));
+            }
+        }
+
+        /**
+         * Rolling kernel state of one cached indicator plus its output so far.
+         * extend() pushes new bars through the same kernels DataProcessor
+         * uses, which is what keeps cached and batch results bit-identical.
+         */
+        class Computation
+        {
+        public:
+            virtual ~Computation() = default;
+
+            // Push the points and append their outputs
+            virtual void extend(std::span<const MarketDataPoint> points) = 0;
+
+            // Output and kernel state, counting spare capacity
+            virtual size_t size_bytes() const = 0;
+        };
+
+        template <typename Output>
+        class Producing : public Computation
+        {
+        public:
+            std::shared_ptr<const Output> result() const { return output_; }
+
+        protected:
+            // Output to append to; copied first if a caller still holds it
+            Output &writable()
+            {
+                if (output_.use_count() > 1)
+                {
+                    output_ = std::make_shared<Output>(*output_);
+                }
+                return *output_;
+            }
+
+            std::shared_ptr<Output> output_ = std::make_shared<Output>();
+        };
+
+        using Lines = std::pair<std::vector<double>, std::vector<double>>;
+
+        class SmaComputation : public Producing<std::vector<double>>
+        {
+        public:
+            explicit SmaComputation(int period) : window_(period) {}
+
+            void extend(std::span<const MarketDataPoint> points) override
+            {
+                auto &sma = writable();
+                grow(sma, points.size());
+                for (const auto &point : points)
+                {
+                    window_.push(point.close);
+                    sma.push_back(window_.value());
+                }
+            }
+
+            size_t size_bytes() const override { return column_bytes(*output_) + window_.period() * sizeof(double); }
+
+        private:
+            RollingMean window_;
+        };
+
+        class EmaComputation : public Producing<std::vector<double>>
+        {
+        public:
+            explicit EmaComputation(int period) : state_(period) {}
+
+            void extend(std::span<const MarketDataPoint> points) override
+            {
+                auto &ema = writable();
+                grow(ema, points.size());
+                for (const auto &point : points)
+                {
+                    ema.push_back(state_.push(point.close));
+                }
+            }
+
+            size_t size_bytes() const override { return column_bytes(*output_) + sizeof(state_); }
+
+        private:
+            EmaState state_;
+        };
+
+        class RsiComputation : public Producing<std::vector<double>>
+        {
+        public:
+            explicit RsiComputation(int period) : state_(period) {}
+
+            void extend(std::span<const MarketDataPoint> points) override
+            {
+                auto &rsi = writable();
+                grow(rsi, points.size());
+                for (const auto &point : points)
+                {
+                    rsi.push_back(state_.push(point.close));
+                }
+            }
+
+            size_t size_bytes() const override { return column_bytes(*output_) + sizeof(state_); }
+
+        private:
+            WilderRsi state_;
+        };
+
+        class MacdComputation : public Producing<Lines>
+        {
+        public:
+            MacdComputation(int fast_period, int slow_period, int signal_period)
+                : fast_(fast_period), slow_(slow_period), signal_(signal_period)
+            {
+            }
+
+            void extend(std::span<const MarketDataPoint> points) override
+            {
+                auto &[macd_line, signal_line] = writable();
+                grow(macd_line, points.size());
+                grow(signal_line, points.size());
+                for (const auto &point : points)
+                {
+                    // Same expression as DataProcessor::calculate_macd
+                    double fast = fast_.push(point.close);
+                    double slow = slow_.push(point.close);
+                    double macd = (std::isnan(fast) || std::isnan(slow)) ? std::numeric_limits<double>::quiet_NaN() : fast - slow;
+                    macd_line.push_back(macd);
+                    signal_line.push_back(signal_.push(macd));
+                }
+            }
+
+            size_t size_bytes() const override
+            {
+                return column_bytes(output_->first) + column_bytes(output_->second) + 3 * sizeof(EmaState);
+            }
+
+        private:
+            EmaState fast_;
+            EmaState slow_;
+            EmaState signal_;
+        };
+
+        class BollingerComputation : public Producing<Lines>
+        {
+        public:
+            BollingerComputation(int period, double std_dev_multiplier)
+                : window_(period), multiplier_(std_dev_multiplier)
+            {
+            }
+
+            void extend(std::span<const MarketDataPoint> points) override
+            {
+                auto &[upper_band, lower_band] = writable();
+                grow(upper_band, points.size());
+                grow(lower_band, points.size());
+                for (const auto &point : points)
+                {
+                    window_.push(point.close);
+                    double sma = window_.mean();
+                    double std_dev = window_.std_dev();
+                    upper_band.push_back(sma + (multiplier_ * std_dev));
+                    lower_band.push_back(sma - (multiplier_ * std_dev));
+                }
+            }
+
+            size_t size_bytes() const override
+            {
+                return column_bytes(output_->first) + column_bytes(output_->second) + window_.period() * sizeof(double);
+            }
+
+        private:
+            RollingMeanVariance window_;
+            double multiplier_;
+        };
+
+        class AllComputation : public Producing<TechnicalIndicators>
+        {
+        public:
+            void extend(std::span<const MarketDataPoint> points) override
+            {
+                auto &indicators = writable();
+                std::vector<double> *columns[] = {&indicators.sma_20, &indicators.sma_50, &indicators.ema_12,
+                                                  &indicators.ema_26, &indicators.rsi, &indicators.macd,
+                                                  &indicators.macd_signal, &indicators.bollinger_upper,
+                                                  &indicators.bollinger_lower, &indicators.volume_sma};
+                for (auto *column : columns)
+                {
+                    grow(*column, points.size());
+                }
+                for (const auto &point : points)
+                {
+                    const IndicatorValues &values = state_.update(point);
+                    indicators.sma_20.push_back(values.sma_20);
+                    indicators.sma_50.push_back(values.sma_50);
+                    indicators.ema_12.push_back(values.ema_12);
+                    indicators.ema_26.push_back(values.ema_26);
+                    indicators.rsi.push_back(values.rsi);
+                    indicators.macd.push_back(values.macd);
+                    indicators.macd_signal.push_back(values.macd_signal);
+                    indicators.bollinger_upper.push_back(values.bollinger_upper);
+                    indicators.bollinger_lower.push_back(values.bollinger_lower);
+                    indicators.volume_sma.push_back(values.volume_sma);
+                }
+            }
+
+            size_t size_bytes() const override
+            {
+                const TechnicalIndicators &indicators = *output_;
+                return column_bytes(indicators.sma_20) + column_bytes(indicators.sma_50) +
+                       column_bytes(indicators.ema_12) + column_bytes(indicators.ema_26) +
+                       column_bytes(indicators.rsi) + column_bytes(indicators.macd) +
+                       column_bytes(indicators.macd_signal) + column_bytes(indicators.bollinger_upper) +
+                       column_bytes(indicators.bollinger_lower) + column_bytes(indicators.volume_sma) +
+                       sizeof(IncrementalIndicators);
+            }
+
+        private:
+            IncrementalIndicators state_{false};
+        };
+    }
+
+    struct IndicatorCache::Entry
+    {
+        explicit Entry(std::unique_ptr<Computation> kernel) : computation(std::move(kernel)) {}
+
+        std::mutex mutex;
+        size_t bars = 0; // Points of the series pushed so far
+        std::unique_ptr<Computation> computation;
+    };
+
+    IndicatorCache::IndicatorCache(size_t max_memory_mb)
+        : max_memory_bytes_(max_memory_mb * 1024 * 1024)
+    {
+    }
+
+    IndicatorCache::IndicatorCache(std::shared_ptr<CacheManager> budget)
+        : budget_(std::move(budget))
+    {
+        if (!budget_)
+        {
+            throw std::invalid_argument("IndicatorCache requires a CacheManager budget");
+        }
+
+        // Lets the series cache take memory back once it has no series left to evict
+        reclaimer_ = budget_->add_reclaimer([this]()
+                                            {
+                                                std::lock_guard<std::mutex> lock(mutex_);
+                                                return evict_one_locked(std::string()); });
+    }
+
+    IndicatorCache::~IndicatorCache()
+    {
+        if (budget_)
+        {
+            budget_->remove_reclaimer(reclaimer_);
+        }
+        clear();
+    }
+
+    template <typename Output>
+    std::shared_ptr<const Output> IndicatorCache::fetch(const MarketDataSeries &series, const std::string &spec,
+                                                        const std::function<std::shared_ptr<Entry>()> &make)
+    {
+        IndicatorCacheMetrics &stats = indicator_cache_metrics();
+        std::string key = std::to_string(series.version()) + "/" + spec;
+
+        std::shared_ptr<Entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(key);
+            if (it == entries_.end())
+            {
+                // Building the kernels validates the parameters
+                Slot slot;
+                slot.entry = make();
+                it = entries_.emplace(key, std::move(slot)).first;
+            }
+            it->second.last_used = ++clock_;
+            entry = it->second.entry;
+        }
+
+        std::shared_ptr<const Output> result;
+        size_t bytes;
+        {
+            std::lock_guard<std::mutex> lock(entry->mutex);
+
+            // The version only survives appends, so the series still starts
+            // with the entry->bars points the entry has seen
+            if (entry->bars == series.size())
+            {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                stats.hits.add();
+            }
+            else
+            {
+                bool fresh = entry->bars == 0;
+                (fresh ? misses_ : extensions_).fetch_add(1, std::memory_order_relaxed);
+                (fresh ? stats.misses : stats.extensions).add();
+
+                metrics::ScopedTimer timer(stats.compute);
+                entry->computation->extend(std::span<const MarketDataPoint>(series.data()).subspan(entry->bars));
+                entry->bars = series.size();
+            }
+
+            result = static_cast<Producing<Output> &>(*entry->computation).result();
+            bytes = entry->computation->size_bytes();
+        }
+
+        charge(key, entry, bytes);
+        return result;
+    }
+
+    IndicatorCache::Column IndicatorCache::sma(const MarketDataSeries &series, int period)
+    {
+        return fetch<std::vector<double>>(series, "sma:" + std::to_string(period), [period]()
+                                          { return std::make_shared<Entry>(std::make_unique<SmaComputation>(period)); });
+    }
+
+    IndicatorCache::Column IndicatorCache::ema(const MarketDataSeries &series, int period)
+    {
+        return fetch<std::vector<double>>(series, "ema:" + std::to_string(period), [period]()
+                                          { return std::make_shared<Entry>(std::make_unique<EmaComputation>(period)); });
+    }
+
+    IndicatorCache::Column IndicatorCache::rsi(const MarketDataSeries &series, int period)
+    {
+        // calculate_rsi returns nothing until there is a price change
+        if (series.size() < 2)
+        {
+            return std::make_shared<const std::vector<double>>();
+        }
+
+        return fetch<std::vector<double>>(series, "rsi:" + std::to_string(period), [period]()
+                                          { return std::make_shared<Entry>(std::make_unique<RsiComputation>(period)); });
+    }
+
+    IndicatorCache::ColumnPair IndicatorCache::macd(const MarketDataSeries &series, int fast_period, int slow_period,
+                                                    int signal_period)
+    {
+        std::string spec = "macd:" + std::to_string(fast_period) + ":" + std::to_string(slow_period) + ":" +
+                           std::to_string(signal_period);
+        return fetch<Lines>(series, spec, [fast_period, slow_period, signal_period]()
+                            { return std::make_shared<Entry>(
+                                  std::make_unique<MacdComputation>(fast_period, slow_period, signal_period)); });
+    }
+
+    IndicatorCache::ColumnPair IndicatorCache::bollinger_bands(const MarketDataSeries &series, int period, double std_dev)
+    {
+        // Full precision, so nearby multipliers never share an entry
+        std::ostringstream spec;
+        spec.precision(17);
+        spec << "bollinger:" << period << ":" << std_dev;
+        return fetch<Lines>(series, spec.str(), [period, std_dev]()
+                            { return std::make_shared<Entry>(std::make_unique<BollingerComputation>(period, std_dev)); });
+    }
+
+    std::shared_ptr<const TechnicalIndicators> IndicatorCache::calculate_indicators(const MarketDataSeries &series)
+    {
+        // Below two bars the batch RSI column is empty rather than NaN, and
+        // there is nothing worth caching anyway
+        if (series.size() < 2)
+        {
+            return std::make_shared<const TechnicalIndicators>(DataProcessor().calculate_indicators(series));
+        }
+
+        return fetch<TechnicalIndicators>(series, "all", []()
+                                          { return std::make_shared<Entry>(std::make_unique<AllComputation>()); });
+    }
+
+    void IndicatorCache::charge(const std::string &key, const std::shared_ptr<Entry> &entry, size_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Evicted or replaced while it was being computed: nothing to account
+        auto it = entries_.find(key);
+        if (it == entries_.end() || it->second.entry != entry)
+        {
+            return;
+        }
+
+        Slot &slot = it->second;
+        if (bytes <= slot.charged_bytes)
+        {
+            // A copy-on-write extension can shrink spare capacity
+            release(slot.charged_bytes - bytes);
+            memory_bytes_ -= slot.charged_bytes - bytes;
+            slot.charged_bytes = bytes;
+            return;
+        }
+
+        // Make room from this cache's own entries first, then from the series
+        size_t extra = bytes - slot.charged_bytes;
+        while (!reserve(extra, false))
+        {
+            if (!evict_one_locked(key))
+            {
+                if (!reserve(extra, true))
+                {
+                    // Does not fit at all; the caller keeps the only copy
+                    erase_locked(it);
+                    return;
+                }
+                break;
+            }
+        }
+        slot.charged_bytes = bytes;
+        memory_bytes_ += extra;
+    }
+
+    bool IndicatorCache::reserve(size_t bytes, bool allow_evict)
+    {
+        if (budget_)
+        {
+            return budget_->reserve_memory(bytes, allow_evict);
+        }
+        return memory_bytes_ + bytes <= max_memory_bytes_;
+    }
+
+    void IndicatorCache::release(size_t bytes)
+    {
+        if (budget_ && bytes > 0)
+        {
+            budget_->release_memory(bytes);
+        }
+    }
+
+    bool IndicatorCache::evict_one_locked(const std::string &keep)
+    {
+        // Linear scan: entries are per (series, indicator), so there are few
+        auto victim = entries_.end();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it)
+        {
+            if (it->first != keep && (victim == entries_.end() || it->second.last_used < victim->second.last_used))
+            {
+                victim = it;
+            }
+        }
+        if (victim == entries_.end())
+        {
+            return false;
+        }
+
+        erase_locked(victim);
+        indicator_cache_metrics().evictions.add();
+        return true;
+    }
+
+    void IndicatorCache::erase_locked(std::unordered_map<std::string, Slot>::iterator it)
+    {
+        release(it->second.charged_bytes);
+        memory_bytes_ -= it->second.charged_bytes;
+        entries_.erase(it);
+    }
+
+    void IndicatorCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        release(memory_bytes_);
+        memory_bytes_ = 0;
+        entries_.clear();
+    }
+
+    size_t IndicatorCache::size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    size_t IndicatorCache::memory_usage() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return memory_bytes_;
+    }
+
+} // namespace trading
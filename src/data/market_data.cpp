@@ -0,0 +1,142 @@
+#include "data/market_data.h"
+#include "data/simd_kernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace trading
+{
+    namespace
+    {
+        // Gather closing prices into a contiguous column for the SIMD kernels
+        std::vector<double> close_prices(const std::vector<MarketDataPoint> &data)
+        {
+            std::vector<double> closes;
+            closes.reserve(data.size());
+            for (const auto &point : data)
+            {
+                closes.push_back(point.close);
+            }
+            return closes;
+        }
+    }
+
+    uint64_t MarketDataSeries::next_version()
+    {
+        static std::atomic<uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    MarketDataSeries &MarketDataSeries::operator=(const MarketDataSeries &other)
+    {
+        if (this != &other)
+        {
+            symbol_ = other.symbol_;
+            data_ = other.data_;
+            version_ = next_version();
+        }
+        return *this;
+    }
+
+    MarketDataSeries &MarketDataSeries::operator=(MarketDataSeries &&other) noexcept
+    {
+        if (this != &other)
+        {
+            symbol_ = std::move(other.symbol_);
+            data_ = std::move(other.data_);
+            version_ = other.version_;
+            other.data_.clear();
+            other.version_ = next_version();
+        }
+        return *this;
+    }
+
+    std::vector<MarketDataPoint> MarketDataSeries::get_range(
+        std::chrono::system_clock::time_point start,
+        std::chrono::system_clock::time_point end) const
+    {
+        std::vector<MarketDataPoint> range;
+        std::copy_if(data_.begin(), data_.end(), std::back_inserter(range),
+                     [&](const MarketDataPoint &point)
+                     { return point.timestamp >= start && point.timestamp <= end; });
+        return range;
+    }
+
+    double MarketDataSeries::get_average_price() const
+    {
+        if (data_.empty())
+        {
+            return 0.0;
+        }
+
+        auto closes = close_prices(data_);
+        return simd::sum(closes) / closes.size();
+    }
+
+    double MarketDataSeries::get_volatility() const
+    {
+        if (data_.size() < 3)
+        {
+            return 0.0;
+        }
+
+        // Standard deviation of close-to-close returns, skipping the leading placeholder
+        auto closes = close_prices(data_);
+        std::vector<double> returns(closes.size());
+        simd::simple_returns(closes, returns);
+
+        std::span<const double> sample(returns.data() + 1, returns.size() - 1);
+        double mean = simd::sum(sample) / sample.size();
+        return std::sqrt(simd::sum_squared_deviations(sample, mean) / sample.size());
+    }
+
+    double MarketDataSeries::get_max_price() const
+    {
+        if (data_.empty())
+        {
+            return 0.0;
+        }
+
+        return simd::min_max(close_prices(data_)).max;
+    }
+
+    double MarketDataSeries::get_min_price() const
+    {
+        if (data_.empty())
+        {
+            return 0.0;
+        }
+
+        return simd::min_max(close_prices(data_)).min;
+    }
+
+    bool MarketDataSeries::is_valid() const
+    {
+        for (size_t i = 0; i < data_.size(); ++i)
+        {
+            const auto &point = data_[i];
+
+            // Prices must be positive and finite, and the bar self-consistent
+            for (double price : {point.open, point.high, point.low, point.close})
+            {
+                if (!std::isfinite(price) || price <= 0.0)
+                {
+                    return false;
+                }
+            }
+            if (point.high < point.low || point.volume < 0)
+            {
+                return false;
+            }
+
+            // Timestamps must not go backwards
+            if (i > 0 && point.timestamp < data_[i - 1].timestamp)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+} // namespace trading
@@ -0,0 +1,590 @@
+#include "data/order_book.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+namespace trading
+{
+    namespace
+    {
+        constexpr size_t kMinLevels = 64;
+        constexpr size_t kMaxLevels = size_t{1} << 22; // Per side; 128 MiB of levels
+
+        size_t round_up_pow2(size_t n)
+        {
+            return std::bit_ceil(std::max<size_t>(n, 16));
+        }
+    }
+
+    OrderBook::OrderBook(double tick_size, size_t initial_levels, size_t initial_orders)
+        : tick_size_(tick_size),
+          node_pool_(sizeof(OrderNode), std::max<size_t>(initial_orders, 1))
+    {
+        if (!(tick_size_ > 0.0) || !std::isfinite(tick_size_))
+        {
+            throw std::invalid_argument("Tick size must be positive");
+        }
+
+        // Whole bitmap words keep the scans simple
+        size_t levels = (std::max(initial_levels, kMinLevels) + 63) & ~size_t{63};
+        for (Ladder *side : {&bids_, &asks_})
+        {
+            side->levels.resize(levels);
+            side->occupied.assign(levels / 64, 0);
+        }
+
+        index_.assign(round_up_pow2(initial_orders * 2), IndexSlot{0, nullptr});
+    }
+
+    OrderBook::~OrderBook()
+    {
+        clear();
+    }
+
+    bool OrderBook::add(uint64_t id, BookSide side, double price, uint64_t quantity)
+    {
+        if (quantity == 0 || find(id) != nullptr)
+        {
+            return false;
+        }
+
+        // Make room first, so a price the ladder cannot hold changes nothing
+        int64_t tick = to_tick(price);
+        level_index(tick);
+        auto *node = new (node_pool_.allocate()) OrderNode{id, quantity, tick, nullptr, nullptr, side};
+        link(node);
+        index_insert(id, node);
+        return true;
+    }
+
+    bool OrderBook::cancel(uint64_t id)
+    {
+        OrderNode *node = find(id);
+        if (node == nullptr)
+        {
+            return false;
+        }
+
+        unlink(node);
+        index_erase(id);
+        release(node);
+        return true;
+    }
+
+    bool OrderBook::reduce(uint64_t id, uint64_t quantity)
+    {
+        OrderNode *node = find(id);
+        if (node == nullptr)
+        {
+            return false;
+        }
+
+        if (quantity >= node->quantity)
+        {
+            return cancel(id);
+        }
+
+        node->quantity -= quantity;
+        ladder(node->side).levels[static_cast<size_t>(node->tick - base_tick_)].quantity -= quantity;
+        return true;
+    }
+
+    bool OrderBook::modify(uint64_t id, double price, uint64_t quantity)
+    {
+        OrderNode *node = find(id);
+        if (node == nullptr)
+        {
+            return false;
+        }
+
+        if (quantity == 0)
+        {
+            return cancel(id);
+        }
+
+        int64_t tick = to_tick(price);
+        if (tick == node->tick && quantity <= node->quantity)
+        {
+            reduce(id, node->quantity - quantity);
+            return true;
+        }
+
+        // Anything else loses priority: move the node to the back of its new level
+        level_index(tick);
+        unlink(node);
+        node->tick = tick;
+        node->quantity = quantity;
+        link(node);
+        return true;
+    }
+
+    bool OrderBook::replace(uint64_t id, uint64_t new_id, double price, uint64_t quantity)
+    {
+        OrderNode *node = find(id);
+        if (node == nullptr || quantity == 0 || (new_id != id && find(new_id) != nullptr))
+        {
+            return false;
+        }
+
+        int64_t tick = to_tick(price);
+        level_index(tick);
+        unlink(node);
+        index_erase(id);
+        node->id = new_id;
+        node->tick = tick;
+        node->quantity = quantity;
+        link(node);
+        index_insert(new_id, node);
+        return true;
+    }
+
+    uint64_t OrderBook::submit(uint64_t id, BookSide side, double price, uint64_t quantity,
+                               std::vector<BookTrade> *trades)
+    {
+        if (quantity == 0 || find(id) != nullptr)
+        {
+            return 0;
+        }
+
+        int64_t tick = to_tick(price);
+        level_index(tick);
+        uint64_t filled = take(side, quantity, tick, trades);
+        if (filled < quantity)
+        {
+            auto *node = new (node_pool_.allocate()) OrderNode{id, quantity - filled, tick, nullptr, nullptr, side};
+            link(node);
+            index_insert(id, node);
+        }
+        return filled;
+    }
+
+    uint64_t OrderBook::match(BookSide taker, uint64_t quantity, std::optional<double> limit_price,
+                              std::vector<BookTrade> *trades)
+    {
+        return take(taker, quantity, limit_tick(taker, limit_price), trades);
+    }
+
+    BookQuote OrderBook::quote(BookSide taker, uint64_t quantity, std::optional<double> limit_price) const
+    {
+        BookQuote result;
+        const Ladder &book = ladder(taker == BookSide::BID ? BookSide::ASK : BookSide::BID);
+        const int64_t limit = limit_tick(taker, limit_price);
+        const int64_t size = static_cast<int64_t>(book.levels.size());
+
+        // Level totals are enough; the orders themselves need not be visited
+        int64_t index = book.best;
+        while (index >= 0 && result.quantity < quantity)
+        {
+            int64_t tick = base_tick_ + index;
+            if (taker == BookSide::BID ? tick > limit : tick < limit)
+            {
+                break;
+            }
+            uint64_t available = std::min(quantity - result.quantity, book.levels[static_cast<size_t>(index)].quantity);
+            result.quantity += available;
+            result.notional += static_cast<double>(available) * to_price(tick);
+            index = taker == BookSide::BID ? lowest_set(book.occupied, index + 1, size) : highest_set(book.occupied, index - 1);
+        }
+
+        return result;
+    }
+
+    std::optional<double> OrderBook::best_bid() const
+    {
+        if (bids_.best < 0)
+        {
+            return std::nullopt;
+        }
+        return to_price(base_tick_ + bids_.best);
+    }
+
+    std::optional<double> OrderBook::best_ask() const
+    {
+        if (asks_.best < 0)
+        {
+            return std::nullopt;
+        }
+        return to_price(base_tick_ + asks_.best);
+    }
+
+    uint64_t OrderBook::volume_at(BookSide side, double price) const
+    {
+        int64_t index = to_tick(price) - base_tick_;
+        const Ladder &book = ladder(side);
+        if (index < 0 || index >= static_cast<int64_t>(book.levels.size()))
+        {
+            return 0;
+        }
+        return book.levels[static_cast<size_t>(index)].quantity;
+    }
+
+    void OrderBook::snapshot(BookSide side, size_t depth, std::vector<BookLevel> &out) const
+    {
+        out.clear();
+        const Ladder &book = ladder(side);
+        const int64_t size = static_cast<int64_t>(book.levels.size());
+
+        int64_t index = book.best;
+        while (index >= 0 && out.size() < depth)
+        {
+            const Level &level = book.levels[static_cast<size_t>(index)];
+            out.push_back(BookLevel{to_price(base_tick_ + index), level.quantity, level.order_count});
+            index = side == BookSide::BID ? highest_set(book.occupied, index - 1) : lowest_set(book.occupied, index + 1, size);
+        }
+    }
+
+    void OrderBook::clear()
+    {
+        for (Ladder *side : {&bids_, &asks_})
+        {
+            for (auto &level : side->levels)
+            {
+                OrderNode *node = level.head;
+                while (node != nullptr)
+                {
+                    OrderNode *next = node->next;
+                    release(node);
+                    node = next;
+                }
+                level = Level{};
+            }
+            std::fill(side->occupied.begin(), side->occupied.end(), 0);
+            side->occupied_levels = 0;
+            side->best = -1;
+        }
+
+        std::fill(index_.begin(), index_.end(), IndexSlot{0, nullptr});
+        index_count_ = 0;
+    }
+
+    int64_t OrderBook::to_tick(double price) const
+    {
+        if (!std::isfinite(price))
+        {
+            throw std::invalid_argument("Order price must be finite");
+        }
+        return std::llround(price / tick_size_);
+    }
+
+    size_t OrderBook::level_index(int64_t tick)
+    {
+        if (tick < base_tick_ || tick >= base_tick_ + static_cast<int64_t>(bids_.levels.size()))
+        {
+            regrow(tick);
+        }
+        return static_cast<size_t>(tick - base_tick_);
+    }
+
+    void OrderBook::regrow(int64_t tick)
+    {
+        const size_t size = bids_.levels.size();
+
+        // An empty book just slides the window so the price sits in the middle
+        if (bids_.occupied_levels == 0 && asks_.occupied_levels == 0)
+        {
+            base_tick_ = tick - static_cast<int64_t>(size / 2);
+            return;
+        }
+
+        // Span of the occupied levels on both sides, plus the new price
+        int64_t low = tick, high = tick;
+        for (const Ladder *side : {&bids_, &asks_})
+        {
+            if (side->occupied_levels > 0)
+            {
+                low = std::min(low, base_tick_ + lowest_set(side->occupied, 0, static_cast<int64_t>(size)));
+                high = std::max(high, base_tick_ + highest_set(side->occupied, static_cast<int64_t>(size) - 1));
+            }
+        }
+
+        // Keep at least as much slack again as the span, so the next move is cheap
+        size_t span = static_cast<size_t>(high - low + 1);
+        size_t new_size = size;
+        while (new_size < span * 2)
+        {
+            new_size *= 2;
+        }
+        if (new_size > kMaxLevels)
+        {
+            throw std::out_of_range("Order book prices span too many ticks");
+        }
+        int64_t new_base = low - static_cast<int64_t>((new_size - span) / 2);
+        int64_t shift = base_tick_ - new_base;
+
+        for (Ladder *side : {&bids_, &asks_})
+        {
+            std::vector<Level> levels(new_size);
+            std::vector<uint64_t> occupied(new_size / 64, 0);
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (side->levels[i].head != nullptr)
+                {
+                    size_t j = static_cast<size_t>(static_cast<int64_t>(i) + shift);
+                    levels[j] = side->levels[i];
+                    occupied[j / 64] |= uint64_t{1} << (j % 64);
+                }
+            }
+            side->levels = std::move(levels);
+            side->occupied = std::move(occupied);
+            if (side->best >= 0)
+            {
+                side->best += shift;
+            }
+        }
+        base_tick_ = new_base;
+    }
+
+    void OrderBook::link(OrderNode *node)
+    {
+        size_t index = level_index(node->tick);
+        Ladder &side = ladder(node->side);
+        Level &level = side.levels[index];
+
+        node->prev = level.tail;
+        node->next = nullptr;
+        if (level.tail != nullptr)
+        {
+            level.tail->next = node;
+        }
+        else
+        {
+            level.head = node;
+            side.occupied[index / 64] |= uint64_t{1} << (index % 64);
+            ++side.occupied_levels;
+
+            int64_t position = static_cast<int64_t>(index);
+            if (side.best < 0 || (node->side == BookSide::BID ? position > side.best : position < side.best))
+            {
+                side.best = position;
+            }
+        }
+        level.tail = node;
+        level.quantity += node->quantity;
+        ++level.order_count;
+    }
+
+    void OrderBook::unlink(OrderNode *node)
+    {
+        size_t index = static_cast<size_t>(node->tick - base_tick_);
+        Ladder &side = ladder(node->side);
+        Level &level = side.levels[index];
+
+        (node->prev != nullptr ? node->prev->next : level.head) = node->next;
+        (node->next != nullptr ? node->next->prev : level.tail) = node->prev;
+        level.quantity -= node->quantity;
+        --level.order_count;
+
+        if (level.head == nullptr)
+        {
+            side.occupied[index / 64] &= ~(uint64_t{1} << (index % 64));
+            --side.occupied_levels;
+
+            int64_t position = static_cast<int64_t>(index);
+            if (position == side.best)
+            {
+                side.best = node->side == BookSide::BID
+                                ? highest_set(side.occupied, position - 1)
+                                : lowest_set(side.occupied, position + 1, static_cast<int64_t>(side.levels.size()));
+            }
+        }
+    }
+
+    void OrderBook::release(OrderNode *node)
+    {
+        node->~OrderNode();
+        node_pool_.deallocate(node);
+    }
+
+    int64_t OrderBook::highest_set(const std::vector<uint64_t> &bits, int64_t from)
+    {
+        if (from < 0)
+        {
+            return -1;
+        }
+
+        int64_t word = from / 64;
+        uint64_t mask = ~uint64_t{0} >> (63 - from % 64);
+        uint64_t current = bits[static_cast<size_t>(word)] & mask;
+        while (true)
+        {
+            if (current != 0)
+            {
+                return word * 64 + 63 - std::countl_zero(current);
+            }
+            if (--word < 0)
+            {
+                return -1;
+            }
+            current = bits[static_cast<size_t>(word)];
+        }
+    }
+
+    int64_t OrderBook::lowest_set(const std::vector<uint64_t> &bits, int64_t from, int64_t limit)
+    {
+        if (from >= limit)
+        {
+            return -1;
+        }
+
+        int64_t word = from / 64;
+        const int64_t words = static_cast<int64_t>(bits.size());
+        uint64_t current = bits[static_cast<size_t>(word)] & (~uint64_t{0} << (from % 64));
+        while (true)
+        {
+            if (current != 0)
+            {
+                return word * 64 + std::countr_zero(current);
+            }
+            if (++word >= words)
+            {
+                return -1;
+            }
+            current = bits[static_cast<size_t>(word)];
+        }
+    }
+
+    uint64_t OrderBook::take(BookSide taker, uint64_t quantity, int64_t limit, std::vector<BookTrade> *trades)
+    {
+        Ladder &book = ladder(taker == BookSide::BID ? BookSide::ASK : BookSide::BID);
+        uint64_t remaining = quantity;
+
+        while (remaining > 0 && book.best >= 0)
+        {
+            const int64_t tick = base_tick_ + book.best;
+            if (taker == BookSide::BID ? tick > limit : tick < limit)
+            {
+                break;
+            }
+
+            // Walk the level in time priority; unlink() moves best on when it empties
+            Level &level = book.levels[static_cast<size_t>(book.best)];
+            const double price = to_price(tick);
+            while (remaining > 0 && level.head != nullptr)
+            {
+                OrderNode *resting = level.head;
+                uint64_t traded = std::min(remaining, resting->quantity);
+                if (trades != nullptr)
+                {
+                    trades->push_back(BookTrade{resting->id, price, traded});
+                }
+                remaining -= traded;
+
+                if (traded == resting->quantity)
+                {
+                    unlink(resting);
+                    index_erase(resting->id);
+                    release(resting);
+                }
+                else
+                {
+                    resting->quantity -= traded;
+                    level.quantity -= traded;
+                }
+            }
+        }
+
+        return quantity - remaining;
+    }
+
+    int64_t OrderBook::limit_tick(BookSide taker, const std::optional<double> &limit_price) const
+    {
+        if (!limit_price)
+        {
+            return taker == BookSide::BID ? std::numeric_limits<int64_t>::max() : std::numeric_limits<int64_t>::min();
+        }
+        return to_tick(*limit_price);
+    }
+
+    OrderBook::OrderNode *OrderBook::find(uint64_t id) const
+    {
+        const size_t mask = index_.size() - 1;
+        for (size_t slot = index_slot(id);; slot = (slot + 1) & mask)
+        {
+            const IndexSlot &entry = index_[slot];
+            if (entry.node == nullptr)
+            {
+                return nullptr;
+            }
+            if (entry.id == id)
+            {
+                return entry.node;
+            }
+        }
+    }
+
+    void OrderBook::index_insert(uint64_t id, OrderNode *node)
+    {
+        // Keep the table at most half full so probes stay short
+        if ((index_count_ + 1) * 2 > index_.size())
+        {
+            std::vector<IndexSlot> old(index_.size() * 2, IndexSlot{0, nullptr});
+            old.swap(index_);
+            index_count_ = 0;
+            for (const auto &entry : old)
+            {
+                if (entry.node != nullptr)
+                {
+                    index_insert(entry.id, entry.node);
+                }
+            }
+        }
+
+        const size_t mask = index_.size() - 1;
+        size_t slot = index_slot(id);
+        while (index_[slot].node != nullptr)
+        {
+            slot = (slot + 1) & mask;
+        }
+        index_[slot] = IndexSlot{id, node};
+        ++index_count_;
+    }
+
+    void OrderBook::index_erase(uint64_t id)
+    {
+        const size_t mask = index_.size() - 1;
+        size_t hole = index_slot(id);
+        while (index_[hole].id != id)
+        {
+            if (index_[hole].node == nullptr)
+            {
+                return;
+            }
+            hole = (hole + 1) & mask;
+        }
+        if (index_[hole].node == nullptr)
+        {
+            return;
+        }
+
+        // Backward-shift deletion: pull later entries of the probe run into the hole
+        size_t next = hole;
+        while (true)
+        {
+            next = (next + 1) & mask;
+            if (index_[next].node == nullptr)
+            {
+                break;
+            }
+            size_t home = index_slot(index_[next].id);
+            // Move it unless its home lies cyclically in (hole, next]
+            bool stays = hole <= next ? (home > hole && home <= next) : (home > hole || home <= next);
+            if (!stays)
+            {
+                index_[hole] = index_[next];
+                hole = next;
+            }
+        }
+        index_[hole] = IndexSlot{0, nullptr};
+        --index_count_;
+    }
+
+    size_t OrderBook::index_slot(uint64_t id) const
+    {
+        // Fibonacci hashing spreads sequential exchange ids across the table
+        return static_cast<size_t>((id * 0x9E3779B97F4A7C15ull) >> 32) & (index_.size() - 1);
+    }
+
+} // namespace trading
@@ -0,0 +1,729 @@
+#include "data/simd_kernels.h"
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+// AVX2/AVX-512 paths are compiled with per-function target attributes and
+// selected at runtime, so the library itself still runs on any x86-64 CPU.
+// They need GCC/Clang for the attributes and __builtin_cpu_supports; other
+// compilers get the scalar path. NEON is baseline on AArch64.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TRADING_SIMD_X86 1
+#include <immintrin.h>
+#define TRADING_TARGET(isa) __attribute__((target(isa)))
+#elif defined(__aarch64__)
+#define TRADING_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// This file must be built with floating-point contraction disabled (see
+// src/data/CMakeLists.txt) so no implementation fuses a multiply and add
+// that another leaves separate.
+
+namespace trading
+{
+    namespace simd
+    {
+        namespace
+        {
+            constexpr size_t kLanes = 8;
+
+            // Fixed combination tree shared by every implementation
+            inline double combine_lanes(const double lane[kLanes])
+            {
+                return ((lane[0] + lane[1]) + (lane[2] + lane[3])) + ((lane[4] + lane[5]) + (lane[6] + lane[7]));
+            }
+
+            // ---------------------------------------------------------------
+            // Scalar reference
+            // ---------------------------------------------------------------
+
+            double sum_scalar(const double *values, size_t n)
+            {
+                double lane[kLanes] = {};
+                for (size_t i = 0; i < n; ++i)
+                {
+                    lane[i % kLanes] += values[i];
+                }
+                return combine_lanes(lane);
+            }
+
+            double sum_squared_deviations_scalar(const double *values, size_t n, double mean)
+            {
+                double lane[kLanes] = {};
+                for (size_t i = 0; i < n; ++i)
+                {
+                    double diff = values[i] - mean;
+                    lane[i % kLanes] += diff * diff;
+                }
+                return combine_lanes(lane);
+            }
+
+            // Same comparisons as std::min_element / std::max_element
+            MinMax min_max_scalar(const double *values, size_t n)
+            {
+                MinMax result{values[0], values[0]};
+                for (size_t i = 1; i < n; ++i)
+                {
+                    if (values[i] < result.min)
+                    {
+                        result.min = values[i];
+                    }
+                    if (result.max < values[i])
+                    {
+                        result.max = values[i];
+                    }
+                }
+                return result;
+            }
+
+            void simple_returns_scalar(const double *prices, double *out, size_t n, size_t start)
+            {
+                for (size_t i = start; i < n; ++i)
+                {
+                    out[i] = prices[i - 1] != 0.0 ? (prices[i] - prices[i - 1]) / prices[i - 1] : 0.0;
+                }
+            }
+
+            void simple_returns_scalar(const double *prices, double *out, size_t n)
+            {
+                out[0] = 0.0;
+                simple_returns_scalar(prices, out, n, 1);
+            }
+
+            void normalize_scalar(const double *values, size_t n, double offset, double scale, double *out, size_t start)
+            {
+                for (size_t i = start; i < n; ++i)
+                {
+                    out[i] = (values[i] - offset) / scale;
+                }
+            }
+
+            void normalize_scalar(const double *values, size_t n, double offset, double scale, double *out)
+            {
+                normalize_scalar(values, n, offset, scale, out, 0);
+            }
+
+            void append_outliers_scalar(const double *values, size_t n, double mean, double std_dev, double threshold,
+                                        std::vector<size_t> &out, size_t start)
+            {
+                for (size_t i = start; i < n; ++i)
+                {
+                    if (std::abs(values[i] - mean) / std_dev > threshold)
+                    {
+                        out.push_back(i);
+                    }
+                }
+            }
+
+            void append_outliers_scalar(const double *values, size_t n, double mean, double std_dev, double threshold,
+                                        std::vector<size_t> &out)
+            {
+                append_outliers_scalar(values, n, mean, std_dev, threshold, out, 0);
+            }
+
+            // Lane-wise min/max can differ from the sequential scan only for
+            // NaN inputs or a signed-zero result; those cases re-run the scan.
+            inline bool needs_scalar_min_max(bool saw_nan, const MinMax &result)
+            {
+                return saw_nan || result.min == 0.0 || result.max == 0.0;
+            }
+
+            // Emit the indices of set bits in an outlier mask
+            inline void push_mask(uint32_t mask, size_t base, std::vector<size_t> &out)
+            {
+                while (mask != 0)
+                {
+                    out.push_back(base + static_cast<size_t>(std::countr_zero(mask)));
+                    mask &= mask - 1;
+                }
+            }
+
+#if defined(TRADING_SIMD_X86)
+            // ---------------------------------------------------------------
+            // AVX2: two 4-wide accumulators cover the eight canonical lanes
+            // ---------------------------------------------------------------
+
+            TRADING_TARGET("avx2")
+            double sum_avx2(const double *values, size_t n)
+            {
+                __m256d acc0 = _mm256_setzero_pd();
+                __m256d acc1 = _mm256_setzero_pd();
+                size_t i = 0;
+                for (; i + kLanes <= n; i += kLanes)
+                {
+                    acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(values + i));
+                    acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(values + i + 4));
+                }
+
+                double lane[kLanes];
+                _mm256_storeu_pd(lane, acc0);
+                _mm256_storeu_pd(lane + 4, acc1);
+                for (; i < n; ++i)
+                {
+                    lane[i % kLanes] += values[i];
+                }
+                return combine_lanes(lane);
+            }
+
+            TRADING_TARGET("avx2")
+            double sum_squared_deviations_avx2(const double *values, size_t n, double mean)
+            {
+                const __m256d vmean = _mm256_set1_pd(mean);
+                __m256d acc0 = _mm256_setzero_pd();
+                __m256d acc1 = _mm256_setzero_pd();
+                size_t i = 0;
+                for (; i + kLanes <= n; i += kLanes)
+                {
+                    __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(values + i), vmean);
+                    __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(values + i + 4), vmean);
+                    acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(d0, d0));
+                    acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(d1, d1));
+                }
+
+                double lane[kLanes];
+                _mm256_storeu_pd(lane, acc0);
+                _mm256_storeu_pd(lane + 4, acc1);
+                for (; i < n; ++i)
+                {
+                    double diff = values[i] - mean;
+                    lane[i % kLanes] += diff * diff;
+                }
+                return combine_lanes(lane);
+            }
+
+            TRADING_TARGET("avx2")
+            MinMax min_max_avx2(const double *values, size_t n)
+            {
+                if (n < 4)
+                {
+                    return min_max_scalar(values, n);
+                }
+
+                __m256d vmin = _mm256_loadu_pd(values);
+                __m256d vmax = vmin;
+                __m256d nan = _mm256_cmp_pd(vmin, vmin, _CMP_UNORD_Q);
+                for (size_t i = 4; i < n; i += 4)
+                {
+                    // Final block overlaps the previous one; min/max are idempotent
+                    __m256d x = _mm256_loadu_pd(values + (i + 4 <= n ? i : n - 4));
+                    vmin = _mm256_min_pd(vmin, x);
+                    vmax = _mm256_max_pd(vmax, x);
+                    nan = _mm256_or_pd(nan, _mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+                }
+
+                double lo[4], hi[4];
+                _mm256_storeu_pd(lo, vmin);
+                _mm256_storeu_pd(hi, vmax);
+                MinMax result{lo[0], hi[0]};
+                for (int k = 1; k < 4; ++k)
+                {
+                    result.min = lo[k] < result.min ? lo[k] : result.min;
+                    result.max = result.max < hi[k] ? hi[k] : result.max;
+                }
+
+                if (needs_scalar_min_max(_mm256_movemask_pd(nan) != 0, result))
+                {
+                    return min_max_scalar(values, n);
+                }
+                return result;
+            }
+
+            TRADING_TARGET("avx2")
+            void simple_returns_avx2(const double *prices, double *out, size_t n)
+            {
+                out[0] = 0.0;
+                const __m256d zero = _mm256_setzero_pd();
+                size_t i = 1;
+                for (; i + 4 <= n; i += 4)
+                {
+                    __m256d prev = _mm256_loadu_pd(prices + i - 1);
+                    __m256d cur = _mm256_loadu_pd(prices + i);
+                    __m256d ret = _mm256_div_pd(_mm256_sub_pd(cur, prev), prev);
+                    // Zero where the previous price is zero (+0.0 is all-zero bits)
+                    __m256d nonzero = _mm256_cmp_pd(prev, zero, _CMP_NEQ_UQ);
+                    _mm256_storeu_pd(out + i, _mm256_and_pd(ret, nonzero));
+                }
+                simple_returns_scalar(prices, out, n, i);
+            }
+
+            TRADING_TARGET("avx2")
+            void normalize_avx2(const double *values, size_t n, double offset, double scale, double *out)
+            {
+                const __m256d voffset = _mm256_set1_pd(offset);
+                const __m256d vscale = _mm256_set1_pd(scale);
+                size_t i = 0;
+                for (; i + 4 <= n; i += 4)
+                {
+                    __m256d x = _mm256_loadu_pd(values + i);
+                    _mm256_storeu_pd(out + i, _mm256_div_pd(_mm256_sub_pd(x, voffset), vscale));
+                }
+                normalize_scalar(values, n, offset, scale, out, i);
+            }
+
+            TRADING_TARGET("avx2")
+            void append_outliers_avx2(const double *values, size_t n, double mean, double std_dev, double threshold,
+                                      std::vector<size_t> &out)
+            {
+                const __m256d vmean = _mm256_set1_pd(mean);
+                const __m256d vstd = _mm256_set1_pd(std_dev);
+                const __m256d vthreshold = _mm256_set1_pd(threshold);
+                const __m256d sign = _mm256_set1_pd(-0.0);
+                size_t i = 0;
+                for (; i + 4 <= n; i += 4)
+                {
+                    __m256d deviation = _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_loadu_pd(values + i), vmean));
+                    __m256d z = _mm256_div_pd(deviation, vstd);
+                    push_mask(static_cast<uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(z, vthreshold, _CMP_GT_OQ))), i, out);
+                }
+                append_outliers_scalar(values, n, mean, std_dev, threshold, out, i);
+            }
+
+            // ---------------------------------------------------------------
+            // AVX-512: one 8-wide accumulator is exactly the canonical lanes
+            // ---------------------------------------------------------------
+
+            TRADING_TARGET("avx512f")
+            double sum_avx512(const double *values, size_t n)
+            {
+                __m512d acc = _mm512_setzero_pd();
+                size_t i = 0;
+                for (; i + kLanes <= n; i += kLanes)
+                {
+                    acc = _mm512_add_pd(acc, _mm512_loadu_pd(values + i));
+                }
+
+                double lane[kLanes];
+                _mm512_storeu_pd(lane, acc);
+                for (; i < n; ++i)
+                {
+                    lane[i % kLanes] += values[i];
+                }
+                return combine_lanes(lane);
+            }
+
+            TRADING_TARGET("avx512f")
+            double sum_squared_deviations_avx512(const double *values, size_t n, double mean)
+            {
+                const __m512d vmean = _mm512_set1_pd(mean);
+                __m512d acc = _mm512_setzero_pd();
+                size_t i = 0;
+                for (; i + kLanes <= n; i += kLanes)
+                {
+                    __m512d d = _mm512_sub_pd(_mm512_loadu_pd(values + i), vmean);
+                    acc = _mm512_add_pd(acc, _mm512_mul_pd(d, d));
+                }
+
+                double lane[kLanes];
+                _mm512_storeu_pd(lane, acc);
+                for (; i < n; ++i)
+                {
+                    double diff = values[i] - mean;
+                    lane[i % kLanes] += diff * diff;
+                }
+                return combine_lanes(lane);
+            }
+
+            TRADING_TARGET("avx512f")
+            MinMax min_max_avx512(const double *values, size_t n)
+            {
+                if (n < 8)
+                {
+                    return min_max_scalar(values, n);
+                }
+
+                __m512d vmin = _mm512_loadu_pd(values);
+                __m512d vmax = vmin;
+                __mmask8 nan = _mm512_cmp_pd_mask(vmin, vmin, _CMP_UNORD_Q);
+                for (size_t i = 8; i < n; i += 8)
+                {
+                    __m512d x = _mm512_loadu_pd(values + (i + 8 <= n ? i : n - 8));
+                    vmin = _mm512_min_pd(vmin, x);
+                    vmax = _mm512_max_pd(vmax, x);
+                    nan = static_cast<__mmask8>(nan | _mm512_cmp_pd_mask(x, x, _CMP_UNORD_Q));
+                }
+
+                double lo[8], hi[8];
+                _mm512_storeu_pd(lo, vmin);
+                _mm512_storeu_pd(hi, vmax);
+                MinMax result{lo[0], hi[0]};
+                for (int k = 1; k < 8; ++k)
+                {
+                    result.min = lo[k] < result.min ? lo[k] : result.min;
+                    result.max = result.max < hi[k] ? hi[k] : result.max;
+                }
+
+                if (needs_scalar_min_max(nan != 0, result))
+                {
+                    return min_max_scalar(values, n);
+                }
+                return result;
+            }
+
+            TRADING_TARGET("avx512f")
+            void simple_returns_avx512(const double *prices, double *out, size_t n)
+            {
+                out[0] = 0.0;
+                const __m512d zero = _mm512_setzero_pd();
+                size_t i = 1;
+                for (; i + 8 <= n; i += 8)
+                {
+                    __m512d prev = _mm512_loadu_pd(prices + i - 1);
+                    __m512d cur = _mm512_loadu_pd(prices + i);
+                    __mmask8 nonzero = _mm512_cmp_pd_mask(prev, zero, _CMP_NEQ_UQ);
+                    __m512d ret = _mm512_div_pd(_mm512_sub_pd(cur, prev), prev);
+                    _mm512_storeu_pd(out + i, _mm512_maskz_mov_pd(nonzero, ret));
+                }
+                simple_returns_scalar(prices, out, n, i);
+            }
+
+            TRADING_TARGET("avx512f")
+            void normalize_avx512(const double *values, size_t n, double offset, double scale, double *out)
+            {
+                const __m512d voffset = _mm512_set1_pd(offset);
+                const __m512d vscale = _mm512_set1_pd(scale);
+                size_t i = 0;
+                for (; i + 8 <= n; i += 8)
+                {
+                    __m512d x = _mm512_loadu_pd(values + i);
+                    _mm512_storeu_pd(out + i, _mm512_div_pd(_mm512_sub_pd(x, voffset), vscale));
+                }
+                normalize_scalar(values, n, offset, scale, out, i);
+            }
+
+            TRADING_TARGET("avx512f")
+            void append_outliers_avx512(const double *values, size_t n, double mean, double std_dev, double threshold,
+                                        std::vector<size_t> &out)
+            {
+                const __m512d vmean = _mm512_set1_pd(mean);
+                const __m512d vstd = _mm512_set1_pd(std_dev);
+                const __m512d vthreshold = _mm512_set1_pd(threshold);
+                size_t i = 0;
+                for (; i + 8 <= n; i += 8)
+                {
+                    __m512d deviation = _mm512_abs_pd(_mm512_sub_pd(_mm512_loadu_pd(values + i), vmean));
+                    __m512d z = _mm512_div_pd(deviation, vstd);
+                    push_mask(_mm512_cmp_pd_mask(z, vthreshold, _CMP_GT_OQ), i, out);
+                }
+                append_outliers_scalar(values, n, mean, std_dev, threshold, out, i);
+            }
+#endif // TRADING_SIMD_X86
+
+#if defined(TRADING_SIMD_NEON)
+            // ---------------------------------------------------------------
+            // NEON: four 2-wide accumulators cover the eight canonical lanes
+            // ---------------------------------------------------------------
+
+            double sum_neon(const double *values, size_t n)
+            {
+                float64x2_t acc[4] = {vdupq_n_f64(0.0), vdupq_n_f64(0.0), vdupq_n_f64(0.0), vdupq_n_f64(0.0)};
+                size_t i = 0;
+                for (; i + kLanes <= n; i += kLanes)
+                {
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        acc[k] = vaddq_f64(acc[k], vld1q_f64(values + i + 2 * k));
+                    }
+                }
+
+                double lane[kLanes];
+                for (int k = 0; k < 4; ++k)
+                {
+                    vst1q_f64(lane + 2 * k, acc[k]);
+                }
+                for (; i < n; ++i)
+                {
+                    lane[i % kLanes] += values[i];
+                }
+                return combine_lanes(lane);
+            }
+
+            double sum_squared_deviations_neon(const double *values, size_t n, double mean)
+            {
+                const float64x2_t vmean = vdupq_n_f64(mean);
+                float64x2_t acc[4] = {vdupq_n_f64(0.0), vdupq_n_f64(0.0), vdupq_n_f64(0.0), vdupq_n_f64(0.0)};
+                size_t i = 0;
+                for (; i + kLanes <= n; i += kLanes)
+                {
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        float64x2_t d = vsubq_f64(vld1q_f64(values + i + 2 * k), vmean);
+                        acc[k] = vaddq_f64(acc[k], vmulq_f64(d, d));
+                    }
+                }
+
+                double lane[kLanes];
+                for (int k = 0; k < 4; ++k)
+                {
+                    vst1q_f64(lane + 2 * k, acc[k]);
+                }
+                for (; i < n; ++i)
+                {
+                    double diff = values[i] - mean;
+                    lane[i % kLanes] += diff * diff;
+                }
+                return combine_lanes(lane);
+            }
+
+            MinMax min_max_neon(const double *values, size_t n)
+            {
+                if (n < 2)
+                {
+                    return min_max_scalar(values, n);
+                }
+
+                float64x2_t vmin = vld1q_f64(values);
+                float64x2_t vmax = vmin;
+                uint64x2_t ordered = vceqq_f64(vmin, vmin);
+                for (size_t i = 2; i < n; i += 2)
+                {
+                    float64x2_t x = vld1q_f64(values + (i + 2 <= n ? i : n - 2));
+                    vmin = vminq_f64(vmin, x);
+                    vmax = vmaxq_f64(vmax, x);
+                    ordered = vandq_u64(ordered, vceqq_f64(x, x));
+                }
+
+                double lo0 = vgetq_lane_f64(vmin, 0), lo1 = vgetq_lane_f64(vmin, 1);
+                double hi0 = vgetq_lane_f64(vmax, 0), hi1 = vgetq_lane_f64(vmax, 1);
+                MinMax result{lo1 < lo0 ? lo1 : lo0, hi0 < hi1 ? hi1 : hi0};
+                bool saw_nan = (vgetq_lane_u64(ordered, 0) & vgetq_lane_u64(ordered, 1)) == 0;
+
+                if (needs_scalar_min_max(saw_nan, result))
+                {
+                    return min_max_scalar(values, n);
+                }
+                return result;
+            }
+
+            void simple_returns_neon(const double *prices, double *out, size_t n)
+            {
+                out[0] = 0.0;
+                const float64x2_t zero = vdupq_n_f64(0.0);
+                size_t i = 1;
+                for (; i + 2 <= n; i += 2)
+                {
+                    float64x2_t prev = vld1q_f64(prices + i - 1);
+                    float64x2_t cur = vld1q_f64(prices + i);
+                    float64x2_t ret = vdivq_f64(vsubq_f64(cur, prev), prev);
+                    vst1q_f64(out + i, vbslq_f64(vceqq_f64(prev, zero), zero, ret));
+                }
+                simple_returns_scalar(prices, out, n, i);
+            }
+
+            void normalize_neon(const double *values, size_t n, double offset, double scale, double *out)
+            {
+                const float64x2_t voffset = vdupq_n_f64(offset);
+                const float64x2_t vscale = vdupq_n_f64(scale);
+                size_t i = 0;
+                for (; i + 2 <= n; i += 2)
+                {
+                    vst1q_f64(out + i, vdivq_f64(vsubq_f64(vld1q_f64(values + i), voffset), vscale));
+                }
+                normalize_scalar(values, n, offset, scale, out, i);
+            }
+
+            void append_outliers_neon(const double *values, size_t n, double mean, double std_dev, double threshold,
+                                      std::vector<size_t> &out)
+            {
+                const float64x2_t vmean = vdupq_n_f64(mean);
+                const float64x2_t vstd = vdupq_n_f64(std_dev);
+                const float64x2_t vthreshold = vdupq_n_f64(threshold);
+                size_t i = 0;
+                for (; i + 2 <= n; i += 2)
+                {
+                    float64x2_t z = vdivq_f64(vabsq_f64(vsubq_f64(vld1q_f64(values + i), vmean)), vstd);
+                    uint64x2_t above = vcgtq_f64(z, vthreshold);
+                    uint32_t mask = static_cast<uint32_t>(vgetq_lane_u64(above, 0) & 1) |
+                                    static_cast<uint32_t>((vgetq_lane_u64(above, 1) & 1) << 1);
+                    push_mask(mask, i, out);
+                }
+                append_outliers_scalar(values, n, mean, std_dev, threshold, out, i);
+            }
+#endif // TRADING_SIMD_NEON
+
+            // ---------------------------------------------------------------
+            // Dispatch
+            // ---------------------------------------------------------------
+
+            struct KernelTable
+            {
+                Isa isa;
+                double (*sum)(const double *, size_t);
+                double (*sum_squared_deviations)(const double *, size_t, double);
+                MinMax (*min_max)(const double *, size_t);
+                void (*simple_returns)(const double *, double *, size_t);
+                void (*normalize)(const double *, size_t, double, double, double *);
+                void (*append_outliers)(const double *, size_t, double, double, double, std::vector<size_t> &);
+            };
+
+            constexpr KernelTable kScalarKernels{
+                Isa::SCALAR, sum_scalar, sum_squared_deviations_scalar, min_max_scalar,
+                simple_returns_scalar, normalize_scalar, append_outliers_scalar};
+
+#if defined(TRADING_SIMD_X86)
+            constexpr KernelTable kAvx2Kernels{
+                Isa::AVX2, sum_avx2, sum_squared_deviations_avx2, min_max_avx2,
+                simple_returns_avx2, normalize_avx2, append_outliers_avx2};
+
+            constexpr KernelTable kAvx512Kernels{
+                Isa::AVX512, sum_avx512, sum_squared_deviations_avx512, min_max_avx512,
+                simple_returns_avx512, normalize_avx512, append_outliers_avx512};
+#endif
+
+#if defined(TRADING_SIMD_NEON)
+            constexpr KernelTable kNeonKernels{
+                Isa::NEON, sum_neon, sum_squared_deviations_neon, min_max_neon,
+                simple_returns_neon, normalize_neon, append_outliers_neon};
+#endif
+
+            const KernelTable *table_for(Isa isa)
+            {
+                switch (isa)
+                {
+#if defined(TRADING_SIMD_X86)
+                case Isa::AVX2:
+                    return &kAvx2Kernels;
+                case Isa::AVX512:
+                    return &kAvx512Kernels;
+#endif
+#if defined(TRADING_SIMD_NEON)
+                case Isa::NEON:
+                    return &kNeonKernels;
+#endif
+                default:
+                    return &kScalarKernels;
+                }
+            }
+
+            std::atomic<const KernelTable *> active_kernels{nullptr};
+
+            const KernelTable &kernels()
+            {
+                const KernelTable *table = active_kernels.load(std::memory_order_acquire);
+                if (table == nullptr)
+                {
+                    // Racing first calls all pick the same table
+                    table = table_for(detect_isa());
+                    active_kernels.store(table, std::memory_order_release);
+                }
+                return *table;
+            }
+        }
+
+        bool is_supported(Isa isa)
+        {
+            switch (isa)
+            {
+            case Isa::SCALAR:
+                return true;
+#if defined(TRADING_SIMD_X86)
+            case Isa::AVX2:
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2");
+            case Isa::AVX512:
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx512f");
+#endif
+#if defined(TRADING_SIMD_NEON)
+            case Isa::NEON:
+                return true;
+#endif
+            default:
+                return false;
+            }
+        }
+
+        Isa detect_isa()
+        {
+            for (Isa isa : {Isa::AVX512, Isa::AVX2, Isa::NEON})
+            {
+                if (is_supported(isa))
+                {
+                    return isa;
+                }
+            }
+            return Isa::SCALAR;
+        }
+
+        Isa active_isa()
+        {
+            return kernels().isa;
+        }
+
+        void set_isa(Isa isa)
+        {
+            if (!is_supported(isa))
+            {
+                throw std::invalid_argument(std::string("Instruction set not supported: ") + isa_name(isa));
+            }
+            active_kernels.store(table_for(isa), std::memory_order_release);
+        }
+
+        const char *isa_name(Isa isa)
+        {
+            switch (isa)
+            {
+            case Isa::SCALAR:
+                return "scalar";
+            case Isa::AVX2:
+                return "avx2";
+            case Isa::AVX512:
+                return "avx512";
+            case Isa::NEON:
+                return "neon";
+            }
+            return "unknown";
+        }
+
+        double sum(std::span<const double> values)
+        {
+            return kernels().sum(values.data(), values.size());
+        }
+
+        double sum_squared_deviations(std::span<const double> values, double mean)
+        {
+            return kernels().sum_squared_deviations(values.data(), values.size(), mean);
+        }
+
+        MinMax min_max(std::span<const double> values)
+        {
+            if (values.empty())
+            {
+                throw std::invalid_argument("min_max requires at least one value");
+            }
+            return kernels().min_max(values.data(), values.size());
+        }
+
+        void simple_returns(std::span<const double> prices, std::span<double> out)
+        {
+            if (out.size() != prices.size())
+            {
+                throw std::invalid_argument("Output size must match input size");
+            }
+            if (prices.empty())
+            {
+                return;
+            }
+            kernels().simple_returns(prices.data(), out.data(), prices.size());
+        }
+
+        void normalize(std::span<const double> values, double offset, double scale, std::span<double> out)
+        {
+            if (out.size() != values.size())
+            {
+                throw std::invalid_argument("Output size must match input size");
+            }
+            kernels().normalize(values.data(), values.size(), offset, scale, out.data());
+        }
+
+        void append_outliers(std::span<const double> values, double mean, double std_dev, double threshold,
+                             std::vector<size_t> &out)
+        {
+            kernels().append_outliers(values.data(), values.size(), mean, std_dev, threshold, out);
+        }
+
+    } // namespace simd
+} // namespace trading
@@ -0,0 +1,311 @@
+#include "data/universe_panel.h"
+#include "data/cache_manager.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace trading
+{
+
+    namespace
+    {
+        constexpr size_t kFieldCount = static_cast<size_t>(PanelField::COUNT);
+        constexpr size_t kLineDoubles = 64 / sizeof(double);
+        constexpr size_t kGroupSymbols = 64; // Symbols per bitmap word
+
+        // Union of the distinct timestamps of every series
+        std::vector<int64_t> union_axis(const std::vector<const MarketDataSeries *> &series)
+        {
+            std::vector<int64_t> axis;
+            std::vector<int64_t> own;
+            std::vector<int64_t> merged;
+            for (const auto *s : series)
+            {
+                if (!s)
+                {
+                    continue;
+                }
+                own.clear();
+                own.reserve(s->size());
+                for (const auto &point : s->data())
+                {
+                    int64_t t = to_epoch_nanos(point.timestamp);
+                    if (!own.empty() && t < own.back())
+                    {
+                        throw std::invalid_argument("Series " + s->symbol() + " has decreasing timestamps");
+                    }
+                    if (own.empty() || t != own.back())
+                    {
+                        own.push_back(t);
+                    }
+                }
+
+                // Most symbols of a universe share the axis: skip the merge then
+                if (own == axis)
+                {
+                    continue;
+                }
+                merged.clear();
+                merged.reserve(axis.size() + own.size());
+                std::set_union(axis.begin(), axis.end(), own.begin(), own.end(), std::back_inserter(merged));
+                axis.swap(merged);
+            }
+            return axis;
+        }
+    }
+
+    // PanelView implementation
+    size_t PanelView::valid_count(size_t bar) const
+    {
+        size_t count = 0;
+        for (uint64_t word : valid_row(bar))
+        {
+            count += static_cast<size_t>(std::popcount(word));
+        }
+        return count;
+    }
+
+    PanelView PanelView::slice(size_t offset, size_t count) const
+    {
+        offset = std::min(offset, bars());
+        count = std::min(count, bars() - offset);
+
+        PanelView view = *this;
+        view.timestamps_ = timestamps_.subspan(offset, count);
+        for (size_t f = 0; f < kFieldCount; ++f)
+        {
+            view.fields_[f] = fields_[f] + offset * stride_;
+        }
+        view.valid_ = valid_ + offset * words_;
+        return view;
+    }
+
+    PanelView PanelView::slice(std::chrono::system_clock::time_point start,
+                               std::chrono::system_clock::time_point end) const
+    {
+        auto first = std::lower_bound(timestamps_.begin(), timestamps_.end(), to_epoch_nanos(start));
+        auto last = std::lower_bound(first, timestamps_.end(), to_epoch_nanos(end));
+        return slice(static_cast<size_t>(first - timestamps_.begin()), static_cast<size_t>(last - first));
+    }
+
+    PanelSymbolView PanelView::symbol(size_t index) const
+    {
+        if (index >= symbols())
+        {
+            throw std::out_of_range("Symbol index out of range");
+        }
+        return PanelSymbolView(*this, index);
+    }
+
+    size_t PanelView::find(const std::string &symbol) const
+    {
+        for (size_t s = 0; s < symbols(); ++s)
+        {
+            if ((*symbols_)[s] == symbol)
+            {
+                return s;
+            }
+        }
+        return npos;
+    }
+
+    // PanelSymbolView implementation
+    std::vector<double> PanelSymbolView::column(PanelField field) const
+    {
+        std::vector<double> values(size());
+        for (size_t t = 0; t < values.size(); ++t)
+        {
+            values[t] = at(field, t);
+        }
+        return values;
+    }
+
+    ColumnarSeries PanelSymbolView::to_columnar() const
+    {
+        ColumnarSeries columnar(symbol());
+        for (size_t t = 0; t < size(); ++t)
+        {
+            if (valid(t))
+            {
+                columnar.add_point(panel_.timestamps()[t], at(PanelField::OPEN, t), at(PanelField::HIGH, t),
+                                   at(PanelField::LOW, t), at(PanelField::CLOSE, t), at(PanelField::VOLUME, t));
+            }
+        }
+        return columnar;
+    }
+
+    MarketDataSeries PanelSymbolView::to_series() const
+    {
+        return to_columnar().to_series();
+    }
+
+    // UniversePanel implementation
+    UniversePanel::UniversePanel()
+        : symbols_(std::make_unique<std::vector<std::string>>())
+    {
+        view_.symbols_ = symbols_.get();
+    }
+
+    UniversePanel UniversePanel::build(std::vector<std::string> names,
+                                       const std::vector<const MarketDataSeries *> &series, ThreadPool *thread_pool)
+    {
+        UniversePanel panel;
+        *panel.symbols_ = std::move(names);
+        panel.timestamps_ = union_axis(series);
+
+        const size_t symbols = series.size();
+        const size_t bars = panel.timestamps_.size();
+        const size_t stride = (symbols + kLineDoubles - 1) / kLineDoubles * kLineDoubles;
+        const size_t words = (symbols + kGroupSymbols - 1) / kGroupSymbols;
+        const size_t matrix = stride * bars;
+
+        // One allocation for every field, with slack to put the first row
+        // on a cache-line boundary; each matrix is a whole number of lines
+        panel.values_.assign(kFieldCount * matrix + kLineDoubles, std::numeric_limits<double>::quiet_NaN());
+        panel.valid_.assign(words * bars, 0);
+        auto address = reinterpret_cast<uintptr_t>(panel.values_.data());
+        size_t skew = ((64 - address % 64) % 64) / sizeof(double);
+        double *base = panel.values_.data() + skew;
+
+        PanelView &view = panel.view_;
+        view.timestamps_ = panel.timestamps_;
+        for (size_t f = 0; f < kFieldCount; ++f)
+        {
+            view.fields_[f] = base + f * matrix;
+        }
+        view.valid_ = panel.valid_.data();
+        view.stride_ = stride;
+        view.words_ = words;
+
+        // Fill one group of 64 symbols row by row, walking each symbol's
+        // bars with a cursor; the group owns its bitmap word in every row
+        const int64_t *axis = panel.timestamps_.data();
+        uint64_t *valid = panel.valid_.data();
+        auto fill_group = [&](size_t group)
+        {
+            const size_t first = group * kGroupSymbols;
+            const size_t last = std::min(symbols, first + kGroupSymbols);
+            size_t cursor[kGroupSymbols] = {};
+            for (size_t t = 0; t < bars; ++t)
+            {
+                double *row[kFieldCount];
+                for (size_t f = 0; f < kFieldCount; ++f)
+                {
+                    row[f] = base + f * matrix + t * stride;
+                }
+                uint64_t bits = 0;
+                for (size_t s = first; s < last; ++s)
+                {
+                    if (!series[s])
+                    {
+                        continue;
+                    }
+                    const auto &data = series[s]->data();
+                    size_t &k = cursor[s - first];
+                    if (k == data.size() || to_epoch_nanos(data[k].timestamp) != axis[t])
+                    {
+                        continue;
+                    }
+                    while (k + 1 < data.size() && to_epoch_nanos(data[k + 1].timestamp) == axis[t])
+                    {
+                        ++k;
+                    }
+                    const auto &point = data[k++];
+                    row[static_cast<size_t>(PanelField::OPEN)][s] = point.open;
+                    row[static_cast<size_t>(PanelField::HIGH)][s] = point.high;
+                    row[static_cast<size_t>(PanelField::LOW)][s] = point.low;
+                    row[static_cast<size_t>(PanelField::CLOSE)][s] = point.close;
+                    row[static_cast<size_t>(PanelField::VOLUME)][s] = static_cast<double>(point.volume);
+                    bits |= uint64_t(1) << (s - first);
+                }
+                valid[t * words + group] = bits;
+            }
+        };
+
+        if (thread_pool && words > 1)
+        {
+            thread_pool->parallel_for(0, words, fill_group, 1);
+        }
+        else
+        {
+            for (size_t group = 0; group < words; ++group)
+            {
+                fill_group(group);
+            }
+        }
+        return panel;
+    }
+
+    UniversePanel UniversePanel::from_series(const std::vector<std::shared_ptr<const MarketDataSeries>> &series,
+                                             std::shared_ptr<ThreadPool> thread_pool)
+    {
+        std::vector<std::string> names;
+        std::vector<const MarketDataSeries *> pointers;
+        names.reserve(series.size());
+        pointers.reserve(series.size());
+        for (const auto &s : series)
+        {
+            names.push_back(s ? s->symbol() : std::string());
+            pointers.push_back(s.get());
+        }
+        return build(std::move(names), pointers, thread_pool.get());
+    }
+
+    UniversePanel UniversePanel::from_series(const std::vector<MarketDataSeries> &series,
+                                             std::shared_ptr<ThreadPool> thread_pool)
+    {
+        std::vector<std::string> names;
+        std::vector<const MarketDataSeries *> pointers;
+        names.reserve(series.size());
+        pointers.reserve(series.size());
+        for (const auto &s : series)
+        {
+            names.push_back(s.symbol());
+            pointers.push_back(&s);
+        }
+        return build(std::move(names), pointers, thread_pool.get());
+    }
+
+    UniversePanel UniversePanel::load(CacheManager &cache, const std::vector<std::string> &keys,
+                                      std::shared_ptr<ThreadPool> thread_pool)
+    {
+        // Entries that are only on disk are faulted in by get(), so running
+        // the lookups on the pool overlaps the loads
+        std::vector<std::shared_ptr<const MarketDataSeries>> series(keys.size());
+        auto fetch = [&](size_t i)
+        {
+            series[i] = cache.get(keys[i]);
+        };
+        if (thread_pool && keys.size() > 1)
+        {
+            thread_pool->parallel_for(0, keys.size(), fetch, 1);
+        }
+        else
+        {
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                fetch(i);
+            }
+        }
+
+        std::vector<std::string> names;
+        std::vector<const MarketDataSeries *> pointers;
+        names.reserve(keys.size());
+        pointers.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            names.push_back(series[i] && !series[i]->symbol().empty() ? series[i]->symbol() : keys[i]);
+            pointers.push_back(series[i].get());
+        }
+        return build(std::move(names), pointers, thread_pool.get());
+    }
+
+    size_t UniversePanel::memory_bytes() const
+    {
+        return values_.size() * sizeof(double) + valid_.size() * sizeof(uint64_t) +
+               timestamps_.size() * sizeof(int64_t);
+    }
+
+} // namespace trading
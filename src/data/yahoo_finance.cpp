@@ -1,131 +1,440 @@
 #include "data/yahoo_finance.h"
-#include "external/json.hpp"
+#include "data/rate_limiter.h"
+#include "data/chart_parser.h"
+#include "core/metrics.h"
 #include <sstream>
 #include <iomanip>
 #include <stdexcept>
-
-using json = nlohmann::json;
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <deque>
+#include <unordered_map>
+#include <algorithm>
+#include <random>
+#include <optional>
 
 namespace trading
 {
-    YahooFinanceClient::YahooFinanceClient(std::shared_ptr<ThreadPool> thread_pool)
-        : thread_pool_(thread_pool), curl_handle_(nullptr)
+    namespace
     {
-        // Initialize CURL
-        curl_global_init(CURL_GLOBAL_ALL);
-        curl_handle_ = curl_easy_init();
+        constexpr auto kInitialBackoff = std::chrono::milliseconds(1000);
+        constexpr auto kMaxBackoff = std::chrono::milliseconds(30000);
+        constexpr auto kIdlePoll = std::chrono::milliseconds(1000);
 
-        if (!curl_handle_)
+        // Errors worth retrying: the same request may well succeed later
+        bool is_transient(CURLcode result)
         {
-            throw std::runtime_error("Failed to initialize CURL");
+            switch (result)
+            {
+            case CURLE_COULDNT_RESOLVE_HOST:
+            case CURLE_COULDNT_CONNECT:
+            case CURLE_OPERATION_TIMEDOUT:
+            case CURLE_SSL_CONNECT_ERROR:
+            case CURLE_SEND_ERROR:
+            case CURLE_RECV_ERROR:
+            case CURLE_GOT_NOTHING:
+            case CURLE_PARTIAL_FILE:
+            case CURLE_HTTP2:
+            case CURLE_HTTP2_STREAM:
+                return true;
+            default:
+                return false;
+            }
         }
 
-        // Set default CURL options
-        curl_easy_setopt(curl_handle_, CURLOPT_TIMEOUT, timeout_seconds_);
-        curl_easy_setopt(curl_handle_, CURLOPT_USERAGENT, user_agent_.c_str());
-        curl_easy_setopt(curl_handle_, CURLOPT_FOLLOWLOCATION, 1L);
-        curl_easy_setopt(curl_handle_, CURLOPT_WRITEFUNCTION, write_callback);
-    }
-
-    YahooFinanceClient::~YahooFinanceClient()
-    {
-        if (curl_handle_)
+        struct FetchMetrics
+        {
+            metrics::Histogram fetch{"yahoo_fetch_seconds", "Time from starting an HTTP attempt to its completion"};
+            metrics::Histogram parse{"yahoo_parse_seconds", "Time spent parsing one response, streamed chunks included"};
+            metrics::Counter requests{"yahoo_requests_total", "Fetches started"};
+            metrics::Counter retries{"yahoo_retries_total", "Attempts after the first"};
+            metrics::Counter failures{"yahoo_failures_total", "Fetches that gave up"};
+            metrics::Counter bytes{"yahoo_received_bytes_total", "Response body bytes received"};
+            metrics::Gauge in_flight{"yahoo_active_transfers", "HTTP transfers in progress"};
+        };
+
+        FetchMetrics &fetch_metrics()
         {
-            curl_easy_cleanup(curl_handle_);
+            static FetchMetrics instance;
+            return instance;
         }
-        curl_global_cleanup();
     }
 
-    YahooFinanceClient::YahooFinanceClient(YahooFinanceClient &&other) noexcept
-        : thread_pool_(std::move(other.thread_pool_)), curl_handle_(other.curl_handle_), timeout_seconds_(other.timeout_seconds_), max_retries_(other.max_retries_), user_agent_(std::move(other.user_agent_))
+    /**
+     * Event loop on a dedicated thread. Other threads only append to the
+     * incoming queue and wake the loop; every curl handle is touched by
+     * the I/O thread alone, so transfers need no locking of their own.
+     */
+    struct YahooFinanceClient::IoLoop
     {
-        other.curl_handle_ = nullptr;
-    }
+        struct Transfer
+        {
+            MarketDataRequest request;
+            std::promise<MarketDataSeries> promise;
+            std::optional<ChartStreamParser> parser; // Fresh for every attempt
+            std::exception_ptr parse_error;
+            int attempts = 0;
+            std::chrono::steady_clock::time_point ready_at; // When a backed-off retry may start
+            uint64_t started_at = 0;                        // metrics::ticks() when this attempt started
+            uint64_t parse_ticks = 0;                       // Spent in the parser during this attempt
+            char error[CURL_ERROR_SIZE] = {};
+        };
+
+        IoLoop();
+        ~IoLoop();
+
+        // HTTP response callback: parses the body as it arrives
+        static size_t write_callback(char *contents, size_t size, size_t nmemb, void *userp);
+
+        // Heap order for the backoff queue: earliest ready_at on top
+        static bool later(const std::unique_ptr<Transfer> &a, const std::unique_ptr<Transfer> &b)
+        {
+            return a->ready_at > b->ready_at;
+        }
 
-    YahooFinanceClient &YahooFinanceClient::operator=(YahooFinanceClient &&other) noexcept
+        void submit(std::vector<std::unique_ptr<Transfer>> transfers);
+        void run();
+        void start(std::unique_ptr<Transfer> transfer);
+        void finish(CURL *handle, CURLcode result);
+        void fail(Transfer &transfer, const std::string &reason);
+        std::chrono::steady_clock::duration backoff(int attempts);
+        std::string build_url(const MarketDataRequest &request);
+        CURL *acquire_handle();
+        void release_handle(CURL *handle);
+
+        CURLM *multi = nullptr;
+        CURLSH *share = nullptr;
+        std::thread thread;
+
+        // Shared with submitting threads
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Transfer>> incoming;
+        bool stopping = false;
+
+        // Owned by the I/O thread
+        std::deque<std::unique_ptr<Transfer>> ready;
+        std::vector<std::unique_ptr<Transfer>> waiting; // Min-heap on ready_at
+        std::unordered_map<CURL *, std::unique_ptr<Transfer>> active;
+        std::vector<CURL *> idle_handles;
+        std::mt19937_64 jitter{std::random_device{}()};
+
+        // Settings
+        RateLimiter limiter{10.0, 20.0};
+        std::atomic<int> timeout_seconds{30};
+        std::atomic<int> max_retries{3};
+        std::atomic<size_t> max_connections{16};
+        std::mutex config_mutex;
+        std::string base_url{"https://query1.finance.yahoo.com/v8/finance/chart/"};
+        const std::string user_agent{"TradingSimulator/1.0"};
+    };
+
+    YahooFinanceClient::IoLoop::IoLoop()
     {
-        if (this != &other)
+        multi = curl_multi_init();
+        share = curl_share_init();
+        if (!multi || !share)
         {
-            if (curl_handle_)
+            if (multi)
             {
-                curl_easy_cleanup(curl_handle_);
+                curl_multi_cleanup(multi);
             }
+            if (share)
+            {
+                curl_share_cleanup(share);
+            }
+            throw std::runtime_error("Failed to initialize CURL");
+        }
 
-            thread_pool_ = std::move(other.thread_pool_);
-            curl_handle_ = other.curl_handle_;
-            timeout_seconds_ = other.timeout_seconds_;
-            max_retries_ = other.max_retries_;
-            user_agent_ = std::move(other.user_agent_);
+        // The multi handle pools connections; the share handle adds DNS and
+        // TLS session reuse, so reconnects skip the full handshake
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+        thread = std::thread(&IoLoop::run, this);
+    }
 
-            other.curl_handle_ = nullptr;
+    YahooFinanceClient::IoLoop::~IoLoop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
         }
-        return *this;
+        curl_multi_wakeup(multi);
+        thread.join();
+
+        for (CURL *handle : idle_handles)
+        {
+            curl_easy_cleanup(handle);
+        }
+        curl_multi_cleanup(multi);
+        curl_share_cleanup(share);
     }
 
-    std::future<MarketDataSeries> YahooFinanceClient::fetch_historical_data(const MarketDataRequest &request)
+    void YahooFinanceClient::IoLoop::submit(std::vector<std::unique_ptr<Transfer>> transfers)
     {
-        return thread_pool_->submit([this, request]()
-                                    { return fetch_historical_data_sync(request); });
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping)
+            {
+                throw std::runtime_error("YahooFinanceClient is shutting down");
+            }
+            for (auto &transfer : transfers)
+            {
+                incoming.push_back(std::move(transfer));
+            }
+        }
+        curl_multi_wakeup(multi);
     }
 
-    MarketDataSeries YahooFinanceClient::fetch_historical_data_sync(const MarketDataRequest &request)
+    void YahooFinanceClient::IoLoop::run()
     {
-        std::string url = build_url(request);
-        std::string response;
+        while (true)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (auto &transfer : incoming)
+                {
+                    ready.push_back(std::move(transfer));
+                }
+                incoming.clear();
 
-        // Set up CURL for this request
-        curl_easy_setopt(curl_handle_, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl_handle_, CURLOPT_WRITEDATA, &response);
+                if (stopping)
+                {
+                    break;
+                }
+            }
 
-        // Perform the request with retries
-        CURLcode result;
-        int retry_count = 0;
+            // Retries whose backoff has elapsed rejoin the queue
+            auto now = std::chrono::steady_clock::now();
+            while (!waiting.empty() && waiting.front()->ready_at <= now)
+            {
+                std::pop_heap(waiting.begin(), waiting.end(), later);
+                ready.push_back(std::move(waiting.back()));
+                waiting.pop_back();
+            }
 
-        do
-        {
-            response.clear();
-            result = curl_easy_perform(curl_handle_);
+            // Start as many transfers as the connection and rate limits allow
+            while (!ready.empty() && active.size() < max_connections && limiter.try_acquire(now))
+            {
+                auto transfer = std::move(ready.front());
+                ready.pop_front();
+                start(std::move(transfer));
+            }
 
-            if (result != CURLE_OK)
+            int running = 0;
+            curl_multi_perform(multi, &running);
+
+            int queued = 0;
+            while (CURLMsg *message = curl_multi_info_read(multi, &queued))
             {
-                retry_count++;
-                if (retry_count < max_retries_)
+                if (message->msg == CURLMSG_DONE)
                 {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(1000 * retry_count));
-                    continue;
+                    finish(message->easy_handle, message->data.result);
                 }
-                handle_curl_error(result, "fetch_historical_data");
             }
-        } while (result != CURLE_OK && retry_count < max_retries_);
 
-        if (result != CURLE_OK)
+            // Sleep until sockets are ready, a token accrues or a backoff ends
+            now = std::chrono::steady_clock::now();
+            auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(kIdlePoll);
+            if (!ready.empty() && active.size() < max_connections)
+            {
+                wait = std::min(wait, std::chrono::ceil<std::chrono::milliseconds>(limiter.wait_time(now)));
+            }
+            if (!waiting.empty())
+            {
+                auto until_retry = std::chrono::ceil<std::chrono::milliseconds>(waiting.front()->ready_at - now);
+                wait = std::min(wait, std::max(until_retry, std::chrono::milliseconds(0)));
+            }
+            long curl_timeout = -1;
+            curl_multi_timeout(multi, &curl_timeout);
+            if (curl_timeout >= 0)
+            {
+                wait = std::min(wait, std::chrono::milliseconds(curl_timeout));
+            }
+
+            curl_multi_poll(multi, nullptr, 0, static_cast<int>(wait.count()), nullptr);
+        }
+
+        // Shutting down: fail whatever is still outstanding
+        for (auto &[handle, transfer] : active)
+        {
+            curl_multi_remove_handle(multi, handle);
+            curl_easy_cleanup(handle);
+            fail(*transfer, "client destroyed");
+        }
+        fetch_metrics().in_flight.sub(static_cast<int64_t>(active.size()));
+        active.clear();
+        for (auto &transfer : ready)
+        {
+            fail(*transfer, "client destroyed");
+        }
+        for (auto &transfer : waiting)
+        {
+            fail(*transfer, "client destroyed");
+        }
+    }
+
+    void YahooFinanceClient::IoLoop::start(std::unique_ptr<Transfer> transfer)
+    {
+        CURL *handle;
+        try
+        {
+            handle = acquire_handle();
+        }
+        catch (const std::exception &e)
         {
-            throw std::runtime_error("Failed to fetch data after " + std::to_string(max_retries_) + " retries");
+            fail(*transfer, e.what());
+            return;
         }
 
-        return parse_json_response(response, request.symbol);
+        FetchMetrics &stats = fetch_metrics();
+        (transfer->attempts == 0 ? stats.requests : stats.retries).add();
+        transfer->attempts++;
+        transfer->parser.emplace(transfer->request.symbol);
+        transfer->parse_error = nullptr;
+        transfer->error[0] = '\0';
+        transfer->started_at = metrics::ticks();
+        transfer->parse_ticks = 0;
+
+        // libcurl copies string options, so the temporary URL is fine
+        std::string url = build_url(transfer->request);
+        curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(handle, CURLOPT_TIMEOUT, static_cast<long>(timeout_seconds.load()));
+        curl_easy_setopt(handle, CURLOPT_USERAGENT, user_agent.c_str());
+        curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, "");
+        curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+        curl_easy_setopt(handle, CURLOPT_SHARE, share);
+        curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, write_callback);
+        curl_easy_setopt(handle, CURLOPT_WRITEDATA, transfer.get());
+        curl_easy_setopt(handle, CURLOPT_ERRORBUFFER, transfer->error);
+
+        curl_multi_add_handle(multi, handle);
+        active.emplace(handle, std::move(transfer));
+        stats.in_flight.add(1);
     }
 
-    double YahooFinanceClient::get_current_price(const std::string &symbol)
+    size_t YahooFinanceClient::IoLoop::write_callback(char *contents, size_t size, size_t nmemb, void *userp)
     {
-        // For now, return a placeholder value
-        // In a real implementation, you would fetch the current price
-        return 100.0;
+        auto *transfer = static_cast<Transfer *>(userp);
+        fetch_metrics().bytes.add(size * nmemb);
+        uint64_t begin = metrics::ticks();
+        try
+        {
+            transfer->parser->feed(std::string_view(contents, size * nmemb));
+            transfer->parse_ticks += metrics::ticks() - begin;
+            return size * nmemb;
+        }
+        catch (...)
+        {
+            // Abort the transfer; there is no point downloading the rest
+            transfer->parse_error = std::current_exception();
+            return 0;
+        }
     }
 
-    bool YahooFinanceClient::validate_symbol(const std::string &symbol)
+    void YahooFinanceClient::IoLoop::finish(CURL *handle, CURLcode result)
     {
-        // For now, just check if the symbol is not empty
-        return !symbol.empty();
+        auto it = active.find(handle);
+        if (it == active.end())
+        {
+            return;
+        }
+        auto transfer = std::move(it->second);
+        active.erase(it);
+        FetchMetrics &stats = fetch_metrics();
+        stats.in_flight.sub(1);
+        stats.fetch.record(metrics::ticks() - transfer->started_at);
+
+        long status = 0;
+        curl_off_t retry_after = 0;
+        curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &status);
+        curl_easy_getinfo(handle, CURLINFO_RETRY_AFTER, &retry_after);
+        curl_multi_remove_handle(multi, handle);
+        release_handle(handle);
+
+        // Non-HTTP URLs (file://) report status 0
+        if (result == CURLE_OK && status < 400)
+        {
+            try
+            {
+                uint64_t begin = metrics::ticks();
+                auto series = transfer->parser->finish().to_series();
+                stats.parse.record(transfer->parse_ticks + metrics::ticks() - begin);
+                transfer->promise.set_value(std::move(series));
+            }
+            catch (...)
+            {
+                transfer->promise.set_exception(std::current_exception());
+            }
+            return;
+        }
+
+        // An unparseable body is only the real error if the status was fine
+        if (result == CURLE_WRITE_ERROR && transfer->parse_error)
+        {
+            if (status < 400)
+            {
+                transfer->promise.set_exception(transfer->parse_error);
+                return;
+            }
+            result = CURLE_OK;
+        }
+
+        bool transient = result != CURLE_OK ? is_transient(result) : (status == 429 || status >= 500);
+        if (transient && transfer->attempts < max_retries)
+        {
+            // Back off on a timer rather than a sleeping thread
+            auto delay = retry_after > 0 ? std::chrono::seconds(retry_after) : backoff(transfer->attempts);
+            transfer->ready_at = std::chrono::steady_clock::now() + delay;
+            waiting.push_back(std::move(transfer));
+            std::push_heap(waiting.begin(), waiting.end(), later);
+            return;
+        }
+
+        if (result != CURLE_OK)
+        {
+            fail(*transfer, "CURL error in fetch_historical_data: " +
+                                std::string(transfer->error[0] ? transfer->error : curl_easy_strerror(result)));
+        }
+        else
+        {
+            // Error bodies are usually a chart.error document worth reporting
+            std::string reason = "HTTP status " + std::to_string(status);
+            if (!transfer->parse_error)
+            {
+                try
+                {
+                    transfer->parser->finish();
+                }
+                catch (const std::runtime_error &e)
+                {
+                    reason += " (" + std::string(e.what()) + ")";
+                }
+            }
+            fail(*transfer, reason);
+        }
+    }
+
+    void YahooFinanceClient::IoLoop::fail(Transfer &transfer, const std::string &reason)
+    {
+        fetch_metrics().failures.add();
+        transfer.promise.set_exception(std::make_exception_ptr(std::runtime_error(
+            "Failed to fetch " + transfer.request.symbol + " after " + std::to_string(transfer.attempts) +
+            " attempt(s): " + reason)));
     }
 
-    size_t YahooFinanceClient::write_callback(void *contents, size_t size, size_t nmemb, std::string *userp)
+    std::chrono::steady_clock::duration YahooFinanceClient::IoLoop::backoff(int attempts)
     {
-        userp->append((char *)contents, size * nmemb);
-        return size * nmemb;
+        // Exponential, capped, with jitter so a burst of failures does not retry in lockstep
+        auto delay = std::min<std::chrono::steady_clock::duration>(kInitialBackoff * (1LL << std::min(attempts - 1, 16)), kMaxBackoff);
+        std::uniform_real_distribution<double> scale(0.5, 1.0);
+        return std::chrono::duration_cast<std::chrono::steady_clock::duration>(delay * scale(jitter));
     }
 
-    std::string YahooFinanceClient::build_url(const MarketDataRequest &request) const
+    std::string YahooFinanceClient::IoLoop::build_url(const MarketDataRequest &request)
     {
         // Convert timestamps to Unix timestamps
         auto start_ts = std::chrono::duration_cast<std::chrono::seconds>(
@@ -137,8 +446,11 @@ namespace trading
 
         // Build Yahoo Finance API URL
         std::ostringstream url;
-        url << "https://query1.finance.yahoo.com/v8/finance/chart/"
-            << request.symbol
+        {
+            std::lock_guard<std::mutex> lock(config_mutex);
+            url << base_url;
+        }
+        url << request.symbol
             << "?period1=" << start_ts
             << "&period2=" << end_ts
             << "&interval=" << request.interval
@@ -148,72 +460,154 @@ namespace trading
         return url.str();
     }
 
-    MarketDataSeries YahooFinanceClient::parse_json_response(const std::string &json_data, const std::string &symbol) const
+    CURL *YahooFinanceClient::IoLoop::acquire_handle()
     {
-        try
+        if (!idle_handles.empty())
         {
-            json j = json::parse(json_data);
-
-            MarketDataSeries series(symbol);
+            // Reset keeps the handle's connection and session caches
+            CURL *handle = idle_handles.back();
+            idle_handles.pop_back();
+            curl_easy_reset(handle);
+            return handle;
+        }
 
-            // Check if the response contains data
-            if (j["chart"]["error"].is_object())
-            {
-                throw std::runtime_error("Yahoo Finance API error: " + j["chart"]["error"]["description"].get<std::string>());
-            }
+        CURL *handle = curl_easy_init();
+        if (!handle)
+        {
+            throw std::runtime_error("Failed to initialize CURL");
+        }
+        return handle;
+    }
 
-            auto result = j["chart"]["result"][0];
-            auto timestamp = result["timestamp"];
-            auto indicators = result["indicators"]["quote"][0];
+    void YahooFinanceClient::IoLoop::release_handle(CURL *handle)
+    {
+        if (idle_handles.size() < max_connections)
+        {
+            idle_handles.push_back(handle);
+        }
+        else
+        {
+            curl_easy_cleanup(handle);
+        }
+    }
 
-            // Get OHLCV data
-            auto open = indicators["open"];
-            auto high = indicators["high"];
-            auto low = indicators["low"];
-            auto close = indicators["close"];
-            auto volume = indicators["volume"];
+    YahooFinanceClient::YahooFinanceClient(std::shared_ptr<ThreadPool> thread_pool)
+        : thread_pool_(thread_pool)
+    {
+        // Initialize CURL
+        curl_global_init(CURL_GLOBAL_ALL);
+        try
+        {
+            io_ = std::make_unique<IoLoop>();
+        }
+        catch (...)
+        {
+            curl_global_cleanup();
+            throw;
+        }
+    }
 
-            // Process each data point
-            for (size_t i = 0; i < timestamp.size(); ++i)
-            {
-                // Skip if any required data is missing
-                if (open[i].is_null() || high[i].is_null() || low[i].is_null() || close[i].is_null())
-                {
-                    continue;
-                }
+    YahooFinanceClient::~YahooFinanceClient()
+    {
+        if (io_)
+        {
+            io_.reset();
+            curl_global_cleanup();
+        }
+    }
 
-                MarketDataPoint point(
-                    parse_timestamp(timestamp[i].get<int64_t>()),
-                    open[i].get<double>(),
-                    high[i].get<double>(),
-                    low[i].get<double>(),
-                    close[i].get<double>(),
-                    volume[i].is_null() ? 0 : volume[i].get<int64_t>());
+    YahooFinanceClient::YahooFinanceClient(YahooFinanceClient &&other) noexcept
+        : thread_pool_(std::move(other.thread_pool_)), io_(std::move(other.io_))
+    {
+    }
 
-                series.add_point(std::move(point));
+    YahooFinanceClient &YahooFinanceClient::operator=(YahooFinanceClient &&other) noexcept
+    {
+        if (this != &other)
+        {
+            if (io_)
+            {
+                io_.reset();
+                curl_global_cleanup();
             }
 
-            return series;
+            thread_pool_ = std::move(other.thread_pool_);
+            io_ = std::move(other.io_);
         }
-        catch (const json::exception &e)
+        return *this;
+    }
+
+    std::future<MarketDataSeries> YahooFinanceClient::fetch_historical_data(const MarketDataRequest &request)
+    {
+        auto futures = fetch_batch({request});
+        return std::move(futures.front());
+    }
+
+    std::vector<std::future<MarketDataSeries>> YahooFinanceClient::fetch_batch(const std::vector<MarketDataRequest> &requests)
+    {
+        std::vector<std::unique_ptr<IoLoop::Transfer>> transfers;
+        std::vector<std::future<MarketDataSeries>> futures;
+        transfers.reserve(requests.size());
+        futures.reserve(requests.size());
+
+        for (const auto &request : requests)
         {
-            throw std::runtime_error("JSON parsing error: " + std::string(e.what()));
+            auto transfer = std::make_unique<IoLoop::Transfer>();
+            transfer->request = request;
+            futures.push_back(transfer->promise.get_future());
+            transfers.push_back(std::move(transfer));
         }
+
+        // One lock and one wake-up for the whole batch
+        io_->submit(std::move(transfers));
+        return futures;
     }
 
-    std::chrono::system_clock::time_point YahooFinanceClient::parse_timestamp(int64_t timestamp) const
+    MarketDataSeries YahooFinanceClient::fetch_historical_data_sync(const MarketDataRequest &request)
     {
-        return std::chrono::system_clock::from_time_t(timestamp);
+        return fetch_historical_data(request).get();
     }
 
-    void YahooFinanceClient::handle_curl_error(CURLcode result, const std::string &operation) const
+    double YahooFinanceClient::get_current_price(const std::string &symbol)
+    {
+        // For now, return a placeholder value
+        // In a real implementation, you would fetch the current price
+        return 100.0;
+    }
+
+    bool YahooFinanceClient::validate_symbol(const std::string &symbol)
+    {
+        // For now, just check if the symbol is not empty
+        return !symbol.empty();
+    }
+
+    void YahooFinanceClient::set_timeout(int timeout_seconds)
+    {
+        io_->timeout_seconds = timeout_seconds;
+    }
+
+    void YahooFinanceClient::set_max_retries(int max_retries)
+    {
+        io_->max_retries = max_retries;
+    }
+
+    void YahooFinanceClient::set_rate_limit(double requests_per_second, double burst)
+    {
+        io_->limiter.set_rate(requests_per_second, burst);
+    }
+
+    void YahooFinanceClient::set_max_connections(size_t max_connections)
     {
-        std::string error_msg = "CURL error in " + operation + ": " + get_error_message(result);
-        throw std::runtime_error(error_msg);
+        if (max_connections == 0)
+        {
+            throw std::invalid_argument("max_connections must be positive");
+        }
+        io_->max_connections = max_connections;
     }
 
-    std::string YahooFinanceClient::get_error_message(CURLcode result) const
+    void YahooFinanceClient::set_base_url(const std::string &base_url)
     {
-        return curl_easy_strerror(result);
+        std::lock_guard<std::mutex> lock(io_->config_mutex);
+        io_->base_url = base_url;
     }
-}
\ No newline at end of file
+}
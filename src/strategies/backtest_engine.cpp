@@ -0,0 +1,416 @@
+#include "strategies/backtest_engine.h"
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <stdexcept>
+
+namespace trading
+{
+    BacktestEngine::BacktestEngine(const BacktestConfig &config)
+        : config_(config),
+          bar_queue_(config.queue_capacity),
+          order_queue_(config.queue_capacity),
+          fill_queue_(std::max(config.queue_capacity, std::min(config.max_working_orders, config.order_pool_size))),
+          order_pool_(sizeof(Order), config.order_pool_size),
+          scratch_(config.scratch_bytes)
+    {
+        if (config_.queue_capacity == 0 || config_.order_pool_size == 0)
+        {
+            throw std::invalid_argument("Queue capacity and order pool size must be greater than 0");
+        }
+
+        // Working orders never outnumber the orders the pool can hold
+        config_.max_working_orders = std::min(config_.max_working_orders, config_.order_pool_size);
+        working_orders_.reserve(config_.max_working_orders);
+    }
+
+    BacktestEngine::~BacktestEngine()
+    {
+        // Return any orders left over from an interrupted run
+        reset();
+    }
+
+    BacktestResult BacktestEngine::run(const MarketDataSeries &series, Strategy &strategy)
+    {
+        start_time_ = std::chrono::steady_clock::now();
+        start_run(series, strategy);
+        replay(0, series.size(), [&series](size_t i) -> const MarketDataPoint &
+               { return series[i]; }, strategy);
+        return finish_run(strategy);
+    }
+
+    BacktestResult BacktestEngine::run_streaming(ChunkedSeriesReader &reader, Strategy &strategy,
+                                                 const ChunkCallback &on_chunk)
+    {
+        start_time_ = std::chrono::steady_clock::now();
+
+        // The first chunk opens the first segment, which names the symbol
+        StreamChunk chunk;
+        bool more = reader.next(chunk);
+        start_run(MarketDataSeries(reader.symbol()), strategy);
+
+        for (; more; more = reader.next(chunk))
+        {
+            if (on_chunk)
+            {
+                on_chunk(chunk);
+            }
+            ColumnarSeriesView bars = chunk.fresh();
+            replay(chunk.first_bar, bars.size(), [&bars](size_t i)
+                   { return bars.point(i); }, strategy);
+        }
+        return finish_run(strategy);
+    }
+
+    void BacktestEngine::start_run(const MarketDataSeries &series, Strategy &strategy)
+    {
+        reset();
+
+        result_.symbol = series.symbol();
+        result_.initial_capital = config_.initial_capital;
+        if (config_.record_equity_curve)
+        {
+            result_.equity_curve.reserve(series.size());
+        }
+        peak_equity_ = config_.initial_capital;
+
+        strategy.on_start(series, *this);
+        scratch_.reset();
+    }
+
+    template <typename BarAt>
+    void BacktestEngine::replay(size_t first_index, size_t count, BarAt &&bar_at, Strategy &strategy)
+    {
+        size_t next_bar = 0;
+
+        while (next_bar < count || !bar_queue_.empty())
+        {
+            // Market data stage: publish as many bars as the queue accepts
+            while (next_bar < count && bar_queue_.try_push(BarEvent{first_index + next_bar, bar_at(next_bar)}))
+            {
+                ++next_bar;
+            }
+
+            // Strategy/execution stages: consume the published bars in order
+            BarEvent event;
+            while (bar_queue_.try_pop(event))
+            {
+                bar_index_ = event.index;
+
+                if (book_ != nullptr && book_feed_)
+                {
+                    book_feed_(event.index, event.bar, *book_);
+                }
+
+                // Orders submitted on earlier bars trade against this bar first
+                execute_working_orders(event.bar);
+                dispatch_fills(strategy);
+
+                last_price_ = event.bar.close;
+                strategy.on_bar(event.bar, *this);
+                accept_new_orders();
+
+                // Everything the strategy allocated for this bar goes at once
+                scratch_.reset();
+
+                double current_equity = equity();
+                peak_equity_ = std::max(peak_equity_, current_equity);
+                if (peak_equity_ > 0.0)
+                {
+                    result_.max_drawdown = std::max(result_.max_drawdown, (peak_equity_ - current_equity) / peak_equity_);
+                }
+                if (config_.record_equity_curve)
+                {
+                    result_.equity_curve.push_back(current_equity);
+                }
+
+                ++result_.bars_processed;
+            }
+        }
+    }
+
+    BacktestResult BacktestEngine::finish_run(Strategy &strategy)
+    {
+        strategy.on_finish(*this);
+        scratch_.reset();
+        accept_new_orders();
+        cancel_all_orders();
+
+        auto end_time = std::chrono::steady_clock::now();
+
+        result_.final_equity = equity();
+        result_.final_position = position_;
+        result_.total_return = config_.initial_capital != 0.0
+                                   ? (result_.final_equity - config_.initial_capital) / config_.initial_capital
+                                   : 0.0;
+        result_.elapsed_seconds = std::chrono::duration<double>(end_time - start_time_).count();
+        if (result_.elapsed_seconds > 0.0)
+        {
+            result_.bars_per_second = result_.bars_processed / result_.elapsed_seconds;
+            result_.orders_per_second = result_.orders_submitted / result_.elapsed_seconds;
+        }
+
+        return std::move(result_);
+    }
+
+    void BacktestEngine::set_order_book(OrderBook *book, BookFeed feed)
+    {
+        book_ = book;
+        book_feed_ = std::move(feed);
+    }
+
+    uint64_t BacktestEngine::submit_order(OrderSide side, int64_t quantity, OrderType type, double limit_price)
+    {
+        if (quantity <= 0 || (type == OrderType::LIMIT && !(limit_price > 0.0)))
+        {
+            ++result_.orders_rejected;
+            return 0;
+        }
+
+        // Never let the pool grow on the hot path
+        if (live_orders_ >= config_.order_pool_size)
+        {
+            ++result_.orders_rejected;
+            return 0;
+        }
+
+        Order *order = new (order_pool_.allocate())
+            Order(next_order_id_++, side, type, quantity, limit_price, bar_index_);
+        ++live_orders_;
+
+        // If the execution stage is backed up, hand over what is queued and retry once
+        if (!order_queue_.try_push(order))
+        {
+            accept_new_orders();
+            if (!order_queue_.try_push(order))
+            {
+                release_order(order);
+                ++result_.orders_rejected;
+                return 0;
+            }
+        }
+
+        ++result_.orders_submitted;
+        return order->id;
+    }
+
+    void BacktestEngine::cancel_all_orders()
+    {
+        // Pending hand-offs are cancelled along with the working set
+        accept_new_orders();
+
+        for (Order *order : working_orders_)
+        {
+            order->status = OrderStatus::CANCELLED;
+            release_order(order);
+            ++result_.orders_cancelled;
+        }
+        working_orders_.clear();
+    }
+
+    void BacktestEngine::reset()
+    {
+        Order *order = nullptr;
+        while (order_queue_.try_pop(order))
+        {
+            release_order(order);
+        }
+        for (Order *working : working_orders_)
+        {
+            release_order(working);
+        }
+        working_orders_.clear();
+
+        Fill fill;
+        while (fill_queue_.try_pop(fill))
+        {
+        }
+        BarEvent event;
+        while (bar_queue_.try_pop(event))
+        {
+        }
+
+        cash_ = config_.initial_capital;
+        position_ = 0;
+        last_price_ = 0.0;
+        bar_index_ = 0;
+        next_order_id_ = 1;
+        result_ = BacktestResult{};
+    }
+
+    void BacktestEngine::execute_working_orders(const MarketDataPoint &bar)
+    {
+        // Compact the working set in place, keeping unfilled orders in submission order
+        size_t kept = 0;
+        for (size_t i = 0; i < working_orders_.size(); ++i)
+        {
+            Order *order = working_orders_[i];
+            if (try_fill(*order, bar))
+            {
+                release_order(order);
+            }
+            else if (order->status == OrderStatus::REJECTED)
+            {
+                release_order(order);
+                ++result_.orders_rejected;
+            }
+            else
+            {
+                working_orders_[kept++] = order;
+            }
+        }
+        working_orders_.resize(kept);
+    }
+
+    bool BacktestEngine::try_fill(Order &order, const MarketDataPoint &bar)
+    {
+        if (book_ != nullptr)
+        {
+            return try_fill_from_book(order);
+        }
+
+        double price;
+
+        if (order.type == OrderType::MARKET)
+        {
+            double slip = bar.open * config_.slippage_bps / 10000.0;
+            price = order.side == OrderSide::BUY ? bar.open + slip : bar.open - slip;
+        }
+        else if (order.side == OrderSide::BUY)
+        {
+            if (bar.low > order.limit_price)
+            {
+                return false;
+            }
+            price = std::min(bar.open, order.limit_price);
+        }
+        else
+        {
+            if (bar.high < order.limit_price)
+            {
+                return false;
+            }
+            price = std::max(bar.open, order.limit_price);
+        }
+
+        if (!record_fill(order, order.quantity, price))
+        {
+            return false;
+        }
+
+        order.status = OrderStatus::FILLED;
+        ++result_.orders_filled;
+        return true;
+    }
+
+    bool BacktestEngine::try_fill_from_book(Order &order)
+    {
+        BookSide taker = order.side == OrderSide::BUY ? BookSide::BID : BookSide::ASK;
+        std::optional<double> limit;
+        if (order.type == OrderType::LIMIT)
+        {
+            limit = order.limit_price;
+        }
+
+        // Price the sweep first; the book only changes once the fill is accepted
+        BookQuote quote = book_->quote(taker, static_cast<uint64_t>(order.quantity), limit);
+        if (quote.quantity == 0)
+        {
+            return false;
+        }
+
+        int64_t quantity = static_cast<int64_t>(quote.quantity);
+        if (!record_fill(order, quantity, quote.average_price()))
+        {
+            return false;
+        }
+        book_->match(taker, quote.quantity, limit);
+
+        order.quantity -= quantity;
+        if (order.quantity > 0)
+        {
+            // Partially filled: the rest keeps working
+            return false;
+        }
+
+        order.status = OrderStatus::FILLED;
+        ++result_.orders_filled;
+        return true;
+    }
+
+    bool BacktestEngine::record_fill(Order &order, int64_t quantity, double price)
+    {
+        double commission = config_.commission_per_share * static_cast<double>(quantity);
+        double notional = price * static_cast<double>(quantity);
+
+        // Portfolio constraints are checked at fill time, when the price is known
+        if (order.side == OrderSide::BUY)
+        {
+            if (!config_.allow_margin && notional + commission > cash_)
+            {
+                order.status = OrderStatus::REJECTED;
+                return false;
+            }
+        }
+        else if (!config_.allow_short && quantity > position_)
+        {
+            order.status = OrderStatus::REJECTED;
+            return false;
+        }
+
+        Fill fill(order.id, order.side, quantity, price, commission, bar_index_);
+        if (!fill_queue_.try_push(fill))
+        {
+            // Unreachable while the fill queue holds at least max_working_orders entries,
+            // but never drop a fill: leave the order working for the next bar
+            return false;
+        }
+
+        if (order.side == OrderSide::BUY)
+        {
+            cash_ -= notional + commission;
+            position_ += quantity;
+        }
+        else
+        {
+            cash_ += notional - commission;
+            position_ -= quantity;
+        }
+
+        result_.total_commission += commission;
+        return true;
+    }
+
+    void BacktestEngine::dispatch_fills(Strategy &strategy)
+    {
+        Fill fill;
+        while (fill_queue_.try_pop(fill))
+        {
+            strategy.on_fill(fill, *this);
+        }
+    }
+
+    void BacktestEngine::accept_new_orders()
+    {
+        Order *order = nullptr;
+        while (order_queue_.try_pop(order))
+        {
+            if (working_orders_.size() >= config_.max_working_orders)
+            {
+                order->status = OrderStatus::REJECTED;
+                release_order(order);
+                ++result_.orders_rejected;
+                continue;
+            }
+            working_orders_.push_back(order);
+        }
+    }
+
+    void BacktestEngine::release_order(Order *order)
+    {
+        order->~Order();
+        order_pool_.deallocate(order);
+        --live_orders_;
+    }
+
+} // namespace trading
@@ -0,0 +1,334 @@
+#include "strategies/parameter_sweep.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+
+namespace trading
+{
+    double ParameterSet::get(const std::string &name, double default_value) const
+    {
+        for (const auto &[key, value] : values)
+        {
+            if (key == name)
+            {
+                return value;
+            }
+        }
+        return default_value;
+    }
+
+    std::string ParameterSet::to_string() const
+    {
+        std::ostringstream oss;
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (i > 0)
+            {
+                oss << ",";
+            }
+            oss << values[i].first << "=" << values[i].second;
+        }
+        return oss.str();
+    }
+
+    // IndicatorColumns implementation
+    IndicatorColumns::IndicatorColumns(std::shared_ptr<const MarketDataSeries> series)
+        : series_(std::move(series))
+    {
+        if (!series_)
+        {
+            throw std::invalid_argument("IndicatorColumns requires a series");
+        }
+    }
+
+    IndicatorColumns::Column IndicatorColumns::closes()
+    {
+        return get_or_compute("close", [this]()
+                              {
+                                  std::vector<double> prices;
+                                  prices.reserve(series_->size());
+                                  for (const auto &point : series_->data())
+                                  {
+                                      prices.push_back(point.close);
+                                  }
+                                  return prices; });
+    }
+
+    IndicatorColumns::Column IndicatorColumns::sma(int period)
+    {
+        auto prices = closes();
+        return get_or_compute("sma_" + std::to_string(period), [this, prices, period]()
+                              { return processor_.calculate_sma(*prices, period); });
+    }
+
+    IndicatorColumns::Column IndicatorColumns::ema(int period)
+    {
+        auto prices = closes();
+        return get_or_compute("ema_" + std::to_string(period), [this, prices, period]()
+                              { return processor_.calculate_ema(*prices, period); });
+    }
+
+    IndicatorColumns::Column IndicatorColumns::rsi(int period)
+    {
+        auto prices = closes();
+        return get_or_compute("rsi_" + std::to_string(period), [this, prices, period]()
+                              { return processor_.calculate_rsi(*prices, period); });
+    }
+
+    size_t IndicatorColumns::computed_columns() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return columns_.size();
+    }
+
+    IndicatorColumns::Column IndicatorColumns::get_or_compute(const std::string &key,
+                                                              const std::function<std::vector<double>()> &compute)
+    {
+        std::promise<Column> promise;
+        std::shared_future<Column> pending;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            auto it = columns_.find(key);
+            if (it != columns_.end())
+            {
+                pending = it->second;
+            }
+            else
+            {
+                columns_.emplace(key, promise.get_future().share());
+            }
+        }
+
+        // Computed or being computed by another job; wait outside the lock
+        if (pending.valid())
+        {
+            return pending.get();
+        }
+
+        // This job owns the computation
+        try
+        {
+            auto column = std::make_shared<const std::vector<double>>(compute());
+            promise.set_value(column);
+            return column;
+        }
+        catch (...)
+        {
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    // SweepResults implementation
+    size_t SweepResults::best_for_symbol(size_t symbol) const
+    {
+        size_t best = size();
+        for (size_t i = 0; i < size(); ++i)
+        {
+            if (symbol_index[i] == symbol && (best == size() || total_return[i] > total_return[best]))
+            {
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    size_t SweepResults::best_parameters() const
+    {
+        if (parameters.empty() || size() == 0)
+        {
+            return parameters.size();
+        }
+
+        std::vector<double> sums(parameters.size(), 0.0);
+        std::vector<size_t> counts(parameters.size(), 0);
+        for (size_t i = 0; i < size(); ++i)
+        {
+            sums[parameter_index[i]] += total_return[i];
+            ++counts[parameter_index[i]];
+        }
+
+        size_t best = parameters.size();
+        double best_mean = 0.0;
+        for (size_t p = 0; p < parameters.size(); ++p)
+        {
+            if (counts[p] == 0)
+            {
+                continue;
+            }
+            double mean = sums[p] / counts[p];
+            if (best == parameters.size() || mean > best_mean)
+            {
+                best = p;
+                best_mean = mean;
+            }
+        }
+        return best;
+    }
+
+    // ParameterSweep implementation
+    ParameterSweep::ParameterSweep(std::shared_ptr<ThreadPool> thread_pool, const BacktestConfig &config)
+        : thread_pool_(std::move(thread_pool)), config_(config)
+    {
+        if (!thread_pool_)
+        {
+            throw std::invalid_argument("ParameterSweep requires a thread pool");
+        }
+
+        // Per-job equity curves are not part of the result table
+        config_.record_equity_curve = false;
+    }
+
+    SweepResults ParameterSweep::run(const std::vector<std::shared_ptr<const MarketDataSeries>> &universe,
+                                     const std::vector<ParameterSet> &parameters,
+                                     const StrategyFactory &factory)
+    {
+        SweepResults results;
+        results.parameters = parameters;
+        results.symbols.reserve(universe.size());
+
+        // One shared indicator store per symbol
+        std::vector<std::unique_ptr<IndicatorColumns>> columns;
+        columns.reserve(universe.size());
+        for (const auto &series : universe)
+        {
+            results.symbols.push_back(series ? series->symbol() : std::string());
+            columns.push_back(std::make_unique<IndicatorColumns>(series));
+        }
+
+        // Pre-size every result column so workers write without synchronization
+        const size_t num_params = parameters.size();
+        const size_t total_jobs = universe.size() * num_params;
+        results.symbol_index.resize(total_jobs);
+        results.parameter_index.resize(total_jobs);
+        results.total_return.resize(total_jobs);
+        results.max_drawdown.resize(total_jobs);
+        results.final_equity.resize(total_jobs);
+        results.orders_filled.resize(total_jobs);
+
+        if (total_jobs == 0)
+        {
+            return results;
+        }
+
+        auto start_time = std::chrono::steady_clock::now();
+
+        std::atomic<size_t> next_job{0};
+        const size_t chunk_size = chunk_size_;
+
+        auto worker = [&]()
+        {
+            BacktestEngine engine(config_);
+
+            while (true)
+            {
+                size_t begin = next_job.fetch_add(chunk_size, std::memory_order_relaxed);
+                if (begin >= total_jobs)
+                {
+                    return;
+                }
+                size_t end = std::min(begin + chunk_size, total_jobs);
+
+                // Jobs are symbol-major, so a chunk mostly stays on one symbol's columns
+                for (size_t job = begin; job < end; ++job)
+                {
+                    size_t s = job / num_params;
+                    size_t p = job % num_params;
+
+                    auto strategy = factory(parameters[p], *columns[s]);
+                    if (!strategy)
+                    {
+                        throw std::runtime_error("Strategy factory returned null for " + parameters[p].to_string());
+                    }
+
+                    auto result = engine.run(columns[s]->series(), *strategy);
+
+                    results.symbol_index[job] = static_cast<uint32_t>(s);
+                    results.parameter_index[job] = static_cast<uint32_t>(p);
+                    results.total_return[job] = result.total_return;
+                    results.max_drawdown[job] = result.max_drawdown;
+                    results.final_equity[job] = result.final_equity;
+                    results.orders_filled[job] = static_cast<uint32_t>(result.orders_filled);
+                }
+            }
+        };
+
+        // One task per worker thread, not one per job
+        size_t num_workers = std::min(thread_pool_->thread_count(), (total_jobs + chunk_size - 1) / chunk_size);
+        num_workers = std::max<size_t>(num_workers, 1);
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(num_workers);
+        for (size_t i = 0; i < num_workers; ++i)
+        {
+            futures.push_back(thread_pool_->submit(worker));
+        }
+
+        // Wait for every worker before rethrowing, since they reference local state
+        std::exception_ptr error;
+        for (auto &future : futures)
+        {
+            try
+            {
+                future.get();
+            }
+            catch (...)
+            {
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+                // Stop the remaining workers early
+                next_job.store(total_jobs, std::memory_order_relaxed);
+            }
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+
+        results.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        return results;
+    }
+
+    std::vector<ParameterSet> ParameterSweep::make_grid(
+        const std::vector<std::pair<std::string, std::vector<double>>> &axes)
+    {
+        std::vector<ParameterSet> grid;
+        if (axes.empty())
+        {
+            return grid;
+        }
+
+        size_t total = 1;
+        for (const auto &axis : axes)
+        {
+            total *= axis.second.size();
+        }
+        grid.reserve(total);
+
+        // Enumerate the product with the last axis varying fastest
+        for (size_t n = 0; n < total; ++n)
+        {
+            ParameterSet set;
+            set.values.reserve(axes.size());
+
+            size_t remainder = n;
+            for (size_t a = axes.size(); a-- > 0;)
+            {
+                const auto &values = axes[a].second;
+                set.values.emplace_back(axes[a].first, values[remainder % values.size()]);
+                remainder /= values.size();
+            }
+            std::reverse(set.values.begin(), set.values.end());
+            grid.push_back(std::move(set));
+        }
+
+        return grid;
+    }
+
+} // namespace trading
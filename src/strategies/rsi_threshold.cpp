@@ -0,0 +1,63 @@
+#include "strategies/rsi_threshold.h"
+#include <stdexcept>
+#include <cmath>
+
+namespace trading
+{
+    RsiThresholdStrategy::RsiThresholdStrategy(std::shared_ptr<const std::vector<double>> rsi,
+                                               double oversold, double overbought, int64_t quantity)
+        : rsi_(std::move(rsi)), oversold_(oversold), overbought_(overbought), quantity_(quantity)
+    {
+        if (!rsi_)
+        {
+            throw std::invalid_argument("RSI column must not be null");
+        }
+        if (oversold >= overbought)
+        {
+            throw std::invalid_argument("Oversold threshold must be below overbought threshold");
+        }
+        if (quantity <= 0)
+        {
+            throw std::invalid_argument("Quantity must be greater than 0");
+        }
+    }
+
+    void RsiThresholdStrategy::on_start(const MarketDataSeries &series, StrategyContext &context)
+    {
+        (void)context;
+
+        if (rsi_->size() < series.size())
+        {
+            throw std::invalid_argument("RSI column is shorter than the series");
+        }
+    }
+
+    void RsiThresholdStrategy::on_bar(const MarketDataPoint &bar, StrategyContext &context)
+    {
+        (void)bar;
+
+        double rsi = (*rsi_)[context.bar_index()];
+        if (std::isnan(rsi) || context.working_orders() > 0)
+        {
+            return;
+        }
+
+        int64_t position = context.position();
+
+        if (rsi < oversold_ && position < quantity_)
+        {
+            context.submit_order(OrderSide::BUY, quantity_ - position);
+        }
+        else if (rsi > overbought_ && position > 0)
+        {
+            context.submit_order(OrderSide::SELL, position);
+        }
+    }
+
+    std::string RsiThresholdStrategy::name() const
+    {
+        return "RSI_Threshold_" + std::to_string(static_cast<int>(oversold_)) + "_" +
+               std::to_string(static_cast<int>(overbought_));
+    }
+
+} // namespace trading
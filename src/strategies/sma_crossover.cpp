@@ -0,0 +1,119 @@
+#include "strategies/sma_crossover.h"
+#include <stdexcept>
+#include <cmath>
+
+namespace trading
+{
+    SmaCrossoverStrategy::SmaCrossoverStrategy(int fast_period, int slow_period, int64_t quantity)
+        : fast_period_(fast_period), slow_period_(slow_period), quantity_(quantity)
+    {
+        if (fast_period <= 0 || slow_period <= fast_period)
+        {
+            throw std::invalid_argument("SMA crossover requires 0 < fast_period < slow_period");
+        }
+        if (quantity <= 0)
+        {
+            throw std::invalid_argument("Quantity must be greater than 0");
+        }
+    }
+
+    SmaCrossoverStrategy::SmaCrossoverStrategy(std::shared_ptr<const std::vector<double>> fast_sma,
+                                               std::shared_ptr<const std::vector<double>> slow_sma,
+                                               int64_t quantity)
+        : fast_period_(0), slow_period_(0), quantity_(quantity),
+          fast_column_(std::move(fast_sma)), slow_column_(std::move(slow_sma))
+    {
+        if (!fast_column_ || !slow_column_)
+        {
+            throw std::invalid_argument("Precomputed SMA columns must not be null");
+        }
+        if (quantity <= 0)
+        {
+            throw std::invalid_argument("Quantity must be greater than 0");
+        }
+    }
+
+    void SmaCrossoverStrategy::on_start(const MarketDataSeries &series, StrategyContext &context)
+    {
+        (void)context;
+
+        if (fast_column_)
+        {
+            if (fast_column_->size() < series.size() || slow_column_->size() < series.size())
+            {
+                throw std::invalid_argument("Precomputed SMA columns are shorter than the series");
+            }
+            return;
+        }
+
+        window_.assign(static_cast<size_t>(slow_period_), 0.0);
+        count_ = 0;
+        fast_sum_ = 0.0;
+        slow_sum_ = 0.0;
+    }
+
+    void SmaCrossoverStrategy::on_bar(const MarketDataPoint &bar, StrategyContext &context)
+    {
+        if (fast_column_)
+        {
+            size_t index = context.bar_index();
+            trade((*fast_column_)[index], (*slow_column_)[index], context);
+            return;
+        }
+
+        const size_t slow = static_cast<size_t>(slow_period_);
+        const size_t fast = static_cast<size_t>(fast_period_);
+
+        // Update running sums: the slow window drops the value slow bars back,
+        // the fast window drops the value fast bars back
+        if (count_ >= slow)
+        {
+            slow_sum_ -= window_[count_ % slow];
+        }
+        if (count_ >= fast)
+        {
+            fast_sum_ -= window_[(count_ - fast) % slow];
+        }
+        window_[count_ % slow] = bar.close;
+        slow_sum_ += bar.close;
+        fast_sum_ += bar.close;
+        ++count_;
+
+        if (count_ < slow)
+        {
+            return;
+        }
+
+        trade(fast_sum_ / fast_period_, slow_sum_ / slow_period_, context);
+    }
+
+    void SmaCrossoverStrategy::trade(double fast_sma, double slow_sma, StrategyContext &context)
+    {
+        // Wait for warm-up and for the previous order to resolve
+        if (std::isnan(fast_sma) || std::isnan(slow_sma) || context.working_orders() > 0)
+        {
+            return;
+        }
+
+        int64_t position = context.position();
+
+        if (fast_sma > slow_sma && position < quantity_)
+        {
+            context.submit_order(OrderSide::BUY, quantity_ - position);
+        }
+        else if (fast_sma < slow_sma && position > 0)
+        {
+            context.submit_order(OrderSide::SELL, position);
+        }
+    }
+
+    std::string SmaCrossoverStrategy::name() const
+    {
+        if (fast_column_)
+        {
+            return "SMA_Crossover_Precomputed";
+        }
+        return "SMA_Crossover_" + std::to_string(fast_period_) + "_" + std::to_string(slow_period_);
+    }
+
+} // namespace trading
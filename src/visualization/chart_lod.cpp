@@ -0,0 +1,315 @@
+#include "visualization/chart_lod.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace trading
+{
+    namespace visualization
+    {
+
+        namespace
+        {
+            // Bucket b of n items split into `buckets` covers [start(b), start(b + 1))
+            size_t bucket_start(size_t b, size_t n, size_t buckets)
+            {
+                return b * n / buckets;
+            }
+
+            void merge_into(CandlestickPoint &into, const CandlestickPoint &point)
+            {
+                into.high = std::max(into.high, point.high);
+                into.low = std::min(into.low, point.low);
+                into.close = point.close;
+                into.volume += point.volume;
+            }
+
+            // Coarsest level with at least max_points buckets in [begin, end)
+            size_t pick_level(size_t level_count, size_t factor, size_t span, size_t max_points, size_t &scale)
+            {
+                size_t k = 0;
+                scale = 1;
+                while (k + 1 < level_count && span / (scale * factor) >= max_points)
+                {
+                    ++k;
+                    scale *= factor;
+                }
+                return k;
+            }
+        }
+
+        size_t lod_budget(const ChartConfig &config, int pixels_per_sample)
+        {
+            if (config.max_points > 0)
+            {
+                return config.max_points;
+            }
+            // Plot area inside the renderers' 50 px margins
+            int plot_width = std::max(1, config.width - 100);
+            return static_cast<size_t>(std::max(2, plot_width / std::max(1, pixels_per_sample)));
+        }
+
+        std::vector<CandlestickPoint> bucket_candles(const CandlestickPoint *data, size_t count, size_t max_points)
+        {
+            if (count <= max_points || max_points == 0)
+            {
+                return std::vector<CandlestickPoint>(data, data + (max_points == 0 ? 0 : count));
+            }
+
+            std::vector<CandlestickPoint> out;
+            out.reserve(max_points);
+            for (size_t b = 0; b < max_points; ++b)
+            {
+                size_t first = bucket_start(b, count, max_points);
+                size_t last = bucket_start(b + 1, count, max_points);
+                CandlestickPoint merged = data[first];
+                for (size_t i = first + 1; i < last; ++i)
+                {
+                    merge_into(merged, data[i]);
+                }
+                merged.is_green = merged.close > merged.open;
+                out.push_back(merged);
+            }
+            return out;
+        }
+
+        std::vector<CandlestickPoint> bucket_candles(const std::vector<CandlestickPoint> &data, size_t max_points)
+        {
+            return bucket_candles(data.data(), data.size(), max_points);
+        }
+
+        std::vector<ChartPoint> lttb_decimate(const ChartPoint *points, size_t count, size_t max_points)
+        {
+            if (count <= max_points)
+            {
+                return std::vector<ChartPoint>(points, points + count);
+            }
+            std::vector<ChartPoint> out;
+            if (max_points == 0)
+            {
+                return out;
+            }
+            out.reserve(max_points);
+            out.push_back(points[0]);
+            if (max_points == 1)
+            {
+                return out;
+            }
+
+            // The first and last points are kept; the rest is split into
+            // max_points - 2 buckets that each contribute one point
+            const size_t inner = count - 2;
+            const size_t buckets = max_points - 2;
+            size_t previous = 0;
+            for (size_t b = 0; b < buckets; ++b)
+            {
+                size_t first = 1 + bucket_start(b, inner, buckets);
+                size_t last = 1 + bucket_start(b + 1, inner, buckets);
+
+                // Average of the next bucket (the last point after the final bucket)
+                size_t next_first = last;
+                size_t next_last = b + 1 < buckets ? 1 + bucket_start(b + 2, inner, buckets) : count;
+                double avg_x = 0.0;
+                double avg_y = 0.0;
+                for (size_t i = next_first; i < next_last; ++i)
+                {
+                    avg_x += points[i].x;
+                    avg_y += points[i].y;
+                }
+                double next_count = static_cast<double>(next_last - next_first);
+                avg_x /= next_count;
+                avg_y /= next_count;
+
+                const ChartPoint &a = points[previous];
+                size_t chosen = first;
+                double best_area = -1.0;
+                for (size_t i = first; i < last; ++i)
+                {
+                    // Twice the triangle area; the factor does not change the argmax
+                    double area = std::abs((a.x - avg_x) * (points[i].y - a.y) - (a.x - points[i].x) * (avg_y - a.y));
+                    if (area > best_area)
+                    {
+                        best_area = area;
+                        chosen = i;
+                    }
+                }
+                out.push_back(points[chosen]);
+                previous = chosen;
+            }
+
+            out.push_back(points[count - 1]);
+            return out;
+        }
+
+        std::vector<ChartPoint> lttb_decimate(const std::vector<ChartPoint> &points, size_t max_points)
+        {
+            return lttb_decimate(points.data(), points.size(), max_points);
+        }
+
+        std::vector<ChartPoint> min_max_decimate(const ChartPoint *points, size_t count, size_t max_points)
+        {
+            if (count <= max_points)
+            {
+                return std::vector<ChartPoint>(points, points + count);
+            }
+            if (max_points < 4)
+            {
+                // No room for a min/max pair between the endpoints
+                return lttb_decimate(points, count, max_points);
+            }
+
+            std::vector<ChartPoint> out;
+            out.reserve(max_points);
+            out.push_back(points[0]);
+
+            const size_t inner = count - 2;
+            const size_t buckets = (max_points - 2) / 2;
+            for (size_t b = 0; b < buckets; ++b)
+            {
+                size_t first = 1 + bucket_start(b, inner, buckets);
+                size_t last = 1 + bucket_start(b + 1, inner, buckets);
+                size_t lo = first;
+                size_t hi = first;
+                for (size_t i = first + 1; i < last; ++i)
+                {
+                    if (points[i].y < points[lo].y)
+                        lo = i;
+                    if (points[i].y > points[hi].y)
+                        hi = i;
+                }
+                out.push_back(points[std::min(lo, hi)]);
+                if (lo != hi)
+                {
+                    out.push_back(points[std::max(lo, hi)]);
+                }
+            }
+
+            out.push_back(points[count - 1]);
+            return out;
+        }
+
+        std::vector<ChartPoint> min_max_decimate(const std::vector<ChartPoint> &points, size_t max_points)
+        {
+            return min_max_decimate(points.data(), points.size(), max_points);
+        }
+
+        std::vector<ChartPoint> decimate(const std::vector<ChartPoint> &points, size_t max_points, Decimation method)
+        {
+            return method == Decimation::MIN_MAX ? min_max_decimate(points, max_points)
+                                                 : lttb_decimate(points, max_points);
+        }
+
+        // CandlestickPyramid implementation
+        CandlestickPyramid::CandlestickPyramid(size_t factor)
+            : factor_(factor)
+        {
+            if (factor < 2)
+            {
+                throw std::invalid_argument("Pyramid factor must be at least 2");
+            }
+        }
+
+        void CandlestickPyramid::build(const std::vector<CandlestickPoint> &data)
+        {
+            levels_.clear();
+            levels_.push_back(data);
+            while (levels_.back().size() > 1)
+            {
+                const auto &below = levels_.back();
+                std::vector<CandlestickPoint> level;
+                level.reserve((below.size() + factor_ - 1) / factor_);
+                for (size_t i = 0; i < below.size(); i += factor_)
+                {
+                    CandlestickPoint merged = below[i];
+                    size_t last = std::min(i + factor_, below.size());
+                    for (size_t j = i + 1; j < last; ++j)
+                    {
+                        merge_into(merged, below[j]);
+                    }
+                    merged.is_green = merged.close > merged.open;
+                    level.push_back(merged);
+                }
+                levels_.push_back(std::move(level));
+            }
+        }
+
+        std::vector<CandlestickPoint> CandlestickPyramid::view(size_t begin, size_t end, size_t max_points) const
+        {
+            end = std::min(end, size());
+            if (begin >= end)
+            {
+                return {};
+            }
+
+            size_t scale = 1;
+            size_t k = pick_level(levels_.size(), factor_, end - begin, max_points, scale);
+            const auto &level = levels_[k];
+            size_t first = begin / scale;
+            size_t last = std::min(level.size(), (end + scale - 1) / scale);
+            return bucket_candles(level.data() + first, last - first, max_points);
+        }
+
+        // LinePyramid implementation
+        LinePyramid::LinePyramid(size_t factor)
+            : factor_(factor)
+        {
+            if (factor < 2)
+            {
+                throw std::invalid_argument("Pyramid factor must be at least 2");
+            }
+        }
+
+        void LinePyramid::build(const std::vector<ChartPoint> &points)
+        {
+            levels_.clear();
+            levels_.push_back(points);
+
+            // Level 0 has one point per bucket, every later level two
+            size_t per_bucket = 1;
+            while (levels_.back().size() / per_bucket > 1)
+            {
+                const auto &below = levels_.back();
+                const size_t group = factor_ * per_bucket;
+                std::vector<ChartPoint> level;
+                level.reserve(2 * ((below.size() + group - 1) / group));
+                for (size_t i = 0; i < below.size(); i += group)
+                {
+                    size_t last = std::min(i + group, below.size());
+                    size_t lo = i;
+                    size_t hi = i;
+                    for (size_t j = i + 1; j < last; ++j)
+                    {
+                        if (below[j].y < below[lo].y)
+                            lo = j;
+                        if (below[j].y > below[hi].y)
+                            hi = j;
+                    }
+                    level.push_back(below[std::min(lo, hi)]);
+                    level.push_back(below[std::max(lo, hi)]);
+                }
+                levels_.push_back(std::move(level));
+                per_bucket = 2;
+            }
+        }
+
+        std::vector<ChartPoint> LinePyramid::view(size_t begin, size_t end, size_t max_points, Decimation method) const
+        {
+            end = std::min(end, size());
+            if (begin >= end)
+            {
+                return {};
+            }
+
+            size_t scale = 1;
+            size_t k = pick_level(levels_.size(), factor_, end - begin, max_points, scale);
+            const auto &level = levels_[k];
+            size_t per_bucket = k == 0 ? 1 : 2;
+            size_t first = (begin / scale) * per_bucket;
+            size_t last = std::min(level.size(), ((end + scale - 1) / scale) * per_bucket);
+
+            return method == Decimation::MIN_MAX ? min_max_decimate(level.data() + first, last - first, max_points)
+                                                 : lttb_decimate(level.data() + first, last - first, max_points);
+        }
+
+    } // namespace visualization
+} // namespace trading
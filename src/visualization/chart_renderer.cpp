@@ -1,4 +1,5 @@
 #include "visualization/chart_renderer.h"
+#include "visualization/chart_lod.h"
 #include "visualization/data_export.h"
 #include <iostream>
 #include <fstream>
@@ -13,6 +14,22 @@ namespace trading
     namespace visualization
     {
 
+        namespace
+        {
+            // Lines are decimated in index space: x becomes the source index,
+            // which is how overlays are laid out
+            std::vector<ChartPoint> indexed(const std::vector<ChartPoint> &points)
+            {
+                std::vector<ChartPoint> out;
+                out.reserve(points.size());
+                for (size_t i = 0; i < points.size(); ++i)
+                {
+                    out.emplace_back(static_cast<double>(i), points[i].y);
+                }
+                return out;
+            }
+        }
+
         // ChartFactory implementation
         std::unique_ptr<ChartRenderer> ChartFactory::create_renderer(RendererType type)
         {
@@ -46,7 +63,11 @@ namespace trading
             if (config.height > 0)
                 current_config_.height = config.height;
 
-            std::string svg_content = generate_svg_candlestick(data);
+            // Candles need a couple of pixels each to stay readable
+            size_t budget = lod_budget(current_config_, 2);
+            std::string svg_content = current_config_.level_of_detail && data.size() > budget
+                                          ? generate_svg_candlestick(bucket_candles(data, budget))
+                                          : generate_svg_candlestick(data);
 
             if (!indicators.empty())
             {
@@ -67,8 +88,26 @@ namespace trading
             if (config.height > 0)
                 current_config_.height = config.height;
 
+            // The JSON view keeps the full series; only the SVG is reduced
             current_series_ = series;
-            std::string svg_content = generate_svg_line(series);
+            std::string svg_content;
+            if (current_config_.level_of_detail)
+            {
+                size_t budget = lod_budget(current_config_, 1);
+                std::vector<ChartSeries> reduced;
+                reduced.reserve(series.size());
+                for (const auto &s : series)
+                {
+                    reduced.emplace_back(s.name, s.type, s.color);
+                    reduced.back().visible = s.visible;
+                    reduced.back().points = decimate(s.points, budget, current_config_.decimation);
+                }
+                svg_content = generate_svg_line(reduced);
+            }
+            else
+            {
+                svg_content = generate_svg_line(series);
+            }
             current_chart_data_ = generate_html_wrapper(svg_content);
             return true;
         }
@@ -445,12 +484,20 @@ namespace trading
 
                 std::string color = indicator.color.empty() ? "#ffff00" : indicator.color;
 
+                // Points are laid out by index, so decimate in index space
+                std::vector<ChartPoint> points = indexed(indicator.points);
+                if (current_config_.level_of_detail)
+                {
+                    points = decimate(points, lod_budget(current_config_, 1), current_config_.decimation);
+                }
+                const double last_index = static_cast<double>(indicator.points.size() - 1);
+
                 // Create path
                 std::ostringstream path;
-                for (size_t i = 0; i < indicator.points.size(); ++i)
+                for (size_t i = 0; i < points.size(); ++i)
                 {
-                    const auto &point = indicator.points[i];
-                    const double x = margin + (static_cast<double>(i) / (indicator.points.size() - 1)) * chart_width;
+                    const auto &point = points[i];
+                    const double x = margin + (point.x / last_index) * chart_width;
                     const double y = margin + (max_y + y_padding - point.y) / (y_range + 2 * y_padding) * chart_height;
 
                     if (i == 0)
@@ -710,14 +757,18 @@ namespace trading
         }
 
         // Helper methods for ConsoleChartRenderer
-        void ConsoleChartRenderer::render_candlestick_console(const std::vector<CandlestickPoint> &data)
+        void ConsoleChartRenderer::render_candlestick_console(const std::vector<CandlestickPoint> &raw)
         {
-            if (data.empty())
+            if (raw.empty())
             {
                 std::cout << "No data to display\n";
                 return;
             }
 
+            // One row per candle: merge bars down to the rows available
+            // (without LOD only the first rows are shown)
+            const std::vector<CandlestickPoint> data = current_config_.level_of_detail ? bucket_candles(raw, 50) : raw;
+
             // Find price range
             double min_price = data[0].low;
             double max_price = data[0].high;
@@ -757,10 +808,13 @@ namespace trading
 
                 std::cout << "Series: " << s.name << "\n";
 
+                // One column per point; min/max keeps spikes visible
+                const std::vector<ChartPoint> points = current_config_.level_of_detail ? min_max_decimate(s.points, 60) : s.points;
+
                 // Find range
-                double min_val = s.points[0].y;
-                double max_val = s.points[0].y;
-                for (const auto &point : s.points)
+                double min_val = points[0].y;
+                double max_val = points[0].y;
+                for (const auto &point : points)
                 {
                     min_val = std::min(min_val, point.y);
                     max_val = std::max(max_val, point.y);
@@ -774,9 +828,9 @@ namespace trading
                 {
                     std::cout << std::setw(3) << (min_val + (row * range / chart_height)) << " |";
 
-                    for (size_t i = 0; i < s.points.size() && i < 60; ++i)
+                    for (size_t i = 0; i < points.size() && i < 60; ++i)
                     { // Limit width
-                        const auto &point = s.points[i];
+                        const auto &point = points[i];
                         const int y_pos = static_cast<int>((point.y - min_val) / range * chart_height);
 
                         if (y_pos == row)
@@ -798,11 +852,13 @@ namespace trading
             }
         }
 
-        void ConsoleChartRenderer::render_volume_console(const std::vector<CandlestickPoint> &data)
+        void ConsoleChartRenderer::render_volume_console(const std::vector<CandlestickPoint> &raw)
         {
-            if (data.empty())
+            if (raw.empty())
                 return;
 
+            const std::vector<CandlestickPoint> data = current_config_.level_of_detail ? bucket_candles(raw, 30) : raw;
+
             std::cout << "Volume Profile:\n";
 
             // Find max volume
@@ -838,10 +894,12 @@ namespace trading
 
                 std::cout << "Indicator: " << indicator.name << "\n";
 
+                const std::vector<ChartPoint> points = current_config_.level_of_detail ? min_max_decimate(indicator.points, 40) : indicator.points;
+
                 // Find range
-                double min_val = indicator.points[0].y;
-                double max_val = indicator.points[0].y;
-                for (const auto &point : indicator.points)
+                double min_val = points[0].y;
+                double max_val = points[0].y;
+                for (const auto &point : points)
                 {
                     min_val = std::min(min_val, point.y);
                     max_val = std::max(max_val, point.y);
@@ -855,9 +913,9 @@ namespace trading
                 {
                     std::cout << std::setw(6) << (min_val + (row * range / chart_height)) << " |";
 
-                    for (size_t i = 0; i < indicator.points.size() && i < 40; ++i)
+                    for (size_t i = 0; i < points.size() && i < 40; ++i)
                     {
-                        const auto &point = indicator.points[i];
+                        const auto &point = points[i];
                         const int y_pos = static_cast<int>((point.y - min_val) / range * chart_height);
 
                         if (y_pos == row)
@@ -0,0 +1,1315 @@
+#include "visualization/columnar_export.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace trading
+{
+    namespace visualization
+    {
+        namespace
+        {
+            // Parquet Thrift enums (parquet.thrift)
+            constexpr int32_t kParquetInt64 = 2;
+            constexpr int32_t kParquetDouble = 5;
+            constexpr int32_t kParquetByteArray = 6;
+            constexpr int32_t kEncodingPlain = 0;
+            constexpr int32_t kEncodingRle = 3;
+            constexpr int32_t kEncodingDeltaBinaryPacked = 5;
+            constexpr int32_t kEncodingRleDictionary = 8;
+            constexpr int32_t kCodecUncompressed = 0;
+            constexpr int32_t kCodecGzip = 2;
+            constexpr int kPageData = 0;
+            constexpr int kPageDictionary = 2;
+            constexpr int32_t kRepetitionRequired = 0;
+            constexpr int32_t kConvertedUtf8 = 0;
+            constexpr int32_t kConvertedTimestampMicros = 10;
+
+            // Arrow flatbuffer enums (Schema.fbs / Message.fbs)
+            constexpr uint8_t kArrowInt = 2;
+            constexpr uint8_t kArrowFloatingPoint = 3;
+            constexpr uint8_t kArrowUtf8 = 5;
+            constexpr uint8_t kArrowTimestamp = 10;
+            constexpr uint8_t kMessageSchema = 1;
+            constexpr uint8_t kMessageRecordBatch = 3;
+            constexpr int16_t kMetadataV5 = 4;
+            constexpr int16_t kPrecisionDouble = 2;
+            constexpr int16_t kTimeUnitMicrosecond = 2;
+
+            const char kParquetMagic[] = "PAR1";
+            const char kArrowMagic[] = "ARROW1";
+            const uint32_t kContinuation = 0xFFFFFFFFu;
+
+            void append(std::vector<uint8_t> &out, const void *data, size_t size)
+            {
+                const auto *bytes = static_cast<const uint8_t *>(data);
+                out.insert(out.end(), bytes, bytes + size);
+            }
+
+            template <typename T>
+            void append_le(std::vector<uint8_t> &out, T value)
+            {
+                // Both formats are little-endian, as is every supported host
+                append(out, &value, sizeof(T));
+            }
+
+            void append_varint(std::vector<uint8_t> &out, uint64_t value)
+            {
+                while (value >= 0x80)
+                {
+                    out.push_back(static_cast<uint8_t>(value | 0x80));
+                    value >>= 7;
+                }
+                out.push_back(static_cast<uint8_t>(value));
+            }
+
+            uint64_t zigzag(int64_t value)
+            {
+                return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+            }
+
+            int bit_width(uint64_t value)
+            {
+                int width = 0;
+                while (value != 0)
+                {
+                    ++width;
+                    value >>= 1;
+                }
+                return width;
+            }
+
+            // Packs values of a fixed bit width, least significant bit first
+            class BitPacker
+            {
+            public:
+                explicit BitPacker(std::vector<uint8_t> &out) : out_(out) {}
+
+                void put(uint64_t value, int width)
+                {
+                    while (width > 0)
+                    {
+                        if (bit_ == 0)
+                        {
+                            out_.push_back(0);
+                        }
+                        int take = std::min(width, 8 - bit_);
+                        out_.back() |= static_cast<uint8_t>((value & ((1u << take) - 1)) << bit_);
+                        value >>= take;
+                        width -= take;
+                        bit_ = (bit_ + take) % 8;
+                    }
+                }
+
+            private:
+                std::vector<uint8_t> &out_;
+                int bit_ = 0;
+            };
+
+            // DELTA_BINARY_PACKED: blocks of 128 deltas in 4 miniblocks of 32
+            void encode_delta(std::vector<uint8_t> &out, const int64_t *values, size_t count)
+            {
+                constexpr size_t kBlock = 128;
+                constexpr size_t kMiniblocks = 4;
+                constexpr size_t kMiniblock = kBlock / kMiniblocks;
+
+                append_varint(out, kBlock);
+                append_varint(out, kMiniblocks);
+                append_varint(out, count);
+                append_varint(out, zigzag(count > 0 ? values[0] : 0));
+
+                uint64_t deltas[kBlock];
+                for (size_t start = 1; start < count; start += kBlock)
+                {
+                    size_t n = std::min(kBlock, count - start);
+                    int64_t min_delta = std::numeric_limits<int64_t>::max();
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        // Wrapping subtraction: the reader adds back modulo 2^64
+                        int64_t delta = static_cast<int64_t>(static_cast<uint64_t>(values[start + i]) -
+                                                             static_cast<uint64_t>(values[start + i - 1]));
+                        deltas[i] = static_cast<uint64_t>(delta);
+                        min_delta = std::min(min_delta, delta);
+                    }
+                    append_varint(out, zigzag(min_delta));
+
+                    int widths[kMiniblocks] = {0, 0, 0, 0};
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        deltas[i] -= static_cast<uint64_t>(min_delta);
+                        widths[i / kMiniblock] = std::max(widths[i / kMiniblock], bit_width(deltas[i]));
+                    }
+                    for (int width : widths)
+                    {
+                        out.push_back(static_cast<uint8_t>(width));
+                    }
+
+                    // Miniblocks past the last value are omitted; a partial one is padded to 32 values
+                    BitPacker packer(out);
+                    for (size_t m = 0; m * kMiniblock < n; ++m)
+                    {
+                        for (size_t i = m * kMiniblock; i < (m + 1) * kMiniblock; ++i)
+                        {
+                            packer.put(i < n ? deltas[i] : 0, widths[m]);
+                        }
+                    }
+                }
+            }
+
+            // RLE / bit-packed hybrid of dictionary indices, prefixed by the bit width
+            void encode_dictionary_indices(std::vector<uint8_t> &out, const std::vector<uint32_t> &indices, size_t dictionary_size)
+            {
+                const int width = std::max(1, bit_width(dictionary_size - 1));
+                const size_t value_bytes = (static_cast<size_t>(width) + 7) / 8;
+                out.push_back(static_cast<uint8_t>(width));
+
+                std::vector<uint32_t> literal;
+                auto flush_literal = [&]
+                {
+                    if (literal.empty())
+                        return;
+                    size_t groups = (literal.size() + 7) / 8;
+                    literal.resize(groups * 8, 0);
+                    append_varint(out, (groups << 1) | 1);
+                    BitPacker packer(out);
+                    for (uint32_t value : literal)
+                    {
+                        packer.put(value, width);
+                    }
+                    literal.clear();
+                };
+
+                for (size_t i = 0; i < indices.size();)
+                {
+                    size_t run_end = i + 1;
+                    while (run_end < indices.size() && indices[run_end] == indices[i])
+                    {
+                        ++run_end;
+                    }
+                    size_t run = run_end - i;
+                    if (run < 8)
+                    {
+                        literal.insert(literal.end(), indices.begin() + static_cast<std::ptrdiff_t>(i),
+                                       indices.begin() + static_cast<std::ptrdiff_t>(run_end));
+                        i = run_end;
+                        continue;
+                    }
+
+                    // Complete the pending bit-packed group from the run, then repeat the rest
+                    size_t top_up = (8 - literal.size() % 8) % 8;
+                    literal.insert(literal.end(), top_up, indices[i]);
+                    flush_literal();
+                    append_varint(out, static_cast<uint64_t>(run - top_up) << 1);
+                    uint32_t value = indices[i];
+                    append(out, &value, value_bytes);
+                    i = run_end;
+                }
+                flush_literal();
+            }
+
+#ifdef HAVE_ZLIB
+            void gzip(const std::vector<uint8_t> &in, std::vector<uint8_t> &out)
+            {
+                z_stream stream{};
+                // windowBits 15 + 16 selects the gzip wrapper Parquet's GZIP codec expects
+                if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                {
+                    throw std::runtime_error("deflateInit2 failed");
+                }
+                out.resize(deflateBound(&stream, static_cast<uLong>(in.size())) + 32);
+                stream.next_in = const_cast<Bytef *>(in.data());
+                stream.avail_in = static_cast<uInt>(in.size());
+                stream.next_out = out.data();
+                stream.avail_out = static_cast<uInt>(out.size());
+                int result = deflate(&stream, Z_FINISH);
+                out.resize(stream.total_out);
+                deflateEnd(&stream);
+                if (result != Z_STREAM_END)
+                {
+                    throw std::runtime_error("gzip compression failed");
+                }
+            }
+#endif
+
+            // Thrift compact protocol writer, enough for the Parquet metadata structs
+            class CompactWriter
+            {
+            public:
+                static constexpr uint8_t kBoolTrue = 1;
+                static constexpr uint8_t kBoolFalse = 2;
+                static constexpr uint8_t kI32 = 5;
+                static constexpr uint8_t kI64 = 6;
+                static constexpr uint8_t kBinary = 8;
+                static constexpr uint8_t kList = 9;
+                static constexpr uint8_t kStruct = 12;
+
+                explicit CompactWriter(std::vector<uint8_t> &out) : out_(out) {}
+
+                void field_i32(int16_t id, int32_t value)
+                {
+                    header(id, kI32);
+                    append_varint(out_, zigzag(value));
+                }
+
+                void field_i64(int16_t id, int64_t value)
+                {
+                    header(id, kI64);
+                    append_varint(out_, zigzag(value));
+                }
+
+                void field_bool(int16_t id, bool value) { header(id, value ? kBoolTrue : kBoolFalse); }
+
+                void field_binary(int16_t id, const std::string &value)
+                {
+                    header(id, kBinary);
+                    list_binary(value);
+                }
+
+                void field_list(int16_t id, uint8_t element_type, size_t size)
+                {
+                    header(id, kList);
+                    if (size < 15)
+                    {
+                        out_.push_back(static_cast<uint8_t>((size << 4) | element_type));
+                    }
+                    else
+                    {
+                        out_.push_back(static_cast<uint8_t>(0xF0 | element_type));
+                        append_varint(out_, size);
+                    }
+                }
+
+                // Struct-valued field, closed by end_struct()
+                void field_struct(int16_t id)
+                {
+                    header(id, kStruct);
+                    begin_struct();
+                }
+
+                // Top-level struct or list element
+                void begin_struct()
+                {
+                    field_ids_.push_back(last_id_);
+                    last_id_ = 0;
+                }
+
+                void end_struct()
+                {
+                    out_.push_back(0);
+                    last_id_ = field_ids_.back();
+                    field_ids_.pop_back();
+                }
+
+                void list_i32(int32_t value) { append_varint(out_, zigzag(value)); }
+
+                void list_binary(const std::string &value)
+                {
+                    append_varint(out_, value.size());
+                    append(out_, value.data(), value.size());
+                }
+
+            private:
+                void header(int16_t id, uint8_t type)
+                {
+                    int delta = id - last_id_;
+                    if (delta > 0 && delta <= 15)
+                    {
+                        out_.push_back(static_cast<uint8_t>((delta << 4) | type));
+                    }
+                    else
+                    {
+                        out_.push_back(type);
+                        append_varint(out_, zigzag(id));
+                    }
+                    last_id_ = id;
+                }
+
+                std::vector<uint8_t> &out_;
+                std::vector<int16_t> field_ids_;
+                int16_t last_id_ = 0;
+            };
+
+            // Minimal flatbuffer builder. Builds back to front like the
+            // reference implementation: offsets are measured from the end of
+            // the buffer until finish() fixes the layout. Tables must be
+            // finished before a parent table starts.
+            class FlatBuilder
+            {
+            public:
+                uint32_t size() const { return static_cast<uint32_t>(buf_.size()); }
+
+                uint32_t create_string(const std::string &value)
+                {
+                    align(4, value.size() + 1);
+                    buf_.insert(buf_.begin(), 1, 0);
+                    buf_.insert(buf_.begin(), value.begin(), value.end());
+                    prepend<uint32_t>(static_cast<uint32_t>(value.size()));
+                    return size();
+                }
+
+                uint32_t create_offsets(const std::vector<uint32_t> &targets)
+                {
+                    align(4, targets.size() * 4);
+                    for (auto it = targets.rbegin(); it != targets.rend(); ++it)
+                    {
+                        prepend_offset(*it);
+                    }
+                    prepend<uint32_t>(static_cast<uint32_t>(targets.size()));
+                    return size();
+                }
+
+                // Vector of structs already laid out in `bytes`
+                uint32_t create_structs(const std::vector<uint8_t> &bytes, size_t count)
+                {
+                    align(8, bytes.size());
+                    buf_.insert(buf_.begin(), bytes.begin(), bytes.end());
+                    prepend<uint32_t>(static_cast<uint32_t>(count));
+                    return size();
+                }
+
+                void start_table()
+                {
+                    fields_.clear();
+                    table_start_ = size();
+                }
+
+                template <typename T>
+                void add_scalar(uint16_t id, T value)
+                {
+                    prepend<T>(value);
+                    fields_.emplace_back(id, size());
+                }
+
+                void add_offset(uint16_t id, uint32_t target)
+                {
+                    prepend_offset(target);
+                    fields_.emplace_back(id, size());
+                }
+
+                uint32_t end_table()
+                {
+                    prepend<int32_t>(0); // soffset to the vtable, patched below
+                    const uint32_t table = size();
+
+                    uint16_t slot_count = 0;
+                    for (const auto &field : fields_)
+                    {
+                        slot_count = std::max<uint16_t>(slot_count, static_cast<uint16_t>(field.first + 1));
+                    }
+                    std::vector<uint16_t> slots(slot_count, 0);
+                    for (const auto &field : fields_)
+                    {
+                        slots[field.first] = static_cast<uint16_t>(table - field.second);
+                    }
+                    for (auto it = slots.rbegin(); it != slots.rend(); ++it)
+                    {
+                        prepend<uint16_t>(*it);
+                    }
+                    prepend<uint16_t>(static_cast<uint16_t>(table - table_start_));
+                    prepend<uint16_t>(static_cast<uint16_t>(4 + 2 * slot_count));
+                    const uint32_t vtable = size();
+
+                    // The vtable sits before the table, so the table subtracts a positive offset
+                    int32_t soffset = static_cast<int32_t>(vtable - table);
+                    std::memcpy(buf_.data() + (buf_.size() - table), &soffset, sizeof(soffset));
+                    return table;
+                }
+
+                // Root offset added; the result's size is a multiple of 8
+                std::vector<uint8_t> finish(uint32_t root)
+                {
+                    align(8, 4);
+                    prepend_offset(root);
+                    return std::move(buf_);
+                }
+
+            private:
+                // Pad so that `size() + upcoming` is a multiple of alignment
+                void align(size_t alignment, size_t upcoming = 0)
+                {
+                    size_t padding = (alignment - (buf_.size() + upcoming) % alignment) % alignment;
+                    buf_.insert(buf_.begin(), padding, 0);
+                }
+
+                template <typename T>
+                void prepend(T value)
+                {
+                    align(sizeof(T));
+                    uint8_t bytes[sizeof(T)];
+                    std::memcpy(bytes, &value, sizeof(T));
+                    buf_.insert(buf_.begin(), bytes, bytes + sizeof(T));
+                }
+
+                void prepend_offset(uint32_t target)
+                {
+                    align(4);
+                    prepend<uint32_t>(size() + 4 - target);
+                }
+
+                std::vector<uint8_t> buf_;
+                std::vector<std::pair<uint16_t, uint32_t>> fields_;
+                uint32_t table_start_ = 0;
+            };
+
+            uint32_t build_arrow_schema(FlatBuilder &fb, const std::vector<ColumnSpec> &schema,
+                                        const std::map<std::string, std::string> &metadata)
+            {
+                std::vector<uint32_t> fields;
+                for (const auto &column : schema)
+                {
+                    uint32_t name = fb.create_string(column.name);
+                    uint32_t children = fb.create_offsets({});
+                    uint8_t type_type = kArrowUtf8;
+                    uint32_t type = 0;
+                    switch (column.type)
+                    {
+                    case ColumnType::INT64:
+                        type_type = kArrowInt;
+                        fb.start_table();
+                        fb.add_scalar<int32_t>(0, 64);
+                        fb.add_scalar<uint8_t>(1, 1);
+                        type = fb.end_table();
+                        break;
+                    case ColumnType::DOUBLE:
+                        type_type = kArrowFloatingPoint;
+                        fb.start_table();
+                        fb.add_scalar<int16_t>(0, kPrecisionDouble);
+                        type = fb.end_table();
+                        break;
+                    case ColumnType::TIMESTAMP:
+                    {
+                        type_type = kArrowTimestamp;
+                        uint32_t timezone = fb.create_string("UTC");
+                        fb.start_table();
+                        fb.add_offset(1, timezone);
+                        fb.add_scalar<int16_t>(0, kTimeUnitMicrosecond);
+                        type = fb.end_table();
+                        break;
+                    }
+                    case ColumnType::STRING:
+                        fb.start_table();
+                        type = fb.end_table();
+                        break;
+                    }
+
+                    fb.start_table();
+                    fb.add_offset(0, name);
+                    fb.add_offset(3, type);
+                    fb.add_offset(5, children);
+                    fb.add_scalar<uint8_t>(1, 0); // Not nullable: writers never produce nulls
+                    fb.add_scalar<uint8_t>(2, type_type);
+                    fields.push_back(fb.end_table());
+                }
+                uint32_t field_vector = fb.create_offsets(fields);
+
+                std::vector<uint32_t> pairs;
+                for (const auto &entry : metadata)
+                {
+                    uint32_t key = fb.create_string(entry.first);
+                    uint32_t value = fb.create_string(entry.second);
+                    fb.start_table();
+                    fb.add_offset(0, key);
+                    fb.add_offset(1, value);
+                    pairs.push_back(fb.end_table());
+                }
+                uint32_t metadata_vector = fb.create_offsets(pairs);
+
+                fb.start_table();
+                fb.add_offset(1, field_vector);
+                fb.add_offset(2, metadata_vector);
+                return fb.end_table();
+            }
+
+            std::vector<uint8_t> build_arrow_message(FlatBuilder &fb, uint8_t header_type, uint32_t header, int64_t body_length)
+            {
+                fb.start_table();
+                fb.add_scalar<int64_t>(3, body_length);
+                fb.add_offset(2, header);
+                fb.add_scalar<int16_t>(0, kMetadataV5);
+                fb.add_scalar<uint8_t>(1, header_type);
+                return fb.finish(fb.end_table());
+            }
+
+            size_t padded(size_t size, size_t alignment = 8)
+            {
+                return (size + alignment - 1) / alignment * alignment;
+            }
+
+            int64_t to_micros(const std::chrono::system_clock::time_point &timestamp)
+            {
+                return std::chrono::duration_cast<std::chrono::microseconds>(timestamp.time_since_epoch()).count();
+            }
+
+            double value_or_nan(const std::vector<double> &values, size_t i)
+            {
+                return i < values.size() ? values[i] : std::numeric_limits<double>::quiet_NaN();
+            }
+
+            double value_or_nan(const std::vector<ChartPoint> &points, size_t i)
+            {
+                return i < points.size() ? points[i].y : std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+
+        // ColumnBatch implementation
+        ColumnBatch::ColumnBatch(const std::vector<ColumnSpec> &schema)
+        {
+            columns_.reserve(schema.size());
+            for (const auto &column : schema)
+            {
+                columns_.push_back(Column{column.type, {}, {}, {}});
+            }
+        }
+
+        size_t ColumnBatch::rows() const
+        {
+            size_t rows = 0;
+            for (size_t c = 0; c < columns_.size(); ++c)
+            {
+                const auto &column = columns_[c];
+                size_t length = column.type == ColumnType::DOUBLE   ? column.doubles.size()
+                                : column.type == ColumnType::STRING ? column.strings.size()
+                                                                    : column.ints.size();
+                if (c > 0 && length != rows)
+                {
+                    throw std::invalid_argument("Columns in a batch differ in length");
+                }
+                rows = length;
+            }
+            return rows;
+        }
+
+        void ColumnBatch::reserve(size_t rows)
+        {
+            for (auto &column : columns_)
+            {
+                switch (column.type)
+                {
+                case ColumnType::DOUBLE:
+                    column.doubles.reserve(rows);
+                    break;
+                case ColumnType::STRING:
+                    column.strings.reserve(rows);
+                    break;
+                default:
+                    column.ints.reserve(rows);
+                    break;
+                }
+            }
+        }
+
+        void ColumnBatch::clear()
+        {
+            for (auto &column : columns_)
+            {
+                column.ints.clear();
+                column.doubles.clear();
+                column.strings.clear();
+            }
+        }
+
+        // ColumnarWriter implementation
+        ColumnarWriter::ColumnarWriter(const std::string &path, std::vector<ColumnSpec> schema, ColumnarOptions options)
+            : schema_(std::move(schema)), options_(std::move(options)), path_(path), temp_path_(path + ".tmp")
+        {
+            if (schema_.empty())
+            {
+                throw std::invalid_argument("Columnar schema has no columns");
+            }
+            file_.open(temp_path_, std::ios::binary | std::ios::trunc);
+            if (!file_.is_open())
+            {
+                throw std::runtime_error("Cannot create " + temp_path_);
+            }
+        }
+
+        ColumnarWriter::~ColumnarWriter()
+        {
+            if (!closed_)
+            {
+                file_.close();
+                std::remove(temp_path_.c_str());
+            }
+        }
+
+        void ColumnarWriter::write(const ColumnBatch &batch)
+        {
+            if (closed_)
+            {
+                throw std::runtime_error("Columnar writer is closed");
+            }
+            if (batch.column_count() != schema_.size())
+            {
+                throw std::invalid_argument("Batch does not match the writer schema");
+            }
+            for (size_t c = 0; c < schema_.size(); ++c)
+            {
+                if (batch.type(c) != schema_[c].type)
+                {
+                    throw std::invalid_argument("Batch column " + schema_[c].name + " has the wrong type");
+                }
+            }
+
+            size_t rows = batch.rows();
+            if (rows == 0)
+            {
+                return;
+            }
+            write_batch(batch, rows);
+            rows_written_ += rows;
+        }
+
+        void ColumnarWriter::close()
+        {
+            if (closed_)
+            {
+                return;
+            }
+            write_footer();
+            file_.close();
+            if (file_.fail())
+            {
+                throw std::runtime_error("Failed to write " + temp_path_);
+            }
+            if (std::rename(temp_path_.c_str(), path_.c_str()) != 0)
+            {
+                throw std::runtime_error("Cannot rename " + temp_path_ + " to " + path_);
+            }
+            closed_ = true;
+        }
+
+        void ColumnarWriter::write_bytes(const void *data, size_t size)
+        {
+            file_.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+            if (!file_)
+            {
+                throw std::runtime_error("Failed to write " + temp_path_);
+            }
+            offset_ += size;
+        }
+
+        void ColumnarWriter::write_padding(size_t alignment)
+        {
+            static const uint8_t zeros[64] = {};
+            size_t padding = padded(offset_, alignment) - offset_;
+            write_bytes(zeros, padding);
+        }
+
+        // ParquetWriter implementation
+        ParquetWriter::ParquetWriter(const std::string &path, std::vector<ColumnSpec> schema, ColumnarOptions options)
+            : ColumnarWriter(path, std::move(schema), std::move(options))
+        {
+#ifndef HAVE_ZLIB
+            if (options_.compression == ExportCompression::GZIP)
+            {
+                throw std::runtime_error("GZIP compression requires zlib");
+            }
+#endif
+            write_bytes(kParquetMagic, 4);
+        }
+
+        void ParquetWriter::write_batch(const ColumnBatch &batch, size_t rows)
+        {
+            RowGroupInfo group;
+            group.num_rows = static_cast<int64_t>(rows);
+            for (size_t c = 0; c < schema_.size(); ++c)
+            {
+                group.columns.push_back(write_chunk(batch, c, rows));
+                group.total_byte_size += group.columns.back().total_uncompressed;
+            }
+            row_groups_.push_back(std::move(group));
+        }
+
+        ParquetWriter::ChunkInfo ParquetWriter::write_chunk(const ColumnBatch &batch, size_t column, size_t rows)
+        {
+            ChunkInfo chunk;
+            chunk.num_values = static_cast<int64_t>(rows);
+            std::vector<uint8_t> payload;
+
+            switch (schema_[column].type)
+            {
+            case ColumnType::INT64:
+            case ColumnType::TIMESTAMP:
+            {
+                const auto &values = batch.ints(column);
+                chunk.type = kParquetInt64;
+                auto [lo, hi] = std::minmax_element(values.begin(), values.end());
+                chunk.min_value.assign(reinterpret_cast<const char *>(&*lo), sizeof(int64_t));
+                chunk.max_value.assign(reinterpret_cast<const char *>(&*hi), sizeof(int64_t));
+                encode_delta(payload, values.data(), rows);
+                chunk.encodings = {kEncodingDeltaBinaryPacked};
+                write_page(chunk, kPageData, payload, rows, kEncodingDeltaBinaryPacked);
+                break;
+            }
+            case ColumnType::DOUBLE:
+            {
+                const auto &values = batch.doubles(column);
+                chunk.type = kParquetDouble;
+                double lo = std::numeric_limits<double>::infinity();
+                double hi = -lo;
+                for (double value : values)
+                {
+                    if (!std::isnan(value))
+                    {
+                        lo = std::min(lo, value);
+                        hi = std::max(hi, value);
+                    }
+                }
+                if (lo <= hi)
+                {
+                    chunk.min_value.assign(reinterpret_cast<const char *>(&lo), sizeof(double));
+                    chunk.max_value.assign(reinterpret_cast<const char *>(&hi), sizeof(double));
+                }
+                append(payload, values.data(), rows * sizeof(double));
+                chunk.encodings = {kEncodingPlain};
+                write_page(chunk, kPageData, payload, rows, kEncodingPlain);
+                break;
+            }
+            case ColumnType::STRING:
+            {
+                const auto &values = batch.strings(column);
+                chunk.type = kParquetByteArray;
+
+                // Dictionary in first-seen order; keys view the batch's strings
+                std::unordered_map<std::string_view, uint32_t> lookup;
+                std::vector<const std::string *> dictionary;
+                std::vector<uint32_t> indices;
+                indices.reserve(rows);
+                for (const auto &value : values)
+                {
+                    auto [it, inserted] = lookup.emplace(value, static_cast<uint32_t>(dictionary.size()));
+                    if (inserted)
+                    {
+                        if (dictionary.size() == kMaxDictionarySize)
+                        {
+                            break;
+                        }
+                        dictionary.push_back(&value);
+                    }
+                    indices.push_back(it->second);
+                }
+
+                auto put_plain = [&payload](const std::string &value)
+                {
+                    append_le<uint32_t>(payload, static_cast<uint32_t>(value.size()));
+                    append(payload, value.data(), value.size());
+                };
+                if (indices.size() == rows)
+                {
+                    for (const auto *value : dictionary)
+                    {
+                        put_plain(*value);
+                    }
+                    write_page(chunk, kPageDictionary, payload, dictionary.size(), kEncodingPlain);
+                    payload.clear();
+                    encode_dictionary_indices(payload, indices, dictionary.size());
+                    chunk.encodings = {kEncodingPlain, kEncodingRle, kEncodingRleDictionary};
+                    write_page(chunk, kPageData, payload, rows, kEncodingRleDictionary);
+
+                    auto [lo, hi] = std::minmax_element(dictionary.begin(), dictionary.end(),
+                                                        [](const std::string *a, const std::string *b)
+                                                        { return *a < *b; });
+                    chunk.min_value = **lo;
+                    chunk.max_value = **hi;
+                }
+                else
+                {
+                    // Too many distinct values for a dictionary to pay off
+                    for (const auto &value : values)
+                    {
+                        put_plain(value);
+                    }
+                    chunk.encodings = {kEncodingPlain};
+                    write_page(chunk, kPageData, payload, rows, kEncodingPlain);
+                    auto [lo, hi] = std::minmax_element(values.begin(), values.end());
+                    chunk.min_value = *lo;
+                    chunk.max_value = *hi;
+                }
+                break;
+            }
+            }
+            return chunk;
+        }
+
+        void ParquetWriter::write_page(ChunkInfo &chunk, int page_type, const std::vector<uint8_t> &payload,
+                                       size_t values, int encoding)
+        {
+            const std::vector<uint8_t> *body = &payload;
+#ifdef HAVE_ZLIB
+            if (options_.compression == ExportCompression::GZIP)
+            {
+                gzip(payload, compressed_);
+                body = &compressed_;
+            }
+#endif
+
+            std::vector<uint8_t> header;
+            CompactWriter thrift(header);
+            thrift.begin_struct();
+            thrift.field_i32(1, page_type);
+            thrift.field_i32(2, static_cast<int32_t>(payload.size()));
+            thrift.field_i32(3, static_cast<int32_t>(body->size()));
+            if (page_type == kPageData)
+            {
+                thrift.field_struct(5);
+                thrift.field_i32(1, static_cast<int32_t>(values));
+                thrift.field_i32(2, encoding);
+                thrift.field_i32(3, kEncodingRle); // Definition levels (none: columns are REQUIRED)
+                thrift.field_i32(4, kEncodingRle); // Repetition levels (none: columns are flat)
+                thrift.end_struct();
+            }
+            else
+            {
+                thrift.field_struct(7);
+                thrift.field_i32(1, static_cast<int32_t>(values));
+                thrift.field_i32(2, encoding);
+                thrift.end_struct();
+            }
+            thrift.end_struct();
+
+            if (page_type == kPageData)
+            {
+                chunk.data_page_offset = static_cast<int64_t>(offset_);
+            }
+            else
+            {
+                chunk.dictionary_page_offset = static_cast<int64_t>(offset_);
+            }
+            chunk.total_uncompressed += static_cast<int64_t>(header.size() + payload.size());
+            chunk.total_compressed += static_cast<int64_t>(header.size() + body->size());
+            write_bytes(header.data(), header.size());
+            write_bytes(body->data(), body->size());
+        }
+
+        void ParquetWriter::write_footer()
+        {
+            const int32_t codec = options_.compression == ExportCompression::GZIP ? kCodecGzip : kCodecUncompressed;
+            std::vector<uint8_t> footer;
+            CompactWriter thrift(footer);
+            thrift.begin_struct();
+            thrift.field_i32(1, 1); // version
+
+            // Schema: a root group followed by one REQUIRED leaf per column
+            thrift.field_list(2, CompactWriter::kStruct, schema_.size() + 1);
+            thrift.begin_struct();
+            thrift.field_binary(4, "schema");
+            thrift.field_i32(5, static_cast<int32_t>(schema_.size()));
+            thrift.end_struct();
+            for (const auto &column : schema_)
+            {
+                thrift.begin_struct();
+                thrift.field_i32(1, column.type == ColumnType::DOUBLE   ? kParquetDouble
+                                    : column.type == ColumnType::STRING ? kParquetByteArray
+                                                                        : kParquetInt64);
+                thrift.field_i32(3, kRepetitionRequired);
+                thrift.field_binary(4, column.name);
+                if (column.type == ColumnType::STRING)
+                {
+                    thrift.field_i32(6, kConvertedUtf8);
+                    thrift.field_struct(10); // LogicalType
+                    thrift.field_struct(1);  // STRING
+                    thrift.end_struct();
+                    thrift.end_struct();
+                }
+                else if (column.type == ColumnType::TIMESTAMP)
+                {
+                    thrift.field_i32(6, kConvertedTimestampMicros);
+                    thrift.field_struct(10); // LogicalType
+                    thrift.field_struct(8);  // TIMESTAMP
+                    thrift.field_bool(1, true);
+                    thrift.field_struct(2); // unit
+                    thrift.field_struct(2); // MICROS
+                    thrift.end_struct();
+                    thrift.end_struct();
+                    thrift.end_struct();
+                    thrift.end_struct();
+                }
+                thrift.end_struct();
+            }
+
+            thrift.field_i64(3, static_cast<int64_t>(rows_written()));
+
+            thrift.field_list(4, CompactWriter::kStruct, row_groups_.size());
+            for (const auto &group : row_groups_)
+            {
+                thrift.begin_struct();
+                thrift.field_list(1, CompactWriter::kStruct, group.columns.size());
+                for (size_t c = 0; c < group.columns.size(); ++c)
+                {
+                    const auto &chunk = group.columns[c];
+                    int64_t chunk_start = chunk.dictionary_page_offset >= 0 ? chunk.dictionary_page_offset
+                                                                            : chunk.data_page_offset;
+                    thrift.begin_struct();
+                    thrift.field_i64(2, chunk_start);
+                    thrift.field_struct(3); // ColumnMetaData
+                    thrift.field_i32(1, chunk.type);
+                    thrift.field_list(2, CompactWriter::kI32, chunk.encodings.size());
+                    for (int32_t encoding : chunk.encodings)
+                    {
+                        thrift.list_i32(encoding);
+                    }
+                    thrift.field_list(3, CompactWriter::kBinary, 1);
+                    thrift.list_binary(schema_[c].name);
+                    thrift.field_i32(4, codec);
+                    thrift.field_i64(5, chunk.num_values);
+                    thrift.field_i64(6, chunk.total_uncompressed);
+                    thrift.field_i64(7, chunk.total_compressed);
+                    thrift.field_i64(9, chunk.data_page_offset);
+                    if (chunk.dictionary_page_offset >= 0)
+                    {
+                        thrift.field_i64(11, chunk.dictionary_page_offset);
+                    }
+                    thrift.field_struct(12); // Statistics
+                    thrift.field_i64(3, 0);  // null_count
+                    if (!chunk.max_value.empty() || !chunk.min_value.empty())
+                    {
+                        thrift.field_binary(5, chunk.max_value);
+                        thrift.field_binary(6, chunk.min_value);
+                    }
+                    thrift.end_struct();
+                    thrift.end_struct();
+                    thrift.end_struct();
+                }
+                thrift.field_i64(2, group.total_byte_size);
+                thrift.field_i64(3, group.num_rows);
+                thrift.end_struct();
+            }
+
+            if (!options_.metadata.empty())
+            {
+                thrift.field_list(5, CompactWriter::kStruct, options_.metadata.size());
+                for (const auto &entry : options_.metadata)
+                {
+                    thrift.begin_struct();
+                    thrift.field_binary(1, entry.first);
+                    thrift.field_binary(2, entry.second);
+                    thrift.end_struct();
+                }
+            }
+            thrift.field_binary(6, "trading-simulator");
+            thrift.end_struct();
+
+            append_le<uint32_t>(footer, static_cast<uint32_t>(footer.size()));
+            append(footer, kParquetMagic, 4);
+            write_bytes(footer.data(), footer.size());
+        }
+
+        // FeatherWriter implementation
+        FeatherWriter::FeatherWriter(const std::string &path, std::vector<ColumnSpec> schema, ColumnarOptions options)
+            : ColumnarWriter(path, std::move(schema), std::move(options))
+        {
+            if (options_.compression != ExportCompression::NONE)
+            {
+                throw std::invalid_argument("Feather output does not support GZIP compression");
+            }
+            write_bytes(kArrowMagic, 6);
+            write_padding(8);
+
+            FlatBuilder fb;
+            uint32_t header = build_arrow_schema(fb, schema_, options_.metadata);
+            write_message(build_arrow_message(fb, kMessageSchema, header, 0), {});
+        }
+
+        void FeatherWriter::write_batch(const ColumnBatch &batch, size_t rows)
+        {
+            // String columns need int32 offsets and one contiguous data buffer
+            std::vector<std::vector<int32_t>> string_offsets;
+            std::vector<std::string> string_data;
+            string_offsets.reserve(schema_.size());
+            string_data.reserve(schema_.size());
+
+            std::vector<std::pair<const void *, size_t>> buffers;
+            for (size_t c = 0; c < schema_.size(); ++c)
+            {
+                buffers.emplace_back(nullptr, 0); // Validity bitmap: omitted, no nulls
+                switch (schema_[c].type)
+                {
+                case ColumnType::INT64:
+                case ColumnType::TIMESTAMP:
+                    buffers.emplace_back(batch.ints(c).data(), rows * sizeof(int64_t));
+                    break;
+                case ColumnType::DOUBLE:
+                    buffers.emplace_back(batch.doubles(c).data(), rows * sizeof(double));
+                    break;
+                case ColumnType::STRING:
+                {
+                    auto &offsets = string_offsets.emplace_back();
+                    auto &data = string_data.emplace_back();
+                    offsets.reserve(rows + 1);
+                    offsets.push_back(0);
+                    for (const auto &value : batch.strings(c))
+                    {
+                        data += value;
+                        if (data.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+                        {
+                            throw std::runtime_error("String column " + schema_[c].name + " exceeds 2 GiB in one batch");
+                        }
+                        offsets.push_back(static_cast<int32_t>(data.size()));
+                    }
+                    buffers.emplace_back(offsets.data(), offsets.size() * sizeof(int32_t));
+                    buffers.emplace_back(data.data(), data.size());
+                    break;
+                }
+                }
+            }
+
+            FlatBuilder fb;
+            std::vector<uint8_t> nodes;
+            for (size_t c = 0; c < schema_.size(); ++c)
+            {
+                append_le<int64_t>(nodes, static_cast<int64_t>(rows)); // length
+                append_le<int64_t>(nodes, 0);                          // null_count
+            }
+            std::vector<uint8_t> layout;
+            int64_t body_length = 0;
+            for (const auto &buffer : buffers)
+            {
+                append_le<int64_t>(layout, body_length);
+                append_le<int64_t>(layout, static_cast<int64_t>(buffer.second));
+                body_length += static_cast<int64_t>(padded(buffer.second));
+            }
+            uint32_t node_vector = fb.create_structs(nodes, schema_.size());
+            uint32_t buffer_vector = fb.create_structs(layout, buffers.size());
+            fb.start_table();
+            fb.add_scalar<int64_t>(0, static_cast<int64_t>(rows));
+            fb.add_offset(1, node_vector);
+            fb.add_offset(2, buffer_vector);
+            uint32_t header = fb.end_table();
+
+            record_batches_.push_back(write_message(build_arrow_message(fb, kMessageRecordBatch, header, body_length), buffers));
+        }
+
+        FeatherWriter::Block FeatherWriter::write_message(const std::vector<uint8_t> &metadata,
+                                                          const std::vector<std::pair<const void *, size_t>> &buffers)
+        {
+            Block block{static_cast<int64_t>(offset_), 0, 0};
+            int32_t metadata_size = static_cast<int32_t>(metadata.size());
+            write_bytes(&kContinuation, sizeof(kContinuation));
+            write_bytes(&metadata_size, sizeof(metadata_size));
+            write_bytes(metadata.data(), metadata.size());
+            block.metadata_length = static_cast<int32_t>(offset_ - static_cast<uint64_t>(block.offset));
+
+            uint64_t body_start = offset_;
+            for (const auto &buffer : buffers)
+            {
+                write_bytes(buffer.first, buffer.second);
+                write_padding(8);
+            }
+            block.body_length = static_cast<int64_t>(offset_ - body_start);
+            return block;
+        }
+
+        void FeatherWriter::write_footer()
+        {
+            // End-of-stream marker
+            const uint32_t end_of_stream[2] = {kContinuation, 0};
+            write_bytes(end_of_stream, sizeof(end_of_stream));
+
+            FlatBuilder fb;
+            uint32_t schema = build_arrow_schema(fb, schema_, options_.metadata);
+            std::vector<uint8_t> blocks;
+            for (const auto &block : record_batches_)
+            {
+                append_le<int64_t>(blocks, block.offset);
+                append_le<int32_t>(blocks, block.metadata_length);
+                append_le<int32_t>(blocks, 0); // Struct padding
+                append_le<int64_t>(blocks, block.body_length);
+            }
+            uint32_t batch_vector = fb.create_structs(blocks, record_batches_.size());
+            uint32_t dictionary_vector = fb.create_structs({}, 0);
+            fb.start_table();
+            fb.add_offset(1, schema);
+            fb.add_offset(2, dictionary_vector);
+            fb.add_offset(3, batch_vector);
+            fb.add_scalar<int16_t>(0, kMetadataV5);
+            std::vector<uint8_t> footer = fb.finish(fb.end_table());
+
+            int32_t footer_size = static_cast<int32_t>(footer.size());
+            write_bytes(footer.data(), footer.size());
+            write_bytes(&footer_size, sizeof(footer_size));
+            write_bytes(kArrowMagic, 6);
+        }
+
+        // ColumnarExporter implementation
+        template <typename Fill>
+        bool ColumnarExporter::stream_rows(const ExportConfig &config, std::vector<ColumnSpec> schema, size_t rows,
+                                           std::map<std::string, std::string> metadata, Fill fill)
+        {
+            if (!validate_config(config))
+                return false;
+
+            try
+            {
+                ColumnarOptions options;
+                options.compression = config.compression;
+                options.metadata = std::move(metadata);
+                options.metadata.insert(config.metadata.begin(), config.metadata.end());
+
+                auto writer = open_writer(ExportUtils::get_output_path(config.filename), std::move(schema), std::move(options));
+                ColumnBatch batch(writer->schema());
+                const size_t group_size = std::max<size_t>(1, config.row_group_size);
+                batch.reserve(std::min(group_size, rows));
+                for (size_t begin = 0; begin < rows; begin += group_size)
+                {
+                    size_t end = std::min(rows, begin + group_size);
+                    batch.clear();
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        fill(batch, i);
+                    }
+                    writer->write(batch);
+                }
+                writer->close();
+                return true;
+            }
+            catch (const std::exception &)
+            {
+                return false;
+            }
+        }
+
+        bool ColumnarExporter::export_market_data(const MarketDataSeries &series, const ExportConfig &config)
+        {
+            std::vector<ColumnSpec> schema = {
+                {"timestamp", ColumnType::TIMESTAMP}, {"symbol", ColumnType::STRING}, {"open", ColumnType::DOUBLE}, {"high", ColumnType::DOUBLE}, {"low", ColumnType::DOUBLE}, {"close", ColumnType::DOUBLE}, {"volume", ColumnType::INT64}};
+            const auto &data = series.data();
+            const std::string &symbol = series.symbol();
+            return stream_rows(config, std::move(schema), data.size(), {{"symbol", symbol}},
+                               [&](ColumnBatch &batch, size_t i)
+                               {
+                                   const auto &point = data[i];
+                                   batch.ints(0).push_back(to_micros(point.timestamp));
+                                   batch.strings(1).push_back(symbol);
+                                   batch.doubles(2).push_back(point.open);
+                                   batch.doubles(3).push_back(point.high);
+                                   batch.doubles(4).push_back(point.low);
+                                   batch.doubles(5).push_back(point.close);
+                                   batch.ints(6).push_back(static_cast<int64_t>(point.volume));
+                               });
+        }
+
+        bool ColumnarExporter::export_indicators(const TechnicalIndicators &indicators, const ExportConfig &config)
+        {
+            const std::vector<std::pair<const char *, const std::vector<double> *>> series = {
+                {"sma_20", &indicators.sma_20},
+                {"sma_50", &indicators.sma_50},
+                {"ema_12", &indicators.ema_12},
+                {"ema_26", &indicators.ema_26},
+                {"rsi", &indicators.rsi},
+                {"macd", &indicators.macd},
+                {"macd_signal", &indicators.macd_signal},
+                {"bollinger_upper", &indicators.bollinger_upper},
+                {"bollinger_lower", &indicators.bollinger_lower},
+                {"volume_sma", &indicators.volume_sma}};
+
+            std::vector<ColumnSpec> schema = {{"index", ColumnType::INT64}};
+            size_t rows = 0;
+            for (const auto &entry : series)
+            {
+                schema.emplace_back(entry.first, ColumnType::DOUBLE);
+                rows = std::max(rows, entry.second->size());
+            }
+            return stream_rows(config, std::move(schema), rows, {},
+                               [&](ColumnBatch &batch, size_t i)
+                               {
+                                   batch.ints(0).push_back(static_cast<int64_t>(i));
+                                   for (size_t s = 0; s < series.size(); ++s)
+                                   {
+                                       batch.doubles(s + 1).push_back(value_or_nan(*series[s].second, i));
+                                   }
+                               });
+        }
+
+        bool ColumnarExporter::export_chart_data(const std::vector<CandlestickPoint> &data,
+                                                 const std::vector<IndicatorOverlay> &indicators,
+                                                 const ExportConfig &config)
+        {
+            std::vector<ColumnSpec> schema = {
+                {"timestamp", ColumnType::TIMESTAMP}, {"open", ColumnType::DOUBLE}, {"high", ColumnType::DOUBLE}, {"low", ColumnType::DOUBLE}, {"close", ColumnType::DOUBLE}, {"volume", ColumnType::INT64}};
+            for (const auto &overlay : indicators)
+            {
+                schema.emplace_back(overlay.name, ColumnType::DOUBLE);
+            }
+            return stream_rows(config, std::move(schema), data.size(), {},
+                               [&](ColumnBatch &batch, size_t i)
+                               {
+                                   const auto &point = data[i];
+                                   batch.ints(0).push_back(to_micros(point.timestamp));
+                                   batch.doubles(1).push_back(point.open);
+                                   batch.doubles(2).push_back(point.high);
+                                   batch.doubles(3).push_back(point.low);
+                                   batch.doubles(4).push_back(point.close);
+                                   batch.ints(5).push_back(static_cast<int64_t>(point.volume));
+                                   for (size_t k = 0; k < indicators.size(); ++k)
+                                   {
+                                       batch.doubles(k + 6).push_back(value_or_nan(indicators[k].points, i));
+                                   }
+                               });
+        }
+
+        bool ColumnarExporter::export_performance_data(const std::vector<ChartPoint> &pnl_data,
+                                                       const std::vector<ChartPoint> &drawdown_data,
+                                                       const ExportConfig &config)
+        {
+            std::vector<ColumnSpec> schema = {
+                {"index", ColumnType::INT64}, {"pnl", ColumnType::DOUBLE}, {"drawdown", ColumnType::DOUBLE}};
+            return stream_rows(config, std::move(schema), std::max(pnl_data.size(), drawdown_data.size()), {},
+                               [&](ColumnBatch &batch, size_t i)
+                               {
+                                   batch.ints(0).push_back(static_cast<int64_t>(i));
+                                   batch.doubles(1).push_back(value_or_nan(pnl_data, i));
+                                   batch.doubles(2).push_back(value_or_nan(drawdown_data, i));
+                               });
+        }
+
+        bool ColumnarExporter::export_portfolio_data(const std::vector<std::pair<std::string, double>> &positions,
+                                                     const ExportConfig &config)
+        {
+            std::vector<ColumnSpec> schema = {{"symbol", ColumnType::STRING}, {"quantity", ColumnType::DOUBLE}};
+            return stream_rows(config, std::move(schema), positions.size(), {},
+                               [&](ColumnBatch &batch, size_t i)
+                               {
+                                   batch.strings(0).push_back(positions[i].first);
+                                   batch.doubles(1).push_back(positions[i].second);
+                               });
+        }
+
+        bool ColumnarExporter::validate_config(const ExportConfig &config)
+        {
+#ifndef HAVE_ZLIB
+            if (config.compression == ExportCompression::GZIP)
+                return false;
+#endif
+            return !config.filename.empty() && config.row_group_size > 0;
+        }
+
+        // ParquetExporter implementation
+        std::unique_ptr<ColumnarWriter> ParquetExporter::open_writer(const std::string &path, std::vector<ColumnSpec> schema,
+                                                                     ColumnarOptions options)
+        {
+            return std::make_unique<ParquetWriter>(path, std::move(schema), std::move(options));
+        }
+
+        // FeatherExporter implementation
+        bool FeatherExporter::validate_config(const ExportConfig &config)
+        {
+            return config.compression == ExportCompression::NONE && ColumnarExporter::validate_config(config);
+        }
+
+        std::unique_ptr<ColumnarWriter> FeatherExporter::open_writer(const std::string &path, std::vector<ColumnSpec> schema,
+                                                                     ColumnarOptions options)
+        {
+            return std::make_unique<FeatherWriter>(path, std::move(schema), std::move(options));
+        }
+
+    } // namespace visualization
+} // namespace trading
@@ -24,13 +24,28 @@ namespace trading
             needs_update_ = false;
         }
 
+        bool DashboardWidget::begin_update()
+        {
+            // Cleared before the channels are read, so data published while
+            // update() runs marks the widget again instead of being lost
+            if (!needs_update_.exchange(false, std::memory_order_acq_rel))
+            {
+                return false;
+            }
+            needs_render_ = true;
+            return true;
+        }
+
         // PriceTickerWidget implementation
         void PriceTickerWidget::update()
         {
-            if (needs_update_)
+            if (begin_update() && quote_in_.take(quote_))
             {
-                // Update logic would go here
-                clear_update_flag();
+                current_price_ = quote_.price;
+                price_change_ = quote_.change;
+                price_change_percent_ = quote_.change_percent;
+                volume_ = quote_.volume;
+                last_update_ = quote_.timestamp;
             }
         }
 
@@ -95,11 +110,18 @@ namespace trading
 
         void PriceTickerWidget::update_price(double price, double change, double change_percent, uint64_t volume)
         {
-            current_price_ = price;
-            price_change_ = change;
-            price_change_percent_ = change_percent;
-            volume_ = volume;
-            last_update_ = std::chrono::system_clock::now();
+            Quote quote;
+            quote.price = price;
+            quote.change = change;
+            quote.change_percent = change_percent;
+            quote.volume = volume;
+            quote.timestamp = std::chrono::system_clock::now();
+            update_quote(quote);
+        }
+
+        void PriceTickerWidget::update_quote(const Quote &quote)
+        {
+            quote_in_.publish(quote);
             mark_for_update();
         }
 
@@ -143,17 +165,42 @@ namespace trading
 
         void ChartWidget::update()
         {
-            if (needs_update_ && renderer_)
+            if (!begin_update())
+            {
+                return;
+            }
+            if (candles_in_.take(candlestick_data_))
+            {
+                pyramid_.build(candlestick_data_);
+            }
+            indicators_in_.take(indicators_);
+
+            if (renderer_)
             {
                 if (!candlestick_data_.empty())
                 {
-                    renderer_->render_candlestick_chart(candlestick_data_, indicators_, chart_config_);
+                    size_t begin = std::min(view_begin_, candlestick_data_.size());
+                    size_t end = std::min(view_end_, candlestick_data_.size());
+                    std::vector<CandlestickPoint> view = pyramid_.view(begin, end, lod_budget(chart_config_, 2));
+
+                    // Overlays are aligned with the bars; the renderer reduces them
+                    std::vector<IndicatorOverlay> overlays;
+                    overlays.reserve(indicators_.size());
+                    for (const auto &indicator : indicators_)
+                    {
+                        overlays.emplace_back(indicator.name, indicator.color);
+                        overlays.back().opacity = indicator.opacity;
+                        overlays.back().visible = indicator.visible;
+                        size_t first = std::min(begin, indicator.points.size());
+                        size_t last = std::min(end, indicator.points.size());
+                        overlays.back().points.assign(indicator.points.begin() + first, indicator.points.begin() + last);
+                    }
+                    renderer_->render_candlestick_chart(view, overlays, chart_config_);
                 }
                 else if (!current_series_.empty())
                 {
                     renderer_->render_line_chart(current_series_, chart_config_);
                 }
-                clear_update_flag();
             }
         }
 
@@ -197,13 +244,13 @@ namespace trading
 
         void ChartWidget::update_candlestick_data(const std::vector<CandlestickPoint> &data)
         {
-            candlestick_data_ = data;
+            candles_in_.publish(data);
             mark_for_update();
         }
 
         void ChartWidget::update_indicators(const std::vector<IndicatorOverlay> &indicators)
         {
-            indicators_ = indicators;
+            indicators_in_.publish(indicators);
             mark_for_update();
         }
 
@@ -213,6 +260,13 @@ namespace trading
             mark_for_update();
         }
 
+        void ChartWidget::set_view_range(size_t begin, size_t end)
+        {
+            view_begin_ = begin;
+            view_end_ = end;
+            mark_for_update();
+        }
+
         bool ChartWidget::export_chart(const std::string &filename)
         {
             if (renderer_)
@@ -225,27 +279,26 @@ namespace trading
         // OrderBookWidget implementation
         void OrderBookWidget::update()
         {
-            if (needs_update_)
+            if (begin_update() && depth_in_.take(depth_))
             {
-                // Calculate spread and totals
-                if (!bids_.empty() && !asks_.empty())
+                // Calculate spread and totals; a one-sided book has no spread
+                spread_ = 0.0;
+                if (!depth_.bids.empty() && !depth_.asks.empty())
                 {
-                    spread_ = asks_[0].price - bids_[0].price;
+                    spread_ = depth_.asks[0].price - depth_.bids[0].price;
                 }
 
                 total_bid_volume_ = 0;
                 total_ask_volume_ = 0;
 
-                for (const auto &bid : bids_)
+                for (const auto &bid : depth_.bids)
                 {
                     total_bid_volume_ += bid.quantity;
                 }
-                for (const auto &ask : asks_)
+                for (const auto &ask : depth_.asks)
                 {
                     total_ask_volume_ += ask.quantity;
                 }
-
-                clear_update_flag();
             }
         }
 
@@ -257,18 +310,18 @@ namespace trading
             std::cout << "Total Ask Volume: " << format_volume(total_ask_volume_) << "\n\n";
 
             std::cout << "Asks (Sell Orders):\n";
-            for (size_t i = 0; i < std::min(asks_.size(), size_t(5)); ++i)
+            for (size_t i = 0; i < std::min(depth_.asks.size(), size_t(5)); ++i)
             {
-                const auto &ask = asks_[i];
+                const auto &ask = depth_.asks[i];
                 std::cout << "  $" << std::fixed << std::setprecision(2) << ask.price
                           << " - " << format_volume(ask.quantity)
                           << " (" << ask.order_count << " orders)\n";
             }
 
             std::cout << "\nBids (Buy Orders):\n";
-            for (size_t i = 0; i < std::min(bids_.size(), size_t(5)); ++i)
+            for (size_t i = 0; i < std::min(depth_.bids.size(), size_t(5)); ++i)
             {
-                const auto &bid = bids_[i];
+                const auto &bid = depth_.bids[i];
                 std::cout << "  $" << std::fixed << std::setprecision(2) << bid.price
                           << " - " << format_volume(bid.quantity)
                           << " (" << bid.order_count << " orders)\n";
@@ -284,21 +337,21 @@ namespace trading
             data << "  \"total_bid_volume\": " << total_bid_volume_ << ",\n";
             data << "  \"total_ask_volume\": " << total_ask_volume_ << ",\n";
             data << "  \"asks\": [\n";
-            for (size_t i = 0; i < asks_.size(); ++i)
+            for (size_t i = 0; i < depth_.asks.size(); ++i)
             {
-                const auto &ask = asks_[i];
+                const auto &ask = depth_.asks[i];
                 data << "    {\"price\": " << ask.price << ", \"quantity\": " << ask.quantity << ", \"orders\": " << ask.order_count << "}";
-                if (i < asks_.size() - 1)
+                if (i < depth_.asks.size() - 1)
                     data << ",";
                 data << "\n";
             }
             data << "  ],\n";
             data << "  \"bids\": [\n";
-            for (size_t i = 0; i < bids_.size(); ++i)
+            for (size_t i = 0; i < depth_.bids.size(); ++i)
             {
-                const auto &bid = bids_[i];
+                const auto &bid = depth_.bids[i];
                 data << "    {\"price\": " << bid.price << ", \"quantity\": " << bid.quantity << ", \"orders\": " << bid.order_count << "}";
-                if (i < bids_.size() - 1)
+                if (i < depth_.bids.size() - 1)
                     data << ",";
                 data << "\n";
             }
@@ -321,8 +374,27 @@ namespace trading
         void OrderBookWidget::update_order_book(const std::vector<OrderBookLevel> &bids,
                                                 const std::vector<OrderBookLevel> &asks)
         {
-            bids_ = bids;
-            asks_ = asks;
+            depth_in_.publish(Depth{bids, asks});
+            mark_for_update();
+        }
+
+        void OrderBookWidget::update_from_book(const OrderBook &book, size_t depth)
+        {
+            staged_.bids.clear();
+            staged_.asks.clear();
+
+            book.snapshot(BookSide::BID, depth, snapshot_);
+            for (const auto &level : snapshot_)
+            {
+                staged_.bids.emplace_back(level.price, level.quantity, static_cast<int>(level.order_count), true);
+            }
+            book.snapshot(BookSide::ASK, depth, snapshot_);
+            for (const auto &level : snapshot_)
+            {
+                staged_.asks.emplace_back(level.price, level.quantity, static_cast<int>(level.order_count), false);
+            }
+
+            depth_in_.publish(staged_);
             mark_for_update();
         }
 
@@ -349,8 +421,11 @@ namespace trading
         // PositionSummaryWidget implementation
         void PositionSummaryWidget::update()
         {
-            if (needs_update_)
+            if (begin_update())
             {
+                positions_in_.take(positions_);
+                portfolio_value_in_.take(total_portfolio_value_);
+
                 // Calculate P&L for each position
                 for (auto &position : positions_)
                 {
@@ -366,8 +441,6 @@ namespace trading
                     total_unrealized_pnl_ += position.unrealized_pnl;
                     total_realized_pnl_ += position.realized_pnl;
                 }
-
-                clear_update_flag();
             }
         }
 
@@ -431,13 +504,13 @@ namespace trading
 
         void PositionSummaryWidget::update_positions(const std::vector<Position> &positions)
         {
-            positions_ = positions;
+            positions_in_.publish(positions);
             mark_for_update();
         }
 
         void PositionSummaryWidget::update_portfolio_value(double value)
         {
-            total_portfolio_value_ = value;
+            portfolio_value_in_.publish(value);
             mark_for_update();
         }
 
@@ -454,7 +527,20 @@ namespace trading
 
         void PnLChartWidget::update()
         {
-            if (needs_update_ && renderer_)
+            if (!begin_update())
+            {
+                return;
+            }
+            pnl_in_.take(pnl_data_);
+            drawdown_in_.take(drawdown_data_);
+            std::pair<double, double> metrics;
+            if (metrics_in_.take(metrics))
+            {
+                max_drawdown_ = metrics.first;
+                total_return_ = metrics.second;
+            }
+
+            if (renderer_)
             {
                 // Create chart series from P&L data
                 std::vector<ChartSeries> series;
@@ -483,8 +569,6 @@ namespace trading
                 {
                     renderer_->render_line_chart(series, chart_config_);
                 }
-
-                clear_update_flag();
             }
         }
 
@@ -522,25 +606,28 @@ namespace trading
 
         void PnLChartWidget::update_pnl_data(const std::vector<ChartPoint> &pnl, const std::vector<ChartPoint> &drawdown)
         {
-            pnl_data_ = pnl;
-            drawdown_data_ = drawdown;
+            pnl_in_.publish(pnl);
+            drawdown_in_.publish(drawdown);
             mark_for_update();
         }
 
         void PnLChartWidget::update_metrics(double max_dd, double total_ret)
         {
-            max_drawdown_ = max_dd;
-            total_return_ = total_ret;
+            metrics_in_.publish(std::make_pair(max_dd, total_ret));
             mark_for_update();
         }
 
+        void PnLChartWidget::update_metrics(const analytics::CurveMetrics &metrics)
+        {
+            update_metrics(metrics.max_drawdown, metrics.total_return);
+        }
+
         // PerformanceMetricsWidget implementation
         void PerformanceMetricsWidget::update()
         {
-            if (needs_update_)
+            if (begin_update())
             {
-                // Update logic would go here
-                clear_update_flag();
+                metrics_in_.take(metrics_);
             }
         }
 
@@ -594,7 +681,84 @@ namespace trading
 
         void PerformanceMetricsWidget::update_metrics(const Metrics &metrics)
         {
-            metrics_ = metrics;
+            metrics_in_.publish(metrics);
+            mark_for_update();
+        }
+
+        void PerformanceMetricsWidget::update_metrics(const analytics::CurveMetrics &metrics)
+        {
+            Metrics shown;
+            shown.sharpe_ratio = metrics.sharpe_ratio;
+            shown.sortino_ratio = metrics.sortino_ratio;
+            shown.calmar_ratio = metrics.calmar_ratio;
+            shown.max_drawdown = metrics.max_drawdown;
+            shown.total_return = metrics.total_return;
+            shown.annualized_return = metrics.annualized_return;
+            shown.volatility = metrics.volatility;
+            shown.win_rate = metrics.win_rate;
+            shown.total_trades = metrics.total_trades;
+            shown.avg_win = metrics.avg_win;
+            shown.avg_loss = metrics.avg_loss;
+            shown.profit_factor = metrics.profit_factor;
+            update_metrics(shown);
+        }
+
+        // SystemMetricsWidget implementation
+        void SystemMetricsWidget::update()
+        {
+            if (begin_update())
+            {
+                snapshot_in_.take(snapshot_);
+            }
+        }
+
+        void SystemMetricsWidget::render()
+        {
+            std::cout << "=== " << config_.title << " ===\n";
+            std::cout << std::left << std::setw(44) << "Latency (us)" << std::right << std::setw(10) << "count"
+                      << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "p99.9"
+                      << std::setw(10) << "max" << "\n";
+            for (const auto &histogram : snapshot_.histograms)
+            {
+                std::cout << std::left << std::setw(44) << histogram.name << std::right << std::setw(10)
+                          << histogram.count << std::fixed << std::setprecision(1)
+                          << std::setw(10) << histogram.percentile(0.5) / 1000.0
+                          << std::setw(10) << histogram.percentile(0.99) / 1000.0
+                          << std::setw(10) << histogram.percentile(0.999) / 1000.0
+                          << std::setw(10) << histogram.max / 1000.0 << "\n";
+            }
+            for (const auto *values : {&snapshot_.counters, &snapshot_.gauges})
+            {
+                for (const auto &value : *values)
+                {
+                    std::string name = value.labels.empty() ? value.name : value.name + "{" + value.labels + "}";
+                    std::cout << std::left << std::setw(44) << name << std::right << std::setw(10)
+                              << std::fixed << std::setprecision(0) << value.value << "\n";
+                }
+            }
+            std::cout << "\n";
+        }
+
+        std::string SystemMetricsWidget::get_data() const
+        {
+            return metrics::to_json(snapshot_);
+        }
+
+        void SystemMetricsWidget::set_data(const std::string & /*data*/)
+        {
+            // Snapshots only come from the registry
+            mark_for_update();
+        }
+
+        void SystemMetricsWidget::update_metrics(const metrics::MetricsSnapshot &snapshot)
+        {
+            snapshot_in_.publish(snapshot);
+            mark_for_update();
+        }
+
+        void SystemMetricsWidget::update_from_registry()
+        {
+            snapshot_in_.publish(metrics::Registry::global().snapshot());
             mark_for_update();
         }
 
@@ -641,6 +805,7 @@ namespace trading
                 {
                     widget->render();
                 }
+                widget->clear_render_flag();
             }
         }
 
@@ -652,7 +817,32 @@ namespace trading
             }
         }
 
+        size_t DashboardPanel::render_dirty()
+        {
+            if (!visible_)
+                return 0;
+
+            size_t rendered = 0;
+            for (auto &widget : widgets_)
+            {
+                if (!widget->needs_render())
+                    continue;
+                if (widget->config().visible)
+                {
+                    widget->render();
+                    ++rendered;
+                }
+                widget->clear_render_flag();
+            }
+            return rendered;
+        }
+
         // Dashboard implementation
+        Dashboard::~Dashboard()
+        {
+            stop();
+        }
+
         void Dashboard::add_panel(std::unique_ptr<DashboardPanel> panel)
         {
             panels_.push_back(std::move(panel));
@@ -737,31 +927,19 @@ namespace trading
 
         void Dashboard::update()
         {
+            // Widgets only do work for data published since the last call;
+            // nothing is re-marked on a timer
             for (auto &panel : panels_)
             {
                 panel->update();
             }
-
-            if (auto_refresh_)
-            {
-                auto now = std::chrono::system_clock::now();
-                if (now - last_update_ >= refresh_interval_)
-                {
-                    last_update_ = now;
-                    // Trigger refresh of all widgets
-                    for (auto &panel : panels_)
-                    {
-                        for (auto &widget : panel->widgets())
-                        {
-                            widget->mark_for_update();
-                        }
-                    }
-                }
-            }
+            last_update_ = std::chrono::system_clock::now();
         }
 
         void Dashboard::render()
         {
+            update();
+
             std::cout << "=== " << title_ << " ===\n";
             std::cout << "Dashboard rendering at " << width_ << "x" << height_ << "\n\n";
 
@@ -771,6 +949,83 @@ namespace trading
             }
         }
 
+        size_t Dashboard::render_dirty()
+        {
+            size_t rendered = 0;
+            for (auto &panel : panels_)
+            {
+                rendered += panel->render_dirty();
+            }
+            if (rendered > 0)
+            {
+                std::cout.flush();
+            }
+            frames_rendered_.fetch_add(1, std::memory_order_relaxed);
+            widgets_rendered_.fetch_add(rendered, std::memory_order_relaxed);
+            return rendered;
+        }
+
+        void Dashboard::start()
+        {
+            if (render_thread_.joinable())
+            {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(render_mutex_);
+                stop_render_ = false;
+            }
+            render_thread_ = std::thread(&Dashboard::render_loop, this);
+        }
+
+        void Dashboard::stop()
+        {
+            if (!render_thread_.joinable())
+            {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(render_mutex_);
+                stop_render_ = true;
+            }
+            render_cv_.notify_all();
+            render_thread_.join();
+        }
+
+        void Dashboard::render_loop()
+        {
+            auto next_frame = std::chrono::steady_clock::now();
+            std::unique_lock<std::mutex> lock(render_mutex_);
+            while (!stop_render_)
+            {
+                // Fixed cadence: a slow frame shortens the next wait rather
+                // than pushing every later frame back
+                next_frame += refresh_interval_;
+                auto now = std::chrono::steady_clock::now();
+                if (next_frame < now)
+                {
+                    next_frame = now;
+                }
+                if (render_cv_.wait_until(lock, next_frame, [this]
+                                          { return stop_render_; }))
+                {
+                    break;
+                }
+
+                if (!auto_refresh_.load(std::memory_order_relaxed))
+                {
+                    continue;
+                }
+
+                // Data threads never wait on the render mutex, but
+                // set_refresh_interval() and stop() do, so drop it while drawing
+                lock.unlock();
+                update();
+                render_dirty();
+                lock.lock();
+            }
+        }
+
         void Dashboard::export_layout(const std::string &filename)
         {
             std::string output_path = ExportUtils::get_output_path(filename);
@@ -831,6 +1086,7 @@ namespace trading
 
         void Dashboard::clear()
         {
+            stop();
             panels_.clear();
             data_sources_.clear();
         }
@@ -1,4 +1,5 @@
 #include "visualization/data_export.h"
+#include "visualization/columnar_export.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -6,11 +7,404 @@
 #include <algorithm>
 #include <filesystem>
 #include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <ctime>
+#include <string_view>
+#include <limits>
+#include <cstring>
+#include <system_error>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 namespace trading
 {
     namespace visualization
     {
+        namespace
+        {
+            // Fixed-point text, same output as std::fixed << std::setprecision(precision)
+            template <typename String>
+            void append_fixed(String &out, double value, int precision)
+            {
+                size_t start = out.size();
+                out.resize(start + 32);
+                auto result = std::to_chars(out.data() + start, out.data() + out.size(), value,
+                                            std::chars_format::fixed, precision);
+                if (result.ec == std::errc::value_too_large)
+                {
+                    // Up to 309 integer digits for the largest doubles
+                    out.resize(start + 320 + static_cast<size_t>(precision));
+                    result = std::to_chars(out.data() + start, out.data() + out.size(), value,
+                                           std::chars_format::fixed, precision);
+                }
+                out.resize(static_cast<size_t>(result.ptr - out.data()));
+            }
+
+            // Same output as streaming a double with default flags (%g)
+            template <typename String>
+            void append_general(String &out, double value)
+            {
+                char formatted[32];
+                auto result = std::to_chars(formatted, formatted + sizeof(formatted), value, std::chars_format::general, 6);
+                out.append(formatted, static_cast<size_t>(result.ptr - formatted));
+            }
+
+            template <typename String>
+            void append_integer(String &out, int64_t value)
+            {
+                char digits[24];
+                auto result = std::to_chars(digits, digits + sizeof(digits), value);
+                out.append(digits, static_cast<size_t>(result.ptr - digits));
+            }
+
+            // Local time as "%Y-%m-%d %H:%M:%S". localtime_r() is only called
+            // when the hour changes: UTC offsets change on the hour, so within
+            // an hour the minutes and seconds can be advanced directly.
+            class TimestampFormatter
+            {
+            public:
+                template <typename String>
+                void append(String &out, const std::chrono::system_clock::time_point &value)
+                {
+                    std::time_t time = std::chrono::system_clock::to_time_t(value);
+                    std::time_t into_hour = time - hour_start_;
+                    if (hour_start_ == kNoHour || into_hour < 0 || into_hour >= 3600)
+                    {
+                        std::tm local{};
+                        localtime_r(&time, &local);
+                        hour_start_ = time - local.tm_min * 60 - local.tm_sec;
+                        into_hour = time - hour_start_;
+                        write_digits(text_, local.tm_year + 1900, 4);
+                        text_[4] = '-';
+                        write_digits(text_ + 5, local.tm_mon + 1, 2);
+                        text_[7] = '-';
+                        write_digits(text_ + 8, local.tm_mday, 2);
+                        text_[10] = ' ';
+                        write_digits(text_ + 11, local.tm_hour, 2);
+                        text_[13] = ':';
+                        text_[16] = ':';
+                    }
+                    write_digits(text_ + 14, static_cast<int>(into_hour / 60), 2);
+                    write_digits(text_ + 17, static_cast<int>(into_hour % 60), 2);
+                    out.append(text_, sizeof(text_));
+                }
+
+            private:
+                static constexpr std::time_t kNoHour = std::numeric_limits<std::time_t>::min();
+
+                static void write_digits(char *out, int value, int width)
+                {
+                    for (int i = width - 1; i >= 0; --i)
+                    {
+                        out[i] = static_cast<char>('0' + value % 10);
+                        value /= 10;
+                    }
+                }
+
+                std::time_t hour_start_ = kNoHour;
+                char text_[19] = {};
+            };
+
+            // Streambuf behind the text exporters: a large user-space buffer
+            // drained with fwrite() and, for GZIP, a deflate stage in between,
+            // so compressed files are produced as rows are written instead
+            // of by a second pass over the finished file
+            class OutputFileBuffer : public std::streambuf
+            {
+            public:
+                static constexpr size_t kBufferBytes = 1 << 20;
+
+                OutputFileBuffer(const std::string &path, ExportCompression compression)
+                    : buffer_(kBufferBytes)
+                {
+#ifdef HAVE_ZLIB
+                    if (compression == ExportCompression::GZIP)
+                    {
+                        // windowBits 15 + 16 writes a gzip header and trailer
+                        if (deflateInit2(&stream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                        {
+                            return;
+                        }
+                        compressing_ = true;
+                        compressed_.resize(kBufferBytes / 4);
+                    }
+#else
+                    if (compression == ExportCompression::GZIP)
+                    {
+                        return;
+                    }
+#endif
+                    file_ = std::fopen(path.c_str(), "wb");
+                    setp(buffer_.data(), buffer_.data() + buffer_.size());
+                }
+
+                ~OutputFileBuffer() override { close(); }
+
+                bool is_open() const { return file_ != nullptr; }
+
+                // Flush, finish the compressed stream and close; false if any write failed
+                bool close()
+                {
+                    if (!file_)
+                    {
+                        return false;
+                    }
+                    drain(pbase(), static_cast<size_t>(pptr() - pbase()), true);
+#ifdef HAVE_ZLIB
+                    if (compressing_)
+                    {
+                        deflateEnd(&stream_);
+                        compressing_ = false;
+                    }
+#endif
+                    ok_ = std::fclose(file_) == 0 && ok_;
+                    file_ = nullptr;
+                    return ok_;
+                }
+
+            protected:
+                int_type overflow(int_type ch) override
+                {
+                    if (!drain(pbase(), static_cast<size_t>(pptr() - pbase()), false))
+                    {
+                        return traits_type::eof();
+                    }
+                    setp(buffer_.data(), buffer_.data() + buffer_.size());
+                    if (!traits_type::eq_int_type(ch, traits_type::eof()))
+                    {
+                        *pptr() = traits_type::to_char_type(ch);
+                        pbump(1);
+                    }
+                    return traits_type::not_eof(ch);
+                }
+
+                std::streamsize xsputn(const char *data, std::streamsize count) override
+                {
+                    size_t size = static_cast<size_t>(count);
+                    if (size <= static_cast<size_t>(epptr() - pptr()))
+                    {
+                        std::memcpy(pptr(), data, size);
+                        pbump(static_cast<int>(size));
+                        return count;
+                    }
+                    // Blocks larger than the free space bypass the buffer
+                    if (!drain(pbase(), static_cast<size_t>(pptr() - pbase()), false) || !drain(data, size, false))
+                    {
+                        return 0;
+                    }
+                    setp(buffer_.data(), buffer_.data() + buffer_.size());
+                    return count;
+                }
+
+                int sync() override
+                {
+                    bool drained = drain(pbase(), static_cast<size_t>(pptr() - pbase()), false);
+                    setp(buffer_.data(), buffer_.data() + buffer_.size());
+                    return drained ? 0 : -1;
+                }
+
+            private:
+                bool drain(const char *data, size_t size, bool finish)
+                {
+                    if (!file_ || !ok_)
+                    {
+                        return false;
+                    }
+#ifdef HAVE_ZLIB
+                    if (compressing_)
+                    {
+                        stream_.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+                        stream_.avail_in = static_cast<uInt>(size);
+                        int result = Z_OK;
+                        do
+                        {
+                            stream_.next_out = compressed_.data();
+                            stream_.avail_out = static_cast<uInt>(compressed_.size());
+                            result = deflate(&stream_, finish ? Z_FINISH : Z_NO_FLUSH);
+                            size_t produced = compressed_.size() - stream_.avail_out;
+                            ok_ = ok_ && result != Z_STREAM_ERROR &&
+                                  std::fwrite(compressed_.data(), 1, produced, file_) == produced;
+                        } while (ok_ && (stream_.avail_out == 0 || (finish && result != Z_STREAM_END)));
+                        return ok_;
+                    }
+#else
+                    (void)finish;
+#endif
+                    ok_ = ok_ && std::fwrite(data, 1, size, file_) == size;
+                    return ok_;
+                }
+
+                std::vector<char> buffer_;
+                std::FILE *file_ = nullptr;
+                bool ok_ = true;
+#ifdef HAVE_ZLIB
+                z_stream stream_{};
+                bool compressing_ = false;
+                std::vector<Bytef> compressed_;
+#endif
+            };
+
+            // Output file of a text export
+            class ExportStream : public std::ostream
+            {
+            public:
+                ExportStream(const std::string &path, ExportCompression compression)
+                    : std::ostream(nullptr), buffer_(path, compression)
+                {
+                    rdbuf(&buffer_);
+                    if (!buffer_.is_open())
+                    {
+                        setstate(std::ios::failbit);
+                    }
+                }
+
+                bool is_open() const { return buffer_.is_open(); }
+
+                // True if everything reached the file
+                bool close()
+                {
+                    bool flushed = static_cast<bool>(flush());
+                    return buffer_.close() && flushed;
+                }
+
+            private:
+                OutputFileBuffer buffer_;
+            };
+
+            bool compression_supported(const ExportConfig &config)
+            {
+#ifdef HAVE_ZLIB
+                (void)config;
+                return true;
+#else
+                return config.compression == ExportCompression::NONE;
+#endif
+            }
+
+            // Output path of a text export; compressed files get a ".gz" suffix
+            std::string text_output_path(const ExportConfig &config)
+            {
+                std::string path = ExportUtils::get_output_path(config.filename);
+                bool has_suffix = path.size() >= 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+                if (config.compression == ExportCompression::GZIP && !has_suffix)
+                {
+                    path += ".gz";
+                }
+                return path;
+            }
+
+            // Builds rows in a scratch buffer and writes them to the file in
+            // large blocks; formats fields in place with std::to_chars
+            // instead of through a temporary ostringstream and string per value
+            class RowWriter
+            {
+            public:
+                static constexpr size_t kFlushBytes = 64 * 1024;
+
+                RowWriter(std::ostream &file, std::pmr::memory_resource *scratch)
+                    : file_(file), buffer_(scratch)
+                {
+                    buffer_.reserve(kFlushBytes + 512);
+                }
+
+                ~RowWriter() { flush(); }
+
+                RowWriter &text(std::string_view value)
+                {
+                    buffer_.append(value);
+                    return *this;
+                }
+
+                // Same output as std::fixed << std::setprecision(precision)
+                RowWriter &number(double value, int precision = 6)
+                {
+                    append_fixed(buffer_, value, precision);
+                    return *this;
+                }
+
+                // Same output as streaming a double with default flags
+                RowWriter &general(double value)
+                {
+                    append_general(buffer_, value);
+                    return *this;
+                }
+
+                // Element i of values, or nothing past its end
+                RowWriter &number_at(const std::vector<double> &values, size_t i)
+                {
+                    return i < values.size() ? number(values[i]) : *this;
+                }
+
+                RowWriter &integer(int64_t value)
+                {
+                    append_integer(buffer_, value);
+                    return *this;
+                }
+
+                // Local time as "%Y-%m-%d %H:%M:%S"
+                RowWriter &timestamp(const std::chrono::system_clock::time_point &value)
+                {
+                    timestamps_.append(buffer_, value);
+                    return *this;
+                }
+
+                // Field of market data row i, from the shared cache when there is one
+                RowWriter &field(const FormattedSeries *formatted, const MarketDataPoint &point, size_t i,
+                                 FormattedSeries::Column column)
+                {
+                    if (formatted)
+                    {
+                        return text(formatted->field(i, column));
+                    }
+                    switch (column)
+                    {
+                    case FormattedSeries::TIMESTAMP:
+                        return timestamp(point.timestamp);
+                    case FormattedSeries::OPEN:
+                        return number(point.open);
+                    case FormattedSeries::HIGH:
+                        return number(point.high);
+                    case FormattedSeries::LOW:
+                        return number(point.low);
+                    case FormattedSeries::CLOSE:
+                        return number(point.close);
+                    default:
+                        return integer(static_cast<int64_t>(point.volume));
+                    }
+                }
+
+                // Call at the end of each row
+                void end_row()
+                {
+                    if (buffer_.size() >= kFlushBytes)
+                    {
+                        flush();
+                    }
+                }
+
+                void flush()
+                {
+                    file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+                    buffer_.clear();
+                }
+
+            private:
+                std::ostream &file_;
+                std::pmr::string buffer_;
+                TimestampFormatter timestamps_;
+            };
+
+            // One {"x": ..., "y": ...} array element with its separator
+            void write_chart_point(RowWriter &out, std::string_view indent, const ChartPoint &point, bool more)
+            {
+                out.text(indent).text("{\"x\": ").general(point.x).text(", \"y\": ").number(point.y).text("}");
+                out.text(more ? ",\n" : "\n");
+                out.end_row();
+            }
+        }
 
         // ExportFactory implementation
         std::unique_ptr<DataExporter> ExportFactory::create_exporter(ExportFormat format)
@@ -25,6 +419,10 @@ namespace trading
                 return std::make_unique<XMLExporter>();
             case ExportFormat::EXCEL:
                 return std::make_unique<ExcelExporter>();
+            case ExportFormat::PARQUET:
+                return std::make_unique<ParquetExporter>();
+            case ExportFormat::FEATHER:
+                return std::make_unique<FeatherExporter>();
             default:
                 return nullptr;
             }
@@ -78,8 +476,7 @@ namespace trading
             if (!validate_config(config))
                 return false;
 
-            std::string output_path = ExportUtils::get_output_path(config.filename);
-            std::ofstream file(output_path);
+            ExportStream file(text_output_path(config), config.compression);
             if (!file.is_open())
                 return false;
 
@@ -98,18 +495,22 @@ namespace trading
             }
 
             // Write data
-            for (const auto &point : series.data())
+            RowWriter out(file, scratch_resource());
+            const FormattedSeries *formatted = formatted_for(series);
+            for (size_t i = 0; i < series.size(); ++i)
             {
-                file << format_timestamp(point.timestamp) << config.delimiter;
-                file << format_number(point.open) << config.delimiter;
-                file << format_number(point.high) << config.delimiter;
-                file << format_number(point.low) << config.delimiter;
-                file << format_number(point.close) << config.delimiter;
-                file << point.volume << "\n";
+                const auto &point = series.data()[i];
+                out.field(formatted, point, i, FormattedSeries::TIMESTAMP).text(config.delimiter);
+                out.field(formatted, point, i, FormattedSeries::OPEN).text(config.delimiter);
+                out.field(formatted, point, i, FormattedSeries::HIGH).text(config.delimiter);
+                out.field(formatted, point, i, FormattedSeries::LOW).text(config.delimiter);
+                out.field(formatted, point, i, FormattedSeries::CLOSE).text(config.delimiter);
+                out.field(formatted, point, i, FormattedSeries::VOLUME).text("\n");
+                out.end_row();
             }
+            out.flush();
 
-            file.close();
-            return true;
+            return file.close();
         }
 
         bool CSVExporter::export_indicators(const TechnicalIndicators &indicators, const ExportConfig &config)
@@ -117,8 +518,7 @@ namespace trading
             if (!validate_config(config))
                 return false;
 
-            std::string output_path = ExportUtils::get_output_path(config.filename);
-            std::ofstream file(output_path);
+            ExportStream file(text_output_path(config), config.compression);
             if (!file.is_open())
                 return false;
 
@@ -135,19 +535,21 @@ namespace trading
                                           indicators.rsi.size(), indicators.macd.size()});
 
             // Write data
+            RowWriter out(file, scratch_resource());
             for (size_t i = 0; i < max_length; ++i)
             {
-                file << i << config.delimiter;
-                file << (i < indicators.sma_20.size() ? format_number(indicators.sma_20[i]) : "") << config.delimiter;
-                file << (i < indicators.sma_50.size() ? format_number(indicators.sma_50[i]) : "") << config.delimiter;
-                file << (i < indicators.ema_12.size() ? format_number(indicators.ema_12[i]) : "") << config.delimiter;
-                file << (i < indicators.ema_26.size() ? format_number(indicators.ema_26[i]) : "") << config.delimiter;
-                file << (i < indicators.rsi.size() ? format_number(indicators.rsi[i]) : "") << config.delimiter;
-                file << (i < indicators.macd.size() ? format_number(indicators.macd[i]) : "") << "\n";
+                out.integer(static_cast<int64_t>(i)).text(config.delimiter);
+                out.number_at(indicators.sma_20, i).text(config.delimiter);
+                out.number_at(indicators.sma_50, i).text(config.delimiter);
+                out.number_at(indicators.ema_12, i).text(config.delimiter);
+                out.number_at(indicators.ema_26, i).text(config.delimiter);
+                out.number_at(indicators.rsi, i).text(config.delimiter);
+                out.number_at(indicators.macd, i).text("\n");
+                out.end_row();
             }
+            out.flush();
 
-            file.close();
-            return true;
+            return file.close();
         }
 
         bool CSVExporter::export_chart_data(const std::vector<CandlestickPoint> &data,
@@ -157,8 +559,7 @@ namespace trading
             if (!validate_config(config))
                 return false;
 
-            std::string output_path = ExportUtils::get_output_path(config.filename);
-            std::ofstream file(output_path);
+            ExportStream file(text_output_path(config), config.compression);
             if (!file.is_open())
                 return false;
 
@@ -170,18 +571,20 @@ namespace trading
             }
 
             // Write candlestick data
+            RowWriter out(file, scratch_resource());
             for (const auto &point : data)
             {
-                file << format_timestamp(point.timestamp) << config.delimiter;
-                file << format_number(point.open) << config.delimiter;
-                file << format_number(point.high) << config.delimiter;
-                file << format_number(point.low) << config.delimiter;
-                file << format_number(point.close) << config.delimiter;
-                file << point.volume << "\n";
+                out.timestamp(point.timestamp).text(config.delimiter);
+                out.number(point.open).text(config.delimiter);
+                out.number(point.high).text(config.delimiter);
+                out.number(point.low).text(config.delimiter);
+                out.number(point.close).text(config.delimiter);
+                out.integer(point.volume).text("\n");
+                out.end_row();
             }
+            out.flush();
 
-            file.close();
-            return true;
+            return file.close();
         }
 
         bool CSVExporter::export_performance_data(const std::vector<ChartPoint> &pnl_data,
@@ -191,8 +594,7 @@ namespace trading
             if (!validate_config(config))
                 return false;
 
-            std::string output_path = ExportUtils::get_output_path(config.filename);
-            std::ofstream file(output_path);
+            ExportStream file(text_output_path(config), config.compression);
             if (!file.is_open())
                 return false;
 
@@ -207,15 +609,25 @@ namespace trading
             size_t max_length = std::max(pnl_data.size(), drawdown_data.size());
 
             // Write data
+            RowWriter out(file, scratch_resource());
             for (size_t i = 0; i < max_length; ++i)
             {
-                file << i << config.delimiter;
-                file << (i < pnl_data.size() ? format_number(pnl_data[i].y) : "") << config.delimiter;
-                file << (i < drawdown_data.size() ? format_number(drawdown_data[i].y) : "") << "\n";
+                out.integer(static_cast<int64_t>(i)).text(config.delimiter);
+                if (i < pnl_data.size())
+                {
+                    out.number(pnl_data[i].y);
+                }
+                out.text(config.delimiter);
+                if (i < drawdown_data.size())
+                {
+                    out.number(drawdown_data[i].y);
+                }
+                out.text("\n");
+                out.end_row();
             }
+            out.flush();
 
-            file.close();
-            return true;
+            return file.close();
         }
 
         bool CSVExporter::export_portfolio_data(const std::vector<std::pair<std::string, double>> &positions,
@@ -224,8 +636,7 @@ namespace trading
             if (!validate_config(config))
                 return false;
 
-            std::string output_path = ExportUtils::get_output_path(config.filename);
-            std::ofstream file(output_path);
+            ExportStream file(text_output_path(config), config.compression);
             if (!file.is_open())
                 return false;
 
@@ -243,13 +654,12 @@ namespace trading
                 file << format_number(position.second) << "\n";
             }
 
-            file.close();
-            return true;
+            return file.close();
         }
 
         bool CSVExporter::validate_config(const ExportConfig &config)
         {
-            return !config.filename.empty() && !config.delimiter.empty();
+            return !config.filename.empty() && !config.delimiter.empty() && compression_supported(config);
         }
 
         std::vector<ExportFormat> CSVExporter::supported_formats() const
@@ -281,20 +691,19 @@ namespace trading
 
         std::string CSVExporter::format_timestamp(const std::chrono::system_clock::time_point &timestamp)
         {
-            auto time_t = std::chrono::system_clock::to_time_t(timestamp);
-            std::ostringstream oss;
-            oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-            return oss.str();
+            std::string text;
+            TimestampFormatter().append(text, timestamp);
+            return text;
         }
 
         std::string CSVExporter::format_number(double value, int precision)
         {
-            std::ostringstream oss;
-            oss << std::fixed << std::setprecision(precision) << value;
-            return oss.str();
+            std::string text;
+            append_fixed(text, value, precision);
+            return text;
         }
 
-        void CSVExporter::write_headers(std::ofstream &file, const std::vector<std::string> &headers, const std::string &delimiter)
+        void CSVExporter::write_headers(std::ostream &file, const std::vector<std::string> &headers, const std::string &delimiter)
         {
             for (size_t i = 0; i < headers.size(); ++i)
             {
@@ -305,7 +714,7 @@ namespace trading
             file << "\n";
         }
 
-        void CSVExporter::write_metadata(std::ofstream &file, const std::map<std::string, std::string> &metadata)
+        void CSVExporter::write_metadata(std::ostream &file, const std::map<std::string, std::string> &metadata)
         {
             for (const auto &[key, value] : metadata)
             {
@@ -319,8 +728,7 @@ namespace trading
             if (!validate_config(config))
                 return false;
 
-            std::string output_path = ExportUtils::get_output_path(config.filename);
-            std::ofstream file(output_path);
+            ExportStream file(text_output_path(config), config.compression);
             if (!file.is_open())
                 return false;
 
@@ -332,19 +740,28 @@ namespace trading
             file << "  },\n";
             file << "  \"data\": [\n";
 
+            RowWriter out(file, scratch_resource());
+            const FormattedSeries *formatted = formatted_for(series);
             for (size_t i = 0; i < series.size(); ++i)
             {
                 const auto &point = series.data()[i];
-                file << "    " << serialize_market_data_point(point);
+                out.text("    {\n      \"timestamp\": \"").field(formatted, point, i, FormattedSeries::TIMESTAMP);
+                out.text("\",\n      \"open\": ").field(formatted, point, i, FormattedSeries::OPEN);
+                out.text(",\n      \"high\": ").field(formatted, point, i, FormattedSeries::HIGH);
+                out.text(",\n      \"low\": ").field(formatted, point, i, FormattedSeries::LOW);
+                out.text(",\n      \"close\": ").field(formatted, point, i, FormattedSeries::CLOSE);
+                out.text(",\n      \"volume\": ").field(formatted, point, i, FormattedSeries::VOLUME);
+                out.text("\n    }");
                 if (i < series.size() - 1)
-                    file << ",";
-                file << "\n";
+                    out.text(",");
+                out.text("\n");
+                out.end_row();
             }
+            out.flush();
 
             file << "  ]\n";
             file << "}";
-            file.close();
-            return true;
+            return file.close();
         }
 
         bool JSONExporter::export_indicators(const TechnicalIndicators &indicators, const ExportConfig &config)
@@ -352,44 +769,34 @@ namespace trading
             if (!validate_config(config))
                 return false;
 
-            std::string output_path = ExportUtils::get_output_path(config.filename);
-            std::ofstream file(output_path);
+            ExportStream file(text_output_path(config), config.compression);
             if (!file.is_open())
                 return false;
 
             file << "{\n";
             file << "  \"indicators\": {\n";
-            file << "    \"sma_20\": [";
-            for (size_t i = 0; i < indicators.sma_20.size(); ++i)
-            {
-                file << format_number(indicators.sma_20[i]);
-                if (i < indicators.sma_20.size() - 1)
-                    file << ", ";
-            }
-            file << "],\n";
-
-            file << "    \"sma_50\": [";
-            for (size_t i = 0; i < indicators.sma_50.size(); ++i)
-            {
-                file << format_number(indicators.sma_50[i]);
-                if (i < indicators.sma_50.size() - 1)
-                    file << ", ";
-            }
-            file << "],\n";
 
-            file << "    \"rsi\": [";
-            for (size_t i = 0; i < indicators.rsi.size(); ++i)
+            RowWriter out(file, scratch_resource());
+            auto write_array = [&](const char *name, const std::vector<double> &values, bool last)
             {
-                file << format_number(indicators.rsi[i]);
-                if (i < indicators.rsi.size() - 1)
-                    file << ", ";
-            }
-            file << "]\n";
+                out.text("    \"").text(name).text("\": [");
+                for (size_t i = 0; i < values.size(); ++i)
+                {
+                    out.number(values[i]);
+                    if (i < values.size() - 1)
+                        out.text(", ");
+                    out.end_row();
+                }
+                out.text(last ? "]\n" : "],\n");
+            };
+            write_array("sma_20", indicators.sma_20, false);
+            write_array("sma_50", indicators.sma_50, false);
+            write_array("rsi", indicators.rsi, true);
+            out.flush();
 
             file << "  }\n";
             file << "}";
-            file.close();
-            return true;
+            return file.close();
         }
 
         bool JSONExporter::export_chart_data(const std::vector<CandlestickPoint> &data,
@@ -399,52 +806,58 @@ namespace trading
             if (!validate_config(config))
                 return false;
 
-            std::string output_path = ExportUtils::get_output_path(config.filename);
-            std::ofstream file(output_path);
+            ExportStream file(text_output_path(config), config.compression);
             if (!file.is_open())
                 return false;
 
             file << "{\n";
             file << "  \"candlesticks\": [\n";
 
+            RowWriter out(file, scratch_resource());
             for (size_t i = 0; i < data.size(); ++i)
             {
-                file << "    " << serialize_candlestick_point(data[i]);
+                const auto &point = data[i];
+                out.text("    {\n      \"timestamp\": \"").timestamp(point.timestamp);
+                out.text("\",\n      \"open\": ").number(point.open);
+                out.text(",\n      \"high\": ").number(point.high);
+                out.text(",\n      \"low\": ").number(point.low);
+                out.text(",\n      \"close\": ").number(point.close);
+                out.text(",\n      \"volume\": ").integer(static_cast<int64_t>(point.volume));
+                out.text(",\n      \"is_green\": ").text(point.is_green ? "true" : "false");
+                out.text("\n    }");
                 if (i < data.size() - 1)
-                    file << ",";
-                file << "\n";
+                    out.text(",");
+                out.text("\n");
+                out.end_row();
             }
 
-            file << "  ],\n";
-            file << "  \"indicators\": [\n";
+            out.text("  ],\n");
+            out.text("  \"indicators\": [\n");
 
             for (size_t i = 0; i < indicators.size(); ++i)
             {
                 const auto &indicator = indicators[i];
-                file << "    {\n";
-                file << "      \"name\": \"" << indicator.name << "\",\n";
-                file << "      \"color\": \"" << indicator.color << "\",\n";
-                file << "      \"points\": [\n";
+                out.text("    {\n");
+                out.text("      \"name\": \"").text(indicator.name).text("\",\n");
+                out.text("      \"color\": \"").text(indicator.color).text("\",\n");
+                out.text("      \"points\": [\n");
 
                 for (size_t j = 0; j < indicator.points.size(); ++j)
                 {
-                    file << "        " << serialize_chart_point(indicator.points[j]);
-                    if (j < indicator.points.size() - 1)
-                        file << ",";
-                    file << "\n";
+                    write_chart_point(out, "        ", indicator.points[j], j < indicator.points.size() - 1);
                 }
 
-                file << "      ]\n";
-                file << "    }";
+                out.text("      ]\n");
+                out.text("    }");
                 if (i < indicators.size() - 1)
-                    file << ",";
-                file << "\n";
+                    out.text(",");
+                out.text("\n");
             }
+            out.flush();
 
             file << "  ]\n";
             file << "}";
-            file.close();
-            return true;
+            return file.close();
         }
 
         bool JSONExporter::export_performance_data(const std::vector<ChartPoint> &pnl_data,
@@ -454,34 +867,28 @@ namespace trading
             if (!validate_config(config))
                 return false;
 
-            std::string output_path = ExportUtils::get_output_path(config.filename);
-            std::ofstream file(output_path);
+            ExportStream file(text_output_path(config), config.compression);
             if (!file.is_open())
                 return false;
 
             file << "{\n";
-            file << "  \"pnl\": [\n";
+            RowWriter out(file, scratch_resource());
+            out.text("  \"pnl\": [\n");
             for (size_t i = 0; i < pnl_data.size(); ++i)
             {
-                file << "    " << serialize_chart_point(pnl_data[i]);
-                if (i < pnl_data.size() - 1)
-                    file << ",";
-                file << "\n";
+                write_chart_point(out, "    ", pnl_data[i], i < pnl_data.size() - 1);
             }
-            file << "  ],\n";
+            out.text("  ],\n");
 
-            file << "  \"drawdown\": [\n";
+            out.text("  \"drawdown\": [\n");
             for (size_t i = 0; i < drawdown_data.size(); ++i)
             {
-                file << "    " << serialize_chart_point(drawdown_data[i]);
-                if (i < drawdown_data.size() - 1)
-                    file << ",";
-                file << "\n";
+                write_chart_point(out, "    ", drawdown_data[i], i < drawdown_data.size() - 1);
             }
-            file << "  ]\n";
+            out.text("  ]\n");
+            out.flush();
             file << "}";
-            file.close();
-            return true;
+            return file.close();
         }
 
         bool JSONExporter::export_portfolio_data(const std::vector<std::pair<std::string, double>> &positions,
@@ -490,8 +897,7 @@ namespace trading
             if (!validate_config(config))
                 return false;
 
-            std::string output_path = ExportUtils::get_output_path(config.filename);
-            std::ofstream file(output_path);
+            ExportStream file(text_output_path(config), config.compression);
             if (!file.is_open())
                 return false;
 
@@ -512,13 +918,12 @@ namespace trading
 
             file << "  ]\n";
             file << "}";
-            file.close();
-            return true;
+            return file.close();
         }
 
         bool JSONExporter::validate_config(const ExportConfig &config)
         {
-            return !config.filename.empty();
+            return !config.filename.empty() && compression_supported(config);
         }
 
         std::vector<ExportFormat> JSONExporter::supported_formats() const
@@ -529,53 +934,16 @@ namespace trading
         // Helper methods for JSONExporter
         std::string JSONExporter::format_timestamp(const std::chrono::system_clock::time_point &timestamp)
         {
-            auto time_t = std::chrono::system_clock::to_time_t(timestamp);
-            std::ostringstream oss;
-            oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-            return oss.str();
+            std::string text;
+            TimestampFormatter().append(text, timestamp);
+            return text;
         }
 
         std::string JSONExporter::format_number(double value, int precision)
         {
-            std::ostringstream oss;
-            oss << std::fixed << std::setprecision(precision) << value;
-            return oss.str();
-        }
-
-        std::string JSONExporter::serialize_market_data_point(const MarketDataPoint &point)
-        {
-            std::ostringstream oss;
-            oss << "{\n";
-            oss << "      \"timestamp\": \"" << format_timestamp(point.timestamp) << "\",\n";
-            oss << "      \"open\": " << format_number(point.open) << ",\n";
-            oss << "      \"high\": " << format_number(point.high) << ",\n";
-            oss << "      \"low\": " << format_number(point.low) << ",\n";
-            oss << "      \"close\": " << format_number(point.close) << ",\n";
-            oss << "      \"volume\": " << point.volume << "\n";
-            oss << "    }";
-            return oss.str();
-        }
-
-        std::string JSONExporter::serialize_chart_point(const ChartPoint &point)
-        {
-            std::ostringstream oss;
-            oss << "{\"x\": " << point.x << ", \"y\": " << format_number(point.y) << "}";
-            return oss.str();
-        }
-
-        std::string JSONExporter::serialize_candlestick_point(const CandlestickPoint &point)
-        {
-            std::ostringstream oss;
-            oss << "{\n";
-            oss << "      \"timestamp\": \"" << format_timestamp(point.timestamp) << "\",\n";
-            oss << "      \"open\": " << format_number(point.open) << ",\n";
-            oss << "      \"high\": " << format_number(point.high) << ",\n";
-            oss << "      \"low\": " << format_number(point.low) << ",\n";
-            oss << "      \"close\": " << format_number(point.close) << ",\n";
-            oss << "      \"volume\": " << point.volume << ",\n";
-            oss << "      \"is_green\": " << (point.is_green ? "true" : "false") << "\n";
-            oss << "    }";
-            return oss.str();
+            std::string text;
+            append_fixed(text, value, precision);
+            return text;
         }
 
         // XMLExporter implementation (simplified)
@@ -584,8 +952,7 @@ namespace trading
             if (!validate_config(config))
                 return false;
 
-            std::string output_path = ExportUtils::get_output_path(config.filename);
-            std::ofstream file(output_path);
+            ExportStream file(text_output_path(config), config.compression);
             if (!file.is_open())
                 return false;
 
@@ -593,21 +960,25 @@ namespace trading
             file << "  <symbol>" << escape_xml(series.symbol()) << "</symbol>\n";
             file << "  <data_points>" << series.size() << "</data_points>\n";
 
-            for (const auto &point : series.data())
+            RowWriter out(file, scratch_resource());
+            const FormattedSeries *formatted = formatted_for(series);
+            for (size_t i = 0; i < series.size(); ++i)
             {
-                file << "  <point>\n";
-                file << "    <timestamp>" << format_timestamp(point.timestamp) << "</timestamp>\n";
-                file << "    <open>" << format_number(point.open) << "</open>\n";
-                file << "    <high>" << format_number(point.high) << "</high>\n";
-                file << "    <low>" << format_number(point.low) << "</low>\n";
-                file << "    <close>" << format_number(point.close) << "</close>\n";
-                file << "    <volume>" << point.volume << "</volume>\n";
-                file << "  </point>\n";
+                const auto &point = series.data()[i];
+                out.text("  <point>\n");
+                out.text("    <timestamp>").field(formatted, point, i, FormattedSeries::TIMESTAMP).text("</timestamp>\n");
+                out.text("    <open>").field(formatted, point, i, FormattedSeries::OPEN).text("</open>\n");
+                out.text("    <high>").field(formatted, point, i, FormattedSeries::HIGH).text("</high>\n");
+                out.text("    <low>").field(formatted, point, i, FormattedSeries::LOW).text("</low>\n");
+                out.text("    <close>").field(formatted, point, i, FormattedSeries::CLOSE).text("</close>\n");
+                out.text("    <volume>").field(formatted, point, i, FormattedSeries::VOLUME).text("</volume>\n");
+                out.text("  </point>\n");
+                out.end_row();
             }
+            out.flush();
 
             write_xml_footer(file, "market_data");
-            file.close();
-            return true;
+            return file.close();
         }
 
         bool XMLExporter::export_indicators(const TechnicalIndicators &indicators, const ExportConfig &config)
@@ -649,7 +1020,7 @@ namespace trading
 
         bool XMLExporter::validate_config(const ExportConfig &config)
         {
-            return !config.filename.empty();
+            return !config.filename.empty() && compression_supported(config);
         }
 
         std::vector<ExportFormat> XMLExporter::supported_formats() const
@@ -660,17 +1031,16 @@ namespace trading
         // Helper methods for XMLExporter
         std::string XMLExporter::format_timestamp(const std::chrono::system_clock::time_point &timestamp)
         {
-            auto time_t = std::chrono::system_clock::to_time_t(timestamp);
-            std::ostringstream oss;
-            oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-            return oss.str();
+            std::string text;
+            TimestampFormatter().append(text, timestamp);
+            return text;
         }
 
         std::string XMLExporter::format_number(double value, int precision)
         {
-            std::ostringstream oss;
-            oss << std::fixed << std::setprecision(precision) << value;
-            return oss.str();
+            std::string text;
+            append_fixed(text, value, precision);
+            return text;
         }
 
         std::string XMLExporter::escape_xml(const std::string &text)
@@ -698,13 +1068,13 @@ namespace trading
             return result;
         }
 
-        void XMLExporter::write_xml_header(std::ofstream &file, const std::string &root_element)
+        void XMLExporter::write_xml_header(std::ostream &file, const std::string &root_element)
         {
             file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
             file << "<" << root_element << ">\n";
         }
 
-        void XMLExporter::write_xml_footer(std::ofstream &file, const std::string &root_element)
+        void XMLExporter::write_xml_footer(std::ostream &file, const std::string &root_element)
         {
             file << "</" << root_element << ">\n";
         }
@@ -713,13 +1083,13 @@ namespace trading
         bool ExcelExporter::export_market_data(const MarketDataSeries &series, const ExportConfig &config)
         {
             // For now, just use CSV format
-            CSVExporter csv_exporter;
+            CSVExporter csv_exporter = csv_delegate();
             return csv_exporter.export_market_data(series, config);
         }
 
         bool ExcelExporter::export_indicators(const TechnicalIndicators &indicators, const ExportConfig &config)
         {
-            CSVExporter csv_exporter;
+            CSVExporter csv_exporter = csv_delegate();
             return csv_exporter.export_indicators(indicators, config);
         }
 
@@ -727,7 +1097,7 @@ namespace trading
                                               const std::vector<IndicatorOverlay> &indicators,
                                               const ExportConfig &config)
         {
-            CSVExporter csv_exporter;
+            CSVExporter csv_exporter = csv_delegate();
             return csv_exporter.export_chart_data(data, indicators, config);
         }
 
@@ -735,20 +1105,20 @@ namespace trading
                                                     const std::vector<ChartPoint> &drawdown_data,
                                                     const ExportConfig &config)
         {
-            CSVExporter csv_exporter;
+            CSVExporter csv_exporter = csv_delegate();
             return csv_exporter.export_performance_data(pnl_data, drawdown_data, config);
         }
 
         bool ExcelExporter::export_portfolio_data(const std::vector<std::pair<std::string, double>> &positions,
                                                   const ExportConfig &config)
         {
-            CSVExporter csv_exporter;
+            CSVExporter csv_exporter = csv_delegate();
             return csv_exporter.export_portfolio_data(positions, config);
         }
 
         bool ExcelExporter::validate_config(const ExportConfig &config)
         {
-            return !config.filename.empty();
+            return !config.filename.empty() && compression_supported(config);
         }
 
         std::vector<ExportFormat> ExcelExporter::supported_formats() const
@@ -759,34 +1129,115 @@ namespace trading
         // Helper methods for ExcelExporter
         std::string ExcelExporter::format_timestamp(const std::chrono::system_clock::time_point &timestamp)
         {
-            auto time_t = std::chrono::system_clock::to_time_t(timestamp);
-            std::ostringstream oss;
-            oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-            return oss.str();
+            std::string text;
+            TimestampFormatter().append(text, timestamp);
+            return text;
         }
 
         std::string ExcelExporter::format_number(double value, int precision)
         {
-            std::ostringstream oss;
-            oss << std::fixed << std::setprecision(precision) << value;
-            return oss.str();
+            std::string text;
+            append_fixed(text, value, precision);
+            return text;
+        }
+
+        CSVExporter ExcelExporter::csv_delegate() const
+        {
+            CSVExporter csv_exporter;
+            csv_exporter.set_scratch_resource(scratch_);
+            csv_exporter.set_formatted_series(formatted_);
+            return csv_exporter;
         }
 
-        void ExcelExporter::write_excel_header(std::ofstream &file)
+        void ExcelExporter::write_excel_header(std::ostream &file)
         {
             // Simplified Excel header
             file << "Excel Export\n";
         }
 
-        void ExcelExporter::write_excel_footer(std::ofstream &file)
+        void ExcelExporter::write_excel_footer(std::ostream &file)
         {
             // Simplified Excel footer
             file << "End of Export\n";
         }
 
+        // FormattedSeries implementation
+        FormattedSeries::FormattedSeries(const MarketDataSeries &series, ThreadPool *thread_pool)
+            : series_(&series), rows_(series.size()), chunks_((series.size() + kChunkRows - 1) / kChunkRows)
+        {
+            auto format_chunk = [this](size_t c)
+            {
+                Chunk &chunk = chunks_[c];
+                size_t first = c * kChunkRows;
+                size_t last = std::min(rows_, first + kChunkRows);
+                chunk.text.reserve((last - first) * 72);
+                chunk.row_start.reserve(last - first);
+                chunk.widths.reserve((last - first) * COLUMN_COUNT);
+                TimestampFormatter timestamps;
+                auto close_field = [&chunk](size_t field_start)
+                {
+                    chunk.widths.push_back(static_cast<uint16_t>(chunk.text.size() - field_start));
+                };
+                for (size_t i = first; i < last; ++i)
+                {
+                    const auto &point = series_->data()[i];
+                    size_t start = chunk.text.size();
+                    chunk.row_start.push_back(static_cast<uint32_t>(start));
+                    timestamps.append(chunk.text, point.timestamp);
+                    close_field(start);
+                    for (double value : {point.open, point.high, point.low, point.close})
+                    {
+                        start = chunk.text.size();
+                        append_fixed(chunk.text, value, 6);
+                        close_field(start);
+                    }
+                    start = chunk.text.size();
+                    append_integer(chunk.text, static_cast<int64_t>(point.volume));
+                    close_field(start);
+                }
+            };
+
+            if (thread_pool && chunks_.size() > 1)
+            {
+                thread_pool->parallel_for(0, chunks_.size(), format_chunk, 1);
+            }
+            else
+            {
+                for (size_t c = 0; c < chunks_.size(); ++c)
+                {
+                    format_chunk(c);
+                }
+            }
+        }
+
+        std::string_view FormattedSeries::field(size_t row, Column column) const
+        {
+            const Chunk &chunk = chunks_[row / kChunkRows];
+            size_t r = row % kChunkRows;
+            const uint16_t *widths = chunk.widths.data() + r * COLUMN_COUNT;
+            size_t start = chunk.row_start[r];
+            for (int c = 0; c < column; ++c)
+            {
+                start += widths[c];
+            }
+            return std::string_view(chunk.text.data() + start, widths[column]);
+        }
+
         // BatchExporter implementation
+        BatchExporter::BatchExporter(size_t scratch_bytes)
+            : scratch_bytes_(scratch_bytes)
+        {
+        }
+
+        BatchExporter::BatchExporter(std::shared_ptr<ThreadPool> thread_pool, size_t scratch_bytes)
+            : thread_pool_(std::move(thread_pool)), scratch_bytes_(scratch_bytes)
+        {
+        }
+
         void BatchExporter::add_exporter(std::unique_ptr<DataExporter> exporter)
         {
+            scratch_.push_back(std::make_unique<ScratchArena>(scratch_bytes_));
+            exporter->set_scratch_resource(scratch_.back().get());
             exporters_.push_back(std::move(exporter));
         }
 
@@ -795,88 +1246,139 @@ namespace trading
             export_configs_[name] = config;
         }
 
-        bool BatchExporter::export_market_data_batch(const MarketDataSeries &series)
+        namespace
         {
-            bool success = true;
-            for (auto &exporter : exporters_)
+            bool supports(const DataExporter &exporter, ExportFormat format)
             {
-                for (const auto &[name, config] : export_configs_)
-                {
-                    if (!exporter->export_market_data(series, config))
-                    {
-                        success = false;
-                    }
-                }
+                auto formats = exporter.supported_formats();
+                return std::find(formats.begin(), formats.end(), format) != formats.end();
+            }
+
+            bool is_text_format(ExportFormat format)
+            {
+                return format == ExportFormat::CSV || format == ExportFormat::JSON ||
+                       format == ExportFormat::XML || format == ExportFormat::EXCEL;
             }
-            return success;
         }
 
-        bool BatchExporter::export_indicators_batch(const TechnicalIndicators &indicators)
+        template <typename Export>
+        bool BatchExporter::run_exports(Export &&export_one)
         {
-            bool success = true;
-            for (auto &exporter : exporters_)
+            std::vector<const std::pair<const std::string, ExportConfig> *> configs;
+            for (const auto &entry : export_configs_)
             {
-                for (const auto &[name, config] : export_configs_)
+                configs.push_back(&entry);
+            }
+
+            // results[e][c]: exporter e on configuration c (char, not a racy vector<bool>)
+            enum : char
+            {
+                FAILED,
+                EXPORTED,
+                NOT_APPLICABLE
+            };
+            std::vector<std::vector<char>> results(exporters_.size(), std::vector<char>(configs.size(), NOT_APPLICABLE));
+            auto run_exporter = [&](size_t e)
+            {
+                for (size_t c = 0; c < configs.size(); ++c)
                 {
-                    if (!exporter->export_indicators(indicators, config))
+                    if (supports(*exporters_[e], configs[c]->second.format))
                     {
-                        success = false;
+                        results[e][c] = export_one(*exporters_[e], configs[c]->second) ? EXPORTED : FAILED;
+                        scratch_[e]->reset();
                     }
                 }
+            };
+            if (thread_pool_ && exporters_.size() > 1)
+            {
+                thread_pool_->parallel_for(0, exporters_.size(), run_exporter, 1);
             }
-            return success;
-        }
-
-        bool BatchExporter::export_chart_data_batch(const std::vector<CandlestickPoint> &data,
-                                                    const std::vector<IndicatorOverlay> &indicators)
-        {
-            bool success = true;
-            for (auto &exporter : exporters_)
+            else
             {
-                for (const auto &[name, config] : export_configs_)
+                for (size_t e = 0; e < exporters_.size(); ++e)
                 {
-                    if (!exporter->export_chart_data(data, indicators, config))
-                    {
-                        success = false;
-                    }
+                    run_exporter(e);
                 }
             }
-            return success;
-        }
 
-        bool BatchExporter::export_performance_data_batch(const std::vector<ChartPoint> &pnl_data,
-                                                          const std::vector<ChartPoint> &drawdown_data)
-        {
+            // A configuration succeeds if some exporter handled it and none failed
             bool success = true;
-            for (auto &exporter : exporters_)
+            export_status_.clear();
+            for (size_t c = 0; c < configs.size(); ++c)
             {
-                for (const auto &[name, config] : export_configs_)
+                bool exported = false;
+                bool failed = false;
+                for (size_t e = 0; e < exporters_.size(); ++e)
                 {
-                    if (!exporter->export_performance_data(pnl_data, drawdown_data, config))
-                    {
-                        success = false;
-                    }
+                    exported = exported || results[e][c] == EXPORTED;
+                    failed = failed || results[e][c] == FAILED;
                 }
+                export_status_[configs[c]->first] = exported && !failed;
+                success = success && exported && !failed;
             }
             return success;
         }
 
-        bool BatchExporter::export_portfolio_data_batch(const std::vector<std::pair<std::string, double>> &positions)
+        bool BatchExporter::export_market_data_batch(const MarketDataSeries &series)
         {
-            bool success = true;
-            for (auto &exporter : exporters_)
+            // Text formats copy their fields from one shared formatting pass
+            size_t text_exports = 0;
+            for (const auto &exporter : exporters_)
             {
                 for (const auto &[name, config] : export_configs_)
                 {
-                    if (!exporter->export_portfolio_data(positions, config))
+                    if (is_text_format(config.format) && supports(*exporter, config.format))
                     {
-                        success = false;
+                        ++text_exports;
                     }
                 }
             }
+            std::unique_ptr<FormattedSeries> formatted;
+            if (text_exports > 1)
+            {
+                formatted = std::make_unique<FormattedSeries>(series, thread_pool_.get());
+            }
+            for (auto &exporter : exporters_)
+            {
+                exporter->set_formatted_series(formatted.get());
+            }
+
+            bool success = run_exports([&](DataExporter &exporter, const ExportConfig &config)
+                                       { return exporter.export_market_data(series, config); });
+
+            for (auto &exporter : exporters_)
+            {
+                exporter->set_formatted_series(nullptr);
+            }
             return success;
         }
 
+        bool BatchExporter::export_indicators_batch(const TechnicalIndicators &indicators)
+        {
+            return run_exports([&](DataExporter &exporter, const ExportConfig &config)
+                               { return exporter.export_indicators(indicators, config); });
+        }
+
+        bool BatchExporter::export_chart_data_batch(const std::vector<CandlestickPoint> &data,
+                                                    const std::vector<IndicatorOverlay> &indicators)
+        {
+            return run_exports([&](DataExporter &exporter, const ExportConfig &config)
+                               { return exporter.export_chart_data(data, indicators, config); });
+        }
+
+        bool BatchExporter::export_performance_data_batch(const std::vector<ChartPoint> &pnl_data,
+                                                          const std::vector<ChartPoint> &drawdown_data)
+        {
+            return run_exports([&](DataExporter &exporter, const ExportConfig &config)
+                               { return exporter.export_performance_data(pnl_data, drawdown_data, config); });
+        }
+
+        bool BatchExporter::export_portfolio_data_batch(const std::vector<std::pair<std::string, double>> &positions)
+        {
+            return run_exports([&](DataExporter &exporter, const ExportConfig &config)
+                               { return exporter.export_portfolio_data(positions, config); });
+        }
+
         void BatchExporter::clear_configs()
         {
             export_configs_.clear();
@@ -884,13 +1386,7 @@ namespace trading
 
         std::map<std::string, bool> BatchExporter::get_export_status() const
         {
-            // Simplified implementation
-            std::map<std::string, bool> status;
-            for (const auto &[name, config] : export_configs_)
-            {
-                status[name] = true; // Assume success for demo
-            }
-            return status;
+            return export_status_;
         }
 
         // ExportUtils implementation
@@ -965,8 +1461,24 @@ namespace trading
 
         bool ExportUtils::compress_file(const std::string &input_file, const std::string &output_file)
         {
-            // Simplified implementation - would use compression library in real implementation
+#ifdef HAVE_ZLIB
+            std::ifstream input(input_file, std::ios::binary);
+            if (!input.is_open())
+                return false;
+            ExportStream output(output_file, ExportCompression::GZIP);
+            if (!output.is_open())
+                return false;
+
+            std::vector<char> block(OutputFileBuffer::kBufferBytes);
+            while (input)
+            {
+                input.read(block.data(), static_cast<std::streamsize>(block.size()));
+                output.write(block.data(), input.gcount());
+            }
+            return !input.bad() && output.close();
+#else
             return false;
+#endif
         }
 
         std::string ExportUtils::format_file_size(size_t bytes)
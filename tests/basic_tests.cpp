@@ -2,11 +2,71 @@
 #include <cassert>
 #include <thread>
 #include <chrono>
+#include <cmath>
+#include <atomic>
+#include <cstring>
+#include <numeric>
+#include <algorithm>
+#include <memory>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory_resource>
+#include <iterator>
+#include <sstream>
+#include <iomanip>
+#include <ctime>
+#include <random>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
 
 // Include our core components
 #include "core/thread_pool.h"
 #include "core/memory_pool.h"
 #include "core/lock_free_queue.h"
+#include "core/mpmc_queue.h"
+#include "core/arena.h"
+#include "core/metrics.h"
+
+// Include data components
+#include "data/columnar_series.h"
+#include "data/data_processor.h"
+#include "data/incremental_indicators.h"
+#include "data/indicator_pipeline.h"
+#include "data/simd_kernels.h"
+#include "data/columnar_file.h"
+#include "data/cache_manager.h"
+#include "data/indicator_cache.h"
+#include "data/rate_limiter.h"
+#include "data/order_book.h"
+#include "data/chart_parser.h"
+#include "data/yahoo_finance.h"
+#include "data/universe_panel.h"
+#include "data/chunked_reader.h"
+
+// Include strategy components
+#include "strategies/backtest_engine.h"
+#include "strategies/parameter_sweep.h"
+#include "strategies/sma_crossover.h"
+
+// Include analytics components
+#include "analytics/monte_carlo.h"
+#include "analytics/portfolio_analytics.h"
+
+// Include visualization components
+#include "visualization/data_export.h"
+#include "visualization/columnar_export.h"
+#include "visualization/chart_lod.h"
+#include "visualization/dashboard.h"
 
 using namespace trading;
 
@@ -26,6 +86,194 @@ void test_thread_pool_basic()
     std::cout << "ThreadPool basic test passed!" << std::endl;
 }
 
+void test_thread_pool_work_stealing_basic()
+{
+    std::cout << "Testing ThreadPool work stealing..." << std::endl;
+
+    // Small callables are stored inline in the Task
+    auto small = [p = static_cast<int *>(nullptr), q = size_t{0}]()
+    { (void)p, (void)q; };
+    static_assert(Task::fits_inline<decltype(small)>());
+    assert(sizeof(Task) == 64);
+
+    ThreadPool pool(3);
+
+    // Move-only callables and arguments
+    auto owned = std::make_unique<int>(7);
+    auto doubled = pool.submit([value = std::move(owned)](int factor)
+                               { return *value * factor; },
+                               2);
+    assert(doubled.get() == 14);
+
+    // Batch submission keeps index order in the futures
+    auto squares = pool.submit_batch(100, [](size_t i)
+                                     { return i * i; });
+    for (size_t i = 0; i < squares.size(); ++i)
+    {
+        assert(squares[i].get() == i * i);
+    }
+
+    // parallel_for covers every index exactly once, also when nested
+    std::vector<std::atomic<int>> hits(10000);
+    pool.parallel_for(0, hits.size(), [&](size_t i)
+                      { hits[i]++; });
+    assert(std::all_of(hits.begin(), hits.end(), [](const std::atomic<int> &h)
+                       { return h == 1; }));
+
+    auto nested = pool.submit([&]()
+                              {
+        std::atomic<size_t> sum{0};
+        pool.parallel_for(0, 1000, [&](size_t i) { sum += i; }, 10);
+        return sum.load(); });
+    assert(nested.get() == 499500);
+
+    // Exceptions reach the future or the parallel_for caller
+    auto failing = pool.submit([]() -> int
+                               { throw std::runtime_error("task failed"); });
+    bool threw = false;
+    try
+    {
+        failing.get();
+    }
+    catch (const std::runtime_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try
+    {
+        pool.parallel_for(0, 100, [](size_t i)
+                          { if (i == 42) throw std::runtime_error("chunk failed"); });
+    }
+    catch (const std::runtime_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    // wait_all covers tasks that submit more tasks
+    std::atomic<int> done{0};
+    for (int i = 0; i < 50; ++i)
+    {
+        pool.submit([&]()
+                    {
+            done++;
+            pool.submit([&]() { done++; }); });
+    }
+    pool.wait_all();
+    assert(done == 100 && pool.pending_tasks() == 0);
+
+    pool.shutdown();
+    threw = false;
+    try
+    {
+        pool.submit([]() {});
+    }
+    catch (const std::runtime_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "ThreadPool work stealing test passed!" << std::endl;
+}
+
+void test_thread_pool_priority_basic()
+{
+    std::cout << "Testing ThreadPool priority lanes..." << std::endl;
+
+    ThreadPoolConfig config;
+    config.num_threads = 2;
+    config.num_background_threads = 1;
+    config.affinity = AffinityMode::CORE;
+    ThreadPool pool(config);
+    assert(pool.thread_count() == 2 && pool.background_thread_count() == 1);
+    assert(pool.worker_index() == ThreadPool::npos);
+
+    // Background tasks run on their own thread
+    auto lane = pool.submit_background([&]()
+                                       { return pool.worker_index(); });
+    assert(lane.get() == ThreadPool::npos);
+    assert(pool.submit([&]()
+                       { return pool.worker_index(); })
+               .get() < 2);
+
+    // A stalled background task does not hold up normal work
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    auto stalled = pool.submit_background([gate]()
+                                          { gate.wait(); });
+    assert(pool.submit([]()
+                       { return 5; })
+               .get() == 5);
+    release.set_value();
+    stalled.get();
+
+    // on_each_worker visits every worker exactly once
+    std::vector<std::atomic<int>> visits(pool.thread_count());
+    pool.on_each_worker([&](size_t worker)
+                        {
+        assert(pool.worker_index() == worker);
+        visits[worker]++; });
+    assert(visits[0] == 1 && visits[1] == 1);
+
+    // Two workers calling it at once each serve the other's pinned task
+    std::atomic<int> arrived{0};
+    std::atomic<int> calls{0};
+    auto concurrent = [&]()
+    {
+        arrived++;
+        while (arrived.load() < 2)
+        {
+            std::this_thread::yield();
+        }
+        pool.on_each_worker([&](size_t)
+                            { calls++; });
+    };
+    auto first_caller = pool.submit(concurrent);
+    auto second_caller = pool.submit(concurrent);
+    first_caller.get();
+    second_caller.get();
+    assert(calls == 4);
+    assert(pool.worker_numa_node(0) >= -1 && pool.worker_numa_node(5) == -1);
+    pool.wait_all();
+
+    // Without background threads, workers take background work last
+    ThreadPool shared(1);
+    std::promise<void> start;
+    std::shared_future<void> started = start.get_future().share();
+    std::vector<char> order;
+    std::mutex order_mutex;
+    auto record = [&](char c)
+    {
+        std::lock_guard<std::mutex> lock(order_mutex);
+        order.push_back(c);
+    };
+    shared.submit([started]()
+                  { started.wait(); });
+    auto background = shared.submit_background([&]()
+                                               { record('B'); });
+    auto normal = shared.submit([&]()
+                                { record('N'); });
+    start.set_value();
+    background.get();
+    normal.get();
+    assert(order.size() == 2 && order[0] == 'N' && order[1] == 'B');
+
+    // NUMA placement falls back to a single node without topology info
+    ThreadPoolConfig numa;
+    numa.num_threads = 2;
+    numa.affinity = AffinityMode::NUMA_NODE;
+    ThreadPool placed(numa);
+    assert(placed.submit([]()
+                         { return 1; })
+               .get() == 1);
+
+    std::cout << "ThreadPool priority lanes test passed!" << std::endl;
+}
+
 void test_memory_pool_basic()
 {
     std::cout << "Testing MemoryPool basic functionality..." << std::endl;
@@ -43,7 +291,7 @@ void test_memory_pool_basic()
 
     assert(*ptr1 == 100);
     assert(*ptr2 == 200);
-    assert(pool.allocated_blocks() == 2);
+    assert(pool.allocated_blocks() == 2 && pool.outstanding_blocks() >= 2);
 
     pool.deallocate(ptr1);
     pool.deallocate(ptr2);
@@ -53,6 +301,130 @@ void test_memory_pool_basic()
     std::cout << "MemoryPool basic test passed!" << std::endl;
 }
 
+void test_memory_pool_size_classes_basic()
+{
+    std::cout << "Testing MemoryPool size classes..." << std::endl;
+
+    // Every request fits its class, and classes round-trip
+    for (size_t bytes = 1; bytes <= PoolResource::kMaxPooledSize; ++bytes)
+    {
+        size_t index = PoolResource::size_class(bytes);
+        assert(index < PoolResource::kNumClasses);
+        assert(PoolResource::class_size(index) >= bytes);
+        assert(index == 0 || PoolResource::class_size(index - 1) < bytes);
+    }
+    assert(PoolResource::class_size(PoolResource::kNumClasses - 1) == PoolResource::kMaxPooledSize);
+
+    // O(1) ownership: foreign pointers and double frees are ignored
+    MemoryPool pool(24, 4);
+    assert(pool.block_size() >= 24);
+    void *block = pool.allocate();
+    assert(reinterpret_cast<uintptr_t>(block) % MemoryPool::kAlignment == 0);
+    assert(pool.owns(block) && pool.allocated_blocks() == 1);
+    auto foreign = std::make_unique<char[]>(64);
+    assert(!pool.owns(foreign.get() + 16));
+    pool.deallocate(foreign.get() + 16);
+    pool.deallocate(block);
+    pool.deallocate(block);
+    assert(!pool.owns(block) && pool.allocated_blocks() == 0);
+
+    // Blocks freed on other threads than the one that allocated them
+    std::vector<void *> blocks(1000);
+    std::thread producer([&]()
+                         {
+        for (auto &b : blocks)
+        {
+            b = pool.allocate();
+        } });
+    producer.join();
+    assert(pool.allocated_blocks() == blocks.size());
+
+    std::vector<std::thread> consumers;
+    for (size_t t = 0; t < 4; ++t)
+    {
+        consumers.emplace_back([&, t]()
+                               {
+            for (size_t i = t; i < blocks.size(); i += 4)
+            {
+                pool.deallocate(blocks[i]);
+            }
+            // Churn on top of it
+            for (int i = 0; i < 1000; ++i)
+            {
+                pool.deallocate(pool.allocate());
+            } });
+    }
+    for (auto &consumer : consumers)
+    {
+        consumer.join();
+    }
+    assert(pool.allocated_blocks() == 0 && pool.free_blocks() == pool.total_blocks());
+
+    // More pools than a cache set has ways, used in turn on one thread:
+    // pools without a way go through the depot and counts stay exact
+    std::vector<std::unique_ptr<MemoryPool>> crowd;
+    for (int i = 0; i < 100; ++i)
+    {
+        crowd.push_back(std::make_unique<MemoryPool>(32, 4));
+    }
+    std::vector<void *> held;
+    for (int round = 0; round < 3; ++round)
+    {
+        for (auto &member : crowd)
+        {
+            held.push_back(member->allocate());
+        }
+    }
+    for (auto &member : crowd)
+    {
+        assert(member->allocated_blocks() == 3 && member->outstanding_blocks() >= 3);
+    }
+    for (size_t i = 0; i < held.size(); ++i)
+    {
+        crowd[i % crowd.size()]->deallocate(held[i]);
+    }
+    for (auto &member : crowd)
+    {
+        assert(member->allocated_blocks() == 0);
+        assert(member->outstanding_blocks() <= member->total_blocks());
+    }
+
+    // Standard and pmr containers on one resource
+    PoolResource resource;
+    {
+        std::vector<double, PoolAllocator<double>> prices{PoolAllocator<double>(resource)};
+        for (int i = 0; i < 10000; ++i)
+        {
+            prices.push_back(i * 0.5);
+        }
+        assert(prices.back() == 4999.5);
+
+        std::map<int, std::string, std::less<int>, PoolAllocator<std::pair<const int, std::string>>> orders{
+            PoolAllocator<std::pair<const int, std::string>>(resource)};
+        for (int i = 0; i < 500; ++i)
+        {
+            orders.emplace(i, "order");
+        }
+        assert(orders.size() == 500);
+
+        std::pmr::vector<int> sizes(&resource);
+        sizes.assign(100, 7);
+        assert(std::accumulate(sizes.begin(), sizes.end(), 0) == 700);
+
+        PoolAllocator<int> ints(resource);
+        PoolAllocator<double> doubles(ints);
+        assert(ints == doubles);
+        PoolResource other;
+        assert(!(ints == PoolAllocator<int>(other)));
+    }
+    for (size_t i = 0; i < PoolResource::kNumClasses; ++i)
+    {
+        assert(resource.pool(i).allocated_blocks() == 0);
+    }
+
+    std::cout << "MemoryPool size classes test passed!" << std::endl;
+}
+
 void test_lock_free_queue_basic()
 {
     std::cout << "Testing LockFreeQueue basic functionality..." << std::endl;
@@ -74,6 +446,2620 @@ void test_lock_free_queue_basic()
     std::cout << "LockFreeQueue basic test passed!" << std::endl;
 }
 
+void test_queue_bulk_basic()
+{
+    std::cout << "Testing queue bulk operations..." << std::endl;
+
+    // SPSC: bulk calls stop at the capacity and keep FIFO order across the wrap
+    LockFreeQueue<int> spsc(8);
+    std::vector<int> in(12), out(12, -1);
+    std::iota(in.begin(), in.end(), 0);
+    assert(spsc.try_push_bulk(std::span<int>(in).subspan(0, 5)) == 5);
+    assert(spsc.try_pop_bulk(std::span<int>(out).subspan(0, 3)) == 3);
+    assert(out[0] == 0 && out[2] == 2);
+    assert(spsc.try_push_bulk(std::span<int>(in).subspan(5)) == 6);
+    assert(spsc.full());
+    assert(spsc.try_pop_bulk(out) == 8);
+    for (int i = 0; i < 8; ++i)
+    {
+        assert(out[i] == i + 3);
+    }
+    assert(spsc.empty());
+
+    // MPMC: same contract single-threaded
+    MpmcQueue<int> mpmc(4);
+    assert(mpmc.try_push_bulk(in) == 4);
+    assert(!mpmc.try_push(99));
+    int value = -1;
+    assert(mpmc.try_pop(value) && value == 0);
+    assert(mpmc.try_pop_bulk(out) == 3);
+    assert(out[0] == 1 && out[2] == 3);
+    assert(!mpmc.try_pop(value));
+
+    // MPMC: producers and consumers mixing single and bulk calls see every element once
+    MpmcQueue<int> shared(64);
+    const int producers = 2, consumers = 2, per_producer = 20000;
+    std::atomic<long long> sum{0};
+    std::atomic<int> popped{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&, p]()
+                             {
+            std::vector<int> batch(4);
+            int i = 0;
+            while (i < per_producer)
+            {
+                if (i % 8 == 0 && i + 4 <= per_producer)
+                {
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        batch[k] = p * per_producer + i + k + 1;
+                    }
+                    size_t pushed = 0;
+                    while (pushed < 4)
+                    {
+                        size_t n = shared.try_push_bulk(std::span<int>(batch).subspan(pushed));
+                        if (n == 0)
+                        {
+                            std::this_thread::yield();
+                        }
+                        pushed += n;
+                    }
+                    i += 4;
+                }
+                else if (shared.try_push(p * per_producer + i + 1))
+                {
+                    ++i;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            } });
+    }
+    for (int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&, c]()
+                             {
+            std::vector<int> batch(3);
+            while (popped.load() < producers * per_producer)
+            {
+                size_t n = 0;
+                if (c == 0)
+                {
+                    n = shared.try_pop_bulk(batch);
+                }
+                else if (shared.try_pop(batch[0]))
+                {
+                    n = 1;
+                }
+                if (n == 0)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (size_t k = 0; k < n; ++k)
+                {
+                    sum += batch[k];
+                }
+                popped += static_cast<int>(n);
+            } });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    const long long total = static_cast<long long>(producers) * per_producer;
+    assert(popped.load() == total);
+    assert(sum.load() == total * (total + 1) / 2);
+    assert(shared.empty());
+
+    std::cout << "Queue bulk operations test passed!" << std::endl;
+}
+
+void test_queue_wait_strategies_basic()
+{
+    std::cout << "Testing queue wait strategies..." << std::endl;
+
+    // Parking on both sides: a tiny queue forces producer and consumer to take turns sleeping
+    {
+        LockFreeQueue<int, ParkingWait> queue(2);
+        const int count = 2000;
+        long long sum = 0;
+        std::thread consumer([&]()
+                             {
+            for (int i = 0; i < count; ++i)
+            {
+                int value = 0;
+                bool popped = queue.pop(value);
+                assert(popped);
+                assert(value == i + 1);
+                sum += value;
+            } });
+        for (int i = 0; i < count; ++i)
+        {
+            queue.push(i + 1);
+        }
+        consumer.join();
+        assert(sum == static_cast<long long>(count) * (count + 1) / 2);
+        assert(queue.empty());
+    }
+
+    // A parked consumer returns false once stopped and woken
+    {
+        LockFreeQueue<int, ParkingWait> queue(8);
+        std::atomic<bool> stop{false};
+        std::atomic<bool> returned{false};
+        bool got = true;
+        std::thread consumer([&]()
+                             {
+            int value = 0;
+            got = queue.pop(value, &stop);
+            returned = true; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        assert(!returned.load());
+        stop = true;
+        queue.wake_all();
+        consumer.join();
+        assert(!got);
+    }
+
+    // Spin-then-yield MPMC: blocking bulk pops drain everything before honouring stop
+    {
+        MpmcQueue<int, SpinThenYieldWait> queue(16);
+        const int producers = 2, per_producer = 5000;
+        std::atomic<bool> stop{false};
+        std::atomic<long long> sum{0};
+        std::vector<std::thread> threads;
+        for (int c = 0; c < 2; ++c)
+        {
+            threads.emplace_back([&]()
+                                 {
+                std::vector<int> batch(8);
+                size_t n;
+                while ((n = queue.pop_bulk(batch, &stop)) > 0)
+                {
+                    for (size_t k = 0; k < n; ++k)
+                    {
+                        sum += batch[k];
+                    }
+                } });
+        }
+        std::vector<std::thread> feeds;
+        for (int p = 0; p < producers; ++p)
+        {
+            feeds.emplace_back([&, p]()
+                               {
+                for (int i = 0; i < per_producer; ++i)
+                {
+                    queue.push(p * per_producer + i + 1);
+                } });
+        }
+        for (auto &feed : feeds)
+        {
+            feed.join();
+        }
+        stop = true;
+        queue.wake_all();
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        const long long total = static_cast<long long>(producers) * per_producer;
+        assert(sum.load() == total * (total + 1) / 2);
+        assert(queue.empty());
+    }
+
+    std::cout << "Queue wait strategies test passed!" << std::endl;
+}
+
+// Buys on the first bar and sells on the third
+class BuyThenSellStrategy : public Strategy
+{
+public:
+    size_t fills = 0;
+
+    void on_bar(const MarketDataPoint &, StrategyContext &context) override
+    {
+        if (context.bar_index() == 0)
+        {
+            context.submit_order(OrderSide::BUY, 10);
+        }
+        else if (context.bar_index() == 2)
+        {
+            context.submit_order(OrderSide::SELL, 10);
+        }
+    }
+
+    void on_fill(const Fill &, StrategyContext &) override { ++fills; }
+
+    std::string name() const override { return "BuyThenSell"; }
+};
+
+// Element-wise equality where NaN warm-up values compare equal
+static bool same_values(const std::vector<double> &a, const std::vector<double> &b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (!(a[i] == b[i] || (std::isnan(a[i]) && std::isnan(b[i]))))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_columnar_series_basic()
+{
+    std::cout << "Testing ColumnarSeries basic functionality..." << std::endl;
+
+    MarketDataSeries series("TEST");
+    auto t0 = std::chrono::system_clock::now();
+    for (int i = 0; i < 120; ++i)
+    {
+        double close = 100.0 + 5.0 * std::sin(0.1 * i) + 0.05 * i;
+        series.add_point(MarketDataPoint(t0 + std::chrono::minutes(i), close - 0.2, close + 0.5,
+                                         close - 0.6, close, 1000 + 10 * i));
+    }
+
+    // AoS -> SoA -> AoS round trip is lossless
+    auto columnar = ColumnarSeries::from_series(series);
+    assert(columnar.size() == series.size());
+    assert(columnar.symbol() == "TEST");
+    auto restored = columnar.to_series();
+    for (size_t i = 0; i < series.size(); ++i)
+    {
+        assert(restored[i].timestamp == series[i].timestamp);
+        assert(restored[i].close == series[i].close);
+        assert(restored[i].volume == series[i].volume);
+    }
+
+    // Views are zero-copy and slice without touching the data
+    ColumnarSeriesView view = columnar;
+    assert(view.close.data() == columnar.close().data());
+    auto tail = view.slice(100, 20);
+    assert(tail.size() == 20);
+    assert(tail.close[0] == series[100].close);
+
+    // Columnar indicators match the AoS path exactly
+    DataProcessor processor;
+    auto aos = processor.calculate_indicators(series);
+    auto soa = processor.calculate_indicators(view);
+    assert(same_values(aos.sma_20, soa.sma_20));
+    assert(same_values(aos.ema_26, soa.ema_26));
+    assert(same_values(aos.rsi, soa.rsi));
+    assert(same_values(aos.macd_signal, soa.macd_signal));
+    assert(same_values(aos.bollinger_upper, soa.bollinger_upper));
+    assert(same_values(aos.volume_sma, soa.volume_sma));
+
+    auto cleaned = processor.clean_data(view);
+    assert(cleaned.size() == processor.clean_data(series).size());
+
+    std::cout << "ColumnarSeries basic test passed!" << std::endl;
+}
+
+// Allocates a few pmr temporaries from the engine's scratch memory every bar
+class ScratchStrategy : public Strategy
+{
+public:
+    std::pmr::memory_resource *seen = nullptr;
+    double total = 0.0;
+
+    void on_bar(const MarketDataPoint &bar, StrategyContext &context) override
+    {
+        seen = context.scratch();
+        std::pmr::vector<double> window(64, bar.close, context.scratch());
+        std::pmr::string note("bar scratch that does not fit the small-string buffer", context.scratch());
+        total += window.back() + static_cast<double>(note.size());
+    }
+
+    std::string name() const override { return "Scratch"; }
+};
+
+void test_clean_data_chunked_basic()
+{
+    std::cout << "Testing chunked clean_data..." << std::endl;
+
+    // Three and a bit chunks, with spikes and broken bars spread across them
+    const size_t n = 3 * DataProcessor::kCleanChunkPoints + 123;
+    auto t0 = std::chrono::system_clock::now();
+    std::vector<MarketDataPoint> bars;
+    for (size_t i = 0; i < n; ++i)
+    {
+        double close = 100.0 + 5.0 * std::sin(0.001 * i);
+        bars.emplace_back(t0 + std::chrono::minutes(i), close - 0.2, close + 0.5, close - 0.6, close, 1000);
+    }
+    const std::vector<size_t> spikes = {17, 70000, 140001, n - 1};
+    for (size_t i : spikes)
+    {
+        bars[i].close = 1000.0;
+    }
+    bars[0].open = std::nan("");              // nothing to fill from yet: dropped
+    bars[5000].close = std::nan("");          // filled from the previous close
+    bars[80000].high = bars[80000].low - 1.0; // high < low: dropped
+    bars[90000].volume = -1;                  // negative volume: dropped
+    bars[150000].timestamp = t0;              // goes back in time: dropped
+    MarketDataSeries series("DIRTY");
+    for (const auto &bar : bars)
+    {
+        series.add_point(bar);
+    }
+
+    // Chunk statistics merge to the plain mean and deviation of the finite closes
+    std::vector<double> closes;
+    double mean = 0.0;
+    for (const auto &bar : bars)
+    {
+        closes.push_back(bar.close);
+        mean += std::isfinite(bar.close) ? bar.close : 0.0;
+    }
+    mean /= (n - 1);
+    double variance = 0.0;
+    for (double close : closes)
+    {
+        variance += std::isfinite(close) ? (close - mean) * (close - mean) : 0.0;
+    }
+    double std_dev = std::sqrt(variance / (n - 1));
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (std::abs(closes[i] - mean) / std_dev > 3.0)
+        {
+            expected.push_back(i);
+        }
+    }
+    DataProcessor serial;
+    assert(expected == spikes);
+    assert(serial.detect_outliers(closes, 3.0) == spikes);
+
+    // The pool only changes who computes each chunk, not the result
+    DataProcessor pooled;
+    pooled.set_thread_pool(std::make_shared<ThreadPool>(2));
+    assert(pooled.detect_outliers(closes, 3.0) == spikes);
+
+    auto cleaned = serial.clean_data(series);
+    auto cleaned_pooled = pooled.clean_data(series);
+    assert(cleaned.size() == n - spikes.size() - 4);
+    assert(cleaned.size() == cleaned_pooled.size());
+    assert(cleaned.is_valid());
+    for (size_t i = 0; i < cleaned.size(); ++i)
+    {
+        assert(cleaned[i].close == cleaned_pooled[i].close && cleaned[i].close < 1000.0);
+    }
+    assert(cleaned[0].timestamp == bars[1].timestamp);
+    assert(cleaned[4999 - 2].close == bars[4999].close && cleaned[5000 - 2].close == bars[4999].close);
+
+    // The columnar path keeps the same bars
+    auto columnar = ColumnarSeries::from_series(series);
+    auto cleaned_columnar = pooled.clean_data(columnar.view());
+    assert(cleaned_columnar.size() == cleaned.size());
+    auto expected_columnar = ColumnarSeries::from_series(cleaned);
+    assert(std::equal(cleaned_columnar.close().begin(), cleaned_columnar.close().end(),
+                      expected_columnar.close().begin()));
+
+    std::cout << "Chunked clean_data test passed!" << std::endl;
+}
+
+void test_scratch_arena_basic()
+{
+    std::cout << "Testing ScratchArena basic functionality..." << std::endl;
+
+    // Cycles that overflow the buffer grow it to the peak on reset
+    ScratchArena arena(256);
+    for (int cycle = 0; cycle < 3; ++cycle)
+    {
+        std::pmr::vector<double> values(&arena);
+        for (int i = 0; i < 1000; ++i)
+        {
+            values.push_back(i);
+        }
+        void *aligned = arena.allocate(8, 64);
+        assert(reinterpret_cast<uintptr_t>(aligned) % 64 == 0);
+        arena.reset();
+        assert(arena.bytes_used() == 0);
+    }
+    assert(arena.capacity() >= arena.high_water());
+
+    // ... after which a cycle never calls the upstream resource
+    size_t upstream = arena.upstream_allocations();
+    {
+        std::pmr::vector<double> values(&arena);
+        for (int i = 0; i < 1000; ++i)
+        {
+            values.push_back(i);
+        }
+        assert(arena.bytes_used() > 0);
+    }
+    arena.reset();
+    assert(arena.upstream_allocations() == upstream);
+
+    // DataProcessor temporaries come from the arena; results do not
+    MarketDataSeries series("SCRATCH");
+    auto now = std::chrono::system_clock::now();
+    for (int i = 0; i < 200; ++i)
+    {
+        double close = 100.0 + std::sin(0.1 * i);
+        series.add_point(MarketDataPoint(now + std::chrono::minutes(i), close, close + 1.0, close - 1.0, close, 1000 + i));
+    }
+    DataProcessor plain;
+    DataProcessor scratch(&arena);
+    assert(scratch.scratch_resource() == &arena && plain.scratch_resource() == std::pmr::get_default_resource());
+    auto expected = plain.calculate_indicators(series);
+    auto actual = scratch.calculate_indicators(series);
+    assert(arena.bytes_used() >= 2 * series.size() * sizeof(double));
+    arena.reset();
+    assert(same_values(expected.macd, actual.macd) && same_values(expected.volume_sma, actual.volume_sma));
+    assert(scratch.clean_data(series).size() == plain.clean_data(series).size());
+
+    // Exported rows are formatted exactly as before
+    visualization::BatchExporter batch;
+    batch.add_exporter(std::make_unique<visualization::CSVExporter>());
+    batch.add_export_config("csv", visualization::ExportConfig("scratch_arena_test.csv"));
+    visualization::ExportConfig json("scratch_arena_test.json", visualization::ExportFormat::JSON);
+    visualization::JSONExporter json_exporter;
+    json_exporter.set_scratch_resource(&arena);
+    std::vector<visualization::ChartPoint> pnl = {visualization::ChartPoint(1, 2.5), visualization::ChartPoint(2, -1.25)};
+    assert(batch.export_market_data_batch(series));
+    assert(json_exporter.export_performance_data(pnl, {}, json));
+
+    std::ifstream csv(visualization::ExportUtils::get_output_path("scratch_arena_test.csv"));
+    std::string header, row;
+    std::getline(csv, header);
+    std::getline(csv, row);
+    assert(header == "Timestamp,Open,High,Low,Close,Volume");
+    assert(row.substr(row.find(',')) == ",100.000000,101.000000,99.000000,100.000000,1000");
+
+    std::ifstream json_file(visualization::ExportUtils::get_output_path("scratch_arena_test.json"));
+    std::string json_text((std::istreambuf_iterator<char>(json_file)), std::istreambuf_iterator<char>());
+    assert(json_text.find("{\"x\": 1, \"y\": 2.500000},\n    {\"x\": 2, \"y\": -1.250000}\n") != std::string::npos);
+    std::filesystem::remove(visualization::ExportUtils::get_output_path("scratch_arena_test.csv"));
+    std::filesystem::remove(visualization::ExportUtils::get_output_path("scratch_arena_test.json"));
+
+    // Strategies see a per-bar scratch resource
+    BacktestEngine engine;
+    ScratchStrategy strategy;
+    engine.run(series, strategy);
+    assert(strategy.seen == engine.scratch() && strategy.seen != std::pmr::get_default_resource());
+    assert(strategy.total > 0.0);
+
+    std::cout << "ScratchArena basic test passed!" << std::endl;
+}
+
+void test_incremental_indicators_basic()
+{
+    std::cout << "Testing IncrementalIndicators basic functionality..." << std::endl;
+
+    std::vector<double> closes, volumes;
+    for (int i = 0; i < 300; ++i)
+    {
+        closes.push_back(100.0 + 3.0 * std::sin(0.07 * i) + 0.01 * i);
+        volumes.push_back(1000.0 + (i % 17) * 25.0);
+    }
+
+    // Rolling SMA and Bollinger match a direct window computation
+    DataProcessor processor;
+    auto sma = processor.calculate_sma(closes, 20);
+    auto bands = processor.calculate_bollinger_bands(closes, 20, 2.0);
+    assert(std::isnan(sma[18]) && !std::isnan(sma[19]));
+    for (size_t i = 19; i < closes.size(); ++i)
+    {
+        double mean = 0.0, variance = 0.0;
+        for (size_t j = i - 19; j <= i; ++j)
+        {
+            mean += closes[j];
+        }
+        mean /= 20;
+        for (size_t j = i - 19; j <= i; ++j)
+        {
+            variance += (closes[j] - mean) * (closes[j] - mean);
+        }
+        double upper = mean + 2.0 * std::sqrt(variance / 20);
+        assert(std::abs(sma[i] - mean) < 1e-9);
+        assert(std::abs(bands.first[i] - upper) < 1e-9);
+    }
+
+    // Wilder RSI: seeded with simple averages, then smoothed
+    std::vector<double> prices = {10.0, 11.0, 10.5, 11.5, 12.0, 11.0};
+    auto rsi = processor.calculate_rsi(prices, 3);
+    assert(std::isnan(rsi[2]));
+    double avg_gain = 2.0 / 3, avg_loss = 0.5 / 3;
+    assert(std::abs(rsi[3] - (100.0 - 100.0 / (1.0 + avg_gain / avg_loss))) < 1e-12);
+    avg_gain = (avg_gain * 2 + 0.5) / 3;
+    avg_loss = (avg_loss * 2) / 3;
+    assert(std::abs(rsi[4] - (100.0 - 100.0 / (1.0 + avg_gain / avg_loss))) < 1e-12);
+
+    // Bar-by-bar updates reproduce the batch indicators exactly
+    IncrementalIndicators streaming;
+    for (size_t i = 0; i < closes.size(); ++i)
+    {
+        streaming.update(closes[i], volumes[i]);
+    }
+    ColumnarSeriesView view{"TEST", {}, {}, {}, {}, closes, volumes};
+    auto batch = processor.calculate_indicators(view);
+    const auto &history = streaming.history();
+    assert(streaming.size() == closes.size());
+    assert(same_values(history.sma_20, batch.sma_20));
+    assert(same_values(history.sma_50, batch.sma_50));
+    assert(same_values(history.ema_12, batch.ema_12));
+    assert(same_values(history.rsi, batch.rsi));
+    assert(same_values(history.macd, batch.macd));
+    assert(same_values(history.macd_signal, batch.macd_signal));
+    assert(same_values(history.bollinger_lower, batch.bollinger_lower));
+    assert(same_values(history.volume_sma, batch.volume_sma));
+    assert(streaming.latest().rsi == batch.rsi.back());
+
+    streaming.reset();
+    assert(streaming.size() == 0 && history.rsi.empty());
+    assert(std::isnan(streaming.latest().sma_20));
+
+    std::cout << "IncrementalIndicators basic test passed!" << std::endl;
+}
+
+// Bitwise equality, so NaN payloads and signed zeros count
+static bool same_bits(double a, double b)
+{
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+static bool same_bits(const std::vector<double> &a, const std::vector<double> &b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+void test_indicator_pipeline_basic()
+{
+    std::cout << "Testing IndicatorPipeline basic functionality..." << std::endl;
+
+    std::vector<double> closes, volumes;
+    for (int i = 0; i < 500; ++i)
+    {
+        closes.push_back(100.0 + 3.0 * std::sin(0.07 * i) + 0.01 * i);
+        volumes.push_back(1000.0 + (i % 17) * 25.0);
+    }
+    DataProcessor processor;
+
+    // Compile-time windows match the run-time ones exactly
+    BasicRollingMean<7> fixed_mean;
+    RollingMean runtime_mean(7);
+    BasicRollingMeanVariance<7> fixed_variance;
+    RollingMeanVariance runtime_variance(7);
+    for (double close : closes)
+    {
+        fixed_mean.push(close);
+        runtime_mean.push(close);
+        fixed_variance.push(close);
+        runtime_variance.push(close);
+        assert(same_values({fixed_mean.value(), fixed_variance.std_dev()},
+                           {runtime_mean.value(), runtime_variance.std_dev()}));
+    }
+    static_assert(sizeof(BasicRollingMean<7>) > 7 * sizeof(double), "window is stored inline");
+
+    // A custom pipeline writes its columns in stage order
+    using Custom = IndicatorPipeline<stages::Sma<5>, stages::Bollinger<10, 1.5>, stages::Ema<3, PipelineInput::VOLUME>>;
+    static_assert(Custom::output_count == 4 && Custom::reads_volume);
+    std::vector<std::vector<double>> columns(Custom::output_count, std::vector<double>(closes.size()));
+    Custom custom;
+    custom.process(closes, volumes, {columns[0], columns[1], columns[2], columns[3]});
+    auto bands = processor.calculate_bollinger_bands(closes, 10, 1.5);
+    assert(custom.size() == closes.size());
+    assert(same_values(columns[0], processor.calculate_sma(closes, 5)));
+    assert(same_values(columns[1], bands.first) && same_values(columns[2], bands.second));
+    assert(same_values(columns[3], processor.calculate_ema(volumes, 3)));
+
+    // Chunked and bar-by-bar feeding continue the same state
+    StandardIndicatorPipeline chunked;
+    std::vector<std::vector<double>> standard(StandardIndicatorPipeline::output_count, std::vector<double>(closes.size()));
+    for (size_t start = 0; start < closes.size();)
+    {
+        size_t length = std::min<size_t>(start < 100 ? 1 : 73, closes.size() - start);
+        StandardIndicatorPipeline::Outputs outputs;
+        for (size_t k = 0; k < outputs.size(); ++k)
+        {
+            outputs[k] = std::span<double>(standard[k]).subspan(start, length);
+        }
+        chunked.process(std::span<const double>(closes).subspan(start, length),
+                        std::span<const double>(volumes).subspan(start, length), outputs);
+        start += length;
+    }
+    ColumnarSeriesView view{"TEST", {}, {}, {}, {}, closes, volumes};
+    auto batch = processor.calculate_indicators(view);
+    assert(same_values(standard[0], batch.sma_20) && same_values(standard[1], batch.sma_50));
+    assert(same_values(standard[4], processor.calculate_rsi(closes, 14)));
+    assert(same_values(standard[6], processor.calculate_macd(closes).second));
+    assert(same_values(standard[9], processor.calculate_sma(volumes, 20)));
+
+    // The fused calculate_indicators keeps the one-bar RSI edge case
+    MarketDataSeries one("ONE");
+    one.add_point(MarketDataPoint(std::chrono::system_clock::now(), 10.0, 11.0, 9.0, 10.5, 100));
+    auto single = processor.calculate_indicators(one);
+    assert(single.sma_20.size() == 1 && single.rsi.empty());
+
+    // Columns shorter than the input are rejected
+    bool threw = false;
+    try
+    {
+        std::vector<double> short_column(closes.size() - 1);
+        IndicatorPipeline<stages::Sma<5>> sma;
+        sma.process(closes, {}, {short_column});
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "IndicatorPipeline test passed!" << std::endl;
+}
+
+void test_simd_kernels_basic()
+{
+    std::cout << "Testing SIMD kernels basic functionality..." << std::endl;
+
+    // Odd length exercises every tail path; include a zero price
+    std::vector<double> prices;
+    for (int i = 0; i < 1003; ++i)
+    {
+        prices.push_back(50.0 + 10.0 * std::sin(0.013 * i) + (i % 7) * 0.01);
+    }
+    prices[500] = 0.0;
+    prices[777] = 500.0;
+
+    DataProcessor processor;
+    simd::set_isa(simd::Isa::SCALAR);
+    double ref_sum = simd::sum(prices);
+    double ref_dev = simd::sum_squared_deviations(prices, 50.0);
+    auto ref_returns = processor.calculate_returns(prices);
+    auto ref_normalized = processor.normalize_prices(prices);
+    auto ref_outliers = processor.detect_outliers(prices, 3.0);
+
+    // Elementwise kernels match the original scalar loops exactly
+    for (size_t i = 1; i < prices.size(); ++i)
+    {
+        double expected = prices[i - 1] != 0.0 ? (prices[i] - prices[i - 1]) / prices[i - 1] : 0.0;
+        assert(same_bits(ref_returns[i], expected));
+    }
+    assert(ref_normalized[500] == 0.0 && ref_normalized[777] == 1.0);
+    assert(ref_outliers.size() == 2 && ref_outliers[0] == 500 && ref_outliers[1] == 777);
+    assert(std::abs(ref_sum - std::accumulate(prices.begin(), prices.end(), 0.0)) < 1e-9);
+
+    std::vector<double> with_nan = {3.0, std::nan(""), 1.0, 2.0, 0.0, -0.0, 4.0, 4.0, 1.0, 7.0};
+
+    // Every available instruction set reproduces the scalar reference bit for bit
+    for (auto isa : {simd::Isa::AVX2, simd::Isa::AVX512, simd::Isa::NEON})
+    {
+        if (!simd::is_supported(isa))
+        {
+            continue;
+        }
+        simd::set_isa(isa);
+        assert(simd::active_isa() == isa);
+        assert(same_bits(simd::sum(prices), ref_sum));
+        assert(same_bits(simd::sum_squared_deviations(prices, 50.0), ref_dev));
+        assert(same_bits(processor.calculate_returns(prices), ref_returns));
+        assert(same_bits(processor.normalize_prices(prices), ref_normalized));
+        assert(processor.detect_outliers(prices, 3.0) == ref_outliers);
+
+        for (size_t n = 1; n <= with_nan.size(); ++n)
+        {
+            std::span<const double> head(with_nan.data(), n);
+            auto vector_result = simd::min_max(head);
+            simd::set_isa(simd::Isa::SCALAR);
+            auto scalar_result = simd::min_max(head);
+            simd::set_isa(isa);
+            assert(same_bits(vector_result.min, scalar_result.min));
+            assert(same_bits(vector_result.max, scalar_result.max));
+        }
+    }
+    simd::set_isa(simd::detect_isa());
+
+    // MarketDataSeries statistics run on the same kernels
+    MarketDataSeries series("TEST");
+    auto t0 = std::chrono::system_clock::now();
+    for (int i = 0; i < 5; ++i)
+    {
+        double close = 10.0 + i;
+        series.add_point(MarketDataPoint(t0 + std::chrono::minutes(i), close, close + 1, close - 1, close, 100));
+    }
+    assert(series.get_average_price() == 12.0);
+    assert(series.get_max_price() == 14.0 && series.get_min_price() == 10.0);
+    assert(series.get_volatility() > 0.0);
+    assert(series.is_valid());
+    assert(series.get_range(t0 + std::chrono::minutes(1), t0 + std::chrono::minutes(3)).size() == 3);
+
+    std::cout << "SIMD kernels basic test passed!" << std::endl;
+}
+
+void test_columnar_file_basic()
+{
+    std::cout << "Testing columnar cache file basic functionality..." << std::endl;
+
+    auto dir = std::filesystem::temp_directory_path() / "trading_columnar_file_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    MarketDataSeries series("TEST");
+    auto t0 = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+    for (int i = 0; i < 1000; ++i)
+    {
+        double close = 100.0 + 0.01 * i;
+        series.add_point(MarketDataPoint(t0 + std::chrono::minutes(i), close - 0.1, close + 0.2,
+                                         close - 0.3, close, 500 + i));
+    }
+
+    // Round trip through a mapped file; columns are aligned and read in place
+    std::string path = (dir / "TEST.cache").string();
+    write_columnar_file(path, ColumnarSeries::from_series(series));
+    assert(MappedColumnarFile::is_columnar_file(path));
+    auto mapped = MappedColumnarFile::open(path);
+    assert(mapped->symbol() == "TEST" && mapped->size() == 1000);
+    assert(reinterpret_cast<uintptr_t>(mapped->view().close.data()) % 64 == 0);
+    auto restored = mapped->to_series();
+    for (size_t i = 0; i < series.size(); ++i)
+    {
+        assert(restored[i].timestamp == series[i].timestamp);
+        assert(restored[i].high == series[i].high);
+        assert(restored[i].volume == series[i].volume);
+    }
+
+    // A flipped byte in the data is caught by the checksum
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(mapped->file_size() - 100));
+        file.put('\x7f');
+    }
+    bool rejected = false;
+    try
+    {
+        MappedColumnarFile::open(path);
+    }
+    catch (const std::runtime_error &)
+    {
+        rejected = true;
+    }
+    assert(rejected);
+
+    // CacheManager persists in the binary format and reloads it on preload
+    std::string cache_dir = (dir / "cache").string();
+    {
+        CacheManager cache(10, cache_dir);
+        cache.put("TEST", series);
+    }
+    {
+        CacheManager cache(10, cache_dir);
+        assert(cache.contains("TEST") && !cache.is_resident("TEST"));
+        auto view = cache.map_from_disk("TEST");
+        assert(view && view->size() == series.size());
+        cache.preload_from_disk();
+        auto loaded = cache.get("TEST");
+        assert(loaded && loaded->size() == series.size() && loaded->back().close == series.back().close);
+        assert(cache.export_to_json("TEST", (dir / "TEST.json").string()));
+    }
+
+    std::filesystem::remove_all(dir);
+
+    std::cout << "Columnar cache file basic test passed!" << std::endl;
+}
+
+void test_cache_manager_lazy_basic()
+{
+    std::cout << "Testing CacheManager lazy startup..." << std::endl;
+
+    auto dir = std::filesystem::temp_directory_path() / "trading_cache_lazy_test";
+    std::filesystem::remove_all(dir);
+
+    // Three ~480 KB series; a 1 MB budget holds two of them
+    auto make_series = [](const std::string &symbol)
+    {
+        MarketDataSeries series(symbol);
+        auto t0 = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+        for (int i = 0; i < 10000; ++i)
+        {
+            series.add_point(MarketDataPoint(t0 + std::chrono::minutes(i), 10.0, 11.0, 9.0, 10.5, 100));
+        }
+        return series;
+    };
+
+    {
+        CacheManager cache(1, dir.string());
+        cache.put("A", make_series("A"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        cache.put("B", make_series("B"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        cache.put("C", make_series("C"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        assert(!cache.is_resident("A")); // Evicted to fit C
+        assert(cache.get("A"));          // Faulted back in, now most recent
+    }
+
+    // Startup reads only the index
+    {
+        CacheManager cache(1, dir.string());
+        assert(cache.size() == 0 && cache.indexed_size() == 3);
+        assert(cache.contains("B") && !cache.is_resident("B"));
+
+        auto series = cache.get("B");
+        assert(series && series->size() == 10000 && cache.is_resident("B"));
+    }
+
+    // Warm-up loads most recently used first and stays within the budget
+    {
+        auto pool = std::make_shared<ThreadPool>(1);
+        CacheManager cache(1, dir.string(), pool);
+        size_t loaded = cache.warm_up_async().get();
+        assert(loaded == 2);
+        assert(cache.is_resident("B") && cache.is_resident("A") && !cache.is_resident("C"));
+        assert(cache.memory_usage() <= 1024 * 1024);
+    }
+
+    std::filesystem::remove_all(dir);
+
+    std::cout << "CacheManager lazy startup test passed!" << std::endl;
+}
+
+void test_cache_manager_sharded_basic()
+{
+    std::cout << "Testing CacheManager sharding..." << std::endl;
+
+    auto dir = std::filesystem::temp_directory_path() / "trading_cache_sharded_test";
+    std::filesystem::remove_all(dir);
+
+    auto make_series = [](const std::string &symbol, int points)
+    {
+        MarketDataSeries series(symbol);
+        auto t0 = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+        for (int i = 0; i < points; ++i)
+        {
+            series.add_point(MarketDataPoint(t0 + std::chrono::minutes(i), 10.0, 11.0, 9.0, 10.5, 100));
+        }
+        return series;
+    };
+
+    {
+        CacheManager cache(10, dir.string(), nullptr, 4);
+        assert(cache.shard_count() == 4);
+
+        for (int i = 0; i < 32; ++i)
+        {
+            cache.put("S" + std::to_string(i), make_series("S" + std::to_string(i), 10));
+        }
+        assert(cache.size() == 32);
+
+        // Hits hand out the cached series itself, not a copy
+        auto first = cache.get("S0");
+        assert(first && first == cache.get("S0"));
+        assert(!cache.get("MISSING"));
+        assert(std::abs(cache.hit_rate() - 2.0 / 3.0) < 1e-12);
+
+        // Concurrent readers share the shard locks
+        std::atomic<int> found{0};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t)
+        {
+            readers.emplace_back([&]()
+                                 {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    if (cache.get("S" + std::to_string(i % 32)))
+                    {
+                        found++;
+                    }
+                } });
+        }
+        for (auto &reader : readers)
+        {
+            reader.join();
+        }
+        assert(found == 4000);
+    }
+    std::filesystem::remove_all(dir);
+
+    {
+        // Three ~480 KB series in a 1 MB budget: CLOCK keeps the entry that was hit
+        CacheManager cache(1, dir.string(), nullptr, 4);
+        cache.put("A", make_series("A", 10000));
+        cache.put("B", make_series("B", 10000));
+        auto held = cache.get("A");
+        cache.put("C", make_series("C", 10000));
+        assert(cache.is_resident("A") && !cache.is_resident("B") && cache.is_resident("C"));
+
+        // Evicted series stay valid for holders
+        cache.remove("A");
+        assert(!cache.contains("A") && held->size() == 10000);
+        assert(cache.memory_usage() <= 1024 * 1024);
+    }
+    std::filesystem::remove_all(dir);
+
+    std::cout << "CacheManager sharding test passed!" << std::endl;
+}
+
+void test_indicator_cache_basic()
+{
+    std::cout << "Testing IndicatorCache basic functionality..." << std::endl;
+
+    auto t0 = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+    auto add_bars = [&](MarketDataSeries &series, int count)
+    {
+        for (int n = 0; n < count; ++n)
+        {
+            double i = static_cast<double>(series.size());
+            double close = 100.0 + 3.0 * std::sin(0.07 * i) + 0.01 * i;
+            series.add_point(MarketDataPoint(t0 + std::chrono::minutes(static_cast<int>(i)), close, close + 1.0,
+                                             close - 1.0, close, 1000 + static_cast<int64_t>(i) % 17 * 25));
+        }
+    };
+    auto closes = [](const MarketDataSeries &series)
+    {
+        std::vector<double> prices;
+        for (const auto &point : series.data())
+        {
+            prices.push_back(point.close);
+        }
+        return prices;
+    };
+
+    // Versions survive appends and moves, never copies or clears
+    MarketDataSeries series("TEST");
+    add_bars(series, 200);
+    uint64_t version = series.version();
+    add_bars(series, 1);
+    assert(series.version() == version);
+    MarketDataSeries copy = series;
+    assert(copy.version() != version && copy.size() == series.size());
+    MarketDataSeries moved = std::move(copy);
+    assert(moved.version() != version && moved.version() != copy.version());
+    uint64_t moved_version = moved.version();
+    moved.clear();
+    assert(moved.version() != moved_version);
+
+    DataProcessor processor;
+    IndicatorCache cache(16);
+
+    // Repeated requests are served from the cache
+    auto sma = cache.sma(series, 20);
+    assert(same_values(*sma, processor.calculate_sma(closes(series), 20)));
+    assert(cache.sma(series, 20) == sma);
+    assert(cache.misses() == 1 && cache.hits() == 1 && cache.extensions() == 0);
+
+    // Appended bars extend the entry; the handle already out keeps its values
+    add_bars(series, 49);
+    auto extended = cache.sma(series, 20);
+    assert(sma->size() == 201 && extended->size() == 250);
+    assert(same_values(*extended, processor.calculate_sma(closes(series), 20)));
+    assert(cache.extensions() == 1 && cache.misses() == 1);
+
+    // Every indicator stays bit-identical to the batch kernels across
+    // single-bar and multi-bar appends
+    for (int step = 0; step < 3; ++step)
+    {
+        auto prices = closes(series);
+        assert(same_values(*cache.ema(series, 12), processor.calculate_ema(prices, 12)));
+        assert(same_values(*cache.rsi(series, 14), processor.calculate_rsi(prices, 14)));
+        auto macd = cache.macd(series, 12, 26, 9);
+        auto expected_macd = processor.calculate_macd(prices, 12, 26, 9);
+        assert(same_values(macd->first, expected_macd.first) && same_values(macd->second, expected_macd.second));
+        auto bands = cache.bollinger_bands(series, 20, 2.0);
+        auto expected_bands = processor.calculate_bollinger_bands(prices, 20, 2.0);
+        assert(same_values(bands->first, expected_bands.first) && same_values(bands->second, expected_bands.second));
+
+        auto all = cache.calculate_indicators(series);
+        auto batch = processor.calculate_indicators(series);
+        assert(same_values(all->sma_50, batch.sma_50) && same_values(all->rsi, batch.rsi));
+        assert(same_values(all->macd_signal, batch.macd_signal) && same_values(all->volume_sma, batch.volume_sma));
+        assert(same_values(all->bollinger_upper, batch.bollinger_upper));
+
+        add_bars(series, step == 0 ? 1 : 37);
+    }
+    assert(cache.size() == 6);
+
+    // Parameters and series are part of the key; a cleared series starts over
+    assert(cache.sma(series, 21) != cache.sma(series, 20));
+    assert(cache.bollinger_bands(series, 20, 2.0) != cache.bollinger_bands(series, 20, 2.5));
+    MarketDataSeries short_series("SHORT");
+    add_bars(short_series, 1);
+    assert(cache.rsi(short_series, 14)->empty() && cache.calculate_indicators(short_series)->rsi.empty());
+    series.clear();
+    add_bars(series, 30);
+    assert(same_values(*cache.sma(series, 20), processor.calculate_sma(closes(series), 20)));
+
+    bool threw = false;
+    try
+    {
+        cache.ema(series, 0);
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    // DataProcessor can serve calculate_indicators from the cache
+    auto shared_cache = std::make_shared<IndicatorCache>(16);
+    DataProcessor cached_processor;
+    cached_processor.set_indicator_cache(shared_cache);
+    add_bars(series, 100);
+    auto cached = cached_processor.calculate_indicators(series);
+    assert(same_values(cached.ema_26, processor.calculate_indicators(series).ema_26));
+    cached_processor.calculate_indicators(series);
+    assert(shared_cache->hits() == 1);
+
+    // One memory budget shared with the series cache
+    auto dir = std::filesystem::temp_directory_path() / "trading_indicator_cache_test";
+    std::filesystem::remove_all(dir);
+    {
+        auto budget = std::make_shared<CacheManager>(1, dir.string(), nullptr, 4);
+        MarketDataSeries large("LARGE");
+        add_bars(large, 10000);
+        budget->put("A", large);
+        size_t series_bytes = budget->memory_usage();
+
+        IndicatorCache shared(budget);
+        shared.sma(large, 20);
+        assert(shared.memory_usage() >= 10000 * sizeof(double));
+        assert(budget->memory_usage() == series_bytes + shared.memory_usage());
+
+        // Ten 80 KB columns do not fit beside the series: the cache drops
+        // its own SMA first, then the series
+        auto all = shared.calculate_indicators(large);
+        assert(shared.size() == 1 && !budget->is_resident("A"));
+        assert(budget->memory_usage() == shared.memory_usage() && budget->memory_usage() <= 1024 * 1024);
+
+        // A new series takes the memory back once no series is left to evict
+        budget->put("B", large);
+        assert(budget->is_resident("B") && shared.size() == 0 && shared.memory_usage() == 0);
+        assert(budget->memory_usage() == series_bytes && all->sma_20.size() == 10000);
+
+        shared.ema(large, 12);
+        shared.clear();
+        assert(budget->memory_usage() == series_bytes);
+    }
+    std::filesystem::remove_all(dir);
+
+    std::cout << "IndicatorCache test passed!" << std::endl;
+}
+
+void test_universe_panel_basic()
+{
+    std::cout << "Testing UniversePanel basic functionality..." << std::endl;
+
+    // 130 symbols (three bitmap words); symbol s skips every bar where
+    // i % (s % 7 + 2) == 0, symbol 5 only starts at bar 10, symbol 129
+    // has a duplicated timestamp and symbol 7 has no bars at all
+    auto t0 = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+    const size_t symbols = 130;
+    const size_t bars = 50;
+    std::vector<MarketDataSeries> universe;
+    for (size_t s = 0; s < symbols; ++s)
+    {
+        MarketDataSeries series("S" + std::to_string(s));
+        for (size_t i = 0; i < bars && s != 7; ++i)
+        {
+            if ((i % (s % 7 + 2) == 0 && s % 3 == 0) || (s == 5 && i < 10))
+            {
+                continue;
+            }
+            double price = 100.0 + static_cast<double>(s) + 0.01 * static_cast<double>(i);
+            series.add_point(MarketDataPoint(t0 + std::chrono::minutes(i), price, price + 1.0, price - 1.0,
+                                             price + 0.5, static_cast<int64_t>(1000 * s + i)));
+            if (s == 129 && i == 20)
+            {
+                series.add_point(MarketDataPoint(t0 + std::chrono::minutes(i), 1.0, 2.0, 0.5, 7.0, 1));
+            }
+        }
+        universe.push_back(std::move(series));
+    }
+
+    auto check = [&](const UniversePanel &panel)
+    {
+        assert(panel.symbols() == symbols && panel.bars() == bars);
+        const PanelView &view = panel.view();
+        assert(reinterpret_cast<uintptr_t>(view.row(PanelField::CLOSE, 0).data()) % 64 == 0);
+        for (size_t t = 0; t < bars; ++t)
+        {
+            assert(view.time(t) == t0 + std::chrono::minutes(t));
+            size_t expected_valid = 0;
+            for (size_t s = 0; s < symbols; ++s)
+            {
+                bool present = s != 7 && !((t % (s % 7 + 2) == 0 && s % 3 == 0) || (s == 5 && t < 10));
+                assert(view.valid(t, s) == present);
+                expected_valid += present ? 1 : 0;
+                double close = view.at(PanelField::CLOSE, t, s);
+                if (!present)
+                {
+                    assert(std::isnan(close));
+                }
+                else if (s == 129 && t == 20)
+                {
+                    assert(close == 7.0); // Last bar of a duplicated timestamp wins
+                }
+                else
+                {
+                    assert(close == 100.5 + static_cast<double>(s) + 0.01 * static_cast<double>(t));
+                    assert(view.at(PanelField::VOLUME, t, s) == static_cast<double>(1000 * s + t));
+                }
+            }
+            assert(view.valid_count(t) == expected_valid);
+            assert(view.row(PanelField::OPEN, t).size() == symbols);
+        }
+    };
+
+    UniversePanel serial = UniversePanel::from_series(universe);
+    check(serial);
+    UniversePanel parallel = UniversePanel::from_series(universe, std::make_shared<ThreadPool>(2));
+    check(parallel);
+
+    // Slicing by index and by time
+    auto slice = serial.slice(t0 + std::chrono::minutes(10), t0 + std::chrono::minutes(15));
+    assert(slice.bars() == 5 && slice.time(0) == t0 + std::chrono::minutes(10));
+    assert(slice.valid(0, 5) && !serial.view().valid(9, 5));
+    assert(slice.at(PanelField::HIGH, 2, 43) == serial.view().at(PanelField::HIGH, 12, 43));
+    assert(serial.slice(45, 100).bars() == 5);
+    assert(serial.slice(t0 + std::chrono::hours(5), t0 + std::chrono::hours(6)).bars() == 0);
+
+    // Per-symbol views hold only real bars when copied out
+    auto five = serial.symbol(serial.find("S5"));
+    assert(five.symbol() == "S5" && five.size() == bars && !five.valid(0) && std::isnan(five.close(0)));
+    auto five_series = five.to_series();
+    assert(five_series.size() == bars - 10);
+    assert(five_series[0].timestamp == t0 + std::chrono::minutes(10));
+    assert(five_series[0].close == universe[5][0].close);
+    assert(slice.symbol(5).to_columnar().size() == 5);
+    assert(serial.symbol(7).to_columnar().empty());
+    assert(serial.find("missing") == PanelView::npos);
+
+    // Symbols on their own axis extend the union
+    std::vector<std::shared_ptr<const MarketDataSeries>> shifted;
+    shifted.push_back(std::make_shared<MarketDataSeries>(universe[1]));
+    auto late = std::make_shared<MarketDataSeries>("LATE");
+    late->add_point(MarketDataPoint(t0 + std::chrono::seconds(30), 1.0, 1.0, 1.0, 1.0, 1));
+    shifted.push_back(late);
+    shifted.push_back(nullptr);
+    auto merged = UniversePanel::from_series(shifted);
+    assert(merged.bars() == universe[1].size() + 1 && merged.symbols() == 3);
+    assert(merged.view().time(1) == t0 + std::chrono::seconds(30));
+    assert(merged.view().valid(1, 1) && !merged.view().valid(1, 0) && merged.view().valid_count(1) == 1);
+
+    // Decreasing timestamps are rejected
+    MarketDataSeries backwards("BACK");
+    backwards.add_point(MarketDataPoint(t0 + std::chrono::minutes(1), 1.0, 1.0, 1.0, 1.0, 1));
+    backwards.add_point(MarketDataPoint(t0, 1.0, 1.0, 1.0, 1.0, 1));
+    bool threw = false;
+    try
+    {
+        UniversePanel::from_series(std::vector<MarketDataSeries>{backwards});
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    // Loading through the cache, with one key that is not cached
+    auto dir = std::filesystem::temp_directory_path() / "trading_universe_panel_test";
+    std::filesystem::remove_all(dir);
+    {
+        auto pool = std::make_shared<ThreadPool>(2);
+        CacheManager cache(64, dir.string(), pool);
+        std::vector<std::string> keys;
+        for (size_t s = 0; s < 10; ++s)
+        {
+            keys.push_back("S" + std::to_string(s) + "_1m");
+            cache.put(keys.back(), universe[s]);
+        }
+        keys.push_back("NOT_CACHED");
+        auto loaded = UniversePanel::load(cache, keys, pool);
+        assert(loaded.symbols() == 11 && loaded.bars() == bars);
+        assert(loaded.view().symbol_names()[3] == "S3" && loaded.view().symbol_names()[10] == "NOT_CACHED");
+        for (size_t t = 0; t < bars; ++t)
+        {
+            size_t expected_valid = 0;
+            for (size_t s = 0; s < 10; ++s)
+            {
+                assert(loaded.view().valid(t, s) == serial.view().valid(t, s));
+                expected_valid += serial.view().valid(t, s) ? 1 : 0;
+            }
+            assert(!loaded.view().valid(t, 10));
+            assert(loaded.view().valid_count(t) == expected_valid);
+        }
+
+        UniversePanel moved = std::move(loaded);
+        assert(moved.view().at(PanelField::LOW, 20, 4) == serial.view().at(PanelField::LOW, 20, 4));
+    }
+    std::filesystem::remove_all(dir);
+
+    std::cout << "UniversePanel basic test passed!" << std::endl;
+}
+
+void test_rate_limiter_basic()
+{
+    std::cout << "Testing RateLimiter basic functionality..." << std::endl;
+
+    // 10 requests per second with a burst of 3
+    RateLimiter limiter(10.0, 3.0);
+    auto t0 = RateLimiter::Clock::now() + std::chrono::seconds(1);
+    assert(limiter.try_acquire(t0) && limiter.try_acquire(t0) && limiter.try_acquire(t0));
+    assert(!limiter.try_acquire(t0));
+    assert(limiter.wait_time(t0) > std::chrono::milliseconds(99) && limiter.wait_time(t0) <= std::chrono::milliseconds(100));
+
+    // Tokens accrue with time, but never beyond the burst
+    assert(limiter.try_acquire(t0 + std::chrono::milliseconds(100)));
+    assert(!limiter.try_acquire(t0 + std::chrono::milliseconds(150)));
+    auto later = t0 + std::chrono::seconds(10);
+    assert(limiter.try_acquire(later) && limiter.try_acquire(later) && limiter.try_acquire(later));
+    assert(!limiter.try_acquire(later));
+
+    // Zero rate means unlimited
+    RateLimiter unlimited(0.0, 1.0);
+    for (int i = 0; i < 100; ++i)
+    {
+        assert(unlimited.try_acquire());
+    }
+
+    bool threw = false;
+    try
+    {
+        RateLimiter bad(1.0, 0.0);
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "RateLimiter basic test passed!" << std::endl;
+}
+
+void test_yahoo_finance_batch_basic()
+{
+    std::cout << "Testing YahooFinanceClient batch fetching..." << std::endl;
+
+    // Serve chart responses from files so no network is needed
+    auto dir = std::filesystem::temp_directory_path() / "trading_yahoo_batch_test";
+    std::filesystem::create_directories(dir);
+    auto write_chart = [&](const std::string &symbol, int points)
+    {
+        std::ofstream file(dir / symbol);
+        file << "{\"chart\":{\"result\":[{\"timestamp\":[";
+        for (int i = 0; i < points; ++i)
+        {
+            file << (i ? "," : "") << 1700000000 + i * 86400;
+        }
+        file << "],\"indicators\":{\"quote\":[{";
+        for (const char *field : {"open", "high", "low", "close", "volume"})
+        {
+            file << (field[0] == 'o' ? "" : ",") << "\"" << field << "\":[";
+            for (int i = 0; i < points; ++i)
+            {
+                file << (i ? "," : "") << 100 + i;
+            }
+            file << "]";
+        }
+        file << "}]}}],\"error\":null}}";
+    };
+    write_chart("AAA", 5);
+    write_chart("BBB", 7);
+    {
+        std::ofstream file(dir / "ERR");
+        file << "{\"chart\":{\"result\":null,\"error\":{\"code\":\"Not Found\",\"description\":\"No data found\"}}}";
+    }
+
+    auto pool = std::make_shared<ThreadPool>(1);
+    YahooFinanceClient client(pool);
+    client.set_base_url("file://" + dir.generic_string() + "/");
+    client.set_max_connections(2);
+    client.set_rate_limit(0.0, 1.0);
+
+    auto now = std::chrono::system_clock::now();
+    std::vector<MarketDataRequest> requests;
+    for (const char *symbol : {"AAA", "BBB", "ERR", "MISSING", "AAA"})
+    {
+        requests.emplace_back(symbol, now - std::chrono::hours(24 * 30), now);
+    }
+
+    auto futures = client.fetch_batch(requests);
+    assert(futures.size() == requests.size());
+    auto first = futures[0].get();
+    assert(first.symbol() == "AAA" && first.size() == 5 && first[4].close == 104.0);
+    assert(futures[1].get().size() == 7);
+    assert(futures[4].get().size() == 5);
+
+    // Failures stay with their own request
+    for (size_t i : {2, 3})
+    {
+        bool threw = false;
+        try
+        {
+            futures[i].get();
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // The synchronous path is safe to call from several threads at once
+    std::atomic<size_t> points{0};
+    std::vector<std::thread> callers;
+    for (int t = 0; t < 4; ++t)
+    {
+        callers.emplace_back([&]()
+                             { points += client.fetch_historical_data_sync(requests[1]).size(); });
+    }
+    for (auto &caller : callers)
+    {
+        caller.join();
+    }
+    assert(points == 28);
+
+    std::filesystem::remove_all(dir);
+
+    std::cout << "YahooFinanceClient batch test passed!" << std::endl;
+}
+
+void test_chart_parser_basic()
+{
+    std::cout << "Testing ChartStreamParser basic functionality..." << std::endl;
+
+    // Nulls drop the row (or zero the volume), unrelated members are skipped
+    const std::string body =
+        "{\"chart\":{\"result\":[{\"meta\":{\"symbol\":\"T\\u00e9st\\\"\",\"periods\":[[{\"start\":1}],[]],\"ok\":true},"
+        "\"timestamp\":[1700000000,1700086400,1700172800,1700259200],"
+        "\"indicators\":{\"quote\":[{\"open\":[10.5,null,12,13],\"high\":[11,12,1.3e1,14.25],"
+        "\"low\":[10,11,11.5,12.75],\"close\":[10.75,11.5,12.5,-0.0],\"volume\":[1000,2000,null,4000]}],"
+        "\"adjclose\":[{\"adjclose\":[1,2,3,4]}]}}],\"error\":null}}";
+
+    auto check = [](const ColumnarSeries &series)
+    {
+        assert(series.symbol() == "TEST" && series.size() == 3);
+        assert(series.timestamps()[0] == to_epoch_nanos(std::chrono::system_clock::from_time_t(1700000000)));
+        assert(series.timestamps()[1] == to_epoch_nanos(std::chrono::system_clock::from_time_t(1700172800)));
+        assert(series.open()[0] == 10.5 && series.high()[1] == 13.0 && series.high()[2] == 14.25);
+        assert(series.low()[2] == 12.75 && series.close()[0] == 10.75);
+        assert(series.volume()[0] == 1000.0 && series.volume()[1] == 0.0 && series.volume()[2] == 4000.0);
+    };
+
+    {
+        ChartStreamParser parser("TEST");
+        parser.feed(body);
+        check(parser.finish());
+    }
+
+    // Any chunking gives the same result, down to one byte at a time
+    for (size_t chunk : {1, 2, 3, 7, 64})
+    {
+        ChartStreamParser parser("TEST");
+        for (size_t offset = 0; offset < body.size(); offset += chunk)
+        {
+            parser.feed(std::string_view(body).substr(offset, chunk));
+        }
+        assert(parser.bytes_consumed() == body.size());
+        check(parser.finish());
+    }
+
+    auto throws = [](const std::string &input, const std::string &expected)
+    {
+        try
+        {
+            ChartStreamParser parser("TEST");
+            parser.feed(input);
+            parser.finish();
+        }
+        catch (const std::runtime_error &e)
+        {
+            return std::string(e.what()).find(expected) != std::string::npos;
+        }
+        return false;
+    };
+
+    assert(throws("{\"chart\":{\"result\":null,\"error\":{\"code\":\"Not Found\",\"description\":\"No data found\"}}}",
+                  "No data found"));
+    assert(throws(body.substr(0, body.size() / 2), "unexpected end of input"));
+    assert(throws("{\"chart\":[1,]}", "JSON parsing error"));
+    assert(throws("{\"chart\":nul}", "invalid literal"));
+    assert(throws("{\"chart\"}", "JSON parsing error"));
+
+    std::cout << "ChartStreamParser basic test passed!" << std::endl;
+}
+
+void test_backtest_engine_basic()
+{
+    std::cout << "Testing BacktestEngine basic functionality..." << std::endl;
+
+    MarketDataSeries series("TEST");
+    auto now = std::chrono::system_clock::now();
+    for (int i = 0; i < 5; ++i)
+    {
+        double open = 100.0 + i;
+        series.add_point(MarketDataPoint(now + std::chrono::minutes(i), open, open + 1.0, open - 1.0, open + 0.5, 1000));
+    }
+
+    BacktestConfig config;
+    config.initial_capital = 10000.0;
+    config.queue_capacity = 2; // Force the bar queue to wrap several times
+    BacktestEngine engine(config);
+
+    BuyThenSellStrategy strategy;
+    auto result = engine.run(series, strategy);
+
+    // Buy fills at bar 1 open (101), sell fills at bar 3 open (103)
+    assert(result.bars_processed == 5);
+    assert(result.orders_submitted == 2);
+    assert(result.orders_filled == 2);
+    assert(strategy.fills == 2);
+    assert(result.final_position == 0);
+    assert(result.final_equity == 10000.0 + 10 * (103.0 - 101.0));
+    assert(result.equity_curve.size() == 5);
+
+    // The engine can be reused and starts from a clean state
+    BuyThenSellStrategy second;
+    auto rerun = engine.run(series, second);
+    assert(rerun.final_equity == result.final_equity);
+
+    std::cout << "BacktestEngine basic test passed!" << std::endl;
+}
+
+void test_streaming_backtest_basic()
+{
+    std::cout << "Testing streaming backtest..." << std::endl;
+
+    auto dir = std::filesystem::temp_directory_path() / "trading_streaming_backtest_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    // 1000 bars split over three segment files of uneven length
+    MarketDataSeries series("STRM");
+    std::mt19937_64 rng(5);
+    std::normal_distribution<double> step(0.0, 0.5);
+    auto t0 = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+    double price = 100.0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        double open = price;
+        price = std::max(1.0, price + step(rng));
+        series.add_point(MarketDataPoint(t0 + std::chrono::minutes(i), open, std::max(open, price) + 0.25,
+                                         std::min(open, price) - 0.25, price, 1000 + i));
+    }
+    ColumnarSeries columns = ColumnarSeries::from_series(series);
+    std::vector<std::string> paths;
+    size_t offset = 0;
+    for (size_t length : {450, 50, 500})
+    {
+        paths.push_back((dir / ("part" + std::to_string(paths.size()) + ".col")).string());
+        write_columnar_file(paths.back(), columns.view().slice(offset, length));
+        offset += length;
+    }
+
+    // Chunks cover the stream in order, each led by the previous chunk's tail
+    StreamingConfig config;
+    config.chunk_bars = 128;
+    config.lookback = 3;
+    {
+        ChunkedSeriesReader reader(paths, config);
+        StreamChunk chunk;
+        size_t expected_first = 0;
+        while (reader.next(chunk))
+        {
+            assert(chunk.first_bar == expected_first);
+            assert(chunk.lookback == (expected_first == 0 ? 0 : 3));
+            assert(chunk.size() == std::min<size_t>(128, 1000 - expected_first));
+            for (size_t i = 0; i < chunk.bars.size(); ++i)
+            {
+                size_t bar = chunk.first_bar - chunk.lookback + i;
+                assert(chunk.bars.timestamps[i] == columns.timestamps()[bar]);
+                assert(chunk.bars.close[i] == columns.close()[bar]);
+            }
+            expected_first += chunk.size();
+        }
+        assert(expected_first == 1000 && reader.bars_read() == 1000);
+        assert(reader.symbol() == "STRM");
+        assert(reader.buffer_bytes() == 2 * 131 * 6 * sizeof(double));
+        assert(!reader.next(chunk));
+
+        reader.rewind();
+        assert(reader.next(chunk) && chunk.first_bar == 0 && chunk.lookback == 0);
+    }
+
+    // Streaming is bar-for-bar the in-memory run, with or without prefetching
+    BacktestConfig backtest;
+    backtest.initial_capital = 50000.0;
+    backtest.queue_capacity = 16;
+    BacktestEngine engine(backtest);
+    SmaCrossoverStrategy in_memory_strategy(5, 20);
+    auto expected = engine.run(series, in_memory_strategy);
+    assert(expected.orders_filled > 0);
+
+    auto pool = std::make_shared<ThreadPool>(2);
+    for (auto thread_pool : {std::shared_ptr<ThreadPool>(), pool})
+    {
+        ChunkedSeriesReader reader(paths, config, thread_pool);
+        SmaCrossoverStrategy strategy(5, 20);
+
+        // Batch kernels see each chunk with its lookback as warm-up: the
+        // returns of the new bars match the whole-series returns
+        std::vector<double> returns(columns.size(), 0.0);
+        std::vector<double> scratch(config.lookback + config.chunk_bars);
+        auto result = engine.run_streaming(reader, strategy, [&](const StreamChunk &chunk)
+                                           {
+            std::span<double> out(scratch.data(), chunk.bars.size());
+            simd::simple_returns(chunk.bars.close, out);
+            for (size_t i = chunk.lookback; i < chunk.bars.size(); ++i)
+            {
+                returns[chunk.first_bar + i - chunk.lookback] = out[i];
+            } });
+
+        assert(result.symbol == "STRM");
+        assert(result.bars_processed == expected.bars_processed);
+        assert(result.orders_submitted == expected.orders_submitted);
+        assert(result.orders_filled == expected.orders_filled);
+        assert(result.final_equity == expected.final_equity);
+        assert(result.max_drawdown == expected.max_drawdown);
+        assert(result.equity_curve == expected.equity_curve);
+
+        std::vector<double> whole(columns.size());
+        simd::simple_returns(columns.close(), whole);
+        for (size_t i = 1; i < whole.size(); ++i)
+        {
+            assert(returns[i] == whole[i]);
+        }
+    }
+
+    // Persisted cache entries stream without being loaded into the cache
+    {
+        CacheManager cache(10, (dir / "cache").string());
+        cache.put("STRM_A", columns.view().slice(0, 600).to_series());
+        cache.put("STRM_B", columns.view().slice(600, 400).to_series());
+        auto reader = ChunkedSeriesReader::from_cache(cache, {"STRM_A", "STRM_B"}, config, pool);
+        SmaCrossoverStrategy strategy(5, 20);
+        auto result = engine.run_streaming(*reader, strategy);
+        assert(result.final_equity == expected.final_equity);
+
+        auto missing = ChunkedSeriesReader::from_cache(cache, {"STRM_A", "NOT_THERE"}, config);
+        StreamChunk chunk;
+        bool threw = false;
+        try
+        {
+            while (missing->next(chunk))
+            {
+            }
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    std::filesystem::remove_all(dir);
+
+    std::cout << "Streaming backtest test passed!" << std::endl;
+}
+
+// Sweeps the book on the first bar with a market and a limit buy
+class BookTakerStrategy : public Strategy
+{
+public:
+    std::vector<Fill> fills;
+
+    void on_bar(const MarketDataPoint &, StrategyContext &context) override
+    {
+        if (context.bar_index() == 0)
+        {
+            context.submit_order(OrderSide::BUY, 150);
+            context.submit_order(OrderSide::BUY, 300, OrderType::LIMIT, 10.15);
+        }
+    }
+
+    void on_fill(const Fill &fill, StrategyContext &) override { fills.push_back(fill); }
+
+    std::string name() const override { return "BookTaker"; }
+};
+
+void test_order_book_basic()
+{
+    std::cout << "Testing OrderBook basic functionality..." << std::endl;
+
+    OrderBook book(0.01, 64);
+    assert(!book.best_bid() && !book.best_ask());
+
+    assert(book.add(1, BookSide::BID, 100.00, 100));
+    assert(book.add(2, BookSide::BID, 100.01, 50));
+    assert(book.add(3, BookSide::BID, 100.01, 25));
+    assert(book.add(10, BookSide::ASK, 100.03, 40));
+    assert(book.add(11, BookSide::ASK, 100.05, 60));
+    assert(!book.add(1, BookSide::BID, 99.00, 1)); // Duplicate id
+    assert(*book.best_bid() == 100.01 && *book.best_ask() == 100.03);
+    assert(book.level_count(BookSide::BID) == 2);
+    assert(book.volume_at(BookSide::BID, 100.01) == 75);
+
+    // A market buy sweeps the asks in price order
+    std::vector<BookTrade> trades;
+    BookQuote quote = book.quote(BookSide::BID, 70);
+    assert(quote.quantity == 70);
+    assert(book.match(BookSide::BID, 70, std::nullopt, &trades) == 70);
+    assert(trades.size() == 2 && trades[0].resting_id == 10 && trades[1].resting_id == 11);
+    assert(trades[1].quantity == 30);
+    assert(std::abs(quote.notional - (40 * 100.03 + 30 * 100.05)) < 1e-9);
+    assert(*book.best_ask() == 100.05 && book.volume_at(BookSide::ASK, 100.05) == 30);
+
+    // A crossing limit sell fills best price first, then time priority, and nothing rests
+    trades.clear();
+    assert(book.submit(20, BookSide::ASK, 100.00, 100, &trades) == 100);
+    assert(trades.size() == 3);
+    assert(trades[0].resting_id == 2 && trades[1].resting_id == 3 && trades[2].resting_id == 1);
+    assert(trades[2].quantity == 25 && trades[2].price == 100.00);
+    assert(!book.contains(20) && book.volume_at(BookSide::BID, 100.00) == 75);
+
+    // Shrinking keeps priority, growing loses it
+    assert(book.reduce(1, 75) && !book.contains(1));
+    assert(book.add(4, BookSide::BID, 100.00, 10));
+    assert(book.add(5, BookSide::BID, 100.00, 10));
+    assert(book.modify(4, 100.00, 5));
+    trades.clear();
+    book.match(BookSide::ASK, 1, std::nullopt, &trades);
+    assert(trades[0].resting_id == 4);
+    assert(book.modify(4, 100.00, 20));
+    trades.clear();
+    book.match(BookSide::ASK, 10, std::nullopt, &trades);
+    assert(trades.size() == 1 && trades[0].resting_id == 5);
+
+    // Replace moves the order to a new id and price
+    assert(book.replace(4, 40, 99.50, 7));
+    assert(!book.contains(4) && book.contains(40));
+    assert(*book.best_bid() == 99.50 && book.volume_at(BookSide::BID, 99.50) == 7);
+
+    // A price far outside the ladder grows it without disturbing the rest
+    assert(book.add(12, BookSide::ASK, 105.00, 9));
+    assert(*book.best_bid() == 99.50 && *book.best_ask() == 100.05);
+    std::vector<BookLevel> asks;
+    book.snapshot(BookSide::ASK, 10, asks);
+    assert(asks.size() == 2 && asks[1].price == 105.00 && asks[1].quantity == 9);
+
+    // Limit matching stops at the limit
+    assert(book.match(BookSide::BID, 100, 100.10) == 30);
+    assert(*book.best_ask() == 105.00);
+
+    // The id index survives heavy churn
+    OrderBook churn(0.01, 64, 16);
+    for (uint64_t id = 1; id <= 5000; ++id)
+    {
+        assert(churn.add(id * 7919, id % 2 ? BookSide::BID : BookSide::ASK, id % 2 ? 50.0 - (id % 40) * 0.01 : 50.01 + (id % 40) * 0.01, id));
+    }
+    for (uint64_t id = 1; id <= 5000; id += 2)
+    {
+        assert(churn.cancel(id * 7919));
+    }
+    assert(churn.order_count() == 2500 && churn.level_count(BookSide::BID) == 0);
+    for (uint64_t id = 1; id <= 5000; ++id)
+    {
+        assert(churn.contains(id * 7919) == (id % 2 == 0));
+    }
+    churn.clear();
+    assert(churn.order_count() == 0 && !churn.best_ask());
+
+    // The widget renders snapshots of the book
+    visualization::OrderBookWidget widget("book", visualization::WidgetConfig(visualization::WidgetType::ORDER_BOOK, "Book", 0, 0, 40, 20));
+    assert(book.add(41, BookSide::BID, 99.75, 3));
+    widget.update_from_book(book, 5);
+    widget.update();
+    assert(std::abs(widget.spread() - (105.00 - 99.75)) < 1e-9);
+    assert(widget.total_bid_volume() == 10 && widget.total_ask_volume() == 9);
+
+    // Backtest fills sweep an L2 book updated by the feed
+    MarketDataSeries series("BOOK");
+    auto now = std::chrono::system_clock::now();
+    for (int i = 0; i < 4; ++i)
+    {
+        series.add_point(MarketDataPoint(now + std::chrono::minutes(i), 10.0, 10.5, 9.5, 10.0, 1000));
+    }
+
+    OrderBook l2(0.01);
+    BacktestConfig config;
+    config.initial_capital = 100000.0;
+    BacktestEngine engine(config);
+    engine.set_order_book(&l2, [](size_t bar, const MarketDataPoint &, OrderBook &feed)
+                          {
+        if (bar == 1)
+        {
+            feed.add(1, BookSide::ASK, 10.00, 100);
+            feed.add(2, BookSide::ASK, 10.10, 100);
+            feed.add(3, BookSide::ASK, 10.20, 100);
+        }
+        else if (bar == 2)
+        {
+            feed.add(4, BookSide::ASK, 10.15, 500);
+        } });
+
+    BookTakerStrategy strategy;
+    auto result = engine.run(series, strategy);
+
+    // Bar 1: the market order takes 100 @ 10.00 and 50 @ 10.10; the limit gets the other 50 @ 10.10
+    // Bar 2: the limit fills its remaining 250 @ 10.15
+    assert(strategy.fills.size() == 3);
+    assert(strategy.fills[0].quantity == 150);
+    assert(std::abs(strategy.fills[0].price - (100 * 10.00 + 50 * 10.10) / 150.0) < 1e-9);
+    assert(strategy.fills[1].quantity == 50 && std::abs(strategy.fills[1].price - 10.10) < 1e-9);
+    assert(strategy.fills[2].quantity == 250 && std::abs(strategy.fills[2].price - 10.15) < 1e-9);
+    assert(result.orders_filled == 2 && result.final_position == 450);
+    assert(l2.volume_at(BookSide::ASK, 10.15) == 250 && l2.volume_at(BookSide::ASK, 10.20) == 100);
+
+    std::cout << "OrderBook basic test passed!" << std::endl;
+}
+
+void test_chart_lod_basic()
+{
+    std::cout << "Testing chart level of detail..." << std::endl;
+
+    using namespace trading::visualization;
+
+    // Bucketed candles are the bars a coarser interval would give
+    auto start = std::chrono::system_clock::now();
+    std::vector<CandlestickPoint> bars;
+    for (int i = 0; i < 1000; ++i)
+    {
+        double base = 100.0 + std::sin(i * 0.05) * 10.0;
+        bars.emplace_back(MarketDataPoint(start + std::chrono::minutes(i), base, base + 1.0 + (i == 437 ? 50.0 : 0.0), base - 1.0, base + 0.5, 10));
+    }
+    auto buckets = bucket_candles(bars, 10);
+    assert(buckets.size() == 10);
+    assert(buckets[0].open == bars[0].open && buckets[0].close == bars[99].close);
+    assert(buckets[0].timestamp == bars[0].timestamp && buckets[9].close == bars[999].close);
+    assert(buckets[4].high > 150.0 && buckets[4].volume == 1000);
+    uint64_t total_volume = 0;
+    for (const auto &bucket : buckets)
+    {
+        total_volume += bucket.volume;
+    }
+    assert(total_volume == 10000);
+    assert(bucket_candles(bars, 5000).size() == 1000);
+
+    // LTTB keeps the endpoints and the spike; min/max keeps every extreme
+    std::vector<ChartPoint> line;
+    for (int i = 0; i < 10000; ++i)
+    {
+        line.emplace_back(i, std::sin(i * 0.01) + (i == 6789 ? 25.0 : 0.0));
+    }
+    auto lttb = lttb_decimate(line, 200);
+    assert(lttb.size() == 200 && lttb.front().x == 0 && lttb.back().x == 9999);
+    assert(std::is_sorted(lttb.begin(), lttb.end(), [](const ChartPoint &a, const ChartPoint &b)
+                          { return a.x < b.x; }));
+    assert(std::any_of(lttb.begin(), lttb.end(), [](const ChartPoint &p)
+                       { return p.x == 6789; }));
+    auto extremes = min_max_decimate(line, 200);
+    assert(extremes.size() <= 200 && extremes.front().x == 0 && extremes.back().x == 9999);
+    double lowest = 0.0;
+    for (const auto &p : extremes)
+    {
+        lowest = std::min(lowest, p.y);
+    }
+    assert(lowest < -0.999 && std::any_of(extremes.begin(), extremes.end(), [](const ChartPoint &p)
+                                          { return p.y > 24.0; }));
+    assert(lttb_decimate(line, 2).size() == 2 && min_max_decimate(line, 3).size() == 3);
+
+    // Pyramid views match bucketing the raw range, without reading it all
+    CandlestickPyramid pyramid(4);
+    pyramid.build(bars);
+    assert(pyramid.size() == 1000 && pyramid.level_count() == 6 && pyramid.level(5).size() == 1);
+    assert(pyramid.level(5)[0].high == buckets[4].high && pyramid.level(5)[0].volume == 10000);
+    auto full = pyramid.view(0, 1000, 50);
+    assert(full.size() == 50 && full.front().open == bars[0].open && full.back().close == bars[999].close);
+    auto zoomed = pyramid.view(400, 480, 20);
+    assert(zoomed.size() == 20 && zoomed.front().open == bars[400].open && zoomed.back().close == bars[479].close);
+    assert(pyramid.view(990, 5000, 50).size() == 10 && pyramid.view(10, 10, 5).empty());
+
+    LinePyramid line_pyramid(4);
+    line_pyramid.build(line);
+    auto line_view = line_pyramid.view(6000, 8000, 100, Decimation::MIN_MAX);
+    assert(line_view.size() <= 100 && line_view.front().x >= 6000 && line_view.back().x < 8000);
+    assert(std::any_of(line_view.begin(), line_view.end(), [](const ChartPoint &p)
+                       { return p.x == 6789; }));
+
+    // The HTML renderer emits one candle per bucket, not per bar
+    HTMLChartRenderer renderer;
+    ChartConfig config;
+    config.width = 300; // 200 px of plot area, 2 px per candle
+    renderer.initialize(config);
+    renderer.render_candlestick_chart(bars, {}, config);
+    std::string html = renderer.get_chart_data("html");
+    size_t candles = 0;
+    for (size_t pos = html.find("<rect x="); pos != std::string::npos; pos = html.find("<rect x=", pos + 1))
+    {
+        ++candles;
+    }
+    assert(candles == 100);
+    config.level_of_detail = false;
+    renderer.initialize(config);
+    renderer.render_candlestick_chart(bars, {}, config);
+    assert(renderer.get_chart_data("html").size() > html.size() * 5);
+
+    std::cout << "Chart level of detail test passed!" << std::endl;
+}
+
+// Counts its renders; publishes an int through a snapshot channel
+class CountingWidget : public visualization::DashboardWidget
+{
+public:
+    CountingWidget(const std::string &id)
+        : DashboardWidget(id, visualization::WidgetConfig(visualization::WidgetType::ALERTS, id, 0, 0, 10, 10)) {}
+
+    void update() override
+    {
+        if (begin_update())
+        {
+            value_in_.take(value_);
+        }
+    }
+    void render() override { ++renders; }
+    std::string get_data() const override { return std::to_string(value_); }
+    void set_data(const std::string &) override {}
+
+    void publish(int value)
+    {
+        value_in_.publish(value);
+        mark_for_update();
+    }
+    int value() const { return value_; }
+
+    std::atomic<int> renders{0};
+
+private:
+    visualization::SnapshotChannel<int> value_in_;
+    int value_ = 0;
+};
+
+void test_dashboard_rendering_basic()
+{
+    std::cout << "Testing Dashboard incremental rendering..." << std::endl;
+
+    using namespace trading::visualization;
+
+    // The channel only keeps the newest snapshot and reuses buffers
+    SnapshotChannel<std::vector<int>> channel;
+    std::vector<int> front;
+    assert(!channel.take(front));
+    channel.publish(std::vector<int>{1, 2, 3});
+    channel.publish(std::vector<int>{4, 5});
+    assert(channel.pending() && channel.take(front));
+    assert(front == (std::vector<int>{4, 5}) && !channel.pending() && !channel.take(front));
+
+    Dashboard dashboard("Test", 800, 600);
+    dashboard.add_panel(std::make_unique<DashboardPanel>("panel", "Panel", 0, 0, 800, 600));
+    for (int i = 0; i < 4; ++i)
+    {
+        dashboard.add_widget_to_panel("panel", std::make_unique<CountingWidget>("w" + std::to_string(i)));
+    }
+    auto *w0 = dashboard.get_widget_as<CountingWidget>("w0");
+    auto *w1 = dashboard.get_widget_as<CountingWidget>("w1");
+    assert(w0 && w1 && dashboard.get_widget_as<PriceTickerWidget>("w0") == nullptr);
+
+    // Every widget draws once, then only the ones with new data
+    assert(dashboard.render_dirty() == 4);
+    dashboard.update();
+    assert(dashboard.render_dirty() == 0);
+    w1->publish(7);
+    w1->publish(8);
+    assert(w1->value() == 0); // Not applied until the render side updates
+    dashboard.update();
+    assert(dashboard.render_dirty() == 1);
+    assert(w1->value() == 8 && w1->renders == 2 && w0->renders == 1);
+
+    // Hidden widgets are skipped; showing one again redraws it
+    w0->set_visible(false);
+    w0->publish(1);
+    dashboard.update();
+    assert(dashboard.render_dirty() == 0 && w0->renders == 1);
+    w0->set_visible(true);
+    assert(dashboard.render_dirty() == 1 && w0->renders == 2 && w0->value() == 1);
+
+    // Typed updates reach the built-in widgets without string parsing
+    auto ticker = std::make_unique<PriceTickerWidget>("ticker", WidgetConfig(WidgetType::PRICE_TICKER, "T", 0, 0, 10, 10), "AAPL");
+    auto *ticker_ptr = ticker.get();
+    dashboard.add_widget_to_panel("panel", std::move(ticker));
+    ticker_ptr->update_price(101.5, 1.5, 1.5, 1000);
+    std::ostringstream captured;
+    auto *old_buf = std::cout.rdbuf(captured.rdbuf());
+    dashboard.update();
+    size_t rendered = dashboard.render_dirty();
+    std::cout.rdbuf(old_buf);
+    assert(rendered == 1 && ticker_ptr->price() == 101.5);
+    assert(captured.str().find("101.50") != std::string::npos);
+
+    // The render thread picks up data published from another thread
+    dashboard.set_refresh_interval(std::chrono::milliseconds(1));
+    dashboard.start();
+    assert(dashboard.running());
+    std::thread feed([w1]
+                     {
+        for (int v = 100; v <= 200; ++v)
+        {
+            w1->publish(v);
+        } });
+    feed.join();
+    // Two whole frames after the last publish have certainly applied it
+    uint64_t target = dashboard.frames_rendered() + 2;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (dashboard.frames_rendered() < target && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    dashboard.stop();
+    assert(!dashboard.running());
+    assert(w1->value() == 200 && w1->renders >= 3);
+    assert(dashboard.frames_rendered() > 4);
+    assert(w0->renders == 2); // Idle widgets were never redrawn
+
+    std::cout << "Dashboard incremental rendering test passed!" << std::endl;
+}
+
+void test_columnar_export_basic()
+{
+    std::cout << "Testing Parquet/Feather export..." << std::endl;
+
+    using namespace trading::visualization;
+
+    auto dir = std::filesystem::temp_directory_path() / "trading_columnar_export_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    auto read_file = [](const std::filesystem::path &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+
+    MarketDataSeries series("TEST");
+    auto t0 = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+    for (int i = 0; i < 5000; ++i)
+    {
+        double close = 100.0 + 0.01 * (i % 97);
+        series.add_point(MarketDataPoint(t0 + std::chrono::minutes(i), close - 0.1, close + 0.2,
+                                         close - 0.3, close, 500 + i % 50));
+    }
+
+    // The writer streams batches into a temporary file and renames it on close
+    std::vector<ColumnSpec> schema = {{"id", ColumnType::INT64}, {"name", ColumnType::STRING}};
+    auto parquet_path = dir / "direct.parquet";
+    {
+        ParquetWriter writer(parquet_path.string(), schema);
+        ColumnBatch batch(schema);
+        for (int group = 0; group < 3; ++group)
+        {
+            batch.clear();
+            for (int i = 0; i < 100; ++i)
+            {
+                batch.ints(0).push_back(group * 100 + i);
+                batch.strings(1).push_back(i % 2 ? "odd" : "even");
+            }
+            writer.write(batch);
+        }
+        assert(!std::filesystem::exists(parquet_path));
+        batch.strings(1).pop_back();
+        bool rejected = false;
+        try
+        {
+            writer.write(batch);
+        }
+        catch (const std::invalid_argument &)
+        {
+            rejected = true;
+        }
+        assert(rejected);
+        writer.close();
+        assert(writer.rows_written() == 300);
+        assert(writer.bytes_written() == std::filesystem::file_size(parquet_path));
+    }
+    std::string bytes = read_file(parquet_path);
+    assert(bytes.compare(0, 4, "PAR1") == 0 && bytes.compare(bytes.size() - 4, 4, "PAR1") == 0);
+    uint32_t footer_length = 0;
+    std::memcpy(&footer_length, bytes.data() + bytes.size() - 8, sizeof(footer_length));
+    assert(footer_length > 0 && footer_length < bytes.size() - 12);
+
+    // An unclosed writer leaves nothing behind
+    {
+        ParquetWriter writer((dir / "abandoned.parquet").string(), schema);
+    }
+    assert(!std::filesystem::exists(dir / "abandoned.parquet") && !std::filesystem::exists(dir / "abandoned.parquet.tmp"));
+
+    // Exporters from the factory, compared with CSV
+    auto parquet = ExportFactory::create_exporter(ExportFormat::PARQUET);
+    auto feather = ExportFactory::create_exporter(ExportFormat::FEATHER);
+    assert(parquet && feather);
+    ExportConfig config((dir / "series.parquet").string(), ExportFormat::PARQUET);
+    config.row_group_size = 1000;
+    config.metadata["source"] = "test";
+    assert(parquet->export_market_data(series, config));
+    CSVExporter csv;
+    assert(csv.export_market_data(series, ExportConfig((dir / "series.csv").string())));
+    auto parquet_size = std::filesystem::file_size(dir / "series.parquet");
+    assert(parquet_size < std::filesystem::file_size(dir / "series.csv"));
+    std::string parquet_bytes = read_file(dir / "series.parquet");
+    assert(parquet_bytes.find("source") != std::string::npos && parquet_bytes.find("TEST") != std::string::npos);
+
+#ifdef HAVE_ZLIB
+    config.filename = (dir / "series.gz.parquet").string();
+    config.compression = ExportCompression::GZIP;
+    assert(parquet->export_market_data(series, config));
+    assert(std::filesystem::file_size(dir / "series.gz.parquet") < parquet_size);
+#endif
+
+    // Feather: no compression, 8-byte aligned Arrow IPC layout
+    ExportConfig feather_config((dir / "series.feather").string(), ExportFormat::FEATHER);
+    feather_config.compression = ExportCompression::GZIP;
+    assert(!feather->export_market_data(series, feather_config));
+    feather_config.compression = ExportCompression::NONE;
+    feather_config.row_group_size = 2048;
+    assert(feather->export_market_data(series, feather_config));
+    std::string feather_bytes = read_file(dir / "series.feather");
+    assert(feather_bytes.compare(0, 6, "ARROW1") == 0 && feather_bytes.compare(feather_bytes.size() - 6, 6, "ARROW1") == 0);
+    int32_t feather_footer = 0;
+    std::memcpy(&feather_footer, feather_bytes.data() + feather_bytes.size() - 10, sizeof(feather_footer));
+    assert((feather_bytes.size() - 10 - static_cast<size_t>(feather_footer)) % 8 == 0);
+
+    // Every data kind exports; unwritable paths fail cleanly
+    TechnicalIndicators indicators;
+    indicators.sma_20 = {1.0, 2.0, 3.0};
+    indicators.rsi = {50.0};
+    std::vector<ChartPoint> pnl = {ChartPoint(0, 1.0), ChartPoint(1, 2.0)};
+    std::vector<std::pair<std::string, double>> positions = {{"AAPL", 10.0}, {"MSFT", -5.0}};
+    for (auto *exporter : {parquet.get(), feather.get()})
+    {
+        assert(exporter->export_indicators(indicators, ExportConfig((dir / "indicators").string())));
+        assert(exporter->export_performance_data(pnl, pnl, ExportConfig((dir / "performance").string())));
+        assert(exporter->export_portfolio_data(positions, ExportConfig((dir / "portfolio").string())));
+        assert(!exporter->export_portfolio_data(positions, ExportConfig((dir / "missing" / "portfolio").string())));
+    }
+
+    std::filesystem::remove_all(dir);
+    std::cout << "Parquet/Feather export test passed!" << std::endl;
+}
+
+void test_batch_export_basic()
+{
+    std::cout << "Testing parallel batch export..." << std::endl;
+
+    using namespace trading::visualization;
+
+    auto dir = std::filesystem::temp_directory_path() / "trading_batch_export_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    auto read_file = [](const std::filesystem::path &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+
+    // Bars cross hour boundaries and step backwards once; prices cover
+    // rounding, negatives and very large values
+    MarketDataSeries series("BATCH");
+    auto t0 = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000 + 17));
+    std::vector<double> prices = {100.0, 0.1234565, -2.5, 1e-7, 123456789.987654321, 1e300, 99.9999995};
+    for (int i = 0; i < 10000; ++i)
+    {
+        double close = prices[i % prices.size()] + 0.001 * i;
+        auto when = t0 + std::chrono::seconds(i == 5000 ? -7200 : 37 * i);
+        series.add_point(MarketDataPoint(when, close, close + 1.0, close - 1.0, close, 1000 + i));
+    }
+
+    // Rows match the old iostream formatting
+    CSVExporter csv;
+    assert(csv.export_market_data(series, ExportConfig((dir / "single.csv").string())));
+    std::ifstream single(dir / "single.csv");
+    std::string line;
+    std::getline(single, line);
+    for (size_t i = 0; std::getline(single, line); ++i)
+    {
+        const auto &point = series[i];
+        std::time_t time = std::chrono::system_clock::to_time_t(point.timestamp);
+        std::ostringstream expected;
+        expected << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S") << std::fixed << std::setprecision(6)
+                 << "," << point.open << "," << point.high << "," << point.low << "," << point.close << "," << point.volume;
+        assert(line == expected.str());
+    }
+
+    // A shared cache gives the same text as formatting in place
+    auto pool = std::make_shared<ThreadPool>(2);
+    FormattedSeries formatted(series, pool.get());
+    assert(formatted.rows() == series.size());
+    assert(formatted.field(0, FormattedSeries::OPEN) == "100.000000" && formatted.field(3, FormattedSeries::OPEN) == "0.003000");
+    assert(formatted.field(9999, FormattedSeries::VOLUME) == "10999");
+
+    // Each configuration goes to the exporters for its format; the
+    // exporters run on the pool and share one formatting pass
+    BatchExporter batch(pool);
+    batch.add_exporter(std::make_unique<CSVExporter>());
+    batch.add_exporter(std::make_unique<JSONExporter>());
+    batch.add_exporter(std::make_unique<XMLExporter>());
+    batch.add_export_config("csv", ExportConfig((dir / "batch.csv").string()));
+    batch.add_export_config("json", ExportConfig((dir / "batch.json").string(), ExportFormat::JSON));
+    batch.add_export_config("xml", ExportConfig((dir / "batch.xml").string(), ExportFormat::XML));
+    assert(batch.export_market_data_batch(series));
+    assert(read_file(dir / "batch.csv") == read_file(dir / "single.csv"));
+    std::string json = read_file(dir / "batch.json");
+    assert(json.find("\"open\": " + std::string(formatted.field(4, FormattedSeries::OPEN))) != std::string::npos);
+    assert(json.substr(json.size() - 5) == "  ]\n}");
+    std::string xml = read_file(dir / "batch.xml");
+    assert(xml.find("<symbol>BATCH</symbol>") != std::string::npos && xml.find("<volume>10999</volume>") != std::string::npos);
+    auto status = batch.get_export_status();
+    assert(status.size() == 3 && status["csv"] && status["json"] && status["xml"]);
+
+    // A configuration no exporter handles is reported as failed
+    batch.add_export_config("excel", ExportConfig((dir / "batch.xls").string(), ExportFormat::EXCEL));
+    assert(!batch.export_market_data_batch(series));
+    assert(!batch.get_export_status()["excel"] && batch.get_export_status()["csv"]);
+
+#ifdef HAVE_ZLIB
+    // Compression happens while writing, and compress_file reuses that stage
+    ExportConfig gzip_config((dir / "compressed.csv").string());
+    gzip_config.compression = ExportCompression::GZIP;
+    assert(csv.export_market_data(series, gzip_config));
+    std::string compressed = read_file(dir / "compressed.csv.gz");
+    assert(compressed.size() > 2 && static_cast<unsigned char>(compressed[0]) == 0x1f &&
+           static_cast<unsigned char>(compressed[1]) == 0x8b);
+    assert(compressed.size() < std::filesystem::file_size(dir / "single.csv") / 2);
+    auto gunzip = [](const std::filesystem::path &path)
+    {
+        gzFile file = gzopen(path.string().c_str(), "rb");
+        std::string text;
+        char block[65536];
+        int read = 0;
+        while ((read = gzread(file, block, sizeof(block))) > 0)
+        {
+            text.append(block, static_cast<size_t>(read));
+        }
+        gzclose(file);
+        return text;
+    };
+    assert(gunzip(dir / "compressed.csv.gz") == read_file(dir / "single.csv"));
+    assert(ExportUtils::compress_file((dir / "single.csv").string(), (dir / "post.csv.gz").string()));
+    assert(gunzip(dir / "post.csv.gz") == read_file(dir / "single.csv"));
+#else
+    assert(!ExportUtils::compress_file((dir / "single.csv").string(), (dir / "post.csv.gz").string()));
+#endif
+
+    std::filesystem::remove_all(dir);
+    std::cout << "Parallel batch export test passed!" << std::endl;
+}
+
+void test_parameter_sweep_basic()
+{
+    std::cout << "Testing ParameterSweep basic functionality..." << std::endl;
+
+    std::vector<std::shared_ptr<const MarketDataSeries>> universe;
+    auto now = std::chrono::system_clock::now();
+    for (int s = 0; s < 3; ++s)
+    {
+        auto series = std::make_shared<MarketDataSeries>("SYM" + std::to_string(s));
+        for (int i = 0; i < 200; ++i)
+        {
+            double price = 100.0 + 10.0 * std::sin((i + s * 7) / 9.0);
+            series->add_point(MarketDataPoint(now + std::chrono::minutes(i), price, price + 0.5, price - 0.5, price, 1000));
+        }
+        universe.push_back(series);
+    }
+
+    auto grid = ParameterSweep::make_grid({{"fast", {3, 5}}, {"slow", {10, 20, 30}}});
+    assert(grid.size() == 6);
+    assert(grid[1].get("fast") == 3 && grid[1].get("slow") == 20);
+
+    auto pool = std::make_shared<ThreadPool>(2);
+    ParameterSweep sweep(pool);
+    sweep.set_chunk_size(4);
+
+    std::atomic<int> factory_calls{0};
+    auto results = sweep.run(universe, grid, [&](const ParameterSet &params, IndicatorColumns &columns)
+                             {
+                                 ++factory_calls;
+                                 return std::make_unique<SmaCrossoverStrategy>(
+                                     columns.sma(static_cast<int>(params.get("fast"))),
+                                     columns.sma(static_cast<int>(params.get("slow"))), 10); });
+
+    assert(results.size() == universe.size() * grid.size());
+    assert(factory_calls == static_cast<int>(results.size()));
+
+    // Precomputed columns must reproduce a standalone run with rolling SMAs
+    BacktestConfig config;
+    config.record_equity_curve = false;
+    BacktestEngine engine(config);
+    for (size_t row = 0; row < results.size(); ++row)
+    {
+        const auto &params = grid[results.parameter_index[row]];
+        SmaCrossoverStrategy direct(static_cast<int>(params.get("fast")), static_cast<int>(params.get("slow")), 10);
+        auto expected = engine.run(*universe[results.symbol_index[row]], direct);
+        assert(std::abs(results.final_equity[row] - expected.final_equity) < 1e-6);
+    }
+
+    assert(results.best_for_symbol(0) < results.size());
+    assert(results.best_parameters() < grid.size());
+
+    std::cout << "ParameterSweep basic test passed!" << std::endl;
+}
+
+void test_monte_carlo_basic()
+{
+    std::cout << "Testing MonteCarloEngine basic functionality..." << std::endl;
+
+    using namespace trading::analytics;
+
+    // A constant return sample gives a degenerate, exactly known distribution
+    std::vector<double> constant(50, 0.01);
+    MonteCarloConfig config;
+    config.num_paths = 1000;
+    config.horizon = 10;
+    config.paths_per_block = 64;
+    auto flat = MonteCarloEngine(nullptr, config).run(constant);
+    double expected = std::pow(1.01, 10) - 1.0;
+    assert(flat.terminal_returns.size() == 1000);
+    assert(std::abs(flat.terminal_returns[999] - expected) < 1e-12);
+    assert(flat.max_drawdowns[0] == 0.0);
+    assert(flat.risk.size() == 2);
+    assert(std::abs(flat.risk[0].value_at_risk + expected) < 1e-12);
+
+    // Results must not depend on the number of worker threads
+    std::vector<double> sample = {0.02, -0.015, 0.004, -0.03, 0.01, 0.0, 0.025, -0.005};
+    config.num_paths = 5000;
+    config.horizon = 50;
+    config.bootstrap_block_length = 3;
+    auto serial = MonteCarloEngine(nullptr, config).run(sample);
+    auto parallel = MonteCarloEngine(std::make_shared<ThreadPool>(3), config).run(sample);
+    assert(serial.terminal_returns == parallel.terminal_returns);
+    assert(serial.max_drawdowns == parallel.max_drawdowns);
+    assert(serial.risk[1].conditional_var >= serial.risk[1].value_at_risk);
+    assert(serial.risk[1].value_at_risk >= serial.risk[0].value_at_risk);
+
+    config.method = SimulationMethod::GEOMETRIC_BROWNIAN;
+    auto gbm = MonteCarloEngine(nullptr, config).run(sample);
+    assert(gbm.mean_max_drawdown > 0.0 && gbm.mean_max_drawdown < 1.0);
+
+    std::cout << "MonteCarloEngine basic test passed!" << std::endl;
+}
+
+void test_portfolio_analytics_basic()
+{
+    std::cout << "Testing PortfolioAnalytics basic functionality..." << std::endl;
+
+    using namespace trading::analytics;
+
+    // A short curve with hand-checked figures
+    AnalyticsConfig config;
+    config.rolling_window = 4;
+    PortfolioAnalytics simple(1, nullptr, config);
+    for (double equity : {100.0, 110.0, 99.0, 121.0})
+    {
+        simple.update(std::span<const double>(&equity, 1));
+    }
+    auto m = simple.metrics(0);
+    assert(m.bars == 4);
+    assert(std::abs(m.total_return - 0.21) < 1e-12);
+    assert(std::abs(m.max_drawdown - 0.1) < 1e-12);
+    assert(m.max_drawdown_duration == 1 && m.current_drawdown == 0.0);
+    assert(std::abs(m.win_rate - 2.0 / 3.0) < 1e-12);
+    assert(std::abs(m.avg_win - 16.0) < 1e-12 && std::abs(m.avg_loss - 11.0) < 1e-12);
+    assert(std::abs(m.profit_factor - 32.0 / 11.0) < 1e-12);
+    assert(std::abs(m.annualized_return - (std::pow(1.21, 252.0 / 3.0) - 1.0)) < 1e-9 * m.annualized_return);
+    assert(m.turnover == 0.0 && m.total_trades == 0);
+
+    // Random curves against a direct recomputation from the full history
+    const size_t curves = 300;
+    const size_t bars = 500;
+    config.rolling_window = 37;
+    config.risk_free_rate = 0.02;
+    config.curves_per_task = 64;
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> step(0.0004, 0.01);
+    EquityMatrix equity(curves, bars);
+    EquityMatrix exposure(curves, bars);
+    std::vector<double> benchmark(bars);
+    std::vector<double> row(curves, 1000.0);
+    std::vector<double> weights(curves, 0.0);
+    for (size_t b = 0; b < bars; ++b)
+    {
+        benchmark[b] = step(rng);
+        for (size_t c = 0; c < curves; ++c)
+        {
+            if (b > 0)
+            {
+                row[c] *= 1.0 + 0.5 * benchmark[b] * static_cast<double>(c % 3) + step(rng);
+            }
+            if (rng() % 10 == 0)
+            {
+                weights[c] = static_cast<double>(rng() % 5) * 0.25;
+            }
+        }
+        equity.append_bar(row);
+        exposure.append_bar(weights);
+    }
+
+    PortfolioAnalytics incremental(curves, nullptr, config);
+    for (size_t b = 0; b < bars; ++b)
+    {
+        incremental.update(equity.bar(b), benchmark[b], exposure.bar(b));
+    }
+    PortfolioAnalytics serial(curves, nullptr, config);
+    serial.run(equity, benchmark, &exposure);
+    std::vector<std::vector<double>> columns;
+    for (size_t c = 0; c < curves; ++c)
+    {
+        columns.push_back(equity.curve(c));
+    }
+    PortfolioAnalytics parallel(curves, std::make_shared<ThreadPool>(3), config);
+    parallel.run(EquityMatrix::from_curves(columns), benchmark, &exposure);
+    assert(parallel.bars() == bars);
+
+    auto same = [](const CurveMetrics &a, const CurveMetrics &b)
+    {
+        return a.sharpe_ratio == b.sharpe_ratio && a.sortino_ratio == b.sortino_ratio &&
+               a.max_drawdown == b.max_drawdown && a.max_drawdown_duration == b.max_drawdown_duration &&
+               a.rolling_volatility == b.rolling_volatility && a.rolling_beta == b.rolling_beta &&
+               a.turnover == b.turnover && a.total_trades == b.total_trades && a.profit_factor == b.profit_factor;
+    };
+    auto expected = incremental.all_metrics();
+    auto batch = serial.all_metrics();
+    auto pooled = parallel.all_metrics();
+    for (size_t c = 0; c < curves; ++c)
+    {
+        assert(same(expected[c], batch[c]));
+        assert(same(expected[c], pooled[c]));
+    }
+
+    auto close = [](double a, double b)
+    {
+        return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b));
+    };
+    for (size_t c : {size_t(0), size_t(1), size_t(2), size_t(151), curves - 1})
+    {
+        auto curve = equity.curve(c);
+        auto weights_of = exposure.curve(c);
+        std::vector<double> returns;
+        for (size_t b = 1; b < bars; ++b)
+        {
+            returns.push_back(curve[b] / curve[b - 1] - 1.0);
+        }
+        double n = static_cast<double>(returns.size());
+        double mean = std::accumulate(returns.begin(), returns.end(), 0.0) / n;
+        double var = 0.0;
+        double downside = 0.0;
+        double rf = 0.02 / 252.0;
+        for (double r : returns)
+        {
+            var += (r - mean) * (r - mean);
+            downside += std::min(r - rf, 0.0) * std::min(r - rf, 0.0);
+        }
+        double sd = std::sqrt(var / (n - 1.0));
+        double peak = curve[0];
+        double max_dd = 0.0;
+        size_t underwater = 0;
+        size_t longest = 0;
+        double turnover = 0.0;
+        for (size_t b = 1; b < bars; ++b)
+        {
+            peak = std::max(peak, curve[b]);
+            max_dd = std::max(max_dd, 1.0 - curve[b] / peak);
+            underwater = curve[b] < peak ? underwater + 1 : 0;
+            longest = std::max(longest, underwater);
+            turnover += std::abs(weights_of[b] - weights_of[b - 1]);
+        }
+
+        // Rolling window over the last 37 returns, population moments
+        size_t w = 37;
+        double sr = 0.0, sb = 0.0, srr = 0.0, sbb = 0.0, srb = 0.0;
+        for (size_t i = returns.size() - w; i < returns.size(); ++i)
+        {
+            double r = returns[i];
+            double bm = benchmark[i + 1];
+            sr += r;
+            sb += bm;
+            srr += r * r;
+            sbb += bm * bm;
+            srb += r * bm;
+        }
+        double wn = static_cast<double>(w);
+        double beta = (srb / wn - sr / wn * sb / wn) / (sbb / wn - sb / wn * sb / wn);
+        double rolling_vol = std::sqrt((srr / wn - sr / wn * sr / wn) * wn / (wn - 1.0)) * std::sqrt(252.0);
+
+        const auto &got = expected[c];
+        assert(close(got.sharpe_ratio, (mean - rf) / sd * std::sqrt(252.0)));
+        assert(close(got.sortino_ratio, (mean - rf) / std::sqrt(downside / n) * std::sqrt(252.0)));
+        assert(close(got.volatility, sd * std::sqrt(252.0)));
+        assert(close(got.max_drawdown, max_dd));
+        assert(got.max_drawdown_duration == longest);
+        assert(std::abs(got.rolling_volatility - rolling_vol) < 1e-9);
+        assert(std::abs(got.rolling_beta - beta) < 1e-7);
+        assert(close(got.turnover, turnover * 252.0 / n));
+    }
+    // Curves with index % 3 == 2 carry a benchmark beta of about one
+    assert(expected[2].rolling_beta > expected[0].rolling_beta);
+
+    bool threw = false;
+    try
+    {
+        incremental.update(std::vector<double>(curves - 1, 1.0));
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    // The widget shows the computed metrics
+    visualization::PerformanceMetricsWidget widget(
+        "metrics", visualization::WidgetConfig(visualization::WidgetType::PERFORMANCE_METRICS, "Metrics", 0, 0, 40, 20));
+    widget.update_metrics(expected[0]);
+    widget.update();
+    assert(widget.get_metrics().sharpe_ratio == expected[0].sharpe_ratio);
+    assert(widget.get_metrics().total_trades == expected[0].total_trades);
+
+    incremental.reset();
+    assert(incremental.bars() == 0 && incremental.metrics(0).sharpe_ratio == 0.0);
+
+    std::cout << "PortfolioAnalytics basic test passed!" << std::endl;
+}
+
+void test_metrics_basic()
+{
+    std::cout << "Testing metrics..." << std::endl;
+    using namespace trading::metrics;
+
+    // Buckets are exact below 64 and within 1/32 above
+    for (uint64_t value : {uint64_t{0}, uint64_t{1}, uint64_t{63}, uint64_t{64}, uint64_t{65}, uint64_t{1000},
+                           uint64_t{123456789}, (uint64_t{1} << Histogram::kMaxValueBits) - 1})
+    {
+        size_t bucket = Histogram::bucket_index(value);
+        assert(bucket < Histogram::kBuckets);
+        assert(Histogram::bucket_upper_bound(bucket) >= value);
+        assert(bucket == 0 || Histogram::bucket_upper_bound(bucket - 1) < value);
+        assert(Histogram::bucket_upper_bound(bucket) - value <= value / 32);
+    }
+    assert(Histogram::bucket_index(UINT64_MAX) == Histogram::kBuckets - 1);
+
+    // Per-thread shards add up
+    Counter counter("test_events_total", "Test events");
+    Histogram histogram("test_latency_seconds", "Test latency");
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&]()
+                                 {
+                for (uint64_t i = 1; i <= 1000; ++i)
+                {
+                    counter.add();
+                    histogram.record(i);
+                } });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    auto before = Registry::global().snapshot();
+    auto count_of = [](const MetricsSnapshot &snapshot, const std::string &name)
+    {
+        const HistogramSnapshot *found = snapshot.find_histogram(name);
+        return found ? found->count : 0;
+    };
+    auto gauges_named = [](const MetricsSnapshot &snapshot, const std::string &name)
+    {
+        return std::count_if(snapshot.gauges.begin(), snapshot.gauges.end(), [&](const ValueSnapshot &gauge)
+                             { return gauge.name == name; });
+    };
+    if constexpr (kEnabled)
+    {
+        const double tick = nanoseconds_per_tick();
+        const HistogramSnapshot *latency = before.find_histogram("test_latency_seconds");
+        assert(counter.value() == 4000 && before.find_counter("test_events_total")->value == 4000);
+        assert(latency && latency->count == 4000);
+        assert(latency->min == tick && latency->max == 1000 * tick);
+        assert(std::abs(latency->mean() - 500.5 * tick) < 1e-6 * tick);
+        assert(std::abs(latency->percentile(0.5) / tick - 500.0) <= 500.0 / 32 + 1);
+        assert(latency->percentile(1.0) == latency->max);
+    }
+
+    // Instrumented subsystems report into the global registry
+    auto dir = std::filesystem::temp_directory_path() / "trading_metrics_test";
+    std::filesystem::remove_all(dir);
+    {
+        auto pool = std::make_shared<ThreadPool>(2);
+        std::vector<std::future<void>> done;
+        for (int i = 0; i < 100; ++i)
+        {
+            done.push_back(pool->submit([]() {}));
+        }
+        for (auto &future : done)
+        {
+            future.get();
+        }
+
+        CacheManager cache(10, dir.string());
+        MarketDataSeries series("M");
+        series.add_point(MarketDataPoint(std::chrono::system_clock::now(), 1.0, 2.0, 0.5, 1.5, 10));
+        cache.put("M", series);
+        assert(cache.get("M") && !cache.get("missing"));
+
+        auto during = Registry::global().snapshot();
+        assert(gauges_named(during, "threadpool_pending_tasks") == gauges_named(before, "threadpool_pending_tasks") + 1);
+        assert(during.find_gauge("threadpool_sleeping_workers"));
+        if constexpr (kEnabled)
+        {
+            // Futures are ready before run() records the task; wait_all() is not
+            pool->wait_all();
+            during = Registry::global().snapshot();
+            assert(count_of(during, "threadpool_task_run_seconds") >= count_of(before, "threadpool_task_run_seconds") + 100);
+            assert(count_of(during, "threadpool_queue_wait_seconds") >= count_of(before, "threadpool_queue_wait_seconds") + 100);
+            assert(count_of(during, "cache_put_seconds") == count_of(before, "cache_put_seconds") + 1);
+            assert(count_of(during, "cache_get_seconds") == count_of(before, "cache_get_seconds") + 2);
+            assert(during.find_counter("cache_hits_total")->value >= 1);
+            assert(during.find_counter("cache_misses_total")->value >= 1);
+        }
+    }
+    std::filesystem::remove_all(dir);
+    auto after = Registry::global().snapshot();
+    assert(gauges_named(after, "threadpool_pending_tasks") == gauges_named(before, "threadpool_pending_tasks"));
+
+    // Exposition formats
+    std::string text = to_prometheus(after);
+    assert(text.find("# TYPE trading_test_events_total counter") != std::string::npos);
+    assert(text.find("# TYPE trading_test_latency_seconds summary") != std::string::npos);
+    assert(text.find("trading_test_latency_seconds{quantile=\"0.99\"}") != std::string::npos);
+    assert(text.find("trading_test_latency_seconds_count") != std::string::npos);
+    assert(text.find("trading_test_latency_seconds_max") != std::string::npos);
+    std::string json = to_json(after);
+    assert(json.find("\"name\": \"test_latency_seconds\"") != std::string::npos);
+    assert(json.find("\"p999_ns\"") != std::string::npos);
+
+#if !defined(_WIN32)
+    // HTTP endpoint on a free port
+    {
+        MetricsServer server(0);
+        assert(server.port() != 0);
+        auto http_get = [&](const std::string &path)
+        {
+            int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(server.port());
+            inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+            assert(::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+            std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+            assert(::send(fd, request.data(), request.size(), 0) == static_cast<ssize_t>(request.size()));
+            std::string response;
+            char buffer[4096];
+            ssize_t received;
+            while ((received = ::recv(fd, buffer, sizeof(buffer), 0)) > 0)
+            {
+                response.append(buffer, static_cast<size_t>(received));
+            }
+            ::close(fd);
+            return response;
+        };
+
+        std::string metrics = http_get("/metrics");
+        assert(metrics.rfind("HTTP/1.1 200 OK", 0) == 0);
+        assert(metrics.find("text/plain; version=0.0.4") != std::string::npos);
+        assert(metrics.find("trading_test_events_total") != std::string::npos);
+        assert(http_get("/metrics.json?pretty").find("\"histograms\"") != std::string::npos);
+        assert(http_get("/missing").rfind("HTTP/1.1 404", 0) == 0);
+        assert(server.requests_served() == 3);
+    }
+#endif
+
+    // Dashboard widget
+    visualization::SystemMetricsWidget widget(
+        "metrics", visualization::WidgetConfig(visualization::WidgetType::SYSTEM_METRICS, "System", 0, 0, 80, 20));
+    widget.update_from_registry();
+    assert(widget.needs_update());
+    widget.update();
+    assert(widget.get_snapshot().find_histogram("test_latency_seconds"));
+    assert(widget.get_data().find("test_events_total") != std::string::npos);
+    widget.render();
+
+    std::cout << "Metrics test passed!" << std::endl;
+}
+
 int main()
 {
     std::cout << "Running basic tests..." << std::endl;
@@ -81,8 +3067,38 @@ int main()
     try
     {
         test_thread_pool_basic();
+        test_thread_pool_work_stealing_basic();
+        test_thread_pool_priority_basic();
         test_memory_pool_basic();
+        test_memory_pool_size_classes_basic();
         test_lock_free_queue_basic();
+        test_queue_bulk_basic();
+        test_queue_wait_strategies_basic();
+        test_columnar_series_basic();
+        test_clean_data_chunked_basic();
+        test_scratch_arena_basic();
+        test_incremental_indicators_basic();
+        test_indicator_pipeline_basic();
+        test_simd_kernels_basic();
+        test_columnar_file_basic();
+        test_cache_manager_lazy_basic();
+        test_cache_manager_sharded_basic();
+        test_indicator_cache_basic();
+        test_universe_panel_basic();
+        test_chart_parser_basic();
+        test_rate_limiter_basic();
+        test_yahoo_finance_batch_basic();
+        test_backtest_engine_basic();
+        test_streaming_backtest_basic();
+        test_order_book_basic();
+        test_chart_lod_basic();
+        test_dashboard_rendering_basic();
+        test_columnar_export_basic();
+        test_batch_export_basic();
+        test_parameter_sweep_basic();
+        test_monte_carlo_basic();
+        test_portfolio_analytics_basic();
+        test_metrics_basic();
 
         std::cout << "All basic tests passed!" << std::endl;
         return 0;